@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include "e_bigint.hpp"
+
+#include <cstdint>
+#include <random>
+#include <string>
+
+namespace {
+    // n 个 limb 的 随机 正数，按 2^64 进制 拼
+    e_math::bigint random_bigint(std::size_t limbs, unsigned seed) {
+        std::mt19937_64 rng(seed);
+        const e_math::bigint base("18446744073709551616");
+        e_math::bigint r;
+        for (std::size_t i = 0; i < limbs; ++i) r = r * base + e_math::bigint(rng() | 1);
+        return r;
+    }
+}
+
+// 等长 乘法：karatsuba_threshold 附近 的 拐点 从 这里 看
+static void BM_bigint_mul(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto a = random_bigint(n, 1);
+    const auto b = random_bigint(n, 2);
+    for (auto _ : state) {
+        auto p = a * b;
+        benchmark::DoNotOptimize(p);
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+// 长短 相差 很大：按 短 的 长度 切段
+static void BM_bigint_mul_unbalanced(benchmark::State& state) {
+    const auto a = random_bigint(static_cast<std::size_t>(state.range(0)), 3);
+    const auto b = random_bigint(static_cast<std::size_t>(state.range(1)), 4);
+    for (auto _ : state) {
+        auto p = a * b;
+        benchmark::DoNotOptimize(p);
+    }
+}
+
+// 128 位 以内 的 累加：不分配，全走 对象 内 存储
+static void BM_bigint_add_small(benchmark::State& state) {
+    const e_math::bigint step(0x9e3779b97f4a7c15ull);
+    for (auto _ : state) {
+        e_math::bigint acc;
+        for (int i = 0; i < 1024; ++i) acc += step;
+        benchmark::DoNotOptimize(acc);
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+
+// 对照：同样 的 累加 用 内置 128 位 整数
+static void BM_int128_add(benchmark::State& state) {
+    std::uint64_t step = 0x9e3779b97f4a7c15ull;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(step);
+        unsigned __int128 acc = 0;
+        for (int i = 0; i < 1024; ++i) {
+            acc += step;
+            benchmark::DoNotOptimize(acc);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+
+static void BM_bigint_add(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    auto a = random_bigint(n, 5);
+    const auto b = random_bigint(n, 6);
+    for (auto _ : state) {
+        // 加 再 减 回来，长度 不会 一直 涨
+        a += b;
+        a -= b;
+        benchmark::DoNotOptimize(a);
+    }
+    state.SetBytesProcessed(2 * state.iterations() * static_cast<std::int64_t>(n * sizeof(std::uint64_t)));
+}
+
+static void BM_bigint_to_string(benchmark::State& state) {
+    const auto a = random_bigint(static_cast<std::size_t>(state.range(0)), 7);
+    for (auto _ : state) {
+        auto s = a.to_string();
+        benchmark::DoNotOptimize(s);
+    }
+}
+
+BENCHMARK(BM_bigint_mul)->RangeMultiplier(2)->Range(4, 1024)->DenseRange(24, 48, 8)->Complexity();
+BENCHMARK(BM_bigint_mul_unbalanced)->Args({1000, 40})->Args({1000, 200})->Args({4000, 100});
+BENCHMARK(BM_bigint_add_small);
+BENCHMARK(BM_int128_add);
+BENCHMARK(BM_bigint_add)->Arg(2)->Arg(16)->Arg(256)->Arg(4096);
+BENCHMARK(BM_bigint_to_string)->Arg(16)->Arg(128);
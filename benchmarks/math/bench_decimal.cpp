@@ -0,0 +1,124 @@
+#include <benchmark/benchmark.h>
+
+#include "e_decimal.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+    using rate = e_math::decimal<std::int32_t, 4>;
+    using money = e_math::decimal<std::int64_t, 2>;
+
+    // raw 的 绝对值 小于 2^bits
+    template <class D>
+    std::vector<D> make_input(std::size_t n, unsigned seed, int bits) {
+        std::mt19937_64 rng(seed);
+        std::vector<D> v(n);
+        for (auto& x : v) x = D::from_raw(static_cast<typename D::rep>(static_cast<std::int64_t>(rng()) >> (64 - bits)));
+        return v;
+    }
+
+    // 乘积 不溢出 的 输入 位数
+    template <class D>
+    constexpr int mul_bits_a = sizeof(typename D::rep) == 4 ? 30 : 40;
+    template <class D>
+    constexpr int mul_bits_b = sizeof(typename D::rep) == 4 ? 14 : 20;
+
+    void sizes(benchmark::internal::Benchmark* b) {
+        for (std::int64_t n : {1 << 10, 1 << 16, 1 << 20}) b->Arg(n);
+        b->ArgName("n");
+    }
+}
+
+// 对照：逐个 operator*
+template <class D>
+static void BM_decimal_mul_loop(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto a = make_input<D>(n, 1, mul_bits_a<D>);
+    const auto b = make_input<D>(n, 2, mul_bits_b<D>);
+    std::vector<D> out(n);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n; ++i) out[i] = a[i] * b[i];
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class D>
+static void BM_decimal_mul(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto a = make_input<D>(n, 1, mul_bits_a<D>);
+    const auto b = make_input<D>(n, 2, mul_bits_b<D>);
+    std::vector<D> out(n);
+    for (auto _ : state) {
+        D::mul(a, b, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class D>
+static void BM_decimal_add(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto a = make_input<D>(n, 3, static_cast<int>(8 * sizeof(D)) - 2);
+    const auto b = make_input<D>(n, 4, static_cast<int>(8 * sizeof(D)) - 2);
+    std::vector<D> out(n);
+    for (auto _ : state) {
+        D::add(a, b, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(3 * sizeof(D)));
+}
+
+template <class D>
+static void BM_decimal_sum(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto a = make_input<D>(n, 5, sizeof(typename D::rep) == 4 ? 31 : 40);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(D::sum(a));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(sizeof(D)));
+}
+
+static void BM_decimal_to_chars(benchmark::State& state) {
+    const auto v = make_input<money>(1024, 6, 52);
+    char buf[money::max_chars];
+    for (auto _ : state) {
+        for (const auto& x : v) benchmark::DoNotOptimize(x.to_chars(buf, buf + sizeof(buf)).ptr);
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+
+static void BM_decimal_from_chars(benchmark::State& state) {
+    const auto v = make_input<money>(1024, 7, 52);
+    std::vector<char> text;
+    std::vector<std::size_t> ends;
+    for (const auto& x : v) {
+        char buf[money::max_chars];
+        const auto r = x.to_chars(buf, buf + sizeof(buf));
+        text.insert(text.end(), buf, r.ptr);
+        ends.push_back(text.size());
+    }
+    for (auto _ : state) {
+        std::size_t begin = 0;
+        for (std::size_t end : ends) {
+            money m;
+            money::from_chars(text.data() + begin, text.data() + end, m);
+            benchmark::DoNotOptimize(m);
+            begin = end;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+
+BENCHMARK_TEMPLATE(BM_decimal_mul_loop, rate)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_decimal_mul, rate)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_decimal_mul_loop, money)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_decimal_mul, money)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_decimal_add, rate)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_decimal_add, money)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_decimal_sum, rate)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_decimal_sum, money)->Apply(sizes);
+BENCHMARK(BM_decimal_to_chars);
+BENCHMARK(BM_decimal_from_chars);
@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+
+#include "e_expr.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+    std::vector<float> random_floats(std::size_t n, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+        std::vector<float> v(n);
+        for (auto& x : v) x = dist(rng);
+        return v;
+    }
+
+    struct inputs {
+        std::vector<float> a, b, c, d, out;
+
+        explicit inputs(std::size_t n)
+            : a(random_floats(n, 1)), b(random_floats(n, 2)), c(random_floats(n, 3)), d(random_floats(n, 4)), out(n) {}
+    };
+
+    void sizes(benchmark::internal::Benchmark* b) {
+        for (std::int64_t n : {1 << 10, 1 << 16, 1 << 20, 1 << 24}) b->Arg(n);
+        b->ArgName("n");
+    }
+
+    // 读 4 个 写 1 个
+    void set_bytes(benchmark::State& state) {
+        state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(5 * sizeof(float)));
+    }
+}
+
+// 对照：每一步 一个 整长 临时数组
+static void BM_expr_temporaries(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    inputs in(n);
+    for (auto _ : state) {
+        std::vector<float> t1(n), t2(n);
+        for (std::size_t i = 0; i < n; ++i) t1[i] = in.b[i] * in.c[i];
+        for (std::size_t i = 0; i < n; ++i) t2[i] = in.a[i] + t1[i];
+        for (std::size_t i = 0; i < n; ++i) in.out[i] = t2[i] - in.d[i];
+        benchmark::DoNotOptimize(in.out.data());
+    }
+    set_bytes(state);
+}
+
+// 对照：手写 的 一趟 循环（只有 编译器 自动 向量化，基础 指令集）
+static void BM_expr_hand_loop(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    inputs in(n);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n; ++i) in.out[i] = in.a[i] + in.b[i] * in.c[i] - in.d[i];
+        benchmark::DoNotOptimize(in.out.data());
+    }
+    set_bytes(state);
+}
+
+static void BM_expr_fused(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    inputs in(n);
+    const e_math::array_view a(in.a), b(in.b), c(in.c), d(in.d);
+    e_math::array_view out(in.out);
+    for (auto _ : state) {
+        out = a + b * c - d;
+        benchmark::DoNotOptimize(in.out.data());
+    }
+    set_bytes(state);
+}
+
+static void BM_expr_fused_parallel(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    inputs in(n);
+    const e_math::array_view a(in.a), b(in.b), c(in.c), d(in.d);
+    e_math::array_view out(in.out);
+    for (auto _ : state) {
+        out.assign(a + b * c - d, e_math::execution::parallel);
+        benchmark::DoNotOptimize(in.out.data());
+    }
+    set_bytes(state);
+}
+
+BENCHMARK(BM_expr_temporaries)->Apply(sizes);
+BENCHMARK(BM_expr_hand_loop)->Apply(sizes);
+BENCHMARK(BM_expr_fused)->Apply(sizes);
+BENCHMARK(BM_expr_fused_parallel)->Apply(sizes);
@@ -0,0 +1,132 @@
+#include <benchmark/benchmark.h>
+
+#include "e_fft.hpp"
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <random>
+#include <vector>
+
+namespace {
+    template <class T>
+    std::vector<std::complex<T>> make_input(std::size_t n) {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<T> d(-1, 1);
+        std::vector<std::complex<T>> v(n);
+        for (auto& x : v) x = {d(rng), d(rng)};
+        return v;
+    }
+
+    // 对照：教科书式 的 原地 基 2（位反转 + 逐级 蝶形，std::complex），旋转因子 预先 算好
+    template <class T>
+    void textbook_fft(std::vector<std::complex<T>>& a, const std::vector<std::complex<T>>& roots) {
+        const std::size_t n = a.size();
+        for (std::size_t i = 1, j = 0; i < n; ++i) {
+            std::size_t bit = n >> 1;
+            for (; j & bit; bit >>= 1) j ^= bit;
+            j ^= bit;
+            if (i < j) std::swap(a[i], a[j]);
+        }
+        for (std::size_t len = 2; len <= n; len <<= 1) {
+            const std::size_t step = n / len;
+            for (std::size_t i = 0; i < n; i += len) {
+                for (std::size_t k = 0; k < len / 2; ++k) {
+                    const std::complex<T> u = a[i + k];
+                    const std::complex<T> v = a[i + k + len / 2] * roots[k * step];
+                    a[i + k] = u + v;
+                    a[i + k + len / 2] = u - v;
+                }
+            }
+        }
+    }
+
+    // 按 5 n log2(n) 次 浮点运算 折算 的 GFLOPS，方便 不同 长度 比较
+    void set_flops(benchmark::State& state, std::size_t n, std::size_t count = 1) {
+        const double flops = 5.0 * static_cast<double>(n) * std::log2(static_cast<double>(n)) * static_cast<double>(count);
+        state.counters["GFLOPS"] = benchmark::Counter(flops * 1e-9 * static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * n * count));
+    }
+
+    void pow2_args(benchmark::internal::Benchmark* b) {
+        for (std::int64_t n : {1 << 8, 1 << 10, 1 << 12, 1 << 16, 1 << 20}) b->Arg(n);
+        b->ArgName("n")->Unit(benchmark::kMicrosecond);
+    }
+
+    // 2^a 3^b 5^c 混合 与 含 素因子 7 / 11 的 长度
+    void mixed_args(benchmark::internal::Benchmark* b) {
+        for (std::int64_t n : {1000, 1536, 3000, 2310, 46656, 100000}) b->Arg(n);
+        b->ArgName("n")->Unit(benchmark::kMicrosecond);
+    }
+}
+
+template <class T>
+static void BM_textbook_fft(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto input = make_input<T>(n);
+    std::vector<std::complex<T>> roots(n / 2), a(n);
+    for (std::size_t k = 0; k < n / 2; ++k) roots[k] = std::polar(T(1), static_cast<T>(-2 * std::numbers::pi * static_cast<double>(k) / static_cast<double>(n)));
+    for (auto _ : state) {
+        a = input;
+        textbook_fft(a, roots);
+        benchmark::DoNotOptimize(a.data());
+    }
+    set_flops(state, n);
+}
+
+template <class T>
+static void BM_fft(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto input = make_input<T>(n);
+    const auto plan = e_math::fft_plan<T>::cached(n);
+    std::vector<std::complex<T>> out(n);
+    for (auto _ : state) {
+        plan->forward(input, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    set_flops(state, n);
+}
+
+template <class T>
+static void BM_rfft(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    std::vector<T> input(n);
+    for (std::size_t i = 0; i < n; ++i) input[i] = static_cast<T>(std::sin(0.001 * static_cast<double>(i * i)));
+    const auto plan = e_math::rfft_plan<T>::cached(n);
+    std::vector<std::complex<T>> out(n / 2 + 1);
+    for (auto _ : state) {
+        plan->forward(input, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    // 实数 FFT 约 是 同长度 复数 FFT 的 一半 运算
+    set_flops(state, n);
+    state.counters["GFLOPS"].value /= 2;
+}
+
+// 多个 独立 信号 一次 调用，跨线程
+template <class T>
+static void BM_fft_batch(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto count = static_cast<std::size_t>(state.range(1));
+    const auto input = make_input<T>(n * count);
+    const auto plan = e_math::fft_plan<T>::cached(n);
+    std::vector<std::complex<T>> out(n * count);
+    for (auto _ : state) {
+        plan->forward(input, out, count);
+        benchmark::DoNotOptimize(out.data());
+    }
+    set_flops(state, n, count);
+}
+
+BENCHMARK_TEMPLATE(BM_textbook_fft, float)->Apply(pow2_args);
+BENCHMARK_TEMPLATE(BM_fft, float)->Apply(pow2_args);
+BENCHMARK_TEMPLATE(BM_textbook_fft, double)->Apply(pow2_args);
+BENCHMARK_TEMPLATE(BM_fft, double)->Apply(pow2_args);
+BENCHMARK_TEMPLATE(BM_fft, float)->Apply(mixed_args);
+BENCHMARK_TEMPLATE(BM_fft, double)->Apply(mixed_args);
+BENCHMARK_TEMPLATE(BM_rfft, float)->Apply(pow2_args);
+BENCHMARK_TEMPLATE(BM_rfft, double)->Apply(pow2_args);
+BENCHMARK_TEMPLATE(BM_fft_batch, float)->Args({1024, 4096})->Args({4096, 1024})->ArgNames({"n", "count"})->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_fft_batch, double)->Args({1024, 4096})->Args({4096, 1024})->ArgNames({"n", "count"})->Unit(benchmark::kMillisecond)->UseRealTime();
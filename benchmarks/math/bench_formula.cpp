@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+
+#include "e_expr.hpp"
+#include "e_formula.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+    std::vector<double> random_doubles(std::size_t n, unsigned seed) {
+        std::mt19937_64 rng(seed);
+        std::uniform_real_distribution<double> dist(0.5, 2.0);
+        std::vector<double> v(n);
+        for (auto& x : v) x = dist(rng);
+        return v;
+    }
+
+    struct inputs {
+        std::vector<double> price, qty, fee, out;
+
+        explicit inputs(std::size_t n) : price(random_doubles(n, 1)), qty(random_doubles(n, 2)), fee(random_doubles(n, 3)), out(n) {}
+    };
+
+    const char* const kFormula = "clamp(price * qty - fee * (price * qty) * 0.01, 0, 3)";
+
+    void sizes(benchmark::internal::Benchmark* b) {
+        for (std::int64_t n : {1 << 10, 1 << 16, 1 << 20}) b->Arg(n);
+        b->ArgName("n");
+    }
+}
+
+static void BM_formula_compile(benchmark::State& state) {
+    for (auto _ : state) {
+        e_math::formula f(kFormula, {"price", "qty", "fee"});
+        benchmark::DoNotOptimize(f);
+    }
+}
+
+static void BM_formula_evaluate(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    inputs in(n);
+    const e_math::formula f(kFormula, {"price", "qty", "fee"});
+    for (auto _ : state) {
+        f.evaluate({in.price, in.qty, in.fee}, in.out);
+        benchmark::DoNotOptimize(in.out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 对照：编译期 的 表达式 模板，同样 按 块 调用 内核
+static void BM_formula_expr_template(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    inputs in(n);
+    const e_math::array_view price(in.price), qty(in.qty), fee(in.fee);
+    e_math::array_view out(in.out);
+    for (auto _ : state) {
+        out = e_math::clamp(price * qty - fee * (price * qty) * 0.01, 0.0, 3.0);
+        benchmark::DoNotOptimize(in.out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 对照：手写 循环
+static void BM_formula_hand_loop(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    inputs in(n);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n; ++i) {
+            const double v = in.price[i] * in.qty[i];
+            in.out[i] = std::min(std::max(v - in.fee[i] * v * 0.01, 0.0), 3.0);
+        }
+        benchmark::DoNotOptimize(in.out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_formula_compile);
+BENCHMARK(BM_formula_evaluate)->Apply(sizes);
+BENCHMARK(BM_formula_expr_template)->Apply(sizes);
+BENCHMARK(BM_formula_hand_loop)->Apply(sizes);
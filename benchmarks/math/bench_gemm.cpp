@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+
+#include "e_gemm.hpp"
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace {
+    struct operands {
+        std::size_t n;
+        std::vector<float> a;
+        std::vector<float> b;
+        std::vector<float> c;
+
+        explicit operands(std::size_t size) : n(size), a(size * size), b(size * size), c(size * size) {
+            std::mt19937 rng(42);
+            std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+            for (auto& x : a) x = dist(rng);
+            for (auto& x : b) x = dist(rng);
+        }
+    };
+
+    void set_flops(benchmark::State& state, std::size_t n) {
+        state.counters["FLOPS"] = benchmark::Counter(2.0 * static_cast<double>(n * n * n), benchmark::Counter::kIsIterationInvariantRate);
+    }
+}
+
+// 朴素三重循环，i-k-j 顺序：最内层 连续访问，编译器 可以自动向量化
+static void BM_gemm_naive(benchmark::State& state) {
+    operands m(static_cast<std::size_t>(state.range(0)));
+    const std::size_t n = m.n;
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n; ++i) {
+            float* c = &m.c[i * n];
+            for (std::size_t j = 0; j < n; ++j) c[j] = 0.0f;
+            for (std::size_t p = 0; p < n; ++p) {
+                float a = m.a[i * n + p];
+                const float* b = &m.b[p * n];
+                for (std::size_t j = 0; j < n; ++j) c[j] += a * b[j];
+            }
+        }
+        benchmark::DoNotOptimize(m.c.data());
+        benchmark::ClobberMemory();
+    }
+    set_flops(state, n);
+}
+BENCHMARK(BM_gemm_naive)->Arg(64)->Arg(512)->Arg(4096)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_gemm(benchmark::State& state) {
+    operands m(static_cast<std::size_t>(state.range(0)));
+    const std::size_t n = m.n;
+    for (auto _ : state) {
+        e_math::gemm(e_math::matrix_view<const float>{m.a.data(), n, n, n},
+                     e_math::matrix_view<const float>{m.b.data(), n, n, n},
+                     e_math::matrix_view<float>{m.c.data(), n, n, n});
+        benchmark::DoNotOptimize(m.c.data());
+        benchmark::ClobberMemory();
+    }
+    set_flops(state, n);
+}
+// 多线程：按 墙上时间 计
+BENCHMARK(BM_gemm)->Arg(64)->Arg(512)->Arg(4096)->Unit(benchmark::kMillisecond)->UseRealTime();
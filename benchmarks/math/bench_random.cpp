@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+
+#include "e_random.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+    constexpr std::size_t kCount = 1 << 16;
+
+    void set_items(benchmark::State& state) {
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kCount));
+    }
+}
+
+// 基准：std::mt19937 + std::normal_distribution 逐个 生成
+static void BM_normal_std(benchmark::State& state) {
+    std::mt19937 rng(1);
+    std::normal_distribution<float> dist;
+    std::vector<float> out(kCount);
+    for (auto _ : state) {
+        for (auto& x : out) x = dist(rng);
+        benchmark::DoNotOptimize(out.data());
+    }
+    set_items(state);
+}
+BENCHMARK(BM_normal_std);
+
+static void BM_normal_xoshiro(benchmark::State& state) {
+    e_math::xoshiro256pp g(1);
+    std::vector<float> out(kCount);
+    for (auto _ : state) {
+        e_math::fill_normal(g, std::span<float>(out));
+        benchmark::DoNotOptimize(out.data());
+    }
+    set_items(state);
+}
+BENCHMARK(BM_normal_xoshiro);
+
+static void BM_normal_philox(benchmark::State& state) {
+    e_math::philox4x32 g(1);
+    std::vector<float> out(kCount);
+    for (auto _ : state) {
+        e_math::fill_normal(g, std::span<float>(out));
+        benchmark::DoNotOptimize(out.data());
+    }
+    set_items(state);
+}
+BENCHMARK(BM_normal_philox);
+
+static void BM_uniform_std(benchmark::State& state) {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> dist;
+    std::vector<float> out(kCount);
+    for (auto _ : state) {
+        for (auto& x : out) x = dist(rng);
+        benchmark::DoNotOptimize(out.data());
+    }
+    set_items(state);
+}
+BENCHMARK(BM_uniform_std);
+
+static void BM_uniform_xoshiro(benchmark::State& state) {
+    e_math::xoshiro256pp g(1);
+    std::vector<float> out(kCount);
+    for (auto _ : state) {
+        e_math::fill_uniform(g, std::span<float>(out));
+        benchmark::DoNotOptimize(out.data());
+    }
+    set_items(state);
+}
+BENCHMARK(BM_uniform_xoshiro);
+
+static void BM_uniform_philox(benchmark::State& state) {
+    e_math::philox4x32 g(1);
+    std::vector<float> out(kCount);
+    for (auto _ : state) {
+        e_math::fill_uniform(g, std::span<float>(out));
+        benchmark::DoNotOptimize(out.data());
+    }
+    set_items(state);
+}
+BENCHMARK(BM_uniform_philox);
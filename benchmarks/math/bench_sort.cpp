@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+
+#include "e_sort.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+    // 分布：0 = 全范围 均匀，1 = 只有 1000 个 不同值，2 = 基本有序（1% 随机交换）
+    template <class T>
+    std::vector<T> make_input(std::size_t n, int dist) {
+        std::mt19937_64 rng(42);
+        std::vector<T> v(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (dist == 0) {
+                if constexpr (std::is_floating_point_v<T>) {
+                    v[i] = static_cast<T>(std::normal_distribution<double>(0.0, 1e3)(rng));
+                } else {
+                    v[i] = static_cast<T>(rng());
+                }
+            } else if (dist == 1) {
+                v[i] = static_cast<T>(rng() % 1000);
+            } else {
+                v[i] = static_cast<T>(i);
+            }
+        }
+        if (dist == 2) {
+            for (std::size_t k = 0; k < n / 100; ++k) std::swap(v[rng() % n], v[rng() % n]);
+        }
+        return v;
+    }
+
+    // 每次 迭代 先 复制 输入，三种 排序 都包含 这次 复制
+    template <class T, class Sort>
+    void run(benchmark::State& state, Sort sort) {
+        const auto n = static_cast<std::size_t>(state.range(0));
+        const auto input = make_input<T>(n, static_cast<int>(state.range(1)));
+        std::vector<T> v(n);
+        for (auto _ : state) {
+            std::copy(input.begin(), input.end(), v.begin());
+            sort(v);
+            benchmark::DoNotOptimize(v.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * n));
+    }
+
+    void sort_args(benchmark::internal::Benchmark* b) {
+        for (int dist : {0, 1, 2}) {
+            for (std::int64_t n : {1 << 10, 1 << 12, 1 << 16, 1 << 20, 1 << 24}) b->Args({n, dist});
+        }
+        b->ArgNames({"n", "dist"})->Unit(benchmark::kMicrosecond)->UseRealTime();
+    }
+}
+
+template <class T>
+static void BM_std_sort(benchmark::State& state) {
+    run<T>(state, [](std::vector<T>& v) { std::sort(v.begin(), v.end()); });
+}
+
+template <class T>
+static void BM_std_stable_sort(benchmark::State& state) {
+    run<T>(state, [](std::vector<T>& v) { std::stable_sort(v.begin(), v.end()); });
+}
+
+template <class T>
+static void BM_radix_sort(benchmark::State& state) {
+    run<T>(state, [](std::vector<T>& v) { e_math::radix_sort(std::span<T>(v)); });
+}
+
+BENCHMARK_TEMPLATE(BM_std_sort, std::uint32_t)->Apply(sort_args);
+BENCHMARK_TEMPLATE(BM_std_stable_sort, std::uint32_t)->Apply(sort_args);
+BENCHMARK_TEMPLATE(BM_radix_sort, std::uint32_t)->Apply(sort_args);
+BENCHMARK_TEMPLATE(BM_std_sort, std::uint64_t)->Apply(sort_args);
+BENCHMARK_TEMPLATE(BM_std_stable_sort, std::uint64_t)->Apply(sort_args);
+BENCHMARK_TEMPLATE(BM_radix_sort, std::uint64_t)->Apply(sort_args);
+BENCHMARK_TEMPLATE(BM_std_sort, float)->Apply(sort_args);
+BENCHMARK_TEMPLATE(BM_std_stable_sort, float)->Apply(sort_args);
+BENCHMARK_TEMPLATE(BM_radix_sort, float)->Apply(sort_args);
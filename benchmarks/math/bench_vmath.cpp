@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+
+#include "e_vmath.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+    constexpr std::size_t kCount = 1 << 16;
+
+    std::vector<float> inputs(float lo, float hi) {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> dist(lo, hi);
+        std::vector<float> v(kCount);
+        for (auto& x : v) x = dist(rng);
+        return v;
+    }
+
+    template <class F>
+    void run_libm(benchmark::State& state, float lo, float hi, F f) {
+        auto in = inputs(lo, hi);
+        std::vector<float> out(kCount);
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < kCount; ++i) out[i] = f(in[i]);
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kCount));
+    }
+
+    template <class F>
+    void run_vmath(benchmark::State& state, float lo, float hi, F f) {
+        auto in = inputs(lo, hi);
+        std::vector<float> out(kCount);
+        auto p = state.range(0) == 0 ? e_math::precision::accurate : e_math::precision::fast;
+        for (auto _ : state) {
+            f(std::span<const float>(in), std::span<float>(out), p);
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kCount));
+    }
+
+    using vmath_fn = void (*)(std::span<const float>, std::span<float>, e_math::precision);
+}
+
+// 逐个 调用 libm
+static void BM_exp_libm(benchmark::State& state) {
+    run_libm(state, -80.0f, 80.0f, [](float x) { return std::exp(x); });
+}
+BENCHMARK(BM_exp_libm);
+
+static void BM_log_libm(benchmark::State& state) {
+    run_libm(state, 1e-3f, 1e3f, [](float x) { return std::log(x); });
+}
+BENCHMARK(BM_log_libm);
+
+static void BM_sin_libm(benchmark::State& state) {
+    run_libm(state, -100.0f, 100.0f, [](float x) { return std::sin(x); });
+}
+BENCHMARK(BM_sin_libm);
+
+static void BM_tanh_libm(benchmark::State& state) {
+    run_libm(state, -10.0f, 10.0f, [](float x) { return std::tanh(x); });
+}
+BENCHMARK(BM_tanh_libm);
+
+// 参数：0 = accurate，1 = fast
+static void BM_exp(benchmark::State& state) {
+    run_vmath(state, -80.0f, 80.0f, static_cast<vmath_fn>(e_math::exp));
+}
+BENCHMARK(BM_exp)->Arg(0)->Arg(1);
+
+static void BM_log(benchmark::State& state) {
+    run_vmath(state, 1e-3f, 1e3f, static_cast<vmath_fn>(e_math::log));
+}
+BENCHMARK(BM_log)->Arg(0)->Arg(1);
+
+static void BM_sin(benchmark::State& state) {
+    run_vmath(state, -100.0f, 100.0f, static_cast<vmath_fn>(e_math::sin));
+}
+BENCHMARK(BM_sin)->Arg(0)->Arg(1);
+
+static void BM_tanh(benchmark::State& state) {
+    run_vmath(state, -10.0f, 10.0f, static_cast<vmath_fn>(e_math::tanh));
+}
+BENCHMARK(BM_tanh)->Arg(0)->Arg(1);
@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+
+#include "e_arena.hpp"
+
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    // 模拟 一个 请求：解析 出 一批 头部（字符串），建 一个 索引，再 建 一串 小 对象，算 个 结果，最后 全部 释放
+    // 同一份 代码，只 换 memory_resource；new_delete_resource 就是 全局 new / delete
+    struct node {
+        node* next;
+        std::uint64_t id;
+        double weight;
+    };
+
+    std::uint64_t handle_request(std::pmr::memory_resource* mr, int seed) {
+        std::pmr::polymorphic_allocator<> alloc(mr);
+
+        std::pmr::vector<std::pmr::string> headers(alloc);
+        for (int i = 0; i < 64; ++i) {
+            headers.emplace_back("x-request-header-" + std::to_string(seed + i) + ": some value that is long enough");
+        }
+
+        std::pmr::unordered_map<std::pmr::string, int> index(alloc);
+        for (int i = 0; i < 64; ++i) index.emplace(headers[i], i);
+
+        node* head = nullptr;
+        for (int i = 0; i < 1000; ++i) {
+            head = alloc.new_object<node>(node{head, static_cast<std::uint64_t>(seed + i), 0.5 * i});
+        }
+
+        std::uint64_t sum = index.size();
+        for (node* n = head; n != nullptr;) {
+            sum += n->id;
+            node* next = n->next;
+            alloc.delete_object(n);
+            n = next;
+        }
+        return sum;
+    }
+}
+
+static void BM_request_new_delete(benchmark::State& state) {
+    int seed = 0;
+    for (auto _ : state) benchmark::DoNotOptimize(handle_request(std::pmr::new_delete_resource(), ++seed));
+    state.SetItemsProcessed(state.iterations());
+}
+
+// 标准库 自带 的 单调 资源，每个 请求 新建 一个，初始 缓冲 在 栈 上
+static void BM_request_pmr_monotonic(benchmark::State& state) {
+    int seed = 0;
+    for (auto _ : state) {
+        std::byte buffer[16 * 1024];
+        std::pmr::monotonic_buffer_resource mr(buffer, sizeof(buffer));
+        benchmark::DoNotOptimize(handle_request(&mr, ++seed));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// arena 跨 请求 复用，请求 结束 reset()
+static void BM_request_arena(benchmark::State& state) {
+    e_utils::arena a({.block_bytes = static_cast<std::size_t>(state.range(0)), .huge_pages = state.range(1) != 0});
+    int seed = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(handle_request(&a, ++seed));
+        a.reset();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["reserved_kb"] = static_cast<double>(a.reserved_bytes()) / 1024;
+}
+
+// 纯 分配：bump pointer 与 全局 new 的 差距
+static void BM_alloc_32_new_delete(benchmark::State& state) {
+    std::vector<void*> ptrs(1024);
+    for (auto _ : state) {
+        for (auto& p : ptrs) p = ::operator new(32);
+        benchmark::DoNotOptimize(ptrs.data());
+        for (void* p : ptrs) ::operator delete(p);
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+
+static void BM_alloc_32_arena(benchmark::State& state) {
+    e_utils::arena a;
+    std::vector<void*> ptrs(1024);
+    for (auto _ : state) {
+        for (auto& p : ptrs) p = a.alloc(32, 16);
+        benchmark::DoNotOptimize(ptrs.data());
+        a.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+
+BENCHMARK(BM_request_new_delete);
+BENCHMARK(BM_request_pmr_monotonic);
+BENCHMARK(BM_request_arena)->Args({64 * 1024, 0})->Args({2 << 20, 1})->ArgNames({"block", "huge"});
+BENCHMARK(BM_alloc_32_new_delete);
+BENCHMARK(BM_alloc_32_arena);
@@ -0,0 +1,103 @@
+#include <benchmark/benchmark.h>
+
+#include "e_filter.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+    // 前 n 个 插入 过滤器，查询 用 一半 在、一半 不在 的 混合
+    struct workload {
+        std::vector<std::uint64_t> inserted, queries;
+        std::unique_ptr<bool[]> out;
+
+        explicit workload(std::size_t n) : inserted(n), queries(n), out(new bool[n]) {
+            std::mt19937_64 rng(n);
+            for (auto& h : inserted) h = rng();
+            for (std::size_t i = 0; i < n; ++i) queries[i] = i % 2 == 0 ? inserted[i] : rng();
+        }
+    };
+
+    void sizes(benchmark::internal::Benchmark* b) {
+        // 小 的 在 L2 里，大 的 远 超 LLC
+        for (std::int64_t n : {1 << 12, 1 << 16, 1 << 22}) b->Arg(n);
+        b->ArgName("n");
+    }
+
+    template <class Filter>
+    void query_loop(benchmark::State& state, const Filter& f, const workload& w) {
+        for (auto _ : state) {
+            std::size_t hits = 0;
+            for (std::uint64_t h : w.queries) hits += f.contains(h);
+            benchmark::DoNotOptimize(hits);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(w.queries.size()));
+    }
+
+    template <class Filter>
+    void query_batch(benchmark::State& state, const Filter& f, const workload& w) {
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(f.contains(w.queries, std::span<bool>(w.out.get(), w.queries.size())));
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(w.queries.size()));
+    }
+
+    e_utils::bloom_filter make_bloom(const workload& w) {
+        e_utils::bloom_filter f(w.inserted.size(), 0.01);
+        f.insert(w.inserted);
+        return f;
+    }
+
+    e_utils::cuckoo_filter make_cuckoo(const workload& w) {
+        e_utils::cuckoo_filter f(w.inserted.size(), 0.001);
+        for (std::uint64_t h : w.inserted) f.insert(h);
+        return f;
+    }
+}
+
+static void BM_bloom_insert(benchmark::State& state) {
+    const workload w(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        e_utils::bloom_filter f(w.inserted.size(), 0.01);
+        f.insert(w.inserted);
+        benchmark::DoNotOptimize(f.bytes().data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_bloom_contains(benchmark::State& state) {
+    const workload w(static_cast<std::size_t>(state.range(0)));
+    query_loop(state, make_bloom(w), w);
+}
+
+static void BM_bloom_contains_batch(benchmark::State& state) {
+    const workload w(static_cast<std::size_t>(state.range(0)));
+    query_batch(state, make_bloom(w), w);
+}
+
+static void BM_cuckoo_insert(benchmark::State& state) {
+    const workload w(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(make_cuckoo(w).bytes().data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_cuckoo_contains(benchmark::State& state) {
+    const workload w(static_cast<std::size_t>(state.range(0)));
+    query_loop(state, make_cuckoo(w), w);
+}
+
+static void BM_cuckoo_contains_batch(benchmark::State& state) {
+    const workload w(static_cast<std::size_t>(state.range(0)));
+    query_batch(state, make_cuckoo(w), w);
+}
+
+BENCHMARK(BM_bloom_insert)->Apply(sizes);
+BENCHMARK(BM_bloom_contains)->Apply(sizes);
+BENCHMARK(BM_bloom_contains_batch)->Apply(sizes);
+BENCHMARK(BM_cuckoo_insert)->Apply(sizes);
+BENCHMARK(BM_cuckoo_contains)->Apply(sizes);
+BENCHMARK(BM_cuckoo_contains_batch)->Apply(sizes);
@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+
+#include "e_flat_hash_map.hpp"
+
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    using flat_map = e_utils::flat_hash_map<std::uint64_t, std::uint64_t>;
+    using std_map = std::unordered_map<std::uint64_t, std::uint64_t>;
+
+    // 前 n 个 是 表 里 的 键，后 n 个 不在 表 里
+    std::vector<std::uint64_t> random_keys(std::size_t n) {
+        std::mt19937_64 rng(n);
+        std::vector<std::uint64_t> v(2 * n);
+        for (auto& x : v) x = rng() | 1;
+        for (std::size_t i = n; i < v.size(); ++i) v[i] &= ~std::uint64_t{1};
+        return v;
+    }
+
+    void sizes(benchmark::internal::Benchmark* b) {
+        for (std::int64_t n : {1 << 10, 1 << 16, 1 << 20}) b->Arg(n);
+        b->ArgName("n");
+    }
+
+    template <class Map>
+    Map filled(const std::vector<std::uint64_t>& keys, std::size_t n) {
+        Map m;
+        for (std::size_t i = 0; i < n; ++i) m[keys[i]] = i;
+        return m;
+    }
+}
+
+// 从 空表 插入 n 个（含 扩容）
+template <class Map>
+static void BM_hash_map_insert(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto keys = random_keys(n);
+    for (auto _ : state) {
+        Map m;
+        for (std::size_t i = 0; i < n; ++i) m.emplace(keys[i], i);
+        benchmark::DoNotOptimize(m.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class Map>
+static void BM_hash_map_find_hit(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto keys = random_keys(n);
+    const Map m = filled<Map>(keys, n);
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < n; ++i) sum += m.find(keys[i])->second;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class Map>
+static void BM_hash_map_find_miss(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto keys = random_keys(n);
+    const Map m = filled<Map>(keys, n);
+    for (auto _ : state) {
+        std::size_t found = 0;
+        for (std::size_t i = n; i < 2 * n; ++i) found += m.count(keys[i]);
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 删掉 一半 再 插回，墓碑 路径
+template <class Map>
+static void BM_hash_map_erase_reinsert(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto keys = random_keys(n);
+    Map m = filled<Map>(keys, n);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n; i += 2) m.erase(keys[i]);
+        for (std::size_t i = 0; i < n; i += 2) m.emplace(keys[i], i);
+        benchmark::DoNotOptimize(m.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_hash_map_insert<flat_map>)->Apply(sizes);
+BENCHMARK(BM_hash_map_insert<std_map>)->Apply(sizes);
+BENCHMARK(BM_hash_map_find_hit<flat_map>)->Apply(sizes);
+BENCHMARK(BM_hash_map_find_hit<std_map>)->Apply(sizes);
+BENCHMARK(BM_hash_map_find_miss<flat_map>)->Apply(sizes);
+BENCHMARK(BM_hash_map_find_miss<std_map>)->Apply(sizes);
+BENCHMARK(BM_hash_map_erase_reinsert<flat_map>)->Apply(sizes);
+BENCHMARK(BM_hash_map_erase_reinsert<std_map>)->Apply(sizes);
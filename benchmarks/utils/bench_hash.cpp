@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+
+#include "e_hash.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    std::string random_bytes(std::size_t n) {
+        std::mt19937 rng(static_cast<unsigned>(n));
+        std::string s(n, '\0');
+        for (auto& c : s) c = static_cast<char>(rng());
+        return s;
+    }
+
+    void sizes(benchmark::internal::Benchmark* b) {
+        for (std::int64_t n : {8, 64, 1 << 10, 1 << 16}) b->Arg(n);
+        b->ArgName("bytes");
+    }
+
+    // 8 ~ 24 字节 的 键，像 用户名、订单号
+    struct short_keys {
+        std::vector<std::string> storage;
+        std::vector<std::string_view> keys;
+        std::vector<std::uint64_t> out;
+
+        explicit short_keys(std::size_t n) : out(n) {
+            std::mt19937 rng(1);
+            for (std::size_t i = 0; i < n; ++i) storage.push_back(random_bytes(8 + rng() % 17));
+            keys.assign(storage.begin(), storage.end());
+        }
+    };
+
+    constexpr std::size_t kKeys = 4096;
+}
+
+static void BM_hash64(benchmark::State& state) {
+    const std::string s = random_bytes(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) benchmark::DoNotOptimize(e_utils::hash64(s));
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_hash128(benchmark::State& state) {
+    const std::string s = random_bytes(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) benchmark::DoNotOptimize(e_utils::hash128(s));
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_crc32c(benchmark::State& state) {
+    const std::string s = random_bytes(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) benchmark::DoNotOptimize(e_utils::crc32c(s));
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// 对照：标准库 的 字符串 哈希
+static void BM_std_hash(benchmark::State& state) {
+    const std::string s = random_bytes(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) benchmark::DoNotOptimize(std::hash<std::string_view>{}(s));
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// 短键：逐个 调用 与 批量 交错
+static void BM_hash64_short_keys_loop(benchmark::State& state) {
+    short_keys k(kKeys);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < kKeys; ++i) k.out[i] = e_utils::hash64(k.keys[i]);
+        benchmark::DoNotOptimize(k.out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kKeys));
+}
+
+static void BM_hash64_short_keys_batch(benchmark::State& state) {
+    short_keys k(kKeys);
+    for (auto _ : state) {
+        e_utils::hash64_batch(k.keys, k.out);
+        benchmark::DoNotOptimize(k.out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kKeys));
+}
+
+BENCHMARK(BM_hash64)->Apply(sizes);
+BENCHMARK(BM_hash128)->Apply(sizes);
+BENCHMARK(BM_crc32c)->Apply(sizes);
+BENCHMARK(BM_std_hash)->Apply(sizes);
+BENCHMARK(BM_hash64_short_keys_loop);
+BENCHMARK(BM_hash64_short_keys_batch);
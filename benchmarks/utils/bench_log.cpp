@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include "e_log.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace {
+    // 每轮 写 burst 条（缓冲 放得下），不计时 地 等 后台 写完：量 的 是 调用 线程 的 开销，不会 丢
+    constexpr int burst = 4096;
+
+    void quiet_options(e_utils::log_full_policy policy) {
+        e_utils::log_options options;
+        options.full_policy = policy;
+        options.sink = [](std::string_view) {};
+        e_utils::set_log_options(std::move(options));
+    }
+
+    template <class F>
+    void burst_loop(benchmark::State& state, F log_one) {
+        quiet_options(e_utils::log_full_policy::drop);
+        const std::uint64_t dropped = e_utils::log_dropped();
+        int i = 0;
+        for (auto _ : state) {
+            for (int k = 0; k < burst; ++k) log_one(++i);
+            state.PauseTiming();
+            e_utils::log_flush();
+            state.ResumeTiming();
+        }
+        state.SetItemsProcessed(state.iterations() * burst);
+        state.counters["dropped"] = static_cast<double>(e_utils::log_dropped() - dropped);
+        e_utils::set_log_options({});
+    }
+}
+
+static void BM_log_disabled(benchmark::State& state) {
+    burst_loop(state, [](int i) { E_LOG_DEBUG("value {}", i); });
+}
+
+static void BM_log_no_args(benchmark::State& state) {
+    burst_loop(state, [](int) { E_LOG_INFO("request done"); });
+}
+
+static void BM_log_ints(benchmark::State& state) {
+    burst_loop(state, [](int i) { E_LOG_INFO("add({}, {}) = {}", i, 2, i + 2); });
+}
+
+static void BM_log_mixed(benchmark::State& state) {
+    const std::string user = "alice";
+    burst_loop(state, [&](int i) { E_LOG_INFO("user {} took {} ms, ok {}", user, 0.25 * i, true); });
+}
+
+// 持续 写，满 了 等 后台：吞吐 受 后台 格式化 速度 限制
+static void BM_log_ints_block(benchmark::State& state) {
+    if (state.thread_index() == 0) quiet_options(e_utils::log_full_policy::block);
+    int i = 0;
+    for (auto _ : state) {
+        ++i;
+        E_LOG_INFO("add({}, {}) = {}", i, 2, i + 2);
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) e_utils::log_flush();
+}
+
+BENCHMARK(BM_log_disabled);
+BENCHMARK(BM_log_no_args);
+BENCHMARK(BM_log_ints);
+BENCHMARK(BM_log_mixed);
+BENCHMARK(BM_log_ints_block)->Threads(1)->Threads(4)->UseRealTime();
@@ -0,0 +1,99 @@
+#include <benchmark/benchmark.h>
+
+#include "e_mpmc_queue.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+namespace {
+    // 对照：mutex + condition_variable 的 有界 队列
+    class locked_queue {
+    public:
+        explicit locked_queue(std::size_t capacity) : capacity_(capacity) {}
+
+        void push(std::uint64_t v) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            not_full_.wait(lock, [&] { return items_.size() < capacity_; });
+            items_.push_back(v);
+            lock.unlock();
+            not_empty_.notify_one();
+        }
+
+        std::uint64_t pop() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            not_empty_.wait(lock, [&] { return !items_.empty(); });
+            const std::uint64_t v = items_.front();
+            items_.pop_front();
+            lock.unlock();
+            not_full_.notify_one();
+            return v;
+        }
+
+    private:
+        std::size_t capacity_;
+        std::mutex mutex_;
+        std::condition_variable not_full_;
+        std::condition_variable not_empty_;
+        std::deque<std::uint64_t> items_;
+    };
+
+    constexpr std::size_t capacity = 1024;
+    constexpr std::int64_t batch = 16;
+}
+
+// 偶数 线程 生产，奇数 线程 消费，每轮 各 batch 个
+static void BM_mutex_condvar(benchmark::State& state) {
+    static locked_queue* q;
+    if (state.thread_index() == 0) q = new locked_queue(capacity);
+    const bool producer = state.thread_index() % 2 == 0;
+    for (auto _ : state) {
+        for (std::int64_t i = 0; i < batch; ++i) {
+            if (producer) {
+                q->push(static_cast<std::uint64_t>(i));
+            } else {
+                benchmark::DoNotOptimize(q->pop());
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+
+static void BM_blocking_mpmc(benchmark::State& state) {
+    static e_utils::blocking_mpmc_queue<std::uint64_t>* q;
+    if (state.thread_index() == 0) q = new e_utils::blocking_mpmc_queue<std::uint64_t>(capacity);
+    const bool producer = state.thread_index() % 2 == 0;
+    std::uint64_t v = 0;
+    for (auto _ : state) {
+        for (std::int64_t i = 0; i < batch; ++i) {
+            if (producer) {
+                q->push(static_cast<std::uint64_t>(i));
+            } else {
+                q->pop(v);
+                benchmark::DoNotOptimize(v);
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+
+static void BM_blocking_mpmc_bulk(benchmark::State& state) {
+    static e_utils::blocking_mpmc_queue<std::uint64_t>* q;
+    if (state.thread_index() == 0) q = new e_utils::blocking_mpmc_queue<std::uint64_t>(capacity);
+    const bool producer = state.thread_index() % 2 == 0;
+    std::uint64_t buf[batch] = {};
+    for (auto _ : state) {
+        if (producer) {
+            q->push_bulk(buf, batch);
+        } else {
+            for (std::size_t got = 0; got < batch;) got += q->pop_bulk(buf + got, batch - got);
+            benchmark::DoNotOptimize(buf);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+
+BENCHMARK(BM_mutex_condvar)->Threads(2)->Threads(4)->Threads(8)->UseRealTime();
+BENCHMARK(BM_blocking_mpmc)->Threads(2)->Threads(4)->Threads(8)->UseRealTime();
+BENCHMARK(BM_blocking_mpmc_bulk)->Threads(2)->Threads(4)->Threads(8)->UseRealTime();
@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+
+#include "e_object_pool.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace {
+    // 64 字节 的 消息 对象
+    struct message {
+        std::uint64_t id;
+        std::uint64_t payload[7];
+
+        explicit message(std::uint64_t i) : id(i), payload{} {}
+    };
+
+    // 每轮 持有 range(0) 个 对象 再 全部 释放
+    template <class Make>
+    void hold_and_release(benchmark::State& state, Make make) {
+        const auto n = static_cast<std::size_t>(state.range(0));
+        std::vector<decltype(make(0))> held;
+        held.reserve(n);
+        std::uint64_t i = 0;
+        for (auto _ : state) {
+            for (std::size_t k = 0; k < n; ++k) held.push_back(make(++i));
+            benchmark::DoNotOptimize(held.data());
+            held.clear();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+    }
+
+    e_utils::object_pool<message>& shared_pool() {
+        static e_utils::object_pool<message> pool;
+        return pool;
+    }
+}
+
+static void BM_make_unique(benchmark::State& state) {
+    hold_and_release(state, [](std::uint64_t i) { return std::make_unique<message>(i); });
+}
+
+static void BM_pool_make(benchmark::State& state) {
+    e_utils::object_pool<message> pool;
+    hold_and_release(state, [&](std::uint64_t i) { return pool.make(i); });
+}
+
+// 多 线程 各自 分配 / 释放，同 一个 池
+static void BM_make_unique_threads(benchmark::State& state) {
+    hold_and_release(state, [](std::uint64_t i) { return std::make_unique<message>(i); });
+}
+
+static void BM_pool_make_threads(benchmark::State& state) {
+    hold_and_release(state, [](std::uint64_t i) { return shared_pool().make(i); });
+}
+
+BENCHMARK(BM_make_unique)->Arg(16)->Arg(1024);
+BENCHMARK(BM_pool_make)->Arg(16)->Arg(1024);
+BENCHMARK(BM_make_unique_threads)->Arg(256)->Threads(4)->UseRealTime();
+BENCHMARK(BM_pool_make_threads)->Arg(256)->Threads(4)->UseRealTime();
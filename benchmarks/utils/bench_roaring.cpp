@@ -0,0 +1,110 @@
+#include <benchmark/benchmark.h>
+
+#include "e_roaring.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+
+namespace {
+    // 两个 集合，值 取自 [0, 2^24)，每 range(0) 个 值 里 取 一个：1 / 4 出 bitmap 容器，1 / 64 出 array 容器
+    struct workload {
+        std::vector<std::uint32_t> a, b;
+        e_utils::roaring_bitmap ra, rb;
+
+        explicit workload(std::uint32_t stride) {
+            std::mt19937 rng(stride);
+            for (std::uint32_t v = 0; v < (1u << 24); ++v) {
+                if (rng() % stride == 0) a.push_back(v);
+                if (rng() % stride == 0) b.push_back(v);
+            }
+            ra = e_utils::roaring_bitmap::from_values(a);
+            rb = e_utils::roaring_bitmap::from_values(b);
+        }
+    };
+
+    void strides(benchmark::internal::Benchmark* b) {
+        for (std::int64_t s : {4, 64, 1024}) b->Arg(s);
+        b->ArgName("stride");
+    }
+
+    void set_items(benchmark::State& state, const workload& w) {
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(w.a.size() + w.b.size()));
+    }
+}
+
+static void BM_roaring_and(benchmark::State& state) {
+    const workload w(static_cast<std::uint32_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize((w.ra & w.rb).empty());
+    }
+    set_items(state, w);
+}
+
+static void BM_sorted_vector_and(benchmark::State& state) {
+    const workload w(static_cast<std::uint32_t>(state.range(0)));
+    std::vector<std::uint32_t> out;
+    for (auto _ : state) {
+        out.clear();
+        std::set_intersection(w.a.begin(), w.a.end(), w.b.begin(), w.b.end(), std::back_inserter(out));
+        benchmark::DoNotOptimize(out.data());
+    }
+    set_items(state, w);
+}
+
+static void BM_roaring_and_cardinality(benchmark::State& state) {
+    const workload w(static_cast<std::uint32_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(e_utils::and_cardinality(w.ra, w.rb));
+    }
+    set_items(state, w);
+}
+
+static void BM_roaring_or(benchmark::State& state) {
+    const workload w(static_cast<std::uint32_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize((w.ra | w.rb).empty());
+    }
+    set_items(state, w);
+}
+
+static void BM_sorted_vector_or(benchmark::State& state) {
+    const workload w(static_cast<std::uint32_t>(state.range(0)));
+    std::vector<std::uint32_t> out;
+    for (auto _ : state) {
+        out.clear();
+        std::set_union(w.a.begin(), w.a.end(), w.b.begin(), w.b.end(), std::back_inserter(out));
+        benchmark::DoNotOptimize(out.data());
+    }
+    set_items(state, w);
+}
+
+static void BM_roaring_for_each(benchmark::State& state) {
+    const workload w(static_cast<std::uint32_t>(state.range(0)));
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        w.ra.for_each([&](std::uint32_t v) { sum += v; });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(w.a.size()));
+}
+
+static void BM_roaring_contains(benchmark::State& state) {
+    const workload w(static_cast<std::uint32_t>(state.range(0)));
+    for (auto _ : state) {
+        std::size_t hits = 0;
+        for (std::uint32_t v : w.b) hits += w.ra.contains(v);
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(w.b.size()));
+}
+
+BENCHMARK(BM_roaring_and)->Apply(strides);
+BENCHMARK(BM_sorted_vector_and)->Apply(strides);
+BENCHMARK(BM_roaring_and_cardinality)->Apply(strides);
+BENCHMARK(BM_roaring_or)->Apply(strides);
+BENCHMARK(BM_sorted_vector_or)->Apply(strides);
+BENCHMARK(BM_roaring_for_each)->Apply(strides);
+BENCHMARK(BM_roaring_contains)->Apply(strides);
@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+
+#include "e_thread_pool.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+    e_utils::thread_pool& pool() {
+        static e_utils::thread_pool p({.threads = 4});
+        return p;
+    }
+
+    // 每个 下标 一点 计算，模拟 逐 元素 内核
+    std::uint64_t mix(std::uint64_t x) {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        return x;
+    }
+}
+
+// 对照：每次 调用 现 开 线程
+static void BM_spawn_threads_for(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    std::vector<std::uint64_t> out(n);
+    for (auto _ : state) {
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t] {
+                for (std::size_t i = n * t / 4; i < n * (t + 1) / 4; ++i) out[i] = mix(i);
+            });
+        }
+        for (auto& th : threads) th.join();
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_pool_parallel_for(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    std::vector<std::uint64_t> out(n);
+    for (auto _ : state) {
+        pool().parallel_for(0, n, [&](std::size_t i) { out[i] = mix(i); });
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 提交 + 等待 一个 空 任务 的 往返 延迟
+static void BM_pool_submit_get(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pool().submit([] { return 1; }).get());
+    }
+}
+
+// 工作 线程 里 递归 提交：测 本地 队列 与 窃取
+static void BM_pool_fork_join(benchmark::State& state) {
+    struct fib {
+        static std::uint64_t run(e_utils::thread_pool& p, int n) {
+            if (n < 12) {
+                return n < 2 ? static_cast<std::uint64_t>(n) : run_serial(n - 1) + run_serial(n - 2);
+            }
+            auto left = p.submit([&p, n] { return run(p, n - 1); });
+            const std::uint64_t right = run(p, n - 2);
+            return left.get() + right;
+        }
+        static std::uint64_t run_serial(int n) { return n < 2 ? static_cast<std::uint64_t>(n) : run_serial(n - 1) + run_serial(n - 2); }
+    };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pool().submit([] { return fib::run(pool(), 24); }).get());
+    }
+}
+
+BENCHMARK(BM_spawn_threads_for)->Arg(1 << 10)->Arg(1 << 16)->UseRealTime();
+BENCHMARK(BM_pool_parallel_for)->Arg(1 << 10)->Arg(1 << 16)->UseRealTime();
+BENCHMARK(BM_pool_submit_get)->UseRealTime();
+BENCHMARK(BM_pool_fork_join)->UseRealTime();
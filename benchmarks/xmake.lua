@@ -0,0 +1,11 @@
+add_requires("benchmark")
+
+-- xmake build benchmarks
+-- xmake run benchmarks --benchmark_filter=gemm
+
+target("benchmarks")
+    set_kind("binary")
+    add_deps("math", "utils")
+    add_packages("benchmark")
+    set_default(false)
+    add_files("**.cpp")
@@ -1,14 +1,13 @@
 #include "e_hello.h"
+#include "e_log.hpp"
 #include "e_math.hpp"
 
-#include <iostream>
-
 int main(int argc, char** argv)
 {
     hello();
 
     int r = e_math::add(1, 2);
-    std::cout << "add(1, 2) = " << r << std::endl;
+    E_LOG_INFO("add(1, 2) = {}", r);
     
     return 0;
 }
\ No newline at end of file
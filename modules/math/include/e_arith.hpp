@@ -0,0 +1,239 @@
+#ifndef E_MATH_ARITH_H
+#define E_MATH_ARITH_H
+
+// 纯头文件的 算术核心：全部 constexpr、可内联，不经过动态库
+// 用法：e_math::add(a, b, e_math::saturate)，第三个参数 是 溢出策略
+//   wrap     整数按补码回绕；浮点即 IEEE 结果
+//   saturate 整数饱和到 [min, max]，无分支；浮点把 ±inf 收到 ±max
+//   checked  返回 checked_result{value, overflow}，value 为回绕后的值
+
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace e_math {
+    struct wrap_t {};
+    struct saturate_t {};
+    struct checked_t {};
+
+    inline constexpr wrap_t wrap{};
+    inline constexpr saturate_t saturate{};
+    inline constexpr checked_t checked{};
+
+    template <class T>
+    struct checked_result {
+        T value;
+        bool overflow;
+
+        constexpr bool operator==(const checked_result&) const = default;
+    };
+
+    // bool 和 字符类型 不参与算术
+    template <class T>
+    concept arithmetic_value = (std::integral<T> || std::floating_point<T>)
+        && !std::same_as<std::remove_cv_t<T>, bool>
+        && !std::same_as<std::remove_cv_t<T>, char>
+        && !std::same_as<std::remove_cv_t<T>, wchar_t>
+        && !std::same_as<std::remove_cv_t<T>, char8_t>
+        && !std::same_as<std::remove_cv_t<T>, char16_t>
+        && !std::same_as<std::remove_cv_t<T>, char32_t>;
+
+    template <class P>
+    concept overflow_policy = std::same_as<P, wrap_t> || std::same_as<P, saturate_t> || std::same_as<P, checked_t>;
+
+    namespace detail {
+        // 至少 unsigned int 宽，避免 uint16 * uint16 被提升成 int 后 有符号溢出
+        template <class T>
+        using wide_unsigned_t = std::conditional_t<(sizeof(T) < sizeof(unsigned)), unsigned, std::make_unsigned_t<T>>;
+
+        template <class T>
+        constexpr T wrap_add(T a, T b) noexcept {
+            using U = wide_unsigned_t<T>;
+            return static_cast<T>(static_cast<U>(static_cast<U>(a) + static_cast<U>(b)));
+        }
+
+        template <class T>
+        constexpr T wrap_sub(T a, T b) noexcept {
+            using U = wide_unsigned_t<T>;
+            return static_cast<T>(static_cast<U>(static_cast<U>(a) - static_cast<U>(b)));
+        }
+
+        template <class T>
+        constexpr T wrap_mul(T a, T b) noexcept {
+            using U = wide_unsigned_t<T>;
+            return static_cast<T>(static_cast<U>(static_cast<U>(a) * static_cast<U>(b)));
+        }
+
+        template <class T>
+        constexpr bool add_overflows(T a, T b, T r) noexcept {
+            if constexpr (std::is_signed_v<T>) {
+                // 同号相加 结果变号
+                return ((a ^ r) & (b ^ r)) < 0;
+            } else {
+                return r < a;
+            }
+        }
+
+        template <class T>
+        constexpr bool sub_overflows(T a, T b, T r) noexcept {
+            if constexpr (std::is_signed_v<T>) {
+                return ((a ^ b) & (a ^ r)) < 0;
+            } else {
+                return a < b;
+            }
+        }
+
+        template <class T>
+        constexpr bool mul_overflows(T a, T b) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            T r{};
+            return __builtin_mul_overflow(a, b, &r);
+#else
+            if constexpr (sizeof(T) < sizeof(std::int64_t)) {
+                using W = std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>;
+                W r = static_cast<W>(a) * static_cast<W>(b);
+                return r < static_cast<W>(std::numeric_limits<T>::min()) || r > static_cast<W>(std::numeric_limits<T>::max());
+            } else if constexpr (std::is_unsigned_v<T>) {
+                return a != 0 && wrap_mul(a, b) / a != b;
+            } else {
+                using U = std::make_unsigned_t<T>;
+                U ua = a < 0 ? U(0) - static_cast<U>(a) : static_cast<U>(a);
+                U ub = b < 0 ? U(0) - static_cast<U>(b) : static_cast<U>(b);
+                U limit = static_cast<U>(std::numeric_limits<T>::max()) + ((a < 0) != (b < 0) ? 1u : 0u);
+                return ua != 0 && ub > limit / ua;
+            }
+#endif
+        }
+
+        // 溢出时 饱和到的值：有符号 看 negative 取 min / max；无符号 由调用方决定
+        template <class T>
+        constexpr T saturate_value(bool negative) noexcept {
+            using U = std::make_unsigned_t<T>;
+            return static_cast<T>(static_cast<U>(std::numeric_limits<T>::max()) + static_cast<U>(negative));
+        }
+
+        template <class T>
+        constexpr T select(bool c, T a, T b) noexcept {
+            // 写成 三目，编译器生成 cmov，不产生分支
+            return c ? a : b;
+        }
+
+        template <std::floating_point T>
+        constexpr T clamp_inf(T r) noexcept {
+            constexpr T m = std::numeric_limits<T>::max();
+            return r > m ? m : (r < -m ? -m : r);
+        }
+
+        template <std::floating_point T>
+        constexpr bool float_overflows(T a, T b, T r) noexcept {
+            constexpr T m = std::numeric_limits<T>::max();
+            bool finite_in = a >= -m && a <= m && b >= -m && b <= m;
+            return finite_in && !(r >= -m && r <= m) && r == r;
+        }
+    }
+
+    // ---------------- add ----------------
+
+    template <arithmetic_value T>
+    constexpr T add(T a, T b, wrap_t) noexcept {
+        if constexpr (std::is_integral_v<T>) {
+            return detail::wrap_add(a, b);
+        } else {
+            return a + b;
+        }
+    }
+
+    template <arithmetic_value T>
+    constexpr T add(T a, T b, saturate_t) noexcept {
+        if constexpr (std::is_floating_point_v<T>) {
+            return detail::clamp_inf(a + b);
+        } else if constexpr (std::is_signed_v<T>) {
+            T r = detail::wrap_add(a, b);
+            return detail::select(detail::add_overflows(a, b, r), detail::saturate_value<T>(a < 0), r);
+        } else {
+            T r = detail::wrap_add(a, b);
+            return static_cast<T>(r | (T(0) - T(r < a)));
+        }
+    }
+
+    template <arithmetic_value T>
+    constexpr checked_result<T> add(T a, T b, checked_t) noexcept {
+        if constexpr (std::is_floating_point_v<T>) {
+            T r = a + b;
+            return {r, detail::float_overflows(a, b, r)};
+        } else {
+            T r = detail::wrap_add(a, b);
+            return {r, detail::add_overflows(a, b, r)};
+        }
+    }
+
+    // ---------------- sub ----------------
+
+    template <arithmetic_value T>
+    constexpr T sub(T a, T b, wrap_t) noexcept {
+        if constexpr (std::is_integral_v<T>) {
+            return detail::wrap_sub(a, b);
+        } else {
+            return a - b;
+        }
+    }
+
+    template <arithmetic_value T>
+    constexpr T sub(T a, T b, saturate_t) noexcept {
+        if constexpr (std::is_floating_point_v<T>) {
+            return detail::clamp_inf(a - b);
+        } else if constexpr (std::is_signed_v<T>) {
+            T r = detail::wrap_sub(a, b);
+            return detail::select(detail::sub_overflows(a, b, r), detail::saturate_value<T>(a < 0), r);
+        } else {
+            T r = detail::wrap_sub(a, b);
+            return static_cast<T>(r & (T(0) - T(a >= b)));
+        }
+    }
+
+    template <arithmetic_value T>
+    constexpr checked_result<T> sub(T a, T b, checked_t) noexcept {
+        if constexpr (std::is_floating_point_v<T>) {
+            T r = a - b;
+            return {r, detail::float_overflows(a, b, r)};
+        } else {
+            T r = detail::wrap_sub(a, b);
+            return {r, detail::sub_overflows(a, b, r)};
+        }
+    }
+
+    // ---------------- mul ----------------
+
+    template <arithmetic_value T>
+    constexpr T mul(T a, T b, wrap_t) noexcept {
+        if constexpr (std::is_integral_v<T>) {
+            return detail::wrap_mul(a, b);
+        } else {
+            return a * b;
+        }
+    }
+
+    template <arithmetic_value T>
+    constexpr T mul(T a, T b, saturate_t) noexcept {
+        if constexpr (std::is_floating_point_v<T>) {
+            return detail::clamp_inf(a * b);
+        } else if constexpr (std::is_signed_v<T>) {
+            return detail::select(detail::mul_overflows(a, b), detail::saturate_value<T>((a < 0) != (b < 0)), detail::wrap_mul(a, b));
+        } else {
+            return detail::select(detail::mul_overflows(a, b), std::numeric_limits<T>::max(), detail::wrap_mul(a, b));
+        }
+    }
+
+    template <arithmetic_value T>
+    constexpr checked_result<T> mul(T a, T b, checked_t) noexcept {
+        if constexpr (std::is_floating_point_v<T>) {
+            T r = a * b;
+            return {r, detail::float_overflows(a, b, r)};
+        } else {
+            return {detail::wrap_mul(a, b), detail::mul_overflows(a, b)};
+        }
+    }
+}
+
+#endif // E_MATH_ARITH_H
@@ -0,0 +1,122 @@
+#ifndef E_MATH_BIGINT_H
+#define E_MATH_BIGINT_H
+
+// 任意精度 有符号整数：符号 + 绝对值，绝对值 按 64 位 limb 低位在前 存放
+//
+// 绝对值 不超过 128 位（2 个 limb）时 放在 对象内部，不分配 堆内存；更大时 才 上堆
+//   两个 128 位 以内 的 数 加减 在 结果 仍 不超过 128 位 时 全程 不分配
+// 加减 用 带进位 加法 指令（x86 的 _addcarry_u64 / _subborrow_u64）
+// 乘法：短的 一方 少于 karatsuba_threshold 个 limb 时 用 逐 limb 乘加，否则 用 Karatsuba，
+//   两边 长度 相差 很大 时 把 长的 切成 短的 那么长 的 段 分别 乘
+// 除法 截断 取整，余数 与 被除数 同号（同 C++ 内置 整数）；除以 0 抛 std::domain_error
+// 文本 只支持 十进制，可带 + / - 号；格式 不对 抛 std::invalid_argument
+
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace e_math {
+    class bigint {
+    public:
+        // 双方 都 不少于 这么多个 limb 时 乘法 改用 Karatsuba（bench_bigint 测出来 的，16 ~ 64 之间 差别 不大）
+        static constexpr std::size_t karatsuba_threshold = 32;
+
+        bigint() noexcept : size_(0), capacity_(inline_limbs), negative_(false) {}
+
+        template <std::integral T>
+            requires(!std::same_as<std::remove_cv_t<T>, bool> && sizeof(T) <= sizeof(std::uint64_t))
+        bigint(T value) noexcept : bigint() {
+            std::uint64_t magnitude;
+            if constexpr (std::is_signed_v<T>) {
+                negative_ = value < 0;
+                // 先 转 无符号 再 取负，最小值 也 正确
+                magnitude = negative_ ? std::uint64_t(0) - static_cast<std::uint64_t>(value) : static_cast<std::uint64_t>(value);
+            } else {
+                magnitude = value;
+            }
+            inline_[0] = magnitude;
+            size_ = magnitude != 0;
+        }
+
+        explicit bigint(std::string_view text);
+
+        bigint(const bigint& other);
+        bigint(bigint&& other) noexcept;
+        bigint& operator=(const bigint& other);
+        bigint& operator=(bigint&& other) noexcept;
+        ~bigint();
+
+        std::string to_string() const;
+
+        bool is_zero() const noexcept { return size_ == 0; }
+        // -1、0、1
+        int sign() const noexcept { return size_ == 0 ? 0 : (negative_ ? -1 : 1); }
+        // 绝对值 的 二进制 位数，0 为 0
+        std::size_t bit_length() const noexcept;
+        // 绝对值 放在 对象 内部（没有 堆内存）
+        bool is_inline() const noexcept { return capacity_ == inline_limbs; }
+        // 绝对值 的 limb，低位 在前，没有 前导 0
+        std::span<const std::uint64_t> limbs() const noexcept { return {data(), size_}; }
+
+        bool fits_int64() const noexcept;
+        // 超出 int64 范围 抛 std::overflow_error
+        std::int64_t to_int64() const;
+        // 就近 舍入；超出 double 范围 时 为 ±inf
+        double to_double() const noexcept;
+
+        bigint operator-() const&;
+        bigint operator-() &&;
+
+        bigint& operator+=(const bigint& other);
+        bigint& operator-=(const bigint& other);
+        bigint& operator*=(const bigint& other);
+        bigint& operator/=(const bigint& other);
+        bigint& operator%=(const bigint& other);
+
+        friend bigint operator+(bigint a, const bigint& b) { return std::move(a += b); }
+        friend bigint operator-(bigint a, const bigint& b) { return std::move(a -= b); }
+        friend bigint operator*(const bigint& a, const bigint& b);
+        friend bigint operator/(const bigint& a, const bigint& b);
+        friend bigint operator%(const bigint& a, const bigint& b);
+
+        // 一次 得到 商 和 余数
+        static void divmod(const bigint& a, const bigint& b, bigint& quotient, bigint& remainder);
+
+        friend bool operator==(const bigint& a, const bigint& b) noexcept;
+        friend std::strong_ordering operator<=>(const bigint& a, const bigint& b) noexcept;
+
+        friend std::ostream& operator<<(std::ostream& os, const bigint& value);
+
+    private:
+        static constexpr std::uint32_t inline_limbs = 2;
+
+        std::uint64_t* data() noexcept { return is_inline() ? inline_ : heap_; }
+        const std::uint64_t* data() const noexcept { return is_inline() ? inline_ : heap_; }
+
+        // 保证 至少 n 个 limb 的 空间，已有 内容 保留
+        void reserve(std::size_t n);
+        // 去掉 前导 0，0 没有 符号
+        void trim() noexcept;
+        // 绝对值 设为 limbs[0, n)
+        void assign(const std::uint64_t* limbs, std::size_t n, bool negative);
+        void add_magnitude(const bigint& other);
+        void sub_magnitude(const bigint& other);
+
+        union {
+            std::uint64_t inline_[inline_limbs];
+            std::uint64_t* heap_;
+        };
+        std::uint32_t size_;
+        std::uint32_t capacity_;
+        bool negative_;
+    };
+}
+
+#endif // E_MATH_BIGINT_H
@@ -0,0 +1,505 @@
+#ifndef E_MATH_DECIMAL_H
+#define E_MATH_DECIMAL_H
+
+// 定点 十进制数：值 = raw / 10^Scale，raw 为 Rep（int32 / int64）整数，金额 之类 不能有 二进制 舍入误差 的 场合 用
+// 例：decimal<std::int64_t, 2> 表示 分，12.34 存为 1234
+//
+// 加减 是 精确的；乘除 结果 按 就近 舍入，恰好 一半 时 取 偶数（银行家 舍入）
+// 结果 超出 Rep 范围 抛 std::overflow_error，除以 0 抛 std::domain_error
+// 不同 精度 / 存储 之间 用 decimal_cast 转换，缩小 精度 时 同样 就近 取偶
+// 文本：from_chars / to_chars 不分配 内存，格式 为 [-]整数[.小数]，没有 指数；小数位 多于 Scale 时 就近 取偶
+// int64 存储 的 乘除 用 128 位 中间结果：GCC / Clang 用 __int128，没有 时（MSVC）用 detail::soft_int128
+
+#include "e_arith.hpp"
+
+#include <charconv>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+    #include <intrin.h>
+#endif
+
+namespace e_math {
+    template <class Rep, int Scale>
+    class decimal;
+
+    namespace detail {
+#if defined(__SIZEOF_INT128__)
+        __extension__ typedef __int128 decimal_int128;
+#endif
+
+        // 补码 128 位 有符号 整数，只有 decimal 用到 的 运算；没有 __int128 的 编译器 用 它
+        // 除法 与 取余 要求 除数 为 正 且 小于 2^64，结果 同 内置 整数：商 向 0 截断，余数 与 被除数 同号
+        struct soft_int128 {
+            std::uint64_t lo = 0;
+            std::uint64_t hi = 0;
+
+            constexpr soft_int128() noexcept = default;
+
+            template <std::integral I>
+            constexpr soft_int128(I v) noexcept : lo(static_cast<std::uint64_t>(v)), hi(0) {
+                if constexpr (std::is_signed_v<I>) hi = v < 0 ? ~std::uint64_t{0} : 0;
+            }
+
+            // 截断 到 低 位，同 内置 整数 的 static_cast
+            template <std::integral I>
+            constexpr explicit operator I() const noexcept {
+                return static_cast<I>(lo);
+            }
+
+            constexpr bool negative() const noexcept { return (hi >> 63) != 0; }
+
+            friend constexpr soft_int128 operator-(soft_int128 a) noexcept {
+                return soft_int128(0) - a;
+            }
+
+            friend constexpr soft_int128 operator+(soft_int128 a, soft_int128 b) noexcept {
+                soft_int128 r;
+                r.lo = a.lo + b.lo;
+                r.hi = a.hi + b.hi + (r.lo < a.lo);
+                return r;
+            }
+
+            friend constexpr soft_int128 operator-(soft_int128 a, soft_int128 b) noexcept {
+                soft_int128 r;
+                r.lo = a.lo - b.lo;
+                r.hi = a.hi - b.hi - (a.lo < b.lo);
+                return r;
+            }
+
+            // 低 128 位，补码 下 有符号 与 无符号 相同
+            friend constexpr soft_int128 operator*(soft_int128 a, soft_int128 b) noexcept {
+                soft_int128 r;
+                r.lo = mul_wide(a.lo, b.lo, r.hi);
+                r.hi += a.lo * b.hi + a.hi * b.lo;
+                return r;
+            }
+
+            friend constexpr soft_int128 operator/(soft_int128 n, soft_int128 d) noexcept {
+                soft_int128 q, r;
+                divmod(n, d, q, r);
+                return q;
+            }
+
+            friend constexpr soft_int128 operator%(soft_int128 n, soft_int128 d) noexcept {
+                soft_int128 q, r;
+                divmod(n, d, q, r);
+                return r;
+            }
+
+            friend constexpr soft_int128 operator&(soft_int128 a, soft_int128 b) noexcept {
+                soft_int128 r;
+                r.lo = a.lo & b.lo;
+                r.hi = a.hi & b.hi;
+                return r;
+            }
+
+            constexpr soft_int128& operator+=(soft_int128 b) noexcept { return *this = *this + b; }
+            constexpr soft_int128& operator-=(soft_int128 b) noexcept { return *this = *this - b; }
+
+            friend constexpr bool operator==(soft_int128, soft_int128) noexcept = default;
+
+            friend constexpr std::strong_ordering operator<=>(soft_int128 a, soft_int128 b) noexcept {
+                if (a.hi != b.hi) return static_cast<std::int64_t>(a.hi) <=> static_cast<std::int64_t>(b.hi);
+                return a.lo <=> b.lo;
+            }
+
+        private:
+            // 64 x 64 -> 128：返回 低 64 位，高 64 位 写到 hi
+            static constexpr std::uint64_t mul_wide(std::uint64_t a, std::uint64_t b, std::uint64_t& hi) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+                if (!std::is_constant_evaluated()) return _umul128(a, b, &hi);
+#endif
+                constexpr std::uint64_t mask = 0xffffffffu;
+                const std::uint64_t p00 = (a & mask) * (b & mask);
+                const std::uint64_t p01 = (a & mask) * (b >> 32);
+                const std::uint64_t p10 = (a >> 32) * (b & mask);
+                const std::uint64_t mid = (p00 >> 32) + (p01 & mask) + (p10 & mask);
+                hi = (a >> 32) * (b >> 32) + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+                return (mid << 32) | (p00 & mask);
+            }
+
+            // (hi, lo) / d，要求 hi < d
+            static constexpr std::uint64_t div_wide(std::uint64_t hi, std::uint64_t lo, std::uint64_t d, std::uint64_t& rem) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64) && _MSC_VER >= 1920
+                if (!std::is_constant_evaluated()) return _udiv128(hi, lo, d, &rem);
+#endif
+                // 逐 位 试商，移出 的 最高位 为 1 时 余数 已 超过 d
+                std::uint64_t q = 0;
+                for (int i = 63; i >= 0; --i) {
+                    const bool carry = (hi >> 63) != 0;
+                    hi = (hi << 1) | ((lo >> i) & 1);
+                    if (carry || hi >= d) {
+                        hi -= d;
+                        q |= std::uint64_t{1} << i;
+                    }
+                }
+                rem = hi;
+                return q;
+            }
+
+            static constexpr void divmod(soft_int128 n, soft_int128 d, soft_int128& q, soft_int128& r) noexcept {
+                const bool neg = n.negative();
+                if (neg) n = -n;
+                q.hi = n.hi / d.lo;
+                q.lo = div_wide(n.hi % d.lo, n.lo, d.lo, r.lo);
+                r.hi = 0;
+                if (neg) {
+                    q = -q;
+                    r = -r;
+                }
+            }
+        };
+
+        // 乘除 的 中间结果：int32 用 int64，int64 用 int128
+        template <class Rep>
+        struct decimal_wide;
+
+        template <>
+        struct decimal_wide<std::int32_t> {
+            using type = std::int64_t;
+        };
+
+        template <>
+        struct decimal_wide<std::int64_t> {
+#if defined(__SIZEOF_INT128__)
+            using type = decimal_int128;
+#else
+            using type = soft_int128;
+#endif
+        };
+
+        template <class Rep>
+        constexpr Rep pow10(int n) noexcept {
+            Rep r = 1;
+            for (int i = 0; i < n; ++i) r *= 10;
+            return r;
+        }
+
+        // q = n / d，d > 0，就近 舍入，恰好 一半 取 偶
+        template <class W>
+        constexpr W div_round_even(W n, W d) noexcept {
+            // 先 向下 取整，余数 落在 [0, d)，正负 一样 处理
+            // 不用 分支：批量 计算 时 符号 随机，分支 预测 失败 的 代价 比 除法 还大
+            W q = n / d;
+            W r = n % d;
+            const bool negative = r < 0;
+            q -= W(negative);
+            r += negative ? d : W(0);
+            const W twice = r + r;
+            return q + W((twice > d) | ((twice == d) & ((q & 1) != 0)));
+        }
+
+        template <class Rep, class W>
+        constexpr Rep narrow_or_throw(W v) {
+            if (v < W(std::numeric_limits<Rep>::min()) || v > W(std::numeric_limits<Rep>::max())) {
+                throw std::overflow_error("e_math::decimal: result out of range");
+            }
+            return static_cast<Rep>(v);
+        }
+
+        // 批量内核，在 e_decimal.cpp 里 按 CPU 选 SIMD 版本；返回 是否 有 元素 溢出
+        bool decimal_add(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t n);
+        bool decimal_add(const std::int64_t* a, const std::int64_t* b, std::int64_t* out, std::size_t n);
+        bool decimal_mul(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t n, int scale);
+        bool decimal_mul(const std::int64_t* a, const std::int64_t* b, std::int64_t* out, std::size_t n, int scale);
+        // 总和 超出 int64 时 返回 true
+        bool decimal_sum(const std::int32_t* p, std::size_t n, std::int64_t& out);
+        bool decimal_sum(const std::int64_t* p, std::size_t n, std::int64_t& out);
+    }
+
+    template <class Rep, int Scale>
+    class decimal {
+        static_assert(std::is_same_v<Rep, std::int32_t> || std::is_same_v<Rep, std::int64_t>, "decimal: Rep must be int32_t or int64_t");
+        static_assert(Scale >= 0 && Scale <= std::numeric_limits<Rep>::digits10, "decimal: 10^Scale must fit in Rep");
+
+    public:
+        using rep = Rep;
+        static constexpr int scale = Scale;
+        // 1 对应 的 raw 值
+        static constexpr Rep one = detail::pow10<Rep>(Scale);
+        // to_chars 最多 写 这么多 字符：符号、全部 数字、小数点、scale 不小于 位数 时 的 前导 0
+        static constexpr std::size_t max_chars = std::numeric_limits<Rep>::digits10 + 4;
+
+        // 批量 求和 的 结果 类型
+        using sum_type = decimal<std::int64_t, Scale>;
+
+        constexpr decimal() noexcept = default;
+
+        // 整数 值；超出 范围 抛 std::overflow_error
+        template <std::integral I>
+            requires(!std::same_as<std::remove_cv_t<I>, bool>)
+        constexpr explicit decimal(I whole) : raw_(from_whole(whole)) {}
+
+        static constexpr decimal from_raw(Rep raw) noexcept {
+            decimal d;
+            d.raw_ = raw;
+            return d;
+        }
+
+        constexpr Rep raw() const noexcept { return raw_; }
+
+        // 最接近 的 double；只用于 显示 与 统计，不要 再 转回 来 计算
+        constexpr double to_double() const noexcept { return static_cast<double>(raw_) / static_cast<double>(one); }
+
+        // 向 0 截断 的 整数 部分
+        constexpr Rep whole() const noexcept { return raw_ / one; }
+
+        constexpr decimal operator+() const noexcept { return *this; }
+
+        constexpr decimal operator-() const {
+            if (raw_ == std::numeric_limits<Rep>::min()) {
+                throw std::overflow_error("e_math::decimal: result out of range");
+            }
+            return from_raw(-raw_);
+        }
+
+        constexpr decimal& operator+=(decimal other) {
+            const auto r = e_math::add(raw_, other.raw_, checked);
+            if (r.overflow) {
+                throw std::overflow_error("e_math::decimal: result out of range");
+            }
+            raw_ = r.value;
+            return *this;
+        }
+
+        constexpr decimal& operator-=(decimal other) {
+            const auto r = e_math::sub(raw_, other.raw_, checked);
+            if (r.overflow) {
+                throw std::overflow_error("e_math::decimal: result out of range");
+            }
+            raw_ = r.value;
+            return *this;
+        }
+
+        // raw = a * b / 10^Scale，就近 取偶
+        constexpr decimal& operator*=(decimal other) {
+            using W = typename detail::decimal_wide<Rep>::type;
+            if constexpr (sizeof(Rep) == sizeof(std::int64_t)) {
+                // 乘积 不超过 64 位 时 不用 128 位 除法
+                const auto p = e_math::mul(raw_, other.raw_, checked);
+                if (!p.overflow) {
+                    raw_ = detail::div_round_even<Rep>(p.value, one);
+                    return *this;
+                }
+            }
+            raw_ = detail::narrow_or_throw<Rep>(detail::div_round_even<W>(W(raw_) * W(other.raw_), W(one)));
+            return *this;
+        }
+
+        // raw = a * 10^Scale / b，就近 取偶
+        constexpr decimal& operator/=(decimal other) {
+            using W = typename detail::decimal_wide<Rep>::type;
+            if (other.raw_ == 0) {
+                throw std::domain_error("e_math::decimal: division by zero");
+            }
+            W n = W(raw_) * W(one);
+            W d = W(other.raw_);
+            if (d < 0) {
+                n = -n;
+                d = -d;
+            }
+            raw_ = detail::narrow_or_throw<Rep>(detail::div_round_even<W>(n, d));
+            return *this;
+        }
+
+        friend constexpr decimal operator+(decimal a, decimal b) { return a += b; }
+        friend constexpr decimal operator-(decimal a, decimal b) { return a -= b; }
+        friend constexpr decimal operator*(decimal a, decimal b) { return a *= b; }
+        friend constexpr decimal operator/(decimal a, decimal b) { return a /= b; }
+
+        friend constexpr bool operator==(decimal, decimal) noexcept = default;
+        friend constexpr auto operator<=>(decimal, decimal) noexcept = default;
+
+        // ---------------- 文本 ----------------
+
+        // 同 std::from_chars：[-]digits[.digits]，至少 一个 数字，不认 前导 + 与 空白
+        // 格式 不对 返回 errc::invalid_argument，超出 范围 返回 errc::result_out_of_range；出错 时 不改 value
+        static constexpr std::from_chars_result from_chars(const char* first, const char* last, decimal& value) noexcept {
+            using U = std::make_unsigned_t<Rep>;
+            const char* p = first;
+            const bool negative = p != last && *p == '-';
+            if (negative) {
+                ++p;
+            }
+            // 绝对值 上限：负数 可以 多 1
+            const U limit = static_cast<U>(std::numeric_limits<Rep>::max()) + U(negative);
+            U mag = 0;
+            bool overflow = false;
+            bool any = false;
+            auto push = [&](unsigned digit) {
+                if (mag > (limit - digit) / 10) {
+                    overflow = true;
+                } else {
+                    mag = mag * 10 + digit;
+                }
+            };
+            for (; p != last && *p >= '0' && *p <= '9'; ++p) {
+                push(static_cast<unsigned>(*p - '0'));
+                any = true;
+            }
+            int frac = 0;
+            bool round_up = false;
+            if (p != last && *p == '.' && p + 1 != last && p[1] >= '0' && p[1] <= '9') {
+                ++p;
+                // 多出来的 小数位：第一位 决定 舍入，其后 非 0 决定 是否 恰好 一半
+                int first_dropped = -1;
+                bool sticky = false;
+                for (; p != last && *p >= '0' && *p <= '9'; ++p) {
+                    const unsigned digit = static_cast<unsigned>(*p - '0');
+                    if (frac < Scale) {
+                        push(digit);
+                        ++frac;
+                    } else if (first_dropped < 0) {
+                        first_dropped = static_cast<int>(digit);
+                    } else {
+                        sticky = sticky || digit != 0;
+                    }
+                }
+                any = true;
+                round_up = first_dropped > 5 || (first_dropped == 5 && (sticky || (mag & 1) != 0));
+            }
+            if (!any) {
+                return {first, std::errc::invalid_argument};
+            }
+            for (; frac < Scale; ++frac) push(0);
+            if (round_up) {
+                overflow = overflow || mag == limit;
+                ++mag;
+            }
+            if (overflow) {
+                return {p, std::errc::result_out_of_range};
+            }
+            value.raw_ = negative ? static_cast<Rep>(U(0) - mag) : static_cast<Rep>(mag);
+            return {p, std::errc{}};
+        }
+
+        // 整个 字符串 必须 是 一个 数：格式 不对 抛 std::invalid_argument，超出 范围 抛 std::out_of_range
+        static constexpr decimal parse(std::string_view text) {
+            decimal d;
+            const auto [ptr, ec] = from_chars(text.data(), text.data() + text.size(), d);
+            if (ec == std::errc::result_out_of_range) {
+                throw std::out_of_range("e_math::decimal: value out of range");
+            }
+            if (ec != std::errc{} || ptr != text.data() + text.size()) {
+                throw std::invalid_argument("e_math::decimal: invalid number");
+            }
+            return d;
+        }
+
+        // 总是 写 Scale 位 小数；空间 不够 返回 errc::value_too_large，最多 需要 max_chars
+        constexpr std::to_chars_result to_chars(char* first, char* last) const noexcept {
+            using U = std::make_unsigned_t<Rep>;
+            char buf[max_chars];
+            char* end = buf + max_chars;
+            char* p = end;
+            U mag = raw_ < 0 ? U(0) - static_cast<U>(raw_) : static_cast<U>(raw_);
+            int digits = 0;
+            do {
+                if (digits == Scale && Scale > 0) {
+                    *--p = '.';
+                }
+                *--p = static_cast<char>('0' + mag % 10);
+                mag /= 10;
+                ++digits;
+            } while (mag != 0 || digits <= Scale);
+            if (raw_ < 0) {
+                *--p = '-';
+            }
+            const auto len = end - p;
+            if (last - first < len) {
+                return {last, std::errc::value_too_large};
+            }
+            for (char* q = p; q != end; ++q) *first++ = *q;
+            return {first, std::errc{}};
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, decimal value) {
+            char buf[max_chars];
+            const auto r = value.to_chars(buf, buf + max_chars);
+            return os << std::string_view(buf, static_cast<std::size_t>(r.ptr - buf));
+        }
+
+        // ---------------- 批量：按 CPU 用 SIMD ----------------
+        // 长度 必须 相同，否则 抛 std::invalid_argument；out 可以 与 a 或 b 是 同一块 内存，但不能 部分重叠
+        // 有 元素 溢出 时 抛 std::overflow_error，此时 out 的 内容 不确定
+
+        // out[i] = a[i] + b[i]
+        static void add(std::span<const decimal> a, std::span<const decimal> b, std::span<decimal> out) {
+            check_sizes(a, b, out);
+            if (detail::decimal_add(raw_ptr(a.data()), raw_ptr(b.data()), raw_ptr(out.data()), out.size())) {
+                throw std::overflow_error("e_math::decimal::add: result out of range");
+            }
+        }
+
+        // out[i] = a[i] * b[i]，与 逐个 operator* 结果 相同
+        static void mul(std::span<const decimal> a, std::span<const decimal> b, std::span<decimal> out) {
+            check_sizes(a, b, out);
+            if (detail::decimal_mul(raw_ptr(a.data()), raw_ptr(b.data()), raw_ptr(out.data()), out.size(), Scale)) {
+                throw std::overflow_error("e_math::decimal::mul: result out of range");
+            }
+        }
+
+        // 精确 求和，结果 用 int64 存储；超出 int64 抛 std::overflow_error
+        static sum_type sum(std::span<const decimal> v) {
+            std::int64_t total = 0;
+            if (detail::decimal_sum(raw_ptr(v.data()), v.size(), total)) {
+                throw std::overflow_error("e_math::decimal::sum: result out of range");
+            }
+            return sum_type::from_raw(total);
+        }
+
+    private:
+        template <std::integral I>
+        static constexpr Rep from_whole(I whole) {
+            const auto r = e_math::mul(static_cast<Rep>(whole), one, checked);
+            if (!std::in_range<Rep>(whole) || r.overflow) {
+                throw std::overflow_error("e_math::decimal: value out of range");
+            }
+            return r.value;
+        }
+
+        // 只有 一个 Rep 成员 的 标准布局 类型，数组 可以 按 Rep 数组 读写
+        static const Rep* raw_ptr(const decimal* p) noexcept { return reinterpret_cast<const Rep*>(p); }
+        static Rep* raw_ptr(decimal* p) noexcept { return reinterpret_cast<Rep*>(p); }
+
+        static void check_sizes(std::span<const decimal> a, std::span<const decimal> b, std::span<decimal> out) {
+            if (a.size() != b.size() || a.size() != out.size()) {
+                throw std::invalid_argument("e_math::decimal: spans must have the same size");
+            }
+        }
+
+        Rep raw_ = 0;
+    };
+
+    // 换 精度 或 存储：放大 精度 是 精确的，缩小 时 就近 取偶；超出 目标 范围 抛 std::overflow_error
+    template <class To, class Rep, int Scale>
+    constexpr To decimal_cast(decimal<Rep, Scale> from) {
+        using R = typename To::rep;
+        constexpr int to_scale = To::scale;
+        if constexpr (to_scale >= Scale) {
+            constexpr std::int64_t factor = detail::pow10<std::int64_t>(to_scale - Scale);
+            const auto r = mul(static_cast<std::int64_t>(from.raw()), factor, checked);
+            if (r.overflow) {
+                throw std::overflow_error("e_math::decimal_cast: value out of range");
+            }
+            return To::from_raw(detail::narrow_or_throw<R>(r.value));
+        } else {
+            constexpr std::int64_t factor = detail::pow10<std::int64_t>(Scale - to_scale);
+            return To::from_raw(detail::narrow_or_throw<R>(detail::div_round_even<std::int64_t>(from.raw(), factor)));
+        }
+    }
+}
+
+#endif // E_MATH_DECIMAL_H
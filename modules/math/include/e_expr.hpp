@@ -0,0 +1,350 @@
+#ifndef E_MATH_EXPR_H
+#define E_MATH_EXPR_H
+
+// 表达式模板：out = a + b * c - d 这样的 逐元素 运算 合成 一趟 循环，不产生 整长 的 临时数组
+// 例：
+//   e_math::array_view a(va), b(vb), out(vout);
+//   out = e_math::clamp(a + b * 0.5f, 0.0f, 1.0f);
+//   out.assign(a * b - 1.0f, e_math::execution::parallel);
+//
+// 求值 按 块 进行：每块 几百个 元素，中间结果 放在 栈上 的 块 缓冲 里（留在 L1），每个 运算 调用 一次 按 CPU 选好的 SIMD 内核，
+// 加法 直接 用 e_math::add 的 批量 内核
+// 每个 运算 单独 舍入（不合成 fma），结果 与 一步一步 用 临时数组 算 逐位 相同，也 与 指令集、线程数 无关
+// 整数 加减乘 按 补码 回绕；min / max 与 std::min / std::max 相同（相等 或 有 NaN 时 取 第一个）
+// 参与 运算 的 数组 长度 必须 相同，否则 抛 std::invalid_argument
+// out 可以 就是 表达式里 的 某个 数组（原地），但 不能 与 它们 部分 重叠
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+namespace e_math {
+    enum class execution {
+        sequential,
+        // 长度 够大 时 分段 交给 线程池（set_max_threads），较短 时 仍在 当前线程 计算
+        parallel,
+    };
+
+    template <class T>
+    class array_view;
+
+    namespace detail {
+        enum class expr_op : unsigned char {
+            add,
+            sub,
+            mul,
+            min,
+            max,
+            count,
+        };
+
+        // 数组 与 标量：rsub 是 s - a
+        enum class expr_scalar_op : unsigned char {
+            add,
+            sub,
+            rsub,
+            mul,
+            min,
+            max,
+            count,
+        };
+
+        template <class T>
+        using expr_fn = void (*)(const T* a, const T* b, T* out, std::size_t n);
+
+        template <class T>
+        using expr_scalar_fn = void (*)(const T* a, T s, T* out, std::size_t n);
+
+        // 动态库 加载时 按 CPU 选好的 块 内核，out 可以 就是 a 或 b
+        template <class T>
+        struct expr_kernel_table {
+            expr_fn<T> binary[static_cast<std::size_t>(expr_op::count)];
+            expr_scalar_fn<T> scalar[static_cast<std::size_t>(expr_scalar_op::count)];
+        };
+
+        template <class T>
+        const expr_kernel_table<T>& expr_kernels();
+
+        // 只有 这 四种，定义 在 e_expr.cpp
+        template <>
+        const expr_kernel_table<std::int32_t>& expr_kernels<std::int32_t>();
+        template <>
+        const expr_kernel_table<std::int64_t>& expr_kernels<std::int64_t>();
+        template <>
+        const expr_kernel_table<float>& expr_kernels<float>();
+        template <>
+        const expr_kernel_table<double>& expr_kernels<double>();
+
+        // 对 [0, tasks) 的 每个 下标 调用 fn(ctx, t)，用 模块 的 线程池
+        void expr_parallel_for(std::size_t tasks, void (*fn)(const void* ctx, std::size_t t), const void* ctx);
+
+        // 一块 的 字节数：几层 中间结果 一起 仍在 L1 里
+        inline constexpr std::size_t expr_block_bytes = 2048;
+
+        // 并行 时 每段 的 元素数，是 块 的 整数倍
+        inline constexpr std::size_t expr_parallel_grain = std::size_t(1) << 15;
+
+        template <class T>
+        inline constexpr std::size_t expr_block = expr_block_bytes / sizeof(T);
+
+        template <class T>
+        inline constexpr bool expr_element = std::is_same_v<T, std::int32_t> || std::is_same_v<T, std::int64_t> ||
+                                             std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+        template <class E>
+        struct is_expr : std::false_type {};
+
+        template <class E>
+        inline constexpr bool is_expr_v = is_expr<std::remove_cvref_t<E>>::value;
+
+        template <class L, class R>
+        concept expr_pair = is_expr_v<L> && is_expr_v<R> && std::is_same_v<typename L::value_type, typename R::value_type>;
+
+        inline std::size_t expr_common_size(std::size_t a, std::size_t b) {
+            if (a != b) {
+                throw std::invalid_argument("e_math::array_view: extents must match");
+            }
+            return a;
+        }
+
+        // 节点 的 接口：
+        //   value_type、size()
+        //   slots：作为 子节点 求值 时 要用 的 块 缓冲 个数（叶子 为 0）
+        //   eval(i, n, scratch, dst, k)：算 [i, i + n)，写到 dst 并 返回 dst；叶子 直接 返回 自己的 数据
+        //   非叶子 只用 scratch 开始 的 slots 个 块，dst 不会 与 其中 正在用 的 块 冲突
+        template <expr_op Op, class L, class R>
+        class expr_binary {
+        public:
+            using value_type = typename L::value_type;
+
+            static constexpr std::size_t right_offset = L::slots == 0 ? 0 : 1;
+            static constexpr std::size_t slots = std::max({std::size_t(1), L::slots, right_offset + R::slots});
+
+            expr_binary(const L& l, const R& r) : l_(l), r_(r), size_(expr_common_size(l.size(), r.size())) {}
+
+            std::size_t size() const noexcept { return size_; }
+
+            const value_type* eval(std::size_t i, std::size_t n, value_type* scratch, value_type* dst,
+                                   const expr_kernel_table<value_type>& k) const {
+                // 左边 的 结果 在 第 0 块，右边 从 下一块 开始 用，不会 覆盖 左边
+                const value_type* a = l_.eval(i, n, scratch, scratch, k);
+                value_type* right = scratch + right_offset * expr_block<value_type>;
+                const value_type* b = r_.eval(i, n, right, right, k);
+                k.binary[static_cast<std::size_t>(Op)](a, b, dst, n);
+                return dst;
+            }
+
+        private:
+            L l_;
+            R r_;
+            std::size_t size_;
+        };
+
+        template <expr_scalar_op Op, class E>
+        class expr_scalar {
+        public:
+            using value_type = typename E::value_type;
+
+            static constexpr std::size_t slots = std::max(std::size_t(1), E::slots);
+
+            expr_scalar(const E& e, value_type s) : e_(e), s_(s) {}
+
+            std::size_t size() const noexcept { return e_.size(); }
+
+            const value_type* eval(std::size_t i, std::size_t n, value_type* scratch, value_type* dst,
+                                   const expr_kernel_table<value_type>& k) const {
+                const value_type* a = e_.eval(i, n, scratch, scratch, k);
+                k.scalar[static_cast<std::size_t>(Op)](a, s_, dst, n);
+                return dst;
+            }
+
+        private:
+            E e_;
+            value_type s_;
+        };
+
+        template <class T>
+        struct is_expr<array_view<T>> : std::true_type {};
+
+        template <expr_op Op, class L, class R>
+        struct is_expr<expr_binary<Op, L, R>> : std::true_type {};
+
+        template <expr_scalar_op Op, class E>
+        struct is_expr<expr_scalar<Op, E>> : std::true_type {};
+
+        template <class T, class E>
+        void expr_eval(const E& e, T* out, std::size_t begin, std::size_t end, const expr_kernel_table<T>& k) {
+            constexpr std::size_t block = expr_block<T>;
+            alignas(64) T scratch[E::slots == 0 ? 1 : E::slots][block];
+            for (std::size_t i = begin; i < end; i += block) {
+                const std::size_t n = std::min(block, end - i);
+                const T* r = e.eval(i, n, scratch[0], out + i, k);
+                // 整个 表达式 只是 一个 数组：复制
+                if (r != out + i) std::memmove(out + i, r, n * sizeof(T));
+            }
+        }
+
+        template <class T, class E>
+        struct expr_task {
+            const E* e;
+            T* out;
+            std::size_t size;
+            const expr_kernel_table<T>* k;
+
+            static void run(const void* ctx, std::size_t t) {
+                const auto& self = *static_cast<const expr_task*>(ctx);
+                const std::size_t begin = t * expr_parallel_grain;
+                expr_eval(*self.e, self.out, begin, std::min(self.size, begin + expr_parallel_grain), *self.k);
+            }
+        };
+    }
+
+    // 连续 数组 的 视图，不拥有 数据；T 为 int32 / int64 / float / double，可带 const
+    // 赋值 是 按 元素 写入（out = a 复制 元素），不是 换 绑定；要 换 绑定 请 重新 构造
+    template <class T>
+    class array_view {
+    public:
+        using value_type = std::remove_const_t<T>;
+
+        static_assert(detail::expr_element<value_type>, "e_math::array_view: element must be int32, int64, float or double");
+
+        static constexpr std::size_t slots = 0;
+
+        array_view() = default;
+        array_view(std::span<T> s) noexcept : data_(s.data()), size_(s.size()) {}
+
+        // 任意 连续 容器（std::vector、std::array 等）
+        template <class R>
+            requires std::is_constructible_v<std::span<T>, R&> && (!std::is_same_v<std::remove_cvref_t<R>, array_view>)
+        array_view(R&& r) noexcept : array_view(std::span<T>(r)) {}
+
+        array_view(const array_view&) = default;
+
+        array_view& operator=(const array_view& other) {
+            assign(other);
+            return *this;
+        }
+
+        template <class E>
+            requires detail::is_expr_v<E> && std::is_same_v<typename E::value_type, value_type>
+        array_view& operator=(const E& e) {
+            assign(e);
+            return *this;
+        }
+
+        // 计算 e 写入 本视图
+        template <class E>
+            requires detail::is_expr_v<E> && std::is_same_v<typename E::value_type, value_type>
+        void assign(const E& e, execution policy = execution::sequential) const {
+            static_assert(!std::is_const_v<T>, "e_math::array_view: cannot assign to a view of const");
+            const std::size_t n = detail::expr_common_size(size_, e.size());
+            const auto& k = detail::expr_kernels<value_type>();
+            const std::size_t tasks = (n + detail::expr_parallel_grain - 1) / detail::expr_parallel_grain;
+            if (policy == execution::parallel && tasks > 1) {
+                const detail::expr_task<value_type, E> task{&e, data_, n, &k};
+                detail::expr_parallel_for(tasks, &detail::expr_task<value_type, E>::run, &task);
+            } else {
+                detail::expr_eval(e, data_, 0, n, k);
+            }
+        }
+
+        template <class E>
+            requires detail::is_expr_v<E>
+        array_view& operator+=(const E& e) { return *this = *this + e; }
+        template <class E>
+            requires detail::is_expr_v<E>
+        array_view& operator-=(const E& e) { return *this = *this - e; }
+        template <class E>
+            requires detail::is_expr_v<E>
+        array_view& operator*=(const E& e) { return *this = *this * e; }
+
+        array_view& operator+=(value_type s) { return *this = *this + s; }
+        array_view& operator-=(value_type s) { return *this = *this - s; }
+        array_view& operator*=(value_type s) { return *this = *this * s; }
+
+        T* data() const noexcept { return data_; }
+        std::size_t size() const noexcept { return size_; }
+        std::span<T> span() const noexcept { return {data_, size_}; }
+        T& operator[](std::size_t i) const noexcept { return data_[i]; }
+
+        const value_type* eval(std::size_t i, std::size_t, value_type*, value_type*, const detail::expr_kernel_table<value_type>&) const {
+            return data_ + i;
+        }
+
+    private:
+        T* data_ = nullptr;
+        std::size_t size_ = 0;
+    };
+
+    template <class R>
+    array_view(R&&) -> array_view<std::remove_reference_t<decltype(*std::data(std::declval<R&>()))>>;
+
+    // ---------------- 运算 ----------------
+    // 只 生成 表达式 节点，赋给 array_view 时 才 计算；节点 按值 保存 子表达式，可以 先 存到 auto 变量 里
+
+    template <class L, class R>
+        requires detail::expr_pair<L, R>
+    auto operator+(const L& l, const R& r) { return detail::expr_binary<detail::expr_op::add, L, R>(l, r); }
+
+    template <class L, class R>
+        requires detail::expr_pair<L, R>
+    auto operator-(const L& l, const R& r) { return detail::expr_binary<detail::expr_op::sub, L, R>(l, r); }
+
+    template <class L, class R>
+        requires detail::expr_pair<L, R>
+    auto operator*(const L& l, const R& r) { return detail::expr_binary<detail::expr_op::mul, L, R>(l, r); }
+
+    template <class L, class R>
+        requires detail::expr_pair<L, R>
+    auto min(const L& l, const R& r) { return detail::expr_binary<detail::expr_op::min, L, R>(l, r); }
+
+    template <class L, class R>
+        requires detail::expr_pair<L, R>
+    auto max(const L& l, const R& r) { return detail::expr_binary<detail::expr_op::max, L, R>(l, r); }
+
+    // 与 标量：标量 转换成 表达式 的 元素 类型
+
+    template <class E>
+        requires detail::is_expr_v<E>
+    auto operator+(const E& e, typename E::value_type s) { return detail::expr_scalar<detail::expr_scalar_op::add, E>(e, s); }
+
+    template <class E>
+        requires detail::is_expr_v<E>
+    auto operator+(typename E::value_type s, const E& e) { return detail::expr_scalar<detail::expr_scalar_op::add, E>(e, s); }
+
+    template <class E>
+        requires detail::is_expr_v<E>
+    auto operator-(const E& e, typename E::value_type s) { return detail::expr_scalar<detail::expr_scalar_op::sub, E>(e, s); }
+
+    template <class E>
+        requires detail::is_expr_v<E>
+    auto operator-(typename E::value_type s, const E& e) { return detail::expr_scalar<detail::expr_scalar_op::rsub, E>(e, s); }
+
+    template <class E>
+        requires detail::is_expr_v<E>
+    auto operator*(const E& e, typename E::value_type s) { return detail::expr_scalar<detail::expr_scalar_op::mul, E>(e, s); }
+
+    template <class E>
+        requires detail::is_expr_v<E>
+    auto operator*(typename E::value_type s, const E& e) { return detail::expr_scalar<detail::expr_scalar_op::mul, E>(e, s); }
+
+    template <class E>
+        requires detail::is_expr_v<E>
+    auto min(const E& e, typename E::value_type s) { return detail::expr_scalar<detail::expr_scalar_op::min, E>(e, s); }
+
+    template <class E>
+        requires detail::is_expr_v<E>
+    auto max(const E& e, typename E::value_type s) { return detail::expr_scalar<detail::expr_scalar_op::max, E>(e, s); }
+
+    // min(max(e, lo), hi)
+    template <class E>
+        requires detail::is_expr_v<E>
+    auto clamp(const E& e, typename E::value_type lo, typename E::value_type hi) { return min(max(e, lo), hi); }
+}
+
+#endif // E_MATH_EXPR_H
@@ -0,0 +1,120 @@
+#ifndef E_MATH_FFT_H
+#define E_MATH_FFT_H
+
+// 快速傅里叶变换（FFT）：复数 与 实数 输入，float / double
+//
+// 定义：forward  X[k] = sum x[t] * exp(-2 pi i t k / n)
+//       inverse  x[t] = sum X[k] * exp(+2 pi i t k / n)，不除以 n，即 inverse(forward(x)) = n * x
+//
+// 任意长度 n >= 1：按 4 / 2 / 3 / 5 分解 做 混合基 Stockham（不需要 位反转），其余 素因子 用 通用 基（O(n * p)），
+// 大素因子 的 长度 会 明显 变慢；跨度 够宽的 蝶形 按 指令集 用 SIMD
+// plan 在 构造时 算好 各级 旋转因子，之后 只读，可以 多线程 共用
+// cached(n) 与 便捷函数 用 进程内 缓存 的 plan：每种 plan 最多 留 fft_plan_cache_size 个，按 最近 使用 淘汰；
+// 返回 shared_ptr，被 淘汰 或 清空 后 手里 的 plan 仍然 有效；clear_fft_plan_cache() 立刻 释放 缓存 占用 的 内存
+// 批量 接口 把 count 个 首尾相接 的 信号 分给 各线程 分别 变换
+// out 可以 就是 in（原地），但 不能 部分重叠；长度 不对 抛 std::invalid_argument
+
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace e_math {
+    inline constexpr std::size_t fft_plan_cache_size = 16;
+
+    template <class T>
+    class rfft_plan;
+
+    template <class T>
+    class fft_plan {
+    public:
+        // n == 0 抛 std::invalid_argument
+        explicit fft_plan(std::size_t n);
+
+        static std::shared_ptr<const fft_plan> cached(std::size_t n);
+
+        std::size_t size() const { return n_; }
+
+        void forward(std::span<const std::complex<T>> in, std::span<std::complex<T>> out) const;
+        void inverse(std::span<const std::complex<T>> in, std::span<std::complex<T>> out) const;
+
+        // in / out 长度 为 count * size()
+        void forward(std::span<const std::complex<T>> in, std::span<std::complex<T>> out, std::size_t count) const;
+        void inverse(std::span<const std::complex<T>> in, std::span<std::complex<T>> out, std::size_t count) const;
+
+    private:
+        template <class>
+        friend class rfft_plan;
+
+        // 一级 蝶形：长度 radix * m 的 子变换 共 stride 个，旋转因子 从 twiddles_[twiddle] 开始
+        struct stage {
+            std::size_t radix;
+            std::size_t m;
+            std::size_t stride;
+            std::size_t twiddle;
+            std::size_t roots; // 通用 基 的 radix 次 单位根 在 twiddles_ 里 的 位置
+            std::size_t wide;  // 跨度 小于 向量宽度 时 按 向量 展开 的 旋转因子，没有 时 为 npos
+        };
+
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        void run(const std::complex<T>* in, std::complex<T>* out, bool inverse) const;
+        void run_batch(std::span<const std::complex<T>> in, std::span<std::complex<T>> out, std::size_t count, bool inverse) const;
+
+        std::size_t n_;
+        std::vector<stage> stages_;
+        std::vector<std::complex<T>> twiddles_;
+    };
+
+    // 实数 FFT：n 个 实数 <-> n / 2 + 1 个 复数（其余 一半 是 共轭对称 的，不存）
+    // 偶数 n 用 n / 2 点 的 复数 FFT 加 一次 拆分；奇数 n 用 n 点 复数 FFT
+    // inverse 忽略 X[0]（以及 偶数 n 时 X[n / 2]）的 虚部
+    template <class T>
+    class rfft_plan {
+    public:
+        explicit rfft_plan(std::size_t n);
+
+        static std::shared_ptr<const rfft_plan> cached(std::size_t n);
+
+        std::size_t size() const { return n_; }
+
+        void forward(std::span<const T> in, std::span<std::complex<T>> out) const;
+        void inverse(std::span<const std::complex<T>> in, std::span<T> out) const;
+
+        // in 长度 count * size()，out 长度 count * (size() / 2 + 1)；inverse 反过来
+        void forward(std::span<const T> in, std::span<std::complex<T>> out, std::size_t count) const;
+        void inverse(std::span<const std::complex<T>> in, std::span<T> out, std::size_t count) const;
+
+    private:
+        void forward_one(const T* in, std::complex<T>* out) const;
+        void inverse_one(const std::complex<T>* in, T* out) const;
+
+        std::size_t n_;
+        fft_plan<T> complex_;                // 偶数 n：n / 2 点；奇数 n：n 点
+        std::vector<std::complex<T>> split_; // exp(-2 pi i k / n)，k < n / 2
+    };
+
+    extern template class fft_plan<float>;
+    extern template class fft_plan<double>;
+    extern template class rfft_plan<float>;
+    extern template class rfft_plan<double>;
+
+    // 清空 所有 缓存 的 plan
+    void clear_fft_plan_cache();
+
+    // 用 缓存 的 plan；空输入 什么都不做
+    void fft(std::span<const std::complex<float>> in, std::span<std::complex<float>> out);
+    void fft(std::span<const std::complex<double>> in, std::span<std::complex<double>> out);
+    void ifft(std::span<const std::complex<float>> in, std::span<std::complex<float>> out);
+    void ifft(std::span<const std::complex<double>> in, std::span<std::complex<double>> out);
+
+    // out 长度 in.size() / 2 + 1
+    void rfft(std::span<const float> in, std::span<std::complex<float>> out);
+    void rfft(std::span<const double> in, std::span<std::complex<double>> out);
+    // 输出 长度 n = out.size()，in 长度 n / 2 + 1
+    void irfft(std::span<const std::complex<float>> in, std::span<float> out);
+    void irfft(std::span<const std::complex<double>> in, std::span<double> out);
+}
+
+#endif // E_MATH_FFT_H
@@ -0,0 +1,94 @@
+#ifndef E_MATH_FORMULA_H
+#define E_MATH_FORMULA_H
+
+// 运行时 公式：把 文本 编译成 字节码，对 double 列 逐行 求值
+// 例：
+//   e_math::formula f("clamp(price * qty - fee, 0, 1e6)", {"price", "qty", "fee"});
+//   f.evaluate({price, qty, fee}, out);
+//
+// 语法：+ - * /、一元 -、括号、数字（1、2.5、1e-3）、列名（标识符）、函数调用
+// 函数：min(a, b) max(a, b) clamp(x, lo, hi) abs sqrt exp log sin cos tanh sigmoid
+//
+// 编译时 做 常量 折叠 与 公共子表达式 合并（a + b 与 b + a 算 同一个），然后 给 中间结果 分配 块 缓冲
+// 求值 时 每次 取 block_rows 行，一条 指令 对 整块 调用 一次 批量 内核（e_math::add、array_view 的 块 内核、e_vmath.hpp），
+// 解释 的 开销 按 块 摊薄，不是 每个 值 一次
+// 每个 运算 单独 舍入；exp 等 的 精度 见 e_vmath.hpp；折叠 用 同一套 内核，结果 与 不折叠 相同
+// min / max 按 交换律 合并，参数 有 NaN 或 ±0 相等 时 返回 哪一个 不保证
+//
+// 语法 错误、未知 列名 / 函数、参数 个数 不对 抛 std::invalid_argument，消息 里 带 出错 位置（从 0 开始 的 字节 下标）
+
+#include "e_expr.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace e_math {
+    class formula {
+    public:
+        static constexpr std::size_t block_rows = 1024;
+
+        // columns：公式 可以 用 的 列名，evaluate 时 按 同样 顺序 传 数据
+        formula(std::string_view text, std::vector<std::string> columns);
+
+        // columns[k] 是 构造时 第 k 个 列名 的 数据；列数 不对、各列 与 out 长度 不同 抛 std::invalid_argument
+        // out 可以 就是 某一列（原地），但 不能 与 列 部分 重叠
+        void evaluate(std::span<const std::span<const double>> columns, std::span<double> out,
+                      execution policy = execution::sequential) const;
+
+        void evaluate(std::initializer_list<std::span<const double>> columns, std::span<double> out,
+                      execution policy = execution::sequential) const {
+            evaluate(std::span<const std::span<const double>>(columns.begin(), columns.size()), out, policy);
+        }
+
+        std::size_t columns() const { return columns_.size(); }
+        const std::vector<std::string>& column_names() const { return columns_; }
+
+        // 折叠、合并 之后 的 指令数 与 块 缓冲数
+        std::size_t instructions() const { return code_.size(); }
+        std::size_t registers() const { return registers_; }
+
+    private:
+        // 操作数：第 index 列 / 第 index 个 块 缓冲 / 输出
+        struct operand {
+            enum class kind : unsigned char {
+                column,
+                reg,
+                output,
+            };
+
+            kind k = kind::reg;
+            std::uint32_t index = 0;
+        };
+
+        struct instruction {
+            enum class kind : unsigned char {
+                binary, // dst = a op b
+                scalar, // dst = a op s
+                unary,  // dst = f(a)
+                fill,   // dst = s
+            };
+
+            kind k = kind::fill;
+            operand a, b, dst;
+            double s = 0;
+            detail::expr_fn<double> binary = nullptr;
+            detail::expr_scalar_fn<double> scalar = nullptr;
+            void (*unary)(const double* a, double* out, std::size_t n) = nullptr;
+        };
+
+        class compiler;
+
+        void run(const std::span<const double>* columns, double* out, std::size_t begin, std::size_t end, double* regs) const;
+
+        std::vector<std::string> columns_;
+        std::vector<instruction> code_;
+        std::size_t registers_ = 0;
+    };
+}
+
+#endif // E_MATH_FORMULA_H
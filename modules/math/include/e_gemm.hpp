@@ -0,0 +1,41 @@
+#ifndef E_MATH_GEMM_H
+#define E_MATH_GEMM_H
+
+// 稠密矩阵乘法 C = alpha * A * B + beta * C
+// 按 L1 / L2 分块打包，寄存器分块的 SIMD 微内核 计算，C 的 分块 分给多个线程（set_max_threads）
+// 矩阵 可以是 行主序 / 列主序，带 主维 ld，所以 子矩阵 不用拷贝：
+//   行主序 的 子矩阵 data = &M[r0 * ld + c0]，列主序 的 data = &M[c0 * ld + r0]，ld 不变
+
+#include <cstddef>
+#include <type_traits>
+
+namespace e_math {
+    enum class layout {
+        row_major,
+        col_major,
+    };
+
+    // 不拥有数据 的 矩阵视图
+    // ld：行主序 是 相邻两行 首元素 的 距离（>= cols），列主序 是 相邻两列 的 距离（>= rows）
+    template <class T>
+    struct matrix_view {
+        T* data = nullptr;
+        std::size_t rows = 0;
+        std::size_t cols = 0;
+        std::size_t ld = 0;
+        layout order = layout::row_major;
+
+        operator matrix_view<const T>() const
+            requires(!std::is_const_v<T>)
+        {
+            return {data, rows, cols, ld, order};
+        }
+    };
+
+    // a: m x k，b: k x n，c: m x n，维度不符 或 ld 太小 抛 std::invalid_argument
+    // beta == 0 时 不读 C（C 里的 NaN 不会传播），c 不能与 a / b 重叠
+    void gemm(matrix_view<const float> a, matrix_view<const float> b, matrix_view<float> c, float alpha = 1, float beta = 0);
+    void gemm(matrix_view<const double> a, matrix_view<const double> b, matrix_view<double> c, double alpha = 1, double beta = 0);
+}
+
+#endif // E_MATH_GEMM_H
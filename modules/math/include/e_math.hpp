@@ -1,8 +1,26 @@
 #ifndef E_MATH_MATH_H
 #define E_MATH_MATH_H
 
+#include "e_arith.hpp"
+
+#include <cstdint>
+#include <span>
+
 namespace e_math {
+    // 动态库 导出的 旧接口，等价于 add(a, b, wrap)；热循环里请直接用 e_arith.hpp 的 内联版本
     int add(int a, int b);
+
+    // 批量加法：out[i] = a[i] + b[i]
+    // a / b / out 长度必须相同，否则抛 std::invalid_argument
+    // out 可以和 a 或 b 是同一块内存（原地），但不能部分重叠
+    // 整数按补码回绕，不检查溢出
+    void add(std::span<const std::int32_t> a, std::span<const std::int32_t> b, std::span<std::int32_t> out);
+    void add(std::span<const std::int64_t> a, std::span<const std::int64_t> b, std::span<std::int64_t> out);
+    void add(std::span<const float> a, std::span<const float> b, std::span<float> out);
+    void add(std::span<const double> a, std::span<const double> b, std::span<double> out);
+
+    // 库加载时按 cpuid 选中的 SIMD 内核："avx512" / "avx2" / "sse2" / "scalar"
+    const char* simd_isa();
 }
 
-#endif // E_MATH_MATH_H
\ No newline at end of file
+#endif // E_MATH_MATH_H
@@ -0,0 +1,12 @@
+#ifndef E_MATH_PARALLEL_H
+#define E_MATH_PARALLEL_H
+
+namespace e_math {
+    // 并行内核（reduce_* 等）最多使用的线程数，包含调用线程
+    // 0 表示 std::thread::hardware_concurrency()，默认 0；超过 hardware_concurrency() 的 部分 不起作用（共用 e_utils::thread_pool::global()）
+    // 各并行内核的结果 与 线程数 无关，这里只影响速度
+    void set_max_threads(unsigned n);
+    unsigned max_threads();
+}
+
+#endif // E_MATH_PARALLEL_H
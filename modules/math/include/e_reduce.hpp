@@ -0,0 +1,34 @@
+#ifndef E_MATH_REDUCE_H
+#define E_MATH_REDUCE_H
+
+// 并行归约：数据按固定大小分块，块内 16 路 SIMD 累加，块间 按固定顺序 两两合并
+// 分块 与 合并顺序 只取决于长度，所以结果 与 线程数（set_max_threads）、指令集 都无关，逐位可复现
+// 浮点 sum / dot：每一路 Kahan 补偿求和，块间 pairwise
+// 浮点 min / max：输入含 NaN 时 返回 NaN；空输入 抛 std::invalid_argument
+
+#include <cstdint>
+#include <span>
+
+namespace e_math {
+    // 整数求和 用 int64 累加，按补码回绕
+    std::int64_t reduce_sum(std::span<const std::int32_t> v);
+    std::int64_t reduce_sum(std::span<const std::int64_t> v);
+    float reduce_sum(std::span<const float> v);
+    double reduce_sum(std::span<const double> v);
+
+    std::int32_t reduce_min(std::span<const std::int32_t> v);
+    std::int64_t reduce_min(std::span<const std::int64_t> v);
+    float reduce_min(std::span<const float> v);
+    double reduce_min(std::span<const double> v);
+
+    std::int32_t reduce_max(std::span<const std::int32_t> v);
+    std::int64_t reduce_max(std::span<const std::int64_t> v);
+    float reduce_max(std::span<const float> v);
+    double reduce_max(std::span<const double> v);
+
+    // a / b 长度必须相同
+    float reduce_dot(std::span<const float> a, std::span<const float> b);
+    double reduce_dot(std::span<const double> a, std::span<const double> b);
+}
+
+#endif // E_MATH_REDUCE_H
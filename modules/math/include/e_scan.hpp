@@ -0,0 +1,27 @@
+#ifndef E_MATH_SCAN_H
+#define E_MATH_SCAN_H
+
+// 前缀和
+//   inclusive_scan: out[i] = in[0] + ... + in[i]
+//   exclusive_scan: out[i] = init + in[0] + ... + in[i - 1]，out[0] = init
+// in / out 长度必须相同，否则抛 std::invalid_argument；out 可以就是 in（原地），但不能部分重叠
+// 整数 按补码回绕
+// 长数组 分块两遍：先并行求 各块之和，再并行 带进位 扫描各块；
+// 分块 只取决于长度，所以 浮点结果 与 线程数 无关（不同指令集 之间 舍入可能不同）
+
+#include <cstdint>
+#include <span>
+
+namespace e_math {
+    void inclusive_scan(std::span<const std::int32_t> in, std::span<std::int32_t> out);
+    void inclusive_scan(std::span<const std::int64_t> in, std::span<std::int64_t> out);
+    void inclusive_scan(std::span<const float> in, std::span<float> out);
+    void inclusive_scan(std::span<const double> in, std::span<double> out);
+
+    void exclusive_scan(std::span<const std::int32_t> in, std::span<std::int32_t> out, std::int32_t init = 0);
+    void exclusive_scan(std::span<const std::int64_t> in, std::span<std::int64_t> out, std::int64_t init = 0);
+    void exclusive_scan(std::span<const float> in, std::span<float> out, float init = 0);
+    void exclusive_scan(std::span<const double> in, std::span<double> out, double init = 0);
+}
+
+#endif // E_MATH_SCAN_H
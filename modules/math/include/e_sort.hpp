@@ -0,0 +1,66 @@
+#ifndef E_MATH_SORT_H
+#define E_MATH_SORT_H
+
+// 基数排序：升序、稳定，按 8 位 一趟
+//
+// 大输入 先按 最高的 非常数 字节 做一趟 MSD 分桶（多线程 统计 + 散射），再 各桶 并行 做 LSD（桶 小，在 缓存里 完成）；小输入 直接 LSD
+// 所有键 都相同的 字节 跳过，例如 只用到 低 20 位 的 uint32 只排 3 趟
+// 桶 之间 不再细分，分布 极度 倾斜（大部分键 落在 同一个 最高字节）时 并行度 会下降
+//
+// 浮点键 用 翻转 符号位 / 全部位 的 技巧 变成 无符号整数 排序：
+//   -inf < 负数 < -0 < +0 < 正数 < +inf，负号的 NaN 排在 最前，正号的 NaN 排在 最后
+//
+// scratch 版本 只用 调用方 给的 缓冲区 与 栈，不 分配 内存；多线程 时 线程池 派发 任务 仍有 几个 与 线程数 成正比 的 小 分配
+//   scratch 至少 与 keys 一样长，否则 抛 std::invalid_argument；排序后 内容 未指定
+// radix_sort_pairs 让 values[i] 跟着 keys[i] 移动，长度 不同 抛 std::invalid_argument
+// 值 是 32 / 64 位 无符号整数（通常 是 下标 或 句柄）
+
+#include <cstdint>
+#include <span>
+
+namespace e_math {
+    void radix_sort(std::span<std::int32_t> keys);
+    void radix_sort(std::span<std::uint32_t> keys);
+    void radix_sort(std::span<std::int64_t> keys);
+    void radix_sort(std::span<std::uint64_t> keys);
+    void radix_sort(std::span<float> keys);
+    void radix_sort(std::span<double> keys);
+
+    // 只用 scratch，不分配内存
+    void radix_sort(std::span<std::int32_t> keys, std::span<std::int32_t> scratch);
+    void radix_sort(std::span<std::uint32_t> keys, std::span<std::uint32_t> scratch);
+    void radix_sort(std::span<std::int64_t> keys, std::span<std::int64_t> scratch);
+    void radix_sort(std::span<std::uint64_t> keys, std::span<std::uint64_t> scratch);
+    void radix_sort(std::span<float> keys, std::span<float> scratch);
+    void radix_sort(std::span<double> keys, std::span<double> scratch);
+
+    // 键值对
+    void radix_sort_pairs(std::span<std::int32_t> keys, std::span<std::uint32_t> values);
+    void radix_sort_pairs(std::span<std::int32_t> keys, std::span<std::uint64_t> values);
+    void radix_sort_pairs(std::span<std::uint32_t> keys, std::span<std::uint32_t> values);
+    void radix_sort_pairs(std::span<std::uint32_t> keys, std::span<std::uint64_t> values);
+    void radix_sort_pairs(std::span<std::int64_t> keys, std::span<std::uint32_t> values);
+    void radix_sort_pairs(std::span<std::int64_t> keys, std::span<std::uint64_t> values);
+    void radix_sort_pairs(std::span<std::uint64_t> keys, std::span<std::uint32_t> values);
+    void radix_sort_pairs(std::span<std::uint64_t> keys, std::span<std::uint64_t> values);
+    void radix_sort_pairs(std::span<float> keys, std::span<std::uint32_t> values);
+    void radix_sort_pairs(std::span<float> keys, std::span<std::uint64_t> values);
+    void radix_sort_pairs(std::span<double> keys, std::span<std::uint32_t> values);
+    void radix_sort_pairs(std::span<double> keys, std::span<std::uint64_t> values);
+
+    // 键值对，只用 key_scratch / value_scratch，不分配内存
+    void radix_sort_pairs(std::span<std::int32_t> keys, std::span<std::uint32_t> values, std::span<std::int32_t> key_scratch, std::span<std::uint32_t> value_scratch);
+    void radix_sort_pairs(std::span<std::int32_t> keys, std::span<std::uint64_t> values, std::span<std::int32_t> key_scratch, std::span<std::uint64_t> value_scratch);
+    void radix_sort_pairs(std::span<std::uint32_t> keys, std::span<std::uint32_t> values, std::span<std::uint32_t> key_scratch, std::span<std::uint32_t> value_scratch);
+    void radix_sort_pairs(std::span<std::uint32_t> keys, std::span<std::uint64_t> values, std::span<std::uint32_t> key_scratch, std::span<std::uint64_t> value_scratch);
+    void radix_sort_pairs(std::span<std::int64_t> keys, std::span<std::uint32_t> values, std::span<std::int64_t> key_scratch, std::span<std::uint32_t> value_scratch);
+    void radix_sort_pairs(std::span<std::int64_t> keys, std::span<std::uint64_t> values, std::span<std::int64_t> key_scratch, std::span<std::uint64_t> value_scratch);
+    void radix_sort_pairs(std::span<std::uint64_t> keys, std::span<std::uint32_t> values, std::span<std::uint64_t> key_scratch, std::span<std::uint32_t> value_scratch);
+    void radix_sort_pairs(std::span<std::uint64_t> keys, std::span<std::uint64_t> values, std::span<std::uint64_t> key_scratch, std::span<std::uint64_t> value_scratch);
+    void radix_sort_pairs(std::span<float> keys, std::span<std::uint32_t> values, std::span<float> key_scratch, std::span<std::uint32_t> value_scratch);
+    void radix_sort_pairs(std::span<float> keys, std::span<std::uint64_t> values, std::span<float> key_scratch, std::span<std::uint64_t> value_scratch);
+    void radix_sort_pairs(std::span<double> keys, std::span<std::uint32_t> values, std::span<double> key_scratch, std::span<std::uint32_t> value_scratch);
+    void radix_sort_pairs(std::span<double> keys, std::span<std::uint64_t> values, std::span<double> key_scratch, std::span<std::uint64_t> value_scratch);
+}
+
+#endif // E_MATH_SORT_H
@@ -0,0 +1,57 @@
+#ifndef E_MATH_SPARSE_H
+#define E_MATH_SPARSE_H
+
+// CSR（压缩行）稀疏矩阵 与 稀疏矩阵-向量乘（SpMV）
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace e_math {
+    // COO 三元组：(row, col) 处的 值
+    template <class T>
+    struct coo_entry {
+        std::size_t row;
+        std::size_t col;
+        T value;
+    };
+
+    // 第 i 行 的 非零元 是 [row_ptr[i], row_ptr[i + 1])，行内 按列号 升序、没有重复
+    // 列号 用 uint32 省带宽，cols 不能超过 2^31 - 1（SIMD gather 的 下标 是 有符号 32 位）
+    template <class T>
+    class csr_matrix {
+    public:
+        csr_matrix() = default;
+
+        // 从 COO 三元组 构建，三元组 不需要 有序；同一位置 出现多次 时 按输入顺序 相加
+        // 下标越界 或 cols 太大 抛 std::invalid_argument
+        csr_matrix(std::size_t rows, std::size_t cols, std::span<const coo_entry<T>> entries);
+
+        std::size_t rows() const { return rows_; }
+        std::size_t cols() const { return cols_; }
+        std::size_t nnz() const { return values_.size(); }
+
+        std::span<const std::size_t> row_ptr() const { return row_ptr_; }
+        std::span<const std::uint32_t> col_idx() const { return col_idx_; }
+        std::span<const T> values() const { return values_; }
+
+    private:
+        std::size_t rows_ = 0;
+        std::size_t cols_ = 0;
+        std::vector<std::size_t> row_ptr_ = {0};
+        std::vector<std::uint32_t> col_idx_;
+        std::vector<T> values_;
+    };
+
+    extern template class csr_matrix<float>;
+    extern template class csr_matrix<double>;
+
+    // y = A * x；x 长度 = cols，y 长度 = rows，否则抛 std::invalid_argument
+    // 行 按 非零元个数 均分 给各线程；每行 的 结果 与 线程数 无关，SIMD gather 累加 的 顺序 与 指令集 有关
+    // y 不能与 x 重叠
+    void spmv(const csr_matrix<float>& a, std::span<const float> x, std::span<float> y);
+    void spmv(const csr_matrix<double>& a, std::span<const double> x, std::span<double> y);
+}
+
+#endif // E_MATH_SPARSE_H
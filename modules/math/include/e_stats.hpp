@@ -0,0 +1,97 @@
+#ifndef E_MATH_STATS_H
+#define E_MATH_STATS_H
+
+// 流式统计：常数内存，不保存 原始数据
+// 每个线程 各用 一个 累加器，最后 merge 汇总，不需要 加锁；单个对象 不是 线程安全的
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace e_math {
+    // 均值 / 方差：Welford 单遍更新，合并 用 Chan 等人 的 两两合并公式
+    // NaN 会让 mean / variance 变成 NaN；min / max 忽略 NaN
+    class moments {
+    public:
+        void add(double x);
+        // 分块 先算 块内 均值 与 平方差和，再 与 已有结果 合并，比 逐个 add 快且 误差 更小
+        void add(std::span<const float> v);
+        void add(std::span<const double> v);
+
+        void merge(const moments& other);
+
+        std::uint64_t count() const { return n_; }
+        // 空时 返回 NaN
+        double mean() const;
+        // 总体方差 M2 / n；空时 NaN
+        double variance() const;
+        // 样本方差 M2 / (n - 1)；少于 2 个 时 NaN
+        double sample_variance() const;
+        double stddev() const;
+        // 空时 返回 NaN
+        double min() const;
+        double max() const;
+
+    private:
+        std::uint64_t n_ = 0;
+        double mean_ = 0;
+        double m2_ = 0;
+        double min_ = std::numeric_limits<double>::infinity();
+        double max_ = -std::numeric_limits<double>::infinity();
+    };
+
+    // 分位数 sketch：合并式 t-digest（Dunning），k1 尺度函数
+    // 质心 在 两端 很小、在 中间 较大，所以 p99 / p999 这样的 尾部分位数 比 中位数 更准
+    // 分位数 q 处 的 秩误差 通常 小于 2 * pi * sqrt(q * (1 - q)) / compression
+    // 内存：最多 约 compression 个 质心，加上 容量 固定 的 输入缓冲区
+    // 非有限值（NaN / ±inf）被忽略
+    class tdigest {
+    public:
+        // compression 越大 越准、越占内存；小于 10 抛 std::invalid_argument
+        explicit tdigest(double compression = 100);
+
+        // weight 必须 是 正的 有限值，否则 抛 std::invalid_argument
+        void add(double x, double weight = 1);
+        void add(std::span<const float> v);
+        void add(std::span<const double> v);
+
+        // 合并 另一个 sketch（compression 可以不同，结果 用 自己的）；other 可以 是 自己
+        void merge(const tdigest& other);
+
+        // 把 缓冲区 并入 质心；quantile 会 自动 处理 缓冲区，频繁查询 前 先调用 这个 更快
+        void compress();
+
+        // q 在 [0, 1] 内，否则 抛 std::invalid_argument；空时 返回 NaN
+        double quantile(double q) const;
+
+        // 总权重
+        double count() const { return total_ + buffered_; }
+        // 空时 返回 NaN
+        double min() const;
+        double max() const;
+        double compression() const { return compression_; }
+        // 当前 质心数（不含 缓冲区）
+        std::size_t centroid_count() const { return centroids_.size(); }
+
+    private:
+        struct centroid {
+            double mean;
+            double weight;
+        };
+
+        void push_buffered(centroid c);
+
+        double compression_;
+        std::size_t buffer_limit_; // 缓冲区 满 这么多 个 就 compress；不能 用 capacity()，拷贝 时 不保留
+        double total_ = 0;
+        double buffered_ = 0;
+        double min_ = std::numeric_limits<double>::infinity();
+        double max_ = -std::numeric_limits<double>::infinity();
+        std::vector<centroid> centroids_; // 按 mean 升序
+        std::vector<centroid> buffer_;
+    };
+}
+
+#endif // E_MATH_STATS_H
@@ -0,0 +1,49 @@
+#ifndef E_MATH_VMATH_H
+#define E_MATH_VMATH_H
+
+// 批量 超越函数：out[i] = f(in[i])，SIMD 多项式逼近，按 CPU 选 指令集
+// in / out 长度必须相同，否则抛 std::invalid_argument；out 可以就是 in（原地），但不能部分重叠
+//
+// 误差上界（ULP，与 <cmath> 的 高精度结果 比较，全定义域，含 非规格数；tests/math/test_vmath.cpp 检查）：
+//
+//             float               double
+//             accurate   fast     accurate   fast
+//   exp       1          2.5      1.5        3
+//   log       1          2        1          1
+//   sin/cos   2.5        2.5      2          2
+//   tanh      2          3        2          2.5
+//   sigmoid   2.5        3.5      2.5        4
+//
+// fast 用 更短的 多项式（exp，float 的 log / tanh），tanh / sigmoid 的 fast 也用 fast 的 exp；其余 与 accurate 相同
+// 特殊值 与 <cmath> 一致：NaN 传播，exp(-inf) = 0，log(0) = -inf，log(负数) = NaN，sin(±inf) = NaN
+// sin / cos 的 |x| 超过 8192（float）/ 2^30（double）时，该元素 回落到 <cmath>
+
+#include <span>
+
+namespace e_math {
+    enum class precision {
+        accurate,
+        fast,
+    };
+
+    void exp(std::span<const float> in, std::span<float> out, precision p = precision::accurate);
+    void exp(std::span<const double> in, std::span<double> out, precision p = precision::accurate);
+
+    void log(std::span<const float> in, std::span<float> out, precision p = precision::accurate);
+    void log(std::span<const double> in, std::span<double> out, precision p = precision::accurate);
+
+    void sin(std::span<const float> in, std::span<float> out, precision p = precision::accurate);
+    void sin(std::span<const double> in, std::span<double> out, precision p = precision::accurate);
+
+    void cos(std::span<const float> in, std::span<float> out, precision p = precision::accurate);
+    void cos(std::span<const double> in, std::span<double> out, precision p = precision::accurate);
+
+    void tanh(std::span<const float> in, std::span<float> out, precision p = precision::accurate);
+    void tanh(std::span<const double> in, std::span<double> out, precision p = precision::accurate);
+
+    // 1 / (1 + exp(-x))
+    void sigmoid(std::span<const float> in, std::span<float> out, precision p = precision::accurate);
+    void sigmoid(std::span<const double> in, std::span<double> out, precision p = precision::accurate);
+}
+
+#endif // E_MATH_VMATH_H
@@ -0,0 +1,715 @@
+#include "e_bigint.hpp"
+#include "e_simd.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+#endif
+
+namespace e_math {
+    namespace {
+        using limb = std::uint64_t;
+
+        // ---------------- 单个 limb ----------------
+
+        inline unsigned char add_carry(unsigned char carry, limb a, limb b, limb* r) {
+#if E_MATH_X86
+            unsigned long long out;
+            carry = _addcarry_u64(carry, a, b, &out);
+            *r = out;
+            return carry;
+#else
+            const limb s = a + b;
+            const limb t = s + carry;
+            *r = t;
+            return static_cast<unsigned char>((s < a) | (t < s));
+#endif
+        }
+
+        inline unsigned char sub_borrow(unsigned char borrow, limb a, limb b, limb* r) {
+#if E_MATH_X86
+            unsigned long long out;
+            borrow = _subborrow_u64(borrow, a, b, &out);
+            *r = out;
+            return borrow;
+#else
+            const limb d = a - b;
+            const limb t = d - borrow;
+            *r = t;
+            return static_cast<unsigned char>((a < b) | (d < borrow));
+#endif
+        }
+
+        // 64 x 64 -> 128：返回 低 64 位，高 64 位 写到 hi
+        inline limb mul_wide(limb a, limb b, limb* hi) {
+#if defined(__SIZEOF_INT128__)
+            const unsigned __int128 p = static_cast<unsigned __int128>(a) * b;
+            *hi = static_cast<limb>(p >> 64);
+            return static_cast<limb>(p);
+#else
+            return _umul128(a, b, hi);
+#endif
+        }
+
+        // (hi, lo) / d，要求 hi < d
+        inline limb div_wide(limb hi, limb lo, limb d, limb* rem) {
+#if defined(__SIZEOF_INT128__)
+            const unsigned __int128 n = (static_cast<unsigned __int128>(hi) << 64) | lo;
+            *rem = static_cast<limb>(n % d);
+            return static_cast<limb>(n / d);
+#else
+            return _udiv128(hi, lo, d, rem);
+#endif
+        }
+
+        // ---------------- limb 数组：低位 在前 ----------------
+
+        // r = a + b，各 n 个，返回 进位；r 可以 就是 a 或 b
+        unsigned char add_n(limb* r, const limb* a, const limb* b, std::size_t n) {
+            unsigned char c = 0;
+            for (std::size_t i = 0; i < n; ++i) c = add_carry(c, a[i], b[i], r + i);
+            return c;
+        }
+
+        unsigned char sub_n(limb* r, const limb* a, const limb* b, std::size_t n) {
+            unsigned char c = 0;
+            for (std::size_t i = 0; i < n; ++i) c = sub_borrow(c, a[i], b[i], r + i);
+            return c;
+        }
+
+        // r = a + b，an >= bn，r 有 an 个
+        unsigned char add(limb* r, const limb* a, std::size_t an, const limb* b, std::size_t bn) {
+            unsigned char c = add_n(r, a, b, bn);
+            for (std::size_t i = bn; i < an; ++i) c = add_carry(c, a[i], 0, r + i);
+            return c;
+        }
+
+        // r = a - b，a >= b
+        void sub(limb* r, const limb* a, std::size_t an, const limb* b, std::size_t bn) {
+            unsigned char c = sub_n(r, a, b, bn);
+            for (std::size_t i = bn; i < an; ++i) c = sub_borrow(c, a[i], 0, r + i);
+        }
+
+        // 没有 前导 0 的 两个 数 比较 大小
+        int compare(const limb* a, std::size_t an, const limb* b, std::size_t bn) {
+            if (an != bn) {
+                return an < bn ? -1 : 1;
+            }
+            for (std::size_t i = an; i-- > 0;) {
+                if (a[i] != b[i]) {
+                    return a[i] < b[i] ? -1 : 1;
+                }
+            }
+            return 0;
+        }
+
+        // 允许 前导 0 的 比较，两个 都 是 n 个
+        int compare_n(const limb* a, const limb* b, std::size_t n) {
+            for (std::size_t i = n; i-- > 0;) {
+                if (a[i] != b[i]) {
+                    return a[i] < b[i] ? -1 : 1;
+                }
+            }
+            return 0;
+        }
+
+        // r[0, n) += a[0, n) * b，返回 进位 limb
+        limb addmul_1(limb* r, const limb* a, std::size_t n, limb b) {
+            limb carry = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                limb hi;
+                limb lo = mul_wide(a[i], b, &hi);
+                lo += carry;
+                hi += lo < carry;
+                const limb s = r[i] + lo;
+                hi += s < lo;
+                r[i] = s;
+                carry = hi;
+            }
+            return carry;
+        }
+
+        // r[0, n) -= a[0, n) * b，返回 借位 limb
+        limb submul_1(limb* r, const limb* a, std::size_t n, limb b) {
+            limb borrow = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                limb hi;
+                limb lo = mul_wide(a[i], b, &hi);
+                lo += borrow;
+                hi += lo < borrow;
+                const limb x = r[i];
+                r[i] = x - lo;
+                hi += x < lo;
+                borrow = hi;
+            }
+            return borrow;
+        }
+
+        // r[0, an + bn) = a * b，r 不能 与 a、b 重叠
+        void mul_basecase(limb* r, const limb* a, std::size_t an, const limb* b, std::size_t bn) {
+            std::fill(r, r + an, limb(0));
+            for (std::size_t j = 0; j < bn; ++j) r[an + j] = addmul_1(r + j, a, an, b[j]);
+        }
+
+        // d = |x - y|，x 有 m 个、y 有 k 个（k <= m，高位 补 0），返回 x < y
+        bool abs_diff(limb* d, const limb* x, std::size_t m, const limb* y, std::size_t k) {
+            const bool less = std::all_of(x + k, x + m, [](limb v) { return v == 0; }) && compare_n(x, y, k) < 0;
+            if (less) {
+                sub(d, y, k, x, k);
+                std::fill(d + k, d + m, limb(0));
+            } else {
+                sub(d, x, m, y, k);
+            }
+            return less;
+        }
+
+        // Karatsuba 的 临时空间：每层 |a1 - a0|、|b1 - b0|、它们的 积 共 4m 个，再加 下一层 与 z0 + z2 的 较大者
+        std::size_t karatsuba_scratch(std::size_t n) {
+            if (n < bigint::karatsuba_threshold) {
+                return 0;
+            }
+            const std::size_t m = n - n / 2;
+            return 4 * m + std::max(2 * m + 1, karatsuba_scratch(m));
+        }
+
+        // r[0, 2n) = a * b，两边 都是 n 个；a = a0 + a1 B^k，k = n / 2，m = n - k
+        // z1 = z0 + z2 - (a1 - a0)(b1 - b0)，差 的 绝对值 与 符号 分开 算，三次 乘法 都是 不超过 m 个 limb
+        void karatsuba(limb* r, const limb* a, const limb* b, std::size_t n, limb* t) {
+            if (n < bigint::karatsuba_threshold) {
+                mul_basecase(r, a, n, b, n);
+                return;
+            }
+            const std::size_t k = n / 2;
+            const std::size_t m = n - k;
+            limb* da = t;
+            limb* db = t + m;
+            limb* mid = t + 2 * m;
+            limb* next = t + 4 * m;
+
+            const bool na = abs_diff(da, a + k, m, a, k);
+            const bool nb = abs_diff(db, b + k, m, b, k);
+            karatsuba(r, a, b, k, next);                 // z0 -> r[0, 2k)
+            karatsuba(r + 2 * k, a + k, b + k, m, next); // z2 -> r[2k, 2n)
+            karatsuba(mid, da, db, m, next);
+
+            // next = z0 + z2（2m + 1 个），再 减去 或 加上 mid，最后 加到 r[k, ...)
+            limb* sum = next;
+            std::copy(r + 2 * k, r + 2 * n, sum);
+            sum[2 * m] = add(sum, sum, 2 * m, r, 2 * k);
+            if (na == nb) {
+                sub(sum, sum, 2 * m + 1, mid, 2 * m);
+            } else {
+                sum[2 * m] += add_n(sum, sum, mid, 2 * m);
+            }
+            add(r + k, r + k, 2 * n - k, sum, 2 * m + 1);
+        }
+
+        void multiply(limb* r, const limb* a, std::size_t an, const limb* b, std::size_t bn);
+
+        // an >= bn >= karatsuba_threshold：a 切成 bn 个 一段，各段 与 b 做 Karatsuba 后 错位 累加
+        void multiply_chunked(limb* r, const limb* a, std::size_t an, const limb* b, std::size_t bn) {
+            std::vector<limb> scratch(2 * bn + karatsuba_scratch(bn));
+            limb* prod = scratch.data();
+            limb* t = prod + 2 * bn;
+            if (an == bn) {
+                karatsuba(r, a, b, bn, t);
+                return;
+            }
+            std::fill(r, r + an + bn, limb(0));
+            for (std::size_t off = 0; off < an; off += bn) {
+                const std::size_t len = std::min(bn, an - off);
+                if (len == bn) {
+                    karatsuba(prod, a + off, b, bn, t);
+                } else {
+                    multiply(prod, b, bn, a + off, len);
+                }
+                add(r + off, r + off, an + bn - off, prod, bn + len);
+            }
+        }
+
+        // r[0, an + bn) = a * b，an、bn >= 1，r 不能 与 a、b 重叠
+        void multiply(limb* r, const limb* a, std::size_t an, const limb* b, std::size_t bn) {
+            if (an < bn) {
+                std::swap(a, b);
+                std::swap(an, bn);
+            }
+            if (bn < bigint::karatsuba_threshold) {
+                mul_basecase(r, a, an, b, bn);
+            } else {
+                multiply_chunked(r, a, an, b, bn);
+            }
+        }
+
+        // q[0, n) = a / d，返回 余数
+        limb divrem_1(limb* q, const limb* a, std::size_t n, limb d) {
+            limb rem = 0;
+            for (std::size_t i = n; i-- > 0;) q[i] = div_wide(rem, a[i], d, &rem);
+            return rem;
+        }
+
+        // Knuth 算法 D：an >= bn >= 2，b 最高 limb 非 0
+        // q[0, an - bn + 1) 为 商，r[0, bn) 为 余数
+        void divrem(limb* q, limb* r, const limb* a, std::size_t an, const limb* b, std::size_t bn) {
+            const unsigned s = static_cast<unsigned>(std::countl_zero(b[bn - 1]));
+            // 左移 s 位，让 除数 最高位 为 1，试商 最多 大 2
+            std::vector<limb> buffer(an + 1 + bn);
+            limb* u = buffer.data();
+            limb* v = u + an + 1;
+            auto shift_left = [s](limb* dst, const limb* src, std::size_t n) {
+                if (s == 0) {
+                    std::copy(src, src + n, dst);
+                    return limb(0);
+                }
+                limb carry = 0;
+                for (std::size_t i = 0; i < n; ++i) {
+                    dst[i] = (src[i] << s) | carry;
+                    carry = src[i] >> (64 - s);
+                }
+                return carry;
+            };
+            shift_left(v, b, bn);
+            u[an] = shift_left(u, a, an);
+
+            const limb v1 = v[bn - 1];
+            const limb v2 = v[bn - 2];
+            for (std::size_t j = an - bn + 1; j-- > 0;) {
+                limb qhat, rhat;
+                const limb top = u[j + bn];
+                bool rhat_overflow = false;
+                if (top >= v1) {
+                    // 试商 会 超过 64 位：取 B - 1，rhat = (top, next) - (B - 1) * v1 = next + v1（top == v1）
+                    qhat = ~limb(0);
+                    rhat = u[j + bn - 1] + v1;
+                    rhat_overflow = rhat < v1;
+                } else {
+                    qhat = div_wide(top, u[j + bn - 1], v1, &rhat);
+                }
+                // qhat * v2 > (rhat, u[j + bn - 2]) 时 减 1，最多 两次
+                while (!rhat_overflow) {
+                    limb hi;
+                    const limb lo = mul_wide(qhat, v2, &hi);
+                    if (hi < rhat || (hi == rhat && lo <= u[j + bn - 2])) {
+                        break;
+                    }
+                    --qhat;
+                    rhat += v1;
+                    rhat_overflow = rhat < v1;
+                }
+
+                const limb borrow = submul_1(u + j, v, bn, qhat);
+                const limb t = u[j + bn];
+                u[j + bn] = t - borrow;
+                if (t < borrow) {
+                    // 减多了：加回 一次
+                    --qhat;
+                    u[j + bn] += add_n(u + j, u + j, v, bn);
+                }
+                q[j] = qhat;
+            }
+
+            // 余数 在 u[0, bn)，右移 回去
+            for (std::size_t i = 0; i < bn; ++i) {
+                r[i] = s == 0 ? u[i] : (u[i] >> s) | (i + 1 < bn ? u[i + 1] << (64 - s) : limb(0));
+            }
+        }
+
+        std::size_t trimmed(const limb* p, std::size_t n) {
+            while (n > 0 && p[n - 1] == 0) --n;
+            return n;
+        }
+
+        // 10^19：一个 limb 能 放下 的 最大 10 的 幂
+        constexpr limb decimal_base = 10000000000000000000ull;
+        constexpr int decimal_digits = 19;
+    }
+
+    // ---------------- 存储 ----------------
+
+    bigint::bigint(const bigint& other) : bigint() {
+        assign(other.data(), other.size_, other.negative_);
+    }
+
+    bigint::bigint(bigint&& other) noexcept : size_(other.size_), capacity_(other.capacity_), negative_(other.negative_) {
+        if (other.is_inline()) {
+            inline_[0] = other.inline_[0];
+            inline_[1] = other.inline_[1];
+        } else {
+            heap_ = other.heap_;
+            other.capacity_ = inline_limbs;
+        }
+        other.size_ = 0;
+        other.negative_ = false;
+    }
+
+    bigint& bigint::operator=(const bigint& other) {
+        if (this != &other) {
+            assign(other.data(), other.size_, other.negative_);
+        }
+        return *this;
+    }
+
+    bigint& bigint::operator=(bigint&& other) noexcept {
+        if (this != &other) {
+            if (!is_inline()) {
+                delete[] heap_;
+            }
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            negative_ = other.negative_;
+            if (other.is_inline()) {
+                inline_[0] = other.inline_[0];
+                inline_[1] = other.inline_[1];
+            } else {
+                heap_ = other.heap_;
+                other.capacity_ = inline_limbs;
+            }
+            other.size_ = 0;
+            other.negative_ = false;
+        }
+        return *this;
+    }
+
+    bigint::~bigint() {
+        if (!is_inline()) {
+            delete[] heap_;
+        }
+    }
+
+    void bigint::reserve(std::size_t n) {
+        if (n <= capacity_) {
+            return;
+        }
+        if (n > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::length_error("e_math::bigint: value is too large");
+        }
+        const std::size_t cap = std::min<std::size_t>(std::max<std::size_t>(n, 2 * std::size_t(capacity_)), std::numeric_limits<std::uint32_t>::max());
+        limb* p = new limb[cap];
+        std::copy(data(), data() + size_, p);
+        if (!is_inline()) {
+            delete[] heap_;
+        }
+        heap_ = p;
+        capacity_ = static_cast<std::uint32_t>(cap);
+    }
+
+    void bigint::trim() noexcept {
+        size_ = static_cast<std::uint32_t>(trimmed(data(), size_));
+        if (size_ == 0) {
+            negative_ = false;
+        }
+    }
+
+    void bigint::assign(const std::uint64_t* limbs, std::size_t n, bool negative) {
+        n = trimmed(limbs, n);
+        if (n > capacity_) {
+            // 不需要 保留 旧 内容
+            size_ = 0;
+            reserve(n);
+        }
+        std::copy(limbs, limbs + n, data());
+        size_ = static_cast<std::uint32_t>(n);
+        negative_ = negative && n > 0;
+    }
+
+    // ---------------- 文本 ----------------
+
+    bigint::bigint(std::string_view text) : bigint() {
+        bool negative = false;
+        if (!text.empty() && (text[0] == '+' || text[0] == '-')) {
+            negative = text[0] == '-';
+            text.remove_prefix(1);
+        }
+        if (text.empty()) {
+            throw std::invalid_argument("e_math::bigint: empty number");
+        }
+        for (char c : text) {
+            if (c < '0' || c > '9') {
+                throw std::invalid_argument("e_math::bigint: invalid decimal digit");
+            }
+        }
+
+        // 每次 19 位：x = x * 10^k + chunk
+        std::vector<limb> v;
+        v.reserve(text.size() / decimal_digits + 2);
+        std::size_t pos = 0;
+        const std::size_t first = text.size() % decimal_digits == 0 ? decimal_digits : text.size() % decimal_digits;
+        for (std::size_t len = first; pos < text.size(); pos += len, len = decimal_digits) {
+            limb chunk = 0, scale = 1;
+            for (std::size_t i = 0; i < len; ++i) {
+                chunk = chunk * 10 + static_cast<limb>(text[pos + i] - '0');
+                scale *= 10;
+            }
+            limb carry = chunk;
+            for (auto& x : v) {
+                limb hi;
+                limb lo = mul_wide(x, scale, &hi);
+                lo += carry;
+                hi += lo < carry;
+                x = lo;
+                carry = hi;
+            }
+            if (carry != 0) {
+                v.push_back(carry);
+            }
+        }
+        assign(v.data(), v.size(), negative);
+    }
+
+    std::string bigint::to_string() const {
+        if (size_ == 0) {
+            return "0";
+        }
+        // 反复 除以 10^19，低位 的 段 先 出来
+        std::vector<limb> v(data(), data() + size_);
+        std::vector<limb> chunks;
+        std::size_t n = v.size();
+        while (n > 0) {
+            chunks.push_back(divrem_1(v.data(), v.data(), n, decimal_base));
+            n = trimmed(v.data(), n);
+        }
+        std::string s = negative_ ? "-" : "";
+        s += std::to_string(chunks.back());
+        for (std::size_t i = chunks.size() - 1; i-- > 0;) {
+            const std::string part = std::to_string(chunks[i]);
+            s.append(decimal_digits - part.size(), '0');
+            s += part;
+        }
+        return s;
+    }
+
+    std::ostream& operator<<(std::ostream& os, const bigint& value) {
+        return os << value.to_string();
+    }
+
+    // ---------------- 查询 与 转换 ----------------
+
+    std::size_t bigint::bit_length() const noexcept {
+        return size_ == 0 ? 0 : 64 * (std::size_t(size_) - 1) + static_cast<std::size_t>(std::bit_width(data()[size_ - 1]));
+    }
+
+    bool bigint::fits_int64() const noexcept {
+        if (size_ > 1) {
+            return false;
+        }
+        const limb m = size_ == 0 ? 0 : data()[0];
+        return m <= (negative_ ? limb(1) << 63 : (limb(1) << 63) - 1);
+    }
+
+    std::int64_t bigint::to_int64() const {
+        if (!fits_int64()) {
+            throw std::overflow_error("e_math::bigint: value does not fit in int64");
+        }
+        const limb m = size_ == 0 ? 0 : data()[0];
+        return static_cast<std::int64_t>(negative_ ? limb(0) - m : m);
+    }
+
+    double bigint::to_double() const noexcept {
+        const std::size_t bits = bit_length();
+        if (bits == 0) {
+            return 0.0;
+        }
+        const limb* p = data();
+        double magnitude;
+        if (bits <= 64) {
+            magnitude = static_cast<double>(p[0]);
+        } else {
+            // 取 最高 64 位，更低 的 位 非 0 时 把 最低位 置 1（粘滞位），转换 时 的 舍入 就 与 整个数 一致
+            const std::size_t shift = bits - 64;
+            const std::size_t li = shift / 64;
+            const unsigned off = static_cast<unsigned>(shift % 64);
+            limb top = off == 0 ? p[li] : (p[li] >> off) | (p[li + 1] << (64 - off));
+            bool sticky = off != 0 && (p[li] & ((limb(1) << off) - 1)) != 0;
+            for (std::size_t i = 0; i < li && !sticky; ++i) sticky = p[i] != 0;
+            top |= static_cast<limb>(sticky);
+            magnitude = std::ldexp(static_cast<double>(top), static_cast<int>(std::min<std::size_t>(shift, 4096)));
+        }
+        return negative_ ? -magnitude : magnitude;
+    }
+
+    // ---------------- 比较 ----------------
+
+    bool operator==(const bigint& a, const bigint& b) noexcept {
+        return a.negative_ == b.negative_ && compare(a.data(), a.size_, b.data(), b.size_) == 0;
+    }
+
+    std::strong_ordering operator<=>(const bigint& a, const bigint& b) noexcept {
+        if (a.negative_ != b.negative_) {
+            return a.negative_ ? std::strong_ordering::less : std::strong_ordering::greater;
+        }
+        int c = compare(a.data(), a.size_, b.data(), b.size_);
+        if (a.negative_) {
+            c = -c;
+        }
+        return c < 0 ? std::strong_ordering::less : (c > 0 ? std::strong_ordering::greater : std::strong_ordering::equal);
+    }
+
+    // ---------------- 加减 ----------------
+
+    bigint bigint::operator-() const& {
+        bigint r(*this);
+        r.negative_ = !r.negative_ && r.size_ != 0;
+        return r;
+    }
+
+    bigint bigint::operator-() && {
+        negative_ = !negative_ && size_ != 0;
+        return std::move(*this);
+    }
+
+    // |this| += |other|：先 按 较长 的 长度 加，有 进位 时 才 多要 一个 limb，128 位 以内 不溢出 就 不上堆
+    void bigint::add_magnitude(const bigint& other) {
+        const std::size_t an = size_, bn = other.size_;
+        const std::size_t n = std::max(an, bn);
+        reserve(n);
+        limb* r = data();
+        std::fill(r + an, r + n, limb(0));
+        const unsigned char carry = add(r, r, n, other.data(), bn);
+        size_ = static_cast<std::uint32_t>(n);
+        if (carry) {
+            reserve(n + 1);
+            data()[n] = 1;
+            size_ = static_cast<std::uint32_t>(n + 1);
+        }
+    }
+
+    // this 与 other 符号 相同 时 的 this - other：|this| 较小 时 结果 变号
+    void bigint::sub_magnitude(const bigint& other) {
+        const std::size_t an = size_, bn = other.size_;
+        const int c = compare(data(), an, other.data(), bn);
+        if (c == 0) {
+            size_ = 0;
+            negative_ = false;
+            return;
+        }
+        if (c > 0) {
+            limb* r = data();
+            sub(r, r, an, other.data(), bn);
+        } else {
+            reserve(bn);
+            limb* r = data();
+            const limb* b = other.data();
+            std::fill(r + an, r + bn, limb(0));
+            // r = b - r，逐 limb 原地
+            unsigned char borrow = 0;
+            for (std::size_t i = 0; i < bn; ++i) borrow = sub_borrow(borrow, b[i], r[i], r + i);
+            size_ = static_cast<std::uint32_t>(bn);
+            negative_ = !negative_;
+        }
+        trim();
+    }
+
+    bigint& bigint::operator+=(const bigint& other) {
+        if (negative_ == other.negative_ || other.size_ == 0) {
+            add_magnitude(other);
+        } else {
+            sub_magnitude(other);
+        }
+        return *this;
+    }
+
+    bigint& bigint::operator-=(const bigint& other) {
+        if (other.size_ == 0) {
+            return *this;
+        }
+        if (negative_ != other.negative_) {
+            add_magnitude(other);
+        } else {
+            sub_magnitude(other);
+        }
+        return *this;
+    }
+
+    // ---------------- 乘除 ----------------
+
+    bigint operator*(const bigint& a, const bigint& b) {
+        bigint r;
+        const std::size_t an = a.size_, bn = b.size_;
+        if (an == 0 || bn == 0) {
+            return r;
+        }
+        const bool negative = a.negative_ != b.negative_;
+        if (an + bn <= 4) {
+            // 两边 都在 128 位 以内：积 先 放 栈上，结果 不超过 128 位 时 不上堆
+            limb product[4];
+            mul_basecase(product, a.data(), an, b.data(), bn);
+            r.assign(product, an + bn, negative);
+            return r;
+        }
+        r.reserve(an + bn);
+        multiply(r.data(), a.data(), an, b.data(), bn);
+        r.size_ = static_cast<std::uint32_t>(an + bn);
+        r.negative_ = negative;
+        r.trim();
+        return r;
+    }
+
+    bigint& bigint::operator*=(const bigint& other) {
+        return *this = *this * other;
+    }
+
+    void bigint::divmod(const bigint& a, const bigint& b, bigint& quotient, bigint& remainder) {
+        const std::size_t an = a.size_, bn = b.size_;
+        if (bn == 0) {
+            throw std::domain_error("e_math::bigint: division by zero");
+        }
+        const bool q_negative = a.negative_ != b.negative_;
+        const bool r_negative = a.negative_;
+        if (compare(a.data(), an, b.data(), bn) < 0) {
+            remainder = a;
+            quotient = bigint();
+            return;
+        }
+
+        // 商 与 余数 可能 就是 a 或 b，先 算到 局部 缓冲
+        limb small_q[2];
+        std::vector<limb> heap_q;
+        limb* q = small_q;
+        if (an - bn + 1 > 2) {
+            heap_q.resize(an - bn + 1);
+            q = heap_q.data();
+        }
+        if (bn == 1) {
+            const limb rem = divrem_1(q, a.data(), an, b.data()[0]);
+            quotient.assign(q, an, q_negative);
+            remainder.assign(&rem, 1, r_negative);
+            return;
+        }
+        std::vector<limb> rem(bn);
+        divrem(q, rem.data(), a.data(), an, b.data(), bn);
+        quotient.assign(q, an - bn + 1, q_negative);
+        remainder.assign(rem.data(), bn, r_negative);
+    }
+
+    bigint operator/(const bigint& a, const bigint& b) {
+        bigint q, r;
+        bigint::divmod(a, b, q, r);
+        return q;
+    }
+
+    bigint operator%(const bigint& a, const bigint& b) {
+        bigint q, r;
+        bigint::divmod(a, b, q, r);
+        return r;
+    }
+
+    bigint& bigint::operator/=(const bigint& other) {
+        bigint r;
+        divmod(*this, other, *this, r);
+        return *this;
+    }
+
+    bigint& bigint::operator%=(const bigint& other) {
+        bigint q;
+        divmod(*this, other, q, *this);
+        return *this;
+    }
+}
@@ -0,0 +1,316 @@
+#include "e_decimal.hpp"
+#include "e_lanes.hpp"
+#include "e_reduce.hpp"
+#include "e_simd.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace e_math {
+    namespace {
+        // ---------------- 标量：尾部 与 没有 SIMD 时 用 ----------------
+
+        // 同号 相加 结果 变号 即 溢出，各元素 的 判定 或 在一起，最后 看 符号位
+        template <class T>
+        bool add_scalar(const T* a, const T* b, T* out, std::size_t n) {
+            T bad = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                const T x = a[i], y = b[i];
+                const T r = detail::wrap_add(x, y);
+                bad |= (x ^ r) & (y ^ r);
+                out[i] = r;
+            }
+            return bad < 0;
+        }
+
+        // 与 decimal::operator* 相同：宽 整数 乘，再 除以 10^scale 就近 取偶
+        template <class T>
+        bool mul_scalar(const T* a, const T* b, T* out, std::size_t n, T one) {
+            using W = typename detail::decimal_wide<T>::type;
+            bool bad = false;
+            for (std::size_t i = 0; i < n; ++i) {
+                const W q = detail::div_round_even<W>(W(a[i]) * W(b[i]), W(one));
+                bad |= q < W(std::numeric_limits<T>::min()) || q > W(std::numeric_limits<T>::max());
+                out[i] = static_cast<T>(q);
+            }
+            return bad;
+        }
+
+        // 10^Scale 是 编译期 常数，除法 变成 乘法 与 移位；int64 的 乘积 多半 不超过 64 位，溢出 时 才 用 128 位
+        template <class T, int Scale>
+        bool mul_fixed(const T* a, const T* b, T* out, std::size_t n) {
+            using W = typename detail::decimal_wide<T>::type;
+            constexpr T one = detail::pow10<T>(Scale);
+            bool bad = false;
+            for (std::size_t i = 0; i < n; ++i) {
+                if constexpr (sizeof(T) == sizeof(std::int64_t)) {
+                    const auto p = mul(a[i], b[i], checked);
+                    if (!p.overflow) {
+                        out[i] = detail::div_round_even<T>(p.value, one);
+                        continue;
+                    }
+                }
+                const W q = detail::div_round_even<W>(W(a[i]) * W(b[i]), W(one));
+                bad |= q < W(std::numeric_limits<T>::min()) || q > W(std::numeric_limits<T>::max());
+                out[i] = static_cast<T>(q);
+            }
+            return bad;
+        }
+
+        template <class T, std::size_t... S>
+        constexpr auto make_mul_table(std::index_sequence<S...>) {
+            return std::array<bool (*)(const T*, const T*, T*, std::size_t), sizeof...(S)>{mul_fixed<T, static_cast<int>(S)>...};
+        }
+
+        // 下标 为 scale
+        template <class T>
+        constexpr auto mul_table = make_mul_table<T>(std::make_index_sequence<std::numeric_limits<T>::digits10 + 1>{});
+
+        bool mul_i32_base(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t n, int scale) {
+            return mul_table<std::int32_t>[static_cast<std::size_t>(scale)](a, b, out, n);
+        }
+
+        // 128 位 和 拆成 低 64 位（回绕 后 的 s）与 溢出 次数 c：真实值 = s + c * 2^64，c == 0 时 才 在 int64 范围 内
+        E_MATH_ALWAYS_INLINE void sum_step(std::int64_t& s, std::int64_t& c, std::int64_t x) {
+            const std::int64_t r = detail::wrap_add(s, x);
+            if (((s ^ r) & (x ^ r)) < 0) {
+                c += x < 0 ? -1 : 1;
+            }
+            s = r;
+        }
+
+#if E_MATH_HAS_NATIVE_VEC
+        // ---------------- 向量：只写一次，各指令集 的 包装函数 按 Bytes 展开 ----------------
+
+        template <std::size_t Bytes, class T>
+        E_MATH_ALWAYS_INLINE bool add_vec(const T* a, const T* b, T* out, std::size_t n) {
+            using V = detail::vec<T, Bytes>;
+            using UV = detail::vec<std::make_unsigned_t<T>, Bytes>;
+            constexpr std::size_t w = detail::vec_size<T, Bytes>;
+            V bad{};
+            std::size_t i = 0;
+            for (; i + w <= n; i += w) {
+                V x, y;
+                std::memcpy(&x, a + i, sizeof(V));
+                std::memcpy(&y, b + i, sizeof(V));
+                const V r = (V)((UV)x + (UV)y);
+                bad |= (x ^ r) & (y ^ r);
+                std::memcpy(out + i, &r, sizeof(V));
+            }
+            bool any = add_scalar(a + i, b + i, out + i, n - i);
+            for (std::size_t k = 0; k < w; ++k) any |= bad[k] < 0;
+            return any;
+        }
+
+        // 每一路 各自 记 溢出 次数，最后 按 同样的 规则 合并
+        template <std::size_t Bytes>
+        E_MATH_ALWAYS_INLINE bool sum_i64_vec(const std::int64_t* p, std::size_t n, std::int64_t& out) {
+            using V = detail::vec<std::int64_t, Bytes>;
+            using UV = detail::vec<std::uint64_t, Bytes>;
+            constexpr std::size_t w = detail::vec_size<std::int64_t, Bytes>;
+            V s{}, c{};
+            std::size_t i = 0;
+            for (; i + w <= n; i += w) {
+                V x;
+                std::memcpy(&x, p + i, sizeof(V));
+                const V r = (V)((UV)s + (UV)x);
+                const V overflow = ((s ^ r) & (x ^ r)) < 0;
+                // x < 0 时 -1，否则 1
+                c += overflow & ((x < 0) | 1);
+                s = r;
+            }
+            std::int64_t total = 0, carry = 0;
+            for (std::size_t k = 0; k < w; ++k) {
+                sum_step(total, carry, s[k]);
+                carry += c[k];
+            }
+            for (; i < n; ++i) sum_step(total, carry, p[i]);
+            out = total;
+            return carry != 0;
+        }
+#else
+        bool sum_i64_scalar(const std::int64_t* p, std::size_t n, std::int64_t& out) {
+            std::int64_t s = 0, c = 0;
+            for (std::size_t i = 0; i < n; ++i) sum_step(s, c, p[i]);
+            out = s;
+            return c != 0;
+        }
+#endif
+
+#if E_MATH_X86
+        // ---------------- int32 乘法：在 double 里 算 ----------------
+        // x * y 的 舍入值 p 与 误差 e = fma(x, y, -p) 合起来 正好 是 乘积；q = floor(p / one) 的 估计 误差 很小，
+        // 余数 p - q * one + e 是 不大的 整数，fma 算 出来 是 精确的，再 修正 两次 得到 向下取整 的 商 与 [0, one) 的 余数
+        // 结果 在 int32 范围 内 时 所有 中间值 都 是 精确的 整数，与 标量 逐位 相同；超出 时 只 报告 溢出
+
+        E_MATH_TARGET_AVX2 bool mul_i32_avx2(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t n, int scale) {
+            const std::int32_t one = detail::pow10<std::int32_t>(scale);
+            const __m256d vone = _mm256_set1_pd(one);
+            const __m256d inv = _mm256_set1_pd(1.0 / one);
+            const __m256d unit = _mm256_set1_pd(1.0);
+            const __m256d half = _mm256_set1_pd(0.5);
+            const __m256d lo = _mm256_set1_pd(-2147483648.0);
+            const __m256d hi = _mm256_set1_pd(2147483647.0);
+            const __m256d zero = _mm256_setzero_pd();
+            __m256d bad = zero;
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                const __m256d x = _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+                const __m256d y = _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+                const __m256d p = _mm256_mul_pd(x, y);
+                const __m256d e = _mm256_fmsub_pd(x, y, p);
+                __m256d q = _mm256_floor_pd(_mm256_mul_pd(p, inv));
+                __m256d r = _mm256_add_pd(_mm256_fnmadd_pd(q, vone, p), e);
+                const __m256d k = _mm256_floor_pd(_mm256_mul_pd(r, inv));
+                q = _mm256_add_pd(q, k);
+                r = _mm256_fnmadd_pd(k, vone, r);
+                // r 此时 在 [-one, 2 one) 内
+                const __m256d neg = _mm256_cmp_pd(r, zero, _CMP_LT_OQ);
+                q = _mm256_sub_pd(q, _mm256_and_pd(neg, unit));
+                r = _mm256_add_pd(r, _mm256_and_pd(neg, vone));
+                const __m256d big = _mm256_cmp_pd(r, vone, _CMP_GE_OQ);
+                q = _mm256_add_pd(q, _mm256_and_pd(big, unit));
+                r = _mm256_sub_pd(r, _mm256_and_pd(big, vone));
+                // 就近 取偶
+                const __m256d twice = _mm256_add_pd(r, r);
+                const __m256d halved = _mm256_mul_pd(q, half);
+                const __m256d odd = _mm256_cmp_pd(_mm256_floor_pd(halved), halved, _CMP_NEQ_OQ);
+                const __m256d up = _mm256_or_pd(_mm256_cmp_pd(twice, vone, _CMP_GT_OQ), _mm256_and_pd(_mm256_cmp_pd(twice, vone, _CMP_EQ_OQ), odd));
+                q = _mm256_add_pd(q, _mm256_and_pd(up, unit));
+                bad = _mm256_or_pd(bad, _mm256_or_pd(_mm256_cmp_pd(q, lo, _CMP_LT_OQ), _mm256_cmp_pd(q, hi, _CMP_GT_OQ)));
+                q = _mm256_min_pd(_mm256_max_pd(q, lo), hi);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm256_cvttpd_epi32(q));
+            }
+            const bool tail = mul_scalar(a + i, b + i, out + i, n - i, one);
+            return tail || _mm256_movemask_pd(bad) != 0;
+        }
+
+// GCC 12 的 _mm512_cvtepi32_pd 内部 用 _mm512_undefined_pd，会报 -Wmaybe-uninitialized 误报
+    #if defined(__GNUC__) && !defined(__clang__)
+        #pragma GCC diagnostic push
+        #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    #endif
+        E_MATH_TARGET_AVX512 bool mul_i32_avx512(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t n, int scale) {
+            const std::int32_t one = detail::pow10<std::int32_t>(scale);
+            const __m512d vone = _mm512_set1_pd(one);
+            const __m512d inv = _mm512_set1_pd(1.0 / one);
+            const __m512d unit = _mm512_set1_pd(1.0);
+            const __m512d half = _mm512_set1_pd(0.5);
+            const __m512d lo = _mm512_set1_pd(-2147483648.0);
+            const __m512d hi = _mm512_set1_pd(2147483647.0);
+            const __m512d zero = _mm512_setzero_pd();
+            constexpr int floor_mode = _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC;
+            __mmask8 bad = 0;
+            for (std::size_t i = 0; i < n; i += 8) {
+                // 尾部 用 掩码 读写，不足 8 个 的 路 读到 0，结果 不写回
+                const __mmask8 m = n - i >= 8 ? __mmask8(0xff) : static_cast<__mmask8>((1u << (n - i)) - 1);
+                const __m512d x = _mm512_cvtepi32_pd(_mm256_maskz_loadu_epi32(m, a + i));
+                const __m512d y = _mm512_cvtepi32_pd(_mm256_maskz_loadu_epi32(m, b + i));
+                const __m512d p = _mm512_mul_pd(x, y);
+                const __m512d e = _mm512_fmsub_pd(x, y, p);
+                __m512d q = _mm512_roundscale_pd(_mm512_mul_pd(p, inv), floor_mode);
+                __m512d r = _mm512_add_pd(_mm512_fnmadd_pd(q, vone, p), e);
+                const __m512d k = _mm512_roundscale_pd(_mm512_mul_pd(r, inv), floor_mode);
+                q = _mm512_add_pd(q, k);
+                r = _mm512_fnmadd_pd(k, vone, r);
+                const __mmask8 neg = _mm512_cmp_pd_mask(r, zero, _CMP_LT_OQ);
+                q = _mm512_mask_sub_pd(q, neg, q, unit);
+                r = _mm512_mask_add_pd(r, neg, r, vone);
+                const __mmask8 big = _mm512_cmp_pd_mask(r, vone, _CMP_GE_OQ);
+                q = _mm512_mask_add_pd(q, big, q, unit);
+                r = _mm512_mask_sub_pd(r, big, r, vone);
+                const __m512d twice = _mm512_add_pd(r, r);
+                const __m512d halved = _mm512_mul_pd(q, half);
+                const __mmask8 odd = _mm512_cmp_pd_mask(_mm512_roundscale_pd(halved, floor_mode), halved, _CMP_NEQ_OQ);
+                const __mmask8 up = _mm512_cmp_pd_mask(twice, vone, _CMP_GT_OQ) | (_mm512_cmp_pd_mask(twice, vone, _CMP_EQ_OQ) & odd);
+                q = _mm512_mask_add_pd(q, up, q, unit);
+                bad |= _mm512_cmp_pd_mask(q, lo, _CMP_LT_OQ) | _mm512_cmp_pd_mask(q, hi, _CMP_GT_OQ);
+                q = _mm512_min_pd(_mm512_max_pd(q, lo), hi);
+                _mm256_mask_storeu_epi32(out + i, m, _mm512_cvttpd_epi32(q));
+            }
+            return bad != 0;
+        }
+    #if defined(__GNUC__) && !defined(__clang__)
+        #pragma GCC diagnostic pop
+    #endif
+#endif
+
+        // ---------------- 各指令集 的 实例 ----------------
+
+        struct decimal_kernels {
+            bool (*add_i32)(const std::int32_t*, const std::int32_t*, std::int32_t*, std::size_t);
+            bool (*add_i64)(const std::int64_t*, const std::int64_t*, std::int64_t*, std::size_t);
+            bool (*mul_i32)(const std::int32_t*, const std::int32_t*, std::int32_t*, std::size_t, int);
+            bool (*sum_i64)(const std::int64_t*, std::size_t, std::int64_t&);
+        };
+
+#if E_MATH_HAS_NATIVE_VEC
+    #define E_MATH_DECIMAL_KERNELS(isa, target, B, mul_i32)                                                                   \
+        target bool add_i32_##isa(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t n) {            \
+            return add_vec<B>(a, b, out, n);                                                                                  \
+        }                                                                                                                     \
+        target bool add_i64_##isa(const std::int64_t* a, const std::int64_t* b, std::int64_t* out, std::size_t n) {            \
+            return add_vec<B>(a, b, out, n);                                                                                  \
+        }                                                                                                                     \
+        target bool sum_i64_##isa(const std::int64_t* p, std::size_t n, std::int64_t& out) { return sum_i64_vec<B>(p, n, out); } \
+        constexpr decimal_kernels decimal_kernels_##isa = {add_i32_##isa, add_i64_##isa, mul_i32, sum_i64_##isa};
+
+        // 基础指令集 没有 floor 与 fma，乘法 走 标量
+        E_MATH_DECIMAL_KERNELS(base, , detail::base_vec_bytes, mul_i32_base)
+    #if E_MATH_X86
+        E_MATH_DECIMAL_KERNELS(avx2, E_MATH_TARGET_AVX2, 32, mul_i32_avx2)
+        E_MATH_DECIMAL_KERNELS(avx512, E_MATH_TARGET_AVX512, 64, mul_i32_avx512)
+    #endif
+
+    #undef E_MATH_DECIMAL_KERNELS
+#else
+        constexpr decimal_kernels decimal_kernels_base = {add_scalar<std::int32_t>, add_scalar<std::int64_t>, mul_i32_base, sum_i64_scalar};
+#endif
+
+        const decimal_kernels& select_decimal_kernels() {
+#if E_MATH_HAS_NATIVE_VEC && E_MATH_X86
+            switch (detail::cpu_simd_level()) {
+                case detail::simd_level::avx512: return decimal_kernels_avx512;
+                case detail::simd_level::avx2: return decimal_kernels_avx2;
+                default: break;
+            }
+#endif
+            return decimal_kernels_base;
+        }
+
+        const decimal_kernels& g_decimal = select_decimal_kernels();
+    }
+
+    namespace detail {
+        bool decimal_add(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t n) {
+            return g_decimal.add_i32(a, b, out, n);
+        }
+
+        bool decimal_add(const std::int64_t* a, const std::int64_t* b, std::int64_t* out, std::size_t n) {
+            return g_decimal.add_i64(a, b, out, n);
+        }
+
+        bool decimal_mul(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t n, int scale) {
+            return g_decimal.mul_i32(a, b, out, n, scale);
+        }
+
+        // 128 位 乘除 没有 对应的 SIMD 指令，逐个 算
+        bool decimal_mul(const std::int64_t* a, const std::int64_t* b, std::int64_t* out, std::size_t n, int scale) {
+            return mul_table<std::int64_t>[static_cast<std::size_t>(scale)](a, b, out, n);
+        }
+
+        // int32 的 和 用 int64 累加，长度 小于 2^32 时 不会 溢出
+        bool decimal_sum(const std::int32_t* p, std::size_t n, std::int64_t& out) {
+            out = reduce_sum(std::span<const std::int32_t>(p, n));
+            return false;
+        }
+
+        bool decimal_sum(const std::int64_t* p, std::size_t n, std::int64_t& out) {
+            return g_decimal.sum_i64(p, n, out);
+        }
+    }
+}
@@ -0,0 +1,183 @@
+#include "e_expr.hpp"
+#include "e_lanes.hpp"
+#include "e_math.hpp"
+#include "e_pool.hpp"
+#include "e_simd.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+namespace e_math {
+    namespace {
+        // 整数 加减乘 在 无符号 里 算，按 补码 回绕
+        template <class T, bool = std::is_integral_v<T>>
+        struct wrap_type {
+            using type = T;
+        };
+
+        template <class T>
+        struct wrap_type<T, true> {
+            using type = std::make_unsigned_t<T>;
+        };
+
+        template <class T>
+        using wrap_t = typename wrap_type<T>::type;
+
+        // apply 同时 用于 原生向量 与 标量；wraps 为 true 的 运算 整数 走 无符号
+        struct op_add {
+            static constexpr bool wraps = true;
+            template <class X>
+            E_MATH_ALWAYS_INLINE static X apply(X a, X b) { return a + b; }
+        };
+
+        struct op_sub {
+            static constexpr bool wraps = true;
+            template <class X>
+            E_MATH_ALWAYS_INLINE static X apply(X a, X b) { return a - b; }
+        };
+
+        struct op_rsub {
+            static constexpr bool wraps = true;
+            template <class X>
+            E_MATH_ALWAYS_INLINE static X apply(X a, X b) { return b - a; }
+        };
+
+        struct op_mul {
+            static constexpr bool wraps = true;
+            template <class X>
+            E_MATH_ALWAYS_INLINE static X apply(X a, X b) { return a * b; }
+        };
+
+        // 与 std::min / std::max 相同：相等 或 有 NaN 时 取 a
+        struct op_min {
+            static constexpr bool wraps = false;
+            template <class X>
+            E_MATH_ALWAYS_INLINE static X apply(X a, X b) { return b < a ? b : a; }
+        };
+
+        struct op_max {
+            static constexpr bool wraps = false;
+            template <class X>
+            E_MATH_ALWAYS_INLINE static X apply(X a, X b) { return a < b ? b : a; }
+        };
+
+        template <class Op, class T>
+        using compute_t = std::conditional_t<Op::wraps, wrap_t<T>, T>;
+
+        // ---------------- 块 内核：只写一次，各指令集 的 包装函数 按 Bytes 展开 ----------------
+        // 先 读 后 写，out 是 a 或 b 时 也对
+
+        template <std::size_t Bytes, class Op, class T>
+        E_MATH_ALWAYS_INLINE void binary_block(const T* a, const T* b, T* out, std::size_t n) {
+            using C = compute_t<Op, T>;
+            std::size_t i = 0;
+#if E_MATH_HAS_NATIVE_VEC
+            using V = detail::vec<C, Bytes>;
+            constexpr std::size_t w = detail::vec_size<C, Bytes>;
+            for (; i + w <= n; i += w) {
+                V x, y;
+                std::memcpy(&x, a + i, sizeof(V));
+                std::memcpy(&y, b + i, sizeof(V));
+                const V r = Op::apply(x, y);
+                std::memcpy(out + i, &r, sizeof(V));
+            }
+#endif
+            for (; i < n; ++i) out[i] = static_cast<T>(Op::apply(static_cast<C>(a[i]), static_cast<C>(b[i])));
+        }
+
+        template <std::size_t Bytes, class Op, class T>
+        E_MATH_ALWAYS_INLINE void scalar_block(const T* a, T s, T* out, std::size_t n) {
+            using C = compute_t<Op, T>;
+            const C c = static_cast<C>(s);
+            std::size_t i = 0;
+#if E_MATH_HAS_NATIVE_VEC
+            using V = detail::vec<C, Bytes>;
+            constexpr std::size_t w = detail::vec_size<C, Bytes>;
+            const V y = V{} + c;
+            for (; i + w <= n; i += w) {
+                V x;
+                std::memcpy(&x, a + i, sizeof(V));
+                const V r = Op::apply(x, y);
+                std::memcpy(out + i, &r, sizeof(V));
+            }
+#endif
+            for (; i < n; ++i) out[i] = static_cast<T>(Op::apply(static_cast<C>(a[i]), c));
+        }
+
+        // 加法 直接 用 e_math::add 的 批量 内核（它 自己 按 CPU 选 指令集）
+        template <class T>
+        void add_batch(const T* a, const T* b, T* out, std::size_t n) {
+            add(std::span<const T>(a, n), std::span<const T>(b, n), std::span<T>(out, n));
+        }
+
+    #define E_MATH_EXPR_KERNELS(isa, target, B)                                                                                \
+        template <class Op, class T>                                                                                          \
+        target void binary_##isa(const T* a, const T* b, T* out, std::size_t n) {                                             \
+            binary_block<B, Op>(a, b, out, n);                                                                                \
+        }                                                                                                                     \
+        template <class Op, class T>                                                                                          \
+        target void scalar_##isa(const T* a, T s, T* out, std::size_t n) {                                                    \
+            scalar_block<B, Op>(a, s, out, n);                                                                                \
+        }                                                                                                                     \
+        template <class T>                                                                                                    \
+        constexpr detail::expr_kernel_table<T> expr_kernels_##isa = {                                                         \
+            {add_batch<T>, binary_##isa<op_sub, T>, binary_##isa<op_mul, T>, binary_##isa<op_min, T>, binary_##isa<op_max, T>}, \
+            {scalar_##isa<op_add, T>, scalar_##isa<op_sub, T>, scalar_##isa<op_rsub, T>, scalar_##isa<op_mul, T>,             \
+             scalar_##isa<op_min, T>, scalar_##isa<op_max, T>},                                                               \
+        };
+
+        E_MATH_EXPR_KERNELS(base, , detail::base_vec_bytes)
+#if E_MATH_HAS_NATIVE_VEC && E_MATH_X86
+        E_MATH_EXPR_KERNELS(avx2, E_MATH_TARGET_AVX2, 32)
+        E_MATH_EXPR_KERNELS(avx512, E_MATH_TARGET_AVX512, 64)
+#endif
+
+    #undef E_MATH_EXPR_KERNELS
+
+        template <class T>
+        const detail::expr_kernel_table<T>& select_expr_kernels() {
+#if E_MATH_HAS_NATIVE_VEC && E_MATH_X86
+            switch (detail::cpu_simd_level()) {
+                case detail::simd_level::avx512: return expr_kernels_avx512<T>;
+                case detail::simd_level::avx2: return expr_kernels_avx2<T>;
+                default: break;
+            }
+#endif
+            return expr_kernels_base<T>;
+        }
+
+        const detail::expr_kernel_table<std::int32_t>& g_expr_i32 = select_expr_kernels<std::int32_t>();
+        const detail::expr_kernel_table<std::int64_t>& g_expr_i64 = select_expr_kernels<std::int64_t>();
+        const detail::expr_kernel_table<float>& g_expr_f32 = select_expr_kernels<float>();
+        const detail::expr_kernel_table<double>& g_expr_f64 = select_expr_kernels<double>();
+    }
+
+    namespace detail {
+        template <>
+        const expr_kernel_table<std::int32_t>& expr_kernels<std::int32_t>() {
+            return g_expr_i32;
+        }
+
+        template <>
+        const expr_kernel_table<std::int64_t>& expr_kernels<std::int64_t>() {
+            return g_expr_i64;
+        }
+
+        template <>
+        const expr_kernel_table<float>& expr_kernels<float>() {
+            return g_expr_f32;
+        }
+
+        template <>
+        const expr_kernel_table<double>& expr_kernels<double>() {
+            return g_expr_f64;
+        }
+
+        void expr_parallel_for(std::size_t tasks, void (*fn)(const void* ctx, std::size_t t), const void* ctx) {
+            parallel_for(tasks, [&](std::size_t t) { fn(ctx, t); });
+        }
+    }
+}
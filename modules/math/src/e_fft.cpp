@@ -0,0 +1,743 @@
+#include "e_fft.hpp"
+#include "e_lanes.hpp"
+#include "e_parallel.hpp"
+#include "e_pool.hpp"
+#include "e_simd.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <numbers>
+#include <stdexcept>
+#include <utility>
+
+namespace e_math {
+    namespace {
+        // 批量 变换 时 每个 线程 至少 分到 这么多个 复数
+        constexpr std::size_t parallel_points_per_task = std::size_t(1) << 15;
+
+        // 每个 线程 的 工作区：0 给 复数 FFT 的 来回 倒，1 给 实数 FFT 的 拆分；只增不减
+        template <class T>
+        std::complex<T>* scratch(std::size_t slot, std::size_t n) {
+            thread_local std::vector<std::complex<T>> buffers[2];
+            auto& b = buffers[slot];
+            if (b.size() < n) {
+                b.resize(n);
+            }
+            return b.data();
+        }
+
+        // exp(-2 pi i k / n)，用 long double 算，k 先 对 n 取模
+        template <class T>
+        std::complex<T> root(std::size_t k, std::size_t n) {
+            const long double a = -2.0L * std::numbers::pi_v<long double> * static_cast<long double>(k % n) / static_cast<long double>(n);
+            return {static_cast<T>(std::cos(a)), static_cast<T>(std::sin(a))};
+        }
+
+        // ---------------- 复数 运算：标量 与 向量 两套，蝶形 只写一次 ----------------
+
+        template <class T>
+        struct scalar_complex {
+            T re, im;
+        };
+
+        template <class T>
+        E_MATH_ALWAYS_INLINE scalar_complex<T> operator+(scalar_complex<T> a, scalar_complex<T> b) {
+            return {a.re + b.re, a.im + b.im};
+        }
+
+        template <class T>
+        E_MATH_ALWAYS_INLINE scalar_complex<T> operator-(scalar_complex<T> a, scalar_complex<T> b) {
+            return {a.re - b.re, a.im - b.im};
+        }
+
+        template <class T>
+        E_MATH_ALWAYS_INLINE scalar_complex<T> operator*(scalar_complex<T> a, T s) {
+            return {a.re * s, a.im * s};
+        }
+
+        template <class T>
+        struct scalar_ops {
+            using real = T;
+            using C = scalar_complex<T>;
+            static constexpr std::size_t width = 1;
+
+            static E_MATH_ALWAYS_INLINE C load(const std::complex<T>* p) { return {p->real(), p->imag()}; }
+            static E_MATH_ALWAYS_INLINE void store(std::complex<T>* p, C a) { *p = {a.re, a.im}; }
+            static E_MATH_ALWAYS_INLINE C splat(std::complex<T> w) { return {w.real(), w.imag()}; }
+            static E_MATH_ALWAYS_INLINE C mul(C a, C b) { return {a.re * b.re - a.im * b.im, a.re * b.im + a.im * b.re}; }
+            // a * conj(b)
+            static E_MATH_ALWAYS_INLINE C mul_conj(C a, C b) { return {a.re * b.re + a.im * b.im, a.im * b.re - a.re * b.im}; }
+            // 乘 -i，Inv 时 乘 +i
+            template <bool Inv>
+            static E_MATH_ALWAYS_INLINE C rot(C a) {
+                return Inv ? C{-a.im, a.re} : C{a.im, -a.re};
+            }
+        };
+
+#if E_MATH_HAS_NATIVE_VEC
+        template <class V, std::size_t... I>
+        E_MATH_ALWAYS_INLINE V swap_pairs(V v, std::index_sequence<I...>) {
+            return __builtin_shufflevector(v, v, (I ^ 1)...);
+        }
+
+        template <class V, std::size_t... I>
+        E_MATH_ALWAYS_INLINE V dup_real(V v, std::index_sequence<I...>) {
+            return __builtin_shufflevector(v, v, (I & ~std::size_t(1))...);
+        }
+
+        template <class V, std::size_t... I>
+        E_MATH_ALWAYS_INLINE V dup_imag(V v, std::index_sequence<I...>) {
+            return __builtin_shufflevector(v, v, (I | 1)...);
+        }
+
+        // 一个 原生向量 放 width 个 交错存放 的 复数：re0 im0 re1 im1 ...
+        template <class T, std::size_t Bytes>
+        struct vector_ops {
+            using real = T;
+            using C = detail::vec<T, Bytes>;
+            static constexpr std::size_t size = detail::vec_size<T, Bytes>;
+            static constexpr std::size_t width = size / 2;
+            using index = std::make_index_sequence<size>;
+
+            static E_MATH_ALWAYS_INLINE C load(const std::complex<T>* p) {
+                C v;
+                std::memcpy(&v, p, sizeof(v));
+                return v;
+            }
+
+            static E_MATH_ALWAYS_INLINE void store(std::complex<T>* p, C v) { std::memcpy(static_cast<void*>(p), &v, sizeof(v)); }
+
+            static E_MATH_ALWAYS_INLINE C splat(std::complex<T> w) {
+                C v;
+                for (std::size_t i = 0; i < width; ++i) {
+                    v[2 * i] = w.real();
+                    v[2 * i + 1] = w.imag();
+                }
+                return v;
+            }
+
+            // 偶数位 s，奇数位 -s
+            static E_MATH_ALWAYS_INLINE C alternate(T s) {
+                C v;
+                for (std::size_t i = 0; i < size; ++i) v[i] = i % 2 == 0 ? s : -s;
+                return v;
+            }
+
+            static E_MATH_ALWAYS_INLINE C mul(C a, C b) {
+                return a * dup_real(b, index{}) + swap_pairs(a, index{}) * dup_imag(b, index{}) * alternate(T(-1));
+            }
+
+            static E_MATH_ALWAYS_INLINE C mul_conj(C a, C b) {
+                return a * dup_real(b, index{}) + swap_pairs(a, index{}) * dup_imag(b, index{}) * alternate(T(1));
+            }
+
+            template <bool Inv>
+            static E_MATH_ALWAYS_INLINE C rot(C a) {
+                return swap_pairs(a, index{}) * alternate(Inv ? T(-1) : T(1));
+            }
+        };
+#endif
+
+        template <class O, bool Inv>
+        E_MATH_ALWAYS_INLINE typename O::C twiddle(typename O::C a, typename O::C w) {
+            return Inv ? O::mul_conj(a, w) : O::mul(a, w);
+        }
+
+        // ---------------- 蝶形：a[k] <- sum a[r] * exp(-2 pi i r k / P)，Inv 时 指数 取 + ----------------
+
+        template <class O, bool Inv, std::size_t P>
+        E_MATH_ALWAYS_INLINE void butterfly(typename O::C (&a)[P]) {
+            using C = typename O::C;
+            using T = typename O::real;
+            if constexpr (P == 2) {
+                const C t = a[0] - a[1];
+                a[0] = a[0] + a[1];
+                a[1] = t;
+            } else if constexpr (P == 3) {
+                constexpr T s = T(0.866025403784438646763723170752936183);
+                const C t1 = a[1] + a[2];
+                const C t2 = O::template rot<Inv>(a[1] - a[2]) * s;
+                const C m = a[0] - t1 * T(0.5);
+                a[0] = a[0] + t1;
+                a[1] = m + t2;
+                a[2] = m - t2;
+            } else if constexpr (P == 4) {
+                const C t0 = a[0] + a[2];
+                const C t1 = a[0] - a[2];
+                const C t2 = a[1] + a[3];
+                const C t3 = O::template rot<Inv>(a[1] - a[3]);
+                a[0] = t0 + t2;
+                a[1] = t1 + t3;
+                a[2] = t0 - t2;
+                a[3] = t1 - t3;
+            } else {
+                static_assert(P == 5);
+                constexpr T c1 = T(0.309016994374947424102293417182819059);  // cos(2 pi / 5)
+                constexpr T c2 = T(-0.809016994374947424102293417182819059); // cos(4 pi / 5)
+                constexpr T s1 = T(0.951056516295153572116439333379382143);  // sin(2 pi / 5)
+                constexpr T s2 = T(0.587785252292473129168705954639072769);  // sin(4 pi / 5)
+                const C t1 = a[1] + a[4];
+                const C t2 = a[2] + a[3];
+                const C t3 = a[1] - a[4];
+                const C t4 = a[2] - a[3];
+                const C m1 = a[0] + t1 * c1 + t2 * c2;
+                const C m2 = a[0] + t1 * c2 + t2 * c1;
+                const C n1 = O::template rot<Inv>(t3 * s1 + t4 * s2);
+                const C n2 = O::template rot<Inv>(t3 * s2 - t4 * s1);
+                a[0] = a[0] + t1 + t2;
+                a[1] = m1 + n1;
+                a[2] = m2 + n2;
+                a[3] = m2 - n2;
+                a[4] = m1 - n1;
+            }
+        }
+
+        // ---------------- 一级 Stockham ----------------
+        // 对 j < m、q < s：取 x[q + s * (j + r * m)]（r < p）做 p 点 蝶形，
+        // 第 k 个 输出 乘 tw[j * (p - 1) + k - 1] 后 写到 y[q + s * (p * j + k)]
+
+        template <class T>
+        struct stage_args {
+            const std::complex<T>* x;
+            std::complex<T>* y;
+            std::size_t p, m, s;
+            const std::complex<T>* tw;
+            const std::complex<T>* roots; // 通用 基：roots[e] = exp(-2 pi i e / p)
+            const std::complex<T>* wide;  // 小跨度 级 按 向量 展开 的 旋转因子，没有 时 为 nullptr
+        };
+
+        // q 方向 连续，按 O::width 个 复数 一组，q1 - q0 是 O::width 的 倍数
+        template <class O, bool Inv, std::size_t P, class T>
+        E_MATH_ALWAYS_INLINE void stage_fixed(const stage_args<T>& a, std::size_t j0, std::size_t j1, std::size_t q0, std::size_t q1) {
+            using C = typename O::C;
+            // 字段 先 拷到 局部变量：写 y 用 memcpy，编译器 否则 要 每次 重新 读 a
+            const std::complex<T>* const x = a.x;
+            std::complex<T>* const y = a.y;
+            const std::complex<T>* const tw = a.tw;
+            const std::size_t s = a.s, sm = a.s * a.m;
+            for (std::size_t j = j0; j < j1; ++j) {
+                C w[P - 1];
+                E_MATH_UNROLL
+                for (std::size_t k = 1; k < P; ++k) w[k - 1] = O::splat(tw[j * (P - 1) + k - 1]);
+                const std::complex<T>* xj = x + s * j;
+                std::complex<T>* yj = y + s * P * j;
+                for (std::size_t q = q0; q < q1; q += O::width) {
+                    C v[P];
+                    E_MATH_UNROLL
+                    for (std::size_t r = 0; r < P; ++r) v[r] = O::load(xj + q + sm * r);
+                    butterfly<O, Inv, P>(v);
+                    O::store(yj + q, v[0]);
+                    E_MATH_UNROLL
+                    for (std::size_t k = 1; k < P; ++k) O::store(yj + q + s * k, twiddle<O, Inv>(v[k], w[k - 1]));
+                }
+            }
+        }
+
+        // 跨度 S 小于 向量宽度 W 且 整除 W：一个 向量 装 W / S 个 相邻 j 的 全部 q，读 仍然 连续
+        // 旋转因子 每一路 不同，用 展开表：第 j / (W / S) 块、第 k 个 输出 占 W 个 连续 复数
+        // 写 要 按 j 拆开：先 放进 小数组，再 按 S 个 复数 一段 搬过去
+        template <class O, bool Inv, std::size_t P, std::size_t S, class T>
+        E_MATH_ALWAYS_INLINE void stage_small(const stage_args<T>& a, std::size_t j1) {
+            using C = typename O::C;
+            constexpr std::size_t W = O::width;
+            constexpr std::size_t G = W / S;
+            const std::complex<T>* const x = a.x;
+            std::complex<T>* const y = a.y;
+            const std::size_t m = a.m;
+            const std::complex<T>* w = a.wide;
+            for (std::size_t j = 0; j < j1; j += G, w += (P - 1) * W) {
+                C v[P];
+                E_MATH_UNROLL
+                for (std::size_t r = 0; r < P; ++r) v[r] = O::load(x + S * (j + r * m));
+                butterfly<O, Inv, P>(v);
+                std::complex<T> buf[P][W];
+                O::store(buf[0], v[0]);
+                E_MATH_UNROLL
+                for (std::size_t k = 1; k < P; ++k) O::store(buf[k], twiddle<O, Inv>(v[k], O::load(w + (k - 1) * W)));
+                std::complex<T>* yj = y + S * P * j;
+                E_MATH_UNROLL
+                for (std::size_t g = 0; g < G; ++g) {
+                    E_MATH_UNROLL
+                    for (std::size_t k = 0; k < P; ++k) {
+                        E_MATH_UNROLL
+                        for (std::size_t q = 0; q < S; ++q) yj[S * (P * g + k) + q] = buf[k][S * g + q];
+                    }
+                }
+            }
+        }
+
+        // 其余 素数 基：直接 按定义 算 p 点 DFT
+        template <class O, bool Inv, class T>
+        E_MATH_ALWAYS_INLINE void stage_generic(const stage_args<T>& a, std::size_t q0, std::size_t q1) {
+            using C = typename O::C;
+            const std::size_t p = a.p, s = a.s;
+            for (std::size_t j = 0; j < a.m; ++j) {
+                const std::complex<T>* xj = a.x + s * j;
+                std::complex<T>* yj = a.y + s * p * j;
+                for (std::size_t q = q0; q < q1; q += O::width) {
+                    for (std::size_t k = 0; k < p; ++k) {
+                        C acc = O::load(xj + q);
+                        std::size_t e = 0;
+                        for (std::size_t r = 1; r < p; ++r) {
+                            e += k;
+                            if (e >= p) {
+                                e -= p;
+                            }
+                            acc = acc + twiddle<O, Inv>(O::load(xj + q + s * a.m * r), O::splat(a.roots[e]));
+                        }
+                        if (k > 0) {
+                            acc = twiddle<O, Inv>(acc, O::splat(a.tw[j * (p - 1) + k - 1]));
+                        }
+                        O::store(yj + q + s * k, acc);
+                    }
+                }
+            }
+        }
+
+        template <class V, bool Inv, std::size_t P, class T>
+        E_MATH_ALWAYS_INLINE void stage_radix(const stage_args<T>& a) {
+            constexpr std::size_t W = V::width;
+            const std::size_t s = a.s;
+            if (s >= W) {
+                // 跨度 里 能 整组 放进 向量 的 部分 用 V，剩下的 用 标量
+                const std::size_t vec_end = s - s % W;
+                stage_fixed<V, Inv, P>(a, 0, a.m, 0, vec_end);
+                if (vec_end < s) {
+                    stage_fixed<scalar_ops<T>, Inv, P>(a, 0, a.m, vec_end, s);
+                }
+                return;
+            }
+            std::size_t j_end = 0;
+            if constexpr (W > 1) {
+                if (a.wide != nullptr) {
+                    j_end = a.m - a.m % (W / s);
+                    switch (s) {
+                        case 1: stage_small<V, Inv, P, 1>(a, j_end); break;
+                        case 2: if constexpr (W > 2) stage_small<V, Inv, P, 2>(a, j_end); break;
+                        case 4: if constexpr (W > 4) stage_small<V, Inv, P, 4>(a, j_end); break;
+                        default: j_end = 0; break;
+                    }
+                }
+            }
+            stage_fixed<scalar_ops<T>, Inv, P>(a, j_end, a.m, 0, s);
+        }
+
+        template <class V, bool Inv, class T>
+        E_MATH_ALWAYS_INLINE void stage_dir(const stage_args<T>& a) {
+            switch (a.p) {
+                case 2: stage_radix<V, Inv, 2>(a); break;
+                case 3: stage_radix<V, Inv, 3>(a); break;
+                case 4: stage_radix<V, Inv, 4>(a); break;
+                case 5: stage_radix<V, Inv, 5>(a); break;
+                default: {
+                    const std::size_t vec_end = a.s - a.s % V::width;
+                    if (vec_end > 0) {
+                        stage_generic<V, Inv>(a, 0, vec_end);
+                    }
+                    if (vec_end < a.s) {
+                        stage_generic<scalar_ops<T>, Inv>(a, vec_end, a.s);
+                    }
+                    break;
+                }
+            }
+        }
+
+        template <class V, class T>
+        E_MATH_ALWAYS_INLINE void stage_kernel(const stage_args<T>& a, bool inverse) {
+            if (inverse) {
+                stage_dir<V, true>(a);
+            } else {
+                stage_dir<V, false>(a);
+            }
+        }
+
+        template <class T>
+        using stage_fn = void (*)(const stage_args<T>&, bool);
+
+        // 按 CPU 选好 的 内核 与 它 一个 向量 装 几个 复数
+        template <class T>
+        struct fft_kernel {
+            stage_fn<T> fn;
+            std::size_t width;
+        };
+
+    #define E_MATH_FFT_KERNEL(isa, target, ...)                                                                                 \
+        template <class T>                                                                                                     \
+        target void fft_stage_##isa(const stage_args<T>& a, bool inverse) {                                                    \
+            stage_kernel<__VA_ARGS__>(a, inverse);                                                                             \
+        }                                                                                                                      \
+        template <class T>                                                                                                     \
+        constexpr fft_kernel<T> fft_kernel_##isa{fft_stage_##isa<T>, __VA_ARGS__::width};
+
+#if E_MATH_HAS_NATIVE_VEC
+        E_MATH_FFT_KERNEL(base, , vector_ops<T, detail::base_vec_bytes>)
+    #if E_MATH_X86
+        E_MATH_FFT_KERNEL(avx2, E_MATH_TARGET_AVX2, vector_ops<T, 32>)
+        E_MATH_FFT_KERNEL(avx512, E_MATH_TARGET_AVX512, vector_ops<T, 64>)
+    #endif
+#else
+        E_MATH_FFT_KERNEL(base, , scalar_ops<T>)
+#endif
+
+    #undef E_MATH_FFT_KERNEL
+
+        template <class T>
+        fft_kernel<T> select_fft_kernel() {
+#if E_MATH_HAS_NATIVE_VEC && E_MATH_X86
+            switch (detail::cpu_simd_level()) {
+                case detail::simd_level::avx512: return fft_kernel_avx512<T>;
+                case detail::simd_level::avx2: return fft_kernel_avx2<T>;
+                default: break;
+            }
+#endif
+            return fft_kernel_base<T>;
+        }
+
+        const fft_kernel<float> g_fft_float = select_fft_kernel<float>();
+        const fft_kernel<double> g_fft_double = select_fft_kernel<double>();
+
+        const fft_kernel<float>& kernel_for(float) { return g_fft_float; }
+        const fft_kernel<double>& kernel_for(double) { return g_fft_double; }
+
+        // n 分解成 4、2、3、5 与 其余 素数
+        std::vector<std::size_t> factorize(std::size_t n) {
+            std::vector<std::size_t> f;
+            for (std::size_t p : {4, 2, 3, 5}) {
+                while (n % p == 0) {
+                    f.push_back(p);
+                    n /= p;
+                }
+            }
+            for (std::size_t p = 7; p * p <= n; p += 2) {
+                while (n % p == 0) {
+                    f.push_back(p);
+                    n /= p;
+                }
+            }
+            if (n > 1) {
+                f.push_back(n);
+            }
+            return f;
+        }
+
+        // 最近 使用 的 plan 在 后面；条目 很少，线性 查找 比 链表 + 哈希表 快
+        template <class Plan>
+        struct plan_cache {
+            std::mutex mutex;
+            std::vector<std::pair<std::size_t, std::shared_ptr<const Plan>>> plans;
+
+            static plan_cache& instance() {
+                static plan_cache cache;
+                return cache;
+            }
+
+            std::shared_ptr<const Plan> get(std::size_t n) {
+                std::lock_guard lock(mutex);
+                auto it = std::find_if(plans.begin(), plans.end(), [n](const auto& e) { return e.first == n; });
+                if (it != plans.end()) {
+                    std::rotate(it, it + 1, plans.end());
+                    return plans.back().second;
+                }
+                if (plans.size() == fft_plan_cache_size) {
+                    plans.erase(plans.begin());
+                }
+                plans.emplace_back(n, std::make_shared<const Plan>(n));
+                return plans.back().second;
+            }
+
+            void clear() {
+                // 在 锁 外 析构，大 plan 的 释放 不 挡住 别的 线程
+                std::vector<std::pair<std::size_t, std::shared_ptr<const Plan>>> old;
+                {
+                    std::lock_guard lock(mutex);
+                    old.swap(plans);
+                }
+            }
+        };
+
+        // 把 count 个 信号 切成 若干段 交给 线程池；段数 只取决于 总长度
+        template <class F>
+        void for_each_signal(std::size_t count, std::size_t points, F&& fn) {
+            const std::size_t tasks = std::clamp<std::size_t>(count * points / parallel_points_per_task, 1, std::min<std::size_t>(count, max_threads()));
+            if (tasks <= 1) {
+                for (std::size_t i = 0; i < count; ++i) fn(i);
+                return;
+            }
+            detail::parallel_for(tasks, [&](std::size_t t) {
+                const std::size_t b = count / tasks * t + count % tasks * t / tasks;
+                const std::size_t e = count / tasks * (t + 1) + count % tasks * (t + 1) / tasks;
+                for (std::size_t i = b; i < e; ++i) fn(i);
+            });
+        }
+
+        void check_length(std::size_t got, std::size_t expected, const char* what) {
+            if (got != expected) {
+                throw std::invalid_argument(what);
+            }
+        }
+    }
+
+    // ---------------- 复数 FFT ----------------
+
+    template <class T>
+    fft_plan<T>::fft_plan(std::size_t n) : n_(n) {
+        if (n == 0) {
+            throw std::invalid_argument("e_math::fft_plan: size must be positive");
+        }
+        const std::size_t width = kernel_for(T{}).width;
+        std::size_t stride = 1;
+        std::size_t len = n;
+        for (std::size_t p : factorize(n)) {
+            const std::size_t m = len / p;
+            stage st{p, m, stride, twiddles_.size(), 0, npos};
+            for (std::size_t j = 0; j < m; ++j) {
+                for (std::size_t k = 1; k < p; ++k) twiddles_.push_back(root<T>(j * k, len));
+            }
+            if (p > 5) {
+                st.roots = twiddles_.size();
+                for (std::size_t e = 0; e < p; ++e) twiddles_.push_back(root<T>(e, p));
+            }
+            // 一个 向量 装 width / stride 个 j：每块 每个 k 放 width 个，第 l 路 对应 j = 块首 + l / stride
+            if (p <= 5 && stride < width && width % stride == 0 && m >= width / stride) {
+                const std::size_t group = width / stride;
+                st.wide = twiddles_.size();
+                for (std::size_t j = 0; j + group <= m; j += group) {
+                    for (std::size_t k = 1; k < p; ++k) {
+                        for (std::size_t l = 0; l < width; ++l) twiddles_.push_back(root<T>((j + l / stride) * k, len));
+                    }
+                }
+            }
+            stages_.push_back(st);
+            stride *= p;
+            len = m;
+        }
+    }
+
+    template <class T>
+    std::shared_ptr<const fft_plan<T>> fft_plan<T>::cached(std::size_t n) {
+        return plan_cache<fft_plan<T>>::instance().get(n);
+    }
+
+    template <class T>
+    void fft_plan<T>::run(const std::complex<T>* in, std::complex<T>* out, bool inverse) const {
+        const std::size_t count = stages_.size();
+        if (count == 0) {
+            out[0] = in[0];
+            return;
+        }
+        // 最后一级 写到 out：倒数 偶数 级 写 out、奇数 级 写 work
+        std::complex<T>* work = scratch<T>(0, n_);
+        const std::complex<T>* src = in;
+        if (in == out && count % 2 == 1) {
+            std::copy(in, in + n_, work);
+            src = work;
+        }
+        const stage_fn<T> kernel = kernel_for(T{}).fn;
+        const std::complex<T>* tw = twiddles_.data();
+        for (std::size_t i = 0; i < count; ++i) {
+            const stage& st = stages_[i];
+            std::complex<T>* dst = (count - 1 - i) % 2 == 0 ? out : work;
+            const stage_args<T> args{src, dst, st.radix, st.m, st.stride, tw + st.twiddle, tw + st.roots, st.wide == npos ? nullptr : tw + st.wide};
+            kernel(args, inverse);
+            src = dst;
+        }
+    }
+
+    template <class T>
+    void fft_plan<T>::forward(std::span<const std::complex<T>> in, std::span<std::complex<T>> out) const {
+        check_length(in.size(), n_, "e_math::fft_plan: input size does not match the plan");
+        check_length(out.size(), n_, "e_math::fft_plan: output size does not match the plan");
+        run(in.data(), out.data(), false);
+    }
+
+    template <class T>
+    void fft_plan<T>::inverse(std::span<const std::complex<T>> in, std::span<std::complex<T>> out) const {
+        check_length(in.size(), n_, "e_math::fft_plan: input size does not match the plan");
+        check_length(out.size(), n_, "e_math::fft_plan: output size does not match the plan");
+        run(in.data(), out.data(), true);
+    }
+
+    template <class T>
+    void fft_plan<T>::run_batch(std::span<const std::complex<T>> in, std::span<std::complex<T>> out, std::size_t count, bool inverse) const {
+        check_length(in.size(), count * n_, "e_math::fft_plan: input size must be count * size()");
+        check_length(out.size(), count * n_, "e_math::fft_plan: output size must be count * size()");
+        for_each_signal(count, n_, [&](std::size_t i) { run(in.data() + i * n_, out.data() + i * n_, inverse); });
+    }
+
+    template <class T>
+    void fft_plan<T>::forward(std::span<const std::complex<T>> in, std::span<std::complex<T>> out, std::size_t count) const {
+        run_batch(in, out, count, false);
+    }
+
+    template <class T>
+    void fft_plan<T>::inverse(std::span<const std::complex<T>> in, std::span<std::complex<T>> out, std::size_t count) const {
+        run_batch(in, out, count, true);
+    }
+
+    // ---------------- 实数 FFT ----------------
+    // 偶数 n = 2h：z[t] = x[2t] + i x[2t + 1]，Z = FFT_h(z)
+    //   X[k] = E[k] + w^k O[k]，E[k] = (Z[k] + conj Z[h - k]) / 2，O[k] = -i (Z[k] - conj Z[h - k]) / 2，w = exp(-2 pi i / n)
+
+    namespace {
+        std::size_t rfft_complex_size(std::size_t n) {
+            if (n == 0) {
+                throw std::invalid_argument("e_math::rfft_plan: size must be positive");
+            }
+            return n % 2 == 0 ? n / 2 : n;
+        }
+    }
+
+    template <class T>
+    rfft_plan<T>::rfft_plan(std::size_t n) : n_(n), complex_(rfft_complex_size(n)) {
+        if (n % 2 == 0) {
+            split_.resize(n / 2);
+            for (std::size_t k = 0; k < n / 2; ++k) split_[k] = root<T>(k, n);
+        }
+    }
+
+    template <class T>
+    std::shared_ptr<const rfft_plan<T>> rfft_plan<T>::cached(std::size_t n) {
+        return plan_cache<rfft_plan<T>>::instance().get(n);
+    }
+
+    template <class T>
+    void rfft_plan<T>::forward_one(const T* in, std::complex<T>* out) const {
+        if (n_ % 2 == 1) {
+            std::complex<T>* buf = scratch<T>(1, n_);
+            for (std::size_t t = 0; t < n_; ++t) buf[t] = {in[t], T(0)};
+            complex_.run(buf, buf, false);
+            std::copy(buf, buf + n_ / 2 + 1, out);
+            return;
+        }
+
+        // 实数 直接 当作 h 个 复数 放进 out，原地 变换 后 成对 拆开
+        const std::size_t h = n_ / 2;
+        std::memcpy(static_cast<void*>(out), in, n_ * sizeof(T));
+        complex_.run(out, out, false);
+
+        const std::complex<T> z0 = out[0];
+        out[0] = {z0.real() + z0.imag(), T(0)};
+        out[h] = {z0.real() - z0.imag(), T(0)};
+        auto split = [&](std::complex<T> a, std::complex<T> b, std::size_t k) {
+            const std::complex<T> e = (a + std::conj(b)) * T(0.5);
+            const std::complex<T> d = (a - std::conj(b)) * T(0.5);
+            const std::complex<T> o{d.imag(), -d.real()};
+            return e + split_[k] * o;
+        };
+        for (std::size_t k = 1; k <= h / 2; ++k) {
+            const std::complex<T> a = out[k];
+            const std::complex<T> b = out[h - k];
+            out[k] = split(a, b, k);
+            out[h - k] = split(b, a, h - k);
+        }
+    }
+
+    template <class T>
+    void rfft_plan<T>::inverse_one(const std::complex<T>* in, T* out) const {
+        if (n_ % 2 == 1) {
+            std::complex<T>* buf = scratch<T>(1, n_);
+            buf[0] = {in[0].real(), T(0)};
+            for (std::size_t k = 1; k <= n_ / 2; ++k) {
+                buf[k] = in[k];
+                buf[n_ - k] = std::conj(in[k]);
+            }
+            complex_.run(buf, buf, true);
+            for (std::size_t t = 0; t < n_; ++t) out[t] = buf[t].real();
+            return;
+        }
+
+        // 拆分 的 逆：Z[k] = E + i O，E = X[k] + conj X[h - k]，O = (X[k] - conj X[h - k]) * conj(w^k)
+        // 不除以 2，h 点 逆变换 后 正好 是 n * x
+        const std::size_t h = n_ / 2;
+        std::complex<T>* buf = scratch<T>(1, h);
+        for (std::size_t k = 0; k < h; ++k) {
+            std::complex<T> a = in[k];
+            std::complex<T> b = std::conj(in[h - k]);
+            if (k == 0) {
+                a = {a.real(), T(0)};
+                b = {b.real(), T(0)};
+            }
+            const std::complex<T> e = a + b;
+            const std::complex<T> o = (a - b) * std::conj(split_[k]);
+            buf[k] = {e.real() - o.imag(), e.imag() + o.real()};
+        }
+        complex_.run(buf, buf, true);
+        std::memcpy(out, static_cast<const void*>(buf), n_ * sizeof(T));
+    }
+
+    template <class T>
+    void rfft_plan<T>::forward(std::span<const T> in, std::span<std::complex<T>> out) const {
+        check_length(in.size(), n_, "e_math::rfft_plan: input size does not match the plan");
+        check_length(out.size(), n_ / 2 + 1, "e_math::rfft_plan: output size must be size() / 2 + 1");
+        forward_one(in.data(), out.data());
+    }
+
+    template <class T>
+    void rfft_plan<T>::inverse(std::span<const std::complex<T>> in, std::span<T> out) const {
+        check_length(in.size(), n_ / 2 + 1, "e_math::rfft_plan: input size must be size() / 2 + 1");
+        check_length(out.size(), n_, "e_math::rfft_plan: output size does not match the plan");
+        inverse_one(in.data(), out.data());
+    }
+
+    template <class T>
+    void rfft_plan<T>::forward(std::span<const T> in, std::span<std::complex<T>> out, std::size_t count) const {
+        const std::size_t bins = n_ / 2 + 1;
+        check_length(in.size(), count * n_, "e_math::rfft_plan: input size must be count * size()");
+        check_length(out.size(), count * bins, "e_math::rfft_plan: output size must be count * (size() / 2 + 1)");
+        for_each_signal(count, n_, [&](std::size_t i) { forward_one(in.data() + i * n_, out.data() + i * bins); });
+    }
+
+    template <class T>
+    void rfft_plan<T>::inverse(std::span<const std::complex<T>> in, std::span<T> out, std::size_t count) const {
+        const std::size_t bins = n_ / 2 + 1;
+        check_length(in.size(), count * bins, "e_math::rfft_plan: input size must be count * (size() / 2 + 1)");
+        check_length(out.size(), count * n_, "e_math::rfft_plan: output size must be count * size()");
+        for_each_signal(count, n_, [&](std::size_t i) { inverse_one(in.data() + i * bins, out.data() + i * n_); });
+    }
+
+    template class fft_plan<float>;
+    template class fft_plan<double>;
+    template class rfft_plan<float>;
+    template class rfft_plan<double>;
+
+    // ---------------- 便捷函数 ----------------
+
+    void clear_fft_plan_cache() {
+        plan_cache<fft_plan<float>>::instance().clear();
+        plan_cache<fft_plan<double>>::instance().clear();
+        plan_cache<rfft_plan<float>>::instance().clear();
+        plan_cache<rfft_plan<double>>::instance().clear();
+    }
+
+#define E_MATH_FFT_FUNCTIONS(T)                                                                                                \
+    void fft(std::span<const std::complex<T>> in, std::span<std::complex<T>> out) {                                           \
+        check_length(out.size(), in.size(), "e_math::fft: input and output must have the same size");                        \
+        if (!in.empty()) fft_plan<T>::cached(in.size())->forward(in, out);                                                     \
+    }                                                                                                                          \
+    void ifft(std::span<const std::complex<T>> in, std::span<std::complex<T>> out) {                                          \
+        check_length(out.size(), in.size(), "e_math::ifft: input and output must have the same size");                       \
+        if (!in.empty()) fft_plan<T>::cached(in.size())->inverse(in, out);                                                     \
+    }                                                                                                                          \
+    void rfft(std::span<const T> in, std::span<std::complex<T>> out) {                                                        \
+        if (in.empty()) {                                                                                                      \
+            check_length(out.size(), 0, "e_math::rfft: output size must be input size / 2 + 1");                             \
+            return;                                                                                                            \
+        }                                                                                                                      \
+        rfft_plan<T>::cached(in.size())->forward(in, out);                                                                     \
+    }                                                                                                                          \
+    void irfft(std::span<const std::complex<T>> in, std::span<T> out) {                                                       \
+        if (out.empty()) {                                                                                                     \
+            check_length(in.size(), 0, "e_math::irfft: input size must be output size / 2 + 1");                             \
+            return;                                                                                                            \
+        }                                                                                                                      \
+        rfft_plan<T>::cached(out.size())->inverse(in, out);                                                                    \
+    }
+
+    E_MATH_FFT_FUNCTIONS(float)
+    E_MATH_FFT_FUNCTIONS(double)
+
+#undef E_MATH_FFT_FUNCTIONS
+}
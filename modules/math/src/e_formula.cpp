@@ -0,0 +1,580 @@
+#include "e_formula.hpp"
+#include "e_lanes.hpp"
+#include "e_pool.hpp"
+#include "e_simd.hpp"
+#include "e_vmath.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace e_math {
+    namespace {
+        using unary_fn = void (*)(const double* a, double* out, std::size_t n);
+
+        // array_view 的 块 内核 里 没有 的 运算
+        struct formula_kernels {
+            detail::expr_fn<double> div;
+            detail::expr_scalar_fn<double> div_scalar;  // a / s
+            detail::expr_scalar_fn<double> rdiv_scalar; // s / a
+            unary_fn neg;
+            unary_fn abs;
+            unary_fn sqrt;
+        };
+
+        // ---------------- 块 内核：只写一次，各指令集 的 包装函数 按 Bytes 展开；out 可以 就是 输入 ----------------
+
+        template <std::size_t Bytes>
+        E_MATH_ALWAYS_INLINE void div_block(const double* a, const double* b, double* out, std::size_t n) {
+            std::size_t i = 0;
+#if E_MATH_HAS_NATIVE_VEC
+            using V = detail::vec<double, Bytes>;
+            constexpr std::size_t w = detail::vec_size<double, Bytes>;
+            for (; i + w <= n; i += w) {
+                V x, y;
+                std::memcpy(&x, a + i, sizeof(V));
+                std::memcpy(&y, b + i, sizeof(V));
+                const V r = x / y;
+                std::memcpy(out + i, &r, sizeof(V));
+            }
+#endif
+            for (; i < n; ++i) out[i] = a[i] / b[i];
+        }
+
+        template <std::size_t Bytes, bool Reverse>
+        E_MATH_ALWAYS_INLINE void div_scalar_block(const double* a, double s, double* out, std::size_t n) {
+            std::size_t i = 0;
+#if E_MATH_HAS_NATIVE_VEC
+            using V = detail::vec<double, Bytes>;
+            constexpr std::size_t w = detail::vec_size<double, Bytes>;
+            const V y = V{} + s;
+            for (; i + w <= n; i += w) {
+                V x;
+                std::memcpy(&x, a + i, sizeof(V));
+                const V r = Reverse ? y / x : x / y;
+                std::memcpy(out + i, &r, sizeof(V));
+            }
+#endif
+            for (; i < n; ++i) out[i] = Reverse ? s / a[i] : a[i] / s;
+        }
+
+        // 只动 符号位：-0、NaN 也 正确
+        template <std::size_t Bytes, std::uint64_t Mask, bool Xor>
+        E_MATH_ALWAYS_INLINE void sign_block(const double* a, double* out, std::size_t n) {
+            std::size_t i = 0;
+#if E_MATH_HAS_NATIVE_VEC
+            using U = detail::vec<std::uint64_t, Bytes>;
+            constexpr std::size_t w = detail::vec_size<std::uint64_t, Bytes>;
+            const U m = U{} + Mask;
+            for (; i + w <= n; i += w) {
+                U x;
+                std::memcpy(&x, a + i, sizeof(U));
+                const U r = Xor ? x ^ m : x & m;
+                std::memcpy(out + i, &r, sizeof(U));
+            }
+#endif
+            for (; i < n; ++i) {
+                std::uint64_t x;
+                std::memcpy(&x, a + i, sizeof(x));
+                x = Xor ? x ^ Mask : x & Mask;
+                std::memcpy(out + i, &x, sizeof(x));
+            }
+        }
+
+        constexpr std::uint64_t sign_bit = std::uint64_t(1) << 63;
+
+        void sqrt_scalar(const double* a, double* out, std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) out[i] = std::sqrt(a[i]);
+        }
+
+#if E_MATH_X86
+        E_MATH_TARGET_AVX2 void sqrt_avx2(const double* a, double* out, std::size_t n) {
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) _mm256_storeu_pd(out + i, _mm256_sqrt_pd(_mm256_loadu_pd(a + i)));
+            sqrt_scalar(a + i, out + i, n - i);
+        }
+
+// GCC 12 的 _mm512_sqrt_pd 内部 用 _mm512_undefined_pd，会报 -Wmaybe-uninitialized 误报
+    #if defined(__GNUC__) && !defined(__clang__)
+        #pragma GCC diagnostic push
+        #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    #endif
+        E_MATH_TARGET_AVX512 void sqrt_avx512(const double* a, double* out, std::size_t n) {
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8) _mm512_storeu_pd(out + i, _mm512_sqrt_pd(_mm512_loadu_pd(a + i)));
+            sqrt_scalar(a + i, out + i, n - i);
+        }
+    #if defined(__GNUC__) && !defined(__clang__)
+        #pragma GCC diagnostic pop
+    #endif
+#endif
+
+    #define E_MATH_FORMULA_KERNELS(isa, target, B, sqrt_fn)                                                                   \
+        target void div_##isa(const double* a, const double* b, double* out, std::size_t n) { div_block<B>(a, b, out, n); }  \
+        target void div_scalar_##isa(const double* a, double s, double* out, std::size_t n) {                                \
+            div_scalar_block<B, false>(a, s, out, n);                                                                         \
+        }                                                                                                                     \
+        target void rdiv_scalar_##isa(const double* a, double s, double* out, std::size_t n) {                               \
+            div_scalar_block<B, true>(a, s, out, n);                                                                          \
+        }                                                                                                                     \
+        target void neg_##isa(const double* a, double* out, std::size_t n) { sign_block<B, sign_bit, true>(a, out, n); }     \
+        target void abs_##isa(const double* a, double* out, std::size_t n) { sign_block<B, ~sign_bit, false>(a, out, n); }   \
+        constexpr formula_kernels formula_kernels_##isa = {div_##isa, div_scalar_##isa, rdiv_scalar_##isa, neg_##isa, abs_##isa, sqrt_fn};
+
+        E_MATH_FORMULA_KERNELS(base, , detail::base_vec_bytes, sqrt_scalar)
+#if E_MATH_HAS_NATIVE_VEC && E_MATH_X86
+        E_MATH_FORMULA_KERNELS(avx2, E_MATH_TARGET_AVX2, 32, sqrt_avx2)
+        E_MATH_FORMULA_KERNELS(avx512, E_MATH_TARGET_AVX512, 64, sqrt_avx512)
+#endif
+
+    #undef E_MATH_FORMULA_KERNELS
+
+        const formula_kernels& select_formula_kernels() {
+#if E_MATH_HAS_NATIVE_VEC && E_MATH_X86
+            switch (detail::cpu_simd_level()) {
+                case detail::simd_level::avx512: return formula_kernels_avx512;
+                case detail::simd_level::avx2: return formula_kernels_avx2;
+                default: break;
+            }
+#endif
+            return formula_kernels_base;
+        }
+
+        const formula_kernels& g_formula = select_formula_kernels();
+
+        // e_vmath.hpp 的 批量 函数，包成 块 内核 的 形式
+        template <void (*F)(std::span<const double>, std::span<double>, precision)>
+        void vmath_block(const double* a, double* out, std::size_t n) {
+            F(std::span<const double>(a, n), std::span<double>(out, n), precision::accurate);
+        }
+
+        void copy_block(const double* a, double* out, std::size_t n) {
+            std::memmove(out, a, n * sizeof(double));
+        }
+
+        // ---------------- 编译 ----------------
+
+        enum class op : unsigned char {
+            constant,
+            column,
+            add,
+            sub,
+            mul,
+            div,
+            min,
+            max,
+            neg,
+            abs,
+            sqrt,
+            exp,
+            log,
+            sin,
+            cos,
+            tanh,
+            sigmoid,
+        };
+
+        bool is_binary(op o) { return o >= op::add && o <= op::max; }
+
+        bool is_commutative(op o) { return o == op::add || o == op::mul || o == op::min || o == op::max; }
+
+        struct function_info {
+            std::string_view name;
+            op o;
+            int arity;
+        };
+
+        // clamp 展开成 min(max(x, lo), hi)，这里 的 o 不用
+        constexpr function_info functions[] = {
+            {"min", op::min, 2},   {"max", op::max, 2},   {"clamp", op::min, 3}, {"abs", op::abs, 1},
+            {"sqrt", op::sqrt, 1}, {"exp", op::exp, 1},   {"log", op::log, 1},   {"sin", op::sin, 1},
+            {"cos", op::cos, 1},   {"tanh", op::tanh, 1}, {"sigmoid", op::sigmoid, 1},
+        };
+
+        // 两个 操作数 都是 数组 时 的 内核
+        detail::expr_fn<double> binary_kernel(op o) {
+            const auto& k = detail::expr_kernels<double>();
+            switch (o) {
+                case op::add: return k.binary[static_cast<std::size_t>(detail::expr_op::add)];
+                case op::sub: return k.binary[static_cast<std::size_t>(detail::expr_op::sub)];
+                case op::mul: return k.binary[static_cast<std::size_t>(detail::expr_op::mul)];
+                case op::min: return k.binary[static_cast<std::size_t>(detail::expr_op::min)];
+                case op::max: return k.binary[static_cast<std::size_t>(detail::expr_op::max)];
+                default: return g_formula.div;
+            }
+        }
+
+        // 一边 是 常数：constant_left 时 为 s op a
+        detail::expr_scalar_fn<double> scalar_kernel(op o, bool constant_left) {
+            const auto& k = detail::expr_kernels<double>();
+            auto pick = [&](detail::expr_scalar_op s) { return k.scalar[static_cast<std::size_t>(s)]; };
+            switch (o) {
+                case op::add: return pick(detail::expr_scalar_op::add);
+                case op::sub: return pick(constant_left ? detail::expr_scalar_op::rsub : detail::expr_scalar_op::sub);
+                case op::mul: return pick(detail::expr_scalar_op::mul);
+                case op::min: return pick(detail::expr_scalar_op::min);
+                case op::max: return pick(detail::expr_scalar_op::max);
+                default: return constant_left ? g_formula.rdiv_scalar : g_formula.div_scalar;
+            }
+        }
+
+        unary_fn unary_kernel(op o) {
+            switch (o) {
+                case op::neg: return g_formula.neg;
+                case op::abs: return g_formula.abs;
+                case op::sqrt: return g_formula.sqrt;
+                case op::exp: return vmath_block<e_math::exp>;
+                case op::log: return vmath_block<e_math::log>;
+                case op::sin: return vmath_block<e_math::sin>;
+                case op::cos: return vmath_block<e_math::cos>;
+                case op::tanh: return vmath_block<e_math::tanh>;
+                default: return vmath_block<e_math::sigmoid>;
+            }
+        }
+
+        // 括号 / 一元 负号 的 嵌套 上限，防止 恶意 输入 把 栈 用完
+        constexpr int max_depth = 256;
+    }
+
+    // 递归 下降 解析，边 解析 边 建 DAG：相同 的 节点 只建 一次（公共子表达式），常数 参数 当场 算掉
+    class formula::compiler {
+    public:
+        compiler(std::string_view text, const std::vector<std::string>& columns) : text_(text), columns_(columns) {}
+
+        void compile(formula& f) {
+            const std::uint32_t root = parse_expr();
+            skip_space();
+            if (pos_ != text_.size()) fail("unexpected character");
+            emit(f, root);
+        }
+
+    private:
+        struct node {
+            op o;
+            std::uint32_t a = 0; // 列 下标，或 第一个 参数
+            std::uint32_t b = 0;
+            double value = 0;
+        };
+
+        [[noreturn]] void fail(const std::string& what) const {
+            throw std::invalid_argument("e_math::formula: " + what + " at " + std::to_string(pos_));
+        }
+
+        // ---------------- 建 节点 ----------------
+
+        std::uint32_t intern(const node& n) {
+            std::uint64_t bits = 0;
+            std::memcpy(&bits, &n.value, sizeof(bits));
+            const auto key = std::make_tuple(n.o, n.a, n.b, bits);
+            const auto it = index_.find(key);
+            if (it != index_.end()) return it->second;
+            const auto id = static_cast<std::uint32_t>(nodes_.size());
+            nodes_.push_back(n);
+            index_.emplace(key, id);
+            return id;
+        }
+
+        std::uint32_t constant(double v) { return intern({op::constant, 0, 0, v}); }
+
+        bool is_constant(std::uint32_t id) const { return nodes_[id].o == op::constant; }
+
+        std::uint32_t binary(op o, std::uint32_t a, std::uint32_t b) {
+            if (is_constant(a) && is_constant(b)) {
+                double r = 0;
+                binary_kernel(o)(&nodes_[a].value, &nodes_[b].value, &r, 1);
+                return constant(r);
+            }
+            if (is_commutative(o) && a > b) std::swap(a, b);
+            return intern({o, a, b, 0});
+        }
+
+        std::uint32_t unary(op o, std::uint32_t a) {
+            if (is_constant(a)) {
+                double r = 0;
+                unary_kernel(o)(&nodes_[a].value, &r, 1);
+                return constant(r);
+            }
+            return intern({o, a, 0, 0});
+        }
+
+        // ---------------- 解析 ----------------
+
+        void skip_space() {
+            while (pos_ < text_.size() && (text_[pos_] == ' ' || text_[pos_] == '\t' || text_[pos_] == '\n' || text_[pos_] == '\r')) ++pos_;
+        }
+
+        bool accept(char c) {
+            skip_space();
+            if (pos_ < text_.size() && text_[pos_] == c) {
+                ++pos_;
+                return true;
+            }
+            return false;
+        }
+
+        void expect(char c) {
+            if (!accept(c)) fail(std::string("expected '") + c + "'");
+        }
+
+        static bool ident_start(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_'; }
+        static bool ident_char(char c) { return ident_start(c) || (c >= '0' && c <= '9'); }
+
+        std::uint32_t parse_expr() {
+            if (++depth_ > max_depth) fail("expression nested too deeply");
+            std::uint32_t x = parse_term();
+            for (;;) {
+                if (accept('+')) {
+                    x = binary(op::add, x, parse_term());
+                } else if (accept('-')) {
+                    x = binary(op::sub, x, parse_term());
+                } else {
+                    break;
+                }
+            }
+            --depth_;
+            return x;
+        }
+
+        std::uint32_t parse_term() {
+            std::uint32_t x = parse_unary();
+            for (;;) {
+                if (accept('*')) {
+                    x = binary(op::mul, x, parse_unary());
+                } else if (accept('/')) {
+                    x = binary(op::div, x, parse_unary());
+                } else {
+                    return x;
+                }
+            }
+        }
+
+        std::uint32_t parse_unary() {
+            if (accept('-')) {
+                if (++depth_ > max_depth) fail("expression nested too deeply");
+                const std::uint32_t x = unary(op::neg, parse_unary());
+                --depth_;
+                return x;
+            }
+            if (accept('+')) return parse_unary();
+            return parse_primary();
+        }
+
+        std::uint32_t parse_primary() {
+            skip_space();
+            if (pos_ == text_.size()) fail("unexpected end of formula");
+            const char c = text_[pos_];
+            if ((c >= '0' && c <= '9') || c == '.') {
+                double v = 0;
+                const auto r = std::from_chars(text_.data() + pos_, text_.data() + text_.size(), v);
+                if (r.ec != std::errc()) fail("invalid number");
+                pos_ = static_cast<std::size_t>(r.ptr - text_.data());
+                return constant(v);
+            }
+            if (ident_start(c)) {
+                const std::size_t start = pos_;
+                while (pos_ < text_.size() && ident_char(text_[pos_])) ++pos_;
+                const std::string_view name = text_.substr(start, pos_ - start);
+                if (accept('(')) return parse_call(name, start);
+                const auto it = std::find(columns_.begin(), columns_.end(), name);
+                if (it == columns_.end()) {
+                    pos_ = start;
+                    fail("unknown column '" + std::string(name) + "'");
+                }
+                return intern({op::column, static_cast<std::uint32_t>(it - columns_.begin()), 0, 0});
+            }
+            if (accept('(')) {
+                const std::uint32_t x = parse_expr();
+                expect(')');
+                return x;
+            }
+            fail("unexpected character");
+        }
+
+        std::uint32_t parse_call(std::string_view name, std::size_t start) {
+            const auto it = std::find_if(std::begin(functions), std::end(functions), [&](const function_info& f) { return f.name == name; });
+            if (it == std::end(functions)) {
+                pos_ = start;
+                fail("unknown function '" + std::string(name) + "'");
+            }
+            std::vector<std::uint32_t> args;
+            if (!accept(')')) {
+                do {
+                    args.push_back(parse_expr());
+                } while (accept(','));
+                expect(')');
+            }
+            if (static_cast<int>(args.size()) != it->arity) {
+                pos_ = start;
+                fail(std::string(name) + " takes " + std::to_string(it->arity) + " argument(s)");
+            }
+            if (name == "clamp") return binary(op::min, binary(op::max, args[0], args[1]), args[2]);
+            if (it->arity == 2) return binary(it->o, args[0], args[1]);
+            return unary(it->o, args[0]);
+        }
+
+        // ---------------- 生成 字节码 ----------------
+        // 子节点 的 编号 总比 父节点 小，按 编号 顺序 就是 合法 的 计算 顺序
+        // 块 缓冲 在 最后 一次 使用 后 立即 回收，本条 指令 的 结果 可以 写进 刚 回收 的 缓冲（内核 允许 原地）
+
+        void emit(formula& f, std::uint32_t root) {
+            const std::size_t count = nodes_.size();
+            std::vector<bool> live(count, false);
+            std::vector<std::uint32_t> uses(count, 0);
+            live[root] = true;
+            for (std::size_t i = count; i-- > 0;) {
+                if (!live[i]) continue;
+                const node& n = nodes_[i];
+                if (n.o == op::constant || n.o == op::column) continue;
+                live[n.a] = true;
+                ++uses[n.a];
+                if (is_binary(n.o)) {
+                    live[n.b] = true;
+                    ++uses[n.b];
+                }
+            }
+
+            const node& top = nodes_[root];
+            if (top.o == op::constant || top.o == op::column) {
+                instruction ins;
+                ins.dst.k = operand::kind::output;
+                if (top.o == op::constant) {
+                    ins.k = instruction::kind::fill;
+                    ins.s = top.value;
+                } else {
+                    ins.k = instruction::kind::unary;
+                    ins.a = {operand::kind::column, top.a};
+                    ins.unary = copy_block;
+                }
+                f.code_.push_back(ins);
+                return;
+            }
+
+            std::vector<operand> where(count);
+            std::vector<std::uint32_t> free_regs;
+            std::uint32_t regs = 0;
+            auto release = [&](std::uint32_t id) {
+                if (--uses[id] == 0 && where[id].k == operand::kind::reg) free_regs.push_back(where[id].index);
+            };
+
+            for (std::uint32_t i = 0; i <= root; ++i) {
+                if (!live[i]) continue;
+                const node& n = nodes_[i];
+                if (n.o == op::constant) continue;
+                if (n.o == op::column) {
+                    where[i] = {operand::kind::column, n.a};
+                    continue;
+                }
+
+                instruction ins;
+                if (is_binary(n.o)) {
+                    const bool left_constant = is_constant(n.a);
+                    const bool right_constant = is_constant(n.b);
+                    if (left_constant || right_constant) {
+                        ins.k = instruction::kind::scalar;
+                        ins.a = where[left_constant ? n.b : n.a];
+                        ins.s = nodes_[left_constant ? n.a : n.b].value;
+                        ins.scalar = scalar_kernel(n.o, left_constant);
+                        release(left_constant ? n.b : n.a);
+                    } else {
+                        ins.k = instruction::kind::binary;
+                        ins.a = where[n.a];
+                        ins.b = where[n.b];
+                        ins.binary = binary_kernel(n.o);
+                        release(n.a);
+                        release(n.b);
+                    }
+                } else {
+                    ins.k = instruction::kind::unary;
+                    ins.a = where[n.a];
+                    ins.unary = unary_kernel(n.o);
+                    release(n.a);
+                }
+
+                if (i == root) {
+                    ins.dst.k = operand::kind::output;
+                } else {
+                    std::uint32_t r;
+                    if (free_regs.empty()) {
+                        r = regs++;
+                    } else {
+                        // 取 编号 最小 的，结果 与 回收 顺序 无关
+                        const auto it = std::min_element(free_regs.begin(), free_regs.end());
+                        r = *it;
+                        free_regs.erase(it);
+                    }
+                    ins.dst = {operand::kind::reg, r};
+                    where[i] = ins.dst;
+                }
+                f.code_.push_back(ins);
+            }
+            f.registers_ = regs;
+        }
+
+        std::string_view text_;
+        const std::vector<std::string>& columns_;
+        std::size_t pos_ = 0;
+        int depth_ = 0;
+        std::vector<node> nodes_;
+        std::map<std::tuple<op, std::uint32_t, std::uint32_t, std::uint64_t>, std::uint32_t> index_;
+    };
+
+    formula::formula(std::string_view text, std::vector<std::string> columns) : columns_(std::move(columns)) {
+        compiler(text, columns_).compile(*this);
+    }
+
+    void formula::run(const std::span<const double>* columns, double* out, std::size_t begin, std::size_t end, double* regs) const {
+        for (std::size_t i = begin; i < end; i += block_rows) {
+            const std::size_t n = std::min(block_rows, end - i);
+            auto at = [&](const operand& o) -> double* {
+                switch (o.k) {
+                    case operand::kind::column: return const_cast<double*>(columns[o.index].data()) + i;
+                    case operand::kind::reg: return regs + o.index * block_rows;
+                    default: return out + i;
+                }
+            };
+            // 每条 指令 对 整块 调用 一次 内核
+            for (const instruction& ins : code_) {
+                double* dst = at(ins.dst);
+                switch (ins.k) {
+                    case instruction::kind::binary: ins.binary(at(ins.a), at(ins.b), dst, n); break;
+                    case instruction::kind::scalar: ins.scalar(at(ins.a), ins.s, dst, n); break;
+                    case instruction::kind::unary: ins.unary(at(ins.a), dst, n); break;
+                    case instruction::kind::fill: std::fill(dst, dst + n, ins.s); break;
+                }
+            }
+        }
+    }
+
+    void formula::evaluate(std::span<const std::span<const double>> columns, std::span<double> out, execution policy) const {
+        if (columns.size() != columns_.size()) {
+            throw std::invalid_argument("e_math::formula: wrong number of columns");
+        }
+        for (const auto& c : columns) {
+            if (c.size() != out.size()) {
+                throw std::invalid_argument("e_math::formula: columns must have the same size as out");
+            }
+        }
+        const std::size_t n = out.size();
+        const std::size_t grain = detail::expr_parallel_grain;
+        const std::size_t tasks = (n + grain - 1) / grain;
+        if (policy == execution::parallel && tasks > 1) {
+            detail::parallel_for(tasks, [&](std::size_t t) {
+                std::vector<double> regs(registers_ * block_rows);
+                const std::size_t begin = t * grain;
+                run(columns.data(), out.data(), begin, std::min(n, begin + grain), regs.data());
+            });
+        } else {
+            std::vector<double> regs(registers_ * block_rows);
+            run(columns.data(), out.data(), 0, n, regs.data());
+        }
+    }
+}
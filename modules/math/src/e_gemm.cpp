@@ -0,0 +1,309 @@
+#include "e_gemm.hpp"
+#include "e_lanes.hpp"
+#include "e_parallel.hpp"
+#include "e_pool.hpp"
+#include "e_simd.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace e_math {
+    namespace {
+        // 微内核 一次算 mr x nr 的 C 块：A 的 mr 个元素 逐个广播，乘 B 的 两个向量（nr = 2 个向量宽）
+        // 累加器 mr x 2 个向量：AVX-512 / AVX2 下 12 个，SSE2 的 16 个 xmm 也放得下
+        constexpr std::size_t mr = 6;
+
+        // 分块：A 的 mc x kc 块 留在 L2，B 的 kc x nr 细条 留在 L1，B 的 kc x nc 面板 留在 L3
+        constexpr std::size_t mc = 96;
+        constexpr std::size_t kc = 256;
+        constexpr std::size_t nc = 4096;
+
+        // m * n * k 小于这个数 时 不值得 分给多个线程
+        constexpr std::size_t parallel_min_work = std::size_t(1) << 21;
+
+        constexpr std::size_t ceil_div(std::size_t a, std::size_t b) {
+            return (a + b - 1) / b;
+        }
+
+        // 元素 (i, j) 在 data[i * rs + j * cs]，行主序 / 列主序 只是 步长不同
+        template <class T>
+        struct strided {
+            T* data;
+            std::size_t rs;
+            std::size_t cs;
+
+            E_MATH_ALWAYS_INLINE T& operator()(std::size_t i, std::size_t j) const { return data[i * rs + j * cs]; }
+
+            strided sub(std::size_t i, std::size_t j) const { return {&(*this)(i, j), rs, cs}; }
+
+            strided transposed() const { return {data, cs, rs}; }
+        };
+
+        template <class T>
+        strided<T> to_strided(matrix_view<T> v) {
+            if (v.order == layout::row_major) {
+                return {v.data, v.ld, 1};
+            }
+            return {v.data, 1, v.ld};
+        }
+
+        // ---------------- 微内核 / 宏内核 ----------------
+
+        // pa：mr 行的 A 细条，每个 k 连续 mr 个；pb：nr 列的 B 细条，每个 k 连续 nr 个
+        // m / n 是 这一块 实际的 行数 / 列数（边缘 不足 mr / nr，打包时 已补 0）
+        template <class T, std::size_t Bytes>
+        E_MATH_ALWAYS_INLINE void micro_kernel(std::size_t k, const T* pa, const T* pb, std::size_t m, std::size_t n, strided<T> c, T alpha, T beta) {
+            constexpr std::size_t w = Bytes / sizeof(T);
+            constexpr std::size_t nr = 2 * w;
+            T tile[mr][nr];
+#if E_MATH_HAS_NATIVE_VEC
+            using V = detail::vec<T, Bytes>;
+            V acc[mr][2] = {};
+            for (std::size_t p = 0; p < k; ++p) {
+                V b0;
+                V b1;
+                std::memcpy(&b0, pb, sizeof(V));
+                std::memcpy(&b1, pb + w, sizeof(V));
+                E_MATH_UNROLL
+                for (std::size_t i = 0; i < mr; ++i) {
+                    acc[i][0] += pa[i] * b0;
+                    acc[i][1] += pa[i] * b1;
+                }
+                pa += mr;
+                pb += nr;
+            }
+
+            // 整块 且 C 的行连续：直接 向量读写 C
+            if (m == mr && n == nr && c.cs == 1) {
+                E_MATH_UNROLL
+                for (std::size_t i = 0; i < mr; ++i) {
+                    T* row = &c(i, 0);
+                    for (std::size_t h = 0; h < 2; ++h) {
+                        V r = alpha * acc[i][h];
+                        if (beta != T(0)) {
+                            V old;
+                            std::memcpy(&old, row + h * w, sizeof(V));
+                            r += beta * old;
+                        }
+                        std::memcpy(row + h * w, &r, sizeof(V));
+                    }
+                }
+                return;
+            }
+            std::memcpy(tile, acc, sizeof(tile));
+#else
+            for (std::size_t i = 0; i < mr; ++i) {
+                for (std::size_t j = 0; j < nr; ++j) tile[i][j] = T(0);
+            }
+            for (std::size_t p = 0; p < k; ++p) {
+                for (std::size_t i = 0; i < mr; ++i) {
+                    for (std::size_t j = 0; j < nr; ++j) tile[i][j] += pa[i] * pb[j];
+                }
+                pa += mr;
+                pb += nr;
+            }
+#endif
+            for (std::size_t i = 0; i < m; ++i) {
+                for (std::size_t j = 0; j < n; ++j) {
+                    T& x = c(i, j);
+                    x = beta == T(0) ? alpha * tile[i][j] : alpha * tile[i][j] + beta * x;
+                }
+            }
+        }
+
+        // 已打包的 A 块（m 行）乘 B 面板（n 列）：外层 B 细条 从 L1 复用，内层 A 细条 从 L2 流过
+        template <class T, std::size_t Bytes>
+        E_MATH_ALWAYS_INLINE void macro_kernel(const T* pa, const T* pb, std::size_t m, std::size_t n, std::size_t k, strided<T> c, T alpha, T beta) {
+            constexpr std::size_t nr = 2 * Bytes / sizeof(T);
+            for (std::size_t j = 0; j < n; j += nr) {
+                for (std::size_t i = 0; i < m; i += mr) {
+                    micro_kernel<T, Bytes>(k, pa + i * k, pb + j * k, std::min(mr, m - i), std::min(nr, n - j), c.sub(i, j), alpha, beta);
+                }
+            }
+        }
+
+        template <class T>
+        struct gemm_kernel {
+            std::size_t nr;
+            void (*macro)(const T*, const T*, std::size_t, std::size_t, std::size_t, strided<T>, T, T);
+        };
+
+        struct gemm_kernel_set {
+            gemm_kernel<float> f32;
+            gemm_kernel<double> f64;
+        };
+
+#define E_MATH_GEMM_KERNELS_FOR(isa, target, bytes, T, name)                                                                   \
+        target void macro_##name##_##isa(const T* pa, const T* pb, std::size_t m, std::size_t n, std::size_t k, strided<T> c, T alpha, T beta) { \
+            macro_kernel<T, bytes>(pa, pb, m, n, k, c, alpha, beta);                                                             \
+        }
+
+#define E_MATH_GEMM_KERNELS(isa, target, bytes)                                                                                \
+        E_MATH_GEMM_KERNELS_FOR(isa, target, bytes, float, f32)                                                                \
+        E_MATH_GEMM_KERNELS_FOR(isa, target, bytes, double, f64)                                                               \
+        constexpr gemm_kernel_set gemm_kernels_##isa = {                                                                        \
+            {2 * (bytes) / sizeof(float), macro_f32_##isa},                                                                     \
+            {2 * (bytes) / sizeof(double), macro_f64_##isa},                                                                    \
+        };
+
+        E_MATH_GEMM_KERNELS(base, , detail::base_vec_bytes)
+#if E_MATH_X86
+        E_MATH_GEMM_KERNELS(avx2, E_MATH_TARGET_AVX2, 32)
+        E_MATH_GEMM_KERNELS(avx512, E_MATH_TARGET_AVX512, 64)
+#endif
+
+#undef E_MATH_GEMM_KERNELS
+#undef E_MATH_GEMM_KERNELS_FOR
+
+        const gemm_kernel_set& select_gemm_kernels() {
+#if E_MATH_X86
+            switch (detail::cpu_simd_level()) {
+                case detail::simd_level::avx512: return gemm_kernels_avx512;
+                case detail::simd_level::avx2: return gemm_kernels_avx2;
+                default: break;
+            }
+#endif
+            return gemm_kernels_base;
+        }
+
+        const gemm_kernel_set& g_gemm = select_gemm_kernels();
+
+        // ---------------- 打包 ----------------
+
+        // A 的 m x k 块 → 每 mr 行 一条，条内 按 k 排列、每个 k 连续 mr 个，不足 mr 行 补 0
+        template <class T>
+        void pack_a(strided<const T> a, std::size_t m, std::size_t k, T* dst) {
+            for (std::size_t i = 0; i < m; i += mr) {
+                std::size_t rows = std::min(mr, m - i);
+                for (std::size_t p = 0; p < k; ++p) {
+                    if (rows == mr && a.rs == 1) {
+                        std::memcpy(dst, &a(i, p), mr * sizeof(T));
+                    } else {
+                        for (std::size_t r = 0; r < mr; ++r) dst[r] = r < rows ? a(i + r, p) : T(0);
+                    }
+                    dst += mr;
+                }
+            }
+        }
+
+        // B 的 k x n 面板 → 每 nr 列 一条，条内 按 k 排列、每个 k 连续 nr 个，不足 nr 列 补 0
+        template <class T>
+        void pack_b(strided<const T> b, std::size_t k, std::size_t n, std::size_t nr, T* dst) {
+            for (std::size_t j = 0; j < n; j += nr) {
+                std::size_t cols = std::min(nr, n - j);
+                for (std::size_t p = 0; p < k; ++p) {
+                    if (cols == nr && b.cs == 1) {
+                        std::memcpy(dst, &b(p, j), nr * sizeof(T));
+                    } else {
+                        for (std::size_t q = 0; q < nr; ++q) dst[q] = q < cols ? b(p, j + q) : T(0);
+                    }
+                    dst += nr;
+                }
+            }
+        }
+
+        // k == 0 或 alpha == 0：C = beta * C
+        template <class T>
+        void scale(strided<T> c, std::size_t m, std::size_t n, T beta) {
+            for (std::size_t i = 0; i < m; ++i) {
+                for (std::size_t j = 0; j < n; ++j) {
+                    T& x = c(i, j);
+                    x = beta == T(0) ? T(0) : beta * x;
+                }
+            }
+        }
+
+        template <class T>
+        void check_view(const matrix_view<T>& v) {
+            std::size_t min_ld = v.order == layout::row_major ? v.cols : v.rows;
+            if (v.rows != 0 && v.cols != 0 && v.ld < min_ld) {
+                throw std::invalid_argument("e_math::gemm: leading dimension is too small");
+            }
+        }
+
+        template <class T>
+        void gemm_impl(matrix_view<const T> a, matrix_view<const T> b, matrix_view<T> c, T alpha, T beta, const gemm_kernel<T>& kernel) {
+            if (a.cols != b.rows || a.rows != c.rows || b.cols != c.cols) {
+                throw std::invalid_argument("e_math::gemm: matrix dimensions do not match");
+            }
+            check_view(a);
+            check_view(b);
+            check_view(c);
+
+            std::size_t m = c.rows;
+            std::size_t n = c.cols;
+            std::size_t k = a.cols;
+            strided<const T> sa = to_strided(a);
+            strided<const T> sb = to_strided(b);
+            strided<T> sc = to_strided(c);
+            if (m == 0 || n == 0) {
+                return;
+            }
+            if (k == 0 || alpha == T(0)) {
+                scale(sc, m, n, beta);
+                return;
+            }
+
+            // 微内核 按行 写 C；C 是列主序 时 改算 C^T = B^T * A^T，C^T 是行主序
+            if (sc.cs != 1) {
+                std::swap(m, n);
+                std::swap(sa, sb);
+                sa = sa.transposed();
+                sb = sb.transposed();
+                sc = sc.transposed();
+            }
+
+            const std::size_t nr = kernel.nr;
+            const std::size_t kb_max = std::min(k, kc);
+            const std::size_t nb_max = std::min(n, nc);
+            const std::size_t m_blocks = ceil_div(m, mc);
+            std::vector<T> pa(ceil_div(m, mr) * mr * kb_max);
+            std::vector<T> pb(ceil_div(nb_max, nr) * nr * kb_max);
+
+            // A 的行块 不够分给所有线程时，再把 B 面板 按列 切开
+            std::size_t threads = m * n * k < parallel_min_work ? 1 : max_threads();
+            std::size_t n_parts = std::max<std::size_t>(1, ceil_div(threads, m_blocks));
+
+            for (std::size_t jc = 0; jc < n; jc += nc) {
+                std::size_t nb = std::min(nc, n - jc);
+                std::size_t chunk = ceil_div(ceil_div(nb, n_parts), nr) * nr;
+                std::size_t parts = ceil_div(nb, chunk);
+
+                for (std::size_t pc = 0; pc < k; pc += kc) {
+                    std::size_t kb = std::min(kc, k - pc);
+                    // 第一个 k 块 用 beta，之后 累加到 C 上
+                    T beta_pc = pc == 0 ? beta : T(1);
+
+                    // 打包：A 的 各行块、B 的 各列段 互不依赖
+                    detail::parallel_for(m_blocks + parts, [&](std::size_t t) {
+                        if (t < m_blocks) {
+                            std::size_t i = t * mc;
+                            pack_a(sa.sub(i, pc), std::min(mc, m - i), kb, pa.data() + i * kb);
+                        } else {
+                            std::size_t j = (t - m_blocks) * chunk;
+                            pack_b(sb.sub(pc, jc + j), kb, std::min(chunk, nb - j), nr, pb.data() + j * kb);
+                        }
+                    });
+
+                    detail::parallel_for(m_blocks * parts, [&](std::size_t t) {
+                        std::size_t i = t / parts * mc;
+                        std::size_t j = t % parts * chunk;
+                        kernel.macro(pa.data() + i * kb, pb.data() + j * kb, std::min(mc, m - i), std::min(chunk, nb - j), kb, sc.sub(i, jc + j), alpha, beta_pc);
+                    });
+                }
+            }
+        }
+    }
+
+    void gemm(matrix_view<const float> a, matrix_view<const float> b, matrix_view<float> c, float alpha, float beta) {
+        gemm_impl(a, b, c, alpha, beta, g_gemm.f32);
+    }
+
+    void gemm(matrix_view<const double> a, matrix_view<const double> b, matrix_view<double> c, double alpha, double beta) {
+        gemm_impl(a, b, c, alpha, beta, g_gemm.f64);
+    }
+}
@@ -0,0 +1,259 @@
+#ifndef E_MATH_LANES_H
+#define E_MATH_LANES_H
+
+// 模块内部头文件：与指令集无关的 向量写法
+// 算法只写一次，放进 E_MATH_TARGET_xxx 的 函数里 强制内联，编译器就按该指令集展开
+//
+// lanes<T, Bytes>：固定 16 路，由 若干个 Bytes 宽的 原生向量 拼成
+//   每一路的运算顺序 在各指令集下 都相同，所以 逐路累加 的 浮点结果 与 指令集 无关
+// vec<T, Bytes>：一个原生向量，用于 跨路 移位 / 广播 的 算法，结果 可能与指令集有关
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define E_MATH_ALWAYS_INLINE inline __attribute__((always_inline))
+    // 寄存器数组 的 循环 必须完全展开，否则 数组 会落到栈上
+    #define E_MATH_UNROLL _Pragma("GCC unroll 16")
+#else
+    #define E_MATH_ALWAYS_INLINE __forceinline
+    #define E_MATH_UNROLL
+#endif
+
+namespace e_math::detail {
+    inline constexpr std::size_t lane_count = 16;
+
+    // 基础指令集 的 向量宽度：x86-64 的 SSE2、ARM 的 NEON 都是 16 字节
+    inline constexpr std::size_t base_vec_bytes = 16;
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define E_MATH_HAS_NATIVE_VEC 1
+
+    // ---------------- 原生向量 ----------------
+
+    template <class T, std::size_t Bytes>
+    struct vec_traits {
+        typedef T type __attribute__((vector_size(Bytes)));
+    };
+
+    template <class T, std::size_t Bytes>
+    using vec = typename vec_traits<T, Bytes>::type;
+
+    template <class T, std::size_t Bytes>
+    inline constexpr std::size_t vec_size = Bytes / sizeof(T);
+
+    template <std::size_t K, class V, std::size_t... I>
+    E_MATH_ALWAYS_INLINE V vec_shift_up_impl(V v, std::index_sequence<I...>) {
+        return __builtin_shufflevector(V{}, v, (I < K ? I : sizeof...(I) + I - K)...);
+    }
+
+    // 整体 向高位 移 K 路，低 K 路 补 0：r[i] = i < K ? 0 : v[i - K]
+    template <std::size_t K, class T, std::size_t Bytes>
+    E_MATH_ALWAYS_INLINE vec<T, Bytes> vec_shift_up(vec<T, Bytes> v) {
+        return vec_shift_up_impl<K>(v, std::make_index_sequence<vec_size<T, Bytes>>{});
+    }
+
+    template <class V, std::size_t... I>
+    E_MATH_ALWAYS_INLINE V vec_broadcast_last_impl(V v, std::index_sequence<I...>) {
+        return __builtin_shufflevector(v, v, ((void)I, sizeof...(I) - 1)...);
+    }
+
+    // 每一路 都取 v 的 最后一路
+    template <class T, std::size_t Bytes>
+    E_MATH_ALWAYS_INLINE vec<T, Bytes> vec_broadcast_last(vec<T, Bytes> v) {
+        return vec_broadcast_last_impl(v, std::make_index_sequence<vec_size<T, Bytes>>{});
+    }
+
+    // ---------------- 16 路 ----------------
+
+    // 整个 16 路 只用一个 超宽向量 时，GCC 会把 非原生宽度 拆成 逐元素 读写，所以拆成 原生向量 数组
+    template <class T, std::size_t Bytes>
+    struct lanes {
+        static constexpr std::size_t per_reg = vec_size<T, Bytes> < lane_count ? vec_size<T, Bytes> : lane_count;
+        static constexpr std::size_t regs = lane_count / per_reg;
+        using reg = vec<T, per_reg * sizeof(T)>;
+
+        reg r[regs];
+
+        E_MATH_ALWAYS_INLINE T operator[](std::size_t i) const { return r[i / per_reg][i % per_reg]; }
+    };
+
+    template <class T, std::size_t Bytes>
+    E_MATH_ALWAYS_INLINE lanes<T, Bytes> operator+(lanes<T, Bytes> a, lanes<T, Bytes> b) {
+        E_MATH_UNROLL
+        for (std::size_t i = 0; i < a.regs; ++i) a.r[i] = a.r[i] + b.r[i];
+        return a;
+    }
+
+    template <class T, std::size_t Bytes>
+    E_MATH_ALWAYS_INLINE lanes<T, Bytes> operator-(lanes<T, Bytes> a, lanes<T, Bytes> b) {
+        E_MATH_UNROLL
+        for (std::size_t i = 0; i < a.regs; ++i) a.r[i] = a.r[i] - b.r[i];
+        return a;
+    }
+
+    template <class T, std::size_t Bytes>
+    E_MATH_ALWAYS_INLINE lanes<T, Bytes> operator*(lanes<T, Bytes> a, lanes<T, Bytes> b) {
+        E_MATH_UNROLL
+        for (std::size_t i = 0; i < a.regs; ++i) a.r[i] = a.r[i] * b.r[i];
+        return a;
+    }
+
+    // NaN 传播：x 更小 或 x 是 NaN 时 取 x
+    // 分两步、每步 只用一次比较：两个掩码 相或 时，GCC 在 AVX-512 下 会退化成 逐元素
+    template <class T, std::size_t Bytes>
+    E_MATH_ALWAYS_INLINE lanes<T, Bytes> lanes_min(lanes<T, Bytes> acc, lanes<T, Bytes> x) {
+        E_MATH_UNROLL
+        for (std::size_t i = 0; i < acc.regs; ++i) {
+            auto t = (x.r[i] != x.r[i]) ? x.r[i] : acc.r[i];
+            acc.r[i] = (x.r[i] < t) ? x.r[i] : t;
+        }
+        return acc;
+    }
+
+    template <class T, std::size_t Bytes>
+    E_MATH_ALWAYS_INLINE lanes<T, Bytes> lanes_max(lanes<T, Bytes> acc, lanes<T, Bytes> x) {
+        E_MATH_UNROLL
+        for (std::size_t i = 0; i < acc.regs; ++i) {
+            auto t = (x.r[i] != x.r[i]) ? x.r[i] : acc.r[i];
+            acc.r[i] = (x.r[i] > t) ? x.r[i] : t;
+        }
+        return acc;
+    }
+
+    template <class T, std::size_t Bytes>
+    E_MATH_ALWAYS_INLINE lanes<T, Bytes> lanes_splat(T x) {
+        lanes<T, Bytes> v;
+        E_MATH_UNROLL
+        for (std::size_t i = 0; i < v.regs; ++i) {
+            for (std::size_t k = 0; k < v.per_reg; ++k) v.r[i][k] = x;
+        }
+        return v;
+    }
+
+    template <class T, std::size_t Bytes>
+    E_MATH_ALWAYS_INLINE lanes<T, Bytes> lanes_load(const T* p) {
+        lanes<T, Bytes> v;
+        E_MATH_UNROLL
+        for (std::size_t i = 0; i < v.regs; ++i) std::memcpy(&v.r[i], p + i * v.per_reg, sizeof(v.r[i]));
+        return v;
+    }
+
+    // 读 16 个 From，逐路 转换成 To（例如 int32 符号扩展 到 int64）
+    template <class To, std::size_t Bytes, class From>
+    E_MATH_ALWAYS_INLINE lanes<To, Bytes> lanes_load_convert(const From* p) {
+        using result = lanes<To, Bytes>;
+        result v;
+        E_MATH_UNROLL
+        for (std::size_t i = 0; i < result::regs; ++i) {
+            vec<From, result::per_reg * sizeof(From)> x;
+            std::memcpy(&x, p + i * result::per_reg, sizeof(x));
+            v.r[i] = __builtin_convertvector(x, typename result::reg);
+        }
+        return v;
+    }
+
+    template <class T, std::size_t Bytes>
+    E_MATH_ALWAYS_INLINE void lanes_store(T* p, lanes<T, Bytes> v) {
+        E_MATH_UNROLL
+        for (std::size_t i = 0; i < v.regs; ++i) std::memcpy(p + i * v.per_reg, &v.r[i], sizeof(v.r[i]));
+    }
+#else
+    // 没有 GCC 向量扩展 的 编译器（MSVC）：用数组模拟，交给 自动向量化；Bytes 不起作用
+    template <class T, std::size_t Bytes>
+    struct lanes {
+        T v[lane_count];
+
+        E_MATH_ALWAYS_INLINE T operator[](std::size_t i) const { return v[i]; }
+    };
+
+    template <class T, std::size_t Bytes>
+    E_MATH_ALWAYS_INLINE lanes<T, Bytes> operator+(lanes<T, Bytes> a, lanes<T, Bytes> b) {
+        for (std::size_t i = 0; i < lane_count; ++i) a.v[i] = a.v[i] + b.v[i];
+        return a;
+    }
+
+    template <class T, std::size_t Bytes>
+    E_MATH_ALWAYS_INLINE lanes<T, Bytes> operator-(lanes<T, Bytes> a, lanes<T, Bytes> b) {
+        for (std::size_t i = 0; i < lane_count; ++i) a.v[i] = a.v[i] - b.v[i];
+        return a;
+    }
+
+    template <class T, std::size_t Bytes>
+    E_MATH_ALWAYS_INLINE lanes<T, Bytes> operator*(lanes<T, Bytes> a, lanes<T, Bytes> b) {
+        for (std::size_t i = 0; i < lane_count; ++i) a.v[i] = a.v[i] * b.v[i];
+        return a;
+    }
+
+    template <class T, std::size_t Bytes>
+    E_MATH_ALWAYS_INLINE lanes<T, Bytes> lanes_min(lanes<T, Bytes> acc, lanes<T, Bytes> x) {
+        for (std::size_t i = 0; i < lane_count; ++i) acc.v[i] = (x.v[i] < acc.v[i] || x.v[i] != x.v[i]) ? x.v[i] : acc.v[i];
+        return acc;
+    }
+
+    template <class T, std::size_t Bytes>
+    E_MATH_ALWAYS_INLINE lanes<T, Bytes> lanes_max(lanes<T, Bytes> acc, lanes<T, Bytes> x) {
+        for (std::size_t i = 0; i < lane_count; ++i) acc.v[i] = (x.v[i] > acc.v[i] || x.v[i] != x.v[i]) ? x.v[i] : acc.v[i];
+        return acc;
+    }
+
+    template <class T, std::size_t Bytes>
+    E_MATH_ALWAYS_INLINE lanes<T, Bytes> lanes_splat(T x) {
+        lanes<T, Bytes> r;
+        for (std::size_t i = 0; i < lane_count; ++i) r.v[i] = x;
+        return r;
+    }
+
+    template <class T, std::size_t Bytes>
+    E_MATH_ALWAYS_INLINE lanes<T, Bytes> lanes_load(const T* p) {
+        lanes<T, Bytes> r;
+        std::memcpy(r.v, p, sizeof(r.v));
+        return r;
+    }
+
+    template <class To, std::size_t Bytes, class From>
+    E_MATH_ALWAYS_INLINE lanes<To, Bytes> lanes_load_convert(const From* p) {
+        lanes<To, Bytes> r;
+        for (std::size_t i = 0; i < lane_count; ++i) r.v[i] = static_cast<To>(p[i]);
+        return r;
+    }
+
+    template <class T, std::size_t Bytes>
+    E_MATH_ALWAYS_INLINE void lanes_store(T* p, lanes<T, Bytes> v) {
+        std::memcpy(p, v.v, sizeof(v.v));
+    }
+#endif
+
+    // 只读 count (< 16) 个，其余 lane 填 fill
+    template <class T, std::size_t Bytes>
+    E_MATH_ALWAYS_INLINE lanes<T, Bytes> lanes_load_partial(const T* p, std::size_t count, T fill) {
+        T buf[lane_count];
+        for (std::size_t i = 0; i < lane_count; ++i) buf[i] = fill;
+        std::memcpy(buf, p, count * sizeof(T));
+        return lanes_load<T, Bytes>(buf);
+    }
+
+    template <class To, std::size_t Bytes, class From>
+    E_MATH_ALWAYS_INLINE lanes<To, Bytes> lanes_load_convert_partial(const From* p, std::size_t count) {
+        From buf[lane_count] = {};
+        std::memcpy(buf, p, count * sizeof(From));
+        return lanes_load_convert<To, Bytes>(buf);
+    }
+
+    // 16 路 按固定的 树形顺序 求和
+    template <class T, std::size_t Bytes>
+    E_MATH_ALWAYS_INLINE T lanes_sum(lanes<T, Bytes> v) {
+        T a[lane_count];
+        lanes_store(a, v);
+        for (std::size_t w = lane_count / 2; w > 0; w /= 2) {
+            for (std::size_t i = 0; i < w; ++i) {
+                a[i] = a[i] + a[i + w];
+            }
+        }
+        return a[0];
+    }
+}
+
+#endif // E_MATH_LANES_H
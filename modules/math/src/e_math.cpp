@@ -1,7 +1,215 @@
 #include "e_math.hpp"
+#include "e_simd.hpp"
+
+#include <cstddef>
+#include <stdexcept>
 
 namespace e_math {
+    namespace {
+        template <class T>
+        using add_fn = void (*)(const T* a, const T* b, T* out, std::size_t n);
+
+        struct add_kernels {
+            add_fn<std::int32_t> i32;
+            add_fn<std::int64_t> i64;
+            add_fn<float> f32;
+            add_fn<double> f64;
+        };
+
+        template <class T>
+        void add_scalar(const T* a, const T* b, T* out, std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                // 和 SIMD 内核一样 按补码回绕
+                out[i] = add(a[i], b[i], wrap);
+            }
+        }
+
+#if E_MATH_X86
+        // ---------------- SSE2 ----------------
+
+        E_MATH_TARGET_SSE2 void add_i32_sse2(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t n) {
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+                __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_add_epi32(va, vb));
+            }
+            add_scalar(a + i, b + i, out + i, n - i);
+        }
+
+        E_MATH_TARGET_SSE2 void add_i64_sse2(const std::int64_t* a, const std::int64_t* b, std::int64_t* out, std::size_t n) {
+            std::size_t i = 0;
+            for (; i + 2 <= n; i += 2) {
+                __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+                __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_add_epi64(va, vb));
+            }
+            add_scalar(a + i, b + i, out + i, n - i);
+        }
+
+        E_MATH_TARGET_SSE2 void add_f32_sse2(const float* a, const float* b, float* out, std::size_t n) {
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+            }
+            add_scalar(a + i, b + i, out + i, n - i);
+        }
+
+        E_MATH_TARGET_SSE2 void add_f64_sse2(const double* a, const double* b, double* out, std::size_t n) {
+            std::size_t i = 0;
+            for (; i + 2 <= n; i += 2) {
+                _mm_storeu_pd(out + i, _mm_add_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+            }
+            add_scalar(a + i, b + i, out + i, n - i);
+        }
+
+        // ---------------- AVX2 ----------------
+
+        E_MATH_TARGET_AVX2 void add_i32_avx2(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t n) {
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+                __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_add_epi32(va, vb));
+            }
+            add_scalar(a + i, b + i, out + i, n - i);
+        }
+
+        E_MATH_TARGET_AVX2 void add_i64_avx2(const std::int64_t* a, const std::int64_t* b, std::int64_t* out, std::size_t n) {
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+                __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_add_epi64(va, vb));
+            }
+            add_scalar(a + i, b + i, out + i, n - i);
+        }
+
+        E_MATH_TARGET_AVX2 void add_f32_avx2(const float* a, const float* b, float* out, std::size_t n) {
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+            }
+            add_scalar(a + i, b + i, out + i, n - i);
+        }
+
+        E_MATH_TARGET_AVX2 void add_f64_avx2(const double* a, const double* b, double* out, std::size_t n) {
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+            }
+            add_scalar(a + i, b + i, out + i, n - i);
+        }
+
+        // ---------------- AVX-512，尾部用掩码读写，不再回落标量 ----------------
+
+        E_MATH_TARGET_AVX512 void add_i32_avx512(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t n) {
+            std::size_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                __m512i va = _mm512_loadu_si512(a + i);
+                __m512i vb = _mm512_loadu_si512(b + i);
+                _mm512_storeu_si512(out + i, _mm512_add_epi32(va, vb));
+            }
+            if (i < n) {
+                __mmask16 m = static_cast<__mmask16>((1u << (n - i)) - 1);
+                __m512i va = _mm512_maskz_loadu_epi32(m, a + i);
+                __m512i vb = _mm512_maskz_loadu_epi32(m, b + i);
+                _mm512_mask_storeu_epi32(out + i, m, _mm512_add_epi32(va, vb));
+            }
+        }
+
+        E_MATH_TARGET_AVX512 void add_i64_avx512(const std::int64_t* a, const std::int64_t* b, std::int64_t* out, std::size_t n) {
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                __m512i va = _mm512_loadu_si512(a + i);
+                __m512i vb = _mm512_loadu_si512(b + i);
+                _mm512_storeu_si512(out + i, _mm512_add_epi64(va, vb));
+            }
+            if (i < n) {
+                __mmask8 m = static_cast<__mmask8>((1u << (n - i)) - 1);
+                __m512i va = _mm512_maskz_loadu_epi64(m, a + i);
+                __m512i vb = _mm512_maskz_loadu_epi64(m, b + i);
+                _mm512_mask_storeu_epi64(out + i, m, _mm512_add_epi64(va, vb));
+            }
+        }
+
+        E_MATH_TARGET_AVX512 void add_f32_avx512(const float* a, const float* b, float* out, std::size_t n) {
+            std::size_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                _mm512_storeu_ps(out + i, _mm512_add_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+            }
+            if (i < n) {
+                __mmask16 m = static_cast<__mmask16>((1u << (n - i)) - 1);
+                __m512 r = _mm512_add_ps(_mm512_maskz_loadu_ps(m, a + i), _mm512_maskz_loadu_ps(m, b + i));
+                _mm512_mask_storeu_ps(out + i, m, r);
+            }
+        }
+
+        E_MATH_TARGET_AVX512 void add_f64_avx512(const double* a, const double* b, double* out, std::size_t n) {
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                _mm512_storeu_pd(out + i, _mm512_add_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)));
+            }
+            if (i < n) {
+                __mmask8 m = static_cast<__mmask8>((1u << (n - i)) - 1);
+                __m512d r = _mm512_add_pd(_mm512_maskz_loadu_pd(m, a + i), _mm512_maskz_loadu_pd(m, b + i));
+                _mm512_mask_storeu_pd(out + i, m, r);
+            }
+        }
+#endif // E_MATH_X86
+
+        add_kernels select_add_kernels() {
+#if E_MATH_X86
+            switch (detail::cpu_simd_level()) {
+                case detail::simd_level::avx512:
+                    return {add_i32_avx512, add_i64_avx512, add_f32_avx512, add_f64_avx512};
+                case detail::simd_level::avx2:
+                    return {add_i32_avx2, add_i64_avx2, add_f32_avx2, add_f64_avx2};
+                case detail::simd_level::sse2:
+                    return {add_i32_sse2, add_i64_sse2, add_f32_sse2, add_f64_sse2};
+                default:
+                    break;
+            }
+#endif
+            return {add_scalar<std::int32_t>, add_scalar<std::int64_t>, add_scalar<float>, add_scalar<double>};
+        }
+
+        // 命名空间作用域的常量，动态库加载时完成选择，调用时只剩一次间接跳转
+        const add_kernels g_add = select_add_kernels();
+
+        template <class T>
+        void check_sizes(std::span<const T> a, std::span<const T> b, std::span<T> out) {
+            if (a.size() != b.size() || a.size() != out.size()) {
+                throw std::invalid_argument("e_math::add: spans must have the same size");
+            }
+        }
+    }
+
     int add(int a, int b) {
-        return a + b;
+        return add(a, b, wrap);
+    }
+
+    void add(std::span<const std::int32_t> a, std::span<const std::int32_t> b, std::span<std::int32_t> out) {
+        check_sizes(a, b, out);
+        g_add.i32(a.data(), b.data(), out.data(), out.size());
+    }
+
+    void add(std::span<const std::int64_t> a, std::span<const std::int64_t> b, std::span<std::int64_t> out) {
+        check_sizes(a, b, out);
+        g_add.i64(a.data(), b.data(), out.data(), out.size());
+    }
+
+    void add(std::span<const float> a, std::span<const float> b, std::span<float> out) {
+        check_sizes(a, b, out);
+        g_add.f32(a.data(), b.data(), out.data(), out.size());
+    }
+
+    void add(std::span<const double> a, std::span<const double> b, std::span<double> out) {
+        check_sizes(a, b, out);
+        g_add.f64(a.data(), b.data(), out.data(), out.size());
+    }
+
+    const char* simd_isa() {
+        return detail::simd_level_name(detail::cpu_simd_level());
     }
 }
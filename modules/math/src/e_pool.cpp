@@ -0,0 +1,34 @@
+#include "e_pool.hpp"
+#include "e_parallel.hpp"
+
+#include "e_thread_pool.hpp"
+
+#include <atomic>
+#include <thread>
+
+namespace e_math::detail {
+    namespace {
+        std::atomic<unsigned> g_max_threads{0};
+
+        unsigned hardware_threads() {
+            unsigned n = std::thread::hardware_concurrency();
+            return n == 0 ? 1 : n;
+        }
+    }
+
+    void parallel_for(std::size_t tasks, void (*body)(void* context, std::size_t t), void* context) {
+        // 每个 任务 一块：任务 本身 已经 是 调用方 切好 的 大块
+        e_utils::thread_pool::global().parallel_for(0, tasks, [body, context](std::size_t t) { body(context, t); }, {.grain = 1, .max_threads = e_math::max_threads()});
+    }
+}
+
+namespace e_math {
+    void set_max_threads(unsigned n) {
+        detail::g_max_threads.store(n, std::memory_order_relaxed);
+    }
+
+    unsigned max_threads() {
+        unsigned n = detail::g_max_threads.load(std::memory_order_relaxed);
+        return n == 0 ? detail::hardware_threads() : n;
+    }
+}
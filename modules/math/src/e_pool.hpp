@@ -0,0 +1,28 @@
+#ifndef E_MATH_POOL_H
+#define E_MATH_POOL_H
+
+// 模块内部头文件：并行内核共用的 线程池，即 e_utils::thread_pool::global()（工作 窃取，hardware_concurrency() - 1 个 工作 线程）
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace e_math::detail {
+    // 对 [0, tasks) 的 每个下标 调用一次 fn，调用线程也参与，返回时全部完成
+    // 任务的切分 由调用方决定，与线程数无关，这样 结果 才能与线程数无关
+    // 同时 参与 的 线程 不超过 max_threads()，也 不超过 全局 池 的 线程 数 + 1
+    // 可以 并发调用，也 可以 在任务里 再次调用（嵌套 的 也 并行，等待 时 调用线程 帮着 执行 别的 任务）
+    // fn 抛出的 第一个异常 会在 调用线程 重新抛出
+    // fn 按 地址 传下去，不 包装 成 std::function；单线程 时 不 分配 内存
+    void parallel_for(std::size_t tasks, void (*body)(void* context, std::size_t t), void* context);
+
+    template <class F>
+    void parallel_for(std::size_t tasks, F&& fn) {
+        using body_type = std::remove_reference_t<F>;
+        parallel_for(
+            tasks, [](void* context, std::size_t t) { (*static_cast<body_type*>(context))(t); },
+            const_cast<void*>(static_cast<const void*>(std::addressof(fn))));
+    }
+}
+
+#endif // E_MATH_POOL_H
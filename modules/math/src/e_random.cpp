@@ -0,0 +1,411 @@
+#include "e_random.hpp"
+#include "e_lanes.hpp"
+#include "e_simd.hpp"
+#include "e_vmath.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+#include <type_traits>
+
+namespace e_math {
+    namespace {
+        std::uint64_t splitmix64(std::uint64_t& x) {
+            std::uint64_t z = (x += 0x9e3779b97f4a7c15);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+            return z ^ (z >> 31);
+        }
+    }
+
+    xoshiro256pp::xoshiro256pp(std::uint64_t seed) {
+        for (auto& s : s_) s = splitmix64(seed);
+    }
+
+    xoshiro256pp::xoshiro256pp(const std::array<std::uint64_t, 4>& state) : s_(state) {
+        if ((s_[0] | s_[1] | s_[2] | s_[3]) == 0) {
+            throw std::invalid_argument("e_math::xoshiro256pp: state must not be all zero");
+        }
+    }
+
+    namespace {
+        // 状态 乘以 转移矩阵 的 2^128 / 2^192 次幂
+        void apply_jump(xoshiro256pp& g, std::array<std::uint64_t, 4>& s, const std::uint64_t (&poly)[4]) {
+            std::array<std::uint64_t, 4> acc = {};
+            for (std::uint64_t word : poly) {
+                for (int b = 0; b < 64; ++b) {
+                    if (word & (std::uint64_t(1) << b)) {
+                        for (int i = 0; i < 4; ++i) acc[i] ^= s[i];
+                    }
+                    g();
+                }
+            }
+            s = acc;
+        }
+    }
+
+    void xoshiro256pp::jump() {
+        static constexpr std::uint64_t poly[4] = {0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c};
+        apply_jump(*this, s_, poly);
+    }
+
+    void xoshiro256pp::long_jump() {
+        static constexpr std::uint64_t poly[4] = {0x76e15d3efefdcbbf, 0xc5004e441c522fb3, 0x77710069854ee241, 0x39109bb02acbe635};
+        apply_jump(*this, s_, poly);
+    }
+
+    xoshiro256pp xoshiro256pp::stream(std::uint64_t seed, std::uint64_t index) {
+        xoshiro256pp g(seed);
+        for (std::uint64_t i = 0; i < index; ++i) g.jump();
+        return g;
+    }
+
+    void xoshiro256pp::fill(std::span<std::uint64_t> out) {
+        // 状态 放在 局部变量里，循环里 不用 反复 读写 内存
+        xoshiro256pp g = *this;
+        for (auto& x : out) x = g();
+        s_ = g.s_;
+    }
+
+    // ---------------- Philox4x32-10 ----------------
+
+    namespace {
+        constexpr std::uint32_t philox_m0 = 0xD2511F53;
+        constexpr std::uint32_t philox_m1 = 0xCD9E8D57;
+        constexpr std::uint32_t philox_w0 = 0x9E3779B9;
+        constexpr std::uint32_t philox_w1 = 0xBB67AE85;
+        constexpr int philox_rounds = 10;
+
+        // 从 first 开始 的 n 个 块，块 b 的 计数器 = {b 低 32 位, b 高 32 位, stream 低 32 位, stream 高 32 位}
+        using philox_fn = void (*)(std::uint64_t seed, std::uint64_t stream, std::uint64_t first, std::size_t n, std::uint32_t* out);
+
+        void philox_blocks_scalar(std::uint64_t seed, std::uint64_t stream, std::uint64_t first, std::size_t n, std::uint32_t* out) {
+            const std::array<std::uint32_t, 2> key = {static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)};
+            for (std::size_t i = 0; i < n; ++i) {
+                const std::uint64_t b = first + i;
+                auto r = philox4x32::block({static_cast<std::uint32_t>(b), static_cast<std::uint32_t>(b >> 32), static_cast<std::uint32_t>(stream),
+                                            static_cast<std::uint32_t>(stream >> 32)},
+                                           key);
+                std::copy(r.begin(), r.end(), out + 4 * i);
+            }
+        }
+
+#if E_MATH_HAS_NATIVE_VEC
+        // 每个 lane 的 低 32 位 乘以 m，得到 64 位 积
+        // x86 直接用 pmuludq：写成 普通乘法 时，GCC 会把 常数乘法 拆成 一串 移位 与 加减
+        template <class V>
+        E_MATH_ALWAYS_INLINE V mul_lo32(V a, std::uint32_t m) {
+            return a * m;
+        }
+
+    #if E_MATH_X86
+        using u64x2 = detail::vec<std::uint64_t, 16>;
+        using u64x4 = detail::vec<std::uint64_t, 32>;
+        using u64x8 = detail::vec<std::uint64_t, 64>;
+
+        template <>
+        E_MATH_ALWAYS_INLINE u64x2 mul_lo32(u64x2 a, std::uint32_t m) {
+            return (u64x2)_mm_mul_epu32((__m128i)a, _mm_set1_epi64x(m));
+        }
+
+        E_MATH_TARGET_AVX2 inline u64x4 mul_lo32_avx2(u64x4 a, std::uint32_t m) {
+            return (u64x4)_mm256_mul_epu32((__m256i)a, _mm256_set1_epi64x(m));
+        }
+
+        template <>
+        E_MATH_ALWAYS_INLINE u64x4 mul_lo32(u64x4 a, std::uint32_t m) {
+            return mul_lo32_avx2(a, m);
+        }
+
+// GCC 12 的 _mm512_mul_epu32 内部 用 _mm512_undefined_epi32，会报 -Wmaybe-uninitialized 误报
+    #if defined(__GNUC__) && !defined(__clang__)
+        #pragma GCC diagnostic push
+        #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    #endif
+        E_MATH_TARGET_AVX512 inline u64x8 mul_lo32_avx512(u64x8 a, std::uint32_t m) {
+            return (u64x8)_mm512_mul_epu32((__m512i)a, _mm512_set1_epi64(m));
+        }
+    #if defined(__GNUC__) && !defined(__clang__)
+        #pragma GCC diagnostic pop
+    #endif
+
+        template <>
+        E_MATH_ALWAYS_INLINE u64x8 mul_lo32(u64x8 a, std::uint32_t m) {
+            return mul_lo32_avx512(a, m);
+        }
+    #endif
+
+        // 每个 32 位 字 放在 一个 64 位 lane 里：32 x 32 -> 64 的 乘法 直接 得到 高低 两半
+        template <std::size_t Bytes>
+        E_MATH_ALWAYS_INLINE void philox_blocks_vec(std::uint64_t seed, std::uint64_t stream, std::uint64_t first, std::size_t n, std::uint32_t* out) {
+            using V = detail::vec<std::uint64_t, Bytes>;
+            constexpr std::size_t w = detail::vec_size<std::uint64_t, Bytes>;
+            constexpr std::uint64_t low = 0xffffffff;
+
+            std::size_t i = 0;
+            for (; i + w <= n; i += w) {
+                V c0, c1;
+                for (std::size_t j = 0; j < w; ++j) {
+                    const std::uint64_t b = first + i + j;
+                    c0[j] = b & low;
+                    c1[j] = b >> 32;
+                }
+                V c2 = V{} + (stream & low);
+                V c3 = V{} + (stream >> 32);
+                std::uint32_t k0 = static_cast<std::uint32_t>(seed);
+                std::uint32_t k1 = static_cast<std::uint32_t>(seed >> 32);
+
+                E_MATH_UNROLL
+                for (int r = 0; r < philox_rounds; ++r) {
+                    const V p0 = mul_lo32(c0, philox_m0);
+                    const V p1 = mul_lo32(c2, philox_m1);
+                    c0 = (p1 >> 32) ^ c1 ^ k0;
+                    c1 = p1 & low;
+                    c2 = (p0 >> 32) ^ c3 ^ k1;
+                    c3 = p0 & low;
+                    k0 += philox_w0;
+                    k1 += philox_w1;
+                }
+
+                std::uint32_t* o = out + 4 * i;
+                for (std::size_t j = 0; j < w; ++j) {
+                    o[4 * j + 0] = static_cast<std::uint32_t>(c0[j]);
+                    o[4 * j + 1] = static_cast<std::uint32_t>(c1[j]);
+                    o[4 * j + 2] = static_cast<std::uint32_t>(c2[j]);
+                    o[4 * j + 3] = static_cast<std::uint32_t>(c3[j]);
+                }
+            }
+            philox_blocks_scalar(seed, stream, first + i, n - i, out + 4 * i);
+        }
+
+    #define E_MATH_PHILOX_KERNEL(isa, target, bytes)                                                                             \
+        target void philox_blocks_##isa(std::uint64_t seed, std::uint64_t stream, std::uint64_t first, std::size_t n, std::uint32_t* out) { \
+            philox_blocks_vec<bytes>(seed, stream, first, n, out);                                                              \
+        }
+
+        E_MATH_PHILOX_KERNEL(base, , detail::base_vec_bytes)
+    #if E_MATH_X86
+        E_MATH_PHILOX_KERNEL(avx2, E_MATH_TARGET_AVX2, 32)
+        E_MATH_PHILOX_KERNEL(avx512, E_MATH_TARGET_AVX512, 64)
+    #endif
+
+    #undef E_MATH_PHILOX_KERNEL
+#endif
+
+        philox_fn select_philox_kernel() {
+#if E_MATH_HAS_NATIVE_VEC
+    #if E_MATH_X86
+            switch (detail::cpu_simd_level()) {
+                case detail::simd_level::avx512: return philox_blocks_avx512;
+                case detail::simd_level::avx2: return philox_blocks_avx2;
+                default: break;
+            }
+    #endif
+            return philox_blocks_base;
+#else
+            return philox_blocks_scalar;
+#endif
+        }
+
+        const philox_fn g_philox = select_philox_kernel();
+    }
+
+    std::array<std::uint32_t, 4> philox4x32::block(const std::array<std::uint32_t, 4>& counter, const std::array<std::uint32_t, 2>& key) {
+        std::uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+        std::uint32_t k0 = key[0], k1 = key[1];
+        for (int r = 0; r < philox_rounds; ++r) {
+            const std::uint64_t p0 = std::uint64_t(philox_m0) * c0;
+            const std::uint64_t p1 = std::uint64_t(philox_m1) * c2;
+            c0 = static_cast<std::uint32_t>(p1 >> 32) ^ c1 ^ k0;
+            c1 = static_cast<std::uint32_t>(p1);
+            c2 = static_cast<std::uint32_t>(p0 >> 32) ^ c3 ^ k1;
+            c3 = static_cast<std::uint32_t>(p0);
+            k0 += philox_w0;
+            k1 += philox_w1;
+        }
+        return {c0, c1, c2, c3};
+    }
+
+    philox4x32::philox4x32(std::uint64_t seed, std::uint64_t stream) : seed_(seed), stream_(stream) {}
+
+    philox4x32::result_type philox4x32::operator()() {
+        if (pos_ == 4) {
+            g_philox(seed_, stream_, next_block_++, 1, buf_.data());
+            pos_ = 0;
+        }
+        return buf_[pos_++];
+    }
+
+    void philox4x32::discard(std::uint64_t n) {
+        const std::uint64_t left = 4 - pos_;
+        if (n <= left) {
+            pos_ += static_cast<unsigned>(n);
+            return;
+        }
+        n -= left;
+        next_block_ += n / 4;
+        pos_ = 4;
+        if (n % 4 != 0) {
+            g_philox(seed_, stream_, next_block_++, 1, buf_.data());
+            pos_ = static_cast<unsigned>(n % 4);
+        }
+    }
+
+    void philox4x32::fill(std::span<std::uint32_t> out) {
+        std::size_t i = 0;
+        while (pos_ < 4 && i < out.size()) out[i++] = buf_[pos_++];
+
+        const std::size_t blocks = (out.size() - i) / 4;
+        g_philox(seed_, stream_, next_block_, blocks, out.data() + i);
+        next_block_ += blocks;
+        i += blocks * 4;
+
+        while (i < out.size()) out[i++] = (*this)();
+    }
+
+    // ---------------- 分布 ----------------
+
+    namespace {
+        // 每次 处理 这么多个 输出，原始位 与 中间结果 都在 栈上
+        constexpr std::size_t chunk = 512;
+
+        // n 个 [0, 1) 的 均匀数：float 取 24 位，double 取 53 位
+        // 先转成 有符号 整数 再转 浮点：有符号 转换 有 SIMD 指令，无符号 的 没有
+        template <class T>
+        void uniform01(xoshiro256pp& g, T* out, std::size_t n) {
+            std::uint64_t raw[chunk];
+            g.fill(std::span<std::uint64_t>(raw, n));
+            for (std::size_t i = 0; i < n; ++i) {
+                if constexpr (std::is_same_v<T, float>) {
+                    out[i] = static_cast<float>(static_cast<std::int32_t>(raw[i] >> 40)) * 0x1p-24f;
+                } else {
+                    out[i] = static_cast<double>(static_cast<std::int64_t>(raw[i] >> 11)) * 0x1p-53;
+                }
+            }
+        }
+
+        template <class T>
+        void uniform01(philox4x32& g, T* out, std::size_t n) {
+            std::uint32_t raw[2 * chunk];
+            if constexpr (std::is_same_v<T, float>) {
+                g.fill(std::span<std::uint32_t>(raw, n));
+                for (std::size_t i = 0; i < n; ++i) {
+                    out[i] = static_cast<float>(static_cast<std::int32_t>(raw[i] >> 8)) * 0x1p-24f;
+                }
+            } else {
+                g.fill(std::span<std::uint32_t>(raw, 2 * n));
+                for (std::size_t i = 0; i < n; ++i) {
+                    const std::uint64_t bits = (std::uint64_t(raw[2 * i + 1]) << 32) | raw[2 * i];
+                    out[i] = static_cast<double>(static_cast<std::int64_t>(bits >> 11)) * 0x1p-53;
+                }
+            }
+        }
+
+        template <class G, class T>
+        void uniform_impl(G& g, std::span<T> out, T lo, T hi) {
+            const T scale = hi - lo;
+            // lo + scale * u 可能 向上 舍入 到 hi，压到 hi 下面 的 一个 数
+            const T top = lo < hi ? std::nextafter(hi, lo) : lo;
+            for (std::size_t i = 0; i < out.size(); i += chunk) {
+                const std::size_t n = std::min(chunk, out.size() - i);
+                T* o = out.data() + i;
+                uniform01(g, o, n);
+                for (std::size_t k = 0; k < n; ++k) o[k] = std::min(lo + scale * o[k], top);
+            }
+        }
+
+        // Box-Muller：r = sqrt(-2 ln(1 - u1))，z0 = r cos(2 pi u2)，z1 = r sin(2 pi u2)
+        template <class G, class T>
+        void normal_impl(G& g, std::span<T> out, T mean, T stddev) {
+            constexpr std::size_t pairs = chunk / 2;
+            T u[chunk], r[pairs], c[pairs], s[pairs];
+            for (std::size_t i = 0; i < out.size(); i += chunk) {
+                const std::size_t n = std::min(chunk, out.size() - i);
+                const std::size_t m = (n + 1) / 2;
+                uniform01(g, u, 2 * m);
+
+                // u 的 前一半 当 半径，后一半 当 角度
+                for (std::size_t k = 0; k < m; ++k) r[k] = T(1) - u[k]; // (0, 1]
+                e_math::log(std::span<const T>(r, m), std::span<T>(r, m));
+                for (std::size_t k = 0; k < m; ++k) {
+                    r[k] = std::sqrt(T(-2) * r[k]) * stddev;
+                    u[m + k] *= T(2) * std::numbers::pi_v<T>;
+                }
+                e_math::cos(std::span<const T>(u + m, m), std::span<T>(c, m));
+                e_math::sin(std::span<const T>(u + m, m), std::span<T>(s, m));
+
+                T* o = out.data() + i;
+                for (std::size_t k = 0; k < n / 2; ++k) {
+                    o[2 * k] = mean + r[k] * c[k];
+                    o[2 * k + 1] = mean + r[k] * s[k];
+                }
+                if (n % 2 != 0) {
+                    o[n - 1] = mean + r[m - 1] * c[m - 1];
+                }
+            }
+        }
+
+        // -ln(1 - u) / lambda
+        template <class G, class T>
+        void exponential_impl(G& g, std::span<T> out, T lambda) {
+            const T scale = T(-1) / lambda;
+            for (std::size_t i = 0; i < out.size(); i += chunk) {
+                const std::size_t n = std::min(chunk, out.size() - i);
+                T* o = out.data() + i;
+                uniform01(g, o, n);
+                for (std::size_t k = 0; k < n; ++k) o[k] = T(1) - o[k];
+                e_math::log(std::span<const T>(o, n), std::span<T>(o, n));
+                for (std::size_t k = 0; k < n; ++k) o[k] *= scale;
+            }
+        }
+    }
+
+    void fill_uniform(xoshiro256pp& g, std::span<float> out, float lo, float hi) {
+        uniform_impl(g, out, lo, hi);
+    }
+
+    void fill_uniform(xoshiro256pp& g, std::span<double> out, double lo, double hi) {
+        uniform_impl(g, out, lo, hi);
+    }
+
+    void fill_uniform(philox4x32& g, std::span<float> out, float lo, float hi) {
+        uniform_impl(g, out, lo, hi);
+    }
+
+    void fill_uniform(philox4x32& g, std::span<double> out, double lo, double hi) {
+        uniform_impl(g, out, lo, hi);
+    }
+
+    void fill_normal(xoshiro256pp& g, std::span<float> out, float mean, float stddev) {
+        normal_impl(g, out, mean, stddev);
+    }
+
+    void fill_normal(xoshiro256pp& g, std::span<double> out, double mean, double stddev) {
+        normal_impl(g, out, mean, stddev);
+    }
+
+    void fill_normal(philox4x32& g, std::span<float> out, float mean, float stddev) {
+        normal_impl(g, out, mean, stddev);
+    }
+
+    void fill_normal(philox4x32& g, std::span<double> out, double mean, double stddev) {
+        normal_impl(g, out, mean, stddev);
+    }
+
+    void fill_exponential(xoshiro256pp& g, std::span<float> out, float lambda) {
+        exponential_impl(g, out, lambda);
+    }
+
+    void fill_exponential(xoshiro256pp& g, std::span<double> out, double lambda) {
+        exponential_impl(g, out, lambda);
+    }
+
+    void fill_exponential(philox4x32& g, std::span<float> out, float lambda) {
+        exponential_impl(g, out, lambda);
+    }
+
+    void fill_exponential(philox4x32& g, std::span<double> out, double lambda) {
+        exponential_impl(g, out, lambda);
+    }
+}
@@ -0,0 +1,335 @@
+#include "e_reduce.hpp"
+#include "e_lanes.hpp"
+#include "e_pool.hpp"
+#include "e_simd.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// 乘 与 加 要 分别 舍入：GCC 默认 的 -ffp-contract=fast 会在 AVX2 / AVX-512 内核里 合成 FMA，
+// dot 与 Kahan 补偿 的 结果 就 与 SSE2 不同了；别的文件（gemm、vmath）要 FMA，所以 只在 这里关
+#if defined(__clang__)
+    #pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+    #pragma GCC optimize("fp-contract=off")
+#elif defined(_MSC_VER)
+    #pragma fp_contract(off)
+#endif
+
+namespace e_math {
+    namespace {
+        using detail::lane_count;
+        using detail::lanes;
+
+        // 每块的元素数，lane_count 的倍数；块的划分 只取决于 长度
+        constexpr std::size_t block_size = 16384;
+        // 每个并行任务 处理的块数
+        constexpr std::size_t blocks_per_task = 8;
+
+        template <class T>
+        E_MATH_ALWAYS_INLINE T min_op(T acc, T x) {
+            return (x < acc || x != x) ? x : acc;
+        }
+
+        template <class T>
+        E_MATH_ALWAYS_INLINE T max_op(T acc, T x) {
+            return (x > acc || x != x) ? x : acc;
+        }
+
+        template <class T, std::size_t Bytes>
+        E_MATH_ALWAYS_INLINE void kahan_add(lanes<T, Bytes>& s, lanes<T, Bytes>& c, lanes<T, Bytes> x) {
+            lanes<T, Bytes> y = x - c;
+            lanes<T, Bytes> t = s + y;
+            c = (t - s) - y;
+            s = t;
+        }
+
+        // ---------------- 块内核：只写一次，在各指令集的 包装函数里 按该指令集的 向量宽度 展开 ----------------
+
+        template <std::size_t Bytes, class T>
+        E_MATH_ALWAYS_INLINE std::uint64_t sum_block_int(const T* p, std::size_t n) {
+            // 先 符号扩展 到 int64，再按 uint64 累加，回绕有定义
+            using S = std::make_signed_t<T>;
+            lanes<std::uint64_t, Bytes> s = detail::lanes_splat<std::uint64_t, Bytes>(0);
+            std::size_t i = 0;
+            for (; i + lane_count <= n; i += lane_count) {
+                s = s + detail::lanes_load_convert<std::uint64_t, Bytes>(reinterpret_cast<const S*>(p + i));
+            }
+            if (i < n) {
+                s = s + detail::lanes_load_convert_partial<std::uint64_t, Bytes>(reinterpret_cast<const S*>(p + i), n - i);
+            }
+            return detail::lanes_sum(s);
+        }
+
+        template <std::size_t Bytes, class T>
+        E_MATH_ALWAYS_INLINE T sum_block_float(const T* p, std::size_t n) {
+            lanes<T, Bytes> s = detail::lanes_splat<T, Bytes>(0);
+            lanes<T, Bytes> c = s;
+            std::size_t i = 0;
+            for (; i + lane_count <= n; i += lane_count) {
+                kahan_add(s, c, detail::lanes_load<T, Bytes>(p + i));
+            }
+            if (i < n) {
+                kahan_add(s, c, detail::lanes_load_partial<T, Bytes>(p + i, n - i, T(0)));
+            }
+            return detail::lanes_sum(s - c);
+        }
+
+        template <std::size_t Bytes, class T>
+        E_MATH_ALWAYS_INLINE T dot_block(const T* a, const T* b, std::size_t n) {
+            lanes<T, Bytes> s = detail::lanes_splat<T, Bytes>(0);
+            lanes<T, Bytes> c = s;
+            std::size_t i = 0;
+            for (; i + lane_count <= n; i += lane_count) {
+                kahan_add(s, c, detail::lanes_load<T, Bytes>(a + i) * detail::lanes_load<T, Bytes>(b + i));
+            }
+            if (i < n) {
+                kahan_add(s, c, detail::lanes_load_partial<T, Bytes>(a + i, n - i, T(0)) * detail::lanes_load_partial<T, Bytes>(b + i, n - i, T(0)));
+            }
+            return detail::lanes_sum(s - c);
+        }
+
+        // n >= 1；尾部用 p[0] 填充，对 min / max 没有影响
+        template <std::size_t Bytes, class T>
+        E_MATH_ALWAYS_INLINE T min_block(const T* p, std::size_t n) {
+            lanes<T, Bytes> m = detail::lanes_splat<T, Bytes>(p[0]);
+            std::size_t i = 0;
+            for (; i + lane_count <= n; i += lane_count) {
+                m = detail::lanes_min(m, detail::lanes_load<T, Bytes>(p + i));
+            }
+            if (i < n) {
+                m = detail::lanes_min(m, detail::lanes_load_partial<T, Bytes>(p + i, n - i, p[0]));
+            }
+            T r = m[0];
+            for (std::size_t k = 1; k < lane_count; ++k) {
+                r = min_op<T>(r, m[k]);
+            }
+            return r;
+        }
+
+        template <std::size_t Bytes, class T>
+        E_MATH_ALWAYS_INLINE T max_block(const T* p, std::size_t n) {
+            lanes<T, Bytes> m = detail::lanes_splat<T, Bytes>(p[0]);
+            std::size_t i = 0;
+            for (; i + lane_count <= n; i += lane_count) {
+                m = detail::lanes_max(m, detail::lanes_load<T, Bytes>(p + i));
+            }
+            if (i < n) {
+                m = detail::lanes_max(m, detail::lanes_load_partial<T, Bytes>(p + i, n - i, p[0]));
+            }
+            T r = m[0];
+            for (std::size_t k = 1; k < lane_count; ++k) {
+                r = max_op<T>(r, m[k]);
+            }
+            return r;
+        }
+
+        // ---------------- 各指令集的 实例 ----------------
+
+        struct reduce_kernels {
+            std::uint64_t (*sum_i32)(const std::int32_t*, std::size_t);
+            std::uint64_t (*sum_i64)(const std::int64_t*, std::size_t);
+            float (*sum_f32)(const float*, std::size_t);
+            double (*sum_f64)(const double*, std::size_t);
+
+            std::int32_t (*min_i32)(const std::int32_t*, std::size_t);
+            std::int64_t (*min_i64)(const std::int64_t*, std::size_t);
+            float (*min_f32)(const float*, std::size_t);
+            double (*min_f64)(const double*, std::size_t);
+
+            std::int32_t (*max_i32)(const std::int32_t*, std::size_t);
+            std::int64_t (*max_i64)(const std::int64_t*, std::size_t);
+            float (*max_f32)(const float*, std::size_t);
+            double (*max_f64)(const double*, std::size_t);
+
+            float (*dot_f32)(const float*, const float*, std::size_t);
+            double (*dot_f64)(const double*, const double*, std::size_t);
+        };
+
+#define E_MATH_REDUCE_KERNELS(isa, target, B)                                                                                \
+        target std::uint64_t sum_i32_##isa(const std::int32_t* p, std::size_t n) { return sum_block_int<B>(p, n); }            \
+        target std::uint64_t sum_i64_##isa(const std::int64_t* p, std::size_t n) { return sum_block_int<B>(p, n); }            \
+        target float sum_f32_##isa(const float* p, std::size_t n) { return sum_block_float<B>(p, n); }                         \
+        target double sum_f64_##isa(const double* p, std::size_t n) { return sum_block_float<B>(p, n); }                       \
+        target std::int32_t min_i32_##isa(const std::int32_t* p, std::size_t n) { return min_block<B>(p, n); }                 \
+        target std::int64_t min_i64_##isa(const std::int64_t* p, std::size_t n) { return min_block<B>(p, n); }                 \
+        target float min_f32_##isa(const float* p, std::size_t n) { return min_block<B>(p, n); }                               \
+        target double min_f64_##isa(const double* p, std::size_t n) { return min_block<B>(p, n); }                             \
+        target std::int32_t max_i32_##isa(const std::int32_t* p, std::size_t n) { return max_block<B>(p, n); }                 \
+        target std::int64_t max_i64_##isa(const std::int64_t* p, std::size_t n) { return max_block<B>(p, n); }                 \
+        target float max_f32_##isa(const float* p, std::size_t n) { return max_block<B>(p, n); }                               \
+        target double max_f64_##isa(const double* p, std::size_t n) { return max_block<B>(p, n); }                             \
+        target float dot_f32_##isa(const float* a, const float* b, std::size_t n) { return dot_block<B>(a, b, n); }            \
+        target double dot_f64_##isa(const double* a, const double* b, std::size_t n) { return dot_block<B>(a, b, n); }         \
+        constexpr reduce_kernels reduce_kernels_##isa = {                                                                    \
+            sum_i32_##isa, sum_i64_##isa, sum_f32_##isa, sum_f64_##isa,                                                      \
+            min_i32_##isa, min_i64_##isa, min_f32_##isa, min_f64_##isa,                                                      \
+            max_i32_##isa, max_i64_##isa, max_f32_##isa, max_f64_##isa,                                                      \
+            dot_f32_##isa, dot_f64_##isa,                                                                                    \
+        };
+
+        // 基础指令集（x86-64 上即 SSE2）
+        E_MATH_REDUCE_KERNELS(base, , detail::base_vec_bytes)
+#if E_MATH_X86
+        E_MATH_REDUCE_KERNELS(avx2, E_MATH_TARGET_AVX2, 32)
+        E_MATH_REDUCE_KERNELS(avx512, E_MATH_TARGET_AVX512, 64)
+#endif
+
+#undef E_MATH_REDUCE_KERNELS
+
+        const reduce_kernels& select_reduce_kernels() {
+#if E_MATH_X86
+            switch (detail::cpu_simd_level()) {
+                case detail::simd_level::avx512: return reduce_kernels_avx512;
+                case detail::simd_level::avx2: return reduce_kernels_avx2;
+                default: break;
+            }
+#endif
+            return reduce_kernels_base;
+        }
+
+        const reduce_kernels& g_reduce = select_reduce_kernels();
+
+        // ---------------- 分块 + 并行 + 固定顺序合并 ----------------
+
+        template <class P, class C>
+        P combine_pairwise(const std::vector<P>& partials, std::size_t first, std::size_t count, C combine) {
+            if (count == 1) {
+                return partials[first];
+            }
+            std::size_t half = count / 2;
+            return combine(combine_pairwise(partials, first, half, combine), combine_pairwise(partials, first + half, count - half, combine));
+        }
+
+        // block(begin, count) 计算一块的部分结果，combine 合并两个部分结果；n >= 1
+        template <class P, class B, class C>
+        P reduce_blocks(std::size_t n, B block, C combine) {
+            std::size_t blocks = (n + block_size - 1) / block_size;
+            if (blocks == 1) {
+                return block(0, n);
+            }
+
+            std::vector<P> partials(blocks);
+            std::size_t tasks = (blocks + blocks_per_task - 1) / blocks_per_task;
+            detail::parallel_for(tasks, [&](std::size_t t) {
+                std::size_t last = std::min(blocks, (t + 1) * blocks_per_task);
+                for (std::size_t b = t * blocks_per_task; b < last; ++b) {
+                    std::size_t begin = b * block_size;
+                    partials[b] = block(begin, std::min(block_size, n - begin));
+                }
+            });
+            return combine_pairwise(partials, 0, blocks, combine);
+        }
+
+        template <class P, class T>
+        P reduce_sum_impl(std::span<const T> v, P (*kernel)(const T*, std::size_t)) {
+            if (v.empty()) {
+                return P(0);
+            }
+            const T* p = v.data();
+            return reduce_blocks<P>(
+                v.size(),
+                [=](std::size_t begin, std::size_t count) { return kernel(p + begin, count); },
+                [](P a, P b) { return P(a + b); });
+        }
+
+        template <class T>
+        T reduce_min_impl(std::span<const T> v, T (*kernel)(const T*, std::size_t)) {
+            if (v.empty()) {
+                throw std::invalid_argument("e_math::reduce_min: empty input");
+            }
+            const T* p = v.data();
+            return reduce_blocks<T>(
+                v.size(),
+                [=](std::size_t begin, std::size_t count) { return kernel(p + begin, count); },
+                [](T a, T b) { return min_op(a, b); });
+        }
+
+        template <class T>
+        T reduce_max_impl(std::span<const T> v, T (*kernel)(const T*, std::size_t)) {
+            if (v.empty()) {
+                throw std::invalid_argument("e_math::reduce_max: empty input");
+            }
+            const T* p = v.data();
+            return reduce_blocks<T>(
+                v.size(),
+                [=](std::size_t begin, std::size_t count) { return kernel(p + begin, count); },
+                [](T a, T b) { return max_op(a, b); });
+        }
+
+        template <class T>
+        T reduce_dot_impl(std::span<const T> a, std::span<const T> b, T (*kernel)(const T*, const T*, std::size_t)) {
+            if (a.size() != b.size()) {
+                throw std::invalid_argument("e_math::reduce_dot: spans must have the same size");
+            }
+            if (a.empty()) {
+                return T(0);
+            }
+            const T* pa = a.data();
+            const T* pb = b.data();
+            return reduce_blocks<T>(
+                a.size(),
+                [=](std::size_t begin, std::size_t count) { return kernel(pa + begin, pb + begin, count); },
+                [](T x, T y) { return x + y; });
+        }
+    }
+
+    std::int64_t reduce_sum(std::span<const std::int32_t> v) {
+        return static_cast<std::int64_t>(reduce_sum_impl<std::uint64_t>(v, g_reduce.sum_i32));
+    }
+
+    std::int64_t reduce_sum(std::span<const std::int64_t> v) {
+        return static_cast<std::int64_t>(reduce_sum_impl<std::uint64_t>(v, g_reduce.sum_i64));
+    }
+
+    float reduce_sum(std::span<const float> v) {
+        return reduce_sum_impl<float>(v, g_reduce.sum_f32);
+    }
+
+    double reduce_sum(std::span<const double> v) {
+        return reduce_sum_impl<double>(v, g_reduce.sum_f64);
+    }
+
+    std::int32_t reduce_min(std::span<const std::int32_t> v) {
+        return reduce_min_impl(v, g_reduce.min_i32);
+    }
+
+    std::int64_t reduce_min(std::span<const std::int64_t> v) {
+        return reduce_min_impl(v, g_reduce.min_i64);
+    }
+
+    float reduce_min(std::span<const float> v) {
+        return reduce_min_impl(v, g_reduce.min_f32);
+    }
+
+    double reduce_min(std::span<const double> v) {
+        return reduce_min_impl(v, g_reduce.min_f64);
+    }
+
+    std::int32_t reduce_max(std::span<const std::int32_t> v) {
+        return reduce_max_impl(v, g_reduce.max_i32);
+    }
+
+    std::int64_t reduce_max(std::span<const std::int64_t> v) {
+        return reduce_max_impl(v, g_reduce.max_i64);
+    }
+
+    float reduce_max(std::span<const float> v) {
+        return reduce_max_impl(v, g_reduce.max_f32);
+    }
+
+    double reduce_max(std::span<const double> v) {
+        return reduce_max_impl(v, g_reduce.max_f64);
+    }
+
+    float reduce_dot(std::span<const float> a, std::span<const float> b) {
+        return reduce_dot_impl(a, b, g_reduce.dot_f32);
+    }
+
+    double reduce_dot(std::span<const double> a, std::span<const double> b) {
+        return reduce_dot_impl(a, b, g_reduce.dot_f64);
+    }
+}
@@ -0,0 +1,239 @@
+#include "e_scan.hpp"
+#include "e_lanes.hpp"
+#include "e_parallel.hpp"
+#include "e_pool.hpp"
+#include "e_simd.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace e_math {
+    namespace {
+        using detail::lane_count;
+        using detail::lanes;
+
+        // 分块大小 只取决于长度，与线程数无关
+        constexpr std::size_t block_size = 16384;
+        constexpr std::size_t blocks_per_task = 4;
+
+#if E_MATH_HAS_NATIVE_VEC
+        using detail::vec;
+
+        // 寄存器内 前缀和：log2(路数) 次 移位相加
+        template <class T, std::size_t Bytes>
+        E_MATH_ALWAYS_INLINE vec<T, Bytes> vec_prefix(vec<T, Bytes> x) {
+            constexpr std::size_t n = detail::vec_size<T, Bytes>;
+            if constexpr (n > 1) x = x + detail::vec_shift_up<1, T, Bytes>(x);
+            if constexpr (n > 2) x = x + detail::vec_shift_up<2, T, Bytes>(x);
+            if constexpr (n > 4) x = x + detail::vec_shift_up<4, T, Bytes>(x);
+            if constexpr (n > 8) x = x + detail::vec_shift_up<8, T, Bytes>(x);
+            return x;
+        }
+#endif
+
+        // 块内 带进位 扫描，返回 块末尾的 inclusive 值（下一块的进位）
+        // 每个向量 先读后写，所以 out == in 时 也正确
+        template <class T, bool Inclusive, std::size_t Bytes>
+        E_MATH_ALWAYS_INLINE T scan_block(const T* in, T* out, std::size_t n, T carry) {
+            std::size_t i = 0;
+#if E_MATH_HAS_NATIVE_VEC
+            using V = vec<T, Bytes>;
+            constexpr std::size_t width = detail::vec_size<T, Bytes>;
+
+            V c;
+            for (std::size_t k = 0; k < width; ++k) {
+                c[k] = carry;
+            }
+            for (; i + width <= n; i += width) {
+                V x;
+                std::memcpy(&x, in + i, sizeof(V));
+                V local = vec_prefix<T, Bytes>(x);
+                V incl = c + local;
+                V r = incl;
+                if constexpr (!Inclusive) {
+                    r = c + detail::vec_shift_up<1, T, Bytes>(local);
+                }
+                std::memcpy(out + i, &r, sizeof(V));
+                c = detail::vec_broadcast_last<T, Bytes>(incl);
+            }
+            carry = c[0];
+#endif
+            for (; i < n; ++i) {
+                T x = in[i];
+                if constexpr (Inclusive) {
+                    carry = carry + x;
+                    out[i] = carry;
+                } else {
+                    out[i] = carry;
+                    carry = carry + x;
+                }
+            }
+            return carry;
+        }
+
+        // 第一遍 只求块的和；任何固定的 求和顺序 都可以，这里 16 路 + 树形合并
+        template <class T, std::size_t Bytes>
+        E_MATH_ALWAYS_INLINE T sum_block(const T* p, std::size_t n) {
+            lanes<T, Bytes> s = detail::lanes_splat<T, Bytes>(0);
+            std::size_t i = 0;
+            for (; i + lane_count <= n; i += lane_count) {
+                s = s + detail::lanes_load<T, Bytes>(p + i);
+            }
+            if (i < n) {
+                s = s + detail::lanes_load_partial<T, Bytes>(p + i, n - i, T(0));
+            }
+            return detail::lanes_sum(s);
+        }
+
+        template <class T>
+        struct scan_kernels {
+            T (*sum)(const T*, std::size_t);
+            T (*inclusive)(const T*, T*, std::size_t, T);
+            T (*exclusive)(const T*, T*, std::size_t, T);
+        };
+
+        struct scan_kernel_set {
+            // 整数 用 无符号 计算，回绕有定义
+            scan_kernels<std::uint32_t> u32;
+            scan_kernels<std::uint64_t> u64;
+            scan_kernels<float> f32;
+            scan_kernels<double> f64;
+        };
+
+#define E_MATH_SCAN_KERNELS_FOR(isa, target, bytes, T, name)                                                                  \
+        target T sum_##name##_##isa(const T* p, std::size_t n) { return sum_block<T, bytes>(p, n); }                                  \
+        target T incl_##name##_##isa(const T* in, T* out, std::size_t n, T c) { return scan_block<T, true, bytes>(in, out, n, c); }   \
+        target T excl_##name##_##isa(const T* in, T* out, std::size_t n, T c) { return scan_block<T, false, bytes>(in, out, n, c); }
+
+#define E_MATH_SCAN_KERNELS(isa, target, bytes)                                                                               \
+        E_MATH_SCAN_KERNELS_FOR(isa, target, bytes, std::uint32_t, u32)                                                       \
+        E_MATH_SCAN_KERNELS_FOR(isa, target, bytes, std::uint64_t, u64)                                                       \
+        E_MATH_SCAN_KERNELS_FOR(isa, target, bytes, float, f32)                                                               \
+        E_MATH_SCAN_KERNELS_FOR(isa, target, bytes, double, f64)                                                              \
+        constexpr scan_kernel_set scan_kernels_##isa = {                                                                       \
+            {sum_u32_##isa, incl_u32_##isa, excl_u32_##isa},                                                                   \
+            {sum_u64_##isa, incl_u64_##isa, excl_u64_##isa},                                                                   \
+            {sum_f32_##isa, incl_f32_##isa, excl_f32_##isa},                                                                   \
+            {sum_f64_##isa, incl_f64_##isa, excl_f64_##isa},                                                                   \
+        };
+
+        E_MATH_SCAN_KERNELS(base, , detail::base_vec_bytes)
+#if E_MATH_X86
+        E_MATH_SCAN_KERNELS(avx2, E_MATH_TARGET_AVX2, 32)
+        E_MATH_SCAN_KERNELS(avx512, E_MATH_TARGET_AVX512, 64)
+#endif
+
+#undef E_MATH_SCAN_KERNELS
+#undef E_MATH_SCAN_KERNELS_FOR
+
+        const scan_kernel_set& select_scan_kernels() {
+#if E_MATH_X86
+            switch (detail::cpu_simd_level()) {
+                case detail::simd_level::avx512: return scan_kernels_avx512;
+                case detail::simd_level::avx2: return scan_kernels_avx2;
+                default: break;
+            }
+#endif
+            return scan_kernels_base;
+        }
+
+        const scan_kernel_set& g_scan = select_scan_kernels();
+
+        template <class T>
+        void scan_impl(const T* in, T* out, std::size_t n, T init, bool inclusive, const scan_kernels<T>& k) {
+            auto scan = inclusive ? k.inclusive : k.exclusive;
+            std::size_t blocks = (n + block_size - 1) / block_size;
+            // 整数加法 满足结合律，单线程时 一遍扫描 与 两遍 结果相同
+            if (blocks <= 1 || (std::is_integral_v<T> && max_threads() == 1)) {
+                scan(in, out, n, init);
+                return;
+            }
+
+            std::size_t tasks = (blocks + blocks_per_task - 1) / blocks_per_task;
+            auto for_each_block = [&](auto&& fn) {
+                detail::parallel_for(tasks, [&](std::size_t t) {
+                    std::size_t last = std::min(blocks, (t + 1) * blocks_per_task);
+                    for (std::size_t b = t * blocks_per_task; b < last; ++b) {
+                        std::size_t begin = b * block_size;
+                        fn(b, begin, std::min(block_size, n - begin));
+                    }
+                });
+            };
+
+            // 第一遍：各块之和
+            std::vector<T> offsets(blocks);
+            for_each_block([&](std::size_t b, std::size_t begin, std::size_t count) {
+                offsets[b] = k.sum(in + begin, count);
+            });
+
+            // 块之和 的 exclusive scan，即 各块的 进位
+            T carry = init;
+            for (auto& o : offsets) {
+                T s = o;
+                o = carry;
+                carry = carry + s;
+            }
+
+            // 第二遍：带进位 扫描各块
+            for_each_block([&](std::size_t b, std::size_t begin, std::size_t count) {
+                scan(in + begin, out + begin, count, offsets[b]);
+            });
+        }
+
+        template <class T>
+        void check_sizes(std::span<const T> in, std::span<T> out) {
+            if (in.size() != out.size()) {
+                throw std::invalid_argument("e_math::scan: spans must have the same size");
+            }
+        }
+
+        // int32 / int64 按同宽度的 无符号类型 计算（有符号 与 无符号 可以互相别名访问）
+        template <class T, class U>
+        void scan_int(std::span<const T> in, std::span<T> out, T init, bool inclusive, const scan_kernels<U>& k) {
+            check_sizes(in, out);
+            scan_impl(reinterpret_cast<const U*>(in.data()), reinterpret_cast<U*>(out.data()), in.size(), static_cast<U>(init), inclusive, k);
+        }
+
+        template <class T>
+        void scan_float(std::span<const T> in, std::span<T> out, T init, bool inclusive, const scan_kernels<T>& k) {
+            check_sizes(in, out);
+            scan_impl(in.data(), out.data(), in.size(), init, inclusive, k);
+        }
+    }
+
+    void inclusive_scan(std::span<const std::int32_t> in, std::span<std::int32_t> out) {
+        scan_int(in, out, 0, true, g_scan.u32);
+    }
+
+    void inclusive_scan(std::span<const std::int64_t> in, std::span<std::int64_t> out) {
+        scan_int(in, out, std::int64_t(0), true, g_scan.u64);
+    }
+
+    void inclusive_scan(std::span<const float> in, std::span<float> out) {
+        scan_float(in, out, 0.0f, true, g_scan.f32);
+    }
+
+    void inclusive_scan(std::span<const double> in, std::span<double> out) {
+        scan_float(in, out, 0.0, true, g_scan.f64);
+    }
+
+    void exclusive_scan(std::span<const std::int32_t> in, std::span<std::int32_t> out, std::int32_t init) {
+        scan_int(in, out, init, false, g_scan.u32);
+    }
+
+    void exclusive_scan(std::span<const std::int64_t> in, std::span<std::int64_t> out, std::int64_t init) {
+        scan_int(in, out, init, false, g_scan.u64);
+    }
+
+    void exclusive_scan(std::span<const float> in, std::span<float> out, float init) {
+        scan_float(in, out, init, false, g_scan.f32);
+    }
+
+    void exclusive_scan(std::span<const double> in, std::span<double> out, double init) {
+        scan_float(in, out, init, false, g_scan.f64);
+    }
+}
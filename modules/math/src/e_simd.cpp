@@ -0,0 +1,100 @@
+#include "e_simd.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+#if E_MATH_X86 && defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+#endif
+
+namespace e_math::detail {
+    namespace {
+#if E_MATH_X86 && defined(_MSC_VER) && !defined(__clang__)
+        simd_level detect() {
+            int r[4];
+            __cpuid(r, 0);
+            int max_leaf = r[0];
+
+            __cpuid(r, 1);
+            bool sse2 = (r[3] >> 26) & 1;
+            bool fma = (r[2] >> 12) & 1;
+            bool osxsave = (r[2] >> 27) & 1;
+            bool avx = (r[2] >> 28) & 1;
+            if (!sse2) {
+                return simd_level::scalar;
+            }
+            if (!osxsave || !avx || !fma || max_leaf < 7) {
+                return simd_level::sse2;
+            }
+
+            // XCR0: bit 1/2 = XMM/YMM 状态，bit 5/6/7 = AVX-512 状态
+            unsigned long long xcr0 = _xgetbv(0);
+            if ((xcr0 & 0x6) != 0x6) {
+                return simd_level::sse2;
+            }
+
+            __cpuidex(r, 7, 0);
+            bool avx2 = (r[1] >> 5) & 1;
+            if (!avx2) {
+                return simd_level::sse2;
+            }
+
+            bool avx512 = ((r[1] >> 16) & 1)  // F
+                && ((r[1] >> 17) & 1)         // DQ
+                && ((r[1] >> 30) & 1)         // BW
+                && ((r[1] >> 31) & 1)         // VL
+                && (xcr0 & 0xe0) == 0xe0;
+            return avx512 ? simd_level::avx512 : simd_level::avx2;
+        }
+#elif E_MATH_X86
+        simd_level detect() {
+            // __builtin_cpu_supports 已经检查了 OS 是否保存 YMM / ZMM 状态
+            __builtin_cpu_init();
+            if (!__builtin_cpu_supports("sse2")) {
+                return simd_level::scalar;
+            }
+            if (!__builtin_cpu_supports("avx2") || !__builtin_cpu_supports("fma")) {
+                return simd_level::sse2;
+            }
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")
+                && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl")) {
+                return simd_level::avx512;
+            }
+            return simd_level::avx2;
+        }
+#else
+        simd_level detect() {
+            return simd_level::scalar;
+        }
+#endif
+
+        simd_level apply_env_cap(simd_level level) {
+            const char* env = std::getenv("E_MATH_SIMD");
+            if (env == nullptr) {
+                return level;
+            }
+
+            for (int i = 0; i <= static_cast<int>(simd_level::avx512); ++i) {
+                auto cap = static_cast<simd_level>(i);
+                if (std::strcmp(env, simd_level_name(cap)) == 0) {
+                    return cap < level ? cap : level;
+                }
+            }
+            return level;
+        }
+    }
+
+    simd_level cpu_simd_level() {
+        static const simd_level level = apply_env_cap(detect());
+        return level;
+    }
+
+    const char* simd_level_name(simd_level level) {
+        switch (level) {
+            case simd_level::sse2: return "sse2";
+            case simd_level::avx2: return "avx2";
+            case simd_level::avx512: return "avx512";
+            default: return "scalar";
+        }
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef E_MATH_SIMD_H
+#define E_MATH_SIMD_H
+
+// 模块内部头文件：SIMD 指令集探测 与 按函数开启指令集
+// 注：库本身不加 -mavx2 之类的全局编译选项，各内核用 E_MATH_TARGET_xxx 单独开启，运行时按 CPU 选择
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define E_MATH_X86 1
+    #include <immintrin.h>
+#else
+    #define E_MATH_X86 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define E_MATH_TARGET(isa) __attribute__((target(isa)))
+#else
+    // MSVC 不需要开关，intrinsics 总是可用
+    #define E_MATH_TARGET(isa)
+#endif
+
+#define E_MATH_TARGET_SSE2 E_MATH_TARGET("sse2")
+#define E_MATH_TARGET_AVX2 E_MATH_TARGET("avx2,fma")
+#define E_MATH_TARGET_AVX512 E_MATH_TARGET("avx512f,avx512dq,avx512bw,avx512vl,avx2,fma")
+
+namespace e_math::detail {
+    enum class simd_level : int {
+        scalar = 0,
+        sse2,
+        avx2,   // AVX2 + FMA
+        avx512, // F + DQ + BW + VL
+    };
+
+    // 当前 CPU 与 OS 都支持的最高级别；首次调用时探测，之后返回缓存
+    // 环境变量 E_MATH_SIMD=scalar/sse2/avx2/avx512 可以把级别往下压，用于排查问题
+    simd_level cpu_simd_level();
+
+    const char* simd_level_name(simd_level level);
+}
+
+#endif // E_MATH_SIMD_H
@@ -0,0 +1,287 @@
+#include "e_sort.hpp"
+#include "e_parallel.hpp"
+#include "e_pool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace e_math {
+    namespace {
+        // 少于这么多个 键 时 直接 LSD；更多时 先 MSD 分桶，各桶 的 LSD 在 缓存里 完成（单线程 也这样做）
+        constexpr std::size_t msd_min_keys = std::size_t(1) << 16;
+        // 每个 线程 至少 分到 这么多个 键
+        constexpr std::size_t parallel_keys_per_task = std::size_t(1) << 15;
+        // MSD 一趟 最多 分 这么多 段：各段 的 计数器 放在 栈上（32 x 256 个 size_t = 64 KB），不 分配 内存
+        constexpr std::size_t max_msd_tasks = 32;
+        // 桶 不超过 这么大 时 插入排序
+        constexpr std::size_t insertion_max = 32;
+        // 只排 键、不超过 这么多个 时 用 std::sort：映射后 相等 的 键 逐位相同，不需要 稳定
+        constexpr std::size_t comparison_max = 1024;
+        constexpr std::size_t radix = 256;
+
+        // 键 映射成 无符号整数，保持 顺序
+        template <class K>
+        struct radix_key {
+            using U = std::conditional_t<sizeof(K) == 4, std::uint32_t, std::uint64_t>;
+            static constexpr U sign = U(1) << (sizeof(U) * 8 - 1);
+
+            static U bits(K k) {
+                U u;
+                std::memcpy(&u, &k, sizeof(u));
+                if constexpr (std::is_floating_point_v<K>) {
+                    // 负数 翻转 全部位（绝对值 越大 越小），非负数 只翻转 符号位
+                    return u ^ ((U(0) - (u >> (sizeof(U) * 8 - 1))) | sign);
+                } else if constexpr (std::is_signed_v<K>) {
+                    return u ^ sign;
+                } else {
+                    return u;
+                }
+            }
+
+            static std::size_t digit(K k, unsigned byte) {
+                return static_cast<std::size_t>((bits(k) >> (8 * byte)) & (radix - 1));
+            }
+        };
+
+        // 只排 键 时 的 值类型，指针 总是 nullptr
+        struct no_value {};
+
+        template <class K, class V>
+        void insertion_sort(K* k, V* v, std::size_t n) {
+            for (std::size_t i = 1; i < n; ++i) {
+                const K x = k[i];
+                const auto xb = radix_key<K>::bits(x);
+                std::size_t j = i;
+                if constexpr (std::is_same_v<V, no_value>) {
+                    for (; j > 0 && radix_key<K>::bits(k[j - 1]) > xb; --j) k[j] = k[j - 1];
+                } else {
+                    const V y = v[i];
+                    for (; j > 0 && radix_key<K>::bits(k[j - 1]) > xb; --j) {
+                        k[j] = k[j - 1];
+                        v[j] = v[j - 1];
+                    }
+                    v[j] = y;
+                }
+                k[j] = x;
+            }
+        }
+
+        // 对 低 bytes 个 字节 做 LSD，a / b 来回 倒；返回 true 表示 结果 在 b 里
+        template <class K, class V>
+        bool lsd(K* a, V* av, K* b, V* bv, std::size_t n, unsigned bytes) {
+            if (n <= insertion_max) {
+                insertion_sort(a, av, n);
+                return false;
+            }
+
+            // 一遍 读完 所有 字节 的 直方图
+            std::size_t hist[sizeof(K)][radix] = {};
+            for (std::size_t i = 0; i < n; ++i) {
+                const auto u = radix_key<K>::bits(a[i]);
+                for (unsigned d = 0; d < bytes; ++d) {
+                    ++hist[d][(u >> (8 * d)) & (radix - 1)];
+                }
+            }
+
+            bool swapped = false;
+            for (unsigned d = 0; d < bytes; ++d) {
+                std::size_t* h = hist[d];
+                // 所有键 这个字节 都相同
+                if (h[radix_key<K>::digit(a[0], d)] == n) {
+                    continue;
+                }
+                std::size_t sum = 0;
+                for (std::size_t r = 0; r < radix; ++r) {
+                    sum += std::exchange(h[r], sum);
+                }
+                for (std::size_t i = 0; i < n; ++i) {
+                    const std::size_t p = h[radix_key<K>::digit(a[i], d)]++;
+                    b[p] = a[i];
+                    if constexpr (!std::is_same_v<V, no_value>) {
+                        bv[p] = av[i];
+                    }
+                }
+                std::swap(a, b);
+                std::swap(av, bv);
+                swapped = !swapped;
+            }
+            return swapped;
+        }
+
+        template <class K, class V>
+        void copy_back(K* dst, V* dst_v, const K* src, const V* src_v, std::size_t n) {
+            std::copy(src, src + n, dst);
+            if constexpr (!std::is_same_v<V, no_value>) {
+                std::copy(src_v, src_v + n, dst_v);
+            }
+        }
+
+        template <class K, class V>
+        void sort_impl(K* keys, V* vals, K* ks, V* vs, std::size_t n) {
+            using U = typename radix_key<K>::U;
+            if (n < 2) {
+                return;
+            }
+
+            if constexpr (std::is_same_v<V, no_value>) {
+                if (n <= comparison_max) {
+                    std::sort(keys, keys + n, [](K a, K b) { return radix_key<K>::bits(a) < radix_key<K>::bits(b); });
+                    return;
+                }
+            }
+            if (n < msd_min_keys) {
+                if (lsd(keys, vals, ks, vs, n, sizeof(K))) {
+                    copy_back(keys, vals, ks, vs, n);
+                }
+                return;
+            }
+            const std::size_t tasks = std::clamp<std::size_t>(n / parallel_keys_per_task, 1, std::min<std::size_t>(max_threads(), max_msd_tasks));
+
+            auto chunk_begin = [&](std::size_t t) { return n / tasks * t + n % tasks * t / tasks; };
+
+            // 1. 各段 的 按位 与 / 或：最高的 不全相同 的 字节 用来 分桶，更高的 字节 不用排
+            std::array<U, max_msd_tasks> and_bits, or_bits;
+            detail::parallel_for(tasks, [&](std::size_t t) {
+                U a = ~U(0), o = 0;
+                for (std::size_t i = chunk_begin(t), e = chunk_begin(t + 1); i < e; ++i) {
+                    const U u = radix_key<K>::bits(keys[i]);
+                    a &= u;
+                    o |= u;
+                }
+                and_bits[t] = a;
+                or_bits[t] = o;
+            });
+            U all_and = ~U(0), all_or = 0;
+            for (std::size_t t = 0; t < tasks; ++t) {
+                all_and &= and_bits[t];
+                all_or |= or_bits[t];
+            }
+            const U diff = all_and ^ all_or;
+            if (diff == 0) {
+                return; // 全部相等
+            }
+            const unsigned top = static_cast<unsigned>(std::bit_width(diff) - 1) / 8;
+
+            // 2. 各段 按 top 字节 计数
+            std::array<std::array<std::size_t, radix>, max_msd_tasks> offsets;
+            detail::parallel_for(tasks, [&](std::size_t t) {
+                auto& h = offsets[t];
+                h.fill(0);
+                for (std::size_t i = chunk_begin(t), e = chunk_begin(t + 1); i < e; ++i) {
+                    ++h[radix_key<K>::digit(keys[i], top)];
+                }
+            });
+
+            // 3. 桶 按 字节值、桶内 按 段号 排列，保证 稳定
+            std::array<std::size_t, radix + 1> bucket{};
+            std::size_t sum = 0;
+            for (std::size_t r = 0; r < radix; ++r) {
+                bucket[r] = sum;
+                for (std::size_t t = 0; t < tasks; ++t) {
+                    sum += std::exchange(offsets[t][r], sum);
+                }
+            }
+            bucket[radix] = n;
+
+            // 4. 并行 散射 到 scratch
+            detail::parallel_for(tasks, [&](std::size_t t) {
+                auto& h = offsets[t];
+                for (std::size_t i = chunk_begin(t), e = chunk_begin(t + 1); i < e; ++i) {
+                    const std::size_t p = h[radix_key<K>::digit(keys[i], top)]++;
+                    ks[p] = keys[i];
+                    if constexpr (!std::is_same_v<V, no_value>) {
+                        vs[p] = vals[i];
+                    }
+                }
+            });
+
+            // 5. 各桶 LSD 排 低 top 个 字节，结果 写回 keys；大桶 先开始
+            std::array<std::size_t, radix> order;
+            std::size_t buckets = 0;
+            for (std::size_t r = 0; r < radix; ++r) {
+                if (bucket[r + 1] > bucket[r]) {
+                    order[buckets++] = r;
+                }
+            }
+            std::sort(order.begin(), order.begin() + buckets, [&](std::size_t a, std::size_t b) { return bucket[a + 1] - bucket[a] > bucket[b + 1] - bucket[b]; });
+            detail::parallel_for(buckets, [&](std::size_t i) {
+                const std::size_t s = bucket[order[i]];
+                const std::size_t len = bucket[order[i] + 1] - s;
+                V* scratch_v = nullptr;
+                V* out_v = nullptr;
+                if constexpr (!std::is_same_v<V, no_value>) {
+                    scratch_v = vs + s;
+                    out_v = vals + s;
+                }
+                if (!lsd(ks + s, scratch_v, keys + s, out_v, len, top)) {
+                    copy_back(keys + s, out_v, ks + s, scratch_v, len);
+                }
+            });
+        }
+
+        template <class K, class V>
+        void sort_with_buffers(std::span<K> keys, V* vals) {
+            const std::size_t n = keys.size();
+            if (n < 2) {
+                return;
+            }
+            auto ks = std::make_unique_for_overwrite<K[]>(n);
+            if constexpr (std::is_same_v<V, no_value>) {
+                sort_impl<K, V>(keys.data(), nullptr, ks.get(), nullptr, n);
+            } else {
+                auto vs = std::make_unique_for_overwrite<V[]>(n);
+                sort_impl(keys.data(), vals, ks.get(), vs.get(), n);
+            }
+        }
+
+        void check_size(std::size_t keys, std::size_t other, const char* what) {
+            if (other < keys) {
+                throw std::invalid_argument(what);
+            }
+        }
+    }
+
+#define E_MATH_RADIX_SORT_PAIRS(K, V)                                                                                          \
+    void radix_sort_pairs(std::span<K> keys, std::span<V> values) {                                                           \
+        if (values.size() != keys.size()) {                                                                                    \
+            throw std::invalid_argument("e_math::radix_sort_pairs: keys and values must have the same size");                 \
+        }                                                                                                                      \
+        sort_with_buffers(keys, values.data());                                                                                \
+    }                                                                                                                          \
+    void radix_sort_pairs(std::span<K> keys, std::span<V> values, std::span<K> key_scratch, std::span<V> value_scratch) {    \
+        if (values.size() != keys.size()) {                                                                                    \
+            throw std::invalid_argument("e_math::radix_sort_pairs: keys and values must have the same size");                 \
+        }                                                                                                                      \
+        check_size(keys.size(), key_scratch.size(), "e_math::radix_sort_pairs: key scratch is too small");                    \
+        check_size(keys.size(), value_scratch.size(), "e_math::radix_sort_pairs: value scratch is too small");                \
+        sort_impl(keys.data(), values.data(), key_scratch.data(), value_scratch.data(), keys.size());                          \
+    }
+
+#define E_MATH_RADIX_SORT(K)                                                                                                   \
+    void radix_sort(std::span<K> keys) {                                                                                       \
+        sort_with_buffers<K, no_value>(keys, nullptr);                                                                         \
+    }                                                                                                                          \
+    void radix_sort(std::span<K> keys, std::span<K> scratch) {                                                                 \
+        check_size(keys.size(), scratch.size(), "e_math::radix_sort: scratch is too small");                                   \
+        sort_impl<K, no_value>(keys.data(), nullptr, scratch.data(), nullptr, keys.size());                                    \
+    }                                                                                                                          \
+    E_MATH_RADIX_SORT_PAIRS(K, std::uint32_t)                                                                                  \
+    E_MATH_RADIX_SORT_PAIRS(K, std::uint64_t)
+
+    E_MATH_RADIX_SORT(std::int32_t)
+    E_MATH_RADIX_SORT(std::uint32_t)
+    E_MATH_RADIX_SORT(std::int64_t)
+    E_MATH_RADIX_SORT(std::uint64_t)
+    E_MATH_RADIX_SORT(float)
+    E_MATH_RADIX_SORT(double)
+
+#undef E_MATH_RADIX_SORT
+#undef E_MATH_RADIX_SORT_PAIRS
+}
@@ -0,0 +1,239 @@
+#include "e_sparse.hpp"
+#include "e_parallel.hpp"
+#include "e_pool.hpp"
+#include "e_simd.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace e_math {
+    template <class T>
+    csr_matrix<T>::csr_matrix(std::size_t rows, std::size_t cols, std::span<const coo_entry<T>> entries) : rows_(rows), cols_(cols) {
+        if (cols > static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max())) {
+            throw std::invalid_argument("e_math::csr_matrix: too many columns");
+        }
+        for (const auto& e : entries) {
+            if (e.row >= rows || e.col >= cols) {
+                throw std::invalid_argument("e_math::csr_matrix: entry index out of range");
+            }
+        }
+
+        // 按行 计数分桶（保持输入顺序），再 行内 按列 稳定排序，相邻的 重复位置 相加
+        std::vector<std::size_t> start(rows + 1, 0);
+        for (const auto& e : entries) {
+            ++start[e.row + 1];
+        }
+        std::partial_sum(start.begin(), start.end(), start.begin());
+
+        std::vector<std::size_t> order(entries.size());
+        std::vector<std::size_t> next(start.begin(), start.end() - 1);
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+            order[next[entries[i].row]++] = i;
+        }
+
+        row_ptr_.assign(rows + 1, 0);
+        col_idx_.reserve(entries.size());
+        values_.reserve(entries.size());
+        for (std::size_t r = 0; r < rows; ++r) {
+            auto first = order.begin() + static_cast<std::ptrdiff_t>(start[r]);
+            auto last = order.begin() + static_cast<std::ptrdiff_t>(start[r + 1]);
+            std::stable_sort(first, last, [&](std::size_t a, std::size_t b) { return entries[a].col < entries[b].col; });
+            for (auto it = first; it != last; ++it) {
+                const auto& e = entries[*it];
+                auto col = static_cast<std::uint32_t>(e.col);
+                if (values_.size() > row_ptr_[r] && col_idx_.back() == col) {
+                    values_.back() += e.value;
+                } else {
+                    col_idx_.push_back(col);
+                    values_.push_back(e.value);
+                }
+            }
+            row_ptr_[r + 1] = values_.size();
+        }
+    }
+
+    template class csr_matrix<float>;
+    template class csr_matrix<double>;
+
+    namespace {
+        // 非零元 少于这个数 时 单线程
+        constexpr std::size_t parallel_min_nnz = std::size_t(1) << 15;
+
+        // 计算 [r0, r1) 行：y[r] = sum(val[k] * x[col[k]])
+        template <class T>
+        using spmv_fn = void (*)(const std::size_t* ptr, const std::uint32_t* col, const T* val, const T* x, T* y, std::size_t r0, std::size_t r1);
+
+        struct spmv_kernels {
+            spmv_fn<float> f32;
+            spmv_fn<double> f64;
+        };
+
+        template <class T>
+        inline T row_dot_scalar(const std::uint32_t* col, const T* val, std::size_t n, const T* x) {
+            T s = 0;
+            for (std::size_t k = 0; k < n; ++k) {
+                s += val[k] * x[col[k]];
+            }
+            return s;
+        }
+
+#define E_MATH_SPMV_KERNEL(name, target, T, row_dot)                                                                           \
+        target void name(const std::size_t* ptr, const std::uint32_t* col, const T* val, const T* x, T* y, std::size_t r0, std::size_t r1) { \
+            for (std::size_t r = r0; r < r1; ++r) {                                                                             \
+                y[r] = row_dot(col + ptr[r], val + ptr[r], ptr[r + 1] - ptr[r], x);                                             \
+            }                                                                                                                   \
+        }
+
+        E_MATH_SPMV_KERNEL(spmv_f32_scalar, , float, row_dot_scalar<float>)
+        E_MATH_SPMV_KERNEL(spmv_f64_scalar, , double, row_dot_scalar<double>)
+
+#if E_MATH_X86
+// GCC 12 的 gather / reduce intrinsics 内部 用 _mm*_undefined_*，会报 -Wmaybe-uninitialized 误报
+#if defined(__GNUC__) && !defined(__clang__)
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+        // ---------------- AVX2：gather + FMA，尾部 标量 ----------------
+
+        E_MATH_TARGET_AVX2 inline float hsum_avx2(__m256 v) {
+            __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+            s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+            s = _mm_add_ss(s, _mm_movehdup_ps(s));
+            return _mm_cvtss_f32(s);
+        }
+
+        E_MATH_TARGET_AVX2 inline double hsum_avx2(__m256d v) {
+            __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+            s = _mm_add_sd(s, _mm_unpackhi_pd(s, s));
+            return _mm_cvtsd_f64(s);
+        }
+
+        E_MATH_TARGET_AVX2 inline float row_dot_f32_avx2(const std::uint32_t* col, const float* val, std::size_t n, const float* x) {
+            __m256 acc = _mm256_setzero_ps();
+            std::size_t k = 0;
+            for (; k + 8 <= n; k += 8) {
+                __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(col + k));
+                acc = _mm256_fmadd_ps(_mm256_loadu_ps(val + k), _mm256_i32gather_ps(x, idx, 4), acc);
+            }
+            float s = hsum_avx2(acc);
+            for (; k < n; ++k) {
+                s += val[k] * x[col[k]];
+            }
+            return s;
+        }
+
+        E_MATH_TARGET_AVX2 inline double row_dot_f64_avx2(const std::uint32_t* col, const double* val, std::size_t n, const double* x) {
+            __m256d acc = _mm256_setzero_pd();
+            std::size_t k = 0;
+            for (; k + 4 <= n; k += 4) {
+                __m128i idx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(col + k));
+                acc = _mm256_fmadd_pd(_mm256_loadu_pd(val + k), _mm256_i32gather_pd(x, idx, 8), acc);
+            }
+            double s = hsum_avx2(acc);
+            for (; k < n; ++k) {
+                s += val[k] * x[col[k]];
+            }
+            return s;
+        }
+
+        // ---------------- AVX-512：尾部 用掩码 gather ----------------
+
+        E_MATH_TARGET_AVX512 inline float row_dot_f32_avx512(const std::uint32_t* col, const float* val, std::size_t n, const float* x) {
+            __m512 acc = _mm512_setzero_ps();
+            std::size_t k = 0;
+            for (; k + 16 <= n; k += 16) {
+                __m512i idx = _mm512_loadu_si512(col + k);
+                acc = _mm512_fmadd_ps(_mm512_loadu_ps(val + k), _mm512_i32gather_ps(idx, x, 4), acc);
+            }
+            if (k < n) {
+                __mmask16 m = static_cast<__mmask16>((1u << (n - k)) - 1);
+                __m512i idx = _mm512_maskz_loadu_epi32(m, col + k);
+                __m512 xv = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), m, idx, x, 4);
+                acc = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, val + k), xv, acc);
+            }
+            return _mm512_reduce_add_ps(acc);
+        }
+
+        E_MATH_TARGET_AVX512 inline double row_dot_f64_avx512(const std::uint32_t* col, const double* val, std::size_t n, const double* x) {
+            __m512d acc = _mm512_setzero_pd();
+            std::size_t k = 0;
+            for (; k + 8 <= n; k += 8) {
+                __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(col + k));
+                acc = _mm512_fmadd_pd(_mm512_loadu_pd(val + k), _mm512_i32gather_pd(idx, x, 8), acc);
+            }
+            if (k < n) {
+                __mmask8 m = static_cast<__mmask8>((1u << (n - k)) - 1);
+                __m256i idx = _mm256_maskz_loadu_epi32(m, col + k);
+                __m512d xv = _mm512_mask_i32gather_pd(_mm512_setzero_pd(), m, idx, x, 8);
+                acc = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(m, val + k), xv, acc);
+            }
+            return _mm512_reduce_add_pd(acc);
+        }
+
+        E_MATH_SPMV_KERNEL(spmv_f32_avx2, E_MATH_TARGET_AVX2, float, row_dot_f32_avx2)
+        E_MATH_SPMV_KERNEL(spmv_f64_avx2, E_MATH_TARGET_AVX2, double, row_dot_f64_avx2)
+        E_MATH_SPMV_KERNEL(spmv_f32_avx512, E_MATH_TARGET_AVX512, float, row_dot_f32_avx512)
+        E_MATH_SPMV_KERNEL(spmv_f64_avx512, E_MATH_TARGET_AVX512, double, row_dot_f64_avx512)
+
+#if defined(__GNUC__) && !defined(__clang__)
+    #pragma GCC diagnostic pop
+#endif
+#endif // E_MATH_X86
+
+#undef E_MATH_SPMV_KERNEL
+
+        // SSE2 没有 gather，用标量
+        spmv_kernels select_spmv_kernels() {
+#if E_MATH_X86
+            switch (detail::cpu_simd_level()) {
+                case detail::simd_level::avx512: return {spmv_f32_avx512, spmv_f64_avx512};
+                case detail::simd_level::avx2: return {spmv_f32_avx2, spmv_f64_avx2};
+                default: break;
+            }
+#endif
+            return {spmv_f32_scalar, spmv_f64_scalar};
+        }
+
+        const spmv_kernels g_spmv = select_spmv_kernels();
+
+        template <class T>
+        void spmv_impl(const csr_matrix<T>& a, std::span<const T> x, std::span<T> y, spmv_fn<T> kernel) {
+            if (x.size() != a.cols() || y.size() != a.rows()) {
+                throw std::invalid_argument("e_math::spmv: vector sizes do not match the matrix");
+            }
+            const std::size_t* ptr = a.row_ptr().data();
+            const std::uint32_t* col = a.col_idx().data();
+            const T* val = a.values().data();
+            const std::size_t rows = a.rows();
+            const std::size_t nnz = a.nnz();
+
+            std::size_t tasks = nnz < parallel_min_nnz ? 1 : std::min<std::size_t>(max_threads(), rows);
+            if (tasks <= 1) {
+                kernel(ptr, col, val, x.data(), y.data(), 0, rows);
+                return;
+            }
+
+            // 第 t 段 从 第 t * nnz / tasks 个 非零元 所在的行 开始，每段 非零元 大致相同
+            auto first_row = [&](std::size_t t) {
+                return static_cast<std::size_t>(std::lower_bound(ptr, ptr + rows, nnz / tasks * t + nnz % tasks * t / tasks) - ptr);
+            };
+            detail::parallel_for(tasks, [&](std::size_t t) {
+                std::size_t r1 = t + 1 == tasks ? rows : first_row(t + 1);
+                kernel(ptr, col, val, x.data(), y.data(), first_row(t), r1);
+            });
+        }
+    }
+
+    void spmv(const csr_matrix<float>& a, std::span<const float> x, std::span<float> y) {
+        spmv_impl(a, x, y, g_spmv.f32);
+    }
+
+    void spmv(const csr_matrix<double>& a, std::span<const double> x, std::span<double> y) {
+        spmv_impl(a, x, y, g_spmv.f64);
+    }
+}
@@ -0,0 +1,297 @@
+#include "e_stats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+
+namespace e_math {
+    namespace {
+        constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+
+        // 批量更新 的 块大小：块内 两遍（先 均值 后 平方差），数据 还在 L1 里
+        constexpr std::size_t moments_block = 256;
+
+        template <class T>
+        void add_block(const T* p, std::size_t n, std::uint64_t& count, double& mean, double& m2, double& lo, double& hi) {
+            // 4 路 独立累加，打断 依赖链
+            double s[4] = {0, 0, 0, 0};
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                for (int j = 0; j < 4; ++j) s[j] += static_cast<double>(p[i + j]);
+            }
+            for (; i < n; ++i) s[0] += static_cast<double>(p[i]);
+            const double block_mean = ((s[0] + s[1]) + (s[2] + s[3])) / static_cast<double>(n);
+
+            double d[4] = {0, 0, 0, 0};
+            i = 0;
+            for (; i + 4 <= n; i += 4) {
+                for (int j = 0; j < 4; ++j) {
+                    double x = static_cast<double>(p[i + j]) - block_mean;
+                    d[j] += x * x;
+                }
+            }
+            for (; i < n; ++i) {
+                double x = static_cast<double>(p[i]) - block_mean;
+                d[0] += x * x;
+            }
+            const double block_m2 = (d[0] + d[1]) + (d[2] + d[3]);
+
+            for (i = 0; i < n; ++i) {
+                double x = static_cast<double>(p[i]);
+                lo = x < lo ? x : lo; // NaN 比较 为 false，被 忽略
+                hi = x > hi ? x : hi;
+            }
+
+            // Chan 合并
+            const auto nb = static_cast<double>(n);
+            const auto na = static_cast<double>(count);
+            const double total = na + nb;
+            const double delta = block_mean - mean;
+            mean += delta * (nb / total);
+            m2 += block_m2 + delta * delta * (na * nb / total);
+            count += n;
+        }
+
+        template <class T>
+        void add_span(std::span<const T> v, std::uint64_t& count, double& mean, double& m2, double& lo, double& hi) {
+            for (std::size_t i = 0; i < v.size(); i += moments_block) {
+                add_block(v.data() + i, std::min(moments_block, v.size() - i), count, mean, m2, lo, hi);
+            }
+        }
+    }
+
+    void moments::add(double x) {
+        ++n_;
+        double delta = x - mean_;
+        mean_ += delta / static_cast<double>(n_);
+        m2_ += delta * (x - mean_);
+        min_ = x < min_ ? x : min_;
+        max_ = x > max_ ? x : max_;
+    }
+
+    void moments::add(std::span<const float> v) {
+        add_span(v, n_, mean_, m2_, min_, max_);
+    }
+
+    void moments::add(std::span<const double> v) {
+        add_span(v, n_, mean_, m2_, min_, max_);
+    }
+
+    void moments::merge(const moments& other) {
+        if (other.n_ == 0) {
+            return;
+        }
+        if (n_ == 0) {
+            *this = other;
+            return;
+        }
+        const auto na = static_cast<double>(n_);
+        const auto nb = static_cast<double>(other.n_);
+        const double total = na + nb;
+        const double delta = other.mean_ - mean_;
+        mean_ += delta * (nb / total);
+        m2_ += other.m2_ + delta * delta * (na * nb / total);
+        n_ += other.n_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    double moments::mean() const {
+        return n_ == 0 ? nan : mean_;
+    }
+
+    double moments::variance() const {
+        return n_ == 0 ? nan : m2_ / static_cast<double>(n_);
+    }
+
+    double moments::sample_variance() const {
+        return n_ < 2 ? nan : m2_ / static_cast<double>(n_ - 1);
+    }
+
+    double moments::stddev() const {
+        return std::sqrt(variance());
+    }
+
+    double moments::min() const {
+        return n_ == 0 || min_ > max_ ? nan : min_;
+    }
+
+    double moments::max() const {
+        return n_ == 0 || min_ > max_ ? nan : max_;
+    }
+
+    namespace {
+        // 缓冲区 容量 = 这个倍数 * compression
+        constexpr double buffer_factor = 5;
+
+        // k1 尺度函数：k(q) = compression / (2 pi) * asin(2q - 1)，每个 质心 跨度 不超过 1 个 k 单位
+        double k_to_q(double k, double compression) {
+            const double x = k * (2 * std::numbers::pi) / compression;
+            if (x >= std::numbers::pi / 2) {
+                return 1;
+            }
+            return (std::sin(x) + 1) / 2;
+        }
+
+        double q_to_k(double q, double compression) {
+            return compression / (2 * std::numbers::pi) * std::asin(std::clamp(2 * q - 1, -1.0, 1.0));
+        }
+
+        struct by_mean {
+            template <class C>
+            bool operator()(const C& a, const C& b) const {
+                return a.mean < b.mean;
+            }
+        };
+
+        // sorted 按 mean 升序，贪心地 把 相邻 质心 合并到 k 尺度 允许的 上限
+        template <class C>
+        void merge_sorted(std::vector<C>& sorted, double total, double compression) {
+            if (sorted.empty()) {
+                return;
+            }
+            std::size_t out = 0;
+            double before = 0; // 当前 输出质心 之前 的 总权重
+            double limit = total * k_to_q(q_to_k(0, compression) + 1, compression);
+            for (std::size_t i = 1; i < sorted.size(); ++i) {
+                C& cur = sorted[out];
+                const C& next = sorted[i];
+                const double proposed = cur.weight + next.weight;
+                if (before + proposed <= limit) {
+                    cur.mean += (next.mean - cur.mean) * (next.weight / proposed);
+                    cur.weight = proposed;
+                } else {
+                    before += cur.weight;
+                    limit = total * k_to_q(q_to_k(before / total, compression) + 1, compression);
+                    sorted[++out] = next;
+                }
+            }
+            sorted.resize(out + 1);
+        }
+    }
+
+    tdigest::tdigest(double compression) : compression_(compression), buffer_limit_(0) {
+        if (!(compression >= 10) || !std::isfinite(compression)) {
+            throw std::invalid_argument("e_math::tdigest: compression must be at least 10");
+        }
+        buffer_limit_ = static_cast<std::size_t>(std::ceil(compression * buffer_factor));
+        buffer_.reserve(buffer_limit_);
+    }
+
+    void tdigest::push_buffered(centroid c) {
+        if (buffer_.size() >= buffer_limit_) {
+            compress();
+        }
+        buffer_.push_back(c);
+        buffered_ += c.weight;
+    }
+
+    void tdigest::add(double x, double weight) {
+        if (!(weight > 0) || !std::isfinite(weight)) {
+            throw std::invalid_argument("e_math::tdigest: weight must be positive and finite");
+        }
+        if (!std::isfinite(x)) {
+            return;
+        }
+        push_buffered({x, weight});
+        min_ = std::min(min_, x);
+        max_ = std::max(max_, x);
+    }
+
+    void tdigest::add(std::span<const float> v) {
+        for (float x : v) add(static_cast<double>(x));
+    }
+
+    void tdigest::add(std::span<const double> v) {
+        for (double x : v) add(x);
+    }
+
+    void tdigest::merge(const tdigest& other) {
+        if (this == &other) {
+            // 下面 边读 边往 自己的 缓冲区 里 加，先 拷一份
+            const tdigest copy(other);
+            merge(copy);
+            return;
+        }
+        // 对方的 质心 当作 带权重 的 点，按 自己的 compression 重新合并
+        for (const auto* part : {&other.centroids_, &other.buffer_}) {
+            for (const auto& c : *part) push_buffered(c);
+        }
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    void tdigest::compress() {
+        if (buffer_.empty()) {
+            return;
+        }
+        std::sort(buffer_.begin(), buffer_.end(), by_mean{});
+        std::vector<centroid> all(centroids_.size() + buffer_.size());
+        std::merge(centroids_.begin(), centroids_.end(), buffer_.begin(), buffer_.end(), all.begin(), by_mean{});
+        total_ += buffered_;
+        buffered_ = 0;
+        buffer_.clear();
+        merge_sorted(all, total_, compression_);
+        centroids_ = std::move(all);
+    }
+
+    double tdigest::quantile(double q) const {
+        if (!(q >= 0 && q <= 1)) {
+            throw std::invalid_argument("e_math::tdigest: quantile must be in [0, 1]");
+        }
+        const double total = count();
+        if (total == 0) {
+            return nan;
+        }
+
+        // 有 未合并的 输入 时 在 副本上 合并（不修改 自己）
+        std::vector<centroid> merged;
+        const std::vector<centroid>* cs = &centroids_;
+        if (!buffer_.empty()) {
+            merged = buffer_;
+            std::sort(merged.begin(), merged.end(), by_mean{});
+            std::vector<centroid> all(centroids_.size() + merged.size());
+            std::merge(centroids_.begin(), centroids_.end(), merged.begin(), merged.end(), all.begin(), by_mean{});
+            merge_sorted(all, total, compression_);
+            merged = std::move(all);
+            cs = &merged;
+        }
+        const auto& c = *cs;
+
+        if (q == 0) {
+            return min_;
+        }
+        if (q == 1) {
+            return max_;
+        }
+        if (c.size() == 1) {
+            return c[0].mean;
+        }
+
+        // 每个 质心 的 权重 看作 以 mean 为中心 均匀分布：相邻 质心 中心之间 线性插值，两端 插值到 min / max
+        const double index = q * total;
+        const double first_half = c.front().weight / 2;
+        if (index < first_half) {
+            return min_ + (c.front().mean - min_) * (index / first_half);
+        }
+        double cumulative = first_half;
+        for (std::size_t i = 0; i + 1 < c.size(); ++i) {
+            const double step = (c[i].weight + c[i + 1].weight) / 2;
+            if (index < cumulative + step) {
+                return c[i].mean + (c[i + 1].mean - c[i].mean) * ((index - cumulative) / step);
+            }
+            cumulative += step;
+        }
+        const double last_half = c.back().weight / 2;
+        return c.back().mean + (max_ - c.back().mean) * std::min(1.0, (index - cumulative) / last_half);
+    }
+
+    double tdigest::min() const {
+        return count() == 0 ? nan : min_;
+    }
+
+    double tdigest::max() const {
+        return count() == 0 ? nan : max_;
+    }
+}
@@ -0,0 +1,564 @@
+#include "e_vmath.hpp"
+#include "e_lanes.hpp"
+#include "e_simd.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// 多项式系数：accurate 大多取自 Cephes（double 的 log 取自 fdlibm，double 的 exp 是 拟合的），fast 是 按 相对误差 拟合的 近似最佳逼近
+
+namespace e_math {
+    namespace {
+        // 不需要 SIMD 的 部分：<cmath> 参考实现，也是 大参数 sin / cos 的 回落
+        template <class T>
+        T sigmoid_scalar(T x) {
+            T e = std::exp(-std::fabs(x));
+            return x >= 0 ? T(1) / (T(1) + e) : e / (T(1) + e);
+        }
+
+#if E_MATH_HAS_NATIVE_VEC
+        using detail::vec;
+
+        template <class T>
+        struct fp_traits;
+
+        template <>
+        struct fp_traits<float> {
+            using int_type = std::int32_t;
+            static constexpr int mant_bits = 23;
+            static constexpr int_type bias = 127;
+            static constexpr float round_magic = 12582912.0f; // 1.5 * 2^23
+        };
+
+        template <>
+        struct fp_traits<double> {
+            using int_type = std::int64_t;
+            static constexpr int mant_bits = 52;
+            static constexpr int_type bias = 1023;
+            static constexpr double round_magic = 6755399441055744.0; // 1.5 * 2^52
+        };
+
+        template <class V>
+        using elem_t = std::remove_cvref_t<decltype(std::declval<V>()[0])>;
+
+        // 与 V 同宽 的 整数向量，比较的结果 也是这个类型
+        template <class V>
+        using ivec_t = vec<typename fp_traits<elem_t<V>>::int_type, sizeof(V)>;
+
+        template <class V>
+        E_MATH_ALWAYS_INLINE V splat(elem_t<V> x) {
+            return V{} + x;
+        }
+
+        template <class I>
+        E_MATH_ALWAYS_INLINE I sign_mask() {
+            using U = std::remove_cvref_t<decltype(std::declval<I>()[0])>;
+            return I{} + std::numeric_limits<U>::min();
+        }
+
+        template <class V>
+        E_MATH_ALWAYS_INLINE V vabs(V x) {
+            using I = ivec_t<V>;
+            return (V)((I)x & ~sign_mask<I>());
+        }
+
+        // Horner，c 从 最高次 开始
+        template <class V, class T, std::size_t N>
+        E_MATH_ALWAYS_INLINE V poly(V x, const T (&c)[N]) {
+            V r = splat<V>(c[0]);
+            E_MATH_UNROLL
+            for (std::size_t i = 1; i < N; ++i) r = r * x + c[i];
+            return r;
+        }
+
+        // 四舍五入 到整数：加减 1.5 * 2^mant，整数值 同时 留在 尾数低位（|x| < 2^(mant - 1)）
+        template <class V>
+        E_MATH_ALWAYS_INLINE V round_int(V x, ivec_t<V>& n) {
+            using T = elem_t<V>;
+            using I = ivec_t<V>;
+            constexpr T magic = fp_traits<T>::round_magic;
+            V t = x + magic;
+            n = (I)t - (I)splat<V>(magic);
+            return t - magic;
+        }
+
+        // 小整数 转 浮点，同样 借用 1.5 * 2^mant
+        template <class V>
+        E_MATH_ALWAYS_INLINE V int_to_fp(ivec_t<V> n) {
+            using T = elem_t<V>;
+            using I = ivec_t<V>;
+            constexpr T magic = fp_traits<T>::round_magic;
+            return (V)(n + (I)splat<V>(magic)) - magic;
+        }
+
+        // 2^n，n 必须在 规格数 指数范围内
+        template <class V>
+        E_MATH_ALWAYS_INLINE V pow2(ivec_t<V> n) {
+            using T = elem_t<V>;
+            return (V)((n + fp_traits<T>::bias) << fp_traits<T>::mant_bits);
+        }
+
+        template <class I>
+        E_MATH_ALWAYS_INLINE bool all_lanes_set(I m) {
+            std::uint64_t words[sizeof(I) / 8];
+            std::memcpy(words, &m, sizeof(I));
+            std::uint64_t acc = ~std::uint64_t(0);
+            for (std::uint64_t w : words) acc &= w;
+            return acc == ~std::uint64_t(0);
+        }
+
+        // ---------------- exp ----------------
+
+        template <class T>
+        struct exp_consts;
+
+        template <>
+        struct exp_consts<float> {
+            static constexpr float hi = 89.0f;   // 之上 溢出为 inf
+            static constexpr float lo = -104.0f; // 之下 下溢为 0
+            static constexpr float ln2_hi = 0.693359375f;
+            static constexpr float ln2_lo = -2.12194440e-4f;
+            static constexpr float p[] = {1.9875691500e-4f, 1.3981999507e-3f, 8.3334519073e-3f, 4.1665795894e-2f, 1.6666665459e-1f, 5.0000001201e-1f};
+            static constexpr float p_fast[] = {8.312527090e-3f, 4.189011455e-2f, 1.666711420e-1f, 4.999923110e-1f};
+        };
+
+        template <>
+        struct exp_consts<double> {
+            static constexpr double hi = 710.0;
+            static constexpr double lo = -746.0;
+            static constexpr double ln2_hi = 6.93145751953125e-1;
+            static constexpr double ln2_lo = 1.42860682030941723212e-6;
+            static constexpr double p[] = {
+                -8.35517164091494827e-9, 2.25142285078138399e-8, 2.79021593463416677e-7, 2.75655359259990791e-6, 2.48011784961406267e-5, 1.98412605041410416e-4,
+                1.38888890941948483e-3, 8.33333333768500502e-3, 4.16666666662853444e-2, 1.66666666666598906e-1, 5.00000000000001221e-1,
+            };
+            static constexpr double p_fast[] = {
+                2.74393695567652279e-7, 2.76344869727277089e-6, 2.48020354209048608e-5, 1.98411864898549679e-4, 1.38888884197373164e-3,
+                8.33333336989704708e-3, 4.16666666684724352e-2, 1.66666666666138413e-1, 4.99999999999980071e-1,
+            };
+        };
+
+        // x 已经在 [lo, hi] 内（或是 NaN）
+        template <bool Fast, class V>
+        E_MATH_ALWAYS_INLINE V exp_core(V x) {
+            using T = elem_t<V>;
+            using I = ivec_t<V>;
+            using C = exp_consts<T>;
+
+            // x = n ln2 + r，|r| <= ln2 / 2
+            I n;
+            V k = round_int(x * T(1.44269504088896340736), n);
+            V r = x - k * C::ln2_hi;
+            r = r - k * C::ln2_lo;
+
+            V p = (Fast ? poly(r, C::p_fast) : poly(r, C::p)) * (r * r) + r + T(1);
+
+            // 2^n 拆成 两个因子：n 在 上下界 附近时，单个 2^n 会 溢出 / 不是规格数
+            I n1 = n >> 1;
+            return p * pow2<V>(n1) * pow2<V>(n - n1);
+        }
+
+        struct exp_op {
+            template <bool Fast, class V>
+            static E_MATH_ALWAYS_INLINE V apply(V x) {
+                using C = exp_consts<elem_t<V>>;
+                V c = x > C::hi ? splat<V>(C::hi) : x;
+                c = c < C::lo ? splat<V>(C::lo) : c;
+                V r = exp_core<Fast>(c);
+                r = x > C::hi ? splat<V>(std::numeric_limits<elem_t<V>>::infinity()) : r;
+                return x < C::lo ? V{} : r;
+            }
+        };
+
+        // ---------------- log ----------------
+
+        template <class T>
+        struct log_consts;
+
+        template <>
+        struct log_consts<float> {
+            static constexpr float ln2_hi = 0.693359375f;
+            static constexpr float ln2_lo = -2.12194440e-4f;
+            static constexpr float p[] = {7.0376836292e-2f, -1.1514610310e-1f, 1.1676998740e-1f, -1.2420140846e-1f, 1.4249322787e-1f,
+                                          -1.6668057665e-1f, 2.0000714765e-1f, -2.4999993993e-1f, 3.3333331174e-1f};
+            static constexpr float p_fast[] = {8.700359613e-2f, -1.426747590e-1f, 1.491478682e-1f, -1.657758653e-1f, 1.996306181e-1f, -2.500133812e-1f, 3.333390951e-1f};
+        };
+
+        template <>
+        struct log_consts<double> {
+            static constexpr double ln2_hi = 6.93147180369123816490e-1;
+            static constexpr double ln2_lo = 1.90821492927058770002e-10;
+            static constexpr double lg[] = {1.479819860511658591e-1, 1.531383769920937332e-1, 1.818357216161805012e-1, 2.222219843214978396e-1,
+                                            2.857142874366239149e-1, 3.999999999940941908e-1, 6.666666666666735130e-1};
+        };
+
+        struct log_op {
+            template <bool Fast, class V>
+            static E_MATH_ALWAYS_INLINE V apply(V x) {
+                using T = elem_t<V>;
+                using I = ivec_t<V>;
+                using L = std::numeric_limits<T>;
+                using C = log_consts<T>;
+                constexpr int mant = fp_traits<T>::mant_bits;
+
+                // 非规格数 先放大 2^mant
+                I sub = x < L::min();
+                V xs = sub ? x * T(std::uint64_t(1) << mant) : x;
+                I bits = (I)xs;
+                I e = ((bits >> mant) & (2 * fp_traits<T>::bias + 1)) - fp_traits<T>::bias;
+                e = sub ? e - mant : e;
+
+                // x = m * 2^e，m 换到 [sqrt(1/2), sqrt(2))
+                V m = (V)((bits & (((I{} + 1) << mant) - 1)) | (I)splat<V>(T(1)));
+                I big = m > T(1.41421356237309504880);
+                m = big ? m * T(0.5) : m;
+                e = big ? e + 1 : e;
+                V f = m - T(1);
+                V fe = int_to_fp<V>(e);
+
+                V r;
+                if constexpr (std::is_same_v<T, double>) {
+                    // fdlibm：log(1 + f) = 2 atanh(s)，s = f / (2 + f)
+                    V s = f / (T(2) + f);
+                    V z = s * s;
+                    V rz = z * poly(z, C::lg);
+                    V hfsq = T(0.5) * f * f;
+                    r = fe * C::ln2_hi - ((hfsq - (s * (hfsq + rz) + fe * C::ln2_lo)) - f);
+                } else {
+                    V z = f * f;
+                    V y = f * z * (Fast ? poly(f, C::p_fast) : poly(f, C::p));
+                    y = y + fe * C::ln2_lo;
+                    y = y - T(0.5) * z;
+                    r = f + y;
+                    r = r + fe * C::ln2_hi;
+                }
+
+                r = x == L::infinity() ? x : r;
+                r = x == T(0) ? splat<V>(-L::infinity()) : r;
+                r = x < T(0) ? splat<V>(L::quiet_NaN()) : r;
+                return x != x ? x : r;
+            }
+        };
+
+        // ---------------- sin / cos ----------------
+
+        template <class T>
+        struct trig_consts;
+
+        template <>
+        struct trig_consts<float> {
+            static constexpr float limit = 8192.0f; // 之上 回落 <cmath>
+            // pi / 2 拆成 几段 之和，前几段 只有 11 位有效位，k < 2^13 时 k * dp[i] 没有舍入
+            static constexpr float dp[] = {1.5703125f, 4.837512969970703125e-4f, 7.54953362047672271729e-8f, 2.56334406825739e-12f};
+            static constexpr float sin_p[] = {-1.9515295891e-4f, 8.3321608736e-3f, -1.6666654611e-1f};
+            static constexpr float cos_p[] = {2.443315711809948e-5f, -1.388731625493765e-3f, 4.166664568298827e-2f};
+        };
+
+        template <>
+        struct trig_consts<double> {
+            static constexpr double limit = 1073741824.0;
+            static constexpr double dp[] = {1.57079625129699707031e0, 7.54978941586159635336e-8, 5.39030285815811905290e-15};
+            static constexpr double sin_p[] = {1.58962301576546568060e-10, -2.50507477628578072866e-8, 2.75573136213857245213e-6,
+                                               -1.98412698295895385996e-4, 8.33333333332211858878e-3, -1.66666666666666307295e-1};
+            static constexpr double cos_p[] = {-1.13585365213876817300e-11, 2.08757008419747316778e-9, -2.75573141792967388112e-7,
+                                               2.48015872888517045348e-5, -1.38888888888730564116e-3, 4.16666666666665929218e-2};
+        };
+
+        // |x| = q * pi / 2 + z，|z| <= pi / 4；按象限 q 取 ±sin(z) / ±cos(z)，cos(x) = sin(|x| + pi / 2)
+        template <bool Cos>
+        struct trig_op {
+            template <bool Fast, class V>
+            static E_MATH_ALWAYS_INLINE V apply(V x) {
+                using T = elem_t<V>;
+                using I = ivec_t<V>;
+                using C = trig_consts<T>;
+                constexpr int sign_shift = int(sizeof(T) * 8 - 2);
+
+                V ax = vabs(x);
+                I q;
+                V k = round_int(ax * T(0.63661977236758134308), q);
+                V z = ax;
+                for (T dp : C::dp) z = z - k * dp;
+                if constexpr (Cos) {
+                    q = q + 1;
+                }
+
+                V zz = z * z;
+                V s = z + z * zz * poly(zz, C::sin_p);
+                V c = T(1) - T(0.5) * zz + zz * zz * poly(zz, C::cos_p);
+                V r = (q & 1) == 0 ? s : c;
+
+                // 第 2、3 象限 取负；sin 还要 乘上 x 的 符号
+                I sign = (q << sign_shift) & sign_mask<I>();
+                if constexpr (!Cos) {
+                    sign = sign ^ ((I)x & sign_mask<I>());
+                }
+                r = (V)((I)r ^ sign);
+
+                // 大参数 / inf / NaN
+                if (!all_lanes_set(ax <= C::limit)) {
+                    for (std::size_t i = 0; i < sizeof(V) / sizeof(T); ++i) {
+                        if (!(std::fabs(x[i]) <= C::limit)) {
+                            r[i] = Cos ? std::cos(x[i]) : std::sin(x[i]);
+                        }
+                    }
+                }
+                return r;
+            }
+        };
+
+        // ---------------- tanh / sigmoid ----------------
+
+        template <class T>
+        struct tanh_consts;
+
+        template <>
+        struct tanh_consts<float> {
+            static constexpr float clamp = 20.0f; // tanh(20) 已经 舍入为 1
+            static constexpr float p[] = {-5.70498872745e-3f, 2.06390887954e-2f, -5.37397155531e-2f, 1.33314422036e-1f, -3.33332819422e-1f};
+            static constexpr float p_fast[] = {1.519534923e-2f, -5.194788426e-2f, 1.330817491e-1f, -3.333234191e-1f};
+        };
+
+        template <>
+        struct tanh_consts<double> {
+            static constexpr double clamp = 40.0;
+            static constexpr double p[] = {-9.64399179425052238628e-1, -9.92877231001918586564e1, -1.61468768441708447952e3};
+            static constexpr double q[] = {1.0, 1.12811678491632931402e2, 2.23548839060100448583e3, 4.84406305325125486048e3};
+        };
+
+        struct tanh_op {
+            template <bool Fast, class V>
+            static E_MATH_ALWAYS_INLINE V apply(V x) {
+                using T = elem_t<V>;
+                using I = ivec_t<V>;
+                using C = tanh_consts<T>;
+
+                // |x| < 0.625：奇函数 多项式 / 有理式
+                V z = x * x;
+                V small;
+                if constexpr (std::is_same_v<T, double>) {
+                    small = x + x * z * (poly(z, C::p) / poly(z, C::q));
+                } else {
+                    small = x + x * z * (Fast ? poly(z, C::p_fast) : poly(z, C::p));
+                }
+
+                // 其余：1 - 2 / (e^2|x| + 1)，再带上 x 的 符号
+                V ax = vabs(x);
+                V c = ax > C::clamp ? splat<V>(C::clamp) : ax;
+                V e = exp_core<Fast>(c + c);
+                V large = T(1) - T(2) / (e + T(1));
+                large = (V)((I)large | ((I)x & sign_mask<I>()));
+
+                return ax < T(0.625) ? small : large;
+            }
+        };
+
+        // x >= 0：1 / (1 + e^-x)；x < 0：e^x / (1 + e^x)，两端 都没有 抵消
+        struct sigmoid_op {
+            template <bool Fast, class V>
+            static E_MATH_ALWAYS_INLINE V apply(V x) {
+                using T = elem_t<V>;
+                using C = exp_consts<T>;
+                V nx = -vabs(x);
+                V e = exp_core<Fast>(nx < C::lo ? splat<V>(C::lo) : nx);
+                V d = e + T(1);
+                return x >= T(0) ? T(1) / d : e / d;
+            }
+        };
+
+        // 整个向量 读写；尾部 补 0 凑满 一个向量
+        template <class T, std::size_t Bytes, class Op, bool Fast>
+        E_MATH_ALWAYS_INLINE void map(const T* in, T* out, std::size_t n) {
+            using V = vec<T, Bytes>;
+            constexpr std::size_t w = detail::vec_size<T, Bytes>;
+            std::size_t i = 0;
+            for (; i + w <= n; i += w) {
+                V x;
+                std::memcpy(&x, in + i, sizeof(V));
+                V r = Op::template apply<Fast>(x);
+                std::memcpy(out + i, &r, sizeof(V));
+            }
+            if (i < n) {
+                T buf[w] = {};
+                std::memcpy(buf, in + i, (n - i) * sizeof(T));
+                V x;
+                std::memcpy(&x, buf, sizeof(V));
+                V r = Op::template apply<Fast>(x);
+                std::memcpy(buf, &r, sizeof(V));
+                std::memcpy(out + i, buf, (n - i) * sizeof(T));
+            }
+        }
+#else
+        // 没有 GCC 向量扩展 的 编译器（MSVC）：逐个调用 <cmath>，fast 与 accurate 相同
+        struct exp_op {
+            template <bool Fast, class T>
+            static T apply(T x) { return std::exp(x); }
+        };
+
+        struct log_op {
+            template <bool Fast, class T>
+            static T apply(T x) { return std::log(x); }
+        };
+
+        template <bool Cos>
+        struct trig_op {
+            template <bool Fast, class T>
+            static T apply(T x) { return Cos ? std::cos(x) : std::sin(x); }
+        };
+
+        struct tanh_op {
+            template <bool Fast, class T>
+            static T apply(T x) { return std::tanh(x); }
+        };
+
+        struct sigmoid_op {
+            template <bool Fast, class T>
+            static T apply(T x) { return sigmoid_scalar(x); }
+        };
+
+        template <class T, std::size_t Bytes, class Op, bool Fast>
+        void map(const T* in, T* out, std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) out[i] = Op::template apply<Fast>(in[i]);
+        }
+#endif
+
+        template <class T>
+        using unary_fn = void (*)(const T* in, T* out, std::size_t n);
+
+        template <class T>
+        struct unary_kernels {
+            unary_fn<T> exp;
+            unary_fn<T> log;
+            unary_fn<T> sin;
+            unary_fn<T> cos;
+            unary_fn<T> tanh;
+            unary_fn<T> sigmoid;
+        };
+
+        // 下标 是 precision
+        struct vmath_kernel_set {
+            unary_kernels<float> f32[2];
+            unary_kernels<double> f64[2];
+        };
+
+#define E_MATH_VMATH_KERNEL(isa, target, bytes, T, name, op, fast)                                                             \
+        target void name##_##isa(const T* in, T* out, std::size_t n) { map<T, bytes, op, fast>(in, out, n); }
+
+#define E_MATH_VMATH_KERNELS_FOR(isa, target, bytes, T, type, fast, prec)                                                      \
+        E_MATH_VMATH_KERNEL(isa, target, bytes, T, exp_##type##_##prec, exp_op, fast)                                          \
+        E_MATH_VMATH_KERNEL(isa, target, bytes, T, log_##type##_##prec, log_op, fast)                                          \
+        E_MATH_VMATH_KERNEL(isa, target, bytes, T, sin_##type##_##prec, trig_op<false>, fast)                                  \
+        E_MATH_VMATH_KERNEL(isa, target, bytes, T, cos_##type##_##prec, trig_op<true>, fast)                                   \
+        E_MATH_VMATH_KERNEL(isa, target, bytes, T, tanh_##type##_##prec, tanh_op, fast)                                        \
+        E_MATH_VMATH_KERNEL(isa, target, bytes, T, sigmoid_##type##_##prec, sigmoid_op, fast)
+
+#define E_MATH_VMATH_TABLE(isa, type, prec)                                                                                     \
+        {exp_##type##_##prec##_##isa, log_##type##_##prec##_##isa, sin_##type##_##prec##_##isa,                                 \
+         cos_##type##_##prec##_##isa, tanh_##type##_##prec##_##isa, sigmoid_##type##_##prec##_##isa}
+
+#define E_MATH_VMATH_KERNELS(isa, target, bytes)                                                                               \
+        E_MATH_VMATH_KERNELS_FOR(isa, target, bytes, float, f32, false, acc)                                                   \
+        E_MATH_VMATH_KERNELS_FOR(isa, target, bytes, float, f32, true, fast)                                                   \
+        E_MATH_VMATH_KERNELS_FOR(isa, target, bytes, double, f64, false, acc)                                                  \
+        E_MATH_VMATH_KERNELS_FOR(isa, target, bytes, double, f64, true, fast)                                                  \
+        constexpr vmath_kernel_set vmath_kernels_##isa = {                                                                      \
+            {E_MATH_VMATH_TABLE(isa, f32, acc), E_MATH_VMATH_TABLE(isa, f32, fast)},                                            \
+            {E_MATH_VMATH_TABLE(isa, f64, acc), E_MATH_VMATH_TABLE(isa, f64, fast)},                                            \
+        };
+
+        E_MATH_VMATH_KERNELS(base, , detail::base_vec_bytes)
+#if E_MATH_X86 && E_MATH_HAS_NATIVE_VEC
+        E_MATH_VMATH_KERNELS(avx2, E_MATH_TARGET_AVX2, 32)
+        E_MATH_VMATH_KERNELS(avx512, E_MATH_TARGET_AVX512, 64)
+#endif
+
+#undef E_MATH_VMATH_KERNELS
+#undef E_MATH_VMATH_TABLE
+#undef E_MATH_VMATH_KERNELS_FOR
+#undef E_MATH_VMATH_KERNEL
+
+        const vmath_kernel_set& select_vmath_kernels() {
+#if E_MATH_X86 && E_MATH_HAS_NATIVE_VEC
+            switch (detail::cpu_simd_level()) {
+                case detail::simd_level::avx512: return vmath_kernels_avx512;
+                case detail::simd_level::avx2: return vmath_kernels_avx2;
+                default: break;
+            }
+#endif
+            return vmath_kernels_base;
+        }
+
+        const vmath_kernel_set& g_vmath = select_vmath_kernels();
+
+        template <class T>
+        const unary_kernels<T>& kernels(precision p) {
+            if constexpr (std::is_same_v<T, float>) {
+                return g_vmath.f32[p == precision::fast];
+            } else {
+                return g_vmath.f64[p == precision::fast];
+            }
+        }
+
+        template <class T>
+        void run(std::span<const T> in, std::span<T> out, unary_fn<T> fn) {
+            if (in.size() != out.size()) {
+                throw std::invalid_argument("e_math::vmath: spans must have the same size");
+            }
+            fn(in.data(), out.data(), in.size());
+        }
+    }
+
+    void exp(std::span<const float> in, std::span<float> out, precision p) {
+        run(in, out, kernels<float>(p).exp);
+    }
+
+    void exp(std::span<const double> in, std::span<double> out, precision p) {
+        run(in, out, kernels<double>(p).exp);
+    }
+
+    void log(std::span<const float> in, std::span<float> out, precision p) {
+        run(in, out, kernels<float>(p).log);
+    }
+
+    void log(std::span<const double> in, std::span<double> out, precision p) {
+        run(in, out, kernels<double>(p).log);
+    }
+
+    void sin(std::span<const float> in, std::span<float> out, precision p) {
+        run(in, out, kernels<float>(p).sin);
+    }
+
+    void sin(std::span<const double> in, std::span<double> out, precision p) {
+        run(in, out, kernels<double>(p).sin);
+    }
+
+    void cos(std::span<const float> in, std::span<float> out, precision p) {
+        run(in, out, kernels<float>(p).cos);
+    }
+
+    void cos(std::span<const double> in, std::span<double> out, precision p) {
+        run(in, out, kernels<double>(p).cos);
+    }
+
+    void tanh(std::span<const float> in, std::span<float> out, precision p) {
+        run(in, out, kernels<float>(p).tanh);
+    }
+
+    void tanh(std::span<const double> in, std::span<double> out, precision p) {
+        run(in, out, kernels<double>(p).tanh);
+    }
+
+    void sigmoid(std::span<const float> in, std::span<float> out, precision p) {
+        run(in, out, kernels<float>(p).sigmoid);
+    }
+
+    void sigmoid(std::span<const double> in, std::span<double> out, precision p) {
+        run(in, out, kernels<double>(p).sigmoid);
+    }
+}
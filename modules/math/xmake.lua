@@ -3,6 +3,7 @@ target("math")
     add_deps("utils")  -- 添加依赖
     add_files("src/*.cpp") -- 添加源文件
     add_includedirs("include", {public = true}) -- 添加头文件目录
+    add_cxflags("gcc::-Wno-psabi") -- src/e_lanes.hpp 的 宽向量 只在 强制内联 函数间 传递，不涉及 ABI
     if is_plat("windows") then
         add_rules("utils.symbols.export_all", {export_classes = true})
     end
\ No newline at end of file
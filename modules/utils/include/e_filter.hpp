@@ -0,0 +1,196 @@
+#ifndef E_UTILS_FILTER_H
+#define E_UTILS_FILTER_H
+
+// 近似 集合：昂贵 的 查找 之前 先 问 一下，"不在" 是 确定 的，"在" 有 一定 误判率
+// 两种 过滤器 都 只 接收 64 位 哈希 值，键 先 用 e_utils::hash64 之类 的 好 哈希 算一遍
+//
+// bloom_filter：分块 Bloom 过滤器（split block），每个 元素 只 落在 一个 32 字节 块 里，
+//   块 的 8 个 32 位 字 各 置 1 位；一次 查询 只碰 一个 缓存行，AVX2 下 一条 指令 检查 8 位
+//   只能 插入，不能 删除
+// cuckoo_filter：布谷鸟 过滤器，4 槽 一桶，存 8 / 16 / 32 位 指纹；每个 元素 有 两个 候选 桶，
+//   查询 只看 这两个 桶；支持 删除，但 只能 删 确实 插入过 的 元素（否则 可能 删掉 别人 的 指纹）
+//   同一 元素 可以 插入 多次，删除 一次 去掉 一份
+//
+// 批量 查询 先 算出 一段 元素 的 位置 并 预取，再 逐个 检查，把 缓存 未命中 叠 在 一起
+//
+// 序列化：bytes() 就是 完整 的 序列化 结果（64 字节 头 + 数据），可以 直接 写 文件
+//   读 的 时候 不用 反序列化：mmap 之后 交给 bloom_filter_view / cuckoo_filter_view 直接 查
+//   也 可以 用 bytes 构造 bloom_filter / cuckoo_filter，拷贝 一份 继续 插入
+//   按 本机 字节序 存储（x86 / ARM 都是 小端）；头 不对、长度 不对 抛 std::invalid_argument
+//
+// 同一个 过滤器 可以 多线程 同时 查询；插入 / 删除 与 其他 操作 不能 并发
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace e_utils {
+    namespace detail {
+        // 64 字节 对齐 的 字节 缓冲，头 + 数据 放在 一起
+        class filter_storage {
+        public:
+            filter_storage() = default;
+            explicit filter_storage(std::size_t size);
+            filter_storage(const filter_storage& other);
+            filter_storage(filter_storage&& other) noexcept;
+            filter_storage& operator=(filter_storage other) noexcept;
+            ~filter_storage();
+
+            std::byte* data() const noexcept { return data_; }
+            std::size_t size() const noexcept { return size_; }
+
+        private:
+            std::byte* data_ = nullptr;
+            std::size_t size_ = 0;
+        };
+    }
+
+    class bloom_filter_view {
+    public:
+        // 不 拷贝，bytes 要 在 view 用完 之前 一直 有效；对齐 没有 要求
+        explicit bloom_filter_view(std::span<const std::byte> bytes);
+
+        bool contains(std::uint64_t hash) const noexcept;
+
+        // out[i] = contains(hashes[i])，返回 true 的 个数；长度 不同 抛 std::invalid_argument
+        std::size_t contains(std::span<const std::uint64_t> hashes, std::span<bool> out) const;
+
+        std::uint64_t blocks() const noexcept { return blocks_; }
+
+        // 插入 次数（重复 插入 也 算）
+        std::uint64_t items() const noexcept { return items_; }
+
+    private:
+        friend class bloom_filter;
+
+        bloom_filter_view(const std::byte* data, std::uint64_t blocks, std::uint64_t items) noexcept
+            : data_(data), blocks_(blocks), items_(items) {}
+
+        const std::byte* data_ = nullptr;
+        std::uint64_t blocks_ = 0;
+        std::uint64_t items_ = 0;
+    };
+
+    class bloom_filter {
+    public:
+        static constexpr std::size_t block_bytes = 32;
+
+        // 按 预计 元素数 与 目标 误判率 定 大小；参数 不合理 抛 std::invalid_argument
+        bloom_filter(std::size_t expected_items, double false_positive_rate);
+
+        // 从 序列化 结果 拷贝 一份
+        explicit bloom_filter(std::span<const std::byte> bytes);
+
+        // 满足 误判率 的 最少 块 数（每块 32 字节）
+        static std::uint64_t blocks_for(std::size_t expected_items, double false_positive_rate);
+
+        // blocks 个 块 装 items 个 元素 时 的 误判率
+        static double estimate_false_positive_rate(std::uint64_t blocks, std::uint64_t items);
+
+        void insert(std::uint64_t hash) noexcept;
+        void insert(std::span<const std::uint64_t> hashes) noexcept;
+
+        bool contains(std::uint64_t hash) const noexcept { return view().contains(hash); }
+
+        std::size_t contains(std::span<const std::uint64_t> hashes, std::span<bool> out) const {
+            return view().contains(hashes, out);
+        }
+
+        std::uint64_t blocks() const noexcept { return blocks_; }
+        std::uint64_t items() const noexcept;
+
+        // 按 当前 插入 次数 估计 的 误判率
+        double false_positive_rate() const { return estimate_false_positive_rate(blocks_, items()); }
+
+        std::span<const std::byte> bytes() const noexcept { return {storage_.data(), storage_.size()}; }
+        bloom_filter_view view() const noexcept;
+
+    private:
+        void insert_block(std::uint64_t hash) noexcept;
+
+        detail::filter_storage storage_;
+        std::uint64_t blocks_ = 0;
+    };
+
+    class cuckoo_filter_view {
+    public:
+        explicit cuckoo_filter_view(std::span<const std::byte> bytes);
+
+        bool contains(std::uint64_t hash) const noexcept;
+        std::size_t contains(std::span<const std::uint64_t> hashes, std::span<bool> out) const;
+
+        std::uint64_t buckets() const noexcept { return mask_ + 1; }
+        unsigned fingerprint_bits() const noexcept { return bits_; }
+
+        // 当前 元素 个数
+        std::uint64_t size() const noexcept { return size_; }
+
+    private:
+        friend class cuckoo_filter;
+
+        cuckoo_filter_view() = default;
+
+        const std::byte* data_ = nullptr;
+        std::uint64_t mask_ = 0;
+        unsigned bits_ = 0;
+        std::uint64_t size_ = 0;
+        // 插入 时 踢不出去 的 那个 指纹，存在 头 里
+        bool has_victim_ = false;
+        std::uint32_t victim_fingerprint_ = 0;
+        std::uint64_t victim_bucket_ = 0;
+    };
+
+    class cuckoo_filter {
+    public:
+        static constexpr std::size_t bucket_slots = 4;
+
+        // 一次 插入 最多 踢 多少 次
+        static constexpr unsigned max_kicks = 500;
+
+        // 按 容量 与 目标 误判率 选 指纹 位数 与 桶 数（2 的 幂，装载 不超过 95%）
+        // 误判率 约为 8 / 2^bits，小于 8 / 2^32 做不到，抛 std::invalid_argument
+        cuckoo_filter(std::size_t capacity, double false_positive_rate);
+
+        explicit cuckoo_filter(std::span<const std::byte> bytes);
+
+        // 满足 误判率 的 最少 指纹 位数：8、16 或 32
+        static unsigned fingerprint_bits_for(double false_positive_rate);
+
+        // 放不下 时 返回 false，已有 内容 不变
+        bool insert(std::uint64_t hash) noexcept;
+
+        // 删掉 一份 指纹；没有 返回 false
+        bool erase(std::uint64_t hash) noexcept;
+
+        bool contains(std::uint64_t hash) const noexcept { return view().contains(hash); }
+
+        std::size_t contains(std::span<const std::uint64_t> hashes, std::span<bool> out) const {
+            return view().contains(hashes, out);
+        }
+
+        std::uint64_t size() const noexcept { return view().size(); }
+        std::uint64_t buckets() const noexcept { return mask_ + 1; }
+        std::uint64_t capacity() const noexcept { return buckets() * bucket_slots; }
+        unsigned fingerprint_bits() const noexcept { return bits_; }
+
+        std::span<const std::byte> bytes() const noexcept { return {storage_.data(), storage_.size()}; }
+        cuckoo_filter_view view() const noexcept;
+
+    private:
+        void init(std::uint64_t buckets, unsigned bits);
+
+        template <class T>
+        bool insert_impl(std::uint64_t hash) noexcept;
+
+        template <class T>
+        bool erase_impl(std::uint64_t hash) noexcept;
+
+        detail::filter_storage storage_;
+        std::uint64_t mask_ = 0;
+        unsigned bits_ = 0;
+        // 踢 的 时候 选 槽 用 的 随机 状态
+        std::uint64_t rng_ = 0x9e3779b97f4a7c15ull;
+    };
+}
+
+#endif // E_UTILS_FILTER_H
@@ -0,0 +1,630 @@
+#ifndef E_UTILS_FLAT_HASH_MAP_H
+#define E_UTILS_FLAT_HASH_MAP_H
+
+// 开放寻址 哈希表，Swiss table 布局：元素 直接 放在 一个 连续 数组 里，另有 每 槽 1 字节 的 控制 字节
+//   控制 字节：空 = 0x80，已删除 = 0xFE，有元素 = 哈希 的 低 7 位（H2）
+//   查找 时 一次 读 一组（SSE2 为 16 个，其他 平台 用 64 位 整数 模拟 8 个）控制 字节，与 H2 并行 比较，
+//   只有 H2 相同 的 槽 才 比较 键；组 里 有 空槽 就 说明 键 不存在
+// 容量 是 2 的 幂，最多 装 7/8；删除 留下 墓碑，墓碑 多了 在 原 容量 上 重建
+//
+// 与 std::unordered_map 的 区别：
+//   插入 可能 搬动 元素，任何 插入 之后 迭代器、指针、引用 都 失效；删除 只让 被删 元素 的 失效
+//   迭代 顺序 不确定；key / value 要 能 移动 构造
+// 哈希 与 相等 可以 替换；两者 都 有 is_transparent 时 可以 用 别的 类型 查找（例如 std::string 键 用 std::string_view 查）
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// 可以 预先 定义 为 0，在 x86 上 测 通用 实现
+#ifndef E_UTILS_GROUP_SSE2
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define E_UTILS_GROUP_SSE2 1
+    #else
+        #define E_UTILS_GROUP_SSE2 0
+    #endif
+#endif
+
+#if E_UTILS_GROUP_SSE2
+    #include <emmintrin.h>
+#endif
+
+namespace e_utils {
+    namespace detail {
+        // murmur3 的 fmix64：每一位 输入 都 影响 所有 输出 位
+        constexpr std::uint64_t hash_mix(std::uint64_t h) noexcept {
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdull;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ull;
+            h ^= h >> 33;
+            return h;
+        }
+    }
+
+    // 默认 哈希：std::hash 再 混合 一次；整数 的 std::hash 通常 是 恒等，高位 低位 都 要 有 熵 才能 拆成 H1 / H2
+    template <class T>
+    struct hash {
+        std::size_t operator()(const T& v) const noexcept(noexcept(std::hash<T>{}(v))) {
+            return static_cast<std::size_t>(detail::hash_mix(std::hash<T>{}(v)));
+        }
+    };
+
+    // 字符串 哈希 是 透明的：std::string、std::string_view、const char* 得到 相同 的 值
+    template <>
+    struct hash<std::string_view> {
+        using is_transparent = void;
+
+        std::size_t operator()(std::string_view s) const noexcept {
+            return static_cast<std::size_t>(detail::hash_mix(std::hash<std::string_view>{}(s)));
+        }
+    };
+
+    template <>
+    struct hash<std::string> : hash<std::string_view> {};
+
+    namespace detail {
+        using ctrl_t = std::int8_t;
+
+        inline constexpr ctrl_t ctrl_empty = -128;  // 0x80
+        inline constexpr ctrl_t ctrl_deleted = -2;  // 0xFE
+
+        // 一组 控制 字节；match_* 返回 位掩码，每个 槽 占 2^shift 位
+        struct ctrl_group {
+#if E_UTILS_GROUP_SSE2
+            static constexpr std::size_t width = 16;
+            static constexpr int shift = 0;
+
+            __m128i ctrl;
+
+            explicit ctrl_group(const ctrl_t* p) noexcept : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) {}
+
+            std::uint64_t match(ctrl_t h2) const noexcept {
+                return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)));
+            }
+
+            std::uint64_t match_empty() const noexcept { return match(ctrl_empty); }
+
+            // 空 或 墓碑：最高位 为 1
+            std::uint64_t match_free() const noexcept { return static_cast<std::uint32_t>(_mm_movemask_epi8(ctrl)); }
+
+            std::uint64_t match_full() const noexcept { return match_free() ^ 0xffff; }
+
+            static std::size_t leading(std::uint64_t m) noexcept { return static_cast<std::size_t>(std::countl_zero(m)) - 48; }
+#else
+            static constexpr std::size_t width = 8;
+            static constexpr int shift = 3;
+            static constexpr std::uint64_t lsbs = 0x0101010101010101ull;
+            static constexpr std::uint64_t msbs = 0x8080808080808080ull;
+
+            std::uint64_t ctrl = 0;
+
+            // 按 字节 拼，与 大小端 无关；小端 上 编译器 会 合成 一次 读
+            explicit ctrl_group(const ctrl_t* p) noexcept {
+                for (std::size_t i = 0; i < width; ++i) ctrl |= std::uint64_t(static_cast<std::uint8_t>(p[i])) << (8 * i);
+            }
+
+            // 经典 的 “字节 为 0” 位 技巧；误报 只 落在 有元素 的 槽 上（空 / 墓碑 的 最高位 被 ~x 清掉），比较 键 时 会 排除
+            std::uint64_t match(ctrl_t h2) const noexcept {
+                const std::uint64_t x = ctrl ^ (lsbs * static_cast<std::uint8_t>(h2));
+                return (x - lsbs) & ~x & msbs;
+            }
+
+            // 空 0x80 的 第 1 位 是 0，墓碑 0xFE 是 1
+            std::uint64_t match_empty() const noexcept { return ctrl & ~(ctrl << 6) & msbs; }
+
+            std::uint64_t match_free() const noexcept { return ctrl & msbs; }
+
+            std::uint64_t match_full() const noexcept { return ~ctrl & msbs; }
+
+            static std::size_t leading(std::uint64_t m) noexcept { return static_cast<std::size_t>(std::countl_zero(m)) >> shift; }
+#endif
+
+            // m 为 0 时 返回 width
+            static std::size_t trailing(std::uint64_t m) noexcept {
+                return m == 0 ? width : static_cast<std::size_t>(std::countr_zero(m)) >> shift;
+            }
+
+            static std::size_t lowest(std::uint64_t m) noexcept { return static_cast<std::size_t>(std::countr_zero(m)) >> shift; }
+
+            // 每个 槽 最多 一位 为 1
+            static std::uint64_t clear_lowest(std::uint64_t m) noexcept { return m & (m - 1); }
+        };
+
+        template <class H, class E>
+        concept transparent_lookup = requires {
+            typename H::is_transparent;
+            typename E::is_transparent;
+        };
+    }
+
+    template <class K, class V, class Hash = hash<K>, class Eq = std::equal_to<>>
+    class flat_hash_map {
+        using group = detail::ctrl_group;
+        using ctrl_t = detail::ctrl_t;
+
+    public:
+        using key_type = K;
+        using mapped_type = V;
+        using value_type = std::pair<const K, V>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using hasher = Hash;
+        using key_equal = Eq;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+
+        template <bool Const>
+        class basic_iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = flat_hash_map::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+            using reference = std::conditional_t<Const, const value_type&, value_type&>;
+
+            basic_iterator() = default;
+
+            // iterator 可以 转成 const_iterator
+            template <bool C = Const>
+                requires C
+            basic_iterator(const basic_iterator<false>& other) noexcept : map_(other.map_), index_(other.index_) {}
+
+            reference operator*() const noexcept { return map_->slots_[index_]; }
+            pointer operator->() const noexcept { return map_->slots_ + index_; }
+
+            basic_iterator& operator++() noexcept {
+                index_ = map_->next_full(index_ + 1);
+                return *this;
+            }
+
+            basic_iterator operator++(int) noexcept {
+                basic_iterator old = *this;
+                ++*this;
+                return old;
+            }
+
+            friend bool operator==(const basic_iterator&, const basic_iterator&) = default;
+
+        private:
+            friend class flat_hash_map;
+            friend class basic_iterator<!Const>;
+            using map_pointer = std::conditional_t<Const, const flat_hash_map*, flat_hash_map*>;
+
+            basic_iterator(map_pointer map, size_type index) noexcept : map_(map), index_(index) {}
+
+            map_pointer map_ = nullptr;
+            size_type index_ = 0;
+        };
+
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+
+        flat_hash_map() = default;
+
+        explicit flat_hash_map(size_type n, const Hash& h = Hash(), const Eq& eq = Eq()) : hash_(h), eq_(eq) { reserve(n); }
+
+        flat_hash_map(std::initializer_list<value_type> init, const Hash& h = Hash(), const Eq& eq = Eq()) : hash_(h), eq_(eq) {
+            reserve(init.size());
+            insert(init.begin(), init.end());
+        }
+
+        flat_hash_map(const flat_hash_map& other) : hash_(other.hash_), eq_(other.eq_) {
+            reserve(other.size_);
+            for (const auto& v : other) insert_new(hash_(v.first), v.first, v.second);
+        }
+
+        flat_hash_map(flat_hash_map&& other) noexcept
+            : slots_(std::exchange(other.slots_, nullptr)), ctrl_(std::exchange(other.ctrl_, nullptr)),
+              capacity_(std::exchange(other.capacity_, 0)), size_(std::exchange(other.size_, 0)),
+              growth_left_(std::exchange(other.growth_left_, 0)), hash_(other.hash_), eq_(other.eq_) {}
+
+        flat_hash_map& operator=(const flat_hash_map& other) {
+            if (this != &other) {
+                flat_hash_map copy(other);
+                swap(copy);
+            }
+            return *this;
+        }
+
+        flat_hash_map& operator=(flat_hash_map&& other) noexcept {
+            if (this != &other) {
+                flat_hash_map moved(std::move(other));
+                swap(moved);
+            }
+            return *this;
+        }
+
+        ~flat_hash_map() {
+            destroy_all();
+            deallocate();
+        }
+
+        void swap(flat_hash_map& other) noexcept {
+            using std::swap;
+            swap(slots_, other.slots_);
+            swap(ctrl_, other.ctrl_);
+            swap(capacity_, other.capacity_);
+            swap(size_, other.size_);
+            swap(growth_left_, other.growth_left_);
+            swap(hash_, other.hash_);
+            swap(eq_, other.eq_);
+        }
+
+        friend void swap(flat_hash_map& a, flat_hash_map& b) noexcept { a.swap(b); }
+
+        // ---------------- 容量 ----------------
+
+        bool empty() const noexcept { return size_ == 0; }
+        size_type size() const noexcept { return size_; }
+        size_type capacity() const noexcept { return capacity_; }
+        float load_factor() const noexcept { return capacity_ == 0 ? 0.0f : static_cast<float>(size_) / static_cast<float>(capacity_); }
+
+        // 之后 插入 到 n 个 元素 都 不会 重新 分配
+        void reserve(size_type n) {
+            const size_type target = capacity_for(n);
+            if (target > capacity_) rehash_to(target);
+        }
+
+        // 删掉 所有 元素，保留 容量
+        void clear() noexcept {
+            destroy_all();
+            if (capacity_ != 0) reset_ctrl();
+            size_ = 0;
+        }
+
+        // ---------------- 迭代 ----------------
+
+        iterator begin() noexcept { return {this, next_full(0)}; }
+        iterator end() noexcept { return {this, capacity_}; }
+        const_iterator begin() const noexcept { return {this, next_full(0)}; }
+        const_iterator end() const noexcept { return {this, capacity_}; }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend() const noexcept { return end(); }
+
+        // ---------------- 查找 ----------------
+
+        iterator find(const K& key) { return {this, find_index(key)}; }
+        const_iterator find(const K& key) const { return {this, find_index(key)}; }
+        bool contains(const K& key) const { return find_index(key) != capacity_; }
+        size_type count(const K& key) const { return contains(key) ? 1 : 0; }
+
+        template <class Q>
+            requires detail::transparent_lookup<Hash, Eq>
+        iterator find(const Q& key) {
+            return {this, find_index(key)};
+        }
+
+        template <class Q>
+            requires detail::transparent_lookup<Hash, Eq>
+        const_iterator find(const Q& key) const {
+            return {this, find_index(key)};
+        }
+
+        template <class Q>
+            requires detail::transparent_lookup<Hash, Eq>
+        bool contains(const Q& key) const {
+            return find_index(key) != capacity_;
+        }
+
+        template <class Q>
+            requires detail::transparent_lookup<Hash, Eq>
+        size_type count(const Q& key) const {
+            return contains(key) ? 1 : 0;
+        }
+
+        // 键 不存在 抛 std::out_of_range
+        V& at(const K& key) { return at_impl(*this, key); }
+        const V& at(const K& key) const { return at_impl(*this, key); }
+
+        template <class Q>
+            requires detail::transparent_lookup<Hash, Eq>
+        V& at(const Q& key) {
+            return at_impl(*this, key);
+        }
+
+        template <class Q>
+            requires detail::transparent_lookup<Hash, Eq>
+        const V& at(const Q& key) const {
+            return at_impl(*this, key);
+        }
+
+        // ---------------- 插入 ----------------
+        // 键 已 存在 时 什么 都 不做，返回 已有 的 元素 与 false
+
+        template <class... Args>
+        std::pair<iterator, bool> try_emplace(const K& key, Args&&... args) {
+            return try_emplace_impl(key, std::forward<Args>(args)...);
+        }
+
+        template <class... Args>
+        std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+            return try_emplace_impl(std::move(key), std::forward<Args>(args)...);
+        }
+
+        // 用 别的 类型 的 键：只有 不存在 时 才 构造 K
+        template <class Q, class... Args>
+            requires detail::transparent_lookup<Hash, Eq> && std::is_constructible_v<K, Q&&> &&
+                     (!std::is_same_v<std::remove_cvref_t<Q>, K>)
+        std::pair<iterator, bool> try_emplace(Q&& key, Args&&... args) {
+            return try_emplace_impl(std::forward<Q>(key), std::forward<Args>(args)...);
+        }
+
+        template <class... Args>
+        std::pair<iterator, bool> emplace(Args&&... args) {
+            std::pair<K, V> v(std::forward<Args>(args)...);
+            return try_emplace_impl(std::move(v.first), std::move(v.second));
+        }
+
+        std::pair<iterator, bool> insert(const value_type& v) { return try_emplace_impl(v.first, v.second); }
+
+        template <class P>
+            requires std::is_constructible_v<std::pair<K, V>, P&&>
+        std::pair<iterator, bool> insert(P&& v) {
+            return emplace(std::forward<P>(v));
+        }
+
+        template <class It>
+        void insert(It first, It last) {
+            for (; first != last; ++first) insert(*first);
+        }
+
+        void insert(std::initializer_list<value_type> init) { insert(init.begin(), init.end()); }
+
+        // 键 已 存在 时 覆盖 值
+        template <class M>
+        std::pair<iterator, bool> insert_or_assign(const K& key, M&& value) {
+            auto r = try_emplace_impl(key, std::forward<M>(value));
+            if (!r.second) r.first->second = std::forward<M>(value);
+            return r;
+        }
+
+        template <class M>
+        std::pair<iterator, bool> insert_or_assign(K&& key, M&& value) {
+            auto r = try_emplace_impl(std::move(key), std::forward<M>(value));
+            if (!r.second) r.first->second = std::forward<M>(value);
+            return r;
+        }
+
+        V& operator[](const K& key) { return try_emplace_impl(key).first->second; }
+        V& operator[](K&& key) { return try_emplace_impl(std::move(key)).first->second; }
+
+        template <class Q>
+            requires detail::transparent_lookup<Hash, Eq> && std::is_constructible_v<K, Q&&> &&
+                     (!std::is_same_v<std::remove_cvref_t<Q>, K>)
+        V& operator[](Q&& key) {
+            return try_emplace_impl(std::forward<Q>(key)).first->second;
+        }
+
+        // ---------------- 删除 ----------------
+
+        size_type erase(const K& key) { return erase_key(key); }
+
+        template <class Q>
+            requires detail::transparent_lookup<Hash, Eq> && (!std::is_convertible_v<Q, const_iterator>)
+        size_type erase(const Q& key) {
+            return erase_key(key);
+        }
+
+        // 返回 下一个 元素；其他 元素 不动，可以 边 迭代 边 删
+        iterator erase(const_iterator pos) {
+            erase_at(pos.index_);
+            return {this, next_full(pos.index_ + 1)};
+        }
+
+        iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+
+        hasher hash_function() const { return hash_; }
+        key_equal key_eq() const { return eq_; }
+
+    private:
+        static constexpr size_type min_capacity = group::width;
+
+        static constexpr bool trivially_relocatable = std::is_trivially_copyable_v<K> && std::is_trivially_copyable_v<V>;
+
+        static ctrl_t h2(std::size_t h) noexcept { return static_cast<ctrl_t>(h & 0x7f); }
+        static std::size_t h1(std::size_t h) noexcept { return h >> 7; }
+
+        // 装到 n 个 元素 需要 的 容量：2 的 幂，负载 不超过 7/8
+        static size_type capacity_for(size_type n) {
+            if (n == 0) return 0;
+            const size_type need = n + (n + 6) / 7;
+            return need <= min_capacity ? min_capacity : std::bit_ceil(need);
+        }
+
+        static size_type max_growth(size_type capacity) noexcept { return capacity - capacity / 8; }
+
+        // 前 width 个 控制 字节 复制 一份 在 末尾，任何 位置 开始 读 一组 都 不会 越界，也 自然 回绕
+        void set_ctrl(size_type i, ctrl_t c) noexcept {
+            ctrl_[i] = c;
+            if (i < group::width) ctrl_[capacity_ + i] = c;
+        }
+
+        void reset_ctrl() noexcept {
+            std::memset(ctrl_, static_cast<unsigned char>(detail::ctrl_empty), capacity_ + group::width);
+            growth_left_ = max_growth(capacity_);
+        }
+
+        size_type next_full(size_type i) const noexcept {
+            while (i < capacity_) {
+                const std::uint64_t m = group(ctrl_ + i).match_full();
+                if (m != 0) {
+                    i += group::lowest(m);
+                    // 超出 容量 的 是 开头 的 副本
+                    return i < capacity_ ? i : capacity_;
+                }
+                i += group::width;
+            }
+            return capacity_;
+        }
+
+        // 没有 找到 返回 capacity_（即 end 的 下标）
+        template <class Q>
+        size_type find_index(const Q& key) const {
+            if (size_ == 0) return capacity_;
+            return find_index(key, hash_(key));
+        }
+
+        template <class Q>
+        size_type find_index(const Q& key, std::size_t h) const {
+            const size_type mask = capacity_ - 1;
+            const ctrl_t tag = h2(h);
+            size_type pos = h1(h) & mask;
+            // 按 组 做 三角数 探测：容量 为 2 的 幂 时 能 走遍 所有 组
+            for (size_type step = group::width;; step += group::width) {
+                const group g(ctrl_ + pos);
+                for (std::uint64_t m = g.match(tag); m != 0; m = group::clear_lowest(m)) {
+                    const size_type i = (pos + group::lowest(m)) & mask;
+                    if (eq_(slots_[i].first, key)) return i;
+                }
+                if (g.match_empty() != 0) return capacity_;
+                pos = (pos + step) & mask;
+            }
+        }
+
+        // 沿 探测 序列 找 第一个 空槽 或 墓碑；表 里 总有 空槽，一定 能 找到
+        size_type find_free(std::size_t h) const noexcept {
+            const size_type mask = capacity_ - 1;
+            size_type pos = h1(h) & mask;
+            for (size_type step = group::width;; step += group::width) {
+                const std::uint64_t m = group(ctrl_ + pos).match_free();
+                if (m != 0) return (pos + group::lowest(m)) & mask;
+                pos = (pos + step) & mask;
+            }
+        }
+
+        template <class Q, class... Args>
+        std::pair<iterator, bool> try_emplace_impl(Q&& key, Args&&... args) {
+            const std::size_t h = hash_(key);
+            if (size_ != 0) {
+                const size_type i = find_index(key, h);
+                if (i != capacity_) return {iterator(this, i), false};
+            }
+            return {iterator(this, insert_new(h, std::forward<Q>(key), std::forward<Args>(args)...)), true};
+        }
+
+        // 调用方 保证 键 不存在
+        template <class Q, class... Args>
+        size_type insert_new(std::size_t h, Q&& key, Args&&... args) {
+            if (capacity_ == 0) rehash_to(min_capacity);
+            size_type i = find_free(h);
+            if (growth_left_ == 0 && ctrl_[i] == detail::ctrl_empty) {
+                grow();
+                i = find_free(h);
+            }
+            ::new (static_cast<void*>(slots_ + i))
+                value_type(std::piecewise_construct, std::forward_as_tuple(std::forward<Q>(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+            // 构造 成功 后 才 改 控制 字节，抛 异常 时 表 不变
+            if (ctrl_[i] == detail::ctrl_empty) --growth_left_;
+            set_ctrl(i, h2(h));
+            ++size_;
+            return i;
+        }
+
+        template <class Q>
+        size_type erase_key(const Q& key) {
+            const size_type i = find_index(key);
+            if (i == capacity_) return 0;
+            erase_at(i);
+            return 1;
+        }
+
+        void erase_at(size_type i) {
+            std::destroy_at(slots_ + i);
+            --size_;
+            // 包含 i 的 任何 一组 都 有 空槽 时，没有 探测 越过 过 i，可以 直接 标 空，不留 墓碑
+            const size_type before = (i - group::width) & (capacity_ - 1);
+            const std::uint64_t empty_after = group(ctrl_ + i).match_empty();
+            const std::uint64_t empty_before = group(ctrl_ + before).match_empty();
+            if (empty_before != 0 && empty_after != 0 && group::trailing(empty_after) + group::leading(empty_before) < group::width) {
+                set_ctrl(i, detail::ctrl_empty);
+                ++growth_left_;
+            } else {
+                set_ctrl(i, detail::ctrl_deleted);
+            }
+        }
+
+        template <class Self, class Q>
+        static auto& at_impl(Self& self, const Q& key) {
+            const size_type i = self.find_index(key);
+            if (i == self.capacity_) throw std::out_of_range("e_utils::flat_hash_map::at: key not found");
+            return self.slots_[i].second;
+        }
+
+        // 墓碑 占了 一半 以上 的 空位 时 原 容量 重建，否则 翻倍
+        void grow() {
+            if (size_ <= max_growth(capacity_) / 2) {
+                rehash_to(capacity_);
+            } else {
+                rehash_to(capacity_ * 2);
+            }
+        }
+
+        void rehash_to(size_type capacity) {
+            value_type* old_slots = slots_;
+            ctrl_t* old_ctrl = ctrl_;
+            const size_type old_capacity = capacity_;
+
+            allocate(capacity);
+            for (size_type i = 0; i < old_capacity; ++i) {
+                if (old_ctrl[i] < 0) continue;
+                value_type& v = old_slots[i];
+                const std::size_t h = hash_(v.first);
+                const size_type j = find_free(h);
+                if constexpr (trivially_relocatable) {
+                    std::memcpy(static_cast<void*>(slots_ + j), &v, sizeof(value_type));
+                } else {
+                    // 旧 元素 马上 销毁，它的 键 可以 移走
+                    ::new (static_cast<void*>(slots_ + j)) value_type(std::move(const_cast<K&>(v.first)), std::move(v.second));
+                    std::destroy_at(&v);
+                }
+                set_ctrl(j, h2(h));
+            }
+            growth_left_ -= size_;
+            if (old_capacity != 0) ::operator delete(static_cast<void*>(old_slots), std::align_val_t(alignof(value_type)));
+        }
+
+        // 一次 分配：capacity 个 槽，后面 跟 capacity + width 个 控制 字节
+        void allocate(size_type capacity) {
+            void* p = ::operator new(capacity * sizeof(value_type) + capacity + group::width, std::align_val_t(alignof(value_type)));
+            slots_ = static_cast<value_type*>(p);
+            ctrl_ = reinterpret_cast<ctrl_t*>(static_cast<unsigned char*>(p) + capacity * sizeof(value_type));
+            capacity_ = capacity;
+            reset_ctrl();
+        }
+
+        void deallocate() noexcept {
+            if (capacity_ != 0) ::operator delete(static_cast<void*>(slots_), std::align_val_t(alignof(value_type)));
+        }
+
+        void destroy_all() noexcept {
+            if constexpr (!std::is_trivially_destructible_v<value_type>) {
+                for (size_type i = 0; i < capacity_; ++i) {
+                    if (ctrl_[i] >= 0) std::destroy_at(slots_ + i);
+                }
+            }
+        }
+
+        value_type* slots_ = nullptr;
+        ctrl_t* ctrl_ = nullptr;
+        size_type capacity_ = 0;
+        size_type size_ = 0;
+        size_type growth_left_ = 0;
+        [[no_unique_address]] Hash hash_;
+        [[no_unique_address]] Eq eq_;
+    };
+}
+
+#endif // E_UTILS_FLAT_HASH_MAP_H
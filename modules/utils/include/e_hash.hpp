@@ -0,0 +1,89 @@
+#ifndef E_UTILS_HASH_H
+#define E_UTILS_HASH_H
+
+// 非加密 哈希 与 校验和：给 键 做 哈希、给 数据块 做 校验，不能 防 恶意 构造 的 碰撞
+//   hash64  = XXH64，与 xxHash 参考实现 的 结果 一致
+//   hash128 = MurmurHash3 x64_128，seed 小于 2^32 时 与 参考实现 的 结果 一致（low = h1，high = h2）
+//   crc32c  = CRC-32C（Castagnoli，iSCSI / ext4 / RocksDB 用 的 那个），
+//             x86 有 SSE4.2 时 用 crc32 指令（三路 交错），否则 用 slicing-by-8 查表，两者 结果 相同
+//
+// 一次性 与 流式 结果 相同：hasher64 / hasher128 的 update 可以 按 任意 长度 分段
+// hash64_batch 一次 算 很多 短键，几个 键 交错 计算，让 乘法 链 互相 重叠
+// 环境变量 E_UTILS_SIMD=scalar 关掉 crc32 指令，用于 排查 问题
+//
+// 输入 是 字符串 或 字节 区间；其它 对象 用 std::as_bytes(std::span(&x, 1)) 转成 字节
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace e_utils {
+    struct digest128 {
+        std::uint64_t low = 0;
+        std::uint64_t high = 0;
+
+        friend bool operator==(const digest128&, const digest128&) = default;
+    };
+
+    std::uint64_t hash64(std::span<const std::byte> data, std::uint64_t seed = 0) noexcept;
+
+    inline std::uint64_t hash64(std::string_view s, std::uint64_t seed = 0) noexcept {
+        return hash64(std::as_bytes(std::span(s)), seed);
+    }
+
+    digest128 hash128(std::span<const std::byte> data, std::uint64_t seed = 0) noexcept;
+
+    inline digest128 hash128(std::string_view s, std::uint64_t seed = 0) noexcept {
+        return hash128(std::as_bytes(std::span(s)), seed);
+    }
+
+    // out[i] = hash64(keys[i], seed)；长度 不同 抛 std::invalid_argument
+    void hash64_batch(std::span<const std::string_view> keys, std::span<std::uint64_t> out, std::uint64_t seed = 0);
+
+    // crc：前面 数据 的 结果，接着 算；crc32c(b, crc32c(a)) == crc32c(a + b)
+    std::uint32_t crc32c(std::span<const std::byte> data, std::uint32_t crc = 0) noexcept;
+
+    inline std::uint32_t crc32c(std::string_view s, std::uint32_t crc = 0) noexcept {
+        return crc32c(std::as_bytes(std::span(s)), crc);
+    }
+
+    class hasher64 {
+    public:
+        explicit hasher64(std::uint64_t seed = 0) noexcept { reset(seed); }
+
+        void reset(std::uint64_t seed = 0) noexcept;
+        void update(std::span<const std::byte> data) noexcept;
+        void update(std::string_view s) noexcept { update(std::as_bytes(std::span(s))); }
+
+        // 不改变 状态，之后 还能 继续 update
+        std::uint64_t digest() const noexcept;
+
+    private:
+        std::uint64_t acc_[4];
+        std::uint64_t seed_;
+        std::uint64_t total_;
+        unsigned char buffer_[32];
+        std::size_t buffered_;
+    };
+
+    class hasher128 {
+    public:
+        explicit hasher128(std::uint64_t seed = 0) noexcept { reset(seed); }
+
+        void reset(std::uint64_t seed = 0) noexcept;
+        void update(std::span<const std::byte> data) noexcept;
+        void update(std::string_view s) noexcept { update(std::as_bytes(std::span(s))); }
+
+        digest128 digest() const noexcept;
+
+    private:
+        std::uint64_t h1_;
+        std::uint64_t h2_;
+        std::uint64_t total_;
+        unsigned char buffer_[16];
+        std::size_t buffered_;
+    };
+}
+
+#endif // E_UTILS_HASH_H
@@ -0,0 +1,53 @@
+#ifndef E_UTILS_INT_CODEC_H
+#define E_UTILS_INT_CODEC_H
+
+// uint32 数组 压缩：排好序 的 ID、时间戳 之类 的 大数组 存储 / 传输 之前 压一下
+//   varint：每个 数 7 位 一字节（LEB128），小 数 省 空间，通用 兜底
+//   bitpack：每 128 个 一块，块内 减去 最小值（frame of reference）后 按 所需 位数 紧凑 存放
+//   delta_bitpack：第一个 值 单独 存，之后 做 差分 再 bitpack，适合 递增 序列；固定 步长 的 时间戳 每块 只 占 5 字节
+// bitpack 按 SIMD 友好 的 纵向 布局 存放（第 i 个 数 在 第 i % 4 路），
+//   解码 时 每个 位数 有 一个 完全 展开 的 SSE2 内核，差分 的 前缀和 在 同一 遍 里 做完
+// 64 位 时间戳 先 减去 起点 再 存；不足 128 个 的 尾巴 用 varint
+//
+// 编码 结果 自带 头（编码 方式 + 个数），decode_ints 不需要 另外 传 参数
+// 按 本机 字节序 存储；输出 空间 不够、数据 不完整 或 格式 不对 抛 std::invalid_argument
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace e_utils {
+    enum class int_codec : std::uint8_t {
+        varint,
+        bitpack,
+        delta_bitpack,
+    };
+
+    // values[i] -= values[i - 1]（第 0 个 减 prev），按 2^32 取模，原地
+    void delta_encode(std::span<std::uint32_t> values, std::uint32_t prev = 0) noexcept;
+
+    // delta_encode 的 逆：原地 前缀和
+    void delta_decode(std::span<std::uint32_t> values, std::uint32_t prev = 0) noexcept;
+
+    // 裸 varint，没有 头；返回 写了 / 读了 多少 字节
+    std::size_t varint_encode(std::span<const std::uint32_t> values, std::span<std::byte> out);
+    // 解出 out.size() 个 数
+    std::size_t varint_decode(std::span<const std::byte> in, std::span<std::uint32_t> out);
+
+    // 任何 编码 方式 的 输出 都 不会 超过 这个 大小
+    constexpr std::size_t max_encoded_ints_size(std::size_t count) noexcept { return 16 + 5 * count; }
+
+    // 返回 写了 多少 字节
+    std::size_t encode_ints(std::span<const std::uint32_t> values, std::span<std::byte> out, int_codec codec);
+    std::vector<std::byte> encode_ints(std::span<const std::uint32_t> values, int_codec codec);
+
+    // 编码 结果 里 有 多少 个 数（只看 头）
+    std::size_t encoded_ints_count(std::span<const std::byte> in);
+
+    // 返回 解出 的 个数；out 至少 encoded_ints_count(in) 个
+    std::size_t decode_ints(std::span<const std::byte> in, std::span<std::uint32_t> out);
+    std::vector<std::uint32_t> decode_ints(std::span<const std::byte> in);
+}
+
+#endif // E_UTILS_INT_CODEC_H
@@ -0,0 +1,200 @@
+#ifndef E_UTILS_LOG_H
+#define E_UTILS_LOG_H
+
+// 异步 日志：调用 处 只 把 参数 按 二进制 拷进 本线程 的 环形 缓冲，格式化 与 写出 交给 后台 线程
+//   E_LOG_INFO("add({}, {}) = {}", 1, 2, r);
+// 格式 只 支持 {}（按 顺序 替换），{{ 与 }} 输出 花括号；{} 个数 与 参数 个数 不同 编译 报错
+// 参数：整数、浮点、bool、char、枚举、字符串（const char* / std::string / std::string_view，拷贝 内容）、指针
+//
+// 每个 线程 第一次 写 日志 时 分配 一个 环形 缓冲（单 生产者 单 消费者，无锁），线程 退出 后 由 后台 回收
+// 后台 线程 轮询 所有 缓冲，一批 记录 格式化 成 一段 文本 后 一次 交给 sink（默认 写 stdout 并 fflush）
+// 缓冲 满 时 按 full_policy：drop 丢掉 这条 并 计数（后台 会 输出 一行 提示），block 等 后台 腾出 空间
+// 每行：UTC 时间 级别 内容，例如 "2026-01-02 03:04:05.678901 INFO  hello"
+//
+// 记录 里 存 的 是 格式 字符串 的 指针，动态 卸载 的 模块 卸载 之前 要 log_flush()
+// 进程 正常 退出（exit / main 返回）时 自动 log_flush()
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace e_utils {
+    enum class log_level : std::uint8_t {
+        debug,
+        info,
+        warn,
+        error,
+        off,
+    };
+
+    enum class log_full_policy : std::uint8_t {
+        drop,
+        block,
+    };
+
+    struct log_options {
+        log_level min_level = log_level::info;
+        log_full_policy full_policy = log_full_policy::drop;
+        // 每个 线程 的 缓冲 字节数，向上 取 2 的 幂；只 影响 之后 新建 的 缓冲
+        std::size_t buffer_bytes = std::size_t{1} << 20;
+        // 一批 格式化 好 的 行，在 后台 线程 调用；空 则 写 stdout
+        std::function<void(std::string_view)> sink;
+    };
+
+    // 先 log_flush() 再 换 配置
+    void set_log_options(log_options options);
+
+    // 返回 时 本 调用 之前 写入 的 日志（所有 线程）都 已 交给 sink
+    void log_flush();
+
+    // 因为 缓冲 满 被 丢掉 的 条数（累计）
+    std::uint64_t log_dropped() noexcept;
+
+    namespace detail {
+        extern std::atomic<int> g_log_min_level;
+
+        struct log_site {
+            log_level level;
+            const char* format;
+            const char* file;
+            int line;
+        };
+
+        // 把 格式化 好 的 内容 追加 到 out；args 指向 记录 里 的 参数
+        using log_format_fn = void (*)(std::string& out, const char* format, const std::byte* args);
+
+        // 在 本线程 缓冲 里 预留 args_size 字节 的 参数 区，缓冲 满 且 策略 为 drop 时 返回 nullptr
+        std::byte* log_begin(std::size_t args_size, const log_site& site, log_format_fn format);
+        // 发布 log_begin 预留 的 记录
+        void log_end() noexcept;
+
+        // 追加 format 里 下一个 {} 之前 的 文字，返回 {} 之后 的 位置（没有 {} 则 返回 结尾）
+        const char* log_append_literal(std::string& out, const char* format);
+        void log_append(std::string& out, bool v);
+        void log_append(std::string& out, char v);
+        void log_append(std::string& out, std::int64_t v);
+        void log_append(std::string& out, std::uint64_t v);
+        void log_append(std::string& out, double v);
+        void log_append(std::string& out, const void* v);
+        void log_append(std::string& out, std::string_view v);
+
+        constexpr std::size_t log_placeholders(const char* format) {
+            std::size_t n = 0;
+            for (const char* p = format; *p != '\0'; ++p) {
+                if ((p[0] == '{' && p[1] == '{') || (p[0] == '}' && p[1] == '}')) {
+                    ++p;
+                } else if (p[0] == '{' && p[1] == '}') {
+                    ++n;
+                    ++p;
+                }
+            }
+            return n;
+        }
+
+        // 参数 统一 成 几种 存储 类型
+        template <class T>
+        auto log_store(const T& v) noexcept {
+            if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, char>) {
+                return v;
+            } else if constexpr (std::is_enum_v<T>) {
+                return log_store(static_cast<std::underlying_type_t<T>>(v));
+            } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+                return static_cast<std::int64_t>(v);
+            } else if constexpr (std::is_integral_v<T>) {
+                return static_cast<std::uint64_t>(v);
+            } else if constexpr (std::is_floating_point_v<T>) {
+                return static_cast<double>(v);
+            } else if constexpr (std::is_same_v<std::decay_t<T>, const char*> || std::is_same_v<std::decay_t<T>, char*>) {
+                const char* s = v;
+                return s != nullptr ? std::string_view(s) : std::string_view("(null)");
+            } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+                return std::string_view(v);
+            } else if constexpr (std::is_pointer_v<T> || std::is_null_pointer_v<T>) {
+                return static_cast<const void*>(v);
+            } else {
+                static_assert(sizeof(T) == 0, "e_utils log: unsupported argument type");
+            }
+        }
+
+        template <class S>
+        std::size_t log_size(const S& v) noexcept {
+            if constexpr (std::is_same_v<S, std::string_view>) {
+                return sizeof(std::uint32_t) + v.size();
+            } else {
+                return sizeof(S);
+            }
+        }
+
+        template <class S>
+        void log_put(std::byte*& p, const S& v) noexcept {
+            if constexpr (std::is_same_v<S, std::string_view>) {
+                const auto n = static_cast<std::uint32_t>(v.size());
+                std::memcpy(p, &n, sizeof(n));
+                std::memcpy(p + sizeof(n), v.data(), n);
+                p += sizeof(n) + n;
+            } else {
+                std::memcpy(p, &v, sizeof(v));
+                p += sizeof(v);
+            }
+        }
+
+        template <class S>
+        S log_get(const std::byte*& p) noexcept {
+            if constexpr (std::is_same_v<S, std::string_view>) {
+                std::uint32_t n;
+                std::memcpy(&n, p, sizeof(n));
+                const std::string_view s(reinterpret_cast<const char*>(p + sizeof(n)), n);
+                p += sizeof(n) + n;
+                return s;
+            } else {
+                S v;
+                std::memcpy(&v, p, sizeof(v));
+                p += sizeof(v);
+                return v;
+            }
+        }
+
+        template <class... S>
+        void log_format(std::string& out, const char* format, [[maybe_unused]] const std::byte* args) {
+            ((format = log_append_literal(out, format), log_append(out, log_get<S>(args))), ...);
+            log_append_literal(out, format);
+        }
+
+        template <std::size_t Placeholders, class... Args>
+        void log_write(const log_site& site, const Args&... args) {
+            static_assert(Placeholders == sizeof...(Args), "e_utils log: number of {} does not match arguments");
+            const auto stored = [&](const auto&... s) {
+                std::byte* p = log_begin((std::size_t{0} + ... + log_size(s)), site, &log_format<std::decay_t<decltype(s)>...>);
+                if (p != nullptr) {
+                    (log_put(p, s), ...);
+                    log_end();
+                }
+            };
+            stored(log_store(args)...);
+        }
+    }
+
+    inline bool log_enabled(log_level level) noexcept {
+        return static_cast<int>(level) >= detail::g_log_min_level.load(std::memory_order_relaxed);
+    }
+}
+
+#define E_LOG(level, format, ...)                                                                                    \
+    do {                                                                                                             \
+        if (::e_utils::log_enabled(level)) {                                                                         \
+            static constexpr ::e_utils::detail::log_site e_log_site_{level, format, __FILE__, __LINE__};             \
+            ::e_utils::detail::log_write<::e_utils::detail::log_placeholders(format)>(e_log_site_ __VA_OPT__(, ) __VA_ARGS__); \
+        }                                                                                                            \
+    } while (false)
+
+#define E_LOG_DEBUG(...) E_LOG(::e_utils::log_level::debug, __VA_ARGS__)
+#define E_LOG_INFO(...) E_LOG(::e_utils::log_level::info, __VA_ARGS__)
+#define E_LOG_WARN(...) E_LOG(::e_utils::log_level::warn, __VA_ARGS__)
+#define E_LOG_ERROR(...) E_LOG(::e_utils::log_level::error, __VA_ARGS__)
+
+#endif // E_UTILS_LOG_H
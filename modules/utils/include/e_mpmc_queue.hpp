@@ -0,0 +1,328 @@
+#ifndef E_UTILS_MPMC_QUEUE_H
+#define E_UTILS_MPMC_QUEUE_H
+
+// 有界 多 生产者 多 消费者 队列（Vyukov 的 数组 队列）：代替 mutex + condition_variable 的 交接
+//   e_utils::mpmc_queue<job> q(1024);
+//   q.try_push(j);             // 满 了 返回 false
+//   if (q.try_pop(out)) ...    // 空 了 返回 false
+//
+// 每个 槽 有 一个 序号，占 一整条 缓存 行（元素 也 放在 这条 行 里），相邻 槽 的 读写 不会 互相 干扰
+//   生产者 / 消费者 各 只在 自己 的 位置 计数器 上 做 一次 CAS，成功 后 只碰 自己 领到 的 槽，不加锁
+//   try_push_bulk / try_pop_bulk 一次 CAS 领 连续 的 一段 槽
+//
+// blocking_mpmc_queue 在 外面 包 一层 等待：先 忙等 spin 轮，还 不行 才 睡（Linux 上 是 futex）
+//   放入 / 取出 之后 只有 有人 在 睡 的 时候 才 去 唤醒，没人 等 时 不进 内核
+//   close() 之后 push 返回 false，pop 取完 剩下 的 元素 后 返回 false
+//
+// 元素 的 移动 构造 / 移动 赋值 不能 抛 异常（领到 的 槽 不能 退回）
+// 析构 时 不能 还有 别的 线程 在 用 队列，没 取走 的 元素 一起 析构
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace e_utils {
+    namespace detail {
+        // 忙等 的 第 round 轮：前 几轮 是 CPU 的 pause 提示，之后 让出 时间片（核 不够 时 对方 才 跑得 起来）
+        void spin_wait(unsigned round) noexcept;
+        // word 仍 等于 expected 时 睡，直到 park_wake（可能 提前 醒来）
+        void park_wait(std::atomic<std::uint32_t>& word, std::uint32_t expected) noexcept;
+        void park_wake(std::atomic<std::uint32_t>& word, bool all) noexcept;
+    }
+
+    template <class T>
+    class mpmc_queue {
+        static_assert(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>,
+                      "e_utils::mpmc_queue: T must be nothrow movable");
+
+    public:
+        // 容量 向上 取 2 的 幂，至少 2
+        explicit mpmc_queue(std::size_t capacity) {
+            if (capacity == 0 || capacity > (std::size_t{1} << (sizeof(std::size_t) * 8 - 2))) {
+                throw std::invalid_argument("e_utils::mpmc_queue: capacity must be in [1, 2^62]");
+            }
+            std::size_t n = 2;
+            while (n < capacity) n <<= 1;
+            cells_.reset(new cell[n]);
+            mask_ = n - 1;
+            for (std::size_t i = 0; i < n; ++i) cells_[i].seq.store(i, std::memory_order_relaxed);
+        }
+
+        mpmc_queue(const mpmc_queue&) = delete;
+        mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+        ~mpmc_queue() {
+            const std::size_t end = enqueue_pos_.load(std::memory_order_relaxed);
+            for (std::size_t p = dequeue_pos_.load(std::memory_order_relaxed); p != end; ++p) {
+                cell& c = cells_[p & mask_];
+                if (c.seq.load(std::memory_order_relaxed) == p + 1) {
+                    c.get()->~T();
+                }
+            }
+        }
+
+        template <class... Args>
+        bool try_emplace(Args&&... args) {
+            if constexpr (std::is_nothrow_constructible_v<T, Args...>) {
+                std::size_t pos;
+                if (claim(enqueue_pos_, 1, 0, pos) == 0) {
+                    return false;
+                }
+                ::new (cells_[pos & mask_].storage) T(std::forward<Args>(args)...);
+                cells_[pos & mask_].seq.store(pos + 1, std::memory_order_release);
+                return true;
+            } else {
+                // 构造 可能 抛，先 构造 好 再 领 槽
+                T value(std::forward<Args>(args)...);
+                return try_emplace(std::move(value));
+            }
+        }
+
+        bool try_push(const T& value) { return try_emplace(value); }
+        bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+        bool try_pop(T& out) noexcept {
+            std::size_t pos;
+            if (claim(dequeue_pos_, 1, 1, pos) == 0) {
+                return false;
+            }
+            take(pos, out);
+            return true;
+        }
+
+        // 从 items 依次 移入 最多 count 个，返回 放进去 的 个数（队列 满 时 少于 count）
+        std::size_t try_push_bulk(T* items, std::size_t count) noexcept {
+            std::size_t pos;
+            const std::size_t n = claim(enqueue_pos_, count, 0, pos);
+            for (std::size_t i = 0; i < n; ++i) {
+                cell& c = cells_[(pos + i) & mask_];
+                ::new (c.storage) T(std::move(items[i]));
+                c.seq.store(pos + i + 1, std::memory_order_release);
+            }
+            return n;
+        }
+
+        // 最多 取 max_count 个 移到 out，返回 取到 的 个数
+        std::size_t try_pop_bulk(T* out, std::size_t max_count) noexcept {
+            std::size_t pos;
+            const std::size_t n = claim(dequeue_pos_, max_count, 1, pos);
+            for (std::size_t i = 0; i < n; ++i) take(pos + i, out[i]);
+            return n;
+        }
+
+        std::size_t capacity() const noexcept { return mask_ + 1; }
+
+        // 并发 时 只是 近似 值
+        std::size_t size_approx() const noexcept {
+            const std::size_t d = dequeue_pos_.load(std::memory_order_relaxed);
+            const std::size_t e = enqueue_pos_.load(std::memory_order_relaxed);
+            return e > d ? std::min(e - d, capacity()) : 0;
+        }
+
+    private:
+        struct alignas(64) cell {
+            std::atomic<std::size_t> seq;
+            alignas(T) unsigned char storage[sizeof(T)];
+
+            T* get() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+        };
+
+        // 从 counter 处 领 最多 want 个 连续 的 槽，返回 个数，first 为 第一个 的 位置
+        // 位置 p 的 槽 可 写 时 seq == p，可 读 时 seq == p + 1（ready 为 0 / 1）
+        std::size_t claim(std::atomic<std::size_t>& counter, std::size_t want, std::size_t ready, std::size_t& first) noexcept {
+            std::size_t pos = counter.load(std::memory_order_relaxed);
+            for (;;) {
+                std::size_t n = 0;
+                bool stale = false;
+                for (; n < want; ++n) {
+                    const std::size_t seq = cells_[(pos + n) & mask_].seq.load(std::memory_order_acquire);
+                    const auto diff = static_cast<std::ptrdiff_t>(seq - (pos + n + ready));
+                    if (diff != 0) {
+                        // diff < 0：满（写）或 空（读）；diff > 0：pos 已经 被 别人 领走
+                        stale = diff > 0 && n == 0;
+                        break;
+                    }
+                }
+                if (n == 0) {
+                    if (!stale) {
+                        return 0;
+                    }
+                    pos = counter.load(std::memory_order_relaxed);
+                } else if (counter.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed, std::memory_order_relaxed)) {
+                    first = pos;
+                    return n;
+                }
+            }
+        }
+
+        void take(std::size_t pos, T& out) noexcept {
+            cell& c = cells_[pos & mask_];
+            T* p = c.get();
+            out = std::move(*p);
+            p->~T();
+            c.seq.store(pos + mask_ + 1, std::memory_order_release);
+        }
+
+        std::unique_ptr<cell[]> cells_;
+        std::size_t mask_ = 0;
+
+        alignas(64) std::atomic<std::size_t> enqueue_pos_{0};
+        alignas(64) std::atomic<std::size_t> dequeue_pos_{0};
+    };
+
+    template <class T>
+    class blocking_mpmc_queue {
+    public:
+        // spin：睡 之前 忙等 的 轮数
+        explicit blocking_mpmc_queue(std::size_t capacity, unsigned spin = 64) : queue_(capacity), spin_(spin) {}
+
+        // 满 时 等；close 之后 返回 false（元素 没有 放进去）
+        bool push(T value) {
+            return wait_for<false>(
+                [&] {
+                    if (!queue_.try_push(std::move(value))) {
+                        return false;
+                    }
+                    wake(items_, item_waiters_, false);
+                    return true;
+                },
+                space_, space_waiters_);
+        }
+
+        // 空 时 等；close 且 已 取空 时 返回 false
+        bool pop(T& out) {
+            return wait_for<true>(
+                [&] {
+                    if (!queue_.try_pop(out)) {
+                        return false;
+                    }
+                    wake(space_, space_waiters_, false);
+                    return true;
+                },
+                items_, item_waiters_);
+        }
+
+        // 全部 放进去 才 返回；close 时 返回 已经 放进去 的 个数
+        std::size_t push_bulk(T* items, std::size_t count) {
+            std::size_t done = 0;
+            wait_for<false>(
+                [&] {
+                    const std::size_t n = queue_.try_push_bulk(items + done, count - done);
+                    if (n != 0) {
+                        done += n;
+                        wake(items_, item_waiters_, n > 1);
+                    }
+                    return done == count;
+                },
+                space_, space_waiters_);
+            return done;
+        }
+
+        // 等到 至少 有 一个，最多 取 max_count 个；close 且 已 取空 时 返回 0
+        std::size_t pop_bulk(T* out, std::size_t max_count) {
+            std::size_t n = 0;
+            wait_for<true>(
+                [&] {
+                    n = queue_.try_pop_bulk(out, max_count);
+                    if (n == 0) {
+                        return false;
+                    }
+                    wake(space_, space_waiters_, n > 1);
+                    return true;
+                },
+                items_, item_waiters_);
+            return n;
+        }
+
+        bool try_push(T value) {
+            if (closed() || !queue_.try_push(std::move(value))) {
+                return false;
+            }
+            wake(items_, item_waiters_, false);
+            return true;
+        }
+
+        bool try_pop(T& out) {
+            if (!queue_.try_pop(out)) {
+                return false;
+            }
+            wake(space_, space_waiters_, false);
+            return true;
+        }
+
+        // 唤醒 所有 等待 的 线程
+        void close() {
+            closed_.store(true, std::memory_order_seq_cst);
+            items_.fetch_add(1, std::memory_order_seq_cst);
+            space_.fetch_add(1, std::memory_order_seq_cst);
+            detail::park_wake(items_, true);
+            detail::park_wake(space_, true);
+        }
+
+        bool closed() const noexcept { return closed_.load(std::memory_order_acquire); }
+        std::size_t capacity() const noexcept { return queue_.capacity(); }
+        std::size_t size_approx() const noexcept { return queue_.size_approx(); }
+
+    private:
+        // 先 忙等，再 登记 后 最后 试 一次 才 睡：另一方 要么 看到 登记 来 唤醒，要么 这 一次 就 成功
+        // 消费 方（Drain）close 之后 还要 把 剩下 的 取完
+        template <bool Drain, class Attempt>
+        bool wait_for(Attempt&& attempt, std::atomic<std::uint32_t>& word, std::atomic<std::uint32_t>& waiters) {
+            for (unsigned i = 0;; ++i) {
+                if (!Drain && closed()) {
+                    return false;
+                }
+                if (attempt()) {
+                    return true;
+                }
+                if (closed()) {
+                    return Drain && attempt();
+                }
+                if (i >= spin_) {
+                    break;
+                }
+                detail::spin_wait(i);
+            }
+            for (;;) {
+                waiters.fetch_add(1, std::memory_order_seq_cst);
+                const std::uint32_t seen = word.load(std::memory_order_seq_cst);
+                const bool got = attempt();
+                if (!got && !closed()) {
+                    detail::park_wait(word, seen);
+                }
+                waiters.fetch_sub(1, std::memory_order_relaxed);
+                if (got) {
+                    return true;
+                }
+                if (closed()) {
+                    return Drain && attempt();
+                }
+            }
+        }
+
+        static void wake(std::atomic<std::uint32_t>& word, std::atomic<std::uint32_t>& waiters, bool all) noexcept {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiters.load(std::memory_order_relaxed) != 0) {
+                word.fetch_add(1, std::memory_order_seq_cst);
+                detail::park_wake(word, all);
+            }
+        }
+
+        mpmc_queue<T> queue_;
+        unsigned spin_;
+
+        alignas(64) std::atomic<std::uint32_t> items_{0}; // 有 新 元素（有人 等 时 才 变）
+        std::atomic<std::uint32_t> item_waiters_{0};
+        alignas(64) std::atomic<std::uint32_t> space_{0}; // 有 新 空位
+        std::atomic<std::uint32_t> space_waiters_{0};
+        std::atomic<bool> closed_{false};
+    };
+}
+
+#endif // E_UTILS_MPMC_QUEUE_H
@@ -0,0 +1,133 @@
+#ifndef E_UTILS_OBJECT_POOL_H
+#define E_UTILS_OBJECT_POOL_H
+
+// 定长 对象池：同一种 对象 反复 创建 / 销毁（连接、请求、消息 之类），不走 全局 new / delete
+//   e_utils::object_pool<session> pool;
+//   e_utils::pool_ptr<session> s = pool.make(fd);   // unique_ptr，析构 时 还回 池 里
+//
+// 对象 放在 slab 里（一大块 连续 内存 切 成 等长 槽），第一个 slab slab_objects 个，之后 每个 翻倍
+// 每个 线程 有 自己 的 空闲 链表，分配 / 释放 大多 只碰 本线程 的 数据，不加锁 也 没有 原子 操作
+//   线程 与 共享 的 无锁 栈 之间 按 批（thread_cache / 2 个）搬，一批 一次 CAS；栈 也 空 才 加锁 分配 新 slab
+//   线程 最多 缓存 thread_cache 个 空闲 对象，线程 退出 时 全部 还回
+//   共享 栈 的 链接 放在 slab 尾部，不 占 对象 内存，每个 对象 多 8 字节
+//   可以 在 一个 线程 创建、另一个 线程 销毁
+//
+// stats() 给出 容量 与 在用 对象 的 最高 水位，用来 定 池 的 大小（slab_objects）
+//   在用 数 由 各 线程 攒够 一批 再 汇总，有 延迟，误差 每个 线程 不超过 16 个
+//
+// 池 销毁 前 所有 对象 都要 先 还回来；slab 在 池 销毁 时 才 释放
+// 对象池 本身 不能 拷贝 和 移动（pool_ptr 里 存 的 是 它 的 地址）
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace e_utils {
+    struct pool_options {
+        // 第一个 slab 的 对象 数，向上 取 2 的 幂
+        std::size_t slab_objects = 64;
+        // 每个 线程 最多 缓存 的 空闲 对象 数，一半 为 一批
+        std::size_t thread_cache = 64;
+    };
+
+    struct pool_stats {
+        std::size_t capacity = 0; // 所有 slab 的 槽 数
+        std::size_t slabs = 0;
+        std::size_t live = 0;      // 在用 对象 数
+        std::size_t peak_live = 0; // live 的 最高 水位
+    };
+
+    namespace detail {
+        // 与 类型 无关 的 部分：按 槽 大小 与 对齐 管理 内存
+        class pool_core {
+        public:
+            pool_core(std::size_t size, std::size_t alignment, pool_options options);
+            pool_core(const pool_core&) = delete;
+            pool_core& operator=(const pool_core&) = delete;
+            ~pool_core();
+
+            void* allocate();
+            void deallocate(void* p) noexcept;
+            pool_stats stats() const noexcept;
+
+        private:
+            friend struct pool_access;
+
+            static constexpr std::size_t max_slabs = 32;
+
+            std::pair<std::size_t, std::size_t> locate(std::uint32_t index) const noexcept;
+            std::byte* slot(std::uint32_t index) const noexcept;
+            std::atomic<std::uint64_t>& link(std::uint32_t index) const noexcept;
+            std::uint32_t index_of(const void* p) const noexcept;
+            void push(std::uint32_t first, std::uint32_t last) noexcept;
+            bool pop(std::uint32_t& index) noexcept;
+            std::uint32_t grow();
+            void add_live(std::int64_t delta) noexcept;
+
+            std::size_t size_;
+            std::size_t alignment_;
+            unsigned base_shift_; // 第一个 slab 的 槽 数 = 1 << base_shift_
+            std::size_t batch_; // 线程 与 共享 栈 之间 一次 搬 多少 个
+            std::uint64_t id_;
+            std::size_t cache_slot_;
+
+            alignas(64) std::atomic<std::uint64_t> head_; // 共享 栈：高 32 位 版本号，低 32 位 批 头 的 下标
+
+            alignas(64) std::atomic<std::int64_t> live_{0};
+            std::atomic<std::int64_t> peak_{0};
+
+            std::mutex grow_mutex_;
+            std::atomic<std::size_t> slab_count_{0};
+            std::atomic<std::byte*> slabs_[max_slabs] = {};
+        };
+    }
+
+    template <class T>
+    class object_pool {
+    public:
+        struct deleter {
+            object_pool* pool = nullptr;
+
+            void operator()(T* p) const noexcept { pool->destroy(p); }
+        };
+
+        explicit object_pool(pool_options options = {}) : core_(sizeof(T), alignof(T), options) {}
+
+        template <class... Args>
+        std::unique_ptr<T, deleter> make(Args&&... args) {
+            return std::unique_ptr<T, deleter>(create(std::forward<Args>(args)...), deleter{this});
+        }
+
+        // 裸 指针 版本，用完 交给 destroy()
+        template <class... Args>
+        T* create(Args&&... args) {
+            void* p = core_.allocate();
+            try {
+                return ::new (p) T(std::forward<Args>(args)...);
+            } catch (...) {
+                core_.deallocate(p);
+                throw;
+            }
+        }
+
+        void destroy(T* p) noexcept {
+            if (p != nullptr) {
+                p->~T();
+                core_.deallocate(p);
+            }
+        }
+
+        pool_stats stats() const noexcept { return core_.stats(); }
+
+    private:
+        detail::pool_core core_;
+    };
+
+    template <class T>
+    using pool_ptr = std::unique_ptr<T, typename object_pool<T>::deleter>;
+}
+
+#endif // E_UTILS_OBJECT_POOL_H
@@ -0,0 +1,192 @@
+#ifndef E_UTILS_ROARING_H
+#define E_UTILS_ROARING_H
+
+// 压缩 位图（Roaring）：uint32 集合，稠密 稀疏 都 省 空间，集合 运算 快
+// 按 高 16 位 分 容器，每个 容器 装 低 16 位，三种 形式 自动 选择：
+//   array：排好序 的 uint16，元素 不超过 4096 个
+//   bitmap：65536 位（8 KB），元素 多于 4096 个
+//   run：(起点, 长度) 段，连续 区间 多 时 最省；add_range 与 run_optimize 产生
+// 交集 / 并集 / 差集 按 容器 两两 计算：
+//   array 与 array 求交 用 SSE4.2 一次 比较 8 对 8，长短 悬殊 时 改用 二分 跳跃
+//   bitmap 与 bitmap 按 字 运算，AVX2 / popcnt 各 一套，运行时 按 CPU 选（E_UTILS_SIMD=scalar 关掉）
+//   run 容器 先 展开 成 array 或 bitmap 再 算
+// *_cardinality 只 数 个数，不 生成 结果
+//
+// 序列化：serialize() 输出 一段 字节，roaring_view 直接 在 上面 查询、迭代、参与 运算，不 拷贝
+//   格式：16 字节 头 + 每个 容器 16 字节 描述 + 各 容器 数据（8 字节 对齐），按 本机 字节序
+//   要求 起始 地址 8 字节 对齐（mmap 的 页 对齐 满足），格式 不对 抛 std::invalid_argument
+// roaring_bitmap 可以 隐式 转成 roaring_view；view 不 拥有 数据，原 位图 修改 或 销毁 之后 失效
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <vector>
+
+namespace e_utils {
+    class roaring_bitmap;
+
+    namespace detail {
+        enum class roaring_kind : std::uint8_t {
+            array,
+            bitmap,
+            run,
+        };
+
+        // 容器 的 只读 引用，位图 自己 的 与 序列化 的 都 转成 这个
+        struct roaring_ref {
+            std::uint16_t key = 0;
+            roaring_kind kind = roaring_kind::array;
+            std::uint32_t cardinality = 0;
+            // array：元素 个数；bitmap：1024（字 数）；run：段 数
+            std::uint32_t size = 0;
+            // array / run：const uint16_t*（run 为 起点、长度-1 交替）；bitmap：const uint64_t*
+            const void* data = nullptr;
+
+            const std::uint16_t* values() const noexcept { return static_cast<const std::uint16_t*>(data); }
+            const std::uint64_t* words() const noexcept { return static_cast<const std::uint64_t*>(data); }
+        };
+
+        struct roaring_container {
+            std::uint16_t key = 0;
+            roaring_kind kind = roaring_kind::array;
+            std::uint32_t cardinality = 0;
+            std::vector<std::uint16_t> values;
+            std::vector<std::uint64_t> words;
+
+            roaring_ref ref() const noexcept;
+        };
+    }
+
+    class roaring_view {
+    public:
+        roaring_view() = default;
+        roaring_view(const roaring_bitmap& bitmap) noexcept;
+
+        // 检查 结构 与 每个 容器 的 内容（有序、不 越界、cardinality 相符）后 直接 引用 bytes，不 拷贝
+        explicit roaring_view(std::span<const std::byte> bytes);
+
+        bool contains(std::uint32_t value) const noexcept;
+        std::uint64_t cardinality() const noexcept;
+        bool empty() const noexcept { return containers_ == 0; }
+
+        // 按 从小到大 对 每个 元素 调用 f(uint32_t)
+        template <class F>
+        void for_each(F&& f) const;
+
+        std::vector<std::uint32_t> to_vector() const;
+
+        std::size_t containers() const noexcept { return containers_; }
+        detail::roaring_ref container(std::size_t i) const noexcept;
+
+    private:
+        const detail::roaring_container* owned_ = nullptr;
+        const std::byte* serialized_ = nullptr;
+        std::size_t containers_ = 0;
+    };
+
+    class roaring_bitmap {
+    public:
+        roaring_bitmap() = default;
+        roaring_bitmap(std::initializer_list<std::uint32_t> values);
+
+        // 拷贝 一份（例如 从 mmap 的 数据）
+        explicit roaring_bitmap(const roaring_view& view);
+
+        // 任意 顺序，已 排序 时 最快
+        static roaring_bitmap from_values(std::span<const std::uint32_t> values);
+
+        void add(std::uint32_t value);
+        void add_range(std::uint64_t begin, std::uint64_t end); // [begin, end)，end 最大 2^32
+        bool remove(std::uint32_t value);
+        void clear() noexcept { containers_.clear(); }
+
+        bool contains(std::uint32_t value) const noexcept { return roaring_view(*this).contains(value); }
+        std::uint64_t cardinality() const noexcept { return roaring_view(*this).cardinality(); }
+        bool empty() const noexcept { return containers_.empty(); }
+
+        template <class F>
+        void for_each(F&& f) const {
+            roaring_view(*this).for_each(static_cast<F&&>(f));
+        }
+
+        std::vector<std::uint32_t> to_vector() const { return roaring_view(*this).to_vector(); }
+
+        // 每个 容器 换成 最省 空间 的 形式（包括 run），返回 是否 有 变化
+        bool run_optimize();
+
+        roaring_bitmap& operator&=(const roaring_view& other);
+        roaring_bitmap& operator|=(const roaring_view& other);
+        roaring_bitmap& operator-=(const roaring_view& other);
+
+        std::size_t serialized_size() const noexcept;
+        // out 至少 serialized_size() 字节，返回 写了 多少
+        std::size_t serialize(std::span<std::byte> out) const;
+        std::vector<std::byte> serialize() const;
+
+    private:
+        friend class roaring_view;
+        friend roaring_bitmap operator&(const roaring_view& a, const roaring_view& b);
+        friend roaring_bitmap operator|(const roaring_view& a, const roaring_view& b);
+        friend roaring_bitmap operator-(const roaring_view& a, const roaring_view& b);
+
+        detail::roaring_container& container_for(std::uint16_t key);
+
+        std::vector<detail::roaring_container> containers_;
+    };
+
+    roaring_bitmap operator&(const roaring_view& a, const roaring_view& b);
+    roaring_bitmap operator|(const roaring_view& a, const roaring_view& b);
+    roaring_bitmap operator-(const roaring_view& a, const roaring_view& b);
+
+    std::uint64_t and_cardinality(const roaring_view& a, const roaring_view& b);
+
+    inline std::uint64_t or_cardinality(const roaring_view& a, const roaring_view& b) {
+        return a.cardinality() + b.cardinality() - and_cardinality(a, b);
+    }
+
+    inline std::uint64_t andnot_cardinality(const roaring_view& a, const roaring_view& b) {
+        return a.cardinality() - and_cardinality(a, b);
+    }
+
+    inline bool operator==(const roaring_view& a, const roaring_view& b) {
+        const std::uint64_t n = a.cardinality();
+        return n == b.cardinality() && and_cardinality(a, b) == n;
+    }
+
+    template <class F>
+    void roaring_view::for_each(F&& f) const {
+        for (std::size_t c = 0; c < containers_; ++c) {
+            const detail::roaring_ref r = container(c);
+            const std::uint32_t high = std::uint32_t{r.key} << 16;
+            switch (r.kind) {
+                case detail::roaring_kind::array: {
+                    const std::uint16_t* v = r.values();
+                    for (std::uint32_t i = 0; i < r.size; ++i) f(high | v[i]);
+                    break;
+                }
+                case detail::roaring_kind::bitmap: {
+                    const std::uint64_t* w = r.words();
+                    for (std::uint32_t i = 0; i < r.size; ++i) {
+                        for (std::uint64_t bits = w[i]; bits != 0; bits &= bits - 1) {
+                            f(high | (i * 64 + static_cast<std::uint32_t>(std::countr_zero(bits))));
+                        }
+                    }
+                    break;
+                }
+                case detail::roaring_kind::run: {
+                    const std::uint16_t* v = r.values();
+                    for (std::uint32_t i = 0; i < r.size; ++i) {
+                        const std::uint32_t start = v[2 * i];
+                        const std::uint32_t last = start + v[2 * i + 1];
+                        for (std::uint32_t x = start; x <= last; ++x) f(high | x);
+                    }
+                    break;
+                }
+            }
+        }
+    }
+}
+
+#endif // E_UTILS_ROARING_H
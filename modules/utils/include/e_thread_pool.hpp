@@ -0,0 +1,172 @@
+#ifndef E_UTILS_THREAD_POOL_H
+#define E_UTILS_THREAD_POOL_H
+
+// 工作 窃取 线程池：每个 工作 线程 一个 Chase-Lev 双端 队列
+//   工作 线程 提交 的 任务 放进 自己 队列 的 底部，自己 从 底部 取（后进先出，缓存 热），
+//   空闲 的 线程 从 别人 队列 的 顶部 偷（先进先出，偷 到 的 往往 是 大块 任务）
+//   非 工作 线程 提交 的 任务 进 一个 加锁 的 共享 队列
+//   没 活 的 线程 睡眠，提交 时 只在 有人 睡 的 时候 才 唤醒
+//
+//   e_utils::thread_pool& pool = e_utils::thread_pool::global();
+//   auto h = pool.submit([] { return 6 * 7; });
+//   pool.parallel_for(0, n, [&](std::size_t i) { out[i] = f(in[i]); });
+//   int v = h.get();
+//
+// submit 返回 task_handle，get() 等 结果（任务 的 异常 在 这里 重新 抛出）
+// parallel_for：调用 线程 也 参与；grain 为 0 时 自动 定 粒度（每个 线程 大约 8 块），
+//   块 按 顺序 动态 领取，负载 不均 时 先 做完 的 线程 多 领；第一个 异常 在 调用 线程 重新 抛出，剩下 的 块 不再 执行
+// 在 工作 线程 里 等待（task_handle::get / 嵌套 parallel_for）不会 死锁：等 的 时候 顺便 执行 别的 任务
+//
+// 析构 时 先 把 已 提交 的 任务 做完，再 结束 线程
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace e_utils {
+    struct thread_pool_options {
+        // 工作 线程 数，0 表示 std::thread::hardware_concurrency()
+        unsigned threads = 0;
+        // 第 i 个 工作 线程 绑定 到 第 i 个 CPU（Linux / Windows），避免 线程 在 核 之间 迁移
+        bool pin_threads = false;
+    };
+
+    struct parallel_options {
+        // 每块 至少 多少 个 下标，0 表示 自动
+        std::size_t grain = 0;
+        // 最多 多少 个 线程 一起 做（含 调用 线程），0 表示 不限
+        unsigned max_threads = 0;
+    };
+
+    class thread_pool;
+
+    namespace detail {
+        // 任务：run 执行 并 释放 自己
+        struct pool_task {
+            void (*run)(pool_task* self);
+        };
+
+        // 等 flag 变成 非 0；在 pool 的 工作 线程 上 等 时 帮忙 执行 任务
+        void pool_wait(thread_pool* pool, const std::atomic<std::uint32_t>& flag);
+
+        template <class R>
+        struct task_state {
+            std::atomic<std::uint32_t> ready{0};
+            std::optional<std::conditional_t<std::is_void_v<R>, bool, R>> value;
+            std::exception_ptr error;
+        };
+
+        template <class F, class R>
+        struct submit_task : pool_task {
+            submit_task(F&& f, std::shared_ptr<task_state<R>> s)
+                : pool_task{&submit_task::execute}, fn(std::move(f)), state(std::move(s)) {}
+
+            static void execute(pool_task* self) {
+                std::unique_ptr<submit_task> t(static_cast<submit_task*>(self));
+                task_state<R>& s = *t->state;
+                try {
+                    if constexpr (std::is_void_v<R>) {
+                        t->fn();
+                        s.value.emplace(true);
+                    } else {
+                        s.value.emplace(t->fn());
+                    }
+                } catch (...) {
+                    s.error = std::current_exception();
+                }
+                s.ready.store(1, std::memory_order_release);
+                s.ready.notify_all();
+            }
+
+            F fn;
+            std::shared_ptr<task_state<R>> state;
+        };
+    }
+
+    // submit 的 结果，类似 std::future；只能 get 一次
+    template <class R>
+    class task_handle {
+    public:
+        task_handle() = default;
+
+        bool valid() const noexcept { return state_ != nullptr; }
+        bool ready() const noexcept { return state_->ready.load(std::memory_order_acquire) != 0; }
+        void wait() const { detail::pool_wait(pool_, state_->ready); }
+
+        R get() {
+            wait();
+            std::shared_ptr<detail::task_state<R>> s = std::move(state_);
+            if (s->error) {
+                std::rethrow_exception(s->error);
+            }
+            if constexpr (!std::is_void_v<R>) {
+                return std::move(*s->value);
+            }
+        }
+
+    private:
+        friend class thread_pool;
+
+        task_handle(thread_pool* pool, std::shared_ptr<detail::task_state<R>> state) : pool_(pool), state_(std::move(state)) {}
+
+        thread_pool* pool_ = nullptr;
+        std::shared_ptr<detail::task_state<R>> state_;
+    };
+
+    class thread_pool {
+    public:
+        explicit thread_pool(thread_pool_options options = {});
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+        ~thread_pool();
+
+        // 进程 共用 的 池：hardware_concurrency() - 1 个 工作 线程（调用 线程 也 干活），故意 不 析构
+        static thread_pool& global();
+
+        unsigned size() const noexcept;
+
+        template <class F>
+        auto submit(F&& fn) -> task_handle<std::invoke_result_t<std::decay_t<F>&>> {
+            using R = std::invoke_result_t<std::decay_t<F>&>;
+            auto state = std::make_shared<detail::task_state<R>>();
+            auto task = std::make_unique<detail::submit_task<std::decay_t<F>, R>>(std::decay_t<F>(std::forward<F>(fn)), state);
+            push(task.get());
+            task.release();
+            return task_handle<R>(this, std::move(state));
+        }
+
+        // 对 [begin, end) 的 每个 下标 调用 fn(i)，返回 时 全部 完成
+        template <class F>
+        void parallel_for(std::size_t begin, std::size_t end, F&& fn, parallel_options options = {}) {
+            using body_type = std::remove_reference_t<F>;
+            parallel_for_impl(begin, end, options, &run_range<body_type>, const_cast<void*>(static_cast<const void*>(std::addressof(fn))));
+        }
+
+        bool on_worker_thread() const noexcept;
+
+        // 当前 线程 是 本池 的 工作 线程 时，执行 一个 排队 的 任务；没有 任务 或 不是 工作 线程 返回 false
+        bool run_pending_task();
+
+    private:
+        struct impl;
+
+        template <class Body>
+        static void run_range(void* body, std::size_t begin, std::size_t end) {
+            Body& fn = *static_cast<Body*>(body);
+            for (std::size_t i = begin; i < end; ++i) fn(i);
+        }
+
+        void push(detail::pool_task* task);
+        void parallel_for_impl(std::size_t begin, std::size_t end, parallel_options options,
+                               void (*body)(void*, std::size_t, std::size_t), void* context);
+
+        std::unique_ptr<impl> impl_;
+    };
+}
+
+#endif // E_UTILS_THREAD_POOL_H
@@ -0,0 +1,182 @@
+#include "e_arena.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__linux__)
+    #include <sys/mman.h>
+#elif defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#endif
+
+namespace e_utils {
+    namespace {
+        constexpr std::size_t min_block_bytes = 4096;
+        constexpr std::size_t huge_page_bytes = std::size_t{2} << 20;
+        // 块 头 占 一个 缓存行，数据 从 64 字节 处 开始
+        constexpr std::size_t header_bytes = 64;
+
+        enum class block_source : std::uint32_t {
+            heap,
+            mmap,
+            virtual_alloc,
+        };
+
+        // 失败 返回 nullptr；huge 时 size 是 2 MB 的 倍数
+        void* system_alloc(std::size_t size, bool huge, block_source& source) {
+            if (huge) {
+#if defined(__linux__)
+    #if defined(MAP_HUGETLB)
+                void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                if (p != MAP_FAILED) {
+                    source = block_source::mmap;
+                    return p;
+                }
+    #endif
+                // 没有 预留 大页：多 映射 2 MB，裁出 2 MB 对齐 的 一段，透明 大页 才能 整段 映射
+                void* raw = ::mmap(nullptr, size + huge_page_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (raw != MAP_FAILED) {
+                    auto* bytes = static_cast<std::byte*>(raw);
+                    const auto addr = reinterpret_cast<std::uintptr_t>(raw);
+                    const std::size_t head = ((addr + huge_page_bytes - 1) & ~(huge_page_bytes - 1)) - addr;
+                    if (head != 0) ::munmap(bytes, head);
+                    if (head != huge_page_bytes) ::munmap(bytes + head + size, huge_page_bytes - head);
+    #if defined(MADV_HUGEPAGE)
+                    ::madvise(bytes + head, size, MADV_HUGEPAGE);
+    #endif
+                    source = block_source::mmap;
+                    return bytes + head;
+                }
+#elif defined(_WIN32)
+                const SIZE_T large = ::GetLargePageMinimum();
+                if (large != 0 && size % large == 0) {
+                    void* p = ::VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+                    if (p != nullptr) {
+                        source = block_source::virtual_alloc;
+                        return p;
+                    }
+                }
+#endif
+            }
+            source = block_source::heap;
+            return ::operator new(size, std::align_val_t{header_bytes}, std::nothrow);
+        }
+
+        void system_free(void* p, std::size_t size, block_source source) noexcept {
+            switch (source) {
+            case block_source::heap:
+                ::operator delete(p, std::align_val_t{header_bytes});
+                break;
+            case block_source::mmap:
+#if defined(__linux__)
+                ::munmap(p, size);
+#endif
+                break;
+            case block_source::virtual_alloc:
+#if defined(_WIN32)
+                ::VirtualFree(p, 0, MEM_RELEASE);
+#endif
+                break;
+            }
+            (void)size;
+        }
+
+        std::size_t round_up(std::size_t n, std::size_t unit) {
+            if (n > std::numeric_limits<std::size_t>::max() - (unit - 1)) {
+                throw std::bad_alloc();
+            }
+            return (n + unit - 1) / unit * unit;
+        }
+    }
+
+    struct arena::block {
+        block* next;
+        std::size_t size; // 整块 字节数，含 头
+        block_source source;
+    };
+
+    arena::arena(arena_options options)
+        : block_bytes_(std::max(options.block_bytes, min_block_bytes)), huge_pages_(options.huge_pages) {
+        static_assert(sizeof(block) <= header_bytes);
+        if (huge_pages_) {
+            block_bytes_ = round_up(block_bytes_, huge_page_bytes);
+        }
+        first_ = new_block(block_bytes_);
+        enter(first_);
+    }
+
+    arena::~arena() {
+        reset();
+        while (first_ != nullptr) {
+            block* next = first_->next;
+            free_block(first_);
+            first_ = next;
+        }
+    }
+
+    void* arena::alloc_slow(std::size_t bytes, std::size_t alignment) {
+        if (bytes > std::numeric_limits<std::size_t>::max() - alignment - header_bytes) {
+            throw std::bad_alloc();
+        }
+        // 按 最坏 的 对齐 填充 算
+        const std::size_t need = bytes + alignment - 1;
+        if (need > (block_bytes_ - header_bytes) / 2) {
+            // 大 分配 单独 一块，不 打断 当前 块
+            block* b = new_block(huge_pages_ ? round_up(header_bytes + need, huge_page_bytes) : header_bytes + need);
+            b->next = large_;
+            large_ = b;
+            const auto data = reinterpret_cast<std::uintptr_t>(b) + header_bytes;
+            return reinterpret_cast<void*>((data + alignment - 1) & ~(alignment - 1));
+        }
+
+        // 当前 块 剩下 的 不够，换 下一块：reset() 之后 先 复用 已有 的
+        if (current_->next == nullptr) {
+            current_->next = new_block(block_bytes_);
+        }
+        enter(current_->next);
+        return alloc(bytes, alignment);
+    }
+
+    arena::block* arena::new_block(std::size_t size) {
+        block_source source;
+        void* p = system_alloc(size, huge_pages_, source);
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        reserved_ += size;
+        return ::new (p) block{nullptr, size, source};
+    }
+
+    void arena::free_block(block* b) noexcept {
+        reserved_ -= b->size;
+        system_free(b, b->size, b->source);
+    }
+
+    void arena::enter(block* b) noexcept {
+        current_ = b;
+        cur_ = reinterpret_cast<std::uintptr_t>(b) + header_bytes;
+        end_ = reinterpret_cast<std::uintptr_t>(b) + b->size;
+    }
+
+    void arena::reset() noexcept {
+        while (large_ != nullptr) {
+            block* next = large_->next;
+            free_block(large_);
+            large_ = next;
+        }
+        enter(first_);
+    }
+
+    void arena::release() noexcept {
+        reset();
+        block* b = first_->next;
+        first_->next = nullptr;
+        while (b != nullptr) {
+            block* next = b->next;
+            free_block(b);
+            b = next;
+        }
+    }
+}
@@ -0,0 +1,632 @@
+#include "e_filter.hpp"
+
+#include "e_simd.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace e_utils {
+    namespace detail {
+        namespace {
+            constexpr std::align_val_t storage_alignment{64};
+        }
+
+        filter_storage::filter_storage(std::size_t size)
+            : data_(static_cast<std::byte*>(::operator new(size, storage_alignment))), size_(size) {
+            std::memset(data_, 0, size);
+        }
+
+        filter_storage::filter_storage(const filter_storage& other) : filter_storage(other.size_) {
+            if (size_ > 0) std::memcpy(data_, other.data_, size_);
+        }
+
+        filter_storage::filter_storage(filter_storage&& other) noexcept
+            : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+        filter_storage& filter_storage::operator=(filter_storage other) noexcept {
+            std::swap(data_, other.data_);
+            std::swap(size_, other.size_);
+            return *this;
+        }
+
+        filter_storage::~filter_storage() {
+            if (data_ != nullptr) ::operator delete(data_, storage_alignment);
+        }
+    }
+
+    namespace {
+        // 序列化 头，固定 64 字节；数据 紧跟 在 后面
+        struct filter_header {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t bits;                // cuckoo：指纹 位数；bloom：0
+            std::uint64_t blocks;              // bloom：32 字节 块 数；cuckoo：桶 数
+            std::uint64_t items;               // bloom：插入 次数；cuckoo：当前 个数（含 victim）
+            std::uint64_t victim_bucket;       // cuckoo 专用
+            std::uint32_t victim_fingerprint;
+            std::uint32_t has_victim;
+            unsigned char reserved[16];
+        };
+
+        static_assert(sizeof(filter_header) == 64);
+
+        constexpr std::size_t header_bytes = sizeof(filter_header);
+        constexpr std::uint32_t format_version = 1;
+        constexpr char bloom_magic[8] = {'E', 'B', 'L', 'O', 'O', 'M', 'F', '1'};
+        constexpr char cuckoo_magic[8] = {'E', 'C', 'U', 'C', 'K', 'O', 'O', '1'};
+
+        // 块 下标 / 桶 下标 取 哈希 高 32 位，上限 2^32
+        constexpr std::uint64_t max_blocks = std::uint64_t{1} << 32;
+
+        filter_header read_header(std::span<const std::byte> bytes, const char (&magic)[8], const char* who) {
+            if (bytes.size() < header_bytes) {
+                throw std::invalid_argument(std::string(who) + ": truncated header");
+            }
+            filter_header h;
+            std::memcpy(&h, bytes.data(), header_bytes);
+            if (std::memcmp(h.magic, magic, sizeof(magic)) != 0 || h.version != format_version) {
+                throw std::invalid_argument(std::string(who) + ": bad magic or version");
+            }
+            return h;
+        }
+
+        filter_header make_header(const char (&magic)[8], std::uint64_t blocks, std::uint32_t bits) {
+            filter_header h{};
+            std::memcpy(h.magic, magic, sizeof(magic));
+            h.version = format_version;
+            h.bits = bits;
+            h.blocks = blocks;
+            return h;
+        }
+
+        // 自己 分配 的 存储 64 字节 对齐，头 可以 直接 当 对象 用
+        filter_header* owned_header(const detail::filter_storage& s) noexcept {
+            return std::launder(reinterpret_cast<filter_header*>(s.data()));
+        }
+
+        inline std::uint32_t load32(const std::byte* p) noexcept {
+            std::uint32_t v;
+            std::memcpy(&v, p, 4);
+            return v;
+        }
+
+        inline std::uint64_t load64(const std::byte* p) noexcept {
+            std::uint64_t v;
+            std::memcpy(&v, p, 8);
+            return v;
+        }
+
+        inline void prefetch(const void* p) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(p);
+#elif E_UTILS_X86
+            _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#endif
+        }
+
+        // 批量 查询 时 一次 先 预取 多少 个
+        constexpr std::size_t prefetch_chunk = 16;
+
+        void check_batch_sizes(std::size_t hashes, std::size_t out, const char* who) {
+            if (hashes != out) {
+                throw std::invalid_argument(std::string(who) + ": hashes and out differ in size");
+            }
+        }
+
+        // ---------------- bloom ----------------
+
+        // 与 Parquet / Impala 的 split block Bloom filter 相同 的 常数
+        constexpr std::uint32_t bloom_salt[8] = {0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du,
+                                                 0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u};
+
+        inline const std::byte* bloom_block(const std::byte* data, std::uint64_t blocks, std::uint64_t hash) noexcept {
+            return data + ((hash >> 32) * blocks >> 32) * bloom_filter::block_bytes;
+        }
+
+        bool bloom_check_scalar(const std::byte* block, std::uint32_t h) noexcept {
+            std::uint32_t missing = 0;
+            for (int i = 0; i < 8; ++i) {
+                const std::uint32_t bit = (h * bloom_salt[i]) >> 27;
+                missing |= ~load32(block + 4 * i) >> bit;
+            }
+            return (missing & 1) == 0;
+        }
+
+        std::size_t bloom_batch_scalar(const std::byte* data, std::uint64_t blocks, const std::uint64_t* hashes,
+                                       bool* out, std::size_t n) noexcept {
+            const std::byte* block[prefetch_chunk];
+            std::size_t hits = 0;
+            for (std::size_t i = 0; i < n; i += prefetch_chunk) {
+                const std::size_t m = std::min(prefetch_chunk, n - i);
+                for (std::size_t j = 0; j < m; ++j) {
+                    block[j] = bloom_block(data, blocks, hashes[i + j]);
+                    prefetch(block[j]);
+                }
+                for (std::size_t j = 0; j < m; ++j) {
+                    const bool hit = bloom_check_scalar(block[j], static_cast<std::uint32_t>(hashes[i + j]));
+                    out[i + j] = hit;
+                    hits += hit;
+                }
+            }
+            return hits;
+        }
+
+#if E_UTILS_X86
+        // 8 个 字 各 要求 1 位：乘 盐、取 高 5 位、移位 成 掩码，testc 检查 全部 置位
+        E_UTILS_TARGET_AVX2
+        inline bool bloom_check_avx2(const std::byte* block, std::uint32_t h) noexcept {
+            const __m256i salt = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bloom_salt));
+            const __m256i bits = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int>(h)), salt), 27);
+            const __m256i mask = _mm256_sllv_epi32(_mm256_set1_epi32(1), bits);
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+            return _mm256_testc_si256(b, mask) != 0;
+        }
+
+        E_UTILS_TARGET_AVX2
+        std::size_t bloom_batch_avx2(const std::byte* data, std::uint64_t blocks, const std::uint64_t* hashes,
+                                     bool* out, std::size_t n) noexcept {
+            const std::byte* block[prefetch_chunk];
+            std::size_t hits = 0;
+            for (std::size_t i = 0; i < n; i += prefetch_chunk) {
+                const std::size_t m = std::min(prefetch_chunk, n - i);
+                for (std::size_t j = 0; j < m; ++j) {
+                    block[j] = bloom_block(data, blocks, hashes[i + j]);
+                    prefetch(block[j]);
+                }
+                for (std::size_t j = 0; j < m; ++j) {
+                    const bool hit = bloom_check_avx2(block[j], static_cast<std::uint32_t>(hashes[i + j]));
+                    out[i + j] = hit;
+                    hits += hit;
+                }
+            }
+            return hits;
+        }
+#endif
+
+        struct bloom_kernels {
+            bool (*check)(const std::byte* block, std::uint32_t h) noexcept;
+            std::size_t (*batch)(const std::byte* data, std::uint64_t blocks, const std::uint64_t* hashes, bool* out,
+                                 std::size_t n) noexcept;
+        };
+
+        const bloom_kernels& select_bloom() {
+            static const bloom_kernels scalar = {bloom_check_scalar, bloom_batch_scalar};
+#if E_UTILS_X86
+            static const bloom_kernels avx2 = {bloom_check_avx2, bloom_batch_avx2};
+            if (detail::cpu_has_avx2()) {
+                return avx2;
+            }
+#endif
+            return scalar;
+        }
+
+        const bloom_kernels& g_bloom = select_bloom();
+
+        // ---------------- cuckoo ----------------
+
+        template <class T>
+        inline T cuckoo_fingerprint(std::uint64_t hash) noexcept {
+            // 0 表示 空槽
+            const T f = static_cast<T>(hash);
+            return f != 0 ? f : T(1);
+        }
+
+        // 另一个 桶 = 桶 ^ f(指纹)，两个 方向 用 同一个 公式
+        inline std::uint64_t cuckoo_alt(std::uint64_t bucket, std::uint32_t fingerprint, std::uint64_t mask) noexcept {
+            std::uint64_t x = fingerprint * 0xc6a4a7935bd1e995ull;
+            x ^= x >> 32;
+            return (bucket ^ x) & mask;
+        }
+
+        template <class T>
+        inline std::byte* cuckoo_bucket(std::byte* data, std::uint64_t bucket) noexcept {
+            return data + header_bytes + bucket * cuckoo_filter::bucket_slots * sizeof(T);
+        }
+
+        template <class T>
+        inline const std::byte* cuckoo_bucket(const std::byte* data, std::uint64_t bucket) noexcept {
+            return data + header_bytes + bucket * cuckoo_filter::bucket_slots * sizeof(T);
+        }
+
+        template <class T>
+        inline T slot_get(const std::byte* bucket, std::size_t slot) noexcept {
+            T v;
+            std::memcpy(&v, bucket + slot * sizeof(T), sizeof(T));
+            return v;
+        }
+
+        template <class T>
+        inline void slot_set(std::byte* bucket, std::size_t slot, T v) noexcept {
+            std::memcpy(bucket + slot * sizeof(T), &v, sizeof(T));
+        }
+
+        // 两个 桶 的 8 个 槽 里 有没有 fp；SSE2 一次 比较 完
+        template <class T>
+        inline bool bucket_pair_has(const std::byte* a, const std::byte* b, T fp) noexcept {
+#if E_UTILS_X86
+            if constexpr (sizeof(T) == 1) {
+                const std::uint64_t v = load32(a) | std::uint64_t{load32(b)} << 32;
+                const __m128i eq = _mm_cmpeq_epi8(_mm_cvtsi64_si128(static_cast<long long>(v)),
+                                                  _mm_set1_epi8(static_cast<char>(fp)));
+                return (_mm_movemask_epi8(eq) & 0xff) != 0;
+            } else if constexpr (sizeof(T) == 2) {
+                const __m128i v = _mm_set_epi64x(static_cast<long long>(load64(b)), static_cast<long long>(load64(a)));
+                return _mm_movemask_epi8(_mm_cmpeq_epi16(v, _mm_set1_epi16(static_cast<short>(fp)))) != 0;
+            } else {
+                const __m128i f = _mm_set1_epi32(static_cast<int>(fp));
+                const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+                const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+                return _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi32(va, f), _mm_cmpeq_epi32(vb, f))) != 0;
+            }
+#else
+            bool found = false;
+            for (std::size_t s = 0; s < cuckoo_filter::bucket_slots; ++s) {
+                found |= slot_get<T>(a, s) == fp;
+                found |= slot_get<T>(b, s) == fp;
+            }
+            return found;
+#endif
+        }
+
+        struct cuckoo_state {
+            const std::byte* data;
+            std::uint64_t mask;
+            bool has_victim;
+            std::uint32_t victim_fingerprint;
+            std::uint64_t victim_bucket;
+        };
+
+        template <class T>
+        inline bool victim_matches(const cuckoo_state& s, T fp, std::uint64_t i1, std::uint64_t i2) noexcept {
+            return s.has_victim && s.victim_fingerprint == fp && (s.victim_bucket == i1 || s.victim_bucket == i2);
+        }
+
+        template <class T>
+        bool cuckoo_contains(const cuckoo_state& s, std::uint64_t hash) noexcept {
+            const T fp = cuckoo_fingerprint<T>(hash);
+            const std::uint64_t i1 = (hash >> 32) & s.mask;
+            const std::uint64_t i2 = cuckoo_alt(i1, fp, s.mask);
+            return bucket_pair_has<T>(cuckoo_bucket<T>(s.data, i1), cuckoo_bucket<T>(s.data, i2), fp)
+                || victim_matches(s, fp, i1, i2);
+        }
+
+        template <class T>
+        std::size_t cuckoo_batch(const cuckoo_state& s, const std::uint64_t* hashes, bool* out, std::size_t n) noexcept {
+            const std::byte* first[prefetch_chunk];
+            const std::byte* second[prefetch_chunk];
+            std::size_t hits = 0;
+            for (std::size_t i = 0; i < n; i += prefetch_chunk) {
+                const std::size_t m = std::min(prefetch_chunk, n - i);
+                for (std::size_t j = 0; j < m; ++j) {
+                    const std::uint64_t i1 = (hashes[i + j] >> 32) & s.mask;
+                    first[j] = cuckoo_bucket<T>(s.data, i1);
+                    second[j] = cuckoo_bucket<T>(s.data, cuckoo_alt(i1, cuckoo_fingerprint<T>(hashes[i + j]), s.mask));
+                    prefetch(first[j]);
+                    prefetch(second[j]);
+                }
+                for (std::size_t j = 0; j < m; ++j) {
+                    const T fp = cuckoo_fingerprint<T>(hashes[i + j]);
+                    bool hit = bucket_pair_has<T>(first[j], second[j], fp);
+                    if (s.has_victim && !hit) hit = cuckoo_contains<T>(s, hashes[i + j]);
+                    out[i + j] = hit;
+                    hits += hit;
+                }
+            }
+            return hits;
+        }
+
+        std::uint64_t cuckoo_payload_bytes(std::uint64_t buckets, unsigned bits) noexcept {
+            return buckets * cuckoo_filter::bucket_slots * (bits / 8);
+        }
+    }
+
+    // ---------------- bloom_filter_view / bloom_filter ----------------
+
+    bloom_filter_view::bloom_filter_view(std::span<const std::byte> bytes) {
+        const filter_header h = read_header(bytes, bloom_magic, "e_utils::bloom_filter");
+        if (h.blocks == 0 || h.blocks > max_blocks || bytes.size() - header_bytes != h.blocks * bloom_filter::block_bytes) {
+            throw std::invalid_argument("e_utils::bloom_filter: size does not match header");
+        }
+        data_ = bytes.data() + header_bytes;
+        blocks_ = h.blocks;
+        items_ = h.items;
+    }
+
+    bool bloom_filter_view::contains(std::uint64_t hash) const noexcept {
+        return g_bloom.check(bloom_block(data_, blocks_, hash), static_cast<std::uint32_t>(hash));
+    }
+
+    std::size_t bloom_filter_view::contains(std::span<const std::uint64_t> hashes, std::span<bool> out) const {
+        check_batch_sizes(hashes.size(), out.size(), "e_utils::bloom_filter::contains");
+        return g_bloom.batch(data_, blocks_, hashes.data(), out.data(), hashes.size());
+    }
+
+    bloom_filter::bloom_filter(std::size_t expected_items, double false_positive_rate)
+        : blocks_(blocks_for(expected_items, false_positive_rate)) {
+        storage_ = detail::filter_storage(header_bytes + blocks_ * block_bytes);
+        ::new (storage_.data()) filter_header(make_header(bloom_magic, blocks_, 0));
+    }
+
+    bloom_filter::bloom_filter(std::span<const std::byte> bytes) {
+        const bloom_filter_view v(bytes);
+        blocks_ = v.blocks();
+        storage_ = detail::filter_storage(bytes.size());
+        ::new (storage_.data()) filter_header;
+        std::memcpy(storage_.data(), bytes.data(), bytes.size());
+    }
+
+    double bloom_filter::estimate_false_positive_rate(std::uint64_t blocks, std::uint64_t items) {
+        if (items == 0) {
+            return 0.0;
+        }
+        if (blocks == 0) {
+            return 1.0;
+        }
+        // 每块 的 元素数 服从 泊松 分布；块 里 有 j 个 元素 时，每个 字 已 置 的 位 占 1 - (31/32)^j
+        const double lambda = static_cast<double>(items) / static_cast<double>(blocks);
+        const double spread = 10.0 * std::sqrt(lambda) + 10.0;
+        const double first = std::max(0.0, std::floor(lambda - spread));
+        double rate = 0.0;
+        for (double j = first; j <= lambda + spread; j += 1.0) {
+            const double p = std::exp(j * std::log(lambda) - lambda - std::lgamma(j + 1.0));
+            rate += p * std::pow(1.0 - std::pow(31.0 / 32.0, j), 8.0);
+        }
+        return std::min(rate, 1.0);
+    }
+
+    std::uint64_t bloom_filter::blocks_for(std::size_t expected_items, double false_positive_rate) {
+        if (!(false_positive_rate > 0.0 && false_positive_rate < 1.0)) {
+            throw std::invalid_argument("e_utils::bloom_filter: false positive rate must be in (0, 1)");
+        }
+        // 从 每个 元素 8 位 左右 开始 翻倍 找 上界；块 太少 时 每块 元素 很多，估计 要 算 很多 项
+        std::uint64_t lo = 1;
+        std::uint64_t hi = std::clamp<std::uint64_t>(expected_items / 32, 1, max_blocks);
+        while (estimate_false_positive_rate(hi, expected_items) > false_positive_rate) {
+            if (hi >= max_blocks) {
+                throw std::invalid_argument("e_utils::bloom_filter: too many items for the target rate");
+            }
+            lo = hi + 1;
+            hi = std::min(hi * 2, max_blocks);
+        }
+        // 误判率 随 块数 单调 下降，二分
+        while (lo < hi) {
+            const std::uint64_t mid = lo + (hi - lo) / 2;
+            if (estimate_false_positive_rate(mid, expected_items) > false_positive_rate) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return hi;
+    }
+
+    void bloom_filter::insert_block(std::uint64_t hash) noexcept {
+        std::byte* block = storage_.data() + header_bytes + ((hash >> 32) * blocks_ >> 32) * block_bytes;
+        const auto h = static_cast<std::uint32_t>(hash);
+        for (int i = 0; i < 8; ++i) {
+            const std::uint32_t word = load32(block + 4 * i) | (1u << ((h * bloom_salt[i]) >> 27));
+            std::memcpy(block + 4 * i, &word, 4);
+        }
+    }
+
+    void bloom_filter::insert(std::uint64_t hash) noexcept {
+        insert_block(hash);
+        ++owned_header(storage_)->items;
+    }
+
+    void bloom_filter::insert(std::span<const std::uint64_t> hashes) noexcept {
+        for (std::size_t i = 0; i < hashes.size(); i += prefetch_chunk) {
+            const std::size_t m = std::min(prefetch_chunk, hashes.size() - i);
+            for (std::size_t j = 0; j < m; ++j) prefetch(bloom_block(storage_.data() + header_bytes, blocks_, hashes[i + j]));
+            for (std::size_t j = 0; j < m; ++j) insert_block(hashes[i + j]);
+        }
+        owned_header(storage_)->items += hashes.size();
+    }
+
+    std::uint64_t bloom_filter::items() const noexcept {
+        return owned_header(storage_)->items;
+    }
+
+    bloom_filter_view bloom_filter::view() const noexcept {
+        return bloom_filter_view(storage_.data() + header_bytes, blocks_, items());
+    }
+
+    // ---------------- cuckoo_filter_view / cuckoo_filter ----------------
+
+    cuckoo_filter_view::cuckoo_filter_view(std::span<const std::byte> bytes) {
+        const filter_header h = read_header(bytes, cuckoo_magic, "e_utils::cuckoo_filter");
+        const bool bits_ok = h.bits == 8 || h.bits == 16 || h.bits == 32;
+        const bool buckets_ok = h.blocks != 0 && h.blocks <= max_blocks && (h.blocks & (h.blocks - 1)) == 0;
+        if (!bits_ok || !buckets_ok || h.has_victim > 1 || (h.has_victim && h.victim_bucket >= h.blocks)
+            || bytes.size() - header_bytes != cuckoo_payload_bytes(h.blocks, h.bits)) {
+            throw std::invalid_argument("e_utils::cuckoo_filter: size does not match header");
+        }
+        data_ = bytes.data();
+        mask_ = h.blocks - 1;
+        bits_ = h.bits;
+        size_ = h.items;
+        has_victim_ = h.has_victim != 0;
+        victim_fingerprint_ = h.victim_fingerprint;
+        victim_bucket_ = h.victim_bucket;
+    }
+
+    bool cuckoo_filter_view::contains(std::uint64_t hash) const noexcept {
+        const cuckoo_state s = {data_, mask_, has_victim_, victim_fingerprint_, victim_bucket_};
+        switch (bits_) {
+            case 8: return cuckoo_contains<std::uint8_t>(s, hash);
+            case 16: return cuckoo_contains<std::uint16_t>(s, hash);
+            default: return cuckoo_contains<std::uint32_t>(s, hash);
+        }
+    }
+
+    std::size_t cuckoo_filter_view::contains(std::span<const std::uint64_t> hashes, std::span<bool> out) const {
+        check_batch_sizes(hashes.size(), out.size(), "e_utils::cuckoo_filter::contains");
+        const cuckoo_state s = {data_, mask_, has_victim_, victim_fingerprint_, victim_bucket_};
+        switch (bits_) {
+            case 8: return cuckoo_batch<std::uint8_t>(s, hashes.data(), out.data(), hashes.size());
+            case 16: return cuckoo_batch<std::uint16_t>(s, hashes.data(), out.data(), hashes.size());
+            default: return cuckoo_batch<std::uint32_t>(s, hashes.data(), out.data(), hashes.size());
+        }
+    }
+
+    unsigned cuckoo_filter::fingerprint_bits_for(double false_positive_rate) {
+        if (!(false_positive_rate > 0.0 && false_positive_rate < 1.0)) {
+            throw std::invalid_argument("e_utils::cuckoo_filter: false positive rate must be in (0, 1)");
+        }
+        // 查询 比较 2 个 桶 共 8 个 槽，每个 槽 误撞 的 概率 约 1 / 2^bits
+        for (unsigned bits : {8u, 16u, 32u}) {
+            if (2.0 * bucket_slots / std::ldexp(1.0, static_cast<int>(bits)) <= false_positive_rate) {
+                return bits;
+            }
+        }
+        throw std::invalid_argument("e_utils::cuckoo_filter: false positive rate below 8 / 2^32");
+    }
+
+    cuckoo_filter::cuckoo_filter(std::size_t capacity, double false_positive_rate) {
+        const unsigned bits = fingerprint_bits_for(false_positive_rate);
+        // 装载 超过 95% 之后 插入 很容易 失败
+        const auto wanted = static_cast<std::uint64_t>(std::ceil(static_cast<double>(capacity) / (bucket_slots * 0.95)));
+        std::uint64_t buckets = 1;
+        while (buckets < wanted) {
+            if (buckets >= max_blocks) {
+                throw std::invalid_argument("e_utils::cuckoo_filter: capacity too large");
+            }
+            buckets *= 2;
+        }
+        init(buckets, bits);
+    }
+
+    cuckoo_filter::cuckoo_filter(std::span<const std::byte> bytes) {
+        const cuckoo_filter_view v(bytes);
+        mask_ = v.buckets() - 1;
+        bits_ = v.fingerprint_bits();
+        storage_ = detail::filter_storage(bytes.size());
+        ::new (storage_.data()) filter_header;
+        std::memcpy(storage_.data(), bytes.data(), bytes.size());
+    }
+
+    void cuckoo_filter::init(std::uint64_t buckets, unsigned bits) {
+        mask_ = buckets - 1;
+        bits_ = bits;
+        storage_ = detail::filter_storage(header_bytes + cuckoo_payload_bytes(buckets, bits));
+        ::new (storage_.data()) filter_header(make_header(cuckoo_magic, buckets, bits));
+    }
+
+    cuckoo_filter_view cuckoo_filter::view() const noexcept {
+        const filter_header* h = owned_header(storage_);
+        cuckoo_filter_view v;
+        v.data_ = storage_.data();
+        v.mask_ = mask_;
+        v.bits_ = bits_;
+        v.size_ = h->items;
+        v.has_victim_ = h->has_victim != 0;
+        v.victim_fingerprint_ = h->victim_fingerprint;
+        v.victim_bucket_ = h->victim_bucket;
+        return v;
+    }
+
+    namespace {
+        template <class T>
+        bool bucket_add(std::byte* bucket, T fp) noexcept {
+            for (std::size_t s = 0; s < cuckoo_filter::bucket_slots; ++s) {
+                if (slot_get<T>(bucket, s) == 0) {
+                    slot_set<T>(bucket, s, fp);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        template <class T>
+        bool bucket_remove(std::byte* bucket, T fp) noexcept {
+            for (std::size_t s = 0; s < cuckoo_filter::bucket_slots; ++s) {
+                if (slot_get<T>(bucket, s) == fp) {
+                    slot_set<T>(bucket, s, T(0));
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // 放到 i 或 它 的 另一个 桶；都 满 就 随机 踢走 一个，被踢 的 去 它 的 另一个 桶
+        // 踢 满 max_kicks 次 还 没 放下，最后 手里 的 那个 存成 victim
+        template <class T>
+        void cuckoo_place(std::byte* data, filter_header* h, std::uint64_t mask, std::uint64_t& rng, T fp,
+                          std::uint64_t i) noexcept {
+            if (bucket_add<T>(cuckoo_bucket<T>(data, i), fp)) return;
+            i = cuckoo_alt(i, fp, mask);
+            if (bucket_add<T>(cuckoo_bucket<T>(data, i), fp)) return;
+            for (unsigned kick = 0; kick < cuckoo_filter::max_kicks; ++kick) {
+                rng ^= rng << 13;
+                rng ^= rng >> 7;
+                rng ^= rng << 17;
+                std::byte* bucket = cuckoo_bucket<T>(data, i);
+                const std::size_t slot = rng % cuckoo_filter::bucket_slots;
+                const T evicted = slot_get<T>(bucket, slot);
+                slot_set<T>(bucket, slot, fp);
+                fp = evicted;
+                i = cuckoo_alt(i, fp, mask);
+                if (bucket_add<T>(cuckoo_bucket<T>(data, i), fp)) return;
+            }
+            h->has_victim = 1;
+            h->victim_fingerprint = fp;
+            h->victim_bucket = i;
+        }
+    }
+
+    template <class T>
+    bool cuckoo_filter::insert_impl(std::uint64_t hash) noexcept {
+        filter_header* h = owned_header(storage_);
+        if (h->has_victim) {
+            return false;
+        }
+        cuckoo_place<T>(storage_.data(), h, mask_, rng_, cuckoo_fingerprint<T>(hash), (hash >> 32) & mask_);
+        ++h->items;
+        return true;
+    }
+
+    template <class T>
+    bool cuckoo_filter::erase_impl(std::uint64_t hash) noexcept {
+        filter_header* h = owned_header(storage_);
+        const T fp = cuckoo_fingerprint<T>(hash);
+        const std::uint64_t i1 = (hash >> 32) & mask_;
+        const std::uint64_t i2 = cuckoo_alt(i1, fp, mask_);
+        if (bucket_remove<T>(cuckoo_bucket<T>(storage_.data(), i1), fp)
+            || bucket_remove<T>(cuckoo_bucket<T>(storage_.data(), i2), fp)) {
+            --h->items;
+            // 腾出 了 位置，victim 重新 放进去
+            if (h->has_victim) {
+                h->has_victim = 0;
+                cuckoo_place<T>(storage_.data(), h, mask_, rng_, static_cast<T>(h->victim_fingerprint), h->victim_bucket);
+            }
+            return true;
+        }
+        if (h->has_victim && h->victim_fingerprint == fp && (h->victim_bucket == i1 || h->victim_bucket == i2)) {
+            h->has_victim = 0;
+            --h->items;
+            return true;
+        }
+        return false;
+    }
+
+    bool cuckoo_filter::insert(std::uint64_t hash) noexcept {
+        switch (bits_) {
+            case 8: return insert_impl<std::uint8_t>(hash);
+            case 16: return insert_impl<std::uint16_t>(hash);
+            default: return insert_impl<std::uint32_t>(hash);
+        }
+    }
+
+    bool cuckoo_filter::erase(std::uint64_t hash) noexcept {
+        switch (bits_) {
+            case 8: return erase_impl<std::uint8_t>(hash);
+            case 16: return erase_impl<std::uint16_t>(hash);
+            default: return erase_impl<std::uint32_t>(hash);
+        }
+    }
+}
@@ -0,0 +1,411 @@
+#include "e_hash.hpp"
+
+#include "e_simd.hpp"
+
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+namespace e_utils {
+    namespace {
+        // 按 小端 读，大端 机器 上 结果 与 小端 相同
+        inline std::uint64_t read64(const unsigned char* p) noexcept {
+            std::uint64_t v;
+            std::memcpy(&v, p, 8);
+            if constexpr (std::endian::native == std::endian::big) {
+                v = ((v & 0x00000000ffffffffull) << 32) | (v >> 32);
+                v = ((v & 0x0000ffff0000ffffull) << 16) | ((v >> 16) & 0x0000ffff0000ffffull);
+                v = ((v & 0x00ff00ff00ff00ffull) << 8) | ((v >> 8) & 0x00ff00ff00ff00ffull);
+            }
+            return v;
+        }
+
+        inline std::uint64_t read32(const unsigned char* p) noexcept {
+            return std::uint64_t{p[0]} | std::uint64_t{p[1]} << 8 | std::uint64_t{p[2]} << 16 | std::uint64_t{p[3]} << 24;
+        }
+
+        // ---------------- XXH64 ----------------
+
+        constexpr std::uint64_t P1 = 0x9e3779b185ebca87ull;
+        constexpr std::uint64_t P2 = 0xc2b2ae3d27d4eb4full;
+        constexpr std::uint64_t P3 = 0x165667b19e3779f9ull;
+        constexpr std::uint64_t P4 = 0x85ebca77c2b2ae63ull;
+        constexpr std::uint64_t P5 = 0x27d4eb2f165667c5ull;
+
+        inline std::uint64_t xxh_round(std::uint64_t acc, std::uint64_t input) noexcept {
+            acc += input * P2;
+            return std::rotl(acc, 31) * P1;
+        }
+
+        inline std::uint64_t xxh_merge(std::uint64_t h, std::uint64_t acc) noexcept {
+            h ^= xxh_round(0, acc);
+            return h * P1 + P4;
+        }
+
+        inline void xxh_init(std::uint64_t (&acc)[4], std::uint64_t seed) noexcept {
+            acc[0] = seed + P1 + P2;
+            acc[1] = seed + P2;
+            acc[2] = seed;
+            acc[3] = seed - P1;
+        }
+
+        // 4 条 独立 的 累加 链，每次 吃 32 字节；返回 处理了 多少 字节
+        inline std::size_t xxh_stripes(std::uint64_t (&acc)[4], const unsigned char* p, std::size_t n) noexcept {
+            std::uint64_t a0 = acc[0], a1 = acc[1], a2 = acc[2], a3 = acc[3];
+            std::size_t done = 0;
+            for (; done + 32 <= n; done += 32) {
+                a0 = xxh_round(a0, read64(p + done));
+                a1 = xxh_round(a1, read64(p + done + 8));
+                a2 = xxh_round(a2, read64(p + done + 16));
+                a3 = xxh_round(a3, read64(p + done + 24));
+            }
+            acc[0] = a0;
+            acc[1] = a1;
+            acc[2] = a2;
+            acc[3] = a3;
+            return done;
+        }
+
+        inline std::uint64_t xxh_converge(const std::uint64_t (&acc)[4]) noexcept {
+            std::uint64_t h = std::rotl(acc[0], 1) + std::rotl(acc[1], 7) + std::rotl(acc[2], 12) + std::rotl(acc[3], 18);
+            h = xxh_merge(h, acc[0]);
+            h = xxh_merge(h, acc[1]);
+            h = xxh_merge(h, acc[2]);
+            return xxh_merge(h, acc[3]);
+        }
+
+        inline std::uint64_t xxh_avalanche(std::uint64_t h) noexcept {
+            h ^= h >> 33;
+            h *= P2;
+            h ^= h >> 29;
+            h *= P3;
+            return h ^ (h >> 32);
+        }
+
+        // 不足 32 字节 的 尾巴
+        inline std::uint64_t xxh_finalize(std::uint64_t h, const unsigned char* p, std::size_t n) noexcept {
+            for (; n >= 8; p += 8, n -= 8) {
+                h ^= xxh_round(0, read64(p));
+                h = std::rotl(h, 27) * P1 + P4;
+            }
+            if (n >= 4) {
+                h ^= read32(p) * P1;
+                h = std::rotl(h, 23) * P2 + P3;
+                p += 4;
+                n -= 4;
+            }
+            for (; n > 0; ++p, --n) {
+                h ^= *p * P5;
+                h = std::rotl(h, 11) * P1;
+            }
+            return xxh_avalanche(h);
+        }
+
+        // 4 个 短键（< 32 字节）同时 算：每一步 对 4 个 键 各做 一次，4 条 乘法 链 互不 依赖
+        constexpr std::size_t batch_lanes = 4;
+
+        void xxh_short_lanes(const std::string_view* keys, std::uint64_t* out, std::uint64_t seed) noexcept {
+            const unsigned char* p[batch_lanes];
+            std::size_t n[batch_lanes];
+            std::uint64_t h[batch_lanes];
+            for (std::size_t j = 0; j < batch_lanes; ++j) {
+                p[j] = reinterpret_cast<const unsigned char*>(keys[j].data());
+                n[j] = keys[j].size();
+                h[j] = seed + P5 + n[j];
+            }
+            for (int step = 0; step < 3; ++step) {
+                for (std::size_t j = 0; j < batch_lanes; ++j) {
+                    if (n[j] >= 8) {
+                        h[j] ^= xxh_round(0, read64(p[j]));
+                        h[j] = std::rotl(h[j], 27) * P1 + P4;
+                        p[j] += 8;
+                        n[j] -= 8;
+                    }
+                }
+            }
+            for (std::size_t j = 0; j < batch_lanes; ++j) {
+                if (n[j] >= 4) {
+                    h[j] ^= read32(p[j]) * P1;
+                    h[j] = std::rotl(h[j], 23) * P2 + P3;
+                    p[j] += 4;
+                    n[j] -= 4;
+                }
+            }
+            for (int step = 0; step < 3; ++step) {
+                for (std::size_t j = 0; j < batch_lanes; ++j) {
+                    if (n[j] > 0) {
+                        h[j] ^= *p[j] * P5;
+                        h[j] = std::rotl(h[j], 11) * P1;
+                        ++p[j];
+                        --n[j];
+                    }
+                }
+            }
+            for (std::size_t j = 0; j < batch_lanes; ++j) out[j] = xxh_avalanche(h[j]);
+        }
+
+        // ---------------- MurmurHash3 x64_128 ----------------
+
+        constexpr std::uint64_t C1 = 0x87c37b91114253d5ull;
+        constexpr std::uint64_t C2 = 0x4cf5ad432745937full;
+
+        inline std::uint64_t mix_k1(std::uint64_t k) noexcept { return std::rotl(k * C1, 31) * C2; }
+        inline std::uint64_t mix_k2(std::uint64_t k) noexcept { return std::rotl(k * C2, 33) * C1; }
+
+        inline std::uint64_t fmix64(std::uint64_t k) noexcept {
+            k ^= k >> 33;
+            k *= 0xff51afd7ed558ccdull;
+            k ^= k >> 33;
+            k *= 0xc4ceb9fe1a85ec53ull;
+            return k ^ (k >> 33);
+        }
+
+        inline std::size_t murmur_blocks(std::uint64_t& h1, std::uint64_t& h2, const unsigned char* p, std::size_t n) noexcept {
+            std::size_t done = 0;
+            for (; done + 16 <= n; done += 16) {
+                h1 ^= mix_k1(read64(p + done));
+                h1 = (std::rotl(h1, 27) + h2) * 5 + 0x52dce729;
+                h2 ^= mix_k2(read64(p + done + 8));
+                h2 = (std::rotl(h2, 31) + h1) * 5 + 0x38495ab5;
+            }
+            return done;
+        }
+
+        // 不足 16 字节 的 尾巴 与 收尾
+        inline digest128 murmur_finalize(std::uint64_t h1, std::uint64_t h2, const unsigned char* p, std::size_t n,
+                                         std::uint64_t total) noexcept {
+            std::uint64_t k1 = 0, k2 = 0;
+            for (std::size_t i = n; i > 8; --i) k2 = (k2 << 8) | p[i - 1];
+            for (std::size_t i = n < 8 ? n : 8; i > 0; --i) k1 = (k1 << 8) | p[i - 1];
+            if (n > 8) h2 ^= mix_k2(k2);
+            if (n > 0) h1 ^= mix_k1(k1);
+
+            h1 ^= total;
+            h2 ^= total;
+            h1 += h2;
+            h2 += h1;
+            h1 = fmix64(h1);
+            h2 = fmix64(h2);
+            h1 += h2;
+            h2 += h1;
+            return {h1, h2};
+        }
+
+        // ---------------- CRC-32C ----------------
+        // 内部 状态 是 取反 之后 的 值，与 crc32 指令 的 约定 相同；进出 各 取反 一次
+
+        constexpr std::uint32_t crc_poly = 0x82f63b78; // 0x1edc6f41 按位 反转
+
+        struct crc_tables {
+            // slicing-by-8：byte[k][b] = 字节 b 后面 再跟 k 个 0 字节 的 效果
+            std::uint32_t byte[8][256];
+        };
+
+        constexpr crc_tables make_crc_tables() {
+            crc_tables t{};
+            for (std::uint32_t i = 0; i < 256; ++i) {
+                std::uint32_t c = i;
+                for (int b = 0; b < 8; ++b) c = (c >> 1) ^ (crc_poly & (0u - (c & 1)));
+                t.byte[0][i] = c;
+            }
+            for (int k = 1; k < 8; ++k) {
+                for (std::uint32_t i = 0; i < 256; ++i) {
+                    const std::uint32_t prev = t.byte[k - 1][i];
+                    t.byte[k][i] = (prev >> 8) ^ t.byte[0][prev & 0xff];
+                }
+            }
+            return t;
+        }
+
+        constexpr crc_tables g_crc_tables = make_crc_tables();
+
+        std::uint32_t crc_update_table(std::uint32_t c, const unsigned char* p, std::size_t n) noexcept {
+            const auto& t = g_crc_tables.byte;
+            for (; n >= 8; p += 8, n -= 8) {
+                const std::uint64_t w = read64(p) ^ c;
+                c = t[7][w & 0xff] ^ t[6][(w >> 8) & 0xff] ^ t[5][(w >> 16) & 0xff] ^ t[4][(w >> 24) & 0xff]
+                    ^ t[3][(w >> 32) & 0xff] ^ t[2][(w >> 40) & 0xff] ^ t[1][(w >> 48) & 0xff] ^ t[0][w >> 56];
+            }
+            for (; n > 0; ++p, --n) c = (c >> 8) ^ t[0][(c ^ *p) & 0xff];
+            return c;
+        }
+
+#if E_UTILS_X86
+        // 三路 交错：crc32 指令 延迟 3、吞吐 1，三段 各自 独立 算，再 用 shift 表 拼起来
+        constexpr std::size_t crc_stride = 256;
+
+        struct crc_shift_table {
+            // byte[k][b]：状态 第 k 个 字节 为 b（其余 为 0）时，后面 跟 crc_stride 个 0 字节 之后 的 状态
+            std::uint32_t byte[4][256];
+        };
+
+        // 状态 后面 补 0 字节 是 线性 的：先 算 32 个 单位 向量，再 按 位 异或 组合
+        constexpr crc_shift_table make_crc_shift_table() {
+            std::uint32_t basis[32] = {};
+            for (int b = 0; b < 32; ++b) {
+                std::uint32_t c = 1u << b;
+                for (std::size_t i = 0; i < crc_stride; ++i) c = (c >> 8) ^ g_crc_tables.byte[0][c & 0xff];
+                basis[b] = c;
+            }
+            crc_shift_table t{};
+            for (int k = 0; k < 4; ++k) {
+                for (std::uint32_t v = 0; v < 256; ++v) {
+                    std::uint32_t c = 0;
+                    for (int b = 0; b < 8; ++b) {
+                        if ((v >> b) & 1) c ^= basis[8 * k + b];
+                    }
+                    t.byte[k][v] = c;
+                }
+            }
+            return t;
+        }
+
+        constexpr crc_shift_table g_crc_shift = make_crc_shift_table();
+
+        inline std::uint32_t crc_shift(std::uint32_t c) noexcept {
+            const auto& t = g_crc_shift.byte;
+            return t[0][c & 0xff] ^ t[1][(c >> 8) & 0xff] ^ t[2][(c >> 16) & 0xff] ^ t[3][c >> 24];
+        }
+
+        E_UTILS_TARGET_SSE42
+        std::uint32_t crc_update_sse42(std::uint32_t c, const unsigned char* p, std::size_t n) noexcept {
+            for (; n >= 3 * crc_stride; p += 3 * crc_stride, n -= 3 * crc_stride) {
+                std::uint64_t a = c, b = 0, d = 0;
+                for (std::size_t i = 0; i < crc_stride; i += 8) {
+                    a = _mm_crc32_u64(a, read64(p + i));
+                    b = _mm_crc32_u64(b, read64(p + crc_stride + i));
+                    d = _mm_crc32_u64(d, read64(p + 2 * crc_stride + i));
+                }
+                c = crc_shift(crc_shift(static_cast<std::uint32_t>(a)) ^ static_cast<std::uint32_t>(b))
+                    ^ static_cast<std::uint32_t>(d);
+            }
+            std::uint64_t c64 = c;
+            for (; n >= 8; p += 8, n -= 8) c64 = _mm_crc32_u64(c64, read64(p));
+            c = static_cast<std::uint32_t>(c64);
+            for (; n > 0; ++p, --n) c = _mm_crc32_u8(c, *p);
+            return c;
+        }
+#endif
+
+        using crc_update_fn = std::uint32_t (*)(std::uint32_t, const unsigned char*, std::size_t) noexcept;
+
+        crc_update_fn select_crc_update() {
+#if E_UTILS_X86
+            if (detail::cpu_has_sse42()) {
+                return crc_update_sse42;
+            }
+#endif
+            return crc_update_table;
+        }
+
+        const crc_update_fn g_crc_update = select_crc_update();
+    }
+
+    std::uint64_t hash64(std::span<const std::byte> data, std::uint64_t seed) noexcept {
+        const auto* p = reinterpret_cast<const unsigned char*>(data.data());
+        const std::size_t size = data.size();
+        std::uint64_t h = seed + P5;
+        std::size_t done = 0;
+        if (size >= 32) {
+            std::uint64_t acc[4];
+            xxh_init(acc, seed);
+            done = xxh_stripes(acc, p, size);
+            h = xxh_converge(acc);
+        }
+        return xxh_finalize(h + size, p + done, size - done);
+    }
+
+    digest128 hash128(std::span<const std::byte> data, std::uint64_t seed) noexcept {
+        const auto* p = reinterpret_cast<const unsigned char*>(data.data());
+        const std::size_t size = data.size();
+        std::uint64_t h1 = seed, h2 = seed;
+        const std::size_t done = murmur_blocks(h1, h2, p, size);
+        return murmur_finalize(h1, h2, p + done, size - done, size);
+    }
+
+    void hash64_batch(std::span<const std::string_view> keys, std::span<std::uint64_t> out, std::uint64_t seed) {
+        if (keys.size() != out.size()) {
+            throw std::invalid_argument("e_utils::hash64_batch: keys and out differ in size");
+        }
+        std::size_t i = 0;
+        for (; i + batch_lanes <= keys.size(); i += batch_lanes) {
+            bool all_short = true;
+            for (std::size_t j = 0; j < batch_lanes; ++j) all_short &= keys[i + j].size() < 32;
+            if (all_short) {
+                xxh_short_lanes(keys.data() + i, out.data() + i, seed);
+            } else {
+                for (std::size_t j = 0; j < batch_lanes; ++j) out[i + j] = hash64(keys[i + j], seed);
+            }
+        }
+        for (; i < keys.size(); ++i) out[i] = hash64(keys[i], seed);
+    }
+
+    std::uint32_t crc32c(std::span<const std::byte> data, std::uint32_t crc) noexcept {
+        return ~g_crc_update(~crc, reinterpret_cast<const unsigned char*>(data.data()), data.size());
+    }
+
+    void hasher64::reset(std::uint64_t seed) noexcept {
+        xxh_init(acc_, seed);
+        seed_ = seed;
+        total_ = 0;
+        buffered_ = 0;
+    }
+
+    void hasher64::update(std::span<const std::byte> data) noexcept {
+        const auto* p = reinterpret_cast<const unsigned char*>(data.data());
+        std::size_t size = data.size();
+        total_ += size;
+        if (buffered_ + size < sizeof(buffer_)) {
+            if (size > 0) std::memcpy(buffer_ + buffered_, p, size);
+            buffered_ += size;
+            return;
+        }
+        if (buffered_ > 0) {
+            const std::size_t fill = sizeof(buffer_) - buffered_;
+            std::memcpy(buffer_ + buffered_, p, fill);
+            xxh_stripes(acc_, buffer_, sizeof(buffer_));
+            p += fill;
+            size -= fill;
+        }
+        const std::size_t done = xxh_stripes(acc_, p, size);
+        buffered_ = size - done;
+        if (buffered_ > 0) std::memcpy(buffer_, p + done, buffered_);
+    }
+
+    std::uint64_t hasher64::digest() const noexcept {
+        const std::uint64_t h = total_ >= 32 ? xxh_converge(acc_) : seed_ + P5;
+        return xxh_finalize(h + total_, buffer_, buffered_);
+    }
+
+    void hasher128::reset(std::uint64_t seed) noexcept {
+        h1_ = seed;
+        h2_ = seed;
+        total_ = 0;
+        buffered_ = 0;
+    }
+
+    void hasher128::update(std::span<const std::byte> data) noexcept {
+        const auto* p = reinterpret_cast<const unsigned char*>(data.data());
+        std::size_t size = data.size();
+        total_ += size;
+        if (buffered_ + size < sizeof(buffer_)) {
+            if (size > 0) std::memcpy(buffer_ + buffered_, p, size);
+            buffered_ += size;
+            return;
+        }
+        if (buffered_ > 0) {
+            const std::size_t fill = sizeof(buffer_) - buffered_;
+            std::memcpy(buffer_ + buffered_, p, fill);
+            murmur_blocks(h1_, h2_, buffer_, sizeof(buffer_));
+            p += fill;
+            size -= fill;
+        }
+        const std::size_t done = murmur_blocks(h1_, h2_, p, size);
+        buffered_ = size - done;
+        if (buffered_ > 0) std::memcpy(buffer_, p + done, buffered_);
+    }
+
+    digest128 hasher128::digest() const noexcept {
+        return murmur_finalize(h1_, h2_, buffer_, buffered_, total_);
+    }
+}
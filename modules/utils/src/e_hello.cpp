@@ -1,7 +1,7 @@
 #include "e_hello.h"
 
-#include <iostream>
+#include "e_log.hpp"
 
 void hello(void) {
-    std::cout << "Now calling hello()" << std::endl;
+    E_LOG_INFO("Now calling hello()");
 }
\ No newline at end of file
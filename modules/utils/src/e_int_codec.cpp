@@ -0,0 +1,427 @@
+#include "e_int_codec.hpp"
+
+#include "e_simd.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace e_utils {
+    namespace {
+        constexpr std::size_t block_size = 128;
+
+        // ---------------- 4 路 uint32 ----------------
+        // SSE2 是 x86-64 的 基线，不用 运行时 选择；其他 平台 退回 普通 数组
+
+#if E_UTILS_X86
+        struct lanes4 {
+            __m128i v;
+
+            static lanes4 zero() noexcept { return {_mm_setzero_si128()}; }
+            static lanes4 fill(std::uint32_t x) noexcept { return {_mm_set1_epi32(static_cast<int>(x))}; }
+            static lanes4 load(const void* p) noexcept { return {_mm_loadu_si128(static_cast<const __m128i*>(p))}; }
+            void store(void* p) const noexcept { _mm_storeu_si128(static_cast<__m128i*>(p), v); }
+
+            template <unsigned S>
+            lanes4 shl() const noexcept { return {_mm_slli_epi32(v, S)}; }
+            template <unsigned S>
+            lanes4 shr() const noexcept { return {_mm_srli_epi32(v, S)}; }
+
+            // [a, a+b, a+b+c, a+b+c+d]
+            lanes4 prefix_sum() const noexcept {
+                const __m128i x = _mm_add_epi32(v, _mm_slli_si128(v, 4));
+                return {_mm_add_epi32(x, _mm_slli_si128(x, 8))};
+            }
+
+            // 第 3 路 广播
+            lanes4 last() const noexcept { return {_mm_shuffle_epi32(v, 0xff)}; }
+
+            // [prev 的 第 3 路, a, b, c]
+            lanes4 shift_in(lanes4 prev) const noexcept { return {_mm_or_si128(_mm_slli_si128(v, 4), _mm_srli_si128(prev.v, 12))}; }
+
+            friend lanes4 operator|(lanes4 a, lanes4 b) noexcept { return {_mm_or_si128(a.v, b.v)}; }
+            friend lanes4 operator&(lanes4 a, lanes4 b) noexcept { return {_mm_and_si128(a.v, b.v)}; }
+            friend lanes4 operator+(lanes4 a, lanes4 b) noexcept { return {_mm_add_epi32(a.v, b.v)}; }
+            friend lanes4 operator-(lanes4 a, lanes4 b) noexcept { return {_mm_sub_epi32(a.v, b.v)}; }
+        };
+#else
+        struct lanes4 {
+            std::uint32_t x[4];
+
+            static lanes4 zero() noexcept { return {}; }
+            static lanes4 fill(std::uint32_t v) noexcept { return {{v, v, v, v}}; }
+            static lanes4 load(const void* p) noexcept {
+                lanes4 r;
+                std::memcpy(r.x, p, sizeof(r.x));
+                return r;
+            }
+            void store(void* p) const noexcept { std::memcpy(p, x, sizeof(x)); }
+
+            template <unsigned S>
+            lanes4 shl() const noexcept { return {{x[0] << S, x[1] << S, x[2] << S, x[3] << S}}; }
+            template <unsigned S>
+            lanes4 shr() const noexcept { return {{x[0] >> S, x[1] >> S, x[2] >> S, x[3] >> S}}; }
+
+            lanes4 prefix_sum() const noexcept {
+                const std::uint32_t a = x[0], b = a + x[1], c = b + x[2];
+                return {{a, b, c, c + x[3]}};
+            }
+            lanes4 last() const noexcept { return fill(x[3]); }
+            lanes4 shift_in(lanes4 prev) const noexcept { return {{prev.x[3], x[0], x[1], x[2]}}; }
+
+            friend lanes4 operator|(lanes4 a, lanes4 b) noexcept { return {{a.x[0] | b.x[0], a.x[1] | b.x[1], a.x[2] | b.x[2], a.x[3] | b.x[3]}}; }
+            friend lanes4 operator&(lanes4 a, lanes4 b) noexcept { return {{a.x[0] & b.x[0], a.x[1] & b.x[1], a.x[2] & b.x[2], a.x[3] & b.x[3]}}; }
+            friend lanes4 operator+(lanes4 a, lanes4 b) noexcept { return {{a.x[0] + b.x[0], a.x[1] + b.x[1], a.x[2] + b.x[2], a.x[3] + b.x[3]}}; }
+            friend lanes4 operator-(lanes4 a, lanes4 b) noexcept { return {{a.x[0] - b.x[0], a.x[1] - b.x[1], a.x[2] - b.x[2], a.x[3] - b.x[3]}}; }
+        };
+#endif
+
+        // ---------------- 128 个 一块 的 位 打包 ----------------
+        // 纵向 布局：第 J 步 处理 in[4J .. 4J+3]，每 路 各自 往 自己 的 32 位 字 里 填 B 位
+        // 一块 = 4 路 × B 个 字 = 16B 字节；B 是 模板 参数，32 步 完全 展开，移位 都是 常数
+
+        template <unsigned B, unsigned J>
+        inline void pack_step(const std::uint32_t* in, std::byte* out, lanes4& acc) noexcept {
+            constexpr unsigned bit = J * B, word = bit / 32, shift = bit % 32;
+            const lanes4 x = lanes4::load(in + 4 * J);
+            acc = acc | x.template shl<shift>();
+            if constexpr (shift + B >= 32) {
+                acc.store(out + 16 * word);
+                if constexpr (shift + B > 32) {
+                    acc = x.template shr<32 - shift>();
+                } else {
+                    acc = lanes4::zero();
+                }
+            }
+        }
+
+        template <unsigned B, std::size_t... J>
+        void pack_block(const std::uint32_t* in, std::byte* out, std::index_sequence<J...>) noexcept {
+            if constexpr (B > 0) {
+                lanes4 acc = lanes4::zero();
+                (pack_step<B, J>(in, out, acc), ...);
+            }
+        }
+
+        template <unsigned B, unsigned J, bool Delta>
+        inline void unpack_step(const std::byte* in, std::uint32_t* out, lanes4& w, lanes4 ref, lanes4& prev) noexcept {
+            lanes4 x = ref;
+            if constexpr (B > 0) {
+                constexpr unsigned bit = J * B, word = bit / 32, shift = bit % 32;
+                x = w.template shr<shift>();
+                if constexpr (shift + B > 32) {
+                    w = lanes4::load(in + 16 * (word + 1));
+                    x = x | w.template shl<32 - shift>();
+                } else if constexpr (shift + B == 32 && word + 1 < B) {
+                    w = lanes4::load(in + 16 * (word + 1));
+                }
+                if constexpr (B < 32) {
+                    x = x & lanes4::fill((1u << B) - 1);
+                }
+                x = x + ref;
+            }
+            if constexpr (Delta) {
+                x = x.prefix_sum() + prev.last();
+                prev = x;
+            }
+            x.store(out + 4 * J);
+        }
+
+        template <unsigned B, bool Delta, std::size_t... J>
+        void unpack_block(const std::byte* in, std::uint32_t* out, std::uint32_t ref, std::uint32_t& prev,
+                          std::index_sequence<J...>) noexcept {
+            lanes4 w = lanes4::zero();
+            if constexpr (B > 0) {
+                w = lanes4::load(in);
+            }
+            lanes4 p = lanes4::fill(prev);
+            (unpack_step<B, J, Delta>(in, out, w, lanes4::fill(ref), p), ...);
+            if constexpr (Delta) {
+                prev = out[block_size - 1];
+            }
+        }
+
+        using pack_fn = void (*)(const std::uint32_t* in, std::byte* out) noexcept;
+        using unpack_fn = void (*)(const std::byte* in, std::uint32_t* out, std::uint32_t ref, std::uint32_t& prev) noexcept;
+
+        template <unsigned B>
+        void pack(const std::uint32_t* in, std::byte* out) noexcept {
+            pack_block<B>(in, out, std::make_index_sequence<32>{});
+        }
+
+        template <unsigned B, bool Delta>
+        void unpack(const std::byte* in, std::uint32_t* out, std::uint32_t ref, std::uint32_t& prev) noexcept {
+            unpack_block<B, Delta>(in, out, ref, prev, std::make_index_sequence<32>{});
+        }
+
+        template <std::size_t... B>
+        constexpr std::array<pack_fn, 33> make_pack_table(std::index_sequence<B...>) {
+            return {pack<B>...};
+        }
+
+        template <bool Delta, std::size_t... B>
+        constexpr std::array<unpack_fn, 33> make_unpack_table(std::index_sequence<B...>) {
+            return {unpack<B, Delta>...};
+        }
+
+        // 下标 是 位数 0 ~ 32
+        constexpr auto g_pack = make_pack_table(std::make_index_sequence<33>{});
+        constexpr auto g_unpack = make_unpack_table<false>(std::make_index_sequence<33>{});
+        constexpr auto g_unpack_delta = make_unpack_table<true>(std::make_index_sequence<33>{});
+
+        // 块 头：u32 参考值（块内 最小值）+ u8 位数
+        constexpr std::size_t block_header = 5;
+
+        std::byte* encode_block(const std::uint32_t* in, std::byte* out, bool delta, std::uint32_t& prev) noexcept {
+            alignas(16) std::uint32_t tmp[block_size];
+            if (delta) {
+                lanes4 p = lanes4::fill(prev);
+                for (std::size_t i = 0; i < block_size; i += 4) {
+                    const lanes4 x = lanes4::load(in + i);
+                    (x - x.shift_in(p)).store(tmp + i);
+                    p = x;
+                }
+                prev = in[block_size - 1];
+            } else {
+                std::memcpy(tmp, in, sizeof(tmp));
+            }
+            const auto [lo, hi] = std::minmax_element(tmp, tmp + block_size);
+            const std::uint32_t ref = *lo;
+            const auto bits = static_cast<unsigned>(std::bit_width(*hi - ref));
+            for (std::uint32_t& x : tmp) x -= ref;
+            std::memcpy(out, &ref, sizeof(ref));
+            out[4] = static_cast<std::byte>(bits);
+            g_pack[bits](tmp, out + block_header);
+            return out + block_header + 16 * bits;
+        }
+
+        // ---------------- varint ----------------
+
+        constexpr std::size_t varint_size(std::uint32_t v) noexcept {
+            return 1 + static_cast<std::size_t>(std::bit_width(v | 1) - 1) / 7;
+        }
+
+        std::byte* put_varint(std::uint32_t v, std::byte* p) noexcept {
+            while (v >= 0x80) {
+                *p++ = static_cast<std::byte>(v | 0x80);
+                v >>= 7;
+            }
+            *p++ = static_cast<std::byte>(v);
+            return p;
+        }
+
+        [[noreturn]] void fail(const char* who, const char* what) {
+            throw std::invalid_argument(std::string(who) + ": " + what);
+        }
+
+        const std::byte* get_varints(const std::byte* p, const std::byte* end, std::uint32_t* out, std::size_t n,
+                                     const char* who) {
+            std::size_t i = 0;
+            while (i < n) {
+                if constexpr (std::endian::native == std::endian::little) {
+                    if (end - p >= 8) {
+                        std::uint64_t w;
+                        std::memcpy(&w, p, sizeof(w));
+                        // 连续 8 个 单字节 的 一次 搬完（小 数 常见）
+                        if (n - i >= 8 && (w & 0x8080808080808080ull) == 0) {
+                            for (unsigned k = 0; k < 8; ++k) out[i + k] = static_cast<std::uint32_t>(w >> (8 * k)) & 0xff;
+                            i += 8;
+                            p += 8;
+                            continue;
+                        }
+                        // 无 分支 解 一个：第一个 最高位 为 0 的 字节 定 长度，各 字节 的 7 位 移到 一起 再 截断
+                        const unsigned len = static_cast<unsigned>(std::countr_zero(~w & 0x8080808080808080ull)) / 8 + 1;
+                        if (len < 5 || (len == 5 && ((w >> 32) & 0xff) <= 0x0f)) {
+                            const std::uint64_t v = (w & 0x7f) | ((w >> 1) & 0x3f80) | ((w >> 2) & 0x1fc000)
+                                                  | ((w >> 3) & 0xfe00000) | ((w >> 4) & 0xf0000000);
+                            out[i++] = static_cast<std::uint32_t>(v & ((std::uint64_t{1} << (7 * len)) - 1));
+                            p += len;
+                            continue;
+                        }
+                    }
+                }
+                std::uint32_t v = 0;
+                for (unsigned shift = 0;; shift += 7) {
+                    if (p == end) fail(who, "truncated varint");
+                    const auto b = static_cast<std::uint8_t>(*p++);
+                    if (shift == 28 && b > 0x0f) fail(who, "varint overflows 32 bits");
+                    v |= static_cast<std::uint32_t>(b & 0x7f) << shift;
+                    if (b < 0x80) break;
+                }
+                out[i++] = v;
+            }
+            return p;
+        }
+
+        // ---------------- 头 ----------------
+
+        struct ints_header {
+            std::uint8_t codec;
+            std::uint8_t reserved[3];
+            std::uint32_t count;
+        };
+
+        static_assert(sizeof(ints_header) == 8);
+
+        ints_header read_header(std::span<const std::byte> in, const char* who) {
+            if (in.size() < sizeof(ints_header)) fail(who, "truncated header");
+            ints_header h;
+            std::memcpy(&h, in.data(), sizeof(h));
+            if (h.codec > static_cast<std::uint8_t>(int_codec::delta_bitpack) || h.reserved[0] != 0 || h.reserved[1] != 0
+                || h.reserved[2] != 0) {
+                fail(who, "bad header");
+            }
+            // count 来自 不可信 的 数据：先 检查 剩下 的 字节 装得下，再 按 它 分配
+            // 每个 varint 至少 1 字节，每个 128 个 值 的 块 至少 有 块头
+            std::size_t n = h.count;
+            std::size_t least = 0;
+            const auto codec = static_cast<int_codec>(h.codec);
+            if (codec == int_codec::delta_bitpack && n > 0) {
+                least = 1;
+                --n;
+            }
+            least += codec == int_codec::varint ? n : n / block_size * block_header + n % block_size;
+            if (in.size() - sizeof(ints_header) < least) fail(who, "count exceeds data size");
+            return h;
+        }
+    }
+
+    void delta_encode(std::span<std::uint32_t> values, std::uint32_t prev) noexcept {
+        std::size_t i = 0;
+        lanes4 p = lanes4::fill(prev);
+        for (; i + 4 <= values.size(); i += 4) {
+            const lanes4 x = lanes4::load(values.data() + i);
+            (x - x.shift_in(p)).store(values.data() + i);
+            p = x;
+        }
+        if (i > 0) {
+            std::uint32_t last[4];
+            p.store(last);
+            prev = last[3];
+        }
+        for (; i < values.size(); ++i) {
+            const std::uint32_t x = values[i];
+            values[i] = x - prev;
+            prev = x;
+        }
+    }
+
+    void delta_decode(std::span<std::uint32_t> values, std::uint32_t prev) noexcept {
+        std::size_t i = 0;
+        lanes4 p = lanes4::fill(prev);
+        for (; i + 4 <= values.size(); i += 4) {
+            p = lanes4::load(values.data() + i).prefix_sum() + p.last();
+            p.store(values.data() + i);
+        }
+        if (i > 0) {
+            prev = values[i - 1];
+        }
+        for (; i < values.size(); ++i) values[i] = prev += values[i];
+    }
+
+    std::size_t varint_encode(std::span<const std::uint32_t> values, std::span<std::byte> out) {
+        std::byte* p = out.data();
+        std::byte* const end = out.data() + out.size();
+        for (std::uint32_t v : values) {
+            if (static_cast<std::size_t>(end - p) < varint_size(v)) fail("e_utils::varint_encode", "output too small");
+            p = put_varint(v, p);
+        }
+        return static_cast<std::size_t>(p - out.data());
+    }
+
+    std::size_t varint_decode(std::span<const std::byte> in, std::span<std::uint32_t> out) {
+        const std::byte* end = get_varints(in.data(), in.data() + in.size(), out.data(), out.size(), "e_utils::varint_decode");
+        return static_cast<std::size_t>(end - in.data());
+    }
+
+    std::size_t encode_ints(std::span<const std::uint32_t> values, std::span<std::byte> out, int_codec codec) {
+        constexpr const char* who = "e_utils::encode_ints";
+        if (values.size() > std::numeric_limits<std::uint32_t>::max()) fail(who, "more than 2^32 - 1 values");
+        if (out.size() < max_encoded_ints_size(values.size())) fail(who, "output smaller than max_encoded_ints_size");
+
+        ints_header h{};
+        h.codec = static_cast<std::uint8_t>(codec);
+        h.count = static_cast<std::uint32_t>(values.size());
+        std::memcpy(out.data(), &h, sizeof(h));
+        std::byte* p = out.data() + sizeof(h);
+
+        std::size_t i = 0;
+        std::uint32_t prev = 0;
+        if (codec != int_codec::varint) {
+            const bool delta = codec == int_codec::delta_bitpack;
+            if (delta && !values.empty()) {
+                // 第一个 值 单独 存，块 从 第二个 开始，免得 第一块 被 一个 大数 撑到 32 位
+                prev = values[0];
+                p = put_varint(prev, p);
+                i = 1;
+            }
+            for (; i + block_size <= values.size(); i += block_size) p = encode_block(values.data() + i, p, delta, prev);
+            if (delta) {
+                for (; i < values.size(); ++i) {
+                    p = put_varint(values[i] - prev, p);
+                    prev = values[i];
+                }
+            }
+        }
+        for (; i < values.size(); ++i) p = put_varint(values[i], p);
+        return static_cast<std::size_t>(p - out.data());
+    }
+
+    std::vector<std::byte> encode_ints(std::span<const std::uint32_t> values, int_codec codec) {
+        std::vector<std::byte> out(max_encoded_ints_size(values.size()));
+        out.resize(encode_ints(values, out, codec));
+        return out;
+    }
+
+    std::size_t encoded_ints_count(std::span<const std::byte> in) {
+        return read_header(in, "e_utils::encoded_ints_count").count;
+    }
+
+    std::size_t decode_ints(std::span<const std::byte> in, std::span<std::uint32_t> out) {
+        constexpr const char* who = "e_utils::decode_ints";
+        const ints_header h = read_header(in, who);
+        const std::size_t n = h.count;
+        if (out.size() < n) fail(who, "output too small");
+
+        const std::byte* p = in.data() + sizeof(h);
+        const std::byte* const end = in.data() + in.size();
+        std::size_t i = 0;
+        std::uint32_t prev = 0;
+        const auto codec = static_cast<int_codec>(h.codec);
+        if (codec != int_codec::varint) {
+            const auto& table = codec == int_codec::delta_bitpack ? g_unpack_delta : g_unpack;
+            if (codec == int_codec::delta_bitpack && n > 0) {
+                p = get_varints(p, end, &prev, 1, who);
+                out[0] = prev;
+                i = 1;
+            }
+            for (; i + block_size <= n; i += block_size) {
+                if (end - p < static_cast<std::ptrdiff_t>(block_header)) fail(who, "truncated block");
+                std::uint32_t ref;
+                std::memcpy(&ref, p, sizeof(ref));
+                const auto bits = static_cast<unsigned>(p[4]);
+                if (bits > 32) fail(who, "bad block width");
+                p += block_header;
+                if (end - p < static_cast<std::ptrdiff_t>(16 * bits)) fail(who, "truncated block");
+                table[bits](p, out.data() + i, ref, prev);
+                p += 16 * bits;
+            }
+        }
+        get_varints(p, end, out.data() + i, n - i, who);
+        if (codec == int_codec::delta_bitpack) {
+            delta_decode(out.subspan(i, n - i), prev);
+        }
+        return n;
+    }
+
+    std::vector<std::uint32_t> decode_ints(std::span<const std::byte> in) {
+        std::vector<std::uint32_t> out(encoded_ints_count(in));
+        decode_ints(in, out);
+        return out;
+    }
+}
@@ -0,0 +1,435 @@
+#include "e_log.hpp"
+#include "e_simd.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(_MSC_VER)
+    #include <intrin.h> // __rdtsc
+#endif
+
+namespace e_utils {
+    namespace detail {
+        std::atomic<int> g_log_min_level{static_cast<int>(log_level::info)};
+    }
+
+    namespace {
+        using detail::log_format_fn;
+        using detail::log_site;
+
+        // 记录 头；记录 按 8 字节 对齐 首尾 相接，放不下 的 尾部 用 一条 填充 记录 跳过
+        struct record_header {
+            std::uint32_t size; // 含 头，8 的 倍数
+            std::uint32_t kind;
+            const log_site* site;
+            log_format_fn format;
+            std::int64_t time; // record_time()
+        };
+
+        constexpr std::uint32_t kind_padding = 0;
+        constexpr std::uint32_t kind_record = 1;
+
+        // 空闲 时 后台 多久 看 一次
+        constexpr auto poll_interval = std::chrono::milliseconds(2);
+
+        constexpr std::size_t align8(std::size_t n) noexcept { return (n + 7) & ~std::size_t{7}; }
+
+        std::int64_t now_ns() noexcept {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        }
+
+        std::int64_t steady_ns() noexcept {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        // 记录 的 时间戳：x86 上 读 TSC（几 ns，系统 时钟 要 几十 ns），由 后台 换算 成 UTC；其他 平台 直接 取 系统 时间
+        std::int64_t record_time() noexcept {
+#if E_UTILS_X86
+            return static_cast<std::int64_t>(__rdtsc());
+#else
+            return now_ns();
+#endif
+        }
+
+        // record_time() 换算 成 UTC ns，只在 后台 线程 用
+        // 频率 用 启动 以来 整段 时间 估计，越 跑 越 准；每轮 sync() 重新 对齐 系统 时间，跟上 NTP 之类 的 调整
+        class tick_clock {
+        public:
+            tick_clock() : start_ticks_(record_time()), start_steady_(steady_ns()) {
+#if E_UTILS_X86
+                // 先 量 1 ms 得到 初始 频率
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+#endif
+                sync();
+            }
+
+            void sync() noexcept {
+#if E_UTILS_X86
+                const std::int64_t ticks = record_time();
+                const std::int64_t steady = steady_ns();
+                if (ticks > start_ticks_ && steady > start_steady_) {
+                    ns_per_tick_ = static_cast<double>(steady - start_steady_) / static_cast<double>(ticks - start_ticks_);
+                }
+                anchor_ticks_ = ticks;
+                anchor_ns_ = now_ns();
+#endif
+            }
+
+            std::int64_t to_ns(std::int64_t time) const noexcept {
+#if E_UTILS_X86
+                return anchor_ns_ + static_cast<std::int64_t>(static_cast<double>(time - anchor_ticks_) * ns_per_tick_);
+#else
+                return time;
+#endif
+            }
+
+        private:
+            std::int64_t start_ticks_;
+            std::int64_t start_steady_;
+            double ns_per_tick_ = 1.0;
+            std::int64_t anchor_ticks_ = 0;
+            std::int64_t anchor_ns_ = 0;
+        };
+
+        std::atomic<std::uint64_t> g_dropped{0};
+        std::atomic<log_full_policy> g_full_policy{log_full_policy::drop};
+
+        // 单 生产者（所属 线程）单 消费者（后台 线程）
+        struct log_ring {
+            explicit log_ring(std::size_t capacity)
+                : data(std::make_unique<std::byte[]>(capacity)), mask(capacity - 1) {}
+
+            std::unique_ptr<std::byte[]> data;
+            const std::size_t mask;
+
+            alignas(64) std::atomic<std::uint64_t> head{0}; // 生产者 写
+            std::uint64_t tail_cache = 0;                   // 生产者 看到 的 tail，减少 读 共享 行
+            std::uint64_t pending = 0;                      // log_begin 预留 后 的 head
+
+            alignas(64) std::atomic<std::uint64_t> tail{0}; // 消费者 写
+            std::atomic<bool> closed{false};                // 所属 线程 已 退出
+        };
+
+        class log_backend {
+        public:
+            log_backend(const log_backend&) = delete;
+            log_backend& operator=(const log_backend&) = delete;
+
+            static log_backend& instance() {
+                // 故意 泄漏，同 e_math 的 线程池；进程 退出 时 由 atexit 刷出
+                static log_backend* backend = [] {
+                    auto* b = new log_backend();
+                    std::atexit([] { log_flush(); });
+                    return b;
+                }();
+                return *backend;
+            }
+
+            log_ring* add_ring() {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto ring = std::make_unique<log_ring>(std::bit_ceil(std::max<std::size_t>(buffer_bytes_, 4096)));
+                rings_.push_back(std::move(ring));
+                return rings_.back().get();
+            }
+
+            // 等 空间 的 生产者 会 反复 调用，只 在 第一次 通知
+            void wake() noexcept {
+                if (!wake_.exchange(true, std::memory_order_release)) {
+                    cv_.notify_one();
+                }
+            }
+
+            void flush() {
+                if (std::this_thread::get_id() == thread_.get_id()) {
+                    return; // sink 里 又 写 日志，不能 等 自己
+                }
+                std::unique_lock<std::mutex> lock(mutex_);
+                // 之后 开始 的 一轮 一定 能 看到 本 线程 之前 发布 的 记录
+                const std::uint64_t target = pass_begun_ + 1;
+                flush_target_ = std::max(flush_target_, target);
+                cv_.notify_one();
+                done_.wait(lock, [&] { return pass_done_ >= target; });
+            }
+
+            void configure(log_options options) {
+                flush();
+                std::lock_guard<std::mutex> lock(mutex_);
+                buffer_bytes_ = options.buffer_bytes;
+                sink_ = std::move(options.sink);
+                g_full_policy.store(options.full_policy, std::memory_order_relaxed);
+                detail::g_log_min_level.store(static_cast<int>(options.min_level), std::memory_order_relaxed);
+            }
+
+        private:
+            log_backend() : thread_([this] { run(); }) {}
+
+            void run() {
+                tick_clock clock;
+                std::string batch;
+                std::vector<log_ring*> rings;
+                std::uint64_t reported_drops = 0;
+                for (;;) {
+                    std::function<void(std::string_view)> sink;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex_);
+                        if (batch.empty() && flush_target_ <= pass_done_) {
+                            cv_.wait_for(lock, poll_interval, [&] {
+                                return wake_.exchange(false, std::memory_order_acquire) || flush_target_ > pass_done_;
+                            });
+                        }
+                        ++pass_begun_;
+                        // 已 退出 的 线程 的 缓冲：上一轮 已经 读空，可以 释放
+                        std::erase_if(rings_, [](const std::unique_ptr<log_ring>& r) {
+                            return r->closed.load(std::memory_order_acquire)
+                                   && r->tail.load(std::memory_order_relaxed) == r->head.load(std::memory_order_acquire);
+                        });
+                        rings.clear();
+                        for (const auto& r : rings_) rings.push_back(r.get());
+                        sink = sink_;
+                    }
+
+                    batch.clear();
+                    clock.sync();
+                    for (log_ring* r : rings) drain(*r, batch, clock);
+                    const std::uint64_t dropped = g_dropped.load(std::memory_order_relaxed);
+                    if (dropped != reported_drops) {
+                        append_line(batch, now_ns(), log_level::warn);
+                        batch += "log buffer full, dropped ";
+                        detail::log_append(batch, dropped - reported_drops);
+                        batch += " messages\n";
+                        reported_drops = dropped;
+                    }
+                    if (!batch.empty()) {
+                        write(sink, batch);
+                    }
+
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    pass_done_ = pass_begun_;
+                    done_.notify_all();
+                }
+            }
+
+            static void drain(log_ring& r, std::string& batch, const tick_clock& clock) {
+                std::uint64_t tail = r.tail.load(std::memory_order_relaxed);
+                const std::uint64_t head = r.head.load(std::memory_order_acquire);
+                while (tail != head) {
+                    const std::byte* p = r.data.get() + (tail & r.mask);
+                    record_header h;
+                    std::memcpy(&h, p, 2 * sizeof(std::uint32_t));
+                    if (h.kind == kind_record) {
+                        std::memcpy(&h, p, sizeof(h));
+                        append_line(batch, clock.to_ns(h.time), h.site->level);
+                        h.format(batch, h.site->format, p + sizeof(h));
+                        batch += '\n';
+                    }
+                    tail += h.size;
+                }
+                r.tail.store(tail, std::memory_order_release);
+            }
+
+            // 时间 与 级别 前缀；同 一秒 内 的 "YYYY-MM-DD HH:MM:SS." 只 算 一次
+            static void append_line(std::string& out, std::int64_t time_ns, log_level level) {
+                using namespace std::chrono;
+                static thread_local std::int64_t cached_second = -1;
+                static thread_local char cached[32];
+                const sys_time<nanoseconds> t{nanoseconds(time_ns)};
+                const auto second = floor<seconds>(t);
+                if (second.time_since_epoch().count() != cached_second) {
+                    cached_second = second.time_since_epoch().count();
+                    const auto day = floor<days>(t);
+                    const year_month_day ymd{day};
+                    const hh_mm_ss hms{second - day};
+                    std::snprintf(cached, sizeof(cached), "%04d-%02u-%02u %02d:%02d:%02d.", static_cast<int>(ymd.year()),
+                                  static_cast<unsigned>(ymd.month()), static_cast<unsigned>(ymd.day()),
+                                  static_cast<int>(hms.hours().count()), static_cast<int>(hms.minutes().count()),
+                                  static_cast<int>(hms.seconds().count()));
+                }
+                out.append(cached, 20);
+                auto us = static_cast<unsigned>(floor<microseconds>(t - second).count());
+                char digits[7] = {0, 0, 0, 0, 0, 0, ' '};
+                for (int i = 5; i >= 0; --i, us /= 10) digits[i] = static_cast<char>('0' + us % 10);
+                out.append(digits, sizeof(digits));
+                static constexpr const char* names[] = {"DEBUG ", "INFO  ", "WARN  ", "ERROR ", "OFF   "};
+                out += names[static_cast<int>(level)];
+            }
+
+            static void write(const std::function<void(std::string_view)>& sink, const std::string& batch) {
+                if (!sink) {
+                    std::fwrite(batch.data(), 1, batch.size(), stdout);
+                    std::fflush(stdout);
+                    return;
+                }
+                try {
+                    sink(batch);
+                } catch (...) {
+                    // sink 的 异常 不能 带走 后台 线程
+                }
+            }
+
+            std::mutex mutex_;
+            std::condition_variable cv_;
+            std::condition_variable done_;
+            std::atomic<bool> wake_{false};
+
+            std::vector<std::unique_ptr<log_ring>> rings_;
+            std::size_t buffer_bytes_ = log_options{}.buffer_bytes;
+            std::function<void(std::string_view)> sink_;
+
+            std::uint64_t pass_begun_ = 0;
+            std::uint64_t pass_done_ = 0;
+            std::uint64_t flush_target_ = 0;
+
+            std::thread thread_; // 最后 初始化，线程 启动 时 其他 成员 已 就绪
+        };
+
+        // 线程 退出 时 标记 缓冲，交给 后台 读空 后 释放
+        struct ring_owner {
+            log_ring* ring = nullptr;
+            bool exited = false;
+
+            ~ring_owner() {
+                if (ring != nullptr) {
+                    ring->closed.store(true, std::memory_order_release);
+                }
+                ring = nullptr;
+                exited = true;
+            }
+        };
+
+        thread_local ring_owner t_owner;
+
+        log_ring* thread_ring() {
+            if (t_owner.ring == nullptr && !t_owner.exited) {
+                t_owner.ring = log_backend::instance().add_ring();
+            }
+            return t_owner.ring;
+        }
+    }
+
+    namespace detail {
+        std::byte* log_begin(std::size_t args_size, const log_site& site, log_format_fn format) {
+            log_ring* r = thread_ring();
+            const std::size_t need = align8(sizeof(record_header) + args_size);
+            const std::size_t capacity = r == nullptr ? 0 : r->mask + 1;
+            if (need > capacity / 2) {
+                // 线程 正在 退出，或者 一条 就 超过 缓冲 一半
+                g_dropped.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            std::uint64_t pos = r->head.load(std::memory_order_relaxed);
+            const std::size_t to_end = capacity - (pos & r->mask);
+            const std::size_t total = to_end < need ? to_end + need : need;
+            if (pos + total - r->tail_cache > capacity) {
+                r->tail_cache = r->tail.load(std::memory_order_acquire);
+                while (pos + total - r->tail_cache > capacity) {
+                    if (g_full_policy.load(std::memory_order_relaxed) == log_full_policy::drop) {
+                        g_dropped.fetch_add(1, std::memory_order_relaxed);
+                        return nullptr;
+                    }
+                    log_backend::instance().wake();
+                    std::this_thread::yield();
+                    r->tail_cache = r->tail.load(std::memory_order_acquire);
+                }
+            }
+
+            if (to_end < need) {
+                const std::uint32_t pad[2] = {static_cast<std::uint32_t>(to_end), kind_padding};
+                std::memcpy(r->data.get() + (pos & r->mask), pad, sizeof(pad));
+                pos += to_end;
+            }
+            std::byte* p = r->data.get() + (pos & r->mask);
+            const record_header h = {static_cast<std::uint32_t>(need), kind_record, &site, format, record_time()};
+            std::memcpy(p, &h, sizeof(h));
+            r->pending = pos + need;
+            return p + sizeof(h);
+        }
+
+        void log_end() noexcept {
+            log_ring* r = t_owner.ring;
+            r->head.store(r->pending, std::memory_order_release);
+        }
+
+        const char* log_append_literal(std::string& out, const char* format) {
+            const char* p = format;
+            for (;;) {
+                const char* q = p;
+                while (*q != '\0' && *q != '{' && *q != '}') ++q;
+                out.append(p, static_cast<std::size_t>(q - p));
+                if (*q == '\0') {
+                    return q;
+                }
+                if (q[1] == q[0]) {
+                    // {{ 或 }}
+                    out += *q;
+                    p = q + 2;
+                } else if (q[0] == '{' && q[1] == '}') {
+                    return q + 2;
+                } else {
+                    out += *q;
+                    p = q + 1;
+                }
+            }
+        }
+
+        void log_append(std::string& out, bool v) {
+            out += v ? "true" : "false";
+        }
+
+        void log_append(std::string& out, char v) {
+            out += v;
+        }
+
+        namespace {
+            template <class T>
+            void append_chars(std::string& out, T v) {
+                char buf[32];
+                const auto r = std::to_chars(buf, buf + sizeof(buf), v);
+                out.append(buf, r.ptr);
+            }
+        }
+
+        void log_append(std::string& out, std::int64_t v) {
+            append_chars(out, v);
+        }
+
+        void log_append(std::string& out, std::uint64_t v) {
+            append_chars(out, v);
+        }
+
+        void log_append(std::string& out, double v) {
+            append_chars(out, v);
+        }
+
+        void log_append(std::string& out, const void* v) {
+            char buf[32] = "0x";
+            const auto r = std::to_chars(buf + 2, buf + sizeof(buf), reinterpret_cast<std::uintptr_t>(v), 16);
+            out.append(buf, r.ptr);
+        }
+
+        void log_append(std::string& out, std::string_view v) {
+            out += v;
+        }
+    }
+
+    void set_log_options(log_options options) {
+        log_backend::instance().configure(std::move(options));
+    }
+
+    void log_flush() {
+        log_backend::instance().flush();
+    }
+
+    std::uint64_t log_dropped() noexcept {
+        return g_dropped.load(std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,50 @@
+#include "e_mpmc_queue.hpp"
+#include "e_simd.hpp"
+
+#include <thread>
+
+#if defined(__linux__)
+    #include <climits>
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace e_utils::detail {
+    void spin_wait(unsigned round) noexcept {
+        if (round >= 16) {
+            std::this_thread::yield();
+            return;
+        }
+#if E_UTILS_X86
+        _mm_pause();
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+        __asm__ __volatile__("yield");
+#endif
+    }
+
+#if defined(__linux__)
+    // 直接 用 futex：std::atomic::wait 在 libstdc++ 里 还要 过 一层 全局 等待 表
+    void park_wait(std::atomic<std::uint32_t>& word, std::uint32_t expected) noexcept {
+        static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t));
+        ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+    }
+
+    void park_wake(std::atomic<std::uint32_t>& word, bool all) noexcept {
+        ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE_PRIVATE, all ? INT_MAX : 1, nullptr, nullptr, 0);
+    }
+#else
+    // 其他 平台 交给 标准库（MSVC 上 是 WaitOnAddress）
+    void park_wait(std::atomic<std::uint32_t>& word, std::uint32_t expected) noexcept {
+        word.wait(expected, std::memory_order_relaxed);
+    }
+
+    void park_wake(std::atomic<std::uint32_t>& word, bool all) noexcept {
+        if (all) {
+            word.notify_all();
+        } else {
+            word.notify_one();
+        }
+    }
+#endif
+}
@@ -0,0 +1,332 @@
+#include "e_object_pool.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <new>
+#include <vector>
+
+namespace e_utils {
+    namespace detail {
+        namespace {
+            constexpr std::uint32_t no_slot = ~std::uint32_t{0};
+            // 在用 数 的 变化 攒够 这么多 才 汇总 到 池 里
+            constexpr std::int64_t live_batch = 16;
+
+            // 空闲 槽 开头 的 指针：本线程 链表 与 一批 之内 的 链表；只有 持有 者 读写
+            struct free_node {
+                free_node* next;
+            };
+
+            struct cache_entry {
+                const pool_core* pool = nullptr;
+                std::uint64_t id = 0;
+                free_node* active = nullptr; // 分配 / 释放 都 在 这里
+                std::size_t active_count = 0;
+                free_node* spare = nullptr;  // 满 的 一批 或 空
+                std::int64_t live = 0;       // 还没 汇总 的 在用 数 变化
+            };
+
+            // 活着 的 池，按 cache_slot 下标；线程 退出 与 池 销毁 用 同一把 锁，退出 时 只 还给 还活着 的 池
+            struct pool_registry {
+                std::mutex mutex;
+                std::vector<const pool_core*> pools;
+                std::vector<std::size_t> free_slots;
+                std::uint64_t next_id = 1;
+            };
+
+            pool_registry& registry() {
+                // 故意 泄漏：线程 可能 在 静态 析构 之后 才 退出
+                static pool_registry* r = new pool_registry();
+                return *r;
+            }
+
+            struct thread_caches {
+                std::vector<cache_entry> entries; // 按 cache_slot 下标
+                ~thread_caches();
+            };
+
+            thread_local bool t_exited = false;
+            thread_local thread_caches t_caches;
+
+            constexpr std::uint64_t pack(std::uint64_t high, std::uint32_t low) noexcept {
+                return high << 32 | low;
+            }
+        }
+
+        struct pool_access {
+            // 本线程 在 这个 池 上 的 缓存；线程 正在 退出 时 返回 nullptr
+            static cache_entry* cache(pool_core& pool) {
+                if (t_exited) {
+                    return nullptr;
+                }
+                auto& entries = t_caches.entries;
+                if (pool.cache_slot_ >= entries.size()) {
+                    entries.resize(pool.cache_slot_ + 1);
+                }
+                cache_entry& c = entries[pool.cache_slot_];
+                if (c.id != pool.id_) {
+                    // 原来 占 这个 位置 的 池 已经 销毁，它 的 内存 已经 释放，链表 直接 丢掉
+                    c = cache_entry{&pool, pool.id_};
+                }
+                return &c;
+            }
+
+            static void flush_live(pool_core& pool, cache_entry& c) noexcept {
+                if (c.live != 0) {
+                    pool.add_live(c.live);
+                    c.live = 0;
+                }
+            }
+
+            // 一批（head 开始 count 个，已 用 next 串好）推 进 共享 栈
+            static void push_batch(pool_core& pool, free_node* head, std::size_t count) noexcept {
+                const std::uint32_t index = pool.index_of(head);
+                pool.link(index).store(pack(count, no_slot), std::memory_order_relaxed);
+                pool.push(index, index);
+            }
+
+            // 取 一批：共享 栈 空 就 分配 新 slab
+            static free_node* take_batch(pool_core& pool, std::size_t& count) {
+                std::uint32_t index;
+                if (!pool.pop(index)) {
+                    index = pool.grow();
+                }
+                count = static_cast<std::size_t>(pool.link(index).load(std::memory_order_relaxed) >> 32);
+                return reinterpret_cast<free_node*>(pool.slot(index));
+            }
+
+            // 线程 退出：缓存 全部 还给 还活着 的 池
+            static void thread_exit(std::vector<cache_entry>& entries) {
+                pool_registry& r = registry();
+                std::lock_guard<std::mutex> lock(r.mutex);
+                for (std::size_t i = 0; i < entries.size(); ++i) {
+                    cache_entry& c = entries[i];
+                    if (c.pool == nullptr || i >= r.pools.size() || r.pools[i] != c.pool) {
+                        continue;
+                    }
+                    // 持 锁，池 不会 同时 销毁；地址 相同 的 新 池 id 不同
+                    auto& pool = const_cast<pool_core&>(*c.pool);
+                    if (c.id != pool.id_) {
+                        continue;
+                    }
+                    if (c.active != nullptr) {
+                        push_batch(pool, c.active, c.active_count);
+                    }
+                    if (c.spare != nullptr) {
+                        push_batch(pool, c.spare, pool.batch_);
+                    }
+                    flush_live(pool, c);
+                    c = cache_entry{};
+                }
+            }
+        };
+
+        namespace {
+            thread_caches::~thread_caches() {
+                t_exited = true;
+                pool_access::thread_exit(entries);
+            }
+        }
+
+        pool_core::pool_core(std::size_t size, std::size_t alignment, pool_options options)
+            : alignment_(std::max(alignment, alignof(free_node))),
+              base_shift_(static_cast<unsigned>(std::bit_width(std::bit_ceil(std::clamp<std::size_t>(options.slab_objects, 1, std::size_t{1} << 20))) - 1)),
+              batch_(std::max<std::size_t>(options.thread_cache / 2, 1)),
+              head_(pack(0, no_slot)) {
+            size_ = (std::max(size, sizeof(free_node)) + alignment_ - 1) / alignment_ * alignment_;
+            pool_registry& r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            id_ = r.next_id++;
+            if (r.free_slots.empty()) {
+                cache_slot_ = r.pools.size();
+                r.pools.push_back(this);
+            } else {
+                cache_slot_ = r.free_slots.back();
+                r.free_slots.pop_back();
+                r.pools[cache_slot_] = this;
+            }
+        }
+
+        pool_core::~pool_core() {
+            {
+                pool_registry& r = registry();
+                std::lock_guard<std::mutex> lock(r.mutex);
+                r.pools[cache_slot_] = nullptr;
+                r.free_slots.push_back(cache_slot_);
+            }
+            const std::size_t n = slab_count_.load(std::memory_order_relaxed);
+            for (std::size_t k = 0; k < n; ++k) {
+                ::operator delete(slabs_[k].load(std::memory_order_relaxed), std::align_val_t{std::max<std::size_t>(alignment_, 64)});
+            }
+        }
+
+        void* pool_core::allocate() {
+            cache_entry* c = pool_access::cache(*this);
+            if (c == nullptr) {
+                // 线程 正在 退出：取 一批 拿 一个，剩下 的 放回
+                add_live(1);
+                std::size_t count;
+                free_node* node = pool_access::take_batch(*this, count);
+                if (count > 1) {
+                    pool_access::push_batch(*this, node->next, count - 1);
+                }
+                return node;
+            }
+            if (c->active == nullptr) {
+                if (c->spare != nullptr) {
+                    c->active = c->spare;
+                    c->active_count = batch_;
+                    c->spare = nullptr;
+                } else {
+                    c->active = pool_access::take_batch(*this, c->active_count);
+                    pool_access::flush_live(*this, *c);
+                }
+            }
+            free_node* node = c->active;
+            c->active = node->next;
+            --c->active_count;
+            if (++c->live >= live_batch) {
+                pool_access::flush_live(*this, *c);
+            }
+            return node;
+        }
+
+        void pool_core::deallocate(void* p) noexcept {
+            auto* node = static_cast<free_node*>(p);
+            cache_entry* c = pool_access::cache(*this);
+            if (c == nullptr) {
+                add_live(-1);
+                node->next = nullptr;
+                pool_access::push_batch(*this, node, 1);
+                return;
+            }
+            node->next = c->active;
+            c->active = node;
+            if (++c->active_count == batch_) {
+                // 攒满 一批：换 到 spare，原来 的 spare 整批 还给 共享 栈
+                if (c->spare != nullptr) {
+                    pool_access::push_batch(*this, c->spare, batch_);
+                }
+                c->spare = c->active;
+                c->active = nullptr;
+                c->active_count = 0;
+            }
+            if (--c->live <= -live_batch) {
+                pool_access::flush_live(*this, *c);
+            }
+        }
+
+        pool_stats pool_core::stats() const noexcept {
+            const std::size_t n = slab_count_.load(std::memory_order_acquire);
+            pool_stats s;
+            s.slabs = n;
+            s.capacity = ((std::size_t{1} << n) - 1) << base_shift_;
+            s.live = static_cast<std::size_t>(std::max<std::int64_t>(live_.load(std::memory_order_relaxed), 0));
+            s.peak_live = static_cast<std::size_t>(peak_.load(std::memory_order_relaxed));
+            return s;
+        }
+
+        // 第 k 个 slab 有 2^(base_shift + k) 个 槽，下标 连续 编号
+        std::pair<std::size_t, std::size_t> pool_core::locate(std::uint32_t index) const noexcept {
+            const std::uint64_t group = (std::uint64_t{index} >> base_shift_) + 1;
+            const auto k = static_cast<std::size_t>(std::bit_width(group)) - 1;
+            return {k, index - (((std::size_t{1} << k) - 1) << base_shift_)};
+        }
+
+        std::byte* pool_core::slot(std::uint32_t index) const noexcept {
+            const auto [k, offset] = locate(index);
+            return slabs_[k].load(std::memory_order_relaxed) + offset * size_;
+        }
+
+        // 槽 后面 是 每个 槽 一个 的 链接 数组，只有 批 头 的 有用：高 32 位 这批 的 个数，低 32 位 下一批 的 头
+        std::atomic<std::uint64_t>& pool_core::link(std::uint32_t index) const noexcept {
+            const auto [k, offset] = locate(index);
+            std::byte* links = slabs_[k].load(std::memory_order_relaxed) + (std::size_t{1} << (base_shift_ + k)) * size_;
+            return reinterpret_cast<std::atomic<std::uint64_t>*>(links)[offset];
+        }
+
+        std::uint32_t pool_core::index_of(const void* p) const noexcept {
+            const auto addr = reinterpret_cast<std::uintptr_t>(p);
+            // 大 slab 在 后面，多数 对象 在 里面，倒着 找
+            for (std::size_t k = slab_count_.load(std::memory_order_acquire); k-- > 0;) {
+                const auto base = reinterpret_cast<std::uintptr_t>(slabs_[k].load(std::memory_order_relaxed));
+                const std::size_t count = std::size_t{1} << (base_shift_ + k);
+                if (addr >= base && addr - base < count * size_) {
+                    return static_cast<std::uint32_t>((((std::size_t{1} << k) - 1) << base_shift_) + (addr - base) / size_);
+                }
+            }
+            return no_slot; // 不是 本池 的 对象
+        }
+
+        // 批 头 first .. last 已经 用 link() 的 低 32 位 串好；只 改 last 的 低 32 位
+        void pool_core::push(std::uint32_t first, std::uint32_t last) noexcept {
+            std::atomic<std::uint64_t>& tail = link(last);
+            const std::uint64_t count = tail.load(std::memory_order_relaxed) >> 32;
+            std::uint64_t old = head_.load(std::memory_order_relaxed);
+            do {
+                tail.store(pack(count, static_cast<std::uint32_t>(old)), std::memory_order_relaxed);
+            } while (!head_.compare_exchange_weak(old, pack((old >> 32) + 1, first), std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        // 版本号 每次 修改 加 1，被 取走 又 放回 的 同一个 批 头 不会 让 CAS 误 成功（ABA）
+        // 读到 的 top 可能 刚被 别的 线程 取走：链接 不在 对象 里，读 它 不会 和 对象 的 写 冲突，CAS 会 失败 重来
+        bool pool_core::pop(std::uint32_t& index) noexcept {
+            std::uint64_t old = head_.load(std::memory_order_acquire);
+            for (;;) {
+                const auto top = static_cast<std::uint32_t>(old);
+                if (top == no_slot) {
+                    return false;
+                }
+                const auto next = static_cast<std::uint32_t>(link(top).load(std::memory_order_relaxed));
+                if (head_.compare_exchange_weak(old, pack((old >> 32) + 1, next), std::memory_order_acquire, std::memory_order_acquire)) {
+                    index = top;
+                    return true;
+                }
+            }
+        }
+
+        // 分配 新 slab，切 成 批：返回 第一批 的 头，其余 推 进 共享 栈
+        std::uint32_t pool_core::grow() {
+            std::lock_guard<std::mutex> lock(grow_mutex_);
+            std::uint32_t index;
+            if (pop(index)) {
+                return index; // 等 锁 的 时候 别的 线程 已经 加了 slab
+            }
+            const std::size_t k = slab_count_.load(std::memory_order_relaxed);
+            // 下标 要 放得进 32 位（no_slot 保留）
+            if (k >= max_slabs || base_shift_ + k >= 32 || ((std::uint64_t{2} << k) - 1) << base_shift_ >= no_slot) {
+                throw std::bad_alloc();
+            }
+            using link_type = std::atomic<std::uint64_t>;
+            const std::size_t count = std::size_t{1} << (base_shift_ + k);
+            auto* slab = static_cast<std::byte*>(
+                ::operator new(count * (size_ + sizeof(link_type)), std::align_val_t{std::max<std::size_t>(alignment_, 64)}));
+            std::byte* links = slab + count * size_;
+            const auto first = static_cast<std::uint32_t>(((std::size_t{1} << k) - 1) << base_shift_);
+            for (std::size_t begin = 0; begin < count; begin += batch_) {
+                const std::size_t end = std::min(begin + batch_, count);
+                for (std::size_t i = begin; i < end; ++i) {
+                    auto* node = reinterpret_cast<free_node*>(slab + i * size_);
+                    node->next = i + 1 < end ? reinterpret_cast<free_node*>(slab + (i + 1) * size_) : nullptr;
+                }
+                const std::uint32_t next = end < count ? static_cast<std::uint32_t>(first + end) : no_slot;
+                ::new (links + begin * sizeof(link_type)) link_type(pack(end - begin, next));
+            }
+            slabs_[k].store(slab, std::memory_order_relaxed);
+            slab_count_.store(k + 1, std::memory_order_release);
+
+            // 第一批 给 调用者，其余 一次 推 进 共享 栈
+            if (count > batch_) {
+                push(static_cast<std::uint32_t>(first + batch_), static_cast<std::uint32_t>(first + (count - 1) / batch_ * batch_));
+            }
+            return first;
+        }
+
+        void pool_core::add_live(std::int64_t delta) noexcept {
+            const std::int64_t live = live_.fetch_add(delta, std::memory_order_relaxed) + delta;
+            std::int64_t peak = peak_.load(std::memory_order_relaxed);
+            while (live > peak && !peak_.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+            }
+        }
+    }
+}
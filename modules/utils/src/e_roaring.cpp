@@ -0,0 +1,979 @@
+#include "e_roaring.hpp"
+
+#include "e_simd.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace e_utils {
+    namespace detail {
+        roaring_ref roaring_container::ref() const noexcept {
+            switch (kind) {
+                case roaring_kind::array:
+                    return {key, kind, cardinality, static_cast<std::uint32_t>(values.size()), values.data()};
+                case roaring_kind::bitmap:
+                    return {key, kind, cardinality, static_cast<std::uint32_t>(words.size()), words.data()};
+                default:
+                    return {key, kind, cardinality, static_cast<std::uint32_t>(values.size() / 2), values.data()};
+            }
+        }
+    }
+
+    namespace {
+        using detail::roaring_container;
+        using detail::roaring_kind;
+        using detail::roaring_ref;
+
+        constexpr std::uint32_t array_max = 4096;
+        constexpr std::uint32_t bitmap_words = 1024;
+
+        // ---------------- 序列化 格式 ----------------
+
+        struct roaring_header {
+            char magic[8];
+            std::uint32_t containers;
+            std::uint32_t reserved;
+        };
+
+        struct roaring_descriptor {
+            std::uint16_t key;
+            std::uint8_t kind;
+            std::uint8_t reserved;
+            std::uint32_t cardinality;
+            std::uint32_t size;
+            std::uint32_t offset; // 相对 开头，8 字节 对齐
+        };
+
+        static_assert(sizeof(roaring_header) == 16 && sizeof(roaring_descriptor) == 16);
+
+        constexpr char roaring_magic[8] = {'E', 'R', 'O', 'A', 'R', 'N', 'G', '1'};
+
+        std::size_t payload_bytes(roaring_kind kind, std::uint32_t size) noexcept {
+            switch (kind) {
+                case roaring_kind::array: return std::size_t{size} * 2;
+                case roaring_kind::bitmap: return std::size_t{size} * 8;
+                default: return std::size_t{size} * 4;
+            }
+        }
+
+        constexpr std::size_t align8(std::size_t n) noexcept { return (n + 7) & ~std::size_t{7}; }
+
+        // 容器 内容 与 描述 一致：array 严格 递增；run 有序、不 重叠、不 越过 65535；cardinality 与 内容 相符
+        bool payload_valid(roaring_kind kind, const std::byte* p, std::uint32_t size, std::uint32_t cardinality) noexcept {
+            std::uint64_t count = 0;
+            if (kind == roaring_kind::bitmap) {
+                std::uint64_t w;
+                for (std::uint32_t i = 0; i < size; ++i) {
+                    std::memcpy(&w, p + i * sizeof(w), sizeof(w));
+                    count += static_cast<std::uint64_t>(std::popcount(w));
+                }
+                return count == cardinality;
+            }
+            std::uint16_t v[2];
+            if (kind == roaring_kind::array) {
+                for (std::uint32_t i = 0; i < size; ++i) {
+                    std::memcpy(v + 1, p + i * 2, 2);
+                    if (i > 0 && v[1] <= v[0]) return false;
+                    v[0] = v[1];
+                }
+                return size == cardinality;
+            }
+            std::uint32_t next = 0; // 下一段 最小 的 起点
+            for (std::uint32_t i = 0; i < size; ++i) {
+                std::memcpy(v, p + i * 4, 4);
+                const std::uint32_t last = std::uint32_t{v[0]} + v[1];
+                if (v[0] < next || last > 65535) return false;
+                next = last + 1;
+                count += std::uint64_t{v[1]} + 1;
+            }
+            return count == cardinality;
+        }
+
+        roaring_descriptor read_descriptor(const std::byte* base, std::size_t i) noexcept {
+            roaring_descriptor d;
+            std::memcpy(&d, base + sizeof(roaring_header) + i * sizeof(roaring_descriptor), sizeof(d));
+            return d;
+        }
+
+        // ---------------- 内核 ----------------
+
+        inline bool test_bit(const std::uint64_t* words, std::uint32_t v) noexcept {
+            return (words[v >> 6] >> (v & 63)) & 1;
+        }
+
+        // [lo, hi] 置 1
+        void set_range(std::uint64_t* words, std::uint32_t lo, std::uint32_t hi) noexcept {
+            const std::uint32_t first = lo >> 6, last = hi >> 6;
+            const std::uint64_t head = ~std::uint64_t{0} << (lo & 63);
+            const std::uint64_t tail = ~std::uint64_t{0} >> (63 - (hi & 63));
+            if (first == last) {
+                words[first] |= head & tail;
+                return;
+            }
+            words[first] |= head;
+            for (std::uint32_t i = first + 1; i < last; ++i) words[i] = ~std::uint64_t{0};
+            words[last] |= tail;
+        }
+
+        std::size_t intersect_scalar(const std::uint16_t* a, std::size_t na, const std::uint16_t* b, std::size_t nb,
+                                     std::uint16_t* out) noexcept {
+            std::size_t i = 0, j = 0, n = 0;
+            while (i < na && j < nb) {
+                const std::uint16_t x = a[i], y = b[j];
+                out[n] = x;
+                n += x == y;
+                i += x <= y;
+                j += y <= x;
+            }
+            return n;
+        }
+
+        struct op_and {
+            static std::uint64_t word(std::uint64_t a, std::uint64_t b) noexcept { return a & b; }
+        };
+
+        struct op_or {
+            static std::uint64_t word(std::uint64_t a, std::uint64_t b) noexcept { return a | b; }
+        };
+
+        struct op_andnot {
+            static std::uint64_t word(std::uint64_t a, std::uint64_t b) noexcept { return a & ~b; }
+        };
+
+        // out 为 nullptr 时 只 数
+        template <class Op>
+        inline std::uint32_t words_loop(const std::uint64_t* a, const std::uint64_t* b, std::uint64_t* out) noexcept {
+            std::uint32_t n = 0;
+            if (out != nullptr) {
+                for (std::uint32_t i = 0; i < bitmap_words; ++i) {
+                    out[i] = Op::word(a[i], b[i]);
+                    n += static_cast<std::uint32_t>(std::popcount(out[i]));
+                }
+            } else {
+                for (std::uint32_t i = 0; i < bitmap_words; ++i) n += static_cast<std::uint32_t>(std::popcount(Op::word(a[i], b[i])));
+            }
+            return n;
+        }
+
+        template <class Op>
+        std::uint32_t words_base(const std::uint64_t* a, const std::uint64_t* b, std::uint64_t* out) noexcept {
+            return words_loop<Op>(a, b, out);
+        }
+
+#if E_UTILS_X86
+        // SSE4.2：pcmpestrm 一次 比较 8 × 8 个 uint16，命中 的 用 pshufb 挤到 前面 写出
+        // 从 CRoaring 的 intersect_vector16 来；out 要 多留 8 个 位置
+        struct shuffle_table {
+            unsigned char mask[256][16];
+        };
+
+        constexpr shuffle_table make_shuffle_table() {
+            shuffle_table t{};
+            for (int m = 0; m < 256; ++m) {
+                int k = 0;
+                for (int lane = 0; lane < 8; ++lane) {
+                    if ((m >> lane) & 1) {
+                        t.mask[m][k++] = static_cast<unsigned char>(2 * lane);
+                        t.mask[m][k++] = static_cast<unsigned char>(2 * lane + 1);
+                    }
+                }
+                for (; k < 16; ++k) t.mask[m][k] = 0x80;
+            }
+            return t;
+        }
+
+        constexpr shuffle_table g_shuffle16 = make_shuffle_table();
+
+        E_UTILS_TARGET("sse4.2,popcnt")
+        std::size_t intersect_sse42(const std::uint16_t* a, std::size_t na, const std::uint16_t* b, std::size_t nb,
+                                    std::uint16_t* out) noexcept {
+            constexpr int lanes = 8;
+            constexpr int mode = _SIDD_UWORD_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_BIT_MASK;
+            const std::size_t end_a = na / lanes * lanes, end_b = nb / lanes * lanes;
+            std::size_t i = 0, j = 0, n = 0;
+            if (end_a > 0 && end_b > 0) {
+                __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+                __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+                while (true) {
+                    // 位 k：va 的 第 k 个 在 vb 里
+                    const int hit = _mm_cvtsi128_si32(_mm_cmpestrm(vb, lanes, va, lanes, mode));
+                    const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(g_shuffle16.mask[hit]));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + n), _mm_shuffle_epi8(va, shuffle));
+                    n += static_cast<std::size_t>(std::popcount(static_cast<unsigned>(hit)));
+                    const std::uint16_t max_a = a[i + lanes - 1], max_b = b[j + lanes - 1];
+                    if (max_a <= max_b) {
+                        i += lanes;
+                        if (i == end_a) break;
+                        va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+                    }
+                    if (max_b <= max_a) {
+                        j += lanes;
+                        if (j == end_b) break;
+                        vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+                    }
+                }
+            }
+            return n + intersect_scalar(a + i, na - i, b + j, nb - j, out + n);
+        }
+
+        template <class Op>
+        E_UTILS_TARGET("popcnt")
+        std::uint32_t words_popcnt(const std::uint64_t* a, const std::uint64_t* b, std::uint64_t* out) noexcept {
+            return words_loop<Op>(a, b, out);
+        }
+
+        // AVX2 没有 64 位 popcount：按 半字节 查表（pshufb），再 用 sad 横向 加
+        E_UTILS_TARGET_AVX2
+        inline __m256i popcount256(__m256i v) noexcept {
+            const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                   0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+            const __m256i low = _mm256_set1_epi8(0x0f);
+            const __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, low));
+            const __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+            return _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256());
+        }
+
+        template <class Op>
+        E_UTILS_TARGET_AVX2
+        inline __m256i apply256(__m256i a, __m256i b) noexcept {
+            if constexpr (std::is_same_v<Op, op_and>) {
+                return _mm256_and_si256(a, b);
+            } else if constexpr (std::is_same_v<Op, op_or>) {
+                return _mm256_or_si256(a, b);
+            } else {
+                return _mm256_andnot_si256(b, a);
+            }
+        }
+
+        template <class Op>
+        E_UTILS_TARGET_AVX2
+        std::uint32_t words_avx2(const std::uint64_t* a, const std::uint64_t* b, std::uint64_t* out) noexcept {
+            __m256i total = _mm256_setzero_si256();
+            for (std::uint32_t i = 0; i < bitmap_words; i += 4) {
+                const __m256i v = apply256<Op>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+                                               _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+                if (out != nullptr) _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), v);
+                total = _mm256_add_epi64(total, popcount256(v));
+            }
+            const __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(total), _mm256_extracti128_si256(total, 1));
+            return static_cast<std::uint32_t>(_mm_cvtsi128_si64(sum) + _mm_extract_epi64(sum, 1));
+        }
+#endif
+
+        using words_fn = std::uint32_t (*)(const std::uint64_t* a, const std::uint64_t* b, std::uint64_t* out) noexcept;
+
+        struct roaring_kernels {
+            std::size_t (*intersect)(const std::uint16_t* a, std::size_t na, const std::uint16_t* b, std::size_t nb,
+                                     std::uint16_t* out) noexcept;
+            words_fn words_and;
+            words_fn words_or;
+            words_fn words_andnot;
+        };
+
+        const roaring_kernels& select_roaring() {
+            static const roaring_kernels base = {intersect_scalar, words_base<op_and>, words_base<op_or>, words_base<op_andnot>};
+#if E_UTILS_X86
+            static const roaring_kernels sse42 = {intersect_sse42, words_popcnt<op_and>, words_popcnt<op_or>,
+                                                  words_popcnt<op_andnot>};
+            static const roaring_kernels avx2 = {intersect_sse42, words_avx2<op_and>, words_avx2<op_or>,
+                                                 words_avx2<op_andnot>};
+            if (detail::cpu_has_avx2() && detail::cpu_has_sse42()) {
+                return avx2;
+            }
+            if (detail::cpu_has_sse42()) {
+                return sse42;
+            }
+#endif
+            return base;
+        }
+
+        const roaring_kernels& g_roaring = select_roaring();
+
+        std::uint32_t count_words(const std::uint64_t* w) noexcept {
+            return g_roaring.words_or(w, w, nullptr);
+        }
+
+        // 长度 悬殊 时 对 长的 做 指数 + 二分 查找，否则 走 内核；out 至少 min(na, nb) + 8
+        std::size_t intersect_arrays(const std::uint16_t* a, std::size_t na, const std::uint16_t* b, std::size_t nb,
+                                     std::uint16_t* out) noexcept {
+            if (na > nb) {
+                std::swap(a, b);
+                std::swap(na, nb);
+            }
+            if (na * 64 >= nb) {
+                return g_roaring.intersect(a, na, b, nb, out);
+            }
+            std::size_t n = 0;
+            const std::uint16_t* lo = b;
+            const std::uint16_t* const end = b + nb;
+            for (std::size_t i = 0; i < na && lo != end; ++i) {
+                const std::uint16_t x = a[i];
+                std::size_t step = 1;
+                const std::uint16_t* hi = lo;
+                while (hi < end && *hi < x) {
+                    lo = hi;
+                    hi = end - hi > static_cast<std::ptrdiff_t>(step) ? hi + step : end;
+                    step *= 2;
+                }
+                lo = std::lower_bound(lo, hi, x);
+                if (lo != end && *lo == x) out[n++] = x;
+            }
+            return n;
+        }
+
+        // 无 分支 归并，out 至少 na + nb
+        std::size_t union_arrays(const std::uint16_t* a, std::size_t na, const std::uint16_t* b, std::size_t nb,
+                                 std::uint16_t* out) noexcept {
+            std::size_t i = 0, j = 0, n = 0;
+            while (i < na && j < nb) {
+                const std::uint16_t x = a[i], y = b[j];
+                out[n++] = std::min(x, y);
+                i += x <= y;
+                j += y <= x;
+            }
+            std::copy(a + i, a + na, out + n);
+            n += na - i;
+            std::copy(b + j, b + nb, out + n);
+            return n + (nb - j);
+        }
+
+        // ---------------- 容器 ----------------
+
+        // run 展开：元素 少 就 成 array，多 就 成 bitmap
+        roaring_ref plain(const roaring_ref& r, std::vector<std::uint16_t>& values, std::vector<std::uint64_t>& words) {
+            if (r.kind != roaring_kind::run) {
+                return r;
+            }
+            const std::uint16_t* v = r.values();
+            if (r.cardinality <= array_max) {
+                values.clear();
+                for (std::uint32_t i = 0; i < r.size; ++i) {
+                    for (std::uint32_t x = v[2 * i], last = x + v[2 * i + 1]; x <= last; ++x) {
+                        values.push_back(static_cast<std::uint16_t>(x));
+                    }
+                }
+                return {r.key, roaring_kind::array, r.cardinality, static_cast<std::uint32_t>(values.size()), values.data()};
+            }
+            words.assign(bitmap_words, 0);
+            for (std::uint32_t i = 0; i < r.size; ++i) set_range(words.data(), v[2 * i], v[2 * i] + v[2 * i + 1]);
+            return {r.key, roaring_kind::bitmap, r.cardinality, bitmap_words, words.data()};
+        }
+
+        roaring_container copy_of(const roaring_ref& r) {
+            roaring_container c;
+            c.key = r.key;
+            c.kind = r.kind;
+            c.cardinality = r.cardinality;
+            if (r.kind == roaring_kind::bitmap) {
+                c.words.assign(r.words(), r.words() + r.size);
+            } else {
+                c.values.assign(r.values(), r.values() + payload_bytes(r.kind, r.size) / 2);
+            }
+            return c;
+        }
+
+        void to_bitmap(roaring_container& c) {
+            std::vector<std::uint64_t> words(bitmap_words, 0);
+            if (c.kind == roaring_kind::array) {
+                for (std::uint16_t v : c.values) words[v >> 6] |= std::uint64_t{1} << (v & 63);
+            } else if (c.kind == roaring_kind::run) {
+                for (std::size_t i = 0; i < c.values.size(); i += 2) set_range(words.data(), c.values[i], c.values[i] + c.values[i + 1]);
+            } else {
+                return;
+            }
+            c.kind = roaring_kind::bitmap;
+            c.words = std::move(words);
+            c.values = {};
+        }
+
+        void to_array(roaring_container& c) {
+            std::vector<std::uint16_t> values;
+            values.reserve(c.cardinality);
+            if (c.kind == roaring_kind::bitmap) {
+                for (std::uint32_t i = 0; i < bitmap_words; ++i) {
+                    for (std::uint64_t w = c.words[i]; w != 0; w &= w - 1) {
+                        values.push_back(static_cast<std::uint16_t>(i * 64 + static_cast<std::uint32_t>(std::countr_zero(w))));
+                    }
+                }
+            } else if (c.kind == roaring_kind::run) {
+                for (std::size_t i = 0; i < c.values.size(); i += 2) {
+                    for (std::uint32_t x = c.values[i], last = x + c.values[i + 1]; x <= last; ++x) {
+                        values.push_back(static_cast<std::uint16_t>(x));
+                    }
+                }
+            } else {
+                return;
+            }
+            c.kind = roaring_kind::array;
+            c.values = std::move(values);
+            c.words = {};
+        }
+
+        // array / bitmap 按 元素 个数 选 形式；run 展开
+        void normalize(roaring_container& c) {
+            if (c.kind == roaring_kind::run) {
+                if (c.cardinality <= array_max) {
+                    to_array(c);
+                } else {
+                    to_bitmap(c);
+                }
+            } else if (c.kind == roaring_kind::array && c.cardinality > array_max) {
+                to_bitmap(c);
+            } else if (c.kind == roaring_kind::bitmap && c.cardinality <= array_max) {
+                to_array(c);
+            }
+        }
+
+        roaring_container bitmap_result(std::uint16_t key) {
+            roaring_container c;
+            c.key = key;
+            c.kind = roaring_kind::bitmap;
+            c.words.resize(bitmap_words);
+            return c;
+        }
+
+        roaring_container array_result(std::uint16_t key, std::size_t reserve) {
+            roaring_container c;
+            c.key = key;
+            c.kind = roaring_kind::array;
+            c.values.resize(reserve);
+            return c;
+        }
+
+        // 以下 a、b 都 不是 run
+        roaring_container container_and(const roaring_ref& a, const roaring_ref& b) {
+            if (a.kind == roaring_kind::bitmap && b.kind == roaring_kind::bitmap) {
+                roaring_container c = bitmap_result(a.key);
+                c.cardinality = g_roaring.words_and(a.words(), b.words(), c.words.data());
+                normalize(c);
+                return c;
+            }
+            if (a.kind == roaring_kind::array && b.kind == roaring_kind::array) {
+                roaring_container c = array_result(a.key, std::min(a.size, b.size) + 8);
+                c.cardinality = static_cast<std::uint32_t>(intersect_arrays(a.values(), a.size, b.values(), b.size, c.values.data()));
+                c.values.resize(c.cardinality);
+                return c;
+            }
+            const roaring_ref& arr = a.kind == roaring_kind::array ? a : b;
+            const roaring_ref& bits = a.kind == roaring_kind::array ? b : a;
+            roaring_container c = array_result(a.key, arr.size);
+            std::uint32_t n = 0;
+            for (std::uint32_t i = 0; i < arr.size; ++i) {
+                const std::uint16_t v = arr.values()[i];
+                c.values[n] = v;
+                n += test_bit(bits.words(), v);
+            }
+            c.values.resize(n);
+            c.cardinality = n;
+            return c;
+        }
+
+        roaring_container container_or(const roaring_ref& a, const roaring_ref& b) {
+            if (a.kind == roaring_kind::bitmap && b.kind == roaring_kind::bitmap) {
+                roaring_container c = bitmap_result(a.key);
+                c.cardinality = g_roaring.words_or(a.words(), b.words(), c.words.data());
+                return c;
+            }
+            if (a.kind == roaring_kind::array && b.kind == roaring_kind::array) {
+                roaring_container c = array_result(a.key, std::size_t{a.size} + b.size);
+                c.cardinality = static_cast<std::uint32_t>(union_arrays(a.values(), a.size, b.values(), b.size, c.values.data()));
+                c.values.resize(c.cardinality);
+                normalize(c);
+                return c;
+            }
+            const roaring_ref& arr = a.kind == roaring_kind::array ? a : b;
+            const roaring_ref& bits = a.kind == roaring_kind::array ? b : a;
+            roaring_container c = copy_of(bits);
+            c.key = a.key;
+            for (std::uint32_t i = 0; i < arr.size; ++i) {
+                const std::uint16_t v = arr.values()[i];
+                std::uint64_t& w = c.words[v >> 6];
+                const std::uint64_t bit = std::uint64_t{1} << (v & 63);
+                c.cardinality += (w & bit) == 0;
+                w |= bit;
+            }
+            return c;
+        }
+
+        roaring_container container_andnot(const roaring_ref& a, const roaring_ref& b) {
+            if (a.kind == roaring_kind::bitmap && b.kind == roaring_kind::bitmap) {
+                roaring_container c = bitmap_result(a.key);
+                c.cardinality = g_roaring.words_andnot(a.words(), b.words(), c.words.data());
+                normalize(c);
+                return c;
+            }
+            if (a.kind == roaring_kind::array) {
+                roaring_container c = array_result(a.key, a.size);
+                std::uint32_t n = 0;
+                if (b.kind == roaring_kind::array) {
+                    n = static_cast<std::uint32_t>(
+                        std::set_difference(a.values(), a.values() + a.size, b.values(), b.values() + b.size, c.values.begin())
+                        - c.values.begin());
+                } else {
+                    for (std::uint32_t i = 0; i < a.size; ++i) {
+                        const std::uint16_t v = a.values()[i];
+                        c.values[n] = v;
+                        n += !test_bit(b.words(), v);
+                    }
+                }
+                c.values.resize(n);
+                c.cardinality = n;
+                return c;
+            }
+            roaring_container c = copy_of(a);
+            for (std::uint32_t i = 0; i < b.size; ++i) {
+                const std::uint16_t v = b.values()[i];
+                std::uint64_t& w = c.words[v >> 6];
+                const std::uint64_t bit = std::uint64_t{1} << (v & 63);
+                c.cardinality -= (w & bit) != 0;
+                w &= ~bit;
+            }
+            normalize(c);
+            return c;
+        }
+
+        std::uint32_t container_and_count(const roaring_ref& a, const roaring_ref& b, std::vector<std::uint16_t>& scratch) {
+            if (a.kind == roaring_kind::bitmap && b.kind == roaring_kind::bitmap) {
+                return g_roaring.words_and(a.words(), b.words(), nullptr);
+            }
+            if (a.kind == roaring_kind::array && b.kind == roaring_kind::array) {
+                scratch.resize(std::min(a.size, b.size) + 8);
+                return static_cast<std::uint32_t>(intersect_arrays(a.values(), a.size, b.values(), b.size, scratch.data()));
+            }
+            const roaring_ref& arr = a.kind == roaring_kind::array ? a : b;
+            const roaring_ref& bits = a.kind == roaring_kind::array ? b : a;
+            std::uint32_t n = 0;
+            for (std::uint32_t i = 0; i < arr.size; ++i) n += test_bit(bits.words(), arr.values()[i]);
+            return n;
+        }
+
+        bool container_contains(const roaring_ref& r, std::uint16_t low) noexcept {
+            switch (r.kind) {
+                case roaring_kind::array:
+                    return std::binary_search(r.values(), r.values() + r.size, low);
+                case roaring_kind::bitmap:
+                    return test_bit(r.words(), low);
+                default: {
+                    // 最后 一个 起点 <= low 的 段
+                    const std::uint16_t* v = r.values();
+                    std::uint32_t lo = 0, hi = r.size;
+                    while (lo < hi) {
+                        const std::uint32_t mid = (lo + hi) / 2;
+                        if (v[2 * mid] <= low) {
+                            lo = mid + 1;
+                        } else {
+                            hi = mid;
+                        }
+                    }
+                    return lo > 0 && low - v[2 * (lo - 1)] <= v[2 * (lo - 1) + 1];
+                }
+            }
+        }
+
+        // 段数：run 起点 的 个数
+        std::uint32_t count_runs(const roaring_container& c) noexcept {
+            if (c.kind == roaring_kind::run) {
+                return static_cast<std::uint32_t>(c.values.size() / 2);
+            }
+            std::uint32_t runs = 0;
+            if (c.kind == roaring_kind::array) {
+                for (std::size_t i = 0; i < c.values.size(); ++i) runs += i == 0 || c.values[i] != c.values[i - 1] + 1;
+                return runs;
+            }
+            std::uint64_t carry = 0;
+            for (std::uint64_t w : c.words) {
+                runs += static_cast<std::uint32_t>(std::popcount(w & ~((w << 1) | carry)));
+                carry = w >> 63;
+            }
+            return runs;
+        }
+
+        void to_run(roaring_container& c, std::uint32_t runs) {
+            std::vector<std::uint16_t> pairs;
+            pairs.reserve(2 * std::size_t{runs});
+            std::int32_t start = -1, prev = -2;
+            const auto push = [&](std::int32_t v) {
+                if (v != prev + 1) {
+                    if (start >= 0) {
+                        pairs.push_back(static_cast<std::uint16_t>(start));
+                        pairs.push_back(static_cast<std::uint16_t>(prev - start));
+                    }
+                    start = v;
+                }
+                prev = v;
+            };
+            if (c.kind == roaring_kind::array) {
+                for (std::uint16_t v : c.values) push(v);
+            } else {
+                for (std::uint32_t i = 0; i < bitmap_words; ++i) {
+                    for (std::uint64_t w = c.words[i]; w != 0; w &= w - 1) push(static_cast<std::int32_t>(i * 64 + std::countr_zero(w)));
+                }
+            }
+            pairs.push_back(static_cast<std::uint16_t>(start));
+            pairs.push_back(static_cast<std::uint16_t>(prev - start));
+            c.kind = roaring_kind::run;
+            c.values = std::move(pairs);
+            c.words = {};
+        }
+
+        enum class set_op {
+            intersect,
+            unite,
+            subtract,
+        };
+
+        roaring_container combine_pair(const roaring_ref& a, const roaring_ref& b, set_op op, std::vector<std::uint16_t> (&values)[2],
+                                       std::vector<std::uint64_t> (&words)[2]) {
+            const roaring_ref pa = plain(a, values[0], words[0]);
+            const roaring_ref pb = plain(b, values[1], words[1]);
+            switch (op) {
+                case set_op::intersect: return container_and(pa, pb);
+                case set_op::unite: return container_or(pa, pb);
+                default: return container_andnot(pa, pb);
+            }
+        }
+    }
+
+    // ---------------- roaring_view ----------------
+
+    roaring_view::roaring_view(const roaring_bitmap& bitmap) noexcept
+        : owned_(bitmap.containers_.data()), containers_(bitmap.containers_.size()) {}
+
+    roaring_view::roaring_view(std::span<const std::byte> bytes) {
+        const auto fail = [](const char* what) {
+            throw std::invalid_argument(std::string("e_utils::roaring_view: ") + what);
+        };
+        if (reinterpret_cast<std::uintptr_t>(bytes.data()) % 8 != 0) fail("data must be 8-byte aligned");
+        if (bytes.size() < sizeof(roaring_header)) fail("truncated header");
+        roaring_header h;
+        std::memcpy(&h, bytes.data(), sizeof(h));
+        if (std::memcmp(h.magic, roaring_magic, sizeof(roaring_magic)) != 0) fail("bad magic");
+        const std::size_t table_end = sizeof(roaring_header) + std::size_t{h.containers} * sizeof(roaring_descriptor);
+        if (h.containers > 65536 || table_end > bytes.size()) fail("truncated container table");
+        for (std::size_t i = 0; i < h.containers; ++i) {
+            const roaring_descriptor d = read_descriptor(bytes.data(), i);
+            if (i > 0 && d.key <= read_descriptor(bytes.data(), i - 1).key) fail("keys not increasing");
+            if (d.kind > static_cast<std::uint8_t>(roaring_kind::run) || d.cardinality == 0 || d.cardinality > 65536) {
+                fail("bad container");
+            }
+            const auto kind = static_cast<roaring_kind>(d.kind);
+            const bool size_ok = kind == roaring_kind::array    ? d.size == d.cardinality && d.size <= array_max
+                                 : kind == roaring_kind::bitmap ? d.size == bitmap_words
+                                                                : d.size > 0 && d.size <= 32768;
+            if (!size_ok) fail("bad container");
+            if (d.offset % 8 != 0 || d.offset < table_end || d.offset > bytes.size()
+                || payload_bytes(kind, d.size) > bytes.size() - d.offset) {
+                fail("container out of bounds");
+            }
+            if (!payload_valid(kind, bytes.data() + d.offset, d.size, d.cardinality)) fail("bad container payload");
+        }
+        serialized_ = bytes.data();
+        containers_ = h.containers;
+    }
+
+    detail::roaring_ref roaring_view::container(std::size_t i) const noexcept {
+        if (owned_ != nullptr) {
+            return owned_[i].ref();
+        }
+        const roaring_descriptor d = read_descriptor(serialized_, i);
+        return {d.key, static_cast<roaring_kind>(d.kind), d.cardinality, d.size, serialized_ + d.offset};
+    }
+
+    bool roaring_view::contains(std::uint32_t value) const noexcept {
+        const auto key = static_cast<std::uint16_t>(value >> 16);
+        std::size_t lo = 0, hi = containers_;
+        while (lo < hi) {
+            const std::size_t mid = (lo + hi) / 2;
+            const std::uint16_t k = owned_ != nullptr ? owned_[mid].key : read_descriptor(serialized_, mid).key;
+            if (k < key) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if (lo == containers_) {
+            return false;
+        }
+        const roaring_ref r = container(lo);
+        return r.key == key && container_contains(r, static_cast<std::uint16_t>(value));
+    }
+
+    std::uint64_t roaring_view::cardinality() const noexcept {
+        std::uint64_t n = 0;
+        for (std::size_t i = 0; i < containers_; ++i) n += container(i).cardinality;
+        return n;
+    }
+
+    std::vector<std::uint32_t> roaring_view::to_vector() const {
+        std::vector<std::uint32_t> out;
+        out.reserve(cardinality());
+        for_each([&](std::uint32_t v) { out.push_back(v); });
+        return out;
+    }
+
+    // ---------------- 集合 运算 ----------------
+
+    namespace {
+        void combine_into(std::vector<roaring_container>& out, const roaring_view& a, const roaring_view& b, set_op op) {
+            std::vector<std::uint16_t> values[2];
+            std::vector<std::uint64_t> words[2];
+            std::size_t i = 0, j = 0;
+            const std::size_t na = a.containers(), nb = b.containers();
+            while (i < na || j < nb) {
+                const roaring_ref ra = i < na ? a.container(i) : roaring_ref{};
+                const roaring_ref rb = j < nb ? b.container(j) : roaring_ref{};
+                if (j == nb || (i < na && ra.key < rb.key)) {
+                    if (op != set_op::intersect) out.push_back(copy_of(ra));
+                    ++i;
+                } else if (i == na || rb.key < ra.key) {
+                    if (op == set_op::unite) out.push_back(copy_of(rb));
+                    ++j;
+                } else {
+                    roaring_container c = combine_pair(ra, rb, op, values, words);
+                    if (c.cardinality > 0) out.push_back(std::move(c));
+                    ++i;
+                    ++j;
+                }
+            }
+        }
+    }
+
+    roaring_bitmap operator&(const roaring_view& a, const roaring_view& b) {
+        roaring_bitmap r;
+        combine_into(r.containers_, a, b, set_op::intersect);
+        return r;
+    }
+
+    roaring_bitmap operator|(const roaring_view& a, const roaring_view& b) {
+        roaring_bitmap r;
+        combine_into(r.containers_, a, b, set_op::unite);
+        return r;
+    }
+
+    roaring_bitmap operator-(const roaring_view& a, const roaring_view& b) {
+        roaring_bitmap r;
+        combine_into(r.containers_, a, b, set_op::subtract);
+        return r;
+    }
+
+    std::uint64_t and_cardinality(const roaring_view& a, const roaring_view& b) {
+        std::vector<std::uint16_t> values[2];
+        std::vector<std::uint64_t> words[2];
+        std::vector<std::uint16_t> scratch;
+        std::uint64_t n = 0;
+        std::size_t i = 0, j = 0;
+        const std::size_t na = a.containers(), nb = b.containers();
+        while (i < na && j < nb) {
+            const roaring_ref ra = a.container(i);
+            const roaring_ref rb = b.container(j);
+            if (ra.key < rb.key) {
+                ++i;
+            } else if (rb.key < ra.key) {
+                ++j;
+            } else {
+                n += container_and_count(plain(ra, values[0], words[0]), plain(rb, values[1], words[1]), scratch);
+                ++i;
+                ++j;
+            }
+        }
+        return n;
+    }
+
+    // ---------------- roaring_bitmap ----------------
+
+    roaring_bitmap::roaring_bitmap(std::initializer_list<std::uint32_t> values)
+        : roaring_bitmap(from_values(std::span<const std::uint32_t>(values.begin(), values.size()))) {}
+
+    roaring_bitmap::roaring_bitmap(const roaring_view& view) {
+        containers_.reserve(view.containers());
+        for (std::size_t i = 0; i < view.containers(); ++i) containers_.push_back(copy_of(view.container(i)));
+    }
+
+    roaring_bitmap roaring_bitmap::from_values(std::span<const std::uint32_t> values) {
+        std::vector<std::uint32_t> sorted;
+        if (!std::is_sorted(values.begin(), values.end())) {
+            sorted.assign(values.begin(), values.end());
+            std::sort(sorted.begin(), sorted.end());
+            values = sorted;
+        }
+        roaring_bitmap r;
+        std::size_t i = 0;
+        while (i < values.size()) {
+            roaring_container c;
+            c.key = static_cast<std::uint16_t>(values[i] >> 16);
+            std::size_t j = i;
+            for (; j < values.size() && values[j] >> 16 == c.key; ++j) {
+                const auto low = static_cast<std::uint16_t>(values[j]);
+                if (c.values.empty() || c.values.back() != low) c.values.push_back(low);
+            }
+            c.cardinality = static_cast<std::uint32_t>(c.values.size());
+            normalize(c);
+            r.containers_.push_back(std::move(c));
+            i = j;
+        }
+        return r;
+    }
+
+    detail::roaring_container& roaring_bitmap::container_for(std::uint16_t key) {
+        const auto it = std::lower_bound(containers_.begin(), containers_.end(), key,
+                                         [](const roaring_container& c, std::uint16_t k) { return c.key < k; });
+        if (it != containers_.end() && it->key == key) {
+            return *it;
+        }
+        roaring_container c;
+        c.key = key;
+        return *containers_.insert(it, std::move(c));
+    }
+
+    void roaring_bitmap::add(std::uint32_t value) {
+        roaring_container& c = container_for(static_cast<std::uint16_t>(value >> 16));
+        const auto low = static_cast<std::uint16_t>(value);
+        if (c.kind == roaring_kind::run) {
+            if (container_contains(c.ref(), low)) return;
+            normalize(c);
+        }
+        if (c.kind == roaring_kind::array) {
+            const auto it = std::lower_bound(c.values.begin(), c.values.end(), low);
+            if (it != c.values.end() && *it == low) return;
+            c.values.insert(it, low);
+            ++c.cardinality;
+            normalize(c);
+        } else {
+            std::uint64_t& w = c.words[low >> 6];
+            const std::uint64_t bit = std::uint64_t{1} << (low & 63);
+            c.cardinality += (w & bit) == 0;
+            w |= bit;
+        }
+    }
+
+    bool roaring_bitmap::remove(std::uint32_t value) {
+        const auto key = static_cast<std::uint16_t>(value >> 16);
+        const auto it = std::lower_bound(containers_.begin(), containers_.end(), key,
+                                         [](const roaring_container& c, std::uint16_t k) { return c.key < k; });
+        const auto low = static_cast<std::uint16_t>(value);
+        if (it == containers_.end() || it->key != key || !container_contains(it->ref(), low)) {
+            return false;
+        }
+        roaring_container& c = *it;
+        normalize(c);
+        if (c.kind == roaring_kind::array) {
+            c.values.erase(std::lower_bound(c.values.begin(), c.values.end(), low));
+        } else {
+            c.words[low >> 6] &= ~(std::uint64_t{1} << (low & 63));
+        }
+        --c.cardinality;
+        if (c.cardinality == 0) {
+            containers_.erase(it);
+        } else {
+            normalize(c);
+        }
+        return true;
+    }
+
+    void roaring_bitmap::add_range(std::uint64_t begin, std::uint64_t end) {
+        if (end > (std::uint64_t{1} << 32)) {
+            throw std::invalid_argument("e_utils::roaring_bitmap::add_range: end past 2^32");
+        }
+        if (begin >= end) {
+            return;
+        }
+        const std::uint64_t last = end - 1;
+        for (std::uint64_t key = begin >> 16; key <= last >> 16; ++key) {
+            const auto lo = static_cast<std::uint32_t>(key == begin >> 16 ? begin & 0xffff : 0);
+            const auto hi = static_cast<std::uint32_t>(key == last >> 16 ? last & 0xffff : 0xffff);
+            roaring_container& c = container_for(static_cast<std::uint16_t>(key));
+            if (c.cardinality == 0 || hi - lo + 1 == 65536) {
+                // 新 容器 或 整个 填满：一段 run
+                c.kind = roaring_kind::run;
+                c.values = {static_cast<std::uint16_t>(lo), static_cast<std::uint16_t>(hi - lo)};
+                c.words = {};
+                c.cardinality = hi - lo + 1;
+                continue;
+            }
+            to_bitmap(c);
+            set_range(c.words.data(), lo, hi);
+            c.cardinality = count_words(c.words.data());
+            normalize(c);
+        }
+    }
+
+    bool roaring_bitmap::run_optimize() {
+        bool changed = false;
+        for (roaring_container& c : containers_) {
+            const std::uint32_t runs = count_runs(c);
+            const std::size_t as_run = 4 * std::size_t{runs};
+            const std::size_t as_plain = c.cardinality <= array_max ? 2 * std::size_t{c.cardinality} : 8 * std::size_t{bitmap_words};
+            if (as_run < as_plain) {
+                if (c.kind != roaring_kind::run) {
+                    to_run(c, runs);
+                    changed = true;
+                }
+            } else {
+                const roaring_kind before = c.kind;
+                normalize(c);
+                changed |= c.kind != before;
+            }
+            c.values.shrink_to_fit();
+        }
+        return changed;
+    }
+
+    roaring_bitmap& roaring_bitmap::operator&=(const roaring_view& other) {
+        return *this = *this & other;
+    }
+
+    roaring_bitmap& roaring_bitmap::operator|=(const roaring_view& other) {
+        return *this = *this | other;
+    }
+
+    roaring_bitmap& roaring_bitmap::operator-=(const roaring_view& other) {
+        return *this = *this - other;
+    }
+
+    std::size_t roaring_bitmap::serialized_size() const noexcept {
+        std::size_t n = sizeof(roaring_header) + containers_.size() * sizeof(roaring_descriptor);
+        for (const roaring_container& c : containers_) {
+            const roaring_ref r = c.ref();
+            n += align8(payload_bytes(r.kind, r.size));
+        }
+        return n;
+    }
+
+    std::size_t roaring_bitmap::serialize(std::span<std::byte> out) const {
+        const std::size_t total = serialized_size();
+        if (out.size() < total) {
+            throw std::invalid_argument("e_utils::roaring_bitmap::serialize: output too small");
+        }
+        std::memset(out.data(), 0, total);
+        roaring_header h{};
+        std::memcpy(h.magic, roaring_magic, sizeof(roaring_magic));
+        h.containers = static_cast<std::uint32_t>(containers_.size());
+        std::memcpy(out.data(), &h, sizeof(h));
+
+        std::size_t offset = sizeof(roaring_header) + containers_.size() * sizeof(roaring_descriptor);
+        for (std::size_t i = 0; i < containers_.size(); ++i) {
+            const roaring_ref r = containers_[i].ref();
+            roaring_descriptor d{};
+            d.key = r.key;
+            d.kind = static_cast<std::uint8_t>(r.kind);
+            d.cardinality = r.cardinality;
+            d.size = r.size;
+            d.offset = static_cast<std::uint32_t>(offset);
+            std::memcpy(out.data() + sizeof(roaring_header) + i * sizeof(roaring_descriptor), &d, sizeof(d));
+            const std::size_t bytes = payload_bytes(r.kind, r.size);
+            std::memcpy(out.data() + offset, r.data, bytes);
+            offset += align8(bytes);
+        }
+        return total;
+    }
+
+    std::vector<std::byte> roaring_bitmap::serialize() const {
+        std::vector<std::byte> out(serialized_size());
+        serialize(out);
+        return out;
+    }
+}
@@ -0,0 +1,65 @@
+#include "e_simd.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+#if E_UTILS_X86 && defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+#endif
+
+namespace e_utils::detail {
+    namespace {
+        struct cpu_features {
+            bool sse42 = false;
+            bool avx2 = false;
+        };
+
+#if E_UTILS_X86 && defined(_MSC_VER) && !defined(__clang__)
+        cpu_features detect() {
+            cpu_features f;
+            int r[4];
+            __cpuid(r, 0);
+            const int max_leaf = r[0];
+            __cpuid(r, 1);
+            f.sse42 = (r[2] >> 20) & 1;
+            const bool osxsave = (r[2] >> 27) & 1;
+            const bool avx = (r[2] >> 28) & 1;
+            if (osxsave && avx && max_leaf >= 7 && (_xgetbv(0) & 0x6) == 0x6) {
+                __cpuidex(r, 7, 0);
+                f.avx2 = (r[1] >> 5) & 1;
+            }
+            return f;
+        }
+#elif E_UTILS_X86
+        cpu_features detect() {
+            __builtin_cpu_init();
+            return {__builtin_cpu_supports("sse4.2") != 0, __builtin_cpu_supports("avx2") != 0};
+        }
+#else
+        cpu_features detect() {
+            return {};
+        }
+#endif
+
+        cpu_features features() {
+            const char* env = std::getenv("E_UTILS_SIMD");
+            if (env != nullptr && std::strcmp(env, "scalar") == 0) {
+                return {};
+            }
+            return detect();
+        }
+
+        const cpu_features& cached() {
+            static const cpu_features f = features();
+            return f;
+        }
+    }
+
+    bool cpu_has_sse42() {
+        return cached().sse42;
+    }
+
+    bool cpu_has_avx2() {
+        return cached().avx2;
+    }
+}
@@ -0,0 +1,30 @@
+#ifndef E_UTILS_SIMD_H
+#define E_UTILS_SIMD_H
+
+// 模块内部头文件：CPU 特性 探测 与 按函数开启指令集（同 math 模块 的 e_simd.hpp）
+// 库 不加 -msse4.2 / -mavx2 之类 的 全局 选项，内核 用 E_UTILS_TARGET_xxx 单独 开启，运行时 按 CPU 选择
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define E_UTILS_X86 1
+    #include <immintrin.h>
+#else
+    #define E_UTILS_X86 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define E_UTILS_TARGET(isa) __attribute__((target(isa)))
+#else
+    #define E_UTILS_TARGET(isa)
+#endif
+
+#define E_UTILS_TARGET_SSE42 E_UTILS_TARGET("sse4.2")
+#define E_UTILS_TARGET_AVX2 E_UTILS_TARGET("avx2")
+
+namespace e_utils::detail {
+    // 首次 调用 时 探测，之后 返回 缓存
+    // 环境变量 E_UTILS_SIMD=scalar 让 两者 都 返回 false，用于 排查 问题 与 测试 通用 实现
+    bool cpu_has_sse42();
+    bool cpu_has_avx2();
+}
+
+#endif // E_UTILS_SIMD_H
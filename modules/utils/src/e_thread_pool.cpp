@@ -0,0 +1,446 @@
+#include "e_thread_pool.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+#elif defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#endif
+
+namespace e_utils {
+    namespace {
+        using detail::pool_task;
+
+        // 空闲 线程 睡 之前 先 转 几圈，刚 提交 的 任务 不用 等 唤醒
+        constexpr unsigned spin_rounds = 64;
+
+        // Chase-Lev 双端 队列（按 Lê 等 "Correct and Efficient Work-Stealing for Weak Memory Models" 的 内存 序）
+        // 所属 线程 在 底部 push / pop，其他 线程 在 顶部 steal；满 了 换 两倍 大 的 环，旧 环 留到 析构（小偷 可能 还在 读）
+        class ws_deque {
+        public:
+            ws_deque() {
+                rings_.push_back(std::make_unique<ring>(256));
+                ring_.store(rings_.back().get(), std::memory_order_relaxed);
+            }
+
+            void push(pool_task* task) {
+                const std::int64_t b = bottom_.load(std::memory_order_relaxed);
+                const std::int64_t t = top_.load(std::memory_order_acquire);
+                ring* r = ring_.load(std::memory_order_relaxed);
+                if (b - t > r->mask) {
+                    r = grow(r, t, b);
+                }
+                r->put(b, task);
+                bottom_.store(b + 1, std::memory_order_release);
+            }
+
+            pool_task* pop() {
+                const std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+                ring* r = ring_.load(std::memory_order_relaxed);
+                bottom_.store(b, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                std::int64_t t = top_.load(std::memory_order_relaxed);
+                if (t > b) {
+                    bottom_.store(b + 1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+                pool_task* task = r->get(b);
+                if (t == b) {
+                    // 只剩 一个，和 小偷 抢
+                    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                        task = nullptr;
+                    }
+                    bottom_.store(b + 1, std::memory_order_relaxed);
+                }
+                return task;
+            }
+
+            // 空 或者 抢 输了 返回 nullptr
+            pool_task* steal() {
+                std::int64_t t = top_.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                const std::int64_t b = bottom_.load(std::memory_order_acquire);
+                if (t >= b) {
+                    return nullptr;
+                }
+                pool_task* task = ring_.load(std::memory_order_acquire)->get(t);
+                if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                    return nullptr;
+                }
+                return task;
+            }
+
+            bool maybe_nonempty() const noexcept {
+                return top_.load(std::memory_order_relaxed) < bottom_.load(std::memory_order_relaxed);
+            }
+
+        private:
+            struct ring {
+                explicit ring(std::int64_t capacity) : mask(capacity - 1), slots(new std::atomic<pool_task*>[static_cast<std::size_t>(capacity)]) {}
+
+                pool_task* get(std::int64_t i) const noexcept { return slots[static_cast<std::size_t>(i & mask)].load(std::memory_order_relaxed); }
+                void put(std::int64_t i, pool_task* task) noexcept { slots[static_cast<std::size_t>(i & mask)].store(task, std::memory_order_relaxed); }
+
+                const std::int64_t mask;
+                std::unique_ptr<std::atomic<pool_task*>[]> slots;
+            };
+
+            ring* grow(ring* old, std::int64_t t, std::int64_t b) {
+                rings_.push_back(std::make_unique<ring>(2 * (old->mask + 1)));
+                ring* r = rings_.back().get();
+                for (std::int64_t i = t; i < b; ++i) r->put(i, old->get(i));
+                ring_.store(r, std::memory_order_release);
+                return r;
+            }
+
+            alignas(64) std::atomic<std::int64_t> top_{0};
+            alignas(64) std::atomic<std::int64_t> bottom_{0};
+            std::atomic<ring*> ring_{nullptr};
+            std::vector<std::unique_ptr<ring>> rings_; // 只有 所属 线程 改
+        };
+
+        struct alignas(64) worker {
+            ws_deque deque;
+            std::thread thread;
+        };
+
+        struct worker_id {
+            const void* pool = nullptr;
+            unsigned index = 0;
+            std::uint32_t rng = 0; // 选 偷 谁
+        };
+
+        thread_local worker_id t_worker;
+
+        // 绑定 到 进程 允许 的 CPU 里 的 第 n 个（容器 里 可能 只 给 一部分 CPU）
+        void pin_current_thread(unsigned n) {
+#if defined(__linux__)
+            cpu_set_t allowed;
+            CPU_ZERO(&allowed);
+            if (::sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+                return;
+            }
+            const int count = CPU_COUNT(&allowed);
+            if (count == 0) {
+                return;
+            }
+            int want = static_cast<int>(n % static_cast<unsigned>(count));
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &allowed) && want-- == 0) {
+                    cpu_set_t one;
+                    CPU_ZERO(&one);
+                    CPU_SET(cpu, &one);
+                    ::pthread_setaffinity_np(::pthread_self(), sizeof(one), &one);
+                    return;
+                }
+            }
+#elif defined(_WIN32)
+            DWORD_PTR process_mask = 0, system_mask = 0;
+            if (!::GetProcessAffinityMask(::GetCurrentProcess(), &process_mask, &system_mask) || process_mask == 0) {
+                return;
+            }
+            unsigned want = n % static_cast<unsigned>(std::popcount(static_cast<std::uint64_t>(process_mask)));
+            for (unsigned cpu = 0; cpu < sizeof(DWORD_PTR) * 8; ++cpu) {
+                const DWORD_PTR bit = DWORD_PTR{1} << cpu;
+                if ((process_mask & bit) != 0 && want-- == 0) {
+                    ::SetThreadAffinityMask(::GetCurrentThread(), bit);
+                    return;
+                }
+            }
+#else
+            (void)n;
+#endif
+        }
+
+        unsigned hardware_threads() {
+            const unsigned n = std::thread::hardware_concurrency();
+            return n == 0 ? 1 : n;
+        }
+
+        // parallel_for 的 共享 状态：晚 启动 的 帮手 可能 在 调用 返回 之后 才 运行，所以 放在 堆 上
+        struct for_state {
+            void (*body)(void*, std::size_t, std::size_t);
+            void* context; // 只在 还有 块 没 做完 时 使用，那时 调用 者 还在 等
+            std::size_t begin;
+            std::size_t end;
+            std::size_t grain;
+            std::size_t chunks;
+
+            alignas(64) std::atomic<std::size_t> next{0};
+            alignas(64) std::atomic<std::size_t> done{0};
+            std::atomic<std::uint32_t> finished{0};
+            std::mutex error_mutex;
+            std::exception_ptr error;
+        };
+
+        void run_chunks(for_state& s) {
+            for (;;) {
+                const std::size_t c = s.next.fetch_add(1, std::memory_order_relaxed);
+                if (c >= s.chunks) {
+                    return;
+                }
+                const std::size_t b = s.begin + c * s.grain;
+                std::size_t completed = 1;
+                try {
+                    s.body(s.context, b, std::min(b + s.grain, s.end));
+                } catch (...) {
+                    {
+                        std::lock_guard<std::mutex> lock(s.error_mutex);
+                        if (!s.error) {
+                            s.error = std::current_exception();
+                        }
+                    }
+                    // 剩下 没 领 的 块 不再 执行，直接 算 完成
+                    const std::size_t unclaimed = s.next.exchange(s.chunks, std::memory_order_relaxed);
+                    if (unclaimed < s.chunks) {
+                        completed += s.chunks - unclaimed;
+                    }
+                }
+                if (s.done.fetch_add(completed, std::memory_order_acq_rel) + completed == s.chunks) {
+                    s.finished.store(1, std::memory_order_release);
+                    s.finished.notify_all();
+                }
+            }
+        }
+
+        struct for_helper : pool_task {
+            explicit for_helper(std::shared_ptr<for_state> s) : pool_task{&for_helper::execute}, state(std::move(s)) {}
+
+            static void execute(pool_task* self) {
+                std::unique_ptr<for_helper> t(static_cast<for_helper*>(self));
+                run_chunks(*t->state);
+            }
+
+            std::shared_ptr<for_state> state;
+        };
+    }
+
+    struct thread_pool::impl {
+        explicit impl(unsigned threads) : workers(threads) {
+            for (auto& w : workers) w = std::make_unique<worker>();
+        }
+
+        // self 为 工作 线程 下标，外部 线程 传 workers.size()
+        pool_task* find_task(unsigned self) {
+            if (self < workers.size()) {
+                if (pool_task* t = workers[self]->deque.pop()) {
+                    return t;
+                }
+            }
+            if (inject_size.load(std::memory_order_relaxed) != 0) {
+                std::lock_guard<std::mutex> lock(inject_mutex);
+                if (!inject.empty()) {
+                    pool_task* t = inject.front();
+                    inject.pop_front();
+                    inject_size.store(inject.size(), std::memory_order_relaxed);
+                    return t;
+                }
+            }
+            // 从 随机 位置 开始 偷，抢 输了 的 再 试 一次
+            const auto n = static_cast<unsigned>(workers.size());
+            std::uint32_t& rng = t_worker.rng;
+            rng = rng * 1664525u + 1013904223u;
+            const unsigned start = rng % n;
+            for (int round = 0; round < 2; ++round) {
+                bool contended = false;
+                for (unsigned k = 0; k < n; ++k) {
+                    const unsigned victim = (start + k) % n;
+                    if (victim == self || !workers[victim]->deque.maybe_nonempty()) {
+                        continue;
+                    }
+                    if (pool_task* t = workers[victim]->deque.steal()) {
+                        return t;
+                    }
+                    contended = true;
+                }
+                if (!contended) {
+                    break;
+                }
+            }
+            return nullptr;
+        }
+
+        // 提交 之后 调用：只有 有人 睡 的 时候 才 去 拿锁
+        void notify() {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (sleepers.load(std::memory_order_relaxed) != 0) {
+                {
+                    std::lock_guard<std::mutex> lock(sleep_mutex);
+                    epoch.fetch_add(1, std::memory_order_relaxed);
+                }
+                sleep_cv.notify_one();
+            }
+        }
+
+        void worker_loop(unsigned index, bool pin) {
+            t_worker = {this, index, index * 2654435761u + 1};
+            if (pin) {
+                pin_current_thread(index);
+            }
+            unsigned idle = 0;
+            for (;;) {
+                if (pool_task* t = find_task(index)) {
+                    t->run(t);
+                    idle = 0;
+                    continue;
+                }
+                if (++idle < spin_rounds) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                idle = 0;
+
+                // 先 登记 再 最后 找 一遍：提交 者 要么 看到 登记 来 唤醒，要么 任务 在 这一遍 里 被 找到
+                sleepers.fetch_add(1, std::memory_order_seq_cst);
+                const std::uint64_t seen = epoch.load(std::memory_order_seq_cst);
+                if (pool_task* t = find_task(index)) {
+                    sleepers.fetch_sub(1, std::memory_order_relaxed);
+                    t->run(t);
+                    continue;
+                }
+                if (stopping.load(std::memory_order_acquire)) {
+                    sleepers.fetch_sub(1, std::memory_order_relaxed);
+                    return;
+                }
+                {
+                    std::unique_lock<std::mutex> lock(sleep_mutex);
+                    sleep_cv.wait(lock, [&] {
+                        return epoch.load(std::memory_order_relaxed) != seen || stopping.load(std::memory_order_relaxed);
+                    });
+                }
+                sleepers.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+
+        std::vector<std::unique_ptr<worker>> workers; // 线程 启动 后 不再 改
+
+        std::mutex inject_mutex;
+        std::deque<pool_task*> inject; // 外部 线程 提交 的
+        std::atomic<std::size_t> inject_size{0};
+
+        std::mutex sleep_mutex;
+        std::condition_variable sleep_cv;
+        std::atomic<unsigned> sleepers{0};
+        std::atomic<std::uint64_t> epoch{0};
+        std::atomic<bool> stopping{false};
+    };
+
+    thread_pool::thread_pool(thread_pool_options options)
+        : impl_(std::make_unique<impl>(options.threads == 0 ? hardware_threads() : options.threads)) {
+        // 所有 队列 建好 再 启动 线程，偷 的 时候 workers 不会 变
+        for (unsigned i = 0; i < impl_->workers.size(); ++i) {
+            impl_->workers[i]->thread = std::thread([this, i, pin = options.pin_threads] { impl_->worker_loop(i, pin); });
+        }
+    }
+
+    thread_pool::~thread_pool() {
+        {
+            std::lock_guard<std::mutex> lock(impl_->sleep_mutex);
+            impl_->stopping.store(true, std::memory_order_release);
+            impl_->epoch.fetch_add(1, std::memory_order_relaxed);
+        }
+        impl_->sleep_cv.notify_all();
+        for (auto& w : impl_->workers) w->thread.join();
+    }
+
+    thread_pool& thread_pool::global() {
+        // 故意 泄漏，同 e_math 原来 的 线程池：Windows 卸载 DLL 时 join 线程 会 死锁，进程 退出 时 线程 由 系统 回收
+        static thread_pool* pool = new thread_pool({.threads = std::max(hardware_threads(), 2u) - 1});
+        return *pool;
+    }
+
+    unsigned thread_pool::size() const noexcept {
+        return static_cast<unsigned>(impl_->workers.size());
+    }
+
+    bool thread_pool::on_worker_thread() const noexcept {
+        return t_worker.pool == impl_.get();
+    }
+
+    bool thread_pool::run_pending_task() {
+        if (!on_worker_thread()) {
+            return false;
+        }
+        pool_task* t = impl_->find_task(t_worker.index);
+        if (t == nullptr) {
+            return false;
+        }
+        t->run(t);
+        return true;
+    }
+
+    void thread_pool::push(pool_task* task) {
+        if (on_worker_thread()) {
+            impl_->workers[t_worker.index]->deque.push(task);
+        } else {
+            std::lock_guard<std::mutex> lock(impl_->inject_mutex);
+            impl_->inject.push_back(task);
+            impl_->inject_size.store(impl_->inject.size(), std::memory_order_relaxed);
+        }
+        impl_->notify();
+    }
+
+    void thread_pool::parallel_for_impl(std::size_t begin, std::size_t end, parallel_options options,
+                                        void (*body)(void*, std::size_t, std::size_t), void* context) {
+        if (end <= begin) {
+            return;
+        }
+        const std::size_t n = end - begin;
+        std::size_t threads = std::size_t{size()} + 1;
+        if (options.max_threads != 0) {
+            threads = std::min<std::size_t>(threads, options.max_threads);
+        }
+        const std::size_t grain = options.grain != 0 ? options.grain : std::max<std::size_t>(1, n / (threads * 8));
+        const std::size_t chunks = (n - 1) / grain + 1;
+        if (threads <= 1 || chunks <= 1) {
+            body(context, begin, end);
+            return;
+        }
+
+        auto state = std::make_shared<for_state>();
+        state->body = body;
+        state->context = context;
+        state->begin = begin;
+        state->end = end;
+        state->grain = grain;
+        state->chunks = chunks;
+        const std::size_t helpers = std::min(threads - 1, chunks - 1);
+        for (std::size_t h = 0; h < helpers; ++h) {
+            auto helper = std::make_unique<for_helper>(state);
+            push(helper.get());
+            helper.release();
+        }
+        run_chunks(*state);
+        detail::pool_wait(this, state->finished);
+        if (state->error) {
+            std::rethrow_exception(state->error);
+        }
+    }
+
+    namespace detail {
+        void pool_wait(thread_pool* pool, const std::atomic<std::uint32_t>& flag) {
+            if (pool != nullptr && pool->on_worker_thread()) {
+                // 工作 线程 不能 干等：等 的 东西 可能 还在 自己 的 队列 里
+                while (flag.load(std::memory_order_acquire) == 0) {
+                    if (!pool->run_pending_task()) {
+                        std::this_thread::yield();
+                    }
+                }
+                return;
+            }
+            while (flag.load(std::memory_order_acquire) == 0) {
+                flag.wait(0, std::memory_order_acquire);
+            }
+        }
+    }
+}
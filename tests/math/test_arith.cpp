@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include "e_arith.hpp"
+
+#include <cstdint>
+#include <limits>
+
+using e_math::checked;
+using e_math::saturate;
+using e_math::wrap;
+
+// constexpr 可用
+static_assert(e_math::add(1, 2, wrap) == 3);
+static_assert(e_math::add(std::int8_t(100), std::int8_t(100), saturate) == 127);
+static_assert(e_math::mul(std::uint16_t(300), std::uint16_t(300), checked).overflow);
+static_assert(e_math::sub(2.5, 0.5, wrap) == 2.0);
+
+TEST(E_Arith, Wrap) {
+    constexpr auto imax = std::numeric_limits<std::int32_t>::max();
+    constexpr auto imin = std::numeric_limits<std::int32_t>::min();
+    EXPECT_EQ(e_math::add(imax, 1, wrap), imin);
+    EXPECT_EQ(e_math::sub(imin, 1, wrap), imax);
+    EXPECT_EQ(e_math::mul(std::uint8_t(16), std::uint8_t(17), wrap), std::uint8_t(16));
+    EXPECT_EQ(e_math::mul(std::uint16_t(65535), std::uint16_t(65535), wrap), std::uint16_t(1));
+}
+
+template <class T>
+static void check_saturate() {
+    constexpr T mx = std::numeric_limits<T>::max();
+    constexpr T mn = std::numeric_limits<T>::min();
+
+    EXPECT_EQ(e_math::add(mx, T(1), saturate), mx);
+    EXPECT_EQ(e_math::add(T(mx - 1), T(1), saturate), mx);
+    EXPECT_EQ(e_math::sub(mn, T(1), saturate), mn);
+    EXPECT_EQ(e_math::mul(mx, T(2), saturate), mx);
+    if constexpr (std::is_signed_v<T>) {
+        EXPECT_EQ(e_math::add(mn, T(-1), saturate), mn);
+        EXPECT_EQ(e_math::sub(mx, T(-1), saturate), mx);
+        EXPECT_EQ(e_math::mul(mn, T(2), saturate), mn);
+        EXPECT_EQ(e_math::mul(mn, T(-1), saturate), mx);
+        EXPECT_EQ(e_math::mul(T(-3), T(4), saturate), T(-12));
+    }
+}
+
+TEST(E_Arith, Saturate) {
+    check_saturate<std::int8_t>();
+    check_saturate<std::uint8_t>();
+    check_saturate<std::int16_t>();
+    check_saturate<std::uint16_t>();
+    check_saturate<std::int32_t>();
+    check_saturate<std::uint32_t>();
+    check_saturate<std::int64_t>();
+    check_saturate<std::uint64_t>();
+
+    constexpr double dmax = std::numeric_limits<double>::max();
+    EXPECT_EQ(e_math::add(dmax, dmax, saturate), dmax);
+    EXPECT_EQ(e_math::mul(-dmax, 2.0, saturate), -dmax);
+}
+
+TEST(E_Arith, Checked) {
+    auto r = e_math::add(std::int64_t(1) << 62, std::int64_t(1) << 62, checked);
+    EXPECT_TRUE(r.overflow);
+    EXPECT_EQ(r.value, std::numeric_limits<std::int64_t>::min());
+
+    EXPECT_EQ(e_math::add(2u, 3u, checked), (e_math::checked_result<unsigned>{5u, false}));
+    EXPECT_TRUE(e_math::sub(2u, 3u, checked).overflow);
+    EXPECT_FALSE(e_math::mul(std::int64_t(-3037000499), std::int64_t(3037000499), checked).overflow);
+    EXPECT_TRUE(e_math::mul(std::int64_t(3037000500), std::int64_t(3037000500), checked).overflow);
+
+    EXPECT_TRUE(e_math::mul(1e300, 1e300, checked).overflow);
+    EXPECT_FALSE(e_math::add(std::numeric_limits<double>::infinity(), 1.0, checked).overflow);
+}
@@ -0,0 +1,256 @@
+#include <gtest/gtest.h>
+
+#include "e_bigint.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using e_math::bigint;
+
+namespace {
+    using i128 = __int128;
+    using u128 = unsigned __int128;
+
+    bigint from_i128(i128 v) {
+        const bool negative = v < 0;
+        const u128 m = negative ? u128(0) - static_cast<u128>(v) : static_cast<u128>(v);
+        bigint r = bigint(static_cast<std::uint64_t>(m >> 64)) * bigint("18446744073709551616") + bigint(static_cast<std::uint64_t>(m));
+        return negative ? -r : r;
+    }
+
+    std::string to_string_i128(i128 v) {
+        if (v == 0) {
+            return "0";
+        }
+        const bool negative = v < 0;
+        u128 m = negative ? u128(0) - static_cast<u128>(v) : static_cast<u128>(v);
+        std::string s;
+        for (; m != 0; m /= 10) s.insert(s.begin(), static_cast<char>('0' + static_cast<int>(m % 10)));
+        return negative ? "-" + s : s;
+    }
+
+    // 由 limb 拼出 一个 数：sum limbs[i] * 2^(64 i)
+    bigint from_limbs(const std::vector<std::uint64_t>& limbs) {
+        const bigint base("18446744073709551616");
+        bigint r;
+        for (std::size_t i = limbs.size(); i-- > 0;) r = r * base + bigint(limbs[i]);
+        return r;
+    }
+
+    std::vector<std::uint64_t> random_limbs(std::size_t n, std::mt19937_64& rng) {
+        std::vector<std::uint64_t> v(n);
+        for (auto& x : v) x = rng();
+        // 偶尔 出现 全 1 / 全 0 的 limb，覆盖 进位 链
+        if (n > 2) {
+            v[n / 2] = ~std::uint64_t(0);
+            v[n / 3] = 0;
+        }
+        return v;
+    }
+
+    // 对照：逐 limb 乘加，不经过 库 里 的 乘法
+    std::vector<std::uint64_t> reference_mul(const std::vector<std::uint64_t>& a, const std::vector<std::uint64_t>& b) {
+        std::vector<std::uint64_t> r(a.size() + b.size());
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            std::uint64_t carry = 0;
+            for (std::size_t j = 0; j < b.size(); ++j) {
+                const u128 t = static_cast<u128>(a[i]) * b[j] + r[i + j] + carry;
+                r[i + j] = static_cast<std::uint64_t>(t);
+                carry = static_cast<std::uint64_t>(t >> 64);
+            }
+            r[i + b.size()] = carry;
+        }
+        while (!r.empty() && r.back() == 0) r.pop_back();
+        return r;
+    }
+
+    std::vector<std::uint64_t> limbs_of(const bigint& x) {
+        return {x.limbs().begin(), x.limbs().end()};
+    }
+}
+
+TEST(E_BigInt, SmallMatchesInt128) {
+    std::mt19937_64 rng(1);
+    const std::int64_t edge[] = {0, 1, -1, 2, -2, std::numeric_limits<std::int64_t>::max(), std::numeric_limits<std::int64_t>::min()};
+    auto sample = [&](int i) -> std::int64_t {
+        return i < 7 ? edge[i] : static_cast<std::int64_t>(rng()) >> (rng() % 64);
+    };
+    for (int i = 0; i < 400; ++i) {
+        const std::int64_t x = sample(i % 50);
+        const std::int64_t y = sample((i * 7 + 3) % 50);
+        const bigint a(x), b(y);
+        EXPECT_EQ((a + b).to_string(), to_string_i128(i128(x) + y));
+        EXPECT_EQ((a - b).to_string(), to_string_i128(i128(x) - y));
+        EXPECT_EQ((a * b).to_string(), to_string_i128(i128(x) * y));
+        if (y != 0) {
+            EXPECT_EQ((a / b).to_string(), to_string_i128(i128(x) / y));
+            EXPECT_EQ((a % b).to_string(), to_string_i128(i128(x) % y));
+        }
+        EXPECT_EQ(a < b, x < y);
+        EXPECT_EQ(a == b, x == y);
+        EXPECT_EQ(a.to_int64(), x);
+        EXPECT_EQ(a.to_double(), static_cast<double>(x));
+    }
+}
+
+TEST(E_BigInt, Int128Range) {
+    std::mt19937_64 rng(2);
+    for (int i = 0; i < 300; ++i) {
+        // 保证 和 与 差 不溢出 int128
+        const i128 x = static_cast<i128>((static_cast<u128>(rng()) << 64 | rng()) >> 2) * (rng() % 2 ? 1 : -1);
+        const i128 y = static_cast<i128>((static_cast<u128>(rng()) << 64 | rng()) >> (2 + rng() % 120)) * (rng() % 2 ? 1 : -1);
+        const bigint a = from_i128(x), b = from_i128(y);
+        EXPECT_EQ(a.to_string(), to_string_i128(x));
+        EXPECT_EQ(bigint(to_string_i128(x)), a);
+        EXPECT_EQ(a + b, from_i128(x + y));
+        EXPECT_EQ(a - b, from_i128(x - y));
+        if (y != 0) {
+            EXPECT_EQ(a / b, from_i128(x / y));
+            EXPECT_EQ(a % b, from_i128(x % y));
+        }
+        EXPECT_EQ(a <=> b, x <=> y);
+    }
+}
+
+// 128 位 以内 的 值 不分配 堆内存
+TEST(E_BigInt, InlineStorage) {
+    const bigint max128("340282366920938463463374607431768211455");
+    EXPECT_TRUE(max128.is_inline());
+    EXPECT_EQ(max128.bit_length(), 128u);
+
+    bigint acc;
+    for (int i = 0; i < 1000; ++i) {
+        acc += bigint(std::numeric_limits<std::uint64_t>::max());
+        acc -= bigint(12345);
+    }
+    EXPECT_TRUE(acc.is_inline());
+
+    const bigint p = bigint(std::numeric_limits<std::uint64_t>::max()) * bigint(std::numeric_limits<std::uint64_t>::max());
+    EXPECT_TRUE(p.is_inline());
+    EXPECT_EQ(p.to_string(), "340282366920938463426481119284349108225");
+
+    const bigint over = max128 + bigint(1);
+    EXPECT_FALSE(over.is_inline());
+    EXPECT_EQ(over.bit_length(), 129u);
+    // 移动 后 原对象 为 0
+    bigint moved = std::move(acc);
+    EXPECT_TRUE(acc.is_zero());
+    EXPECT_FALSE(moved.is_zero());
+}
+
+TEST(E_BigInt, KnownValues) {
+    bigint pow2(1);
+    for (int i = 0; i < 200; ++i) pow2 *= bigint(2);
+    EXPECT_EQ(pow2.to_string(), "1606938044258990275541962092341162602522202993782792835301376");
+    EXPECT_EQ(pow2.bit_length(), 201u);
+
+    bigint fact(1);
+    for (int i = 2; i <= 30; ++i) fact *= bigint(i);
+    EXPECT_EQ(fact.to_string(), "265252859812191058636308480000000");
+
+    std::ostringstream os;
+    os << -fact;
+    EXPECT_EQ(os.str(), "-265252859812191058636308480000000");
+
+    EXPECT_EQ(bigint("-000123").to_string(), "-123");
+    EXPECT_EQ(bigint("+42"), bigint(42));
+    EXPECT_EQ(bigint("-0").to_string(), "0");
+    EXPECT_EQ(bigint("-0").sign(), 0);
+    EXPECT_EQ(bigint("10000000000000000000").to_string(), "10000000000000000000");
+    EXPECT_DOUBLE_EQ(pow2.to_double(), 1606938044258990275541962092341162602522202993782792835301376.0);
+}
+
+// 各种 长度 的 乘积 与 逐 limb 对照 一致，覆盖 逐 limb、Karatsuba、长短 相差 大 的 切段
+TEST(E_BigInt, MultiplySizes) {
+    std::mt19937_64 rng(3);
+    const std::size_t sizes[] = {1, 2, 3, 5, 17, 31, 32, 33, 47, 64, 65, 100, 257};
+    for (std::size_t an : sizes) {
+        for (std::size_t bn : sizes) {
+            const auto la = random_limbs(an, rng);
+            const auto lb = random_limbs(bn, rng);
+            const bigint a = from_limbs(la), b = from_limbs(lb);
+            EXPECT_EQ(limbs_of(a * b), reference_mul(la, lb)) << an << " x " << bn;
+            EXPECT_EQ(limbs_of((-a) * b), reference_mul(la, lb));
+            EXPECT_EQ((-a * b).sign(), -1);
+        }
+    }
+    // 全 1：进位 最多
+    const std::vector<std::uint64_t> ones(300, ~std::uint64_t(0));
+    const bigint m = from_limbs(ones);
+    EXPECT_EQ(limbs_of(m * m), reference_mul(ones, ones));
+}
+
+// a = q b + r，|r| < |b|，r 与 a 同号
+TEST(E_BigInt, DivideIdentity) {
+    std::mt19937_64 rng(4);
+    for (std::size_t an : {1, 2, 3, 8, 40, 120}) {
+        for (std::size_t bn : {1, 2, 3, 7, 39, 80}) {
+            for (int sign = 0; sign < 4; ++sign) {
+                bigint a = from_limbs(random_limbs(an, rng));
+                bigint b = from_limbs(random_limbs(bn, rng));
+                if (sign & 1) a = -a;
+                if (sign & 2) b = -b;
+                bigint q, r;
+                bigint::divmod(a, b, q, r);
+                EXPECT_EQ(q * b + r, a) << an << " / " << bn;
+                EXPECT_TRUE(r.is_zero() || r.sign() == a.sign());
+                EXPECT_LT(r.is_zero() ? bigint() : (r.sign() < 0 ? -r : r), b.sign() < 0 ? -b : b);
+            }
+        }
+    }
+    // 需要 加回 的 情况：除数 次高 limb 很小
+    const bigint a = from_limbs({0, 0, 0x8000000000000000ull, 0x7fffffffffffffffull});
+    const bigint b = from_limbs({1, 0, 0x8000000000000000ull});
+    bigint q, r;
+    bigint::divmod(a, b, q, r);
+    EXPECT_EQ(q * b + r, a);
+    EXPECT_LT(r, b);
+}
+
+TEST(E_BigInt, AddSubIdentity) {
+    std::mt19937_64 rng(5);
+    for (std::size_t an : {1, 2, 3, 10, 50}) {
+        for (std::size_t bn : {1, 2, 3, 10, 50}) {
+            const bigint a = from_limbs(random_limbs(an, rng));
+            const bigint b = -from_limbs(random_limbs(bn, rng));
+            EXPECT_EQ(a + b - b, a);
+            EXPECT_EQ(a - b + b, a);
+            EXPECT_EQ(a + b, b + a);
+            EXPECT_EQ((a - a).sign(), 0);
+            bigint c = a;
+            c += c;
+            EXPECT_EQ(c, a * bigint(2));
+            c -= c;
+            EXPECT_TRUE(c.is_zero());
+        }
+    }
+}
+
+TEST(E_BigInt, Conversions) {
+    EXPECT_TRUE(bigint(std::numeric_limits<std::int64_t>::min()).fits_int64());
+    EXPECT_EQ(bigint(std::numeric_limits<std::int64_t>::min()).to_int64(), std::numeric_limits<std::int64_t>::min());
+    EXPECT_FALSE(bigint(std::uint64_t(1) << 63).fits_int64());
+    EXPECT_THROW(bigint(std::uint64_t(1) << 63).to_int64(), std::overflow_error);
+
+    // 就近 舍入：2^64 + 2^11 + 1 应 向上 舍入 到 2^64 + 2^12
+    const bigint x = bigint("18446744073709551616") + bigint(2049);
+    EXPECT_EQ(x.to_double(), 18446744073709555712.0);
+    bigint huge(1);
+    for (int i = 0; i < 1100; ++i) huge *= bigint(2);
+    EXPECT_EQ(huge.to_double(), std::numeric_limits<double>::infinity());
+    EXPECT_EQ((-huge).to_double(), -std::numeric_limits<double>::infinity());
+}
+
+TEST(E_BigInt, Invalid) {
+    EXPECT_THROW(bigint(""), std::invalid_argument);
+    EXPECT_THROW(bigint("-"), std::invalid_argument);
+    EXPECT_THROW(bigint("12a"), std::invalid_argument);
+    EXPECT_THROW(bigint(" 1"), std::invalid_argument);
+    EXPECT_THROW(bigint(1) / bigint(0), std::domain_error);
+    EXPECT_THROW(bigint(1) % bigint(), std::domain_error);
+}
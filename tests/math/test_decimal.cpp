@@ -0,0 +1,324 @@
+#include <gtest/gtest.h>
+
+#include "e_decimal.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using e_math::decimal;
+using e_math::decimal_cast;
+
+namespace {
+    using money = decimal<std::int64_t, 2>;
+    using rate = decimal<std::int32_t, 4>;
+    using fine = decimal<std::int64_t, 18>;
+
+    template <class D>
+    std::string format(D d) {
+        char buf[D::max_chars];
+        const auto r = d.to_chars(buf, buf + sizeof(buf));
+        return std::string(buf, r.ptr);
+    }
+
+    // 批量 乘法 与 逐个 operator* 逐位 相同
+    template <class D>
+    void check_batch_mul(const std::vector<D>& a, const std::vector<D>& b) {
+        std::vector<D> out(a.size());
+        D::mul(a, b, out);
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            ASSERT_EQ(out[i], a[i] * b[i]) << i << ": " << a[i] << " * " << b[i];
+        }
+    }
+}
+
+// 编译期 可用
+static_assert(money::parse("12.34").raw() == 1234);
+static_assert(money(3).raw() == 300);
+static_assert(decimal_cast<decimal<std::int64_t, 4>>(money::parse("1.25")).raw() == 12500);
+static_assert(decimal_cast<decimal<std::int32_t, 1>>(money::parse("1.25")).raw() == 12);
+static_assert(decimal_cast<decimal<std::int32_t, 1>>(money::parse("1.35")).raw() == 14);
+static_assert((money::parse("1.05") * money::parse("1.05")) == money::parse("1.10"));
+static_assert(money::one == 100 && rate::one == 10000);
+
+TEST(E_Decimal, ParseAndFormat) {
+    EXPECT_EQ(money::parse("0").raw(), 0);
+    EXPECT_EQ(money::parse("-12.3").raw(), -1230);
+    EXPECT_EQ(money::parse(".5").raw(), 50);
+    EXPECT_EQ(money::parse("007.01").raw(), 701);
+    EXPECT_EQ(money::parse("92233720368547758.07").raw(), std::numeric_limits<std::int64_t>::max());
+    EXPECT_EQ(money::parse("-92233720368547758.08").raw(), std::numeric_limits<std::int64_t>::min());
+
+    EXPECT_EQ(format(money::from_raw(5)), "0.05");
+    EXPECT_EQ(format(money::from_raw(-1230)), "-12.30");
+    EXPECT_EQ(format(money::from_raw(std::numeric_limits<std::int64_t>::min())), "-92233720368547758.08");
+    EXPECT_EQ(format(decimal<std::int32_t, 0>::from_raw(-7)), "-7");
+    EXPECT_EQ(format(decimal<std::int32_t, 9>::from_raw(std::numeric_limits<std::int32_t>::min())), "-2.147483648");
+    EXPECT_EQ(format(fine::from_raw(std::numeric_limits<std::int64_t>::min())), "-9.223372036854775808");
+
+    std::ostringstream os;
+    os << rate::parse("-0.0001");
+    EXPECT_EQ(os.str(), "-0.0001");
+}
+
+// 多出来的 小数位 就近 取偶
+TEST(E_Decimal, ParseRounding) {
+    EXPECT_EQ(money::parse("0.125").raw(), 12);
+    EXPECT_EQ(money::parse("0.135").raw(), 14);
+    EXPECT_EQ(money::parse("0.1250001").raw(), 13);
+    EXPECT_EQ(money::parse("-0.125").raw(), -12);
+    EXPECT_EQ(money::parse("0.126").raw(), 13);
+    EXPECT_EQ(money::parse("0.12499999999999999999999").raw(), 12);
+    EXPECT_EQ(money::parse("9.995").raw(), 1000);
+    EXPECT_THROW(money::parse("92233720368547758.075"), std::out_of_range);
+}
+
+TEST(E_Decimal, FromCharsErrors) {
+    money d = money::from_raw(42);
+    const std::string_view bad[] = {"", "-", ".", "+1", " 1", "abc", "-.", "."};
+    for (auto s : bad) {
+        const auto r = money::from_chars(s.data(), s.data() + s.size(), d);
+        EXPECT_EQ(r.ec, std::errc::invalid_argument) << s;
+        EXPECT_EQ(r.ptr, s.data()) << s;
+        EXPECT_EQ(d.raw(), 42) << s;
+    }
+
+    // 停在 第一个 不属于 数 的 字符
+    const std::string_view s = "12.5x";
+    auto r = money::from_chars(s.data(), s.data() + s.size(), d);
+    EXPECT_EQ(r.ec, std::errc{});
+    EXPECT_EQ(r.ptr, s.data() + 4);
+    EXPECT_EQ(d.raw(), 1250);
+    const std::string_view dot = "3.";
+    r = money::from_chars(dot.data(), dot.data() + dot.size(), d);
+    EXPECT_EQ(r.ptr, dot.data() + 1);
+    EXPECT_EQ(d.raw(), 300);
+
+    const std::string_view big = "92233720368547758.08";
+    r = money::from_chars(big.data(), big.data() + big.size(), d);
+    EXPECT_EQ(r.ec, std::errc::result_out_of_range);
+    EXPECT_EQ(r.ptr, big.data() + big.size());
+    EXPECT_EQ(d.raw(), 300);
+
+    EXPECT_THROW(money::parse("1.2.3"), std::invalid_argument);
+    EXPECT_THROW(money::parse("1e5"), std::invalid_argument);
+    EXPECT_THROW(rate::parse("214748.3648"), std::out_of_range);
+
+    char small[4];
+    EXPECT_EQ(money::from_raw(12345).to_chars(small, small + 4).ec, std::errc::value_too_large);
+}
+
+TEST(E_Decimal, TextRoundtrip) {
+    std::mt19937_64 rng(1);
+    for (int i = 0; i < 2000; ++i) {
+        const auto m = money::from_raw(static_cast<std::int64_t>(rng()) >> (rng() % 64));
+        EXPECT_EQ(money::parse(format(m)), m);
+        const auto r = rate::from_raw(static_cast<std::int32_t>(rng()) >> (rng() % 32));
+        EXPECT_EQ(rate::parse(format(r)), r);
+        const auto e = fine::from_raw(static_cast<std::int64_t>(rng()));
+        EXPECT_EQ(fine::parse(format(e)), e);
+    }
+}
+
+TEST(E_Decimal, Arithmetic) {
+    EXPECT_EQ(money::parse("0.1") + money::parse("0.2"), money::parse("0.3"));
+    EXPECT_EQ(money::parse("5") - money::parse("7.5"), money::parse("-2.5"));
+    EXPECT_EQ(-money::parse("1.5"), money::parse("-1.5"));
+    EXPECT_LT(money::parse("-0.01"), money());
+    EXPECT_EQ(money::parse("-3.99").whole(), -3);
+    EXPECT_DOUBLE_EQ(money::parse("12.5").to_double(), 12.5);
+
+    // 乘法：0.075 -> 0.08，0.125 -> 0.12，-0.125 -> -0.12
+    EXPECT_EQ(money::parse("0.15") * money::parse("0.5"), money::parse("0.08"));
+    EXPECT_EQ(money::parse("0.25") * money::parse("0.5"), money::parse("0.12"));
+    EXPECT_EQ(money::parse("-0.25") * money::parse("0.5"), money::parse("-0.12"));
+    EXPECT_EQ(money::parse("-0.15") * money::parse("0.5"), money::parse("-0.08"));
+    EXPECT_EQ(money::parse("19.99") * money(3), money::parse("59.97"));
+
+    // 除法
+    EXPECT_EQ(money(1) / money(3), money::parse("0.33"));
+    EXPECT_EQ(money(2) / money(3), money::parse("0.67"));
+    EXPECT_EQ(money(1) / money(-3), money::parse("-0.33"));
+    EXPECT_EQ(money(-2) / money(3), money::parse("-0.67"));
+    EXPECT_EQ(money::parse("0.01") / money(2), money());
+    EXPECT_EQ(money::parse("0.03") / money(2), money::parse("0.02"));
+    EXPECT_EQ(money::parse("-0.03") / money(-2), money::parse("0.02"));
+
+    // int64 的 乘积 超过 64 位，中间 用 128 位
+    const money big = money::parse("90000000000000000");
+    EXPECT_EQ(big * money::parse("0.5"), money::parse("45000000000000000"));
+    EXPECT_EQ(big / money(1000000), money::parse("90000000000"));
+}
+
+TEST(E_Decimal, Cast) {
+    EXPECT_EQ(decimal_cast<rate>(money::parse("-1.23")).raw(), -12300);
+    EXPECT_EQ(decimal_cast<money>(rate::parse("1.2350")).raw(), 124);
+    EXPECT_EQ(decimal_cast<money>(rate::parse("1.2250")).raw(), 122);
+    EXPECT_EQ(decimal_cast<money>(rate::parse("-1.2251")).raw(), -123);
+    EXPECT_THROW(decimal_cast<rate>(money(1000000)), std::overflow_error);
+    EXPECT_THROW(decimal_cast<fine>(money(1000)), std::overflow_error);
+}
+
+TEST(E_Decimal, Errors) {
+    const money max = money::from_raw(std::numeric_limits<std::int64_t>::max());
+    const money min = money::from_raw(std::numeric_limits<std::int64_t>::min());
+    EXPECT_THROW(max + money::from_raw(1), std::overflow_error);
+    EXPECT_THROW(min - money::from_raw(1), std::overflow_error);
+    EXPECT_THROW(-min, std::overflow_error);
+    EXPECT_THROW(max * money(2), std::overflow_error);
+    EXPECT_THROW(max / money::parse("0.5"), std::overflow_error);
+    EXPECT_THROW(money(1) / money(), std::domain_error);
+    EXPECT_THROW(rate(300000), std::overflow_error);
+    EXPECT_THROW(money(std::numeric_limits<std::uint64_t>::max()), std::overflow_error);
+    EXPECT_EQ(money(-5).raw(), -500);
+}
+
+TEST(E_Decimal, BatchMul) {
+    std::mt19937_64 rng(2);
+    // 各种 长度，覆盖 向量 主体 与 尾部
+    for (std::size_t n : {0, 1, 3, 4, 7, 8, 9, 31, 1000}) {
+        std::vector<rate> a(n), b(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            a[i] = rate::from_raw(static_cast<std::int32_t>(rng()) >> 1);
+            b[i] = rate::from_raw(static_cast<std::int32_t>(rng() % 20001) - 10000);
+        }
+        check_batch_mul(a, b);
+
+        std::vector<money> c(n), d(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            c[i] = money::from_raw(static_cast<std::int64_t>(rng()) >> 20);
+            d[i] = money::from_raw(static_cast<std::int64_t>(rng() % 2000001) - 1000000);
+        }
+        check_batch_mul(c, d);
+    }
+
+    // 正好 一半：乘积 末 4 位 为 5000
+    std::vector<rate> a, b;
+    for (int i = -200; i <= 200; ++i) {
+        a.push_back(rate::from_raw(i * 5));
+        b.push_back(rate::from_raw(1000));
+        a.push_back(rate::from_raw(i));
+        b.push_back(rate::from_raw(5000));
+    }
+    check_batch_mul(a, b);
+
+    // 结果 恰好 在 int32 边界
+    a = {rate::from_raw(std::numeric_limits<std::int32_t>::max()), rate::from_raw(std::numeric_limits<std::int32_t>::min()), rate::from_raw(-std::numeric_limits<std::int32_t>::max())};
+    b = {rate(1), rate(1), rate(-1)};
+    check_batch_mul(a, b);
+
+    // scale 0 与 scale 9
+    std::vector<decimal<std::int32_t, 0>> i0(37), j0(37);
+    std::vector<decimal<std::int32_t, 9>> i9(37), j9(37);
+    for (std::size_t i = 0; i < 37; ++i) {
+        i0[i] = decimal<std::int32_t, 0>::from_raw(static_cast<std::int32_t>(rng() % 60001) - 30000);
+        j0[i] = decimal<std::int32_t, 0>::from_raw(static_cast<std::int32_t>(rng() % 60001) - 30000);
+        i9[i] = decimal<std::int32_t, 9>::from_raw(static_cast<std::int32_t>(rng()) >> 1);
+        j9[i] = decimal<std::int32_t, 9>::from_raw(static_cast<std::int32_t>(rng()) >> 1);
+    }
+    check_batch_mul(i0, j0);
+    check_batch_mul(i9, j9);
+}
+
+TEST(E_Decimal, BatchAddAndSum) {
+    std::mt19937_64 rng(3);
+    for (std::size_t n : {0, 1, 5, 16, 17, 1000, 100000}) {
+        std::vector<rate> a(n), b(n), out(n);
+        std::vector<money> c(n), d(n), out64(n);
+        std::int64_t expected32 = 0, expected64 = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            a[i] = rate::from_raw(static_cast<std::int32_t>(rng()) >> 2);
+            b[i] = rate::from_raw(static_cast<std::int32_t>(rng()) >> 2);
+            c[i] = money::from_raw(static_cast<std::int64_t>(rng()) >> 24);
+            d[i] = money::from_raw(static_cast<std::int64_t>(rng()) >> 24);
+            expected32 += a[i].raw();
+            expected64 += c[i].raw();
+        }
+        rate::add(a, b, out);
+        money::add(c, d, out64);
+        for (std::size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(out[i], a[i] + b[i]);
+            ASSERT_EQ(out64[i], c[i] + d[i]);
+        }
+        EXPECT_EQ(rate::sum(a).raw(), expected32);
+        EXPECT_EQ(money::sum(c).raw(), expected64);
+    }
+
+    // int32 的 和 用 int64 存储，不会 溢出
+    const std::vector<rate> full(100, rate::from_raw(std::numeric_limits<std::int32_t>::max()));
+    EXPECT_EQ(rate::sum(full).raw(), 100 * std::int64_t(std::numeric_limits<std::int32_t>::max()));
+
+    // 中间 溢出、最终 回到 范围 内 不算 溢出；最终 超出 才 抛
+    const std::int64_t max = std::numeric_limits<std::int64_t>::max();
+    std::vector<money> v(40, money::from_raw(max));
+    v.resize(80, money::from_raw(-max));
+    EXPECT_EQ(money::sum(v).raw(), 0);
+    v.push_back(money::from_raw(max));
+    v.push_back(money::from_raw(1));
+    EXPECT_THROW(money::sum(v), std::overflow_error);
+    std::vector<money> negative(33, money::from_raw(std::numeric_limits<std::int64_t>::min() / 32));
+    EXPECT_THROW(money::sum(negative), std::overflow_error);
+}
+
+TEST(E_Decimal, BatchErrors) {
+    std::vector<rate> a(20, rate(1)), b(20, rate(2)), out(20), shorter(19);
+    EXPECT_THROW(rate::add(a, b, shorter), std::invalid_argument);
+    EXPECT_THROW(rate::mul(a, shorter, out), std::invalid_argument);
+
+    // 任何 一个 元素 溢出 都 抛，不论 在 向量 主体 还是 尾部
+    for (std::size_t pos : {0, 5, 17, 19}) {
+        auto x = a;
+        x[pos] = rate::from_raw(std::numeric_limits<std::int32_t>::max());
+        EXPECT_THROW(rate::add(x, b, out), std::overflow_error) << pos;
+        EXPECT_THROW(rate::mul(x, b, out), std::overflow_error) << pos;
+        std::vector<money> y(20, money(1));
+        y[pos] = money::from_raw(std::numeric_limits<std::int64_t>::min());
+        std::vector<money> z(20, money::from_raw(-1)), out64(20);
+        EXPECT_THROW(money::add(y, z, out64), std::overflow_error) << pos;
+        EXPECT_THROW(money::mul(y, std::vector<money>(20, money(2)), out64), std::overflow_error) << pos;
+    }
+
+    // 原地
+    rate::add(a, b, a);
+    EXPECT_EQ(a[7], rate(3));
+    rate::mul(a, b, b);
+    EXPECT_EQ(b[7], rate(6));
+}
+
+// 没有 __int128 时 用 的 soft_int128：与 内置 128 位 整数 逐位 对比
+TEST(E_Decimal, SoftInt128MatchesBuiltin) {
+    using e_math::detail::soft_int128;
+    static_assert(e_math::detail::div_round_even<soft_int128>(soft_int128(-25) * soft_int128(1), soft_int128(10)) == soft_int128(-2));
+    static_assert(soft_int128(std::numeric_limits<std::int64_t>::min()) * soft_int128(-1) > soft_int128(std::numeric_limits<std::int64_t>::max()));
+
+#if defined(__SIZEOF_INT128__)
+    using i128 = e_math::detail::decimal_int128;
+    const auto same = [](soft_int128 s, i128 b) { return s.lo == static_cast<std::uint64_t>(b) && s.hi == static_cast<std::uint64_t>(b >> 64); };
+
+    std::mt19937_64 rng(13);
+    const std::int64_t edges[] = {0, 1, -1, 9, -10, std::numeric_limits<std::int64_t>::max(), std::numeric_limits<std::int64_t>::min()};
+    for (int i = 0; i < 20000; ++i) {
+        const auto x = i < 49 ? edges[i % 7] : static_cast<std::int64_t>(rng()) >> (rng() % 64);
+        const auto y = i < 49 ? edges[i / 7] : static_cast<std::int64_t>(rng()) >> (rng() % 64);
+        const soft_int128 p = soft_int128(x) * soft_int128(y);
+        const i128 q = i128(x) * i128(y);
+        ASSERT_TRUE(same(p, q)) << x << " * " << y;
+        ASSERT_TRUE(same(-p, -q));
+        ASSERT_EQ(p < soft_int128(0), q < 0);
+        ASSERT_EQ(p > soft_int128(std::numeric_limits<std::int64_t>::max()), q > std::numeric_limits<std::int64_t>::max());
+
+        // 除数 取 10^k 与 int64 的 绝对值，最大 2^63
+        const std::uint64_t d = rng() % 2 ? std::uint64_t(e_math::detail::pow10<std::int64_t>(static_cast<int>(rng() % 19))) : (std::uint64_t(y) ^ (y < 0 ? ~0ull : 0)) + (y < 0);
+        if (d == 0) continue;
+        ASSERT_TRUE(same(p / soft_int128(d), q / i128(d))) << x << " * " << y << " / " << d;
+        ASSERT_TRUE(same(p % soft_int128(d), q % i128(d)));
+        ASSERT_TRUE(same(e_math::detail::div_round_even<soft_int128>(p, soft_int128(d)), e_math::detail::div_round_even<i128>(q, i128(d))));
+        ASSERT_EQ(static_cast<std::int64_t>(p / soft_int128(d)), static_cast<std::int64_t>(q / i128(d)));
+    }
+#endif
+}
@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+
+#include "e_expr.hpp"
+#include "e_parallel.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace {
+    // 跨越 单块 / 多块 / 不整除 的 长度
+    const std::size_t kSizes[] = {0, 1, 7, 255, 256, 257, 1000, 4099, 70001};
+
+    template <class T>
+    std::vector<T> random_values(std::size_t n, unsigned seed) {
+        std::mt19937_64 rng(seed);
+        std::vector<T> v(n);
+        for (auto& x : v) {
+            if constexpr (std::is_floating_point_v<T>) {
+                x = static_cast<T>(std::uniform_real_distribution<double>(-100.0, 100.0)(rng));
+            } else {
+                x = static_cast<T>(std::uniform_int_distribution<std::int64_t>(-100000, 100000)(rng));
+            }
+        }
+        return v;
+    }
+
+    // 参考值：整数 按 补码 回绕（同 库 的 约定），先 转 无符号 再 算，避免 有符号 溢出 的 未定义 行为
+    template <class T>
+    T ref_add(T x, T y) {
+        if constexpr (std::is_integral_v<T>) {
+            using U = std::make_unsigned_t<T>;
+            return static_cast<T>(static_cast<U>(static_cast<U>(x) + static_cast<U>(y)));
+        } else {
+            return x + y;
+        }
+    }
+
+    template <class T>
+    T ref_sub(T x, T y) {
+        if constexpr (std::is_integral_v<T>) {
+            using U = std::make_unsigned_t<T>;
+            return static_cast<T>(static_cast<U>(static_cast<U>(x) - static_cast<U>(y)));
+        } else {
+            return x - y;
+        }
+    }
+
+    template <class T>
+    T ref_mul(T x, T y) {
+        if constexpr (std::is_integral_v<T>) {
+            using U = std::make_unsigned_t<T>;
+            return static_cast<T>(static_cast<U>(static_cast<U>(x) * static_cast<U>(y)));
+        } else {
+            return x * y;
+        }
+    }
+
+    class ThreadsGuard {
+    public:
+        ~ThreadsGuard() { e_math::set_max_threads(0); }
+    };
+}
+
+// 与 一步一步 用 临时数组 算 的 结果 逐位 相同
+template <class T>
+static void check_fused() {
+    for (std::size_t n : kSizes) {
+        auto a = random_values<T>(n, 1), b = random_values<T>(n, 2), c = random_values<T>(n, 3), d = random_values<T>(n, 4);
+        std::vector<T> out(n), expect(n), t(n);
+
+        e_math::array_view va(a), vb(b), vc(c), vd(d), vo(out);
+        vo = va + vb * vc - vd;
+        for (std::size_t i = 0; i < n; ++i) t[i] = ref_mul(b[i], c[i]);
+        for (std::size_t i = 0; i < n; ++i) t[i] = ref_add(a[i], t[i]);
+        for (std::size_t i = 0; i < n; ++i) expect[i] = ref_sub(t[i], d[i]);
+        EXPECT_EQ(out, expect) << n;
+
+        // 两边 都是 子表达式，要用 多个 块 缓冲
+        vo = (va * vb + vc * vd) - (va - vb * (vc + vd));
+        for (std::size_t i = 0; i < n; ++i) {
+            T l = ref_mul(a[i], b[i]);
+            T r = ref_mul(c[i], d[i]);
+            l = ref_add(l, r);
+            T s = ref_add(c[i], d[i]);
+            s = ref_mul(b[i], s);
+            s = ref_sub(a[i], s);
+            expect[i] = ref_sub(l, s);
+        }
+        EXPECT_EQ(out, expect) << n;
+
+        vo = e_math::clamp(T(3) - va * T(2), T(-50), T(50)) + e_math::max(va, vb) * e_math::min(vc, T(10));
+        for (std::size_t i = 0; i < n; ++i) {
+            T x = ref_mul(a[i], T(2));
+            x = ref_sub(T(3), x);
+            x = std::min(std::max(x, T(-50)), T(50));
+            T y = std::max(a[i], b[i]);
+            y = ref_mul(y, std::min(c[i], T(10)));
+            expect[i] = ref_add(x, y);
+        }
+        EXPECT_EQ(out, expect) << n;
+    }
+}
+
+TEST(E_Expr, FusedFloat) { check_fused<float>(); }
+TEST(E_Expr, FusedDouble) { check_fused<double>(); }
+TEST(E_Expr, FusedInt32) { check_fused<std::int32_t>(); }
+TEST(E_Expr, FusedInt64) { check_fused<std::int64_t>(); }
+
+TEST(E_Expr, IntegerWraps) {
+    const std::int32_t max = std::numeric_limits<std::int32_t>::max();
+    const std::int32_t min = std::numeric_limits<std::int32_t>::min();
+    std::vector<std::int32_t> a(100, max), b(100, min), out(100);
+    e_math::array_view va(a), vb(b), vo(out);
+
+    vo = va + 1;
+    EXPECT_EQ(out[99], min);
+    vo = vb - va;
+    EXPECT_EQ(out[0], 1);
+    vo = va * 2;
+    EXPECT_EQ(out[50], -2);
+}
+
+TEST(E_Expr, MinMaxFollowStd) {
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    std::vector<float> a = {nan, 1.0f, -0.0f, 2.0f}, b = {1.0f, nan, 0.0f, 2.0f}, out(4);
+    e_math::array_view va(a), vb(b), vo(out);
+
+    vo = e_math::min(va, vb);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        const float expect = std::min(a[i], b[i]);
+        EXPECT_EQ(std::memcmp(&out[i], &expect, sizeof(float)), 0) << i;
+    }
+    vo = e_math::max(va, vb);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        const float expect = std::max(a[i], b[i]);
+        EXPECT_EQ(std::memcmp(&out[i], &expect, sizeof(float)), 0) << i;
+    }
+}
+
+TEST(E_Expr, InPlaceAndCompound) {
+    auto a = random_values<double>(1000, 5);
+    const auto b = random_values<double>(1000, 6);
+    auto expect = a;
+    e_math::array_view va(a);
+    const e_math::array_view vb(b);
+
+    va = va * 2.0 + vb;
+    va += vb;
+    va -= 1.0;
+    va *= vb;
+    for (std::size_t i = 0; i < a.size(); ++i) expect[i] = (expect[i] * 2.0 + b[i] + b[i] - 1.0) * b[i];
+    EXPECT_EQ(a, expect);
+
+    // 赋值 复制 元素
+    std::vector<double> copy(1000);
+    e_math::array_view vc(copy);
+    vc = va;
+    EXPECT_EQ(copy, a);
+    EXPECT_EQ(vc.data(), copy.data());
+}
+
+TEST(E_Expr, ParallelMatchesSequential) {
+    ThreadsGuard guard;
+    const std::size_t n = 300007;
+    const auto a = random_values<float>(n, 7), b = random_values<float>(n, 8), c = random_values<float>(n, 9);
+    std::vector<float> seq(n), par(n);
+    const e_math::array_view va(a), vb(b), vc(c);
+    const auto e = e_math::clamp(va * vb - vc, -10.0f, 10.0f);
+
+    e_math::array_view(seq).assign(e);
+    for (unsigned threads : {1u, 2u, 3u, 8u}) {
+        e_math::set_max_threads(threads);
+        std::fill(par.begin(), par.end(), 0.0f);
+        e_math::array_view(par).assign(e, e_math::execution::parallel);
+        EXPECT_EQ(par, seq) << threads;
+    }
+}
+
+TEST(E_Expr, ExtentsMustMatch) {
+    std::vector<float> a(10), b(11), out(10);
+    e_math::array_view va(a), vb(b), vo(out);
+
+    EXPECT_THROW(va + vb, std::invalid_argument);
+    EXPECT_THROW(vo = vb * 2.0f, std::invalid_argument);
+    EXPECT_THROW(vo.assign(vb - 1.0f, e_math::execution::parallel), std::invalid_argument);
+}
@@ -0,0 +1,246 @@
+#include <gtest/gtest.h>
+
+#include "e_fft.hpp"
+#include "e_parallel.hpp"
+
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    class ThreadsGuard {
+    public:
+        ~ThreadsGuard() { e_math::set_max_threads(0); }
+    };
+
+    template <class T>
+    std::vector<std::complex<T>> random_complex(std::size_t n, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> d(-1, 1);
+        std::vector<std::complex<T>> v(n);
+        for (auto& x : v) x = {static_cast<T>(d(rng)), static_cast<T>(d(rng))};
+        return v;
+    }
+
+    template <class T>
+    std::vector<T> random_real(std::size_t n, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> d(-1, 1);
+        std::vector<T> v(n);
+        for (auto& x : v) x = static_cast<T>(d(rng));
+        return v;
+    }
+
+    // 按 定义 算，long double，sign = -1 正变换
+    template <class T>
+    std::vector<std::complex<long double>> naive_dft(const std::vector<std::complex<T>>& x, int sign) {
+        const std::size_t n = x.size();
+        std::vector<std::complex<long double>> w(n), y(n);
+        for (std::size_t e = 0; e < n; ++e) {
+            const long double a = sign * 2 * std::numbers::pi_v<long double> * static_cast<long double>(e) / static_cast<long double>(n);
+            w[e] = {std::cos(a), std::sin(a)};
+        }
+        for (std::size_t k = 0; k < n; ++k) {
+            std::complex<long double> acc = 0;
+            for (std::size_t t = 0; t < n; ++t) acc += std::complex<long double>(x[t].real(), x[t].imag()) * w[t * k % n];
+            y[k] = acc;
+        }
+        return y;
+    }
+
+    // 相对 均方根 误差
+    template <class A, class B>
+    double rel_error(const std::vector<A>& got, const std::vector<B>& ref) {
+        long double num = 0, den = 0;
+        for (std::size_t i = 0; i < ref.size(); ++i) {
+            const std::complex<long double> g(got[i].real(), got[i].imag());
+            const std::complex<long double> r(ref[i].real(), ref[i].imag());
+            num += std::norm(g - r);
+            den += std::norm(r);
+        }
+        return den == 0 ? static_cast<double>(std::sqrt(num)) : static_cast<double>(std::sqrt(num / den));
+    }
+
+    // FFT 的 均方根 误差 约 eps * sqrt(log n)，留足 余量
+    template <class T>
+    double tolerance(std::size_t n) {
+        return 8 * std::numeric_limits<T>::epsilon() * (1 + std::log2(static_cast<double>(n)));
+    }
+
+    template <class T>
+    void check_against_naive(std::size_t n) {
+        const auto x = random_complex<T>(n, static_cast<unsigned>(n));
+        const auto plan = e_math::fft_plan<T>::cached(n);
+        std::vector<std::complex<T>> y(n), z(n);
+        plan->forward(x, y);
+        EXPECT_LT(rel_error(y, naive_dft(x, -1)), tolerance<T>(n)) << "n = " << n;
+        plan->inverse(x, z);
+        EXPECT_LT(rel_error(z, naive_dft(x, 1)), tolerance<T>(n)) << "n = " << n;
+    }
+
+    template <class T>
+    void check_sizes() {
+        for (std::size_t n = 1; n <= 64; ++n) check_against_naive<T>(n);
+        // 大素因子、重复 因子、2 3 5 7 11 混合
+        for (std::size_t n : {97, 121, 128, 243, 360, 625, 1000, 1024, 2310, 4096}) check_against_naive<T>(n);
+    }
+
+    template <class T>
+    void check_roundtrip(std::size_t n) {
+        const auto x = random_complex<T>(n, 3);
+        std::vector<std::complex<T>> y(n), z(n);
+        e_math::fft(x, y);
+        e_math::ifft(y, z);
+        for (auto& v : z) v /= static_cast<T>(n);
+        EXPECT_LT(rel_error(z, x), tolerance<T>(n)) << "n = " << n;
+    }
+
+    template <class T>
+    void check_real(std::size_t n) {
+        const auto x = random_real<T>(n, static_cast<unsigned>(n) + 1);
+        std::vector<std::complex<T>> xc(x.begin(), x.end());
+        const auto ref = naive_dft(xc, -1);
+
+        std::vector<std::complex<T>> spec(n / 2 + 1);
+        e_math::rfft(x, spec);
+        const std::vector<std::complex<long double>> half(ref.begin(), ref.begin() + static_cast<std::ptrdiff_t>(n / 2 + 1));
+        EXPECT_LT(rel_error(spec, half), tolerance<T>(n)) << "n = " << n;
+        EXPECT_EQ(spec[0].imag(), T(0));
+
+        std::vector<T> back(n);
+        e_math::irfft(spec, back);
+        for (auto& v : back) v /= static_cast<T>(n);
+        std::vector<std::complex<T>> backc(back.begin(), back.end());
+        EXPECT_LT(rel_error(backc, xc), tolerance<T>(n)) << "n = " << n;
+    }
+}
+
+TEST(E_Fft, ComplexFloat) {
+    check_sizes<float>();
+}
+
+TEST(E_Fft, ComplexDouble) {
+    check_sizes<double>();
+}
+
+TEST(E_Fft, RoundtripLarge) {
+    for (std::size_t n : {1 << 16, 3 * 5 * 7 * 1024, 59049, 1 << 20}) {
+        check_roundtrip<float>(n);
+        check_roundtrip<double>(n);
+    }
+}
+
+TEST(E_Fft, Real) {
+    for (std::size_t n : {1, 2, 3, 4, 5, 6, 7, 8, 15, 16, 30, 64, 99, 100, 1000, 1024}) {
+        check_real<float>(n);
+        check_real<double>(n);
+    }
+}
+
+// 单频 信号 只落在 一个 频点
+TEST(E_Fft, SingleTone) {
+    const std::size_t n = 480;
+    const std::size_t f = 37;
+    std::vector<double> x(n);
+    for (std::size_t t = 0; t < n; ++t) x[t] = std::cos(2 * std::numbers::pi * static_cast<double>(f * t) / n);
+    std::vector<std::complex<double>> spec(n / 2 + 1);
+    e_math::rfft(x, spec);
+    for (std::size_t k = 0; k < spec.size(); ++k) {
+        EXPECT_NEAR(std::abs(spec[k]), k == f ? n / 2.0 : 0.0, 1e-9) << k;
+    }
+}
+
+TEST(E_Fft, InPlace) {
+    for (std::size_t n : {1, 8, 12, 60, 77, 1024}) {
+        const auto x = random_complex<double>(n, 9);
+        const auto plan = e_math::fft_plan<double>::cached(n);
+        std::vector<std::complex<double>> y(n);
+        plan->forward(x, y);
+        auto z = x;
+        plan->forward(z, z);
+        EXPECT_EQ(z, y) << n;
+        plan->inverse(z, z);
+        plan->inverse(y, y);
+        EXPECT_EQ(z, y) << n;
+    }
+}
+
+// 批量 与 逐个 变换 逐位相同，与 线程数 无关
+TEST(E_Fft, Batch) {
+    ThreadsGuard guard;
+    const std::size_t n = 1000;
+    const std::size_t count = 67;
+    const auto x = random_complex<float>(n * count, 5);
+    const auto xr = random_real<float>(n * count, 6);
+    const e_math::fft_plan<float> plan(n);
+    const e_math::rfft_plan<float> rplan(n);
+
+    std::vector<std::complex<float>> expected(n * count), expected_r(count * (n / 2 + 1));
+    for (std::size_t i = 0; i < count; ++i) {
+        plan.forward(std::span(x).subspan(i * n, n), std::span(expected).subspan(i * n, n));
+        rplan.forward(std::span(xr).subspan(i * n, n), std::span(expected_r).subspan(i * (n / 2 + 1), n / 2 + 1));
+    }
+
+    for (unsigned t : {1u, 3u, 8u}) {
+        e_math::set_max_threads(t);
+        std::vector<std::complex<float>> y(n * count), yr(count * (n / 2 + 1));
+        plan.forward(x, y, count);
+        EXPECT_EQ(y, expected) << t;
+        rplan.forward(xr, yr, count);
+        EXPECT_EQ(yr, expected_r) << t;
+
+        plan.inverse(y, y, count);
+        for (std::size_t i = 0; i < n * count; ++i) ASSERT_NEAR(std::abs(y[i] / float(n) - x[i]), 0.0f, 1e-5f) << i;
+        std::vector<float> back(n * count);
+        rplan.inverse(yr, back, count);
+        for (std::size_t i = 0; i < n * count; ++i) ASSERT_NEAR(back[i] / float(n), xr[i], 1e-5f) << i;
+    }
+}
+
+TEST(E_Fft, Cached) {
+    EXPECT_EQ(e_math::fft_plan<float>::cached(360), e_math::fft_plan<float>::cached(360));
+    EXPECT_EQ(e_math::rfft_plan<double>::cached(360), e_math::rfft_plan<double>::cached(360));
+    EXPECT_EQ(e_math::fft_plan<double>::cached(77)->size(), 77u);
+
+    // 用过 的 留在 缓存 里，最久 没用 的 被 淘汰；手里 的 plan 不受 影响
+    const auto kept = e_math::fft_plan<float>::cached(360);
+    const auto old = e_math::fft_plan<float>::cached(1000);
+    for (std::size_t n = 1; n < e_math::fft_plan_cache_size; ++n) {
+        EXPECT_EQ(e_math::fft_plan<float>::cached(360), kept);
+        e_math::fft_plan<float>::cached(5000 + n); // 别的 测试 没 用过 的 长度
+    }
+    EXPECT_EQ(e_math::fft_plan<float>::cached(360), kept);
+    EXPECT_NE(e_math::fft_plan<float>::cached(1000), old);
+    EXPECT_EQ(old->size(), 1000u);
+    std::vector<std::complex<float>> x(1000, 1.0f), y(1000);
+    old->forward(x, y);
+    EXPECT_EQ(y[0], std::complex<float>(1000.0f, 0.0f));
+
+    e_math::clear_fft_plan_cache();
+    EXPECT_NE(e_math::fft_plan<float>::cached(360), kept);
+    EXPECT_EQ(kept->size(), 360u);
+}
+
+TEST(E_Fft, Invalid) {
+    EXPECT_THROW(e_math::fft_plan<float>(0), std::invalid_argument);
+    EXPECT_THROW(e_math::rfft_plan<double>(0), std::invalid_argument);
+
+    const e_math::fft_plan<double> plan(8);
+    std::vector<std::complex<double>> a(8), b(7), c(16);
+    EXPECT_THROW(plan.forward(a, b), std::invalid_argument);
+    EXPECT_THROW(plan.forward(b, a), std::invalid_argument);
+    EXPECT_THROW(plan.forward(c, a, 2), std::invalid_argument);
+    EXPECT_THROW(e_math::fft(a, c), std::invalid_argument);
+
+    std::vector<double> r(8);
+    EXPECT_THROW(e_math::rfft(r, a), std::invalid_argument);
+    EXPECT_THROW(e_math::irfft(a, r), std::invalid_argument);
+
+    // 空输入 什么都不做
+    std::vector<std::complex<double>> empty;
+    EXPECT_NO_THROW(e_math::fft(empty, empty));
+}
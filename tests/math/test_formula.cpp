@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include "e_formula.hpp"
+#include "e_parallel.hpp"
+#include "e_vmath.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    // 跨越 单块 / 多块 / 不整除 的 行数
+    const std::size_t kSizes[] = {0, 1, 1023, 1024, 1025, 5000};
+
+    std::vector<double> random_values(std::size_t n, unsigned seed, double lo, double hi) {
+        std::mt19937_64 rng(seed);
+        std::uniform_real_distribution<double> dist(lo, hi);
+        std::vector<double> v(n);
+        for (auto& x : v) x = dist(rng);
+        return v;
+    }
+
+    std::string compile_error(const std::string& text) {
+        try {
+            e_math::formula f(text, {"x", "y"});
+        } catch (const std::invalid_argument& e) {
+            return e.what();
+        }
+        return "";
+    }
+
+    class ThreadsGuard {
+    public:
+        ~ThreadsGuard() { e_math::set_max_threads(0); }
+    };
+}
+
+TEST(E_Formula, ArithmeticMatchesLoop) {
+    const e_math::formula f("a + b * c - d / (a - 3) - -b", {"a", "b", "c", "d"});
+    for (std::size_t n : kSizes) {
+        const auto a = random_values(n, 1, -2, 2), b = random_values(n, 2, -2, 2);
+        const auto c = random_values(n, 3, -2, 2), d = random_values(n, 4, -2, 2);
+        std::vector<double> out(n);
+        f.evaluate({a, b, c, d}, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            double t = b[i] * c[i];
+            t = a[i] + t;
+            double u = a[i] - 3;
+            u = d[i] / u;
+            t = t - u;
+            EXPECT_EQ(out[i], t - (-b[i])) << i;
+        }
+    }
+}
+
+TEST(E_Formula, Functions) {
+    const std::size_t n = 3000;
+    const auto x = random_values(n, 5, 0.1, 5), y = random_values(n, 6, -3, 3);
+    std::vector<double> out(n), expect(n);
+
+    e_math::formula("exp(y)", {"x", "y"}).evaluate({x, y}, out);
+    e_math::exp(y, expect);
+    EXPECT_EQ(out, expect);
+
+    e_math::formula("sigmoid(x * y)", {"x", "y"}).evaluate({x, y}, out);
+    for (std::size_t i = 0; i < n; ++i) expect[i] = x[i] * y[i];
+    e_math::sigmoid(expect, expect);
+    EXPECT_EQ(out, expect);
+
+    e_math::formula("clamp(y, -1, 1) + sqrt(x) * abs(y) - min(x, y) + max(2, y)", {"x", "y"}).evaluate({x, y}, out);
+    for (std::size_t i = 0; i < n; ++i) {
+        double t = std::sqrt(x[i]) * std::fabs(y[i]);
+        t = std::clamp(y[i], -1.0, 1.0) + t;
+        t = t - std::min(x[i], y[i]);
+        EXPECT_EQ(out[i], t + std::max(2.0, y[i])) << i;
+    }
+
+    double logs[] = {1, 2, 10};
+    double sines[3];
+    e_math::formula("sin(log(v))", {"v"}).evaluate({std::span<const double>(logs)}, sines);
+    e_math::log(logs, logs);
+    e_math::sin(logs, logs);
+    EXPECT_EQ(std::vector<double>(sines, sines + 3), std::vector<double>(logs, logs + 3));
+}
+
+TEST(E_Formula, ConstantFolding) {
+    const std::vector<double> x = {1, 2, 3};
+    std::vector<double> out(3);
+
+    const e_math::formula f("(1 + 2) * 4 - x * (2 * 0.5 + exp(0))", {"x"});
+    EXPECT_EQ(f.instructions(), 2u);
+    f.evaluate({x}, out);
+    EXPECT_EQ(out, (std::vector<double>{10, 8, 6}));
+
+    const e_math::formula c("-(2 * 3) / 4", {"x"});
+    EXPECT_EQ(c.instructions(), 1u);
+    EXPECT_EQ(c.registers(), 0u);
+    c.evaluate({x}, out);
+    EXPECT_EQ(out, (std::vector<double>{-1.5, -1.5, -1.5}));
+
+    const e_math::formula id(" x ", {"x"});
+    id.evaluate({x}, out);
+    EXPECT_EQ(out, x);
+}
+
+TEST(E_Formula, CommonSubexpressions) {
+    const e_math::formula f("(a + b) * (b + a) + sqrt(a + b) * exp(a * b) / exp(b * a)", {"a", "b"});
+    // a + b、a * b、(a + b)^2、sqrt、exp、乘、除、加
+    EXPECT_EQ(f.instructions(), 8u);
+    EXPECT_LE(f.registers(), 3u);
+
+    const auto a = random_values(2000, 7, 0, 1), b = random_values(2000, 8, 0, 1);
+    std::vector<double> out(2000), e(2000);
+    for (std::size_t i = 0; i < e.size(); ++i) e[i] = a[i] * b[i];
+    e_math::exp(e, e);
+    f.evaluate({a, b}, out);
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        const double s = a[i] + b[i];
+        EXPECT_EQ(out[i], s * s + std::sqrt(s) * e[i] / e[i]) << i;
+    }
+}
+
+TEST(E_Formula, InPlaceAndParallel) {
+    ThreadsGuard guard;
+    const std::size_t n = 200003;
+    auto x = random_values(n, 9, -10, 10);
+    const auto y = random_values(n, 10, -10, 10);
+    const e_math::formula f("max(x * y - 1, x / (y * y + 1))", {"x", "y"});
+
+    std::vector<double> seq(n), par(n);
+    f.evaluate({x, y}, seq);
+    for (unsigned threads : {1u, 2u, 5u}) {
+        e_math::set_max_threads(threads);
+        std::fill(par.begin(), par.end(), 0.0);
+        f.evaluate({x, y}, par, e_math::execution::parallel);
+        EXPECT_EQ(par, seq) << threads;
+    }
+
+    f.evaluate({x, y}, x);
+    EXPECT_EQ(x, seq);
+}
+
+TEST(E_Formula, Errors) {
+    EXPECT_EQ(compile_error("x +"), "e_math::formula: unexpected end of formula at 3");
+    EXPECT_EQ(compile_error("x + z"), "e_math::formula: unknown column 'z' at 4");
+    EXPECT_EQ(compile_error("foo(x)"), "e_math::formula: unknown function 'foo' at 0");
+    EXPECT_EQ(compile_error("min(x)"), "e_math::formula: min takes 2 argument(s) at 0");
+    EXPECT_EQ(compile_error("(x + y"), "e_math::formula: expected ')' at 6");
+    EXPECT_EQ(compile_error("x y"), "e_math::formula: unexpected character at 2");
+    EXPECT_EQ(compile_error("2e"), "e_math::formula: unexpected character at 1");
+    EXPECT_EQ(compile_error("x # y"), "e_math::formula: unexpected character at 2");
+    EXPECT_EQ(compile_error(""), "e_math::formula: unexpected end of formula at 0");
+    EXPECT_NE(compile_error(std::string(10000, '(') + "x" + std::string(10000, ')')), "");
+    EXPECT_NE(compile_error(std::string(10000, '-') + "x"), "");
+
+    const e_math::formula f("x * y", {"x", "y"});
+    std::vector<double> a(4), b(5), out(4);
+    EXPECT_THROW(f.evaluate({a, b}, out), std::invalid_argument);
+    EXPECT_THROW(f.evaluate({a}, out), std::invalid_argument);
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include "e_gemm.hpp"
+#include "e_parallel.hpp"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using e_math::layout;
+using e_math::matrix_view;
+
+namespace {
+    // 按 逻辑坐标 存取的 矩阵，ld 可以比 最小值 大，用来测 子矩阵 / 两种主序
+    template <class T>
+    struct matrix {
+        std::size_t rows;
+        std::size_t cols;
+        std::size_t ld;
+        layout order;
+        std::vector<T> data;
+
+        matrix(std::size_t r, std::size_t c, layout o, std::size_t pad = 0)
+            : rows(r), cols(c), ld((o == layout::row_major ? c : r) + pad), order(o),
+              data(ld * (o == layout::row_major ? r : c) + 1) {}
+
+        T& operator()(std::size_t i, std::size_t j) { return order == layout::row_major ? data[i * ld + j] : data[j * ld + i]; }
+
+        matrix_view<T> view() { return {data.data(), rows, cols, ld, order}; }
+    };
+
+    template <class T>
+    matrix<T> random_matrix(std::size_t r, std::size_t c, layout o, std::size_t pad, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<T> dist(-1, 1);
+        matrix<T> m(r, c, o, pad);
+        for (auto& x : m.data) x = dist(rng);
+        return m;
+    }
+
+    // C = alpha * A * B + beta * C，与 gemm 比较
+    template <class T>
+    void check_gemm(std::size_t m, std::size_t n, std::size_t k, layout la, layout lb, layout lc, T alpha, T beta, std::size_t pad = 0) {
+        auto a = random_matrix<T>(m, k, la, pad, 1);
+        auto b = random_matrix<T>(k, n, lb, pad, 2);
+        auto c = random_matrix<T>(m, n, lc, pad, 3);
+        auto expected = c;
+        for (std::size_t i = 0; i < m; ++i) {
+            for (std::size_t j = 0; j < n; ++j) {
+                long double s = 0;
+                for (std::size_t p = 0; p < k; ++p) s += static_cast<long double>(a(i, p)) * b(p, j);
+                expected(i, j) = static_cast<T>(alpha * s + (beta == 0 ? 0 : beta * static_cast<long double>(c(i, j))));
+            }
+        }
+
+        e_math::gemm(a.view(), b.view(), c.view(), alpha, beta);
+
+        const double tol = std::numeric_limits<T>::epsilon() * 4 * static_cast<double>(k + 1);
+        for (std::size_t i = 0; i < m; ++i) {
+            for (std::size_t j = 0; j < n; ++j) {
+                ASSERT_NEAR(c(i, j), expected(i, j), tol) << m << "x" << n << "x" << k << " at " << i << "," << j;
+            }
+        }
+        // ld 留出的 空隙 和 末尾 哨兵 不能被写
+        EXPECT_EQ(c.data, [&] {
+            auto d = expected.data;
+            for (std::size_t i = 0; i < m; ++i) {
+                for (std::size_t j = 0; j < n; ++j) {
+                    (lc == layout::row_major ? d[i * c.ld + j] : d[j * c.ld + i]) = c(i, j);
+                }
+            }
+            return d;
+        }());
+    }
+
+    class ThreadsGuard {
+    public:
+        ~ThreadsGuard() { e_math::set_max_threads(0); }
+    };
+}
+
+// 边缘 不足 mr / nr 的 各种尺寸，以及 跨越 k 分块（256）的 长度
+TEST(E_Gemm, Sizes) {
+    const std::size_t dims[][3] = {{1, 1, 1}, {5, 7, 3}, {6, 16, 8}, {13, 33, 17}, {64, 64, 64}, {97, 65, 300}, {200, 3, 513}};
+    for (auto& d : dims) {
+        check_gemm<float>(d[0], d[1], d[2], layout::row_major, layout::row_major, layout::row_major, 1.0f, 0.0f);
+        check_gemm<double>(d[0], d[1], d[2], layout::row_major, layout::row_major, layout::row_major, 1.0, 0.0);
+    }
+}
+
+TEST(E_Gemm, LayoutsAndStrides) {
+    const layout both[] = {layout::row_major, layout::col_major};
+    for (layout la : both) {
+        for (layout lb : both) {
+            for (layout lc : both) {
+                check_gemm<float>(37, 41, 29, la, lb, lc, 1.0f, 0.0f, 0);
+                check_gemm<double>(37, 41, 29, la, lb, lc, 1.0, 0.0, 5);
+            }
+        }
+    }
+}
+
+TEST(E_Gemm, AlphaBeta) {
+    check_gemm<float>(50, 70, 90, layout::row_major, layout::row_major, layout::row_major, 2.0f, 0.5f);
+    check_gemm<double>(50, 70, 300, layout::col_major, layout::row_major, layout::col_major, -1.0, 1.0);
+    check_gemm<double>(30, 40, 0, layout::row_major, layout::row_major, layout::row_major, 1.0, 3.0);
+    check_gemm<float>(30, 40, 20, layout::row_major, layout::row_major, layout::row_major, 0.0f, 2.0f);
+}
+
+// beta == 0 时 不读 C
+TEST(E_Gemm, BetaZeroIgnoresC) {
+    std::vector<float> a(4 * 3, 1.0f), b(3 * 5, 2.0f), c(4 * 5, std::numeric_limits<float>::quiet_NaN());
+    e_math::gemm(matrix_view<const float>{a.data(), 4, 3, 3}, matrix_view<const float>{b.data(), 3, 5, 5}, matrix_view<float>{c.data(), 4, 5, 5});
+    for (float x : c) EXPECT_EQ(x, 6.0f);
+}
+
+// 子矩阵：直接 用 原矩阵的 ld
+TEST(E_Gemm, Submatrix) {
+    auto big = random_matrix<double>(20, 30, layout::row_major, 0, 7);
+    matrix_view<const double> a{&big(2, 3), 8, 5, big.ld};
+    matrix_view<const double> b{&big(10, 20), 5, 6, big.ld};
+    std::vector<double> c(8 * 6);
+    e_math::gemm(a, b, matrix_view<double>{c.data(), 8, 6, 6});
+    for (std::size_t i = 0; i < 8; ++i) {
+        for (std::size_t j = 0; j < 6; ++j) {
+            double s = 0;
+            for (std::size_t p = 0; p < 5; ++p) s += big(2 + i, 3 + p) * big(10 + p, 20 + j);
+            EXPECT_NEAR(c[i * 6 + j], s, 1e-12);
+        }
+    }
+}
+
+TEST(E_Gemm, Threads) {
+    ThreadsGuard guard;
+    for (unsigned t : {1u, 2u, 3u, 8u}) {
+        e_math::set_max_threads(t);
+        check_gemm<float>(300, 260, 270, layout::row_major, layout::col_major, layout::row_major, 1.0f, 0.0f);
+        check_gemm<double>(10, 600, 400, layout::row_major, layout::row_major, layout::col_major, 1.0, 0.0);
+    }
+}
+
+TEST(E_Gemm, Invalid) {
+    std::vector<float> buf(100);
+    matrix_view<const float> a{buf.data(), 4, 3, 3};
+    matrix_view<const float> b{buf.data(), 3, 5, 5};
+    EXPECT_THROW(e_math::gemm(a, a, matrix_view<float>{buf.data(), 4, 3, 3}), std::invalid_argument);
+    EXPECT_THROW(e_math::gemm(a, b, matrix_view<float>{buf.data(), 4, 4, 4}), std::invalid_argument);
+    EXPECT_THROW(e_math::gemm(a, b, matrix_view<float>{buf.data(), 4, 5, 4}), std::invalid_argument);
+    EXPECT_THROW(e_math::gemm(matrix_view<const float>{buf.data(), 4, 3, 3, layout::col_major}, b, matrix_view<float>{buf.data(), 4, 5, 5}), std::invalid_argument);
+    EXPECT_NO_THROW(e_math::gemm(matrix_view<const float>{buf.data(), 0, 3, 0}, b, matrix_view<float>{buf.data(), 0, 5, 0}));
+}
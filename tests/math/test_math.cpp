@@ -2,7 +2,59 @@
 
 #include "e_math.hpp"
 
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 TEST(E_Math, Add) {
     EXPECT_EQ(e_math::add(1, 2), 3); 
     EXPECT_EQ(e_math::add(-1, 1), 0);
-}
\ No newline at end of file
+}
+
+template <class T>
+static void check_batch_add() {
+    // 覆盖 各指令集 的 整块 和 尾部
+    for (std::size_t n : {0, 1, 3, 7, 8, 15, 16, 17, 33, 100, 1027}) {
+        std::vector<T> a(n), b(n), out(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            a[i] = static_cast<T>(i * 3);
+            b[i] = static_cast<T>(100 - static_cast<int>(i));
+        }
+
+        e_math::add(std::span<const T>(a), std::span<const T>(b), std::span<T>(out));
+        for (std::size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(out[i], static_cast<T>(a[i] + b[i])) << "n = " << n << ", i = " << i;
+        }
+
+        // 原地
+        e_math::add(std::span<const T>(a), std::span<const T>(b), std::span<T>(a));
+        EXPECT_EQ(a, out);
+    }
+}
+
+TEST(E_Math, BatchAdd) {
+    check_batch_add<std::int32_t>();
+    check_batch_add<std::int64_t>();
+    check_batch_add<float>();
+    check_batch_add<double>();
+}
+
+TEST(E_Math, BatchAddWraps) {
+    std::vector<std::int32_t> a(20, std::numeric_limits<std::int32_t>::max()), b(20, 1), out(20);
+    e_math::add(std::span<const std::int32_t>(a), std::span<const std::int32_t>(b), std::span<std::int32_t>(out));
+    for (auto v : out) {
+        EXPECT_EQ(v, std::numeric_limits<std::int32_t>::min());
+    }
+}
+
+TEST(E_Math, BatchAddSizeMismatch) {
+    std::vector<double> a(4), b(5), out(4);
+    EXPECT_THROW(e_math::add(std::span<const double>(a), std::span<const double>(b), std::span<double>(out)), std::invalid_argument);
+}
+
+TEST(E_Math, SimdIsa) {
+    std::string isa = e_math::simd_isa();
+    EXPECT_TRUE(isa == "scalar" || isa == "sse2" || isa == "avx2" || isa == "avx512");
+}
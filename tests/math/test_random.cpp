@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+
+#include "e_random.hpp"
+#include "e_stats.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+using e_math::philox4x32;
+using e_math::xoshiro256pp;
+
+// 参考实现（Vigna）从 状态 {1, 2, 3, 4} 出发 的 前几个 输出
+TEST(E_Random, XoshiroReference) {
+    xoshiro256pp g(std::array<std::uint64_t, 4>{1, 2, 3, 4});
+    EXPECT_EQ(g(), 41943041u);
+    EXPECT_EQ(g(), 58720359u);
+    EXPECT_EQ(g(), 3588806011781223u);
+    EXPECT_EQ(g(), 3591011842654386u);
+
+    EXPECT_THROW(xoshiro256pp(std::array<std::uint64_t, 4>{}), std::invalid_argument);
+}
+
+// Random123 的 已知答案
+TEST(E_Random, PhiloxReference) {
+    using block = std::array<std::uint32_t, 4>;
+    EXPECT_EQ(philox4x32::block({0, 0, 0, 0}, {0, 0}), (block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+    EXPECT_EQ(philox4x32::block({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff}),
+              (block{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+    EXPECT_EQ(philox4x32::block({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0}),
+              (block{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+TEST(E_Random, XoshiroJumpStreams) {
+    xoshiro256pp a(7), b(7);
+    a();
+    b.fill(std::span<std::uint64_t>());
+    b();
+    EXPECT_EQ(a.state(), b.state());
+
+    // stream(seed, i) 等于 jump i 次
+    xoshiro256pp c(7);
+    c.jump();
+    c.jump();
+    EXPECT_EQ(xoshiro256pp::stream(7, 2).state(), c.state());
+
+    // 各段 的 开头 互不相同
+    std::set<std::uint64_t> first;
+    for (std::uint64_t i = 0; i < 16; ++i) first.insert(xoshiro256pp::stream(7, i)());
+    EXPECT_EQ(first.size(), 16u);
+
+    xoshiro256pp d(7), e(7);
+    d.long_jump();
+    EXPECT_NE(d.state(), e.state());
+}
+
+// 批量 fill 与 逐个 调用 完全一致，跨越 块 边界 也一样
+TEST(E_Random, FillMatchesSequential) {
+    for (std::size_t n : {0, 1, 3, 4, 5, 31, 64, 1000}) {
+        philox4x32 a(42, 3), b(42, 3);
+        a();
+        b();
+        std::vector<std::uint32_t> got(n);
+        a.fill(got);
+        for (std::size_t i = 0; i < n; ++i) ASSERT_EQ(got[i], b()) << n << " " << i;
+        EXPECT_EQ(a(), b());
+
+        xoshiro256pp x(42), y(42);
+        std::vector<std::uint64_t> got64(n);
+        x.fill(got64);
+        for (std::size_t i = 0; i < n; ++i) ASSERT_EQ(got64[i], y()) << n << " " << i;
+    }
+}
+
+TEST(E_Random, PhiloxDiscardAndStreams) {
+    for (std::uint64_t skip : {0, 1, 3, 4, 7, 1000, 1001}) {
+        philox4x32 a(9), b(9);
+        a();
+        b();
+        a.discard(skip);
+        for (std::uint64_t i = 0; i < skip; ++i) b();
+        for (int i = 0; i < 10; ++i) ASSERT_EQ(a(), b()) << skip;
+    }
+
+    // 第 i 个 输出 = 第 i / 4 块 的 第 i % 4 个 字
+    philox4x32 g(0x123456789abcdefull, 5);
+    g.discard(4 * 1000 + 2);
+    auto blk = philox4x32::block({1000, 0, 5, 0}, {0x89abcdef, 0x01234567});
+    EXPECT_EQ(g(), blk[2]);
+    EXPECT_EQ(g(), blk[3]);
+
+    philox4x32 s0(1, 0), s1(1, 1);
+    EXPECT_NE(s0(), s1());
+}
+
+TEST(E_Random, UniformBits) {
+    philox4x32 g(11), ref(11);
+    std::vector<float> f(1001);
+    e_math::fill_uniform(g, std::span<float>(f));
+    for (float x : f) ASSERT_EQ(x, static_cast<float>(ref() >> 8) * 0x1p-24f);
+
+    std::vector<double> d(777);
+    e_math::fill_uniform(g, std::span<double>(d), -2.0, 3.0);
+    for (double x : d) {
+        std::uint64_t lo = ref(), hi = ref();
+        ASSERT_EQ(x, -2.0 + 5.0 * (static_cast<double>(((hi << 32) | lo) >> 11) * 0x1p-53));
+    }
+
+    xoshiro256pp x(11), xr(11);
+    std::vector<double> xd(100);
+    e_math::fill_uniform(x, std::span<double>(xd));
+    for (double v : xd) ASSERT_EQ(v, static_cast<double>(xr() >> 11) * 0x1p-53);
+}
+
+namespace {
+    // 样本 均值 / 方差 在 理论值 附近（约 6 个 标准误差 以内）
+    template <class T>
+    void check_moments(const std::vector<T>& v, double mean, double variance, double fourth_central) {
+        e_math::moments m;
+        m.add(std::span<const T>(v));
+        const double n = static_cast<double>(v.size());
+        EXPECT_NEAR(m.mean(), mean, 6 * std::sqrt(variance / n));
+        EXPECT_NEAR(m.variance(), variance, 6 * std::sqrt((fourth_central - variance * variance) / n));
+    }
+
+    template <class G, class T>
+    void check_distributions(G g) {
+        const std::size_t n = 1000001; // 奇数：覆盖 Box-Muller 的 最后 半对
+        std::vector<T> v(n);
+
+        e_math::fill_uniform(g, std::span<T>(v), T(-1), T(3));
+        check_moments(v, 1.0, 16.0 / 12.0, 16.0 * 16.0 / 80.0);
+        for (T x : v) ASSERT_TRUE(x >= T(-1) && x < T(3));
+
+        e_math::fill_normal(g, std::span<T>(v), T(2), T(3));
+        check_moments(v, 2.0, 9.0, 3 * 81.0);
+        for (T x : v) ASSERT_TRUE(std::isfinite(x));
+
+        e_math::fill_exponential(g, std::span<T>(v), T(4));
+        check_moments(v, 0.25, 1.0 / 16, 9.0 / 256);
+        for (T x : v) ASSERT_TRUE(x >= 0 && std::isfinite(x));
+    }
+}
+
+TEST(E_Random, Distributions) {
+    check_distributions<xoshiro256pp, float>(xoshiro256pp(1));
+    check_distributions<xoshiro256pp, double>(xoshiro256pp(2));
+    check_distributions<philox4x32, float>(philox4x32(3));
+    check_distributions<philox4x32, double>(philox4x32(4, 1));
+}
+
+// [lo, hi) 不含 hi：hi - lo 比 lo 的 精度 小 时 lo + (hi - lo) * u 经常 舍入 到 hi
+template <class G, class T>
+static void check_uniform_below_hi(G g, T lo, T hi) {
+    std::vector<T> v(100000);
+    e_math::fill_uniform(g, std::span<T>(v), lo, hi);
+    T top = lo;
+    for (T x : v) {
+        ASSERT_GE(x, lo);
+        ASSERT_LT(x, hi);
+        top = std::max(top, x);
+    }
+    EXPECT_EQ(top, std::nextafter(hi, lo));
+}
+
+TEST(E_Random, UniformExcludesHi) {
+    check_uniform_below_hi(xoshiro256pp(5), 1e6f, 1e6f + 1);
+    check_uniform_below_hi(philox4x32(6), 1e6f, 1e6f + 1);
+    check_uniform_below_hi(xoshiro256pp(7), 1e15, 1e15 + 1);
+    check_uniform_below_hi(philox4x32(8), 1e15, 1e15 + 1);
+}
+
+// 可复现：同一 种子 两次 结果 相同
+TEST(E_Random, Reproducible) {
+    std::vector<double> a(5000), b(5000);
+    philox4x32 g1(99, 7), g2(99, 7);
+    e_math::fill_normal(g1, std::span<double>(a));
+    e_math::fill_normal(g2, std::span<double>(b));
+    EXPECT_EQ(a, b);
+}
+
+// 可以 直接 用于 <random> 的 分布
+TEST(E_Random, StdCompatible) {
+    xoshiro256pp g(5);
+    std::uniform_int_distribution<int> dist(1, 6);
+    for (int i = 0; i < 100; ++i) {
+        int x = dist(g);
+        EXPECT_TRUE(x >= 1 && x <= 6);
+    }
+    philox4x32 p(5);
+    std::bernoulli_distribution coin(0.5);
+    (void)coin(p);
+}
@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+
+#include "e_parallel.hpp"
+#include "e_reduce.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#endif
+
+namespace {
+    // 跨越 单块 / 多块 / 不整除 的 长度
+    const std::size_t kSizes[] = {1, 2, 15, 16, 17, 1000, 16384, 16385, 100000, 300007};
+
+    template <class T>
+    std::vector<T> random_values(std::size_t n, unsigned seed) {
+        std::mt19937_64 rng(seed);
+        std::vector<T> v(n);
+        for (auto& x : v) {
+            if constexpr (std::is_floating_point_v<T>) {
+                x = static_cast<T>(std::uniform_real_distribution<double>(-1000.0, 1000.0)(rng));
+            } else {
+                x = static_cast<T>(std::uniform_int_distribution<std::int64_t>(-1000000, 1000000)(rng));
+            }
+        }
+        return v;
+    }
+
+    class ThreadsGuard {
+    public:
+        ~ThreadsGuard() { e_math::set_max_threads(0); }
+    };
+
+    // 浮点 sum / dot 的 结果 位 串成 十六进制，用来 比较 不同 指令集 的 子进程
+    std::string reduce_fingerprint() {
+        std::string s;
+        char buf[24];
+        for (std::size_t n : kSizes) {
+            auto a = random_values<float>(n, 11);
+            auto b = random_values<float>(n, 12);
+            auto c = random_values<double>(n, 13);
+            auto d = random_values<double>(n, 14);
+            std::snprintf(buf, sizeof(buf), "%08x ", std::bit_cast<std::uint32_t>(e_math::reduce_sum(std::span<const float>(a))));
+            s += buf;
+            std::snprintf(buf, sizeof(buf), "%08x ", std::bit_cast<std::uint32_t>(e_math::reduce_dot(std::span<const float>(a), std::span<const float>(b))));
+            s += buf;
+            std::snprintf(buf, sizeof(buf), "%016llx ", static_cast<unsigned long long>(std::bit_cast<std::uint64_t>(e_math::reduce_sum(std::span<const double>(c)))));
+            s += buf;
+            std::snprintf(buf, sizeof(buf), "%016llx\n", static_cast<unsigned long long>(std::bit_cast<std::uint64_t>(e_math::reduce_dot(std::span<const double>(c), std::span<const double>(d)))));
+            s += buf;
+        }
+        return s;
+    }
+
+    std::string executable_path() {
+#if defined(_WIN32)
+        char buf[MAX_PATH];
+        const DWORD n = GetModuleFileNameA(nullptr, buf, MAX_PATH);
+        return n == 0 || n == MAX_PATH ? std::string() : std::string(buf, n);
+#else
+        std::error_code ec;
+        const auto p = std::filesystem::read_symlink("/proc/self/exe", ec);
+        return ec ? std::string() : p.string();
+#endif
+    }
+
+    // value 为 nullptr 时 删除
+    void set_env(const char* name, const char* value) {
+#if defined(_WIN32)
+        _putenv_s(name, value != nullptr ? value : "");
+#else
+        if (value != nullptr) {
+            setenv(name, value, 1);
+        } else {
+            unsetenv(name);
+        }
+#endif
+    }
+}
+
+template <class T>
+static void check_against_reference() {
+    for (std::size_t n : kSizes) {
+        auto v = random_values<T>(n, static_cast<unsigned>(n));
+        auto w = random_values<T>(n, static_cast<unsigned>(n + 1));
+
+        EXPECT_EQ(e_math::reduce_min(std::span<const T>(v)), *std::min_element(v.begin(), v.end()));
+        EXPECT_EQ(e_math::reduce_max(std::span<const T>(v)), *std::max_element(v.begin(), v.end()));
+
+        if constexpr (std::is_floating_point_v<T>) {
+            long double sum = 0, dot = 0, abs_sum = 0, abs_dot = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += v[i];
+                abs_sum += std::fabs(v[i]);
+                dot += static_cast<long double>(v[i]) * w[i];
+                abs_dot += std::fabs(static_cast<long double>(v[i]) * w[i]);
+            }
+            // 补偿求和 的 误差 与 n 基本无关
+            const double eps = std::numeric_limits<T>::epsilon() * 4;
+            EXPECT_NEAR(e_math::reduce_sum(std::span<const T>(v)), static_cast<double>(sum), eps * static_cast<double>(abs_sum)) << n;
+            EXPECT_NEAR(e_math::reduce_dot(std::span<const T>(v), std::span<const T>(w)), static_cast<double>(dot), eps * static_cast<double>(abs_dot)) << n;
+        } else {
+            std::int64_t sum = 0;
+            for (auto x : v) {
+                sum += x;
+            }
+            EXPECT_EQ(e_math::reduce_sum(std::span<const T>(v)), sum);
+        }
+    }
+}
+
+TEST(E_Reduce, MatchesScalarReference) {
+    check_against_reference<std::int32_t>();
+    check_against_reference<std::int64_t>();
+    check_against_reference<float>();
+    check_against_reference<double>();
+}
+
+TEST(E_Reduce, BitwiseReproducibleAcrossThreadCounts) {
+    ThreadsGuard guard;
+    auto v = random_values<double>(1000003, 7);
+    auto w = random_values<double>(1000003, 8);
+    auto f = random_values<float>(1000003, 9);
+
+    e_math::set_max_threads(1);
+    double sum1 = e_math::reduce_sum(std::span<const double>(v));
+    double dot1 = e_math::reduce_dot(std::span<const double>(v), std::span<const double>(w));
+    float fsum1 = e_math::reduce_sum(std::span<const float>(f));
+
+    for (unsigned threads : {2u, 3u, 8u}) {
+        e_math::set_max_threads(threads);
+        EXPECT_EQ(e_math::reduce_sum(std::span<const double>(v)), sum1) << threads;
+        EXPECT_EQ(e_math::reduce_dot(std::span<const double>(v), std::span<const double>(w)), dot1) << threads;
+        EXPECT_EQ(e_math::reduce_sum(std::span<const float>(f)), fsum1) << threads;
+    }
+}
+
+TEST(E_Reduce, NaNPropagates) {
+    std::vector<double> v(50000, 1.0);
+    v[30000] = std::numeric_limits<double>::quiet_NaN();
+    EXPECT_TRUE(std::isnan(e_math::reduce_min(std::span<const double>(v))));
+    EXPECT_TRUE(std::isnan(e_math::reduce_max(std::span<const double>(v))));
+}
+
+TEST(E_Reduce, EmptyInput) {
+    std::vector<float> v;
+    EXPECT_EQ(e_math::reduce_sum(std::span<const float>(v)), 0.0f);
+    EXPECT_THROW(e_math::reduce_min(std::span<const float>(v)), std::invalid_argument);
+    EXPECT_THROW(e_math::reduce_max(std::span<const float>(v)), std::invalid_argument);
+
+    std::vector<float> w(1);
+    EXPECT_THROW(e_math::reduce_dot(std::span<const float>(v), std::span<const float>(w)), std::invalid_argument);
+}
+
+// 内核 在 启动 时 按 E_MATH_SIMD 选定，所以 每个 指令集 起 一个 子进程（还是 这个 测试 程序）算 一遍
+TEST(E_Reduce, BitwiseReproducibleAcrossSimdLevels) {
+    if (const char* out = std::getenv("E_REDUCE_FINGERPRINT_OUT")) {
+        std::ofstream(out, std::ios::binary) << reduce_fingerprint();
+        return;
+    }
+    const std::string self = executable_path();
+    if (self.empty()) {
+        GTEST_SKIP() << "cannot locate the test executable";
+    }
+
+    const char* saved = std::getenv("E_MATH_SIMD");
+    const std::string saved_simd = saved != nullptr ? saved : "";
+    const auto file = std::filesystem::temp_directory_path() / ("e_reduce_fingerprint_" + std::to_string(std::random_device{}()) + ".txt");
+    set_env("E_REDUCE_FINGERPRINT_OUT", file.string().c_str());
+
+    std::string expected;
+    for (const char* level : {"scalar", "sse2", "avx2", "avx512"}) {
+        set_env("E_MATH_SIMD", level);
+#if defined(_WIN32)
+        const std::string command = "\"\"" + self + "\" --gtest_filter=E_Reduce.BitwiseReproducibleAcrossSimdLevels > NUL\"";
+#else
+        const std::string command = "'" + self + "' --gtest_filter=E_Reduce.BitwiseReproducibleAcrossSimdLevels > /dev/null";
+#endif
+        ASSERT_EQ(std::system(command.c_str()), 0) << level;
+        std::ifstream in(file, std::ios::binary);
+        const std::string got((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        ASSERT_FALSE(got.empty()) << level;
+        if (expected.empty()) {
+            expected = got;
+        }
+        EXPECT_EQ(got, expected) << level; // 超过 CPU 的 级别 会 被 压到 CPU 支持 的 最高 级别
+    }
+
+    set_env("E_REDUCE_FINGERPRINT_OUT", nullptr);
+    set_env("E_MATH_SIMD", saved != nullptr ? saved_simd.c_str() : nullptr);
+    std::filesystem::remove(file);
+}
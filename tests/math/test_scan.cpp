@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include "e_parallel.hpp"
+#include "e_scan.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    const std::size_t kSizes[] = {0, 1, 5, 16, 17, 33, 16384, 16385, 100003};
+
+    template <class T>
+    std::vector<T> make_input(std::size_t n) {
+        std::vector<T> v(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            v[i] = static_cast<T>(static_cast<int>(i % 7) - 2);
+        }
+        return v;
+    }
+}
+
+template <class T>
+static void check_scan() {
+    for (std::size_t n : kSizes) {
+        auto in = make_input<T>(n);
+
+        std::vector<T> expect(n), out(n);
+        std::inclusive_scan(in.begin(), in.end(), expect.begin());
+        e_math::inclusive_scan(std::span<const T>(in), std::span<T>(out));
+        EXPECT_EQ(out, expect) << "inclusive, n = " << n;
+
+        std::exclusive_scan(in.begin(), in.end(), expect.begin(), T(10));
+        e_math::exclusive_scan(std::span<const T>(in), std::span<T>(out), T(10));
+        EXPECT_EQ(out, expect) << "exclusive, n = " << n;
+
+        // 原地
+        auto inplace = in;
+        e_math::exclusive_scan(std::span<const T>(inplace), std::span<T>(inplace), T(10));
+        EXPECT_EQ(inplace, expect) << "in place, n = " << n;
+    }
+}
+
+// 输入都是 小整数，浮点 也应当 精确
+TEST(E_Scan, MatchesStd) {
+    check_scan<std::int32_t>();
+    check_scan<std::int64_t>();
+    check_scan<float>();
+    check_scan<double>();
+}
+
+TEST(E_Scan, IntegerWraps) {
+    std::vector<std::int32_t> in(40, std::numeric_limits<std::int32_t>::max()), out(40);
+    e_math::inclusive_scan(std::span<const std::int32_t>(in), std::span<std::int32_t>(out));
+    EXPECT_EQ(out[1], -2);
+}
+
+TEST(E_Scan, IndependentOfThreadCount) {
+    std::vector<double> in(200001);
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        in[i] = std::sin(static_cast<double>(i)) * 1e3;
+    }
+
+    std::vector<double> ref(in.size()), out(in.size());
+    e_math::set_max_threads(1);
+    e_math::inclusive_scan(std::span<const double>(in), std::span<double>(ref));
+    for (unsigned threads : {2u, 5u}) {
+        e_math::set_max_threads(threads);
+        e_math::inclusive_scan(std::span<const double>(in), std::span<double>(out));
+        EXPECT_EQ(out, ref) << threads;
+    }
+    e_math::set_max_threads(0);
+
+    // 与 串行 long double 参考值 的 误差
+    long double s = 0;
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        s += in[i];
+        EXPECT_NEAR(ref[i], static_cast<double>(s), 1e-6) << i;
+    }
+}
+
+TEST(E_Scan, SizeMismatch) {
+    std::vector<float> in(3), out(4);
+    EXPECT_THROW(e_math::inclusive_scan(std::span<const float>(in), std::span<float>(out)), std::invalid_argument);
+}
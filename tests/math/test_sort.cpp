@@ -0,0 +1,298 @@
+#include <gtest/gtest.h>
+
+#include "e_parallel.hpp"
+#include "e_sort.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// 检查 scratch 版本 不分配 内存：替换 全套 全局 分配 函数（普通 / 数组 / nothrow / 对齐），都 转给 malloc / free，
+// 只 统计 打开了 计数 的 线程 上 的 分配
+// Windows 上 DLL 里 的 分配 不经过 exe 的 operator new，不 替换，测试 跳过
+#if !defined(_WIN32)
+    #define E_SORT_TEST_COUNTS_ALLOCATIONS 1
+
+namespace {
+    std::atomic<std::size_t> g_allocations{0};
+    thread_local bool t_counting = false;
+
+    void* counted_alloc(std::size_t size, std::size_t align) noexcept {
+        if (t_counting) {
+            g_allocations.fetch_add(1, std::memory_order_relaxed);
+        }
+        size = size == 0 ? 1 : size;
+        if (align <= alignof(std::max_align_t)) {
+            return std::malloc(size);
+        }
+        void* p = nullptr;
+        return posix_memalign(&p, std::max(align, sizeof(void*)), size) == 0 ? p : nullptr;
+    }
+
+    void* counted_alloc_or_throw(std::size_t size, std::size_t align) {
+        if (void* p = counted_alloc(size, align)) {
+            return p;
+        }
+        throw std::bad_alloc();
+    }
+
+    // 打开 当前 线程 的 计数，返回 析构 时 关掉
+    class CountAllocations {
+    public:
+        CountAllocations() : before_(g_allocations.load()) { t_counting = true; }
+        ~CountAllocations() { t_counting = false; }
+        std::size_t count() const { return g_allocations.load() - before_; }
+
+    private:
+        std::size_t before_;
+    };
+}
+
+// GCC 把 下面 的 delete 内联 到 new 的 调用处 后，会 报 -Wmismatched-new-delete 误报
+    #if defined(__GNUC__) && !defined(__clang__)
+        #pragma GCC diagnostic push
+        #pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+    #endif
+
+void* operator new(std::size_t size) { return counted_alloc_or_throw(size, 0); }
+void* operator new[](std::size_t size) { return counted_alloc_or_throw(size, 0); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return counted_alloc(size, 0); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return counted_alloc(size, 0); }
+void* operator new(std::size_t size, std::align_val_t align) { return counted_alloc_or_throw(size, static_cast<std::size_t>(align)); }
+void* operator new[](std::size_t size, std::align_val_t align) { return counted_alloc_or_throw(size, static_cast<std::size_t>(align)); }
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept { return counted_alloc(size, static_cast<std::size_t>(align)); }
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept { return counted_alloc(size, static_cast<std::size_t>(align)); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+
+    #if defined(__GNUC__) && !defined(__clang__)
+        #pragma GCC diagnostic pop
+    #endif
+#endif
+
+namespace {
+    class ThreadsGuard {
+    public:
+        ~ThreadsGuard() { e_math::set_max_threads(0); }
+    };
+
+    // 与 基数排序 相同的 全序：-0 < +0
+    template <class T>
+    bool less(T a, T b) {
+        if constexpr (std::is_floating_point_v<T>) {
+            if (a == 0 && b == 0) {
+                return std::signbit(a) && !std::signbit(b);
+            }
+        }
+        return a < b;
+    }
+
+    template <class T>
+    std::vector<T> make_keys(std::size_t n, int kind, unsigned seed) {
+        std::mt19937_64 rng(seed);
+        std::vector<T> v(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            std::uint64_t r = rng();
+            switch (kind) {
+                case 0: // 全范围
+                    if constexpr (std::is_floating_point_v<T>) {
+                        v[i] = static_cast<T>(std::uniform_real_distribution<double>(-1e6, 1e6)(rng));
+                    } else {
+                        v[i] = static_cast<T>(r);
+                    }
+                    break;
+                case 1: v[i] = static_cast<T>(r % 1000); break;     // 小范围，大量 重复
+                case 2: v[i] = static_cast<T>(i); break;            // 已排序
+                case 3: v[i] = static_cast<T>(n - i); break;        // 逆序
+                case 4: v[i] = static_cast<T>(7); break;            // 全部相同
+                default: v[i] = static_cast<T>(r % 3) - static_cast<T>(1); break;
+            }
+        }
+        return v;
+    }
+
+    template <class T>
+    void check_sort(std::size_t n) {
+        for (int kind = 0; kind < 6; ++kind) {
+            auto v = make_keys<T>(n, kind, static_cast<unsigned>(n + kind));
+            auto expected = v;
+            std::stable_sort(expected.begin(), expected.end(), less<T>);
+
+            auto a = v;
+            e_math::radix_sort(std::span<T>(a));
+            ASSERT_EQ(a, expected) << "n = " << n << " kind = " << kind;
+
+            auto b = v;
+            std::vector<T> scratch(n + 3);
+            e_math::radix_sort(std::span<T>(b), std::span<T>(scratch));
+            ASSERT_EQ(b, expected) << "n = " << n << " kind = " << kind;
+        }
+    }
+
+    template <class T>
+    void check_all_sizes() {
+        for (std::size_t n : {0, 1, 2, 31, 33, 1000, 70000, 300000}) {
+            check_sort<T>(n);
+        }
+    }
+}
+
+TEST(E_Sort, Int32) {
+    check_all_sizes<std::int32_t>();
+}
+
+TEST(E_Sort, Uint32) {
+    check_all_sizes<std::uint32_t>();
+}
+
+TEST(E_Sort, Int64) {
+    check_all_sizes<std::int64_t>();
+}
+
+TEST(E_Sort, Uint64) {
+    check_all_sizes<std::uint64_t>();
+}
+
+TEST(E_Sort, FloatKeys) {
+    check_all_sizes<float>();
+}
+
+TEST(E_Sort, DoubleKeys) {
+    check_all_sizes<double>();
+}
+
+TEST(E_Sort, FloatSpecialValues) {
+    const float inf = std::numeric_limits<float>::infinity();
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    std::vector<float> v = {3.0f, -0.0f, nan, -inf, 0.0f, -nan, inf, -1.5f, std::numeric_limits<float>::denorm_min(), -2.0f};
+    e_math::radix_sort(std::span<float>(v));
+
+    EXPECT_TRUE(std::isnan(v[0]) && std::signbit(v[0]));
+    EXPECT_EQ(v[1], -inf);
+    EXPECT_EQ(v[2], -2.0f);
+    EXPECT_EQ(v[3], -1.5f);
+    EXPECT_TRUE(v[4] == 0 && std::signbit(v[4]));
+    EXPECT_TRUE(v[5] == 0 && !std::signbit(v[5]));
+    EXPECT_EQ(v[6], std::numeric_limits<float>::denorm_min());
+    EXPECT_EQ(v[7], 3.0f);
+    EXPECT_EQ(v[8], inf);
+    EXPECT_TRUE(std::isnan(v[9]) && !std::signbit(v[9]));
+}
+
+// 值 跟着 键 移动，相同的 键 保持 原顺序
+template <class K, class V>
+static void check_pairs(std::size_t n) {
+    auto keys = make_keys<K>(n, 1, 5);
+    std::vector<V> values(n);
+    std::iota(values.begin(), values.end(), V(0));
+    const auto original = keys;
+
+    e_math::radix_sort_pairs(std::span<K>(keys), std::span<V>(values));
+    for (std::size_t i = 0; i < n; ++i) {
+        ASSERT_EQ(keys[i], original[values[i]]) << i;
+        if (i > 0) {
+            ASSERT_FALSE(less(keys[i], keys[i - 1])) << i;
+            if (keys[i] == keys[i - 1]) {
+                ASSERT_LT(values[i - 1], values[i]) << i;
+            }
+        }
+    }
+
+    auto keys2 = original;
+    std::vector<V> values2(n);
+    std::iota(values2.begin(), values2.end(), V(0));
+    std::vector<K> ks(n);
+    std::vector<V> vs(n);
+    e_math::radix_sort_pairs(std::span<K>(keys2), std::span<V>(values2), std::span<K>(ks), std::span<V>(vs));
+    EXPECT_EQ(keys2, keys);
+    EXPECT_EQ(values2, values);
+}
+
+TEST(E_Sort, Pairs) {
+    for (std::size_t n : {0, 20, 5000, 300000}) {
+        check_pairs<std::uint32_t, std::uint32_t>(n);
+        check_pairs<float, std::uint64_t>(n);
+        check_pairs<std::int64_t, std::uint32_t>(n);
+    }
+}
+
+// MSD 分桶 + 各桶 LSD 的 并行路径 与 单线程 结果 相同
+TEST(E_Sort, Threads) {
+    ThreadsGuard guard;
+    auto v = make_keys<std::uint64_t>(1 << 20, 0, 11);
+    // 只用 低 20 位：MSD 应该 选 第 2 个 字节
+    auto low = v;
+    for (auto& x : low) x &= (1u << 20) - 1;
+
+    for (const auto* input : {&v, &low}) {
+        auto expected = *input;
+        std::sort(expected.begin(), expected.end());
+        for (unsigned t : {1u, 2u, 3u, 8u, 64u}) {
+            e_math::set_max_threads(t);
+            auto a = *input;
+            e_math::radix_sort(std::span<std::uint64_t>(a));
+            ASSERT_EQ(a, expected) << t;
+        }
+    }
+}
+
+// scratch 版本 只用 调用方 的 缓冲区：比较排序、LSD、MSD 分桶 三条 路径 都 不 调用 operator new
+TEST(E_Sort, ScratchDoesNotAllocate) {
+#if !defined(E_SORT_TEST_COUNTS_ALLOCATIONS)
+    GTEST_SKIP() << "allocations inside the math DLL do not go through this executable's operator new";
+#else
+    ThreadsGuard guard;
+    e_math::set_max_threads(1);
+    for (std::size_t n : {1000, 5000, 300000}) {
+        auto keys = make_keys<std::uint64_t>(n, 0, 5);
+        auto fkeys = make_keys<float>(n, 0, 6);
+        std::vector<std::uint64_t> scratch(n);
+        std::vector<float> fscratch(n);
+        std::vector<std::uint32_t> values(n), vscratch(n);
+        std::iota(values.begin(), values.end(), 0u);
+        // 第一次 用 时 创建 全局 线程池，不算
+        std::vector<std::uint64_t> warm = keys;
+        e_math::radix_sort(std::span<std::uint64_t>(warm), std::span<std::uint64_t>(scratch));
+
+        std::size_t allocations = 0;
+        {
+            CountAllocations counter;
+            e_math::radix_sort(std::span<std::uint64_t>(keys), std::span<std::uint64_t>(scratch));
+            e_math::radix_sort_pairs(std::span<float>(fkeys), std::span<std::uint32_t>(values), std::span<float>(fscratch), std::span<std::uint32_t>(vscratch));
+            allocations = counter.count();
+        }
+        EXPECT_EQ(allocations, 0u) << n;
+
+        EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+        EXPECT_TRUE(std::is_sorted(fkeys.begin(), fkeys.end()));
+    }
+#endif
+}
+
+TEST(E_Sort, Invalid) {
+    std::vector<std::uint32_t> k(10), small(9);
+    std::vector<std::uint64_t> v(9);
+    EXPECT_THROW(e_math::radix_sort(std::span<std::uint32_t>(k), std::span<std::uint32_t>(small)), std::invalid_argument);
+    EXPECT_THROW(e_math::radix_sort_pairs(std::span<std::uint32_t>(k), std::span<std::uint64_t>(v)), std::invalid_argument);
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include "e_parallel.hpp"
+#include "e_sparse.hpp"
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using e_math::coo_entry;
+using e_math::csr_matrix;
+
+namespace {
+    template <class T>
+    std::vector<coo_entry<T>> random_entries(std::size_t rows, std::size_t cols, std::size_t count, unsigned seed) {
+        std::mt19937_64 rng(seed);
+        std::uniform_int_distribution<std::size_t> row(0, rows - 1), col(0, cols - 1);
+        std::uniform_real_distribution<double> value(-1.0, 1.0);
+        std::vector<coo_entry<T>> e(count);
+        for (auto& x : e) x = {row(rng), col(rng), static_cast<T>(value(rng))};
+        return e;
+    }
+
+    class ThreadsGuard {
+    public:
+        ~ThreadsGuard() { e_math::set_max_threads(0); }
+    };
+}
+
+TEST(E_Sparse, FromCoo) {
+    // 乱序，(1, 2) 出现两次
+    std::vector<coo_entry<double>> e = {{1, 2, 1.0}, {0, 3, 2.0}, {1, 0, 3.0}, {1, 2, 4.0}, {3, 1, 5.0}};
+    csr_matrix<double> a(4, 5, e);
+
+    EXPECT_EQ(a.rows(), 4u);
+    EXPECT_EQ(a.cols(), 5u);
+    EXPECT_EQ(a.nnz(), 4u);
+    EXPECT_EQ(std::vector<std::size_t>(a.row_ptr().begin(), a.row_ptr().end()), (std::vector<std::size_t>{0, 1, 3, 3, 4}));
+    EXPECT_EQ(std::vector<std::uint32_t>(a.col_idx().begin(), a.col_idx().end()), (std::vector<std::uint32_t>{3, 0, 2, 1}));
+    EXPECT_EQ(std::vector<double>(a.values().begin(), a.values().end()), (std::vector<double>{2.0, 3.0, 5.0, 5.0}));
+}
+
+TEST(E_Sparse, Empty) {
+    csr_matrix<float> a;
+    EXPECT_EQ(a.nnz(), 0u);
+    EXPECT_EQ(a.row_ptr().size(), 1u);
+    e_math::spmv(a, std::span<const float>(), std::span<float>());
+
+    csr_matrix<float> b(3, 2, std::span<const coo_entry<float>>());
+    std::vector<float> x(2, 1.0f), y(3, 7.0f);
+    e_math::spmv(b, std::span<const float>(x), std::span<float>(y));
+    EXPECT_EQ(y, (std::vector<float>{0.0f, 0.0f, 0.0f}));
+}
+
+template <class T>
+static void check_spmv(std::size_t rows, std::size_t cols, std::size_t count) {
+    auto e = random_entries<T>(rows, cols, count, static_cast<unsigned>(rows + count));
+    csr_matrix<T> a(rows, cols, e);
+
+    std::vector<T> x(cols);
+    std::mt19937 rng(1);
+    for (auto& v : x) v = static_cast<T>(std::uniform_real_distribution<double>(-1.0, 1.0)(rng));
+
+    std::vector<double> expected(rows, 0.0), magnitude(rows, 0.0);
+    for (const auto& t : e) {
+        expected[t.row] += static_cast<double>(t.value) * x[t.col];
+        magnitude[t.row] += std::fabs(static_cast<double>(t.value) * x[t.col]);
+    }
+
+    std::vector<T> y(rows);
+    e_math::spmv(a, std::span<const T>(x), std::span<T>(y));
+    for (std::size_t r = 0; r < rows; ++r) {
+        ASSERT_NEAR(y[r], expected[r], std::numeric_limits<T>::epsilon() * 4 * (magnitude[r] + 1)) << r;
+    }
+}
+
+// 每行 非零元个数 覆盖 gather 的 整块 与 尾部
+TEST(E_Sparse, Spmv) {
+    check_spmv<float>(50, 40, 600);
+    check_spmv<double>(50, 40, 600);
+    check_spmv<float>(1000, 300, 100000);
+    check_spmv<double>(3000, 5000, 60000);
+}
+
+// 行 按 非零元 切分：结果 与 线程数 无关
+TEST(E_Sparse, Threads) {
+    ThreadsGuard guard;
+    auto e = random_entries<float>(20000, 1000, 200000, 9);
+    // 几行 特别密
+    for (std::size_t c = 0; c < 1000; ++c) e.push_back({7, c, 1.0f});
+    csr_matrix<float> a(20000, 1000, e);
+    std::vector<float> x(1000, 0.5f);
+
+    std::vector<float> ref(20000);
+    e_math::set_max_threads(1);
+    e_math::spmv(a, std::span<const float>(x), std::span<float>(ref));
+    for (unsigned t : {2u, 3u, 8u}) {
+        e_math::set_max_threads(t);
+        std::vector<float> y(20000);
+        e_math::spmv(a, std::span<const float>(x), std::span<float>(y));
+        EXPECT_EQ(y, ref) << t;
+    }
+}
+
+TEST(E_Sparse, Invalid) {
+    std::vector<coo_entry<float>> bad_row = {{3, 0, 1.0f}};
+    std::vector<coo_entry<float>> bad_col = {{0, 2, 1.0f}};
+    EXPECT_THROW(csr_matrix<float>(3, 2, bad_row), std::invalid_argument);
+    EXPECT_THROW(csr_matrix<float>(3, 2, bad_col), std::invalid_argument);
+
+    csr_matrix<float> a(3, 2, std::span<const coo_entry<float>>());
+    std::vector<float> x(3), y(3);
+    EXPECT_THROW(e_math::spmv(a, std::span<const float>(x), std::span<float>(y)), std::invalid_argument);
+}
@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+
+#include "e_stats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using e_math::moments;
+using e_math::tdigest;
+
+namespace {
+    std::vector<double> normal_samples(std::size_t n, unsigned seed, double mean = 0, double sd = 1) {
+        std::mt19937_64 rng(seed);
+        std::normal_distribution<double> dist(mean, sd);
+        std::vector<double> v(n);
+        for (auto& x : v) x = dist(rng);
+        return v;
+    }
+
+    // 估计值 在 排序后 数据 里 的 秩 与 q 的 差
+    double rank_error(const std::vector<double>& sorted, double q, double estimate) {
+        auto lo = std::lower_bound(sorted.begin(), sorted.end(), estimate) - sorted.begin();
+        auto hi = std::upper_bound(sorted.begin(), sorted.end(), estimate) - sorted.begin();
+        const auto n = static_cast<double>(sorted.size());
+        const double target = q * n;
+        if (target >= static_cast<double>(lo) && target <= static_cast<double>(hi)) {
+            return 0;
+        }
+        return std::min(std::fabs(static_cast<double>(lo) - target), std::fabs(static_cast<double>(hi) - target)) / n;
+    }
+
+    void check_quantiles(const tdigest& d, std::vector<double> data) {
+        std::sort(data.begin(), data.end());
+        for (double q : {0.001, 0.01, 0.1, 0.5, 0.9, 0.99, 0.999}) {
+            double bound = 2 * std::numbers::pi * std::sqrt(q * (1 - q)) / d.compression();
+            EXPECT_LE(rank_error(data, q, d.quantile(q)), bound) << "q = " << q;
+        }
+        EXPECT_EQ(d.quantile(0), data.front());
+        EXPECT_EQ(d.quantile(1), data.back());
+    }
+}
+
+TEST(E_Stats, MomentsBasic) {
+    moments m;
+    EXPECT_EQ(m.count(), 0u);
+    EXPECT_TRUE(std::isnan(m.mean()));
+    EXPECT_TRUE(std::isnan(m.min()));
+
+    for (double x : {2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0}) m.add(x);
+    EXPECT_EQ(m.count(), 8u);
+    EXPECT_DOUBLE_EQ(m.mean(), 5.0);
+    EXPECT_DOUBLE_EQ(m.variance(), 4.0);
+    EXPECT_DOUBLE_EQ(m.sample_variance(), 32.0 / 7.0);
+    EXPECT_DOUBLE_EQ(m.stddev(), 2.0);
+    EXPECT_EQ(m.min(), 2.0);
+    EXPECT_EQ(m.max(), 9.0);
+}
+
+// 均值 很大、方差 很小：朴素的 E[x^2] - E[x]^2 会 完全丢失 精度
+TEST(E_Stats, MomentsStable) {
+    auto v = normal_samples(100000, 1, 1e9, 1.0);
+    long double sum = 0;
+    for (double x : v) sum += x;
+    long double mean = sum / v.size();
+    long double m2 = 0;
+    for (double x : v) m2 += (x - mean) * (x - mean);
+    const double var = static_cast<double>(m2 / v.size());
+
+    moments one, batch;
+    for (double x : v) one.add(x);
+    batch.add(std::span<const double>(v));
+    EXPECT_NEAR(one.mean(), static_cast<double>(mean), 1e-5);
+    EXPECT_NEAR(batch.mean(), static_cast<double>(mean), 1e-5);
+    EXPECT_NEAR(one.variance(), var, var * 1e-6);
+    EXPECT_NEAR(batch.variance(), var, var * 1e-6);
+}
+
+// 分成 几段 各自累加 再合并，与 一次累加 一致
+TEST(E_Stats, MomentsMerge) {
+    auto v = normal_samples(10007, 2, 3.0, 2.0);
+    std::vector<float> f(v.begin(), v.end());
+
+    moments whole;
+    whole.add(std::span<const float>(f));
+
+    moments parts[4];
+    for (std::size_t i = 0; i < f.size(); ++i) parts[i % 4].add(static_cast<double>(f[i]));
+    moments merged;
+    merged.merge(moments{});
+    for (const auto& p : parts) merged.merge(p);
+
+    EXPECT_EQ(merged.count(), whole.count());
+    EXPECT_NEAR(merged.mean(), whole.mean(), 1e-12);
+    EXPECT_NEAR(merged.variance(), whole.variance(), 1e-10);
+    EXPECT_EQ(merged.min(), whole.min());
+    EXPECT_EQ(merged.max(), whole.max());
+}
+
+TEST(E_Stats, TDigestNormal) {
+    auto v = normal_samples(1000000, 3);
+    tdigest d;
+    d.add(std::span<const double>(v));
+    EXPECT_EQ(d.count(), 1000000.0);
+    check_quantiles(d, v);
+
+    // 内存 有界
+    d.compress();
+    EXPECT_LE(d.centroid_count(), 100u);
+}
+
+// 长尾分布：p999 依然准
+TEST(E_Stats, TDigestSkewed) {
+    std::mt19937_64 rng(4);
+    std::lognormal_distribution<double> dist(0.0, 2.0);
+    std::vector<double> v(500000);
+    for (auto& x : v) x = dist(rng);
+    tdigest d(200);
+    d.add(std::span<const double>(v));
+    check_quantiles(d, v);
+}
+
+// 每线程 一个 sketch，最后 合并
+TEST(E_Stats, TDigestMerge) {
+    auto v = normal_samples(400000, 5, 10.0, 3.0);
+    tdigest parts[8];
+    for (std::size_t i = 0; i < v.size(); ++i) parts[i % 8].add(v[i]);
+    tdigest merged;
+    for (const auto& p : parts) merged.merge(p);
+    EXPECT_EQ(merged.count(), 400000.0);
+    check_quantiles(merged, v);
+}
+
+// 拷贝 保留 缓冲区 上限：与 原件 走 同样的 compress 节奏；自己 合并 自己
+TEST(E_Stats, TDigestCopyAndSelfMerge) {
+    auto v = normal_samples(200000, 6, 0.0, 1.0);
+    tdigest original;
+    original.add(std::span<const double>(v.data(), 1000));
+    tdigest copy = original;
+    for (std::size_t i = 1000; i < v.size(); ++i) {
+        original.add(v[i]);
+        copy.add(v[i]);
+    }
+    EXPECT_EQ(copy.centroid_count(), original.centroid_count());
+    for (double q : {0.01, 0.5, 0.99}) EXPECT_EQ(copy.quantile(q), original.quantile(q)) << q;
+
+    copy.merge(copy);
+    EXPECT_EQ(copy.count(), 2 * original.count());
+    check_quantiles(copy, v);
+}
+
+TEST(E_Stats, TDigestEdgeCases) {
+    tdigest d;
+    EXPECT_TRUE(std::isnan(d.quantile(0.5)));
+    EXPECT_TRUE(std::isnan(d.min()));
+
+    d.add(std::numeric_limits<double>::quiet_NaN());
+    d.add(std::numeric_limits<double>::infinity());
+    EXPECT_EQ(d.count(), 0.0);
+
+    d.add(3.0);
+    EXPECT_EQ(d.quantile(0.0), 3.0);
+    EXPECT_EQ(d.quantile(0.5), 3.0);
+    EXPECT_EQ(d.quantile(1.0), 3.0);
+
+    // 带 权重
+    tdigest w;
+    w.add(1.0, 3);
+    w.add(2.0, 1);
+    EXPECT_EQ(w.count(), 4.0);
+    EXPECT_LE(w.quantile(0.25), 1.0 + 1e-12);
+
+    EXPECT_THROW(tdigest(5), std::invalid_argument);
+    EXPECT_THROW(d.add(1.0, 0), std::invalid_argument);
+    EXPECT_THROW(d.quantile(1.5), std::invalid_argument);
+}
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include "e_vmath.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using e_math::precision;
+
+namespace {
+    using ld = long double;
+
+    // got 与 参考值 的 距离，单位 是 T 在 参考值处 的 ulp（非规格数 区间 ulp 固定）
+    template <class T>
+    double ulp_error(T got, ld ref) {
+        const double bad = std::numeric_limits<double>::infinity();
+        if (std::isnan(ref)) {
+            return std::isnan(got) ? 0 : bad;
+        }
+        if (std::isnan(got)) {
+            return bad;
+        }
+        if (std::isinf(got) || std::isinf(ref)) {
+            return got == static_cast<T>(ref) ? 0 : bad;
+        }
+        int e = 0;
+        std::frexp(std::fabs(ref), &e);
+        using L = std::numeric_limits<T>;
+        int ulp_exp = std::max(e - L::digits, L::min_exponent - L::digits);
+        return static_cast<double>(std::fabs(static_cast<ld>(got) - ref) / std::ldexp(ld(1), ulp_exp));
+    }
+
+    ld sigmoid_ref(ld x) {
+        return 1 / (1 + std::exp(-x));
+    }
+
+    using vmath_fn_f = void (*)(std::span<const float>, std::span<float>, precision);
+    using vmath_fn_d = void (*)(std::span<const double>, std::span<double>, precision);
+
+    struct function_case {
+        const char* name;
+        vmath_fn_f f32;
+        vmath_fn_d f64;
+        ld (*ref)(ld);
+        double bound[2][2]; // [float / double][accurate / fast]
+    };
+
+    // 与 e_vmath.hpp 里的 误差表 一致
+    const function_case kCases[] = {
+        {"exp", e_math::exp, e_math::exp, [](ld x) { return std::exp(x); }, {{1, 2.5}, {1.5, 3}}},
+        {"log", e_math::log, e_math::log, [](ld x) { return std::log(x); }, {{1, 2}, {1, 1}}},
+        {"sin", e_math::sin, e_math::sin, [](ld x) { return std::sin(x); }, {{2.5, 2.5}, {2, 2}}},
+        {"cos", e_math::cos, e_math::cos, [](ld x) { return std::cos(x); }, {{2.5, 2.5}, {2, 2}}},
+        {"tanh", e_math::tanh, e_math::tanh, [](ld x) { return std::tanh(x); }, {{2, 3}, {2, 2.5}}},
+        {"sigmoid", e_math::sigmoid, e_math::sigmoid, sigmoid_ref, {{2.5, 3.5}, {2.5, 4}}},
+    };
+
+    template <class T>
+    void add_specials(std::vector<T>& v) {
+        using L = std::numeric_limits<T>;
+        for (T x : {T(0), L::denorm_min(), L::min(), L::max(), L::infinity(), L::quiet_NaN(), T(1), T(0.5), T(0.625), T(88.5), T(710)}) {
+            v.push_back(x);
+            v.push_back(-x);
+        }
+    }
+
+    // float：按 位模式 等距 扫过 全部 2^32 个值
+    std::vector<float> float_inputs() {
+        std::vector<float> v;
+        for (std::uint64_t bits = 0; bits < (std::uint64_t(1) << 32); bits += 4099) {
+            auto b = static_cast<std::uint32_t>(bits);
+            float x;
+            std::memcpy(&x, &b, sizeof(x));
+            v.push_back(x);
+        }
+        add_specials(v);
+        return v;
+    }
+
+    // double：随机 位模式（覆盖 所有指数），再加上 各函数 有意义的 区间
+    std::vector<double> double_inputs() {
+        std::mt19937_64 rng(2024);
+        std::vector<double> v;
+        for (int i = 0; i < 300000; ++i) {
+            std::uint64_t b = rng();
+            double x;
+            std::memcpy(&x, &b, sizeof(x));
+            v.push_back(x);
+        }
+        for (double range : {1.0, 30.0, 750.0, 1e5}) {
+            std::uniform_real_distribution<double> dist(-range, range);
+            for (int i = 0; i < 100000; ++i) v.push_back(dist(rng));
+        }
+        add_specials(v);
+        return v;
+    }
+
+    template <class T, class F>
+    void check_function(const function_case& c, F fn, const std::vector<T>& in, int type) {
+        for (int prec = 0; prec < 2; ++prec) {
+            std::vector<T> out(in.size());
+            fn(std::span<const T>(in), std::span<T>(out), prec == 0 ? precision::accurate : precision::fast);
+
+            double worst = 0;
+            T worst_x = 0;
+            for (std::size_t i = 0; i < in.size(); ++i) {
+                double e = ulp_error(out[i], c.ref(static_cast<ld>(in[i])));
+                if (!(e <= worst)) {
+                    worst = e;
+                    worst_x = in[i];
+                }
+            }
+            EXPECT_LE(worst, c.bound[type][prec]) << c.name << (type == 0 ? " float " : " double ") << (prec == 0 ? "accurate" : "fast")
+                                                  << " at x = " << static_cast<double>(worst_x);
+        }
+    }
+}
+
+TEST(E_VMath, FloatUlp) {
+    auto in = float_inputs();
+    for (const auto& c : kCases) {
+        check_function(c, c.f32, in, 0);
+    }
+}
+
+TEST(E_VMath, DoubleUlp) {
+    auto in = double_inputs();
+    for (const auto& c : kCases) {
+        check_function(c, c.f64, in, 1);
+    }
+}
+
+// 各种长度：整向量 + 尾部；原地
+TEST(E_VMath, LengthsAndInPlace) {
+    for (std::size_t n : {0, 1, 3, 4, 7, 8, 15, 16, 17, 33, 100}) {
+        std::vector<double> v(n);
+        for (std::size_t i = 0; i < n; ++i) v[i] = static_cast<double>(i) * 0.37 - 5.0;
+        auto expected = v;
+        for (auto& x : expected) x = std::exp(x);
+        e_math::exp(std::span<const double>(v), std::span<double>(v));
+        for (std::size_t i = 0; i < n; ++i) {
+            EXPECT_LE(ulp_error(v[i], static_cast<ld>(expected[i])), 2.0) << n;
+        }
+    }
+}
+
+TEST(E_VMath, SizeMismatch) {
+    std::vector<float> a(4), b(5);
+    EXPECT_THROW(e_math::sin(std::span<const float>(a), std::span<float>(b)), std::invalid_argument);
+}
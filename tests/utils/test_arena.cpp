@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include "e_arena.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+    bool aligned(const void* p, std::size_t alignment) {
+        return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+    }
+
+    struct point {
+        double x, y;
+        point(double x_, double y_) : x(x_), y(y_) {}
+    };
+}
+
+TEST(E_Arena, BumpAllocation) {
+    e_utils::arena a({.block_bytes = 4096});
+    EXPECT_EQ(a.reserved_bytes(), 4096u);
+
+    // 连续 分配 紧挨着
+    auto* p = static_cast<char*>(a.alloc(10, 1));
+    auto* q = static_cast<char*>(a.alloc(6, 1));
+    EXPECT_EQ(q, p + 10);
+
+    for (std::size_t alignment : {1u, 2u, 8u, 16u, 64u, 256u}) {
+        a.alloc(1, 1);
+        void* r = a.alloc(24, alignment);
+        EXPECT_TRUE(aligned(r, alignment)) << alignment;
+        std::memset(r, 0xab, 24);
+    }
+
+    const point* pt = a.make<point>(1.5, 2.5);
+    EXPECT_TRUE(aligned(pt, alignof(point)));
+    EXPECT_EQ(pt->x, 1.5);
+    EXPECT_EQ(pt->y, 2.5);
+
+    EXPECT_THROW(a.alloc(SIZE_MAX - 8, 16), std::bad_alloc);
+}
+
+TEST(E_Arena, ChainsBlocksAndReusesThemAfterReset) {
+    e_utils::arena a({.block_bytes = 4096});
+    std::vector<void*> first;
+    for (int i = 0; i < 1000; ++i) {
+        void* p = a.alloc(48, 16);
+        std::memset(p, i & 0xff, 48);
+        first.push_back(p);
+    }
+    const std::size_t reserved = a.reserved_bytes();
+    EXPECT_GE(reserved, 1000u * 48);
+    EXPECT_LE(reserved, 2000u * 48);
+
+    // 同样 的 分配 序列 拿到 同样 的 地址，不再 向 系统 要
+    a.reset();
+    for (int i = 0; i < 1000; ++i) ASSERT_EQ(a.alloc(48, 16), first[i]) << i;
+    EXPECT_EQ(a.reserved_bytes(), reserved);
+
+    a.release();
+    EXPECT_EQ(a.reserved_bytes(), 4096u);
+    EXPECT_NE(a.alloc(48, 16), nullptr);
+}
+
+TEST(E_Arena, LargeAllocationsGetOwnBlock) {
+    e_utils::arena a({.block_bytes = 4096});
+    auto* small = static_cast<char*>(a.alloc(16, 16));
+    void* big = a.alloc(100000, 128);
+    EXPECT_TRUE(aligned(big, 128));
+    std::memset(big, 1, 100000);
+    EXPECT_GE(a.reserved_bytes(), 4096u + 100000);
+
+    // 大 分配 不 打断 当前 块
+    EXPECT_EQ(static_cast<char*>(a.alloc(16, 16)), small + 16);
+
+    // 大 块 reset 时 释放
+    a.reset();
+    EXPECT_EQ(a.reserved_bytes(), 4096u);
+}
+
+TEST(E_Arena, PmrContainers) {
+    e_utils::arena a;
+    {
+        std::pmr::vector<std::pmr::string> names(&a);
+        std::pmr::map<int, std::pmr::string> by_id(&a);
+        for (int i = 0; i < 2000; ++i) {
+            names.emplace_back("a fairly long name that does not fit in SSO #" + std::to_string(i));
+            by_id.emplace(i, names.back());
+        }
+        EXPECT_EQ(names[1234], "a fairly long name that does not fit in SSO #1234");
+        EXPECT_EQ(by_id.at(1999), names.back());
+        EXPECT_EQ(by_id.at(7).get_allocator().resource(), &a);
+    }
+    EXPECT_TRUE(a.is_equal(a));
+    EXPECT_FALSE(a.is_equal(*std::pmr::new_delete_resource()));
+    a.reset();
+}
+
+TEST(E_Arena, HugePages) {
+    // 没有 大页 可用 时 退回 普通 页，行为 一样
+    e_utils::arena a({.block_bytes = 4096, .huge_pages = true});
+    EXPECT_EQ(a.reserved_bytes(), std::size_t{2} << 20);
+    std::vector<char*> ptrs;
+    for (int i = 0; i < 100; ++i) {
+        auto* p = static_cast<char*>(a.alloc(64 * 1024, 64));
+        std::memset(p, i, 64 * 1024);
+        ptrs.push_back(p);
+    }
+    for (int i = 0; i < 100; ++i) EXPECT_EQ(ptrs[i][i * 100], static_cast<char>(i));
+    void* big = a.alloc(3 << 20, 64);
+    std::memset(big, 7, 3 << 20);
+    a.reset();
+    EXPECT_EQ(a.alloc(64 * 1024, 64), ptrs[0]);
+}
@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+
+#include "e_filter.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    // 当作 哈希 值；前 n 个 插入，后 n 个 不插，用来 量 误判率
+    std::vector<std::uint64_t> random_hashes(std::size_t n, unsigned seed) {
+        std::mt19937_64 rng(seed);
+        std::vector<std::uint64_t> v(2 * n);
+        for (auto& x : v) x = rng();
+        return v;
+    }
+
+    template <class Filter>
+    double measured_rate(const Filter& f, const std::vector<std::uint64_t>& hashes, std::size_t n) {
+        std::size_t positives = 0;
+        for (std::size_t i = n; i < 2 * n; ++i) positives += f.contains(hashes[i]);
+        return static_cast<double>(positives) / static_cast<double>(n);
+    }
+
+    // 模拟 mmap：拷到 一块 不对齐 的 内存，view 直接 在 上面 查
+    std::vector<std::byte> unaligned_copy(std::span<const std::byte> bytes) {
+        std::vector<std::byte> v(bytes.size() + 3);
+        std::memcpy(v.data() + 3, bytes.data(), bytes.size());
+        return v;
+    }
+}
+
+TEST(E_BloomFilter, NoFalseNegativesAndRate) {
+    for (double target : {0.1, 0.01, 0.001}) {
+        const std::size_t n = 50000;
+        const auto hashes = random_hashes(n, 1);
+        e_utils::bloom_filter f(n, target);
+        EXPECT_LE(f.estimate_false_positive_rate(f.blocks(), n), target);
+        for (std::size_t i = 0; i < n; ++i) f.insert(hashes[i]);
+        EXPECT_EQ(f.items(), n);
+        for (std::size_t i = 0; i < n; ++i) ASSERT_TRUE(f.contains(hashes[i])) << i;
+
+        const double rate = measured_rate(f, hashes, n);
+        EXPECT_LT(rate, target * 1.3) << target;
+        EXPECT_GT(rate, target * 0.5) << target;
+        EXPECT_NEAR(f.false_positive_rate(), rate, target * 0.3) << target;
+    }
+}
+
+TEST(E_BloomFilter, BatchMatchesSingle) {
+    const std::size_t n = 10007;
+    const auto hashes = random_hashes(n, 2);
+    e_utils::bloom_filter f(n, 0.02);
+    f.insert(std::span<const std::uint64_t>(hashes).first(n));
+
+    std::vector<std::uint8_t> expect(hashes.size());
+    std::size_t expect_hits = 0;
+    for (std::size_t i = 0; i < hashes.size(); ++i) expect_hits += expect[i] = f.contains(hashes[i]);
+
+    auto out = std::make_unique<bool[]>(hashes.size());
+    EXPECT_EQ(f.contains(hashes, std::span<bool>(out.get(), hashes.size())), expect_hits);
+    for (std::size_t i = 0; i < hashes.size(); ++i) EXPECT_EQ(out[i], expect[i] != 0) << i;
+    EXPECT_THROW(f.contains(hashes, std::span<bool>(out.get(), 3)), std::invalid_argument);
+}
+
+TEST(E_BloomFilter, SerializedView) {
+    const std::size_t n = 3000;
+    const auto hashes = random_hashes(n, 3);
+    e_utils::bloom_filter f(n, 0.01);
+    for (std::size_t i = 0; i < n; ++i) f.insert(hashes[i]);
+
+    const auto file = unaligned_copy(f.bytes());
+    const std::span<const std::byte> mapped(file.data() + 3, f.bytes().size());
+    const e_utils::bloom_filter_view v(mapped);
+    EXPECT_EQ(v.blocks(), f.blocks());
+    EXPECT_EQ(v.items(), n);
+    for (std::uint64_t h : hashes) EXPECT_EQ(v.contains(h), f.contains(h));
+
+    // 拷贝 出来 继续 插
+    e_utils::bloom_filter g(mapped);
+    g.insert(hashes[n]);
+    EXPECT_TRUE(g.contains(hashes[n]));
+    EXPECT_EQ(g.items(), n + 1);
+
+    EXPECT_THROW(e_utils::bloom_filter_view(mapped.first(mapped.size() - 1)), std::invalid_argument);
+    EXPECT_THROW(e_utils::bloom_filter_view(mapped.first(10)), std::invalid_argument);
+    EXPECT_THROW(e_utils::cuckoo_filter_view{mapped}, std::invalid_argument);
+    EXPECT_THROW(e_utils::bloom_filter(10, 0.0), std::invalid_argument);
+    EXPECT_THROW(e_utils::bloom_filter(10, 1.0), std::invalid_argument);
+}
+
+TEST(E_CuckooFilter, Sizing) {
+    EXPECT_EQ(e_utils::cuckoo_filter::fingerprint_bits_for(0.05), 8u);
+    EXPECT_EQ(e_utils::cuckoo_filter::fingerprint_bits_for(0.001), 16u);
+    EXPECT_EQ(e_utils::cuckoo_filter::fingerprint_bits_for(1e-6), 32u);
+    EXPECT_THROW(e_utils::cuckoo_filter::fingerprint_bits_for(1e-12), std::invalid_argument);
+
+    const e_utils::cuckoo_filter f(1000, 0.001);
+    EXPECT_GE(f.capacity() * 95 / 100, 1000u);
+    EXPECT_EQ(f.buckets() & (f.buckets() - 1), 0u);
+}
+
+TEST(E_CuckooFilter, InsertEraseAndRate) {
+    for (double target : {0.05, 0.001, 1e-6}) {
+        const std::size_t n = 20000;
+        const auto hashes = random_hashes(n, 4);
+        e_utils::cuckoo_filter f(n, target);
+        for (std::size_t i = 0; i < n; ++i) ASSERT_TRUE(f.insert(hashes[i])) << i;
+        EXPECT_EQ(f.size(), n);
+        for (std::size_t i = 0; i < n; ++i) ASSERT_TRUE(f.contains(hashes[i])) << i;
+        EXPECT_LE(measured_rate(f, hashes, n), target * 1.2) << target;
+
+        // 删掉 一半，剩下 的 还在
+        for (std::size_t i = 0; i < n; i += 2) ASSERT_TRUE(f.erase(hashes[i])) << i;
+        EXPECT_EQ(f.size(), n / 2);
+        for (std::size_t i = 1; i < n; i += 2) ASSERT_TRUE(f.contains(hashes[i])) << i;
+        std::size_t still = 0;
+        for (std::size_t i = 0; i < n; i += 2) still += f.contains(hashes[i]);
+        EXPECT_LT(still, n / 20) << target;
+    }
+
+    // 重复 插入 是 多份
+    e_utils::cuckoo_filter f(100, 0.001);
+    EXPECT_TRUE(f.insert(42));
+    EXPECT_TRUE(f.insert(42));
+    EXPECT_TRUE(f.erase(42));
+    EXPECT_TRUE(f.contains(42));
+    EXPECT_TRUE(f.erase(42));
+    EXPECT_FALSE(f.contains(42));
+    EXPECT_FALSE(f.erase(42));
+}
+
+TEST(E_CuckooFilter, FullFilterRejectsWithoutLosingItems) {
+    const auto hashes = random_hashes(2000, 5);
+    e_utils::cuckoo_filter f(256, 0.05);
+    std::size_t inserted = 0;
+    while (inserted < hashes.size() && f.insert(hashes[inserted])) ++inserted;
+    EXPECT_LT(inserted, hashes.size());
+    EXPECT_GT(inserted, f.capacity() * 9 / 10);
+    EXPECT_EQ(f.size(), inserted);
+    EXPECT_FALSE(f.insert(hashes[inserted]));
+    for (std::size_t i = 0; i < inserted; ++i) ASSERT_TRUE(f.contains(hashes[i])) << i;
+
+    // 删掉 一个 之后 又能 插
+    ASSERT_TRUE(f.erase(hashes[0]));
+    for (std::size_t i = 1; i < inserted; ++i) ASSERT_TRUE(f.contains(hashes[i])) << i;
+    EXPECT_TRUE(f.insert(hashes[0]));
+    for (std::size_t i = 0; i < inserted; ++i) ASSERT_TRUE(f.contains(hashes[i])) << i;
+}
+
+TEST(E_CuckooFilter, BatchAndSerializedView) {
+    for (double target : {0.05, 0.001, 1e-6}) {
+        const std::size_t n = 5000;
+        const auto hashes = random_hashes(n, 6);
+        e_utils::cuckoo_filter f(n, target);
+        for (std::size_t i = 0; i < n; ++i) f.insert(hashes[i]);
+
+        const auto file = unaligned_copy(f.bytes());
+        const std::span<const std::byte> mapped(file.data() + 3, f.bytes().size());
+        const e_utils::cuckoo_filter_view v(mapped);
+        EXPECT_EQ(v.size(), n);
+        EXPECT_EQ(v.fingerprint_bits(), f.fingerprint_bits());
+
+        auto out = std::make_unique<bool[]>(hashes.size());
+        std::size_t expect_hits = 0;
+        for (std::uint64_t h : hashes) expect_hits += f.contains(h);
+        EXPECT_EQ(v.contains(hashes, std::span<bool>(out.get(), hashes.size())), expect_hits);
+        for (std::size_t i = 0; i < hashes.size(); ++i) EXPECT_EQ(out[i], f.contains(hashes[i])) << i;
+
+        e_utils::cuckoo_filter g(mapped);
+        for (std::size_t i = 0; i < n; ++i) ASSERT_TRUE(g.erase(hashes[i])) << i;
+        EXPECT_EQ(g.size(), 0u);
+        EXPECT_EQ(f.size(), n);
+
+        EXPECT_THROW(e_utils::cuckoo_filter_view(mapped.first(mapped.size() - 1)), std::invalid_argument);
+        EXPECT_THROW(e_utils::bloom_filter_view{mapped}, std::invalid_argument);
+    }
+}
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+
+#include "e_flat_hash_map.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    // 统计 存活 对象 数，检查 没有 泄漏 或 重复 析构
+    struct counted {
+        static inline int alive = 0;
+
+        int v = 0;
+
+        explicit counted(int x = 0) : v(x) { ++alive; }
+        counted(const counted& o) : v(o.v) { ++alive; }
+        counted(counted&& o) noexcept : v(o.v) { ++alive; }
+        counted& operator=(const counted&) = default;
+        counted& operator=(counted&&) = default;
+        ~counted() { --alive; }
+    };
+
+    // 所有 键 落在 同一个 位置，全靠 探测 与 比较 键
+    struct constant_hash {
+        std::size_t operator()(int) const noexcept { return 42; }
+    };
+
+    template <class Map, class Ref>
+    void expect_same(const Map& m, const Ref& ref) {
+        ASSERT_EQ(m.size(), ref.size());
+        std::size_t visited = 0;
+        for (const auto& [k, v] : m) {
+            const auto it = ref.find(k);
+            ASSERT_NE(it, ref.end()) << k;
+            EXPECT_EQ(v, it->second) << k;
+            ++visited;
+        }
+        EXPECT_EQ(visited, ref.size());
+    }
+}
+
+TEST(E_FlatHashMap, Basic) {
+    e_utils::flat_hash_map<int, int> m;
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(m.find(1), m.end());
+    EXPECT_EQ(m.begin(), m.end());
+    EXPECT_EQ(m.erase(1), 0u);
+
+    EXPECT_TRUE(m.insert({1, 10}).second);
+    EXPECT_FALSE(m.insert({1, 11}).second);
+    EXPECT_TRUE(m.try_emplace(2, 20).second);
+    EXPECT_TRUE(m.emplace(3, 30).second);
+    m[4] = 40;
+    m[4] += 1;
+    EXPECT_EQ(m.size(), 4u);
+    EXPECT_EQ(m.at(1), 10);
+    EXPECT_EQ(m[4], 41);
+    EXPECT_TRUE(m.contains(3));
+    EXPECT_EQ(m.count(5), 0u);
+    EXPECT_THROW(m.at(5), std::out_of_range);
+
+    EXPECT_FALSE(m.insert_or_assign(1, 12).second);
+    EXPECT_EQ(m.at(1), 12);
+
+    EXPECT_EQ(m.erase(2), 1u);
+    EXPECT_FALSE(m.contains(2));
+    EXPECT_EQ(m.size(), 3u);
+
+    m.clear();
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(m.begin(), m.end());
+    EXPECT_GT(m.capacity(), 0u);
+}
+
+// 随机 插入 / 删除 / 查找，与 std::unordered_map 对照；键 范围 小，删了 又 插，墓碑 很多
+TEST(E_FlatHashMap, RandomAgainstStd) {
+    for (int range : {50, 2000, 100000}) {
+        std::mt19937_64 rng(static_cast<unsigned>(range));
+        e_utils::flat_hash_map<std::uint64_t, std::uint64_t> m;
+        std::unordered_map<std::uint64_t, std::uint64_t> ref;
+        for (int step = 0; step < 200000; ++step) {
+            const std::uint64_t k = rng() % static_cast<std::uint64_t>(range);
+            switch (rng() % 4) {
+                case 0:
+                case 1:
+                    EXPECT_EQ(m.insert_or_assign(k, step).second, ref.insert_or_assign(k, step).second);
+                    break;
+                case 2:
+                    EXPECT_EQ(m.erase(k), ref.erase(k));
+                    break;
+                default: {
+                    const auto it = m.find(k);
+                    const auto r = ref.find(k);
+                    ASSERT_EQ(it == m.end(), r == ref.end());
+                    if (r != ref.end()) {
+                        EXPECT_EQ(it->second, r->second);
+                    }
+                }
+            }
+        }
+        expect_same(m, ref);
+        // 容量 不会 因为 墓碑 一直 涨
+        EXPECT_LE(m.capacity(), 4 * static_cast<std::size_t>(range) + 16);
+    }
+}
+
+TEST(E_FlatHashMap, Collisions) {
+    e_utils::flat_hash_map<int, int, constant_hash, std::equal_to<int>> m;
+    for (int i = 0; i < 300; ++i) m[i] = i * 2;
+    for (int i = 0; i < 300; i += 2) EXPECT_EQ(m.erase(i), 1u);
+    for (int i = 0; i < 300; ++i) {
+        EXPECT_EQ(m.contains(i), i % 2 == 1) << i;
+    }
+    for (int i = 0; i < 300; i += 2) m[i] = -i;
+    EXPECT_EQ(m.size(), 300u);
+    EXPECT_EQ(m.at(298), -298);
+}
+
+TEST(E_FlatHashMap, HeterogeneousStringKeys) {
+    e_utils::flat_hash_map<std::string, int> m;
+    m["alpha"] = 1;
+    m[std::string_view("beta")] = 2;
+    m.try_emplace(std::string("gamma"), 3);
+
+    const std::string_view key = "alpha";
+    EXPECT_EQ(m.at(key), 1);
+    EXPECT_TRUE(m.contains("beta"));
+    EXPECT_NE(m.find(std::string_view("gamma")), m.end());
+    EXPECT_FALSE(m.contains(std::string_view("delta")));
+    EXPECT_FALSE(m.try_emplace(std::string_view("beta"), 5).second);
+    EXPECT_EQ(m.erase(std::string_view("beta")), 1u);
+    EXPECT_EQ(m.size(), 2u);
+
+    // 长 字符串，搬动 时 不能 只 拷 指针
+    for (int i = 0; i < 1000; ++i) m[std::string(40, 'x') + std::to_string(i)] = i;
+    for (int i = 0; i < 1000; ++i) EXPECT_EQ(m.at(std::string(40, 'x') + std::to_string(i)), i);
+}
+
+TEST(E_FlatHashMap, ObjectLifetimes) {
+    {
+        e_utils::flat_hash_map<int, counted> m;
+        for (int i = 0; i < 1000; ++i) m.try_emplace(i, i);
+        EXPECT_EQ(counted::alive, 1000);
+        for (int i = 0; i < 1000; i += 3) m.erase(i);
+        EXPECT_EQ(counted::alive, static_cast<int>(m.size()));
+
+        auto copy = m;
+        EXPECT_EQ(counted::alive, 2 * static_cast<int>(m.size()));
+        auto moved = std::move(copy);
+        EXPECT_TRUE(copy.empty());
+        EXPECT_EQ(moved.at(1).v, 1);
+        moved.clear();
+        EXPECT_EQ(counted::alive, static_cast<int>(m.size()));
+    }
+    EXPECT_EQ(counted::alive, 0);
+
+    // 只能 移动 的 值
+    e_utils::flat_hash_map<int, std::unique_ptr<int>> u;
+    for (int i = 0; i < 100; ++i) u.try_emplace(i, std::make_unique<int>(i));
+    EXPECT_EQ(*u.at(77), 77);
+}
+
+TEST(E_FlatHashMap, EraseWhileIterating) {
+    e_utils::flat_hash_map<int, int> m;
+    for (int i = 0; i < 500; ++i) m[i] = i;
+    for (auto it = m.begin(); it != m.end();) {
+        if (it->first % 3 == 0) {
+            it = m.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    EXPECT_EQ(m.size(), 333u);
+    for (int i = 0; i < 500; ++i) EXPECT_EQ(m.contains(i), i % 3 != 0);
+}
+
+TEST(E_FlatHashMap, ReserveAvoidsRehash) {
+    e_utils::flat_hash_map<int, int> m;
+    m.reserve(1000);
+    const std::size_t capacity = m.capacity();
+    EXPECT_GE(capacity * 7 / 8, 1000u);
+    for (int i = 0; i < 1000; ++i) m[i] = i;
+    EXPECT_EQ(m.capacity(), capacity);
+
+    const e_utils::flat_hash_map<int, int> init = {{1, 2}, {3, 4}};
+    e_utils::flat_hash_map<int, int>::const_iterator it = init.find(3);
+    EXPECT_EQ(it->second, 4);
+}
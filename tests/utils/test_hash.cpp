@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include "e_hash.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    std::string random_bytes(std::size_t n, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::string s(n, '\0');
+        for (auto& c : s) c = static_cast<char>(rng());
+        return s;
+    }
+
+    // 逐位 计算，作为 对照
+    std::uint32_t crc32c_bitwise(std::string_view s, std::uint32_t crc = 0) {
+        crc = ~crc;
+        for (unsigned char c : s) {
+            crc ^= c;
+            for (int b = 0; b < 8; ++b) crc = (crc >> 1) ^ (0x82f63b78u & (0u - (crc & 1)));
+        }
+        return ~crc;
+    }
+
+    // 跨过 各个 分支：尾巴 的 8 / 4 / 1 字节、32 / 16 字节 块、CRC 的 三路 交错（768 字节）
+    const std::size_t kLengths[] = {0, 1, 3, 4, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 100, 767, 768, 769, 1000, 2310, 5000};
+}
+
+// 参考实现 的 结果
+TEST(E_Hash, ReferenceVectors) {
+    EXPECT_EQ(e_utils::hash64(""), 0xef46db3751d8e999ull);
+    EXPECT_EQ(e_utils::hash64("a"), 0xd24ec4f1a98c6e5bull);
+    EXPECT_EQ(e_utils::hash64("abc"), 0x44bc2cf5ad770999ull);
+
+    EXPECT_EQ(e_utils::hash128(""), (e_utils::digest128{0, 0}));
+    // 按 字节 写出 是 6c1b07bc7bbc4be3 47939ac4a93c437a
+    EXPECT_EQ(e_utils::hash128("The quick brown fox jumps over the lazy dog"),
+              (e_utils::digest128{0xe34bbc7bbc071b6cull, 0x7a433ca9c49a9347ull}));
+
+    EXPECT_EQ(e_utils::crc32c("123456789"), 0xe3069283u);
+    EXPECT_EQ(e_utils::crc32c(""), 0u);
+    EXPECT_EQ(e_utils::crc32c(std::string(32, '\0')), 0x8a9136aau);
+
+    // 字节 区间 与 同样 内容 的 字符串 结果 相同
+    const std::vector<std::byte> bytes = {std::byte{'a'}, std::byte{'b'}, std::byte{'c'}};
+    EXPECT_EQ(e_utils::hash64(bytes, 3), e_utils::hash64("abc", 3));
+    EXPECT_EQ(e_utils::hash128(bytes, 3), e_utils::hash128("abc", 3));
+    EXPECT_EQ(e_utils::crc32c(bytes, 3), e_utils::crc32c("abc", 3));
+}
+
+TEST(E_Hash, Crc32cMatchesBitwise) {
+    for (std::size_t n : kLengths) {
+        const std::string s = random_bytes(n + 7, static_cast<unsigned>(n));
+        // 不对齐 的 起点
+        for (std::size_t offset : {0, 1, 5}) {
+            const std::string_view v = std::string_view(s).substr(offset, n);
+            EXPECT_EQ(e_utils::crc32c(v), crc32c_bitwise(v)) << n << " " << offset;
+            EXPECT_EQ(e_utils::crc32c(v, 0x12345678u), crc32c_bitwise(v, 0x12345678u)) << n;
+        }
+    }
+}
+
+TEST(E_Hash, StreamingMatchesOneShot) {
+    for (std::size_t n : kLengths) {
+        const std::string s = random_bytes(n, static_cast<unsigned>(n) + 100);
+        for (std::uint64_t seed : {0ull, 1ull, 0x9e3779b97f4a7c15ull}) {
+            const std::uint64_t h64 = e_utils::hash64(s, seed);
+            const e_utils::digest128 h128 = e_utils::hash128(s, seed);
+            // 各种 切分：一个 一个 字节、固定 步长、随机 长度
+            for (std::size_t step : {1, 3, 13, 32, 50}) {
+                e_utils::hasher64 a(seed);
+                e_utils::hasher128 b(seed);
+                for (std::size_t i = 0; i < n; i += step) {
+                    const std::string_view part = std::string_view(s).substr(i, step);
+                    a.update(part);
+                    b.update(part);
+                }
+                EXPECT_EQ(a.digest(), h64) << n << " " << step;
+                EXPECT_EQ(b.digest(), h128) << n << " " << step;
+            }
+
+            const std::size_t cut = n / 3;
+            EXPECT_EQ(e_utils::crc32c(std::string_view(s).substr(cut), e_utils::crc32c(std::string_view(s).substr(0, cut))),
+                      e_utils::crc32c(s)) << n;
+        }
+    }
+
+    // digest 之后 还能 接着 写；reset 回到 初始
+    e_utils::hasher64 h(7);
+    h.update("hello ");
+    EXPECT_EQ(h.digest(), e_utils::hash64("hello ", 7)); // 字面量 带 seed，7 不会 被 当成 长度
+    h.update(std::as_bytes(std::span("world, this is longer than thirty-two bytes").first(43)));
+    EXPECT_EQ(h.digest(), e_utils::hash64("hello world, this is longer than thirty-two bytes", 7));
+    h.reset();
+    EXPECT_EQ(h.digest(), e_utils::hash64(""));
+}
+
+TEST(E_Hash, BatchMatchesSingle) {
+    std::mt19937 rng(3);
+    std::vector<std::string> storage;
+    for (int i = 0; i < 1003; ++i) {
+        // 大多 是 短键，偶尔 夹 一个 长键
+        const std::size_t n = i % 37 == 0 ? 40 + rng() % 100 : rng() % 32;
+        storage.push_back(random_bytes(n, static_cast<unsigned>(i)));
+    }
+    const std::vector<std::string_view> keys(storage.begin(), storage.end());
+    std::vector<std::uint64_t> out(keys.size());
+    e_utils::hash64_batch(keys, out, 42);
+    for (std::size_t i = 0; i < keys.size(); ++i) EXPECT_EQ(out[i], e_utils::hash64(keys[i], 42)) << i;
+
+    EXPECT_THROW(e_utils::hash64_batch(keys, std::span<std::uint64_t>(out).first(3)), std::invalid_argument);
+}
+
+// 粗查 分布：相邻 整数 键 没有 碰撞，翻转 一位 输入 大约 一半 输出 位 变化
+TEST(E_Hash, Distribution) {
+    std::set<std::uint64_t> seen64;
+    std::set<std::uint64_t> seen128;
+    for (std::uint64_t i = 0; i < 100000; ++i) {
+        seen64.insert(e_utils::hash64(std::as_bytes(std::span(&i, 1))));
+        seen128.insert(e_utils::hash128(std::as_bytes(std::span(&i, 1))).high);
+    }
+    EXPECT_EQ(seen64.size(), 100000u);
+    EXPECT_EQ(seen128.size(), 100000u);
+
+    std::string s = random_bytes(24, 9);
+    const std::uint64_t base = e_utils::hash64(s);
+    int flipped = 0;
+    for (std::size_t bit = 0; bit < s.size() * 8; ++bit) {
+        s[bit / 8] ^= static_cast<char>(1 << (bit % 8));
+        flipped += std::popcount(e_utils::hash64(s) ^ base);
+        s[bit / 8] ^= static_cast<char>(1 << (bit % 8));
+    }
+    const double average = static_cast<double>(flipped) / static_cast<double>(s.size() * 8);
+    EXPECT_NEAR(average, 32.0, 2.0);
+    EXPECT_NE(e_utils::hash64(s, 1), e_utils::hash64(s, 2));
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include "e_int_codec.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    using e_utils::int_codec;
+
+    constexpr int_codec all_codecs[] = {int_codec::varint, int_codec::bitpack, int_codec::delta_bitpack};
+
+    // 每 128 个 一段，位数 从 0 到 32 轮换，覆盖 每个 解包 内核
+    std::vector<std::uint32_t> mixed_widths(std::size_t n, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::vector<std::uint32_t> v(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            const unsigned bits = (i / 128) % 33;
+            const std::uint32_t mask = bits == 32 ? ~0u : (1u << bits) - 1;
+            v[i] = 1000 + (rng() & mask);
+        }
+        return v;
+    }
+
+    // 递增 的 ID，间隔 随机
+    std::vector<std::uint32_t> sorted_ids(std::size_t n, std::uint32_t max_gap, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::vector<std::uint32_t> v(n);
+        std::uint32_t x = 12345;
+        for (auto& y : v) y = x += rng() % max_gap;
+        return v;
+    }
+
+    void expect_round_trip(const std::vector<std::uint32_t>& values) {
+        for (int_codec codec : all_codecs) {
+            const std::vector<std::byte> bytes = e_utils::encode_ints(values, codec);
+            EXPECT_LE(bytes.size(), e_utils::max_encoded_ints_size(values.size()));
+            EXPECT_EQ(e_utils::encoded_ints_count(bytes), values.size());
+            ASSERT_EQ(e_utils::decode_ints(bytes), values) << static_cast<int>(codec) << " n = " << values.size();
+        }
+    }
+}
+
+TEST(E_IntCodec, RoundTripAllWidthsAndTails) {
+    for (std::size_t n : {0, 1, 7, 127, 128, 129, 255, 128 * 33, 128 * 33 + 77}) {
+        expect_round_trip(mixed_widths(n, static_cast<unsigned>(n)));
+        expect_round_trip(sorted_ids(n, 1000, static_cast<unsigned>(n)));
+    }
+
+    // 极值 与 回绕 的 差分
+    expect_round_trip({0, ~0u, 0, ~0u, 1, 0x80000000u, 0x7fffffffu});
+    std::vector<std::uint32_t> wrap(300);
+    for (std::size_t i = 0; i < wrap.size(); ++i) wrap[i] = i % 2 == 0 ? ~0u - static_cast<std::uint32_t>(i) : static_cast<std::uint32_t>(i);
+    expect_round_trip(wrap);
+}
+
+TEST(E_IntCodec, CompressionRatio) {
+    // 固定 步长 的 时间戳：差分 后 每块 位数 为 0，只 剩 块 头（加上 5 字节 的 起点）
+    std::vector<std::uint32_t> ts(1 + 128 * 100);
+    for (std::size_t i = 0; i < ts.size(); ++i) ts[i] = 1700000000u + 15u * static_cast<std::uint32_t>(i);
+    EXPECT_EQ(e_utils::encode_ints(ts, int_codec::delta_bitpack).size(), 8u + 5 + 100 * 5);
+
+    // 间隔 小于 16 的 ID：每个 4 位 上下
+    const auto ids = sorted_ids(1 + 128 * 100, 16, 3);
+    const std::size_t packed = e_utils::encode_ints(ids, int_codec::delta_bitpack).size();
+    EXPECT_LE(packed, 8 + 3 + 100 * (5 + 16 * 4));
+    EXPECT_LT(packed * 2, e_utils::encode_ints(ids, int_codec::bitpack).size());
+    EXPECT_LT(e_utils::encode_ints(ids, int_codec::bitpack).size(), e_utils::encode_ints(ids, int_codec::varint).size());
+}
+
+TEST(E_IntCodec, DeltaInPlace) {
+    for (std::size_t n : {0, 1, 3, 4, 5, 17, 1000}) {
+        const auto ids = sorted_ids(n, 50, 5);
+        std::vector<std::uint32_t> v = ids;
+        e_utils::delta_encode(v, 7);
+        for (std::size_t i = 0; i < n; ++i) EXPECT_EQ(v[i], ids[i] - (i == 0 ? 7 : ids[i - 1])) << i;
+        e_utils::delta_decode(v, 7);
+        EXPECT_EQ(v, ids) << n;
+    }
+}
+
+TEST(E_IntCodec, Varint) {
+    const std::vector<std::uint32_t> values = {0, 1, 127, 128, 300, 16383, 16384, ~0u};
+    std::vector<std::byte> bytes(64);
+    const std::size_t size = e_utils::varint_encode(values, bytes);
+    EXPECT_EQ(size, 1u + 1 + 1 + 2 + 2 + 2 + 3 + 5);
+    EXPECT_EQ(bytes[5], std::byte{0xac}); // 300 = ac 02
+    EXPECT_EQ(bytes[6], std::byte{0x02});
+
+    std::vector<std::uint32_t> out(values.size());
+    EXPECT_EQ(e_utils::varint_decode(std::span<const std::byte>(bytes).first(size), out), size);
+    EXPECT_EQ(out, values);
+
+    // 大量 单字节 走 8 个 一起 的 快速 路径，中间 夹 多字节
+    std::vector<std::uint32_t> small(1001);
+    for (std::size_t i = 0; i < small.size(); ++i) small[i] = i % 97 == 0 ? 100000 : static_cast<std::uint32_t>(i % 128);
+    bytes.resize(5 * small.size());
+    bytes.resize(e_utils::varint_encode(small, bytes));
+    out.assign(small.size(), 0);
+    EXPECT_EQ(e_utils::varint_decode(bytes, out), bytes.size());
+    EXPECT_EQ(out, small);
+
+    std::vector<std::byte> tiny(3);
+    EXPECT_THROW(e_utils::varint_encode(values, tiny), std::invalid_argument);
+    const std::vector<std::byte> overflow = {std::byte{0xff}, std::byte{0xff}, std::byte{0xff}, std::byte{0xff}, std::byte{0x10}};
+    EXPECT_THROW(e_utils::varint_decode(overflow, std::span<std::uint32_t>(out).first(1)), std::invalid_argument);
+    EXPECT_THROW(e_utils::varint_decode(std::span<const std::byte>(overflow).first(4), std::span<std::uint32_t>(out).first(1)),
+                 std::invalid_argument);
+}
+
+TEST(E_IntCodec, RejectsBadInput) {
+    const auto values = mixed_widths(128 * 3 + 5, 9);
+    for (int_codec codec : all_codecs) {
+        const std::vector<std::byte> bytes = e_utils::encode_ints(values, codec);
+
+        // 任何 截断 都 报错，不会 越界 读
+        for (std::size_t cut : {std::size_t{0}, std::size_t{5}, std::size_t{9}, bytes.size() / 2, bytes.size() - 1}) {
+            EXPECT_THROW(e_utils::decode_ints(std::span<const std::byte>(bytes).first(cut)), std::invalid_argument) << cut;
+        }
+
+        std::vector<std::uint32_t> small(values.size() - 1);
+        EXPECT_THROW(e_utils::decode_ints(bytes, small), std::invalid_argument);
+
+        auto broken = bytes;
+        broken[0] = std::byte{9};
+        EXPECT_THROW(e_utils::decode_ints(broken), std::invalid_argument);
+    }
+
+    // 头 里 的 个数 远 超过 数据 能 装下 的：先 报错，不会 按 它 分配 内存
+    for (int_codec codec : all_codecs) {
+        auto huge = e_utils::encode_ints(std::vector<std::uint32_t>{1, 2, 3}, codec);
+        const std::uint32_t count = 0xffffffffu;
+        std::memcpy(huge.data() + 4, &count, sizeof(count));
+        EXPECT_THROW(e_utils::encoded_ints_count(huge), std::invalid_argument);
+        EXPECT_THROW(e_utils::decode_ints(huge), std::invalid_argument);
+        EXPECT_THROW(e_utils::decode_ints(std::span<const std::byte>(huge).first(8)), std::invalid_argument);
+    }
+
+    // 块 位数 超过 32
+    auto broken = e_utils::encode_ints(values, int_codec::bitpack);
+    broken[8 + 4] = std::byte{33};
+    EXPECT_THROW(e_utils::decode_ints(broken), std::invalid_argument);
+
+    std::vector<std::byte> out(e_utils::max_encoded_ints_size(values.size()) - 1);
+    EXPECT_THROW(e_utils::encode_ints(values, out, int_codec::bitpack), std::invalid_argument);
+}
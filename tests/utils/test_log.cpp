@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+
+#include "e_log.hpp"
+
+#include <condition_variable>
+#include <cstdio>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    // "2026-01-02 03:04:05.678901 INFO  " 之后 才是 内容
+    constexpr std::size_t prefix_size = 27 + 6;
+
+    // 收集 sink 收到 的 行；测试 结束 时 恢复 默认 配置
+    class captured_log {
+    public:
+        explicit captured_log(e_utils::log_options options = {}) {
+            options.sink = [state = state_](std::string_view batch) {
+                std::unique_lock<std::mutex> lock(state->mutex);
+                state->cv.wait(lock, [&] { return !state->paused; });
+                state->text.append(batch);
+                ++state->batches;
+            };
+            e_utils::set_log_options(std::move(options));
+        }
+
+        ~captured_log() { e_utils::set_log_options({}); }
+
+        std::vector<std::string> lines() {
+            e_utils::log_flush();
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            std::vector<std::string> out;
+            std::istringstream in(state_->text);
+            for (std::string line; std::getline(in, line);) out.push_back(line);
+            return out;
+        }
+
+        // 暂停 sink，后台 线程 卡住，缓冲 很快 写满
+        void pause(bool paused) {
+            {
+                std::lock_guard<std::mutex> lock(state_->mutex);
+                state_->paused = paused;
+            }
+            state_->cv.notify_all();
+        }
+
+        std::size_t batches() {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            return state_->batches;
+        }
+
+    private:
+        struct state {
+            std::mutex mutex;
+            std::condition_variable cv;
+            bool paused = false;
+            std::string text;
+            std::size_t batches = 0;
+        };
+
+        std::shared_ptr<state> state_ = std::make_shared<state>();
+    };
+
+    e_utils::log_options options(e_utils::log_level min_level, e_utils::log_full_policy full_policy = e_utils::log_full_policy::drop,
+                                 std::size_t buffer_bytes = std::size_t{1} << 20) {
+        e_utils::log_options o;
+        o.min_level = min_level;
+        o.full_policy = full_policy;
+        o.buffer_bytes = buffer_bytes;
+        return o;
+    }
+
+    enum class color { red = 3 };
+}
+
+TEST(E_Log, FormatsArguments) {
+    captured_log log;
+    const std::string s = "str";
+    const char* null = nullptr;
+    int x = 0;
+    E_LOG_INFO("plain");
+    E_LOG_INFO("ints {} {} {} {}", -1, 42u, std::int64_t{-9000000000}, std::uint8_t{7});
+    E_LOG_WARN("bool {} char {} double {} float {}", true, 'c', 0.5, 1.25f);
+    E_LOG_ERROR("strings {} {} {} {}", "lit", s, std::string_view("view"), null);
+    E_LOG_INFO("braces {{}} {{{}}} enum {}", 1, color::red);
+    E_LOG_INFO("pointer {}", static_cast<const void*>(&x));
+    E_LOG_DEBUG("filtered out {}", 1);
+
+    const auto lines = log.lines();
+    ASSERT_EQ(lines.size(), 6u);
+    EXPECT_EQ(lines[0].substr(prefix_size), "plain");
+    EXPECT_EQ(lines[0].substr(26, 7), " INFO  ");
+    EXPECT_EQ(lines[0][4], '-');
+    EXPECT_EQ(lines[0][13], ':');
+    EXPECT_EQ(lines[1].substr(prefix_size), "ints -1 42 -9000000000 7");
+    EXPECT_EQ(lines[2].substr(26, 7), " WARN  ");
+    EXPECT_EQ(lines[2].substr(prefix_size), "bool true char c double 0.5 float 1.25");
+    EXPECT_EQ(lines[3].substr(26, 7), " ERROR ");
+    EXPECT_EQ(lines[3].substr(prefix_size), "strings lit str view (null)");
+    EXPECT_EQ(lines[4].substr(prefix_size), "braces {} {1} enum 3");
+    EXPECT_EQ(lines[5].substr(prefix_size, 10), "pointer 0x");
+}
+
+TEST(E_Log, Levels) {
+    captured_log log(options(e_utils::log_level::warn));
+    EXPECT_FALSE(e_utils::log_enabled(e_utils::log_level::info));
+    EXPECT_TRUE(e_utils::log_enabled(e_utils::log_level::error));
+    E_LOG_INFO("no");
+    E_LOG_WARN("yes");
+    const auto lines = log.lines();
+    ASSERT_EQ(lines.size(), 1u);
+    EXPECT_EQ(lines[0].substr(prefix_size), "yes");
+}
+
+TEST(E_Log, ManyThreadsKeepOrder) {
+    captured_log log(options(e_utils::log_level::info, e_utils::log_full_policy::block, 4096));
+    constexpr int threads = 4, per_thread = 20000;
+    const std::uint64_t dropped = e_utils::log_dropped();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([t] {
+            for (int i = 0; i < per_thread; ++i) E_LOG_INFO("t {} i {}", t, i);
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    const auto lines = log.lines();
+    ASSERT_EQ(lines.size(), static_cast<std::size_t>(threads * per_thread));
+    EXPECT_EQ(e_utils::log_dropped(), dropped);
+    std::vector<int> next(threads, 0);
+    for (const std::string& line : lines) {
+        int t = -1, i = -1;
+        ASSERT_EQ(std::sscanf(line.c_str() + prefix_size, "t %d i %d", &t, &i), 2) << line;
+        ASSERT_EQ(i, next[t]++) << line;
+    }
+    // 多条 记录 一批 写出
+    EXPECT_LT(log.batches(), lines.size() / 10);
+}
+
+TEST(E_Log, DropWhenFull) {
+    captured_log log(options(e_utils::log_level::info, e_utils::log_full_policy::drop, 4096));
+    const std::uint64_t dropped = e_utils::log_dropped();
+    E_LOG_INFO("first");
+    log.lines();
+    log.pause(true);
+    std::thread([] {
+        for (int i = 0; i < 1000; ++i) E_LOG_INFO("message {}", i);
+    }).join();
+    log.pause(false);
+
+    const auto lines = log.lines();
+    const std::uint64_t lost = e_utils::log_dropped() - dropped;
+    EXPECT_GT(lost, 0u);
+
+    // 丢弃 提示 可能 分 几行，合计 等于 丢掉 的 条数
+    std::uint64_t reported = 0;
+    std::size_t notices = 0;
+    for (const std::string& line : lines) {
+        unsigned long long n = 0;
+        if (std::sscanf(line.c_str() + prefix_size, "log buffer full, dropped %llu messages", &n) == 1) {
+            reported += n;
+            ++notices;
+        }
+    }
+    EXPECT_EQ(reported, lost);
+    EXPECT_EQ(lines.size(), 1 + 1000 - lost + notices);
+}
@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+
+#include "e_mpmc_queue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct counted {
+        static inline std::atomic<int> alive{0};
+
+        explicit counted(int v = 0) : value(v) { ++alive; }
+        counted(counted&& o) noexcept : value(o.value) { ++alive; }
+        counted& operator=(counted&& o) noexcept {
+            value = o.value;
+            return *this;
+        }
+        ~counted() { --alive; }
+
+        int value;
+    };
+
+    // producers 个 线程 各 放 per_producer 个（编码 为 线程号 << 32 | 序号），consumers 个 线程 取 到 pop 返回 false
+    // 检查 每个 元素 恰好 取到 一次，且 同一 生产者 的 元素 在 每个 消费者 看来 有序
+    template <class Push, class Pop>
+    void run_mpmc(unsigned producers, unsigned consumers, std::uint32_t per_producer, Push push, Pop pop) {
+        const std::uint64_t total = std::uint64_t{producers} * per_producer;
+        std::vector<std::atomic<std::uint8_t>> seen(total);
+        std::atomic<std::uint64_t> taken{0};
+        std::atomic<bool> ordered{true};
+
+        std::vector<std::thread> threads;
+        for (unsigned p = 0; p < producers; ++p) {
+            threads.emplace_back([&, p] {
+                for (std::uint32_t i = 0; i < per_producer; ++i) push((std::uint64_t{p} << 32) | i);
+            });
+        }
+        for (unsigned c = 0; c < consumers; ++c) {
+            threads.emplace_back([&] {
+                std::vector<std::int64_t> last(producers, -1);
+                std::uint64_t v;
+                while (pop(v, taken, total)) {
+                    const auto p = static_cast<unsigned>(v >> 32);
+                    const auto i = static_cast<std::uint32_t>(v);
+                    if (static_cast<std::int64_t>(i) <= last[p]) ordered = false;
+                    last[p] = i;
+                    seen[std::uint64_t{p} * per_producer + i].fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+        for (auto& t : threads) t.join();
+
+        EXPECT_EQ(taken.load(), total);
+        EXPECT_TRUE(ordered.load());
+        for (std::uint64_t k = 0; k < total; ++k) ASSERT_EQ(seen[k].load(), 1u) << "k=" << k;
+    }
+}
+
+TEST(E_MpmcQueue, FifoAndCapacity) {
+    EXPECT_THROW(e_utils::mpmc_queue<int>(0), std::invalid_argument);
+    EXPECT_EQ(e_utils::mpmc_queue<int>(1).capacity(), 2u);
+
+    e_utils::mpmc_queue<int> q(5);
+    EXPECT_EQ(q.capacity(), 8u);
+    int out = 0;
+    EXPECT_FALSE(q.try_pop(out));
+    // 绕 好几 圈
+    for (int lap = 0; lap < 5; ++lap) {
+        for (int i = 0; i < 8; ++i) EXPECT_TRUE(q.try_push(lap * 100 + i));
+        EXPECT_FALSE(q.try_push(-1));
+        EXPECT_EQ(q.size_approx(), 8u);
+        for (int i = 0; i < 8; ++i) {
+            ASSERT_TRUE(q.try_pop(out));
+            EXPECT_EQ(out, lap * 100 + i);
+        }
+        EXPECT_FALSE(q.try_pop(out));
+    }
+}
+
+TEST(E_MpmcQueue, BulkMoveOnlyAndDestructor) {
+    {
+        e_utils::mpmc_queue<std::unique_ptr<int>> q(8);
+        std::vector<std::unique_ptr<int>> in;
+        for (int i = 0; i < 10; ++i) in.push_back(std::make_unique<int>(i));
+        EXPECT_EQ(q.try_push_bulk(in.data(), in.size()), 8u); // 只 放得下 8 个
+        EXPECT_EQ(in[7], nullptr);
+        EXPECT_NE(in[8], nullptr);
+
+        std::unique_ptr<int> out[5];
+        EXPECT_EQ(q.try_pop_bulk(out, 5), 5u);
+        for (int i = 0; i < 5; ++i) EXPECT_EQ(*out[i], i);
+        EXPECT_EQ(q.try_push_bulk(in.data() + 8, 2), 2u);
+        EXPECT_EQ(q.try_pop_bulk(out, 5), 5u);
+        for (int i = 0; i < 5; ++i) EXPECT_EQ(*out[i], 5 + i);
+        EXPECT_EQ(q.try_pop_bulk(out, 5), 0u);
+    }
+    {
+        e_utils::mpmc_queue<counted> q(16);
+        for (int i = 0; i < 10; ++i) q.try_emplace(i);
+        counted c;
+        q.try_pop(c);
+        EXPECT_EQ(c.value, 0);
+        EXPECT_EQ(counted::alive, 10);
+    }
+    EXPECT_EQ(counted::alive, 0); // 没 取走 的 随 队列 析构
+}
+
+TEST(E_MpmcQueue, ConcurrentTryPushPop) {
+    e_utils::mpmc_queue<std::uint64_t> q(64);
+    run_mpmc(
+        4, 4, 50000,
+        [&](std::uint64_t v) {
+            while (!q.try_push(v)) std::this_thread::yield();
+        },
+        [&](std::uint64_t& v, std::atomic<std::uint64_t>& taken, std::uint64_t total) {
+            while (taken.load() < total) {
+                if (q.try_pop(v)) {
+                    ++taken;
+                    return true;
+                }
+                std::this_thread::yield();
+            }
+            return false;
+        });
+}
+
+TEST(E_BlockingMpmcQueue, ParksAndWakes) {
+    // 容量 2、不 忙等：几乎 每次 都 要 睡 和 唤醒
+    e_utils::blocking_mpmc_queue<std::uint64_t> q(2, 0);
+    std::atomic<unsigned> producers_left{3};
+    run_mpmc(
+        3, 3, 20000,
+        [&](std::uint64_t v) {
+            EXPECT_TRUE(q.push(v));
+            if ((v & 0xffffffffu) == 19999 && --producers_left == 0) q.close();
+        },
+        [&](std::uint64_t& v, std::atomic<std::uint64_t>& taken, std::uint64_t) {
+            if (!q.pop(v)) return false;
+            ++taken;
+            return true;
+        });
+
+    // 批量 版本
+    e_utils::blocking_mpmc_queue<int> b(16, 8);
+    std::thread producer([&] {
+        std::vector<int> chunk(37);
+        for (int round = 0; round < 100; ++round) {
+            for (int i = 0; i < 37; ++i) chunk[i] = round * 37 + i;
+            EXPECT_EQ(b.push_bulk(chunk.data(), chunk.size()), 37u);
+        }
+        b.close();
+    });
+    long long sum = 0;
+    int expected = 0;
+    int out[10];
+    while (std::size_t n = b.pop_bulk(out, 10)) {
+        for (std::size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(out[i], expected++);
+            sum += out[i];
+        }
+    }
+    producer.join();
+    EXPECT_EQ(expected, 3700);
+    EXPECT_EQ(sum, 3699LL * 3700 / 2);
+}
+
+TEST(E_BlockingMpmcQueue, CloseDrainsThenStops) {
+    e_utils::blocking_mpmc_queue<int> q(4);
+    int v = 0;
+
+    // 空 队列 上 等 的 消费者 被 close 唤醒
+    std::thread waiter([&] { EXPECT_FALSE(q.pop(v)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    q.close();
+    waiter.join();
+
+    e_utils::blocking_mpmc_queue<int> r(4);
+    EXPECT_TRUE(r.push(1));
+    EXPECT_TRUE(r.try_push(2));
+    // 满 队列 上 等 的 生产者 被 close 唤醒，元素 没 放进去
+    EXPECT_TRUE(r.push(3));
+    EXPECT_TRUE(r.push(4));
+    std::thread blocked([&] { EXPECT_FALSE(r.push(5)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    r.close();
+    blocked.join();
+    EXPECT_TRUE(r.closed());
+    EXPECT_FALSE(r.push(6));
+    EXPECT_FALSE(r.try_push(6));
+    for (int want = 1; want <= 4; ++want) {
+        ASSERT_TRUE(r.pop(v));
+        EXPECT_EQ(v, want);
+    }
+    EXPECT_FALSE(r.pop(v));
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include "e_object_pool.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct tracked {
+        static inline std::atomic<int> alive{0};
+
+        explicit tracked(int v) : value(v) {
+            if (v < 0) throw std::runtime_error("negative");
+            ++alive;
+        }
+        ~tracked() { --alive; }
+
+        int value;
+        std::string name = "a string that owns heap memory, so leaks show up";
+    };
+
+    struct alignas(64) wide {
+        std::uint64_t words[3];
+    };
+}
+
+TEST(E_ObjectPool, MakeAndReuse) {
+    e_utils::object_pool<tracked> pool;
+    {
+        e_utils::pool_ptr<tracked> a = pool.make(1);
+        e_utils::pool_ptr<tracked> b = pool.make(2);
+        EXPECT_EQ(a->value, 1);
+        EXPECT_EQ(b->value, 2);
+        EXPECT_EQ(tracked::alive, 2);
+        EXPECT_NE(a.get(), b.get());
+
+        // 刚 还回 的 先 被 复用
+        tracked* old = b.get();
+        b.reset();
+        EXPECT_EQ(tracked::alive, 1);
+        b = pool.make(3);
+        EXPECT_EQ(b.get(), old);
+    }
+    EXPECT_EQ(tracked::alive, 0);
+
+    // 构造 抛 异常 时 槽 还回 池 里
+    EXPECT_THROW(pool.make(-1), std::runtime_error);
+    tracked* raw = pool.create(4);
+    EXPECT_EQ(raw->value, 4);
+    pool.destroy(raw);
+    pool.destroy(nullptr);
+    EXPECT_EQ(tracked::alive, 0);
+}
+
+TEST(E_ObjectPool, SlabsAndAlignment) {
+    e_utils::object_pool<wide> pool({.slab_objects = 16, .thread_cache = 8});
+    std::vector<wide*> objects;
+    std::set<wide*> distinct;
+    for (int i = 0; i < 1000; ++i) {
+        wide* w = pool.create();
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(w) % 64, 0u);
+        w->words[0] = w->words[2] = static_cast<std::uint64_t>(i);
+        objects.push_back(w);
+        distinct.insert(w);
+    }
+    EXPECT_EQ(distinct.size(), 1000u);
+    for (int i = 0; i < 1000; ++i) ASSERT_EQ(objects[i]->words[2], static_cast<std::uint64_t>(i));
+
+    // 16 + 32 + ... 翻倍，6 个 slab 够 1008 个
+    const e_utils::pool_stats s = pool.stats();
+    EXPECT_EQ(s.slabs, 6u);
+    EXPECT_EQ(s.capacity, 1008u);
+
+    for (wide* w : objects) pool.destroy(w);
+    // 全部 还回 之后 再 要 同样 多，不 需要 新 slab
+    for (int i = 0; i < 1000; ++i) objects[i] = pool.create();
+    EXPECT_EQ(pool.stats().slabs, 6u);
+    for (wide* w : objects) pool.destroy(w);
+}
+
+TEST(E_ObjectPool, HighWaterMark) {
+    e_utils::object_pool<int> pool;
+    std::vector<int*> v;
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 500; ++i) v.push_back(pool.create(i));
+        for (int* p : v) pool.destroy(p);
+        v.clear();
+    }
+    // 在用 数 按 16 个 一批 汇总
+    const e_utils::pool_stats s = pool.stats();
+    EXPECT_GE(s.peak_live, 500u - 16);
+    EXPECT_LE(s.peak_live, 500u);
+    EXPECT_LE(s.live, 16u);
+    EXPECT_GE(s.capacity, 500u);
+}
+
+TEST(E_ObjectPool, CrossThreadFree) {
+    e_utils::object_pool<tracked> pool({.slab_objects = 64, .thread_cache = 16});
+    constexpr int producers = 4, per_thread = 20000;
+    std::vector<std::vector<e_utils::pool_ptr<tracked>>> made(producers);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < producers; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < per_thread; ++i) {
+                made[t].push_back(pool.make(i));
+                // 边 分配 边 还，线程 缓存 与 共享 栈 之间 来回
+                if (i % 3 == 0) made[t].pop_back();
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    threads.clear();
+
+    // 别的 线程 销毁
+    std::set<const tracked*> distinct;
+    for (auto& v : made) {
+        for (auto& p : v) distinct.insert(p.get());
+    }
+    const std::size_t kept = distinct.size();
+    EXPECT_EQ(kept, static_cast<std::size_t>(producers * (per_thread - (per_thread + 2) / 3)));
+    for (int t = 0; t < producers; ++t) {
+        threads.emplace_back([&, t] {
+            for (std::size_t i = 0; i < made[t].size(); ++i) EXPECT_EQ(made[t][i]->name.size(), 48u);
+            made[t].clear();
+        });
+    }
+    for (auto& th : threads) th.join();
+    EXPECT_EQ(tracked::alive, 0);
+
+    // 退出 的 线程 把 缓存 都 还了：再 要 同样 多 不用 新 slab
+    const std::size_t slabs = pool.stats().slabs;
+    std::vector<e_utils::pool_ptr<tracked>> again;
+    for (std::size_t i = 0; i < kept; ++i) again.push_back(pool.make(1));
+    EXPECT_EQ(pool.stats().slabs, slabs);
+}
+
+TEST(E_ObjectPool, PoolDestroyedWhileThreadCachesIt) {
+    // 线程 还 缓存 着 旧 池 的 对象 时 池 销毁，新 池 复用 同一个 位置
+    std::atomic<int> step{0};
+    auto pool = std::make_unique<e_utils::object_pool<int>>();
+    std::thread worker([&] {
+        for (int i = 0; i < 10; ++i) pool->destroy(pool->create(i));
+        step = 1;
+        while (step != 2) std::this_thread::yield();
+        for (int i = 0; i < 100; ++i) pool->destroy(pool->create(i));
+    });
+    while (step != 1) std::this_thread::yield();
+    pool.reset();
+    pool = std::make_unique<e_utils::object_pool<int>>();
+    step = 2;
+    worker.join();
+    EXPECT_EQ(pool->stats().live, 0u);
+}
@@ -0,0 +1,273 @@
+#include <gtest/gtest.h>
+
+#include "e_roaring.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    using e_utils::roaring_bitmap;
+    using e_utils::roaring_view;
+    using e_utils::detail::roaring_kind;
+
+    // 几个 高 16 位 的 区，每区 密度 不同，能 同时 造出 array 与 bitmap 容器
+    std::vector<std::uint32_t> random_values(unsigned seed, std::size_t per_key) {
+        std::mt19937 rng(seed);
+        std::vector<std::uint32_t> v;
+        for (std::uint32_t key : {0u, 1u, 7u, 300u, 65535u}) {
+            const std::size_t n = per_key * (1 + rng() % 4);
+            for (std::size_t i = 0; i < n; ++i) v.push_back(key << 16 | (rng() & 0xffff));
+        }
+        return v;
+    }
+
+    std::vector<std::uint32_t> sorted_unique(std::vector<std::uint32_t> v) {
+        std::sort(v.begin(), v.end());
+        v.erase(std::unique(v.begin(), v.end()), v.end());
+        return v;
+    }
+
+    std::size_t count_kind(const roaring_view& v, roaring_kind kind) {
+        std::size_t n = 0;
+        for (std::size_t i = 0; i < v.containers(); ++i) n += v.container(i).kind == kind;
+        return n;
+    }
+
+    // 模拟 mmap：8 字节 对齐 的 内存
+    std::vector<std::uint64_t> aligned_copy(const std::vector<std::byte>& bytes) {
+        std::vector<std::uint64_t> v((bytes.size() + 7) / 8);
+        std::memcpy(v.data(), bytes.data(), bytes.size());
+        return v;
+    }
+
+    std::span<const std::byte> as_bytes(const std::vector<std::uint64_t>& v, std::size_t size) {
+        return {reinterpret_cast<const std::byte*>(v.data()), size};
+    }
+}
+
+TEST(E_RoaringBitmap, AddRemoveContains) {
+    std::mt19937 rng(1);
+    std::set<std::uint32_t> expect;
+    roaring_bitmap r;
+    EXPECT_TRUE(r.empty());
+    for (int i = 0; i < 60000; ++i) {
+        // 区 0 稠密（超过 4096 变 bitmap），区 9 稀疏
+        const std::uint32_t v = i % 16 != 0 ? (rng() & 0x3fff) : (9u << 16 | rng() % 50000);
+        if (rng() % 4 == 0) {
+            EXPECT_EQ(r.remove(v), expect.erase(v) == 1);
+        } else {
+            r.add(v);
+            expect.insert(v);
+        }
+    }
+    EXPECT_EQ(r.cardinality(), expect.size());
+    EXPECT_EQ(r.to_vector(), std::vector<std::uint32_t>(expect.begin(), expect.end()));
+    EXPECT_EQ(count_kind(r, roaring_kind::bitmap), 1u);
+    for (std::uint32_t v = 0; v < 0x4000; ++v) ASSERT_EQ(r.contains(v), expect.count(v) == 1) << v;
+    EXPECT_FALSE(r.contains(5u << 16));
+    EXPECT_FALSE(r.contains(0xffffffff));
+
+    // 删 到 4096 以下 变回 array，删空 容器 消失
+    for (std::uint32_t v = 0; v < 0x3000; ++v) r.remove(v);
+    EXPECT_EQ(count_kind(r, roaring_kind::bitmap), 0u);
+    for (std::uint32_t v = 0x3000; v < 0x4000; ++v) r.remove(v);
+    EXPECT_EQ(roaring_view(r).containers(), 1u);
+
+    const roaring_bitmap l = {5, 1, 5, 0xffffffff, 70000};
+    EXPECT_EQ(l.to_vector(), (std::vector<std::uint32_t>{1, 5, 70000, 0xffffffff}));
+    r.clear();
+    EXPECT_TRUE(r.empty());
+}
+
+TEST(E_RoaringBitmap, SetOperationsMatchStd) {
+    // 各种 密度 组合：array/array（长短 悬殊 与 相近）、array/bitmap、bitmap/bitmap
+    for (auto [na, nb] : {std::pair<std::size_t, std::size_t>{3, 5000}, {1000, 1200}, {20, 3000}, {3000, 6000}, {8000, 9000}}) {
+        const auto a = sorted_unique(random_values(static_cast<unsigned>(na), na));
+        const auto b = sorted_unique(random_values(static_cast<unsigned>(nb) + 1, nb));
+        const roaring_bitmap ra = roaring_bitmap::from_values(a);
+        const roaring_bitmap rb = roaring_bitmap::from_values(b);
+
+        std::vector<std::uint32_t> and_, or_, andnot;
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(and_));
+        std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(or_));
+        std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(andnot));
+
+        EXPECT_EQ((ra & rb).to_vector(), and_) << na << " " << nb;
+        EXPECT_EQ((rb & ra).to_vector(), and_) << na << " " << nb;
+        EXPECT_EQ((ra | rb).to_vector(), or_) << na << " " << nb;
+        EXPECT_EQ((ra - rb).to_vector(), andnot) << na << " " << nb;
+        EXPECT_EQ(e_utils::and_cardinality(ra, rb), and_.size());
+        EXPECT_EQ(e_utils::or_cardinality(ra, rb), or_.size());
+        EXPECT_EQ(e_utils::andnot_cardinality(ra, rb), andnot.size());
+        EXPECT_EQ((ra & rb).cardinality(), and_.size());
+        EXPECT_EQ((ra - rb).cardinality(), andnot.size());
+
+        roaring_bitmap c = ra;
+        c |= rb;
+        c -= rb;
+        EXPECT_TRUE(c == (ra - rb));
+        c &= ra;
+        EXPECT_TRUE(c == (ra - rb));
+        EXPECT_FALSE(ra == rb);
+        EXPECT_TRUE(ra == roaring_bitmap::from_values(a));
+    }
+}
+
+TEST(E_RoaringBitmap, RangesAndRunOptimize) {
+    roaring_bitmap r;
+    r.add_range(65000, 200000); // 跨 4 个 容器
+    r.add_range(5, 5);
+    r.add(3);
+    EXPECT_EQ(r.cardinality(), 200000u - 65000u + 1);
+    EXPECT_TRUE(r.contains(3));
+    EXPECT_TRUE(r.contains(65000));
+    EXPECT_TRUE(r.contains(199999));
+    EXPECT_FALSE(r.contains(200000));
+    EXPECT_FALSE(r.contains(64999));
+    EXPECT_EQ(count_kind(r, roaring_kind::run), 3u);
+
+    // run 上 增删 展开 成 普通 形式
+    EXPECT_TRUE(r.remove(100000));
+    EXPECT_FALSE(r.contains(100000));
+    r.add(100000);
+    EXPECT_EQ(r.cardinality(), 200000u - 65000u + 1);
+
+    r.add_range(0xfffffff0ull, 1ull << 32);
+    EXPECT_TRUE(r.contains(0xffffffff));
+    EXPECT_THROW(r.add_range(0, (1ull << 32) + 1), std::invalid_argument);
+
+    // 与 普通 位图 运算 结果 一样
+    std::vector<std::uint32_t> values = r.to_vector();
+    const roaring_bitmap plain = roaring_bitmap::from_values(values);
+    EXPECT_TRUE(r.run_optimize());
+    EXPECT_FALSE(r.run_optimize());
+    EXPECT_EQ(count_kind(r, roaring_kind::run), roaring_view(r).containers());
+    EXPECT_EQ(r.to_vector(), values);
+    EXPECT_LT(r.serialized_size(), plain.serialized_size() / 100);
+
+    const auto other = sorted_unique(random_values(7, 3000));
+    const roaring_bitmap ro = roaring_bitmap::from_values(other);
+    EXPECT_TRUE((r & ro) == (plain & ro));
+    EXPECT_TRUE((ro - r) == (ro - plain));
+    EXPECT_TRUE((r - ro) == (plain - ro));
+    EXPECT_TRUE((r | ro) == (plain | ro));
+    EXPECT_EQ(e_utils::and_cardinality(r, ro), e_utils::and_cardinality(plain, ro));
+
+    // 零散 元素 不 值得 用 run
+    roaring_bitmap sparse = roaring_bitmap::from_values(other);
+    EXPECT_FALSE(sparse.run_optimize());
+}
+
+TEST(E_RoaringView, Serialized) {
+    auto values = random_values(11, 1000);
+    std::mt19937 rng(11);
+    for (int i = 0; i < 20000; ++i) values.push_back(30u << 16 | (rng() & 0xffff));
+    values = sorted_unique(values);
+    roaring_bitmap r = roaring_bitmap::from_values(values);
+    r.add_range(20u << 16, (20u << 16) + 50000);
+    r.run_optimize();
+    ASSERT_GT(count_kind(r, roaring_kind::array), 0u);
+    ASSERT_GT(count_kind(r, roaring_kind::bitmap), 0u);
+    ASSERT_GT(count_kind(r, roaring_kind::run), 0u);
+
+    const std::vector<std::byte> bytes = r.serialize();
+    EXPECT_EQ(bytes.size(), r.serialized_size());
+    const auto file = aligned_copy(bytes);
+    const roaring_view v(as_bytes(file, bytes.size()));
+    EXPECT_EQ(v.containers(), roaring_view(r).containers());
+    EXPECT_EQ(v.cardinality(), r.cardinality());
+    EXPECT_EQ(v.to_vector(), r.to_vector());
+    EXPECT_TRUE(v == r);
+    for (std::uint32_t x : values) ASSERT_TRUE(v.contains(x)) << x;
+    EXPECT_TRUE(v.contains((20u << 16) + 49999));
+    EXPECT_FALSE(v.contains((20u << 16) + 50000));
+    EXPECT_FALSE(v.contains(19u << 16));
+
+    // view 直接 参与 运算，或者 拷贝 出来 再 改
+    const roaring_bitmap other = roaring_bitmap::from_values(sorted_unique(random_values(12, 2000)));
+    EXPECT_TRUE((v & other) == (r & other));
+    EXPECT_TRUE((other - v) == (other - r));
+    roaring_bitmap copy(v);
+    copy.add(19u << 16);
+    EXPECT_EQ(copy.cardinality(), r.cardinality() + 1);
+
+    std::vector<std::byte> small(bytes.size() - 1);
+    EXPECT_THROW(r.serialize(small), std::invalid_argument);
+
+    const auto empty_file = aligned_copy(roaring_bitmap().serialize());
+    const roaring_view empty(as_bytes(empty_file, 16));
+    EXPECT_TRUE(empty.empty());
+}
+
+TEST(E_RoaringView, RejectsBadBytes) {
+    const roaring_bitmap r = roaring_bitmap::from_values(sorted_unique(random_values(13, 1000)));
+    const std::vector<std::byte> bytes = r.serialize();
+    auto file = aligned_copy(bytes);
+
+    EXPECT_THROW(roaring_view(as_bytes(file, bytes.size() - 8)), std::invalid_argument);
+    EXPECT_THROW(roaring_view(as_bytes(file, 10)), std::invalid_argument);
+    EXPECT_THROW(roaring_view(as_bytes(file, bytes.size()).subspan(4, 16)), std::invalid_argument);
+
+    // 改 magic
+    auto broken = bytes;
+    broken[0] = std::byte{'X'};
+    EXPECT_THROW(roaring_view(as_bytes(aligned_copy(broken), broken.size())), std::invalid_argument);
+
+    // 第二个 容器 的 key 改成 与 第一个 相同
+    broken = bytes;
+    std::memcpy(broken.data() + 32, broken.data() + 16, 2);
+    EXPECT_THROW(roaring_view(as_bytes(aligned_copy(broken), broken.size())), std::invalid_argument);
+}
+
+TEST(E_RoaringView, RejectsBadPayloads) {
+    // 改 第一个 容器 的 内容 或 描述，返回 序列化 的 字节
+    const auto tamper = [](const roaring_bitmap& r, auto edit) {
+        std::vector<std::byte> bytes = r.serialize();
+        std::uint32_t offset;
+        std::memcpy(&offset, bytes.data() + 16 + 12, 4);
+        edit(bytes.data() + 16, bytes.data() + offset);
+        return aligned_copy(bytes);
+    };
+    const auto put16 = [](std::byte* p, std::size_t i, std::uint16_t v) { std::memcpy(p + 2 * i, &v, 2); };
+    const auto rejects = [](const std::vector<std::uint64_t>& file) {
+        EXPECT_THROW(roaring_view(as_bytes(file, file.size() * 8)), std::invalid_argument);
+    };
+
+    roaring_bitmap runs;
+    runs.add_range(100, 200);
+    runs.add_range(300, 400);
+    runs.run_optimize();
+    ASSERT_EQ(roaring_view(runs).container(0).kind, roaring_kind::run);
+    // 段 越过 65535：以前 会 在 展开 时 写 出 bitmap
+    rejects(tamper(runs, [&](std::byte*, std::byte* p) { put16(p, 3, 65500); }));
+    // 第二段 起点 落在 第一段 里（元素 个数 不变）
+    rejects(tamper(runs, [&](std::byte*, std::byte* p) { put16(p, 2, 150); }));
+
+    const std::uint32_t values[] = {1, 2, 3, 5000};
+    const roaring_bitmap array = roaring_bitmap::from_values(values);
+    ASSERT_EQ(roaring_view(array).container(0).kind, roaring_kind::array);
+    rejects(tamper(array, [&](std::byte*, std::byte* p) { put16(p, 1, 3); put16(p, 2, 2); })); // 乱序
+    rejects(tamper(array, [&](std::byte*, std::byte* p) { put16(p, 1, 1); }));                 // 重复
+
+    std::vector<std::uint32_t> evens;
+    for (std::uint32_t x = 0; x < 20000; x += 2) evens.push_back(x);
+    const roaring_bitmap dense = roaring_bitmap::from_values(evens);
+    ASSERT_EQ(roaring_view(dense).container(0).kind, roaring_kind::bitmap);
+    rejects(tamper(dense, [&](std::byte* d, std::byte*) {
+        const std::uint32_t cardinality = 10001;
+        std::memcpy(d + 4, &cardinality, 4);
+    }));
+
+    // 没 改 的 都 能 读
+    for (const roaring_bitmap* r : std::initializer_list<const roaring_bitmap*>{&runs, &array, &dense}) {
+        const auto file = tamper(*r, [](std::byte*, std::byte*) {});
+        EXPECT_TRUE(roaring_view(as_bytes(file, file.size() * 8)) == roaring_view(*r));
+    }
+}
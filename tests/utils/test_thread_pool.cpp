@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include "e_thread_pool.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    // 递归 拆分 求和，任务 在 工作 线程 里 提交 并 等待
+    long long tree_sum(e_utils::thread_pool& pool, long long lo, long long hi) {
+        if (hi - lo <= 64) {
+            long long s = 0;
+            for (long long i = lo; i < hi; ++i) s += i;
+            return s;
+        }
+        const long long mid = lo + (hi - lo) / 2;
+        auto left = pool.submit([&pool, lo, mid] { return tree_sum(pool, lo, mid); });
+        const long long right = tree_sum(pool, mid, hi);
+        return left.get() + right;
+    }
+}
+
+TEST(E_ThreadPool, SubmitReturnsValuesAndExceptions) {
+    e_utils::thread_pool pool({.threads = 4});
+    EXPECT_EQ(pool.size(), 4u);
+
+    auto a = pool.submit([] { return 6 * 7; });
+    auto b = pool.submit([] { return std::string("work stealing"); });
+    std::atomic<int> hits{0};
+    auto c = pool.submit([&] { ++hits; });
+    auto d = pool.submit([]() -> int { throw std::runtime_error("task failed"); });
+    auto e = pool.submit([p = std::make_unique<int>(5)] { return *p + 1; }); // 只能 移动 的 函数 对象
+
+    EXPECT_EQ(a.get(), 42);
+    EXPECT_EQ(b.get(), "work stealing");
+    c.get();
+    EXPECT_EQ(hits, 1);
+    EXPECT_THROW(d.get(), std::runtime_error);
+    EXPECT_EQ(e.get(), 6);
+    EXPECT_FALSE(a.valid());
+}
+
+TEST(E_ThreadPool, ParallelForVisitsEveryIndexOnce) {
+    e_utils::thread_pool pool({.threads = 3});
+    for (std::size_t n : {0u, 1u, 7u, 1000u, 100003u}) {
+        std::vector<std::atomic<int>> seen(n);
+        pool.parallel_for(0, n, [&](std::size_t i) { seen[i].fetch_add(1, std::memory_order_relaxed); });
+        for (std::size_t i = 0; i < n; ++i) ASSERT_EQ(seen[i].load(), 1) << "n=" << n << " i=" << i;
+    }
+
+    // 非 0 起点，指定 粒度 与 线程 数
+    std::vector<int> out(500, 0);
+    pool.parallel_for(100, 500, [&](std::size_t i) { out[i] = static_cast<int>(i); }, {.grain = 7, .max_threads = 2});
+    for (std::size_t i = 0; i < 500; ++i) EXPECT_EQ(out[i], i < 100 ? 0 : static_cast<int>(i));
+}
+
+TEST(E_ThreadPool, NestedWorkDoesNotDeadlock) {
+    e_utils::thread_pool pool({.threads = 2});
+
+    // 工作 线程 里 submit 再 get
+    auto total = pool.submit([&pool] { return tree_sum(pool, 0, 100000); });
+    EXPECT_EQ(total.get(), 100000LL * 99999 / 2);
+
+    // parallel_for 里 再 parallel_for
+    std::vector<std::atomic<int>> cells(64 * 64);
+    pool.parallel_for(0, 64, [&](std::size_t row) {
+        pool.parallel_for(0, 64, [&](std::size_t col) { cells[row * 64 + col].fetch_add(1, std::memory_order_relaxed); });
+    });
+    for (auto& c : cells) ASSERT_EQ(c.load(), 1);
+}
+
+TEST(E_ThreadPool, ParallelForRethrowsFirstException) {
+    e_utils::thread_pool pool({.threads = 4});
+    std::atomic<int> ran{0};
+    EXPECT_THROW(pool.parallel_for(0, 10000, [&](std::size_t i) {
+        ++ran;
+        if (i == 10) throw std::invalid_argument("bad index");
+    }, {.grain = 16}),
+                 std::invalid_argument);
+    EXPECT_LT(ran.load(), 10000); // 剩下 的 块 没有 执行
+
+    // 池 还能 继续 用
+    std::atomic<long long> sum{0};
+    pool.parallel_for(0, 1000, [&](std::size_t i) { sum += static_cast<long long>(i); });
+    EXPECT_EQ(sum.load(), 999LL * 1000 / 2);
+}
+
+TEST(E_ThreadPool, PinnedPoolAndDestructorDrains) {
+    std::atomic<int> done{0};
+    {
+        e_utils::thread_pool pool({.threads = 2, .pin_threads = true});
+        for (int i = 0; i < 1000; ++i) {
+            pool.submit([&done] { done.fetch_add(1, std::memory_order_relaxed); });
+        }
+        std::vector<int> v(4096);
+        pool.parallel_for(0, v.size(), [&](std::size_t i) { v[i] = 1; });
+        EXPECT_EQ(std::accumulate(v.begin(), v.end(), 0), 4096);
+    }
+    EXPECT_EQ(done.load(), 1000); // 没 get 的 任务 在 析构 前 做完
+
+    // 全局 池 与 单 线程 限制
+    std::vector<int> w(1000);
+    e_utils::thread_pool::global().parallel_for(0, w.size(), [&](std::size_t i) { w[i] = static_cast<int>(i); }, {.max_threads = 1});
+    EXPECT_EQ(std::accumulate(w.begin(), w.end(), 0), 999 * 1000 / 2);
+}
@@ -5,7 +5,7 @@ add_requires("gtest")
 
 target("tests")
     set_kind("binary")
-    add_deps("math")
+    add_deps("math", "utils")
     add_packages("gtest")
     set_default(false)
     add_files("**.cpp")
\ No newline at end of file
@@ -3,9 +3,10 @@ add_rules("mode.debug", "mode.release")
 -- c++ 20 标准
 set_languages("c++20")
 
--- 仅对 MSVC 编译器添加 /Zc:__cplusplus 选项
+-- 仅对 MSVC 编译器添加 /Zc:__cplusplus、/Zc:preprocessor 选项
 if is_plat("windows") then
     add_cxflags("/Zc:__cplusplus", {force = true})
+    add_cxflags("/Zc:preprocessor", {force = true}) -- e_log.hpp 的 宏 用到 __VA_OPT__
 end
 
 -- 引入 模块
@@ -14,6 +15,7 @@ includes("modules/math")
 includes("modules/main")
 
 includes("tests")
+includes("benchmarks")
 
 includes("examples")
 